@@ -0,0 +1,170 @@
+//---------------------------------------------------------------------------
+//
+// TSDuck sample Java application: throughput of tsp memory plugins.
+//
+// This application runs a tsp pipeline using the input and output memory
+// plugins and measures the number of packets per second, first with event
+// data as byte arrays, then in zero-copy mode with direct ByteBuffer.
+//
+// Usage: java BenchmarkMemoryPlugins [packet-count [packets-per-event]]
+//
+//----------------------------------------------------------------------------
+
+import java.nio.ByteBuffer;
+
+import io.tsduck.AbstractPluginEventHandler;
+import io.tsduck.ErrReport;
+import io.tsduck.PluginEventContext;
+import io.tsduck.Report;
+import io.tsduck.TS;
+import io.tsduck.TSProcessor;
+
+public class BenchmarkMemoryPlugins {
+
+    /**
+     * A null packet, used as input packet.
+     */
+    static private final byte[] NULL_PACKET = nullPacket();
+
+    static private byte[] nullPacket() {
+        byte[] pkt = new byte[TS.PKT_SIZE];
+        pkt[0] = (byte)0x47;
+        pkt[1] = (byte)0x1F;
+        pkt[2] = (byte)0xFF;
+        pkt[3] = (byte)0x10;
+        for (int i = 4; i < TS.PKT_SIZE; i++) {
+            pkt[i] = (byte)0xFF;
+        }
+        return pkt;
+    }
+
+    /**
+     * An event handler for memory input plugin, returns a given number of null packets.
+     */
+    private static class InputHandler extends AbstractPluginEventHandler {
+
+        private long _remaining = 0;
+        private byte[] _chunk = new byte[0];
+
+        public InputHandler(long count, boolean zeroCopy) {
+            super(zeroCopy);
+            _remaining = count;
+        }
+
+        // Number of packets to return in one event.
+        private int packetCount(int maxDataSize) {
+            return (int)Math.min(_remaining, maxDataSize / TS.PKT_SIZE);
+        }
+
+        // Byte array mode: build a new array of packets for each event.
+        @Override
+        public boolean handlePluginEvent(PluginEventContext context, byte[] data) {
+            int count = packetCount(context.maxDataSize());
+            if (_chunk.length != count * TS.PKT_SIZE) {
+                _chunk = new byte[count * TS.PKT_SIZE];
+                for (int i = 0; i < count; i++) {
+                    System.arraycopy(NULL_PACKET, 0, _chunk, i * TS.PKT_SIZE, TS.PKT_SIZE);
+                }
+            }
+            // Simulate an application which produces new packets in each event.
+            context.setOutputData(_chunk.clone());
+            _remaining -= count;
+            return true;
+        }
+
+        // Zero-copy mode: write the packets directly in the tsp buffer.
+        @Override
+        public boolean handlePluginEvent(PluginEventContext context, ByteBuffer data) {
+            int count = packetCount(data.capacity());
+            for (int i = 0; i < count; i++) {
+                data.put(NULL_PACKET);
+            }
+            context.setOutputSize(count * TS.PKT_SIZE);
+            _remaining -= count;
+            return true;
+        }
+    }
+
+    /**
+     * An event handler for memory output plugin, counts the packets.
+     */
+    private static class OutputHandler extends AbstractPluginEventHandler {
+
+        public long packets = 0;
+        public long checksum = 0;
+
+        public OutputHandler(boolean zeroCopy) {
+            super(zeroCopy);
+        }
+
+        @Override
+        public boolean handlePluginEvent(PluginEventContext context, byte[] data) {
+            for (int i = 0; i < data.length; i += TS.PKT_SIZE) {
+                checksum += data[i + 1] & 0xFF;
+            }
+            packets += data.length / TS.PKT_SIZE;
+            return true;
+        }
+
+        @Override
+        public boolean handlePluginEvent(PluginEventContext context, ByteBuffer data) {
+            for (int i = 0; i < data.limit(); i += TS.PKT_SIZE) {
+                checksum += data.get(i + 1) & 0xFF;
+            }
+            packets += data.limit() / TS.PKT_SIZE;
+            return true;
+        }
+    }
+
+    /**
+     * Run one test, return the number of packets per second.
+     */
+    private static double run(Report report, long count, int eventPackets, boolean zeroCopy) {
+        InputHandler input = new InputHandler(count, zeroCopy);
+        OutputHandler output = new OutputHandler(zeroCopy);
+
+        TSProcessor tsp = new TSProcessor(report);
+        tsp.maxInputPackets = eventPackets;
+        tsp.maxOutputPackets = eventPackets;
+        tsp.registerInputEventHandler(input);
+        tsp.registerOutputEventHandler(output);
+        tsp.input = new String[] {"memory"};
+        tsp.output = new String[] {"memory"};
+
+        long start = System.nanoTime();
+        tsp.start();
+        tsp.waitForTermination();
+        long duration = System.nanoTime() - start;
+        tsp.delete();
+
+        if (output.packets != count || output.checksum != 0x1F * count) {
+            report.error(String.format("received %d packets, expected %d", output.packets, count));
+        }
+        input.delete();
+        output.delete();
+        return duration <= 0 ? 0.0 : (double)count * 1.0e9 / duration;
+    }
+
+    /**
+     * Main program.
+     * @param args Command line arguments.
+     */
+    public static void main(String[] args) {
+        long count = args.length > 0 ? Long.parseLong(args[0]) : 2000000;
+        int eventPackets = args.length > 1 ? Integer.parseInt(args[1]) : 128;
+
+        ErrReport report = new ErrReport();
+
+        // A first run to warm up the JVM, not measured.
+        run(report, count / 10, eventPackets, false);
+        run(report, count / 10, eventPackets, true);
+
+        double arrays = run(report, count, eventPackets, false);
+        double direct = run(report, count, eventPackets, true);
+
+        System.out.printf("%,d packets, %d packets per event%n", count, eventPackets);
+        System.out.printf("byte[] events:     %,.0f packets/second%n", arrays);
+        System.out.printf("ByteBuffer events: %,.0f packets/second%n", direct);
+        report.delete();
+    }
+}
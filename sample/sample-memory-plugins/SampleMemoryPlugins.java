@@ -7,7 +7,7 @@
 //
 //----------------------------------------------------------------------------
 
-import java.util.Arrays;
+import java.nio.ByteBuffer;
 
 import io.tsduck.AbstractPluginEventHandler;
 import io.tsduck.AsyncReport;
@@ -102,6 +102,9 @@ public class SampleMemoryPlugins {
     /**
      * An event handler for memory output plugin.
      * It is invoked by the "memory" output plugin each time TS packets are sent.
+     *
+     * This handler uses the zero-copy mode: the output packets are received in
+     * a read-only direct ByteBuffer over the tsp buffer, without intermediate copy.
      */
     private static class OutputHandler extends AbstractPluginEventHandler {
 
@@ -112,20 +115,22 @@ public class SampleMemoryPlugins {
          * @param report The report of the application
          */
         public OutputHandler(Report report) {
+            super(true);
             _report = report;
         }
 
         /**
          * This event handler is called each time the memory plugin sends output packets.
          * @param context An instance of PluginEventContext containing the details of the event.
-         * @param data A byte array containing the data of the event.
+         * @param data A direct ByteBuffer over the data of the event.
          */
         @Override
-        public boolean handlePluginEvent(PluginEventContext context, byte[] data) {
-            int packets_count = data.length / TS.PKT_SIZE;
+        public boolean handlePluginEvent(PluginEventContext context, ByteBuffer data) {
+            int packets_count = data.limit() / TS.PKT_SIZE;
             _report.info(String.format("received %d output packets", packets_count));
+            byte[] packet = new byte[TS.PKT_SIZE];
             for (int i = 0; i < packets_count; i++) {
-                byte[] packet = Arrays.copyOfRange(data, i * TS.PKT_SIZE, (i + 1) * TS.PKT_SIZE);
+                data.get(packet);
                 _report.info(String.format("packet #%d: %s", i, SampleUtils.bytesToHex(packet)));
             }
             return true;
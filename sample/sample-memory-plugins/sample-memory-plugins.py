@@ -50,11 +50,14 @@ class InputHandler(tsduck.AbstractPluginEventHandler):
 # It is invoked by the "memory" output plugin each time TS packets are sent.
 #----------------------------------------------------------------------------
 
+# This handler uses the zero-copy mode: the output packets are received as
+# a read-only memoryview over the tsp buffer, without intermediate copy.
+
 class OutputHandler(tsduck.AbstractPluginEventHandler):
 
     # Constructor.
     def __init__(self, report):
-        super().__init__()
+        super().__init__(zero_copy = True)
         self._report = report
 
     # This event handler is called each time the memory plugin sends output packets.
@@ -62,7 +65,7 @@ class OutputHandler(tsduck.AbstractPluginEventHandler):
         packets_count = len(data) // tsduck.PKT_SIZE
         self._report.info("received %d output packets" % (packets_count))
         for i in range(packets_count):
-            packet = data[i * tsduck.PKT_SIZE : tsduck.PKT_SIZE]
+            packet = data[i * tsduck.PKT_SIZE : (i + 1) * tsduck.PKT_SIZE]
             self._report.info("packet #%d: %s" % (i, packet.hex()))
 
 
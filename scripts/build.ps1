@@ -190,7 +190,7 @@ function Call-MSBuild ([string] $configuration, [string] $platform, [string] $ta
 $AllTargets = @(Select-String -Path "${ProjDir}\*.vcxproj" -Pattern '<RootNameSpace>' |
                 ForEach-Object { $_ -replace '.*<RootNameSpace> *','' -replace ' *</RootNameSpace>.*','' })
 $plugins = ($AllTargets | Select-String "^tsplugin_") -join ';'
-$commands = ($AllTargets | Select-String "^ts" | Select-String -NotMatch @("dll$", "lib$", "^tsplugin_", "^tsp_static$", "^tsmux$", "^tsprofiling$")) -join ';'
+$commands = ($AllTargets | Select-String "^ts" | Select-String -NotMatch @("dll$", "lib$", "^tsplugin_", "^tsp_static$", "^tsmux$", "^tsprofiling$", "^tsbenchmark$")) -join ';'
 
 # Rebuild TSDuck.
 if ($Installer) {
@@ -0,0 +1,3 @@
+CONFIG += util
+TARGET = tsbenchmark
+include(../tsduck.pri)
@@ -0,0 +1,4 @@
+# Automatically generated file, see build-project-files.py
+CONFIG += tstool
+TARGET = tstr101290
+include(../tsduck.pri)
@@ -0,0 +1,274 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Bounded message queue for inter-thread communication with priority
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsBoundedMessageQueue.h"
+
+namespace ts {
+    //!
+    //! Bounded message queue for inter-thread communication with priority.
+    //! @ingroup libtscore thread
+    //!
+    //! The ts::BoundedMessagePriorityQueue template class is a variant of ts::MessagePriorityQueue
+    //! with a fixed capacity and the same interface as ts::BoundedMessageQueue. As in ts::MessagePriorityQueue,
+    //! messages are dequeued in the order of @a COMPARE, the lowest first. Messages with equal priority
+    //! are dequeued in their enqueueing order.
+    //!
+    //! The messages are stored by value in a binary heap which is allocated once. Enqueueing and
+    //! dequeueing a message do not allocate memory. Unlike ts::BoundedMessageQueue, the heap is
+    //! protected by a mutex but the critical section is limited to a logarithmic reordering of
+    //! the heap, without list node or smart pointer allocation.
+    //!
+    //! @tparam MSG The type of the messages to exchange. It must be default-constructible,
+    //! assignable and swappable.
+    //! @tparam COMPARE A function object to sort @a MSG instances. By default,
+    //! the '<' operator on @a MSG is used.
+    //!
+    template <typename MSG, class COMPARE = std::less<MSG>>
+    class BoundedMessagePriorityQueue
+    {
+        TS_NOCOPY(BoundedMessagePriorityQueue);
+    public:
+        //!
+        //! Default maximum number of messages in the queue.
+        //!
+        static constexpr size_t DEFAULT_MAX_MESSAGES = BoundedMessageQueue<MSG>::DEFAULT_MAX_MESSAGES;
+
+        //!
+        //! Number of additional slots which are reserved for forceEnqueue().
+        //!
+        static constexpr size_t RESERVED_MESSAGES = BoundedMessageQueue<MSG>::RESERVED_MESSAGES;
+
+        //!
+        //! Constructor.
+        //! @param [in] maxMessages Maximum number of messages in the queue.
+        //! Zero means DEFAULT_MAX_MESSAGES. The queue cannot be unlimited.
+        //!
+        BoundedMessagePriorityQueue(size_t maxMessages = DEFAULT_MAX_MESSAGES) { setMaxMessages(maxMessages); }
+
+        //!
+        //! Get the maximum allowed messages in the queue.
+        //! @return The maximum allowed messages in the queue.
+        //!
+        size_t getMaxMessages() const;
+
+        //!
+        //! Change the maximum allowed messages in the queue.
+        //! The content of the queue is lost. This method must be called only when no other thread uses the queue.
+        //! @param [in] maxMessages Maximum number of messages in the queue. Zero means DEFAULT_MAX_MESSAGES.
+        //!
+        void setMaxMessages(size_t maxMessages);
+
+        //!
+        //! Get the number of messages in the queue.
+        //! @return The number of messages in the queue.
+        //!
+        size_t size() const;
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes available in the queue.
+        //! @param [in] msg The message to enqueue.
+        //!
+        void enqueue(const MSG& msg) { enqueueWait(msg, false, nullptr); }
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes available in the queue.
+        //! @param [in,out] msg The message to enqueue. The message is moved into the queue.
+        //!
+        void enqueue(MSG&& msg) { enqueueWait(std::move(msg), false, nullptr); }
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes
+        //! available in the queue or the timeout expires.
+        //! @param [in] msg The message to enqueue.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! @return True on success, false on error (queue still full after timeout).
+        //!
+        bool enqueue(const MSG& msg, cn::milliseconds timeout) { return enqueueWait(msg, false, &timeout); }
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes
+        //! available in the queue or the timeout expires.
+        //! @param [in,out] msg The message to enqueue. The message is moved into the queue on success only.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! @return True on success, false on error (queue still full after timeout).
+        //!
+        bool enqueue(MSG&& msg, cn::milliseconds timeout) { return enqueueWait(std::move(msg), false, &timeout); }
+
+        //!
+        //! Insert a message in the queue, even if the queue is full.
+        //! The message may use one of the RESERVED_MESSAGES additional slots.
+        //! @param [in] msg The message to enqueue.
+        //!
+        void forceEnqueue(const MSG& msg) { enqueueWait(msg, true, nullptr); }
+
+        //!
+        //! Insert a message in the queue, even if the queue is full.
+        //! The message may use one of the RESERVED_MESSAGES additional slots.
+        //! @param [in,out] msg The message to enqueue. The message is moved into the queue.
+        //!
+        void forceEnqueue(MSG&& msg) { enqueueWait(std::move(msg), true, nullptr); }
+
+        //!
+        //! Remove the first message in priority order from the queue.
+        //! Wait until a message is received.
+        //! @param [in,out] msg Received message.
+        //!
+        void dequeue(MSG& msg) { dequeueWait(msg, nullptr); }
+
+        //!
+        //! Remove the first message in priority order from the queue.
+        //! Wait until a message is received or the timeout expires.
+        //! @param [in,out] msg Received message.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! If @a timeout is zero and the queue is empty, return immediately.
+        //! @return True on success, false on error (queue still empty after timeout).
+        //!
+        bool dequeue(MSG& msg, cn::milliseconds timeout) { return dequeueWait(msg, &timeout); }
+
+        //!
+        //! Clear the content of the queue.
+        //!
+        void clear();
+
+    private:
+        // An entry in the heap. The order of insertion sorts messages with equal priority.
+        struct Entry
+        {
+            uint64_t order = 0;
+            MSG      value {};
+        };
+
+        // Heap ordering, the lowest message at top, then the oldest one.
+        class EntryLess
+        {
+        public:
+            bool operator()(const Entry& e1, const Entry& e2) const
+            {
+                const COMPARE less;
+                return less(e2.value, e1.value) || (!less(e1.value, e2.value) && e1.order > e2.order);
+            }
+        };
+
+        mutable std::mutex      _mutex {};
+        std::condition_variable _enqueued {};  // Signaled when some message is inserted
+        std::condition_variable _dequeued {};  // Signaled when some message is removed
+        size_t                  _max_messages = 0;
+        uint64_t                _order = 0;    // Insertion order of next message.
+        std::vector<Entry>      _heap {};      // Capacity is preallocated.
+
+        // Enqueue or dequeue a message, wait when necessary. No timeout when null.
+        template <typename T>
+        bool enqueueWait(T&& msg, bool force, const cn::milliseconds* timeout);
+        bool dequeueWait(MSG& msg, const cn::milliseconds* timeout);
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class COMPARE>
+size_t ts::BoundedMessagePriorityQueue<MSG, COMPARE>::getMaxMessages() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _max_messages;
+}
+
+template <typename MSG, class COMPARE>
+void ts::BoundedMessagePriorityQueue<MSG, COMPARE>::setMaxMessages(size_t maxMessages)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _max_messages = maxMessages > 0 ? maxMessages : DEFAULT_MAX_MESSAGES;
+    _heap.clear();
+    _heap.shrink_to_fit();
+    _heap.reserve(_max_messages + RESERVED_MESSAGES);
+}
+
+template <typename MSG, class COMPARE>
+size_t ts::BoundedMessagePriorityQueue<MSG, COMPARE>::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _heap.size();
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a message, wait when necessary.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class COMPARE>
+template <typename T>
+bool ts::BoundedMessagePriorityQueue<MSG, COMPARE>::enqueueWait(T&& msg, bool force, const cn::milliseconds* timeout)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    const size_t limit = _max_messages + (force ? RESERVED_MESSAGES : 0);
+    const auto has_space = [this, limit]() { return _heap.size() < limit; };
+    if (timeout == nullptr) {
+        _dequeued.wait(lock, has_space);
+    }
+    else if (!_dequeued.wait_for(lock, *timeout, has_space)) {
+        return false;
+    }
+    // Within the preallocated capacity, does not reallocate.
+    _heap.push_back(Entry{_order++, std::forward<T>(msg)});
+    std::push_heap(_heap.begin(), _heap.end(), EntryLess());
+    lock.unlock();
+    _enqueued.notify_all();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Remove a message, wait when necessary.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class COMPARE>
+bool ts::BoundedMessagePriorityQueue<MSG, COMPARE>::dequeueWait(MSG& msg, const cn::milliseconds* timeout)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    const auto not_empty = [this]() { return !_heap.empty(); };
+    if (timeout == nullptr) {
+        _enqueued.wait(lock, not_empty);
+    }
+    else if (!_enqueued.wait_for(lock, *timeout, not_empty)) {
+        return false;
+    }
+    std::pop_heap(_heap.begin(), _heap.end(), EntryLess());
+    using std::swap;
+    swap(msg, _heap.back().value);
+    _heap.pop_back();
+    lock.unlock();
+    _dequeued.notify_all();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Clear the queue.
+//----------------------------------------------------------------------------
+
+template <typename MSG, class COMPARE>
+void ts::BoundedMessagePriorityQueue<MSG, COMPARE>::clear()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _heap.clear();
+    }
+    _dequeued.notify_all();
+}
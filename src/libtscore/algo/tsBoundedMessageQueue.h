@@ -0,0 +1,424 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Bounded lock-free message queue for inter-thread communication
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts {
+    //!
+    //! Bounded lock-free message queue for inter-thread communication.
+    //! @ingroup libtscore thread
+    //!
+    //! The ts::BoundedMessageQueue template class is a variant of ts::MessageQueue with a fixed
+    //! capacity. Any number of threads can simultaneously enqueue and dequeue messages.
+    //!
+    //! The messages are stored by value in a ring buffer which is allocated once. Enqueueing and
+    //! dequeueing a message do not allocate memory and do not acquire a lock, except when a
+    //! thread must wait, for free space or for a message. The ring buffer uses per-slot sequence
+    //! numbers (bounded MPMC queue from Dmitry Vyukov).
+    //!
+    //! Message slots are reused. The enqueued message is assigned into its slot and the dequeued
+    //! message is swapped with the slot. When the message type manages a buffer, such as strings,
+    //! the buffers are recycled between the producers and the consumers.
+    //!
+    //! @tparam MSG The type of the messages to exchange. It must be default-constructible,
+    //! assignable and swappable. It is typically a plain structure or a smart pointer.
+    //!
+    template <typename MSG>
+    class BoundedMessageQueue
+    {
+        TS_NOCOPY(BoundedMessageQueue);
+    public:
+        //!
+        //! Default maximum number of messages in the queue.
+        //!
+        static constexpr size_t DEFAULT_MAX_MESSAGES = 1024;
+
+        //!
+        //! Number of additional slots which are reserved for forceEnqueue().
+        //!
+        static constexpr size_t RESERVED_MESSAGES = 4;
+
+        //!
+        //! Number of attempts, yielding the CPU between them, before a thread waits on the queue.
+        //!
+        static constexpr size_t SPIN_COUNT = 64;
+
+        //!
+        //! Constructor.
+        //! @param [in] maxMessages Maximum number of messages in the queue.
+        //! Zero means DEFAULT_MAX_MESSAGES. The queue cannot be unlimited.
+        //!
+        BoundedMessageQueue(size_t maxMessages = DEFAULT_MAX_MESSAGES);
+
+        //!
+        //! Get the maximum allowed messages in the queue.
+        //! @return The maximum allowed messages in the queue.
+        //!
+        size_t getMaxMessages() const { return _max_messages; }
+
+        //!
+        //! Change the maximum allowed messages in the queue.
+        //! The ring buffer is reallocated and its content is lost. Unlike ts::MessageQueue,
+        //! this method must be called only when no other thread uses the queue.
+        //! @param [in] maxMessages Maximum number of messages in the queue. Zero means DEFAULT_MAX_MESSAGES.
+        //!
+        void setMaxMessages(size_t maxMessages);
+
+        //!
+        //! Get the number of messages in the queue.
+        //! @return The number of messages in the queue. This is just an indication since other threads may
+        //! simultaneously enqueue or dequeue messages.
+        //!
+        size_t size() const;
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes available in the queue.
+        //! @param [in] msg The message to enqueue.
+        //!
+        void enqueue(const MSG& msg) { enqueueWait(msg, _max_messages, nullptr); }
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes available in the queue.
+        //! @param [in,out] msg The message to enqueue. The message is moved into the queue.
+        //!
+        void enqueue(MSG&& msg) { enqueueWait(std::move(msg), _max_messages, nullptr); }
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes
+        //! available in the queue or the timeout expires.
+        //! @param [in] msg The message to enqueue.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! If @a timeout is zero and the queue is full, return immediately.
+        //! @return True on success, false on error (queue still full after timeout).
+        //!
+        bool enqueue(const MSG& msg, cn::milliseconds timeout) { return enqueueWait(msg, _max_messages, &timeout); }
+
+        //!
+        //! Insert a message in the queue.
+        //! If the queue is full, the calling thread waits until some space becomes
+        //! available in the queue or the timeout expires.
+        //! @param [in,out] msg The message to enqueue. The message is moved into the queue on success only.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! If @a timeout is zero and the queue is full, return immediately.
+        //! @return True on success, false on error (queue still full after timeout).
+        //!
+        bool enqueue(MSG&& msg, cn::milliseconds timeout) { return enqueueWait(std::move(msg), _max_messages, &timeout); }
+
+        //!
+        //! Insert a message in the queue, even if the queue is full.
+        //! The message may use one of the RESERVED_MESSAGES additional slots. This can be used to
+        //! enqueue a message to instruct the consumer thread to terminate for instance. If the
+        //! reserved slots are also used, the calling thread waits until some space becomes available.
+        //! @param [in] msg The message to enqueue.
+        //!
+        void forceEnqueue(const MSG& msg) { enqueueWait(msg, _max_messages + RESERVED_MESSAGES, nullptr); }
+
+        //!
+        //! Insert a message in the queue, even if the queue is full.
+        //! @param [in,out] msg The message to enqueue. The message is moved into the queue.
+        //! @see forceEnqueue(const MSG&)
+        //!
+        void forceEnqueue(MSG&& msg) { enqueueWait(std::move(msg), _max_messages + RESERVED_MESSAGES, nullptr); }
+
+        //!
+        //! Remove a message from the queue.
+        //! Wait until a message is received.
+        //! @param [in,out] msg Received message. Its previous value is swapped into the queue slot.
+        //!
+        void dequeue(MSG& msg) { dequeueWait(msg, nullptr); }
+
+        //!
+        //! Remove a message from the queue.
+        //! Wait until a message is received or the timeout expires.
+        //! @param [in,out] msg Received message. Its previous value is swapped into the queue slot.
+        //! @param [in] timeout Maximum time to wait in milliseconds.
+        //! If @a timeout is zero and the queue is empty, return immediately.
+        //! @return True on success, false on error (queue still empty after timeout).
+        //!
+        bool dequeue(MSG& msg, cn::milliseconds timeout) { return dequeueWait(msg, &timeout); }
+
+        //!
+        //! Clear the content of the queue.
+        //!
+        void clear();
+
+    private:
+        // A slot in the ring buffer.
+        struct Cell
+        {
+            std::atomic<size_t> sequence {0};
+            MSG                 value {};
+        };
+
+        size_t                  _max_messages = 0;
+        size_t                  _mask = 0;             // Ring size minus one, the ring size is a power of 2.
+        std::unique_ptr<Cell[]> _cells {};
+
+        // The positions are incremented forever, the slot index is the position modulo the ring size.
+        // They are kept in separate cache lines to avoid false sharing between producers and consumers.
+        alignas(64) std::atomic<size_t> _enqueue_pos {0};
+        alignas(64) std::atomic<size_t> _dequeue_pos {0};
+
+        // Waiting threads. The mutex is only used when a thread needs to wait.
+        alignas(64) std::atomic<size_t> _waiting_producers {0};
+        std::atomic<size_t>     _waiting_consumers {0};
+        std::mutex              _mutex {};
+        std::condition_variable _enqueued {};  // Signaled when some message is inserted
+        std::condition_variable _dequeued {};  // Signaled when some message is removed
+
+        // Allocate the ring buffer.
+        void allocate(size_t maxMessages);
+
+        // Try to enqueue or dequeue a message without waiting. The queue is considered full at limit.
+        template <typename T>
+        bool tryEnqueue(T&& msg, size_t limit);
+        bool tryDequeue(MSG& msg);
+
+        // Enqueue or dequeue a message, wait when necessary. No timeout when null.
+        template <typename T>
+        bool enqueueWait(T&& msg, size_t limit, const cn::milliseconds* timeout);
+        bool dequeueWait(MSG& msg, const cn::milliseconds* timeout);
+
+        // Wake up waiting threads, if any.
+        static void Notify(std::atomic<size_t>& waiting, std::mutex& mutex, std::condition_variable& cond);
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+ts::BoundedMessageQueue<MSG>::BoundedMessageQueue(size_t maxMessages)
+{
+    allocate(maxMessages);
+}
+
+template <typename MSG>
+void ts::BoundedMessageQueue<MSG>::setMaxMessages(size_t maxMessages)
+{
+    allocate(maxMessages);
+}
+
+template <typename MSG>
+void ts::BoundedMessageQueue<MSG>::allocate(size_t maxMessages)
+{
+    _max_messages = maxMessages > 0 ? maxMessages : DEFAULT_MAX_MESSAGES;
+    const size_t ring_size = std::bit_ceil(_max_messages + RESERVED_MESSAGES);
+    _mask = ring_size - 1;
+    _cells.reset(new Cell[ring_size]);
+    for (size_t i = 0; i < ring_size; ++i) {
+        _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    _enqueue_pos.store(0, std::memory_order_relaxed);
+    _dequeue_pos.store(0, std::memory_order_release);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the number of messages in the queue.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+size_t ts::BoundedMessageQueue<MSG>::size() const
+{
+    const size_t deq = _dequeue_pos.load(std::memory_order_acquire);
+    const size_t enq = _enqueue_pos.load(std::memory_order_acquire);
+    return enq > deq ? enq - deq : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Try to enqueue or dequeue a message without waiting.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+template <typename T>
+bool ts::BoundedMessageQueue<MSG>::tryEnqueue(T&& msg, size_t limit)
+{
+    size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+        const size_t deq = _dequeue_pos.load(std::memory_order_acquire);
+        if (deq > pos) {
+            // Stale position, the queue has moved in the meantime.
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (pos - deq >= limit) {
+            return false;
+        }
+        cell = &_cells[pos & _mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (seq == pos) {
+            // Free slot, try to reserve it.
+            if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (seq < pos) {
+            // The slot still contains the message of the previous round, the queue is full.
+            return false;
+        }
+        else {
+            // Another producer took the slot.
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    cell->value = std::forward<T>(msg);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename MSG>
+bool ts::BoundedMessageQueue<MSG>::tryDequeue(MSG& msg)
+{
+    size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+        cell = &_cells[pos & _mask];
+        const size_t seq = cell->sequence.load(std::memory_order_acquire);
+        if (seq == pos + 1) {
+            // Message available, try to reserve it.
+            if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (seq < pos + 1) {
+            // The slot is not yet filled, the queue is empty.
+            return false;
+        }
+        else {
+            // Another consumer took the slot.
+            pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    using std::swap;
+    swap(msg, cell->value);
+    cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Wake up waiting threads, if any.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+void ts::BoundedMessageQueue<MSG>::Notify(std::atomic<size_t>& waiting, std::mutex& mutex, std::condition_variable& cond)
+{
+    // The fence orders the previous update of the ring before the check of waiting threads.
+    // A waiting thread holds the mutex between its last check of the ring and its wait.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed) > 0) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+        }
+        cond.notify_all();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Enqueue or dequeue a message, wait when necessary.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+template <typename T>
+bool ts::BoundedMessageQueue<MSG>::enqueueWait(T&& msg, size_t limit, const cn::milliseconds* timeout)
+{
+    bool success = tryEnqueue(std::forward<T>(msg), limit);
+    if (!success && (timeout == nullptr || *timeout > cn::milliseconds::zero())) {
+        // Short contention: retry a few times before waiting on the mutex.
+        for (size_t i = 0; !success && i < SPIN_COUNT; ++i) {
+            std::this_thread::yield();
+            success = tryEnqueue(std::forward<T>(msg), limit);
+        }
+    }
+    if (!success && (timeout == nullptr || *timeout > cn::milliseconds::zero())) {
+        const auto deadline = std::chrono::steady_clock::now() + (timeout == nullptr ? cn::milliseconds::zero() : *timeout);
+        std::unique_lock<std::mutex> lock(_mutex);
+        _waiting_producers++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!(success = tryEnqueue(std::forward<T>(msg), limit))) {
+            if (timeout == nullptr) {
+                _dequeued.wait(lock);
+            }
+            else if (_dequeued.wait_until(lock, deadline) == std::cv_status::timeout) {
+                success = tryEnqueue(std::forward<T>(msg), limit);
+                break;
+            }
+        }
+        _waiting_producers--;
+    }
+    if (success) {
+        Notify(_waiting_consumers, _mutex, _enqueued);
+    }
+    return success;
+}
+
+template <typename MSG>
+bool ts::BoundedMessageQueue<MSG>::dequeueWait(MSG& msg, const cn::milliseconds* timeout)
+{
+    bool success = tryDequeue(msg);
+    if (!success && (timeout == nullptr || *timeout > cn::milliseconds::zero())) {
+        // Short contention: retry a few times before waiting on the mutex.
+        for (size_t i = 0; !success && i < SPIN_COUNT; ++i) {
+            std::this_thread::yield();
+            success = tryDequeue(msg);
+        }
+    }
+    if (!success && (timeout == nullptr || *timeout > cn::milliseconds::zero())) {
+        const auto deadline = std::chrono::steady_clock::now() + (timeout == nullptr ? cn::milliseconds::zero() : *timeout);
+        std::unique_lock<std::mutex> lock(_mutex);
+        _waiting_consumers++;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        while (!(success = tryDequeue(msg))) {
+            if (timeout == nullptr) {
+                _enqueued.wait(lock);
+            }
+            else if (_enqueued.wait_until(lock, deadline) == std::cv_status::timeout) {
+                success = tryDequeue(msg);
+                break;
+            }
+        }
+        _waiting_consumers--;
+    }
+    if (success) {
+        Notify(_waiting_producers, _mutex, _dequeued);
+    }
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Clear the queue.
+//----------------------------------------------------------------------------
+
+template <typename MSG>
+void ts::BoundedMessageQueue<MSG>::clear()
+{
+    MSG msg {};
+    bool dropped = false;
+    while (tryDequeue(msg)) {
+        dropped = true;
+    }
+    if (dropped) {
+        Notify(_waiting_producers, _mutex, _dequeued);
+    }
+}
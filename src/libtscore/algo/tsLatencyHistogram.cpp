@@ -0,0 +1,184 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsLatencyHistogram.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::LatencyHistogram::LatencyHistogram(size_t precision) :
+    _precision(std::clamp<size_t>(precision, 2, 16)),
+    _half(size_t(1) << (_precision - 1)),
+    // First 2^precision exact buckets, then 2^(precision-1) buckets for each larger power of 2.
+    _buckets((66 - _precision) * _half)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Mapping between values and buckets.
+//----------------------------------------------------------------------------
+
+size_t ts::LatencyHistogram::bucketIndex(uint64_t value) const
+{
+    if (value < 2 * _half) {
+        return size_t(value);
+    }
+    else {
+        // Keep the 'precision' most significant bits of the value.
+        const size_t shift = size_t(std::bit_width(value)) - _precision;
+        return shift * _half + size_t(value >> shift);
+    }
+}
+
+uint64_t ts::LatencyHistogram::bucketHighest(size_t index) const
+{
+    if (index < 2 * _half) {
+        return index;
+    }
+    else {
+        const size_t shift = index / _half - 1;
+        const uint64_t low = uint64_t(index - shift * _half) << shift;
+        return low + ((uint64_t(1) << shift) - 1);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Reset the content of the histogram.
+//----------------------------------------------------------------------------
+
+void ts::LatencyHistogram::reset()
+{
+    for (auto& b : _buckets) {
+        b.store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+
+//----------------------------------------------------------------------------
+// Record a value.
+//----------------------------------------------------------------------------
+
+void ts::LatencyHistogram::record(uint64_t value, uint64_t count)
+{
+    if (count > 0) {
+        // The total count is incremented before the bucket (release) so that moveTo(), which
+        // acquires the bucket, can never decrement the total count below zero.
+        _count.fetch_add(count, std::memory_order_relaxed);
+        _buckets[bucketIndex(value)].fetch_add(count, std::memory_order_release);
+        _sum.fetch_add(value * count, std::memory_order_relaxed);
+        updateMinMax(value, value);
+    }
+}
+
+void ts::LatencyHistogram::updateMinMax(uint64_t min, uint64_t max)
+{
+    uint64_t current = _min.load(std::memory_order_relaxed);
+    while (min < current && !_min.compare_exchange_weak(current, min, std::memory_order_relaxed)) {
+    }
+    current = _max.load(std::memory_order_relaxed);
+    while (max > current && !_max.compare_exchange_weak(current, max, std::memory_order_relaxed)) {
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Move or add histograms.
+//----------------------------------------------------------------------------
+
+bool ts::LatencyHistogram::moveTo(LatencyHistogram& other)
+{
+    if (other._precision != _precision) {
+        return false;
+    }
+
+    // The count is the sum of the moved buckets, to remain consistent with concurrent recordings.
+    // Each recorded value is added to the total count before its bucket. Acquiring the buckets
+    // therefore guarantees that the total count already includes them and never underflows.
+    uint64_t moved = 0;
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+        const uint64_t n = _buckets[i].exchange(0, std::memory_order_acquire);
+        other._buckets[i].store(n, std::memory_order_relaxed);
+        moved += n;
+    }
+    other._count.store(moved, std::memory_order_relaxed);
+    _count.fetch_sub(moved, std::memory_order_relaxed);
+    other._sum.store(_sum.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    other._min.store(_min.exchange(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed), std::memory_order_relaxed);
+    other._max.store(_max.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    return true;
+}
+
+bool ts::LatencyHistogram::add(const LatencyHistogram& other)
+{
+    if (other._precision != _precision) {
+        return false;
+    }
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+        _buckets[i].fetch_add(other._buckets[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+    _count.fetch_add(other.count(), std::memory_order_relaxed);
+    _sum.fetch_add(other._sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    updateMinMax(other._min.load(std::memory_order_relaxed), other.maximum());
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Statistics on the recorded values.
+//----------------------------------------------------------------------------
+
+uint64_t ts::LatencyHistogram::minimum() const
+{
+    const uint64_t min = _min.load(std::memory_order_relaxed);
+    return min == std::numeric_limits<uint64_t>::max() ? 0 : min;
+}
+
+double ts::LatencyHistogram::mean() const
+{
+    const uint64_t count = this->count();
+    return count == 0 ? 0.0 : double(_sum.load(std::memory_order_relaxed)) / double(count);
+}
+
+uint64_t ts::LatencyHistogram::percentile(double percent) const
+{
+    const uint64_t count = this->count();
+    if (count == 0) {
+        return 0;
+    }
+
+    // Rank of the requested value, from 1 to count.
+    const uint64_t rank = std::clamp<uint64_t>(uint64_t(std::ceil(std::clamp(percent, 0.0, 100.0) * double(count) / 100.0)), 1, count);
+
+    uint64_t cumulated = 0;
+    for (size_t i = 0; i < _buckets.size(); ++i) {
+        cumulated += _buckets[i].load(std::memory_order_relaxed);
+        if (cumulated >= rank) {
+            return std::min(bucketHighest(i), maximum());
+        }
+    }
+    return maximum();
+}
+
+
+//----------------------------------------------------------------------------
+// Format a summary of the histogram as a one-line string.
+//----------------------------------------------------------------------------
+
+ts::UString ts::LatencyHistogram::summary(const UString& unit) const
+{
+    return UString::Format(u"count: %'d, min: %'d%s, p50: %'d%s, p99: %'d%s, p99.9: %'d%s, max: %'d%s",
+                           count(), minimum(), unit, percentile(50.0), unit, percentile(99.0), unit, percentile(99.9), unit, maximum(), unit);
+}
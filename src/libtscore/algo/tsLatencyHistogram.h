@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Fixed-memory high dynamic range histogram of latency values.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsUString.h"
+
+namespace ts {
+    //!
+    //! Fixed-memory high dynamic range histogram of latency values.
+    //! @ingroup libtscore cpp
+    //!
+    //! This is a log-linear histogram, in the style of HdrHistogram. Values are unsigned integers
+    //! in an application-defined unit (typically microseconds). Values lower than 2^precision are
+    //! recorded exactly. Larger values are recorded in buckets with a relative precision of
+    //! 2^(1-precision) (0.8% with the default precision of 8 bits). All values up to 2^64-1 are
+    //! supported. The memory is allocated in the constructor and never changes after that.
+    //!
+    //! Recording values with record() is lock-free and thread-safe: several threads may record
+    //! values in the same histogram concurrently. Another thread can atomically move all recorded
+    //! values into another histogram using moveTo(), typically at the end of a reporting interval.
+    //! All other methods, such as percentile(), are not thread-safe and should be used on a
+    //! histogram which is not concurrently updated, typically the target of moveTo().
+    //!
+    class TSCOREDLL LatencyHistogram
+    {
+        TS_NOCOPY(LatencyHistogram);
+    public:
+        //!
+        //! Default precision in bits.
+        //!
+        static constexpr size_t DEFAULT_PRECISION = 8;
+
+        //!
+        //! Constructor.
+        //! @param [in] precision Precision in bits, from 2 to 16. Values lower than 2^precision are recorded exactly.
+        //! The number of buckets, and the memory size, grows as 2^precision.
+        //!
+        explicit LatencyHistogram(size_t precision = DEFAULT_PRECISION);
+
+        //!
+        //! Get the precision in bits of the histogram.
+        //! @return The precision in bits of the histogram.
+        //!
+        size_t precision() const { return _precision; }
+
+        //!
+        //! Reset the content of the histogram. Not thread-safe.
+        //!
+        void reset();
+
+        //!
+        //! Record a value. Lock-free and thread-safe.
+        //! @param [in] value The value to record.
+        //! @param [in] count Number of occurrences of the value.
+        //!
+        void record(uint64_t value, uint64_t count = 1);
+
+        //!
+        //! Record a duration value. Lock-free and thread-safe.
+        //! @tparam DURATION The std::chrono::duration type which is used as unit in the histogram.
+        //! @param [in] value The duration to record. Negative durations are recorded as zero.
+        //!
+        template <class DURATION, class Rep, class Period>
+        void recordDuration(const cn::duration<Rep,Period>& value)
+        {
+            const auto count = cn::duration_cast<DURATION>(value).count();
+            record(count < 0 ? 0 : uint64_t(count));
+        }
+
+        //!
+        //! Atomically move all recorded values into another histogram. Lock-free.
+        //! This histogram is reset. Values which are concurrently recorded are either moved or kept
+        //! in this histogram for the next call, they are never lost.
+        //! @param [out] other The target histogram. It is reset first. It must have the same precision.
+        //! @return True on success, false if the two histograms have distinct precisions.
+        //!
+        bool moveTo(LatencyHistogram& other);
+
+        //!
+        //! Add all values from another histogram into this one. Not thread-safe.
+        //! @param [in] other The histogram to merge. It must have the same precision.
+        //! @return True on success, false if the two histograms have distinct precisions.
+        //!
+        bool add(const LatencyHistogram& other);
+
+        //!
+        //! Get the total number of recorded values.
+        //! @return The total number of recorded values.
+        //!
+        uint64_t count() const { return _count.load(std::memory_order_relaxed); }
+
+        //!
+        //! Get the minimum recorded value.
+        //! @return The minimum recorded value or zero if the histogram is empty.
+        //!
+        uint64_t minimum() const;
+
+        //!
+        //! Get the maximum recorded value.
+        //! @return The maximum recorded value or zero if the histogram is empty.
+        //!
+        uint64_t maximum() const { return _max.load(std::memory_order_relaxed); }
+
+        //!
+        //! Get the mean value of all recorded values.
+        //! @return The mean value or zero if the histogram is empty.
+        //!
+        double mean() const;
+
+        //!
+        //! Get the value at a given percentile.
+        //! @param [in] percent Percentile, from 0.0 to 100.0, for instance 99.9.
+        //! @return The highest value which is equivalent, within the precision of the histogram,
+        //! to the value at the given percentile. Never lower than the actual value. Zero if the
+        //! histogram is empty.
+        //!
+        uint64_t percentile(double percent) const;
+
+        //!
+        //! Format a summary of the histogram as a one-line string.
+        //! @param [in] unit Unit name to append to each value.
+        //! @return A string such as "count: 12, min: 2, p50: 5, p99: 12, p99.9: 12, max: 12".
+        //!
+        UString summary(const UString& unit = UString()) const;
+
+    private:
+        const size_t _precision;
+        const size_t _half;  // Number of buckets per power of 2, 2^(precision-1).
+        std::atomic<uint64_t> _count {0};
+        std::atomic<uint64_t> _sum {0};
+        std::atomic<uint64_t> _min {std::numeric_limits<uint64_t>::max()};
+        std::atomic<uint64_t> _max {0};
+        std::vector<std::atomic<uint64_t>> _buckets;
+
+        // Index of the bucket for a value.
+        size_t bucketIndex(uint64_t value) const;
+
+        // Highest value in a bucket.
+        uint64_t bucketHighest(size_t index) const;
+
+        // Atomically update minimum and maximum.
+        void updateMinMax(uint64_t min, uint64_t max);
+    };
+}
@@ -25,7 +25,7 @@ ts::InfluxSender::InfluxSender(Report* report, Object* owner) :
 
 bool ts::InfluxSender::start(const InfluxArgs& args)
 {
-    _queue.clear();
+    // The thread is not started, the queue can be reallocated.
     _queue.setMaxMessages(args.queue_size);
     return Thread::start();
 }
@@ -49,7 +49,8 @@ void ts::InfluxSender::stop()
 
 bool ts::InfluxSender::send(InfluxRequestPtr& request)
 {
-    if (_queue.enqueue(request, cn::milliseconds::zero())) {
+    if (_queue.enqueue(std::move(request), cn::milliseconds::zero())) {
+        request.reset();
         return true;
     }
     else {
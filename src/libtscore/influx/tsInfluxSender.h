@@ -14,7 +14,7 @@
 #pragma once
 #include "tsReporterBase.h"
 #include "tsThread.h"
-#include "tsMessageQueue.h"
+#include "tsBoundedMessageQueue.h"
 #include "tsInfluxArgs.h"
 #include "tsInfluxRequest.h"
 
@@ -59,7 +59,7 @@ namespace ts {
         bool send(InfluxRequestPtr& request);
 
     private:
-        MessageQueue<InfluxRequest> _queue {};
+        BoundedMessageQueue<InfluxRequestPtr> _queue {};
 
         // Thread main code.
         virtual void main() override;
@@ -8,6 +8,7 @@
 
 #include "tsIPProtocols.h"
 #include "tsNames.h"
+#include "tsMemory.h"
 
 
 //----------------------------------------------------------------------------
@@ -57,6 +58,30 @@ uint32_t ts::TCPSequenceDiff(uint32_t seq1, uint32_t seq2)
 }
 
 
+//----------------------------------------------------------------------------
+// Compute the total size of an RTP header.
+//----------------------------------------------------------------------------
+
+size_t ts::RTPHeaderSize(const uint8_t* data, size_t size)
+{
+    if (data == nullptr || size < RTP_HEADER_SIZE || (data[0] & 0xC0) != 0x80) {
+        return 0;
+    }
+
+    // Fixed header and CSRC list (CC field).
+    size_t header_size = RTP_HEADER_SIZE + 4 * (data[0] & 0x0F);
+
+    // Header extension (X bit): 16-bit profile-defined field and 16-bit length in 32-bit words.
+    if ((data[0] & 0x10) != 0) {
+        if (size < header_size + 4) {
+            return 0;
+        }
+        header_size += 4 + 4 * size_t(GetUInt16(data + header_size + 2));
+    }
+    return header_size <= size ? header_size : 0;
+}
+
+
 //----------------------------------------------------------------------------
 // VLAN identification.
 //----------------------------------------------------------------------------
@@ -155,6 +155,39 @@ namespace ts {
     //!
     using rtp_units = cn::duration<std::intmax_t, std::ratio<1, RTP_RATE_MP2T>>;
 
+    //!
+    //! Compute the total size of an RTP header, including the CSRC list and the header extension.
+    //! @ingroup net
+    //! @param [in] data Address of an RTP packet.
+    //! @param [in] size Size in bytes of the RTP packet.
+    //! @return The size in bytes of the RTP header or zero if the packet is not an RTP version 2 packet
+    //! or is too short to contain the complete RTP header.
+    //!
+    TSCOREDLL size_t RTPHeaderSize(const uint8_t* data, size_t size);
+
+    //------------------------------------------------------------------------
+    // SMPTE 2022-1 Forward Error Correction for RTP streams
+    //------------------------------------------------------------------------
+
+    constexpr size_t   FEC2022_HEADER_SIZE        =  16;  //!< Size in bytes of the SMPTE 2022-1 FEC header, after the RTP header.
+    constexpr uint8_t  FEC2022_RTP_PT             =  96;  //!< RTP payload type of SMPTE 2022-1 FEC packets (dynamic).
+    constexpr uint16_t FEC2022_COLUMN_PORT_OFFSET =   2;  //!< Offset to media UDP port of column FEC stream.
+    constexpr uint16_t FEC2022_ROW_PORT_OFFSET    =   4;  //!< Offset to media UDP port of row FEC stream.
+    constexpr size_t   FEC2022_MIN_COLUMNS        =   1;  //!< Minimum number of columns (L) in a SMPTE 2022-1 FEC matrix.
+    constexpr size_t   FEC2022_MAX_COLUMNS        =  20;  //!< Maximum number of columns (L) in a SMPTE 2022-1 FEC matrix.
+    constexpr size_t   FEC2022_MIN_ROWS           =   4;  //!< Minimum number of rows (D) in a SMPTE 2022-1 FEC matrix.
+    constexpr size_t   FEC2022_MAX_ROWS           =  20;  //!< Maximum number of rows (D) in a SMPTE 2022-1 FEC matrix.
+    constexpr size_t   FEC2022_MAX_MATRIX         = 100;  //!< Maximum number of media packets (L x D) in a SMPTE 2022-1 FEC matrix.
+
+    //!
+    //! Compute the difference between two RTP sequence numbers, including wrapping back at 0xFFFF.
+    //! @ingroup net
+    //! @param [in] seq1 First RTP sequence number.
+    //! @param [in] seq2 Second RTP sequence number.
+    //! @return The signed difference @a seq2 - @a seq1, in the range -32768 to 32767.
+    //!
+    inline int RTPSequenceDiff(uint16_t seq1, uint16_t seq2) { return int(int16_t(uint16_t(seq2 - seq1))); }
+
     //------------------------------------------------------------------------
     // Hyper-Text Transfer Protocol (HTTP)
     //------------------------------------------------------------------------
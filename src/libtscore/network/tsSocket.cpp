@@ -11,6 +11,11 @@
 #include "tsSysUtils.h"
 #include "tsException.h"
 #include "tsInitZero.h"
+#if defined(TS_UNIX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <poll.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
 
 
 //----------------------------------------------------------------------------
@@ -324,6 +329,47 @@ bool ts::Socket::setReceiveTimeout(cn::milliseconds timeout)
 }
 
 
+//----------------------------------------------------------------------------
+// Wait until data can be received on the socket, with a timeout.
+//----------------------------------------------------------------------------
+
+bool ts::Socket::waitReadable(cn::microseconds timeout, bool& ready)
+{
+    ready = false;
+
+    // The resolution of poll() is one millisecond, round up to avoid an early timeout.
+    const int ms = int(std::clamp<cn::microseconds::rep>((timeout.count() + 999) / 1000, 0, std::numeric_limits<int>::max()));
+
+#if defined(TS_WINDOWS)
+    ::WSAPOLLFD pfd {};
+    pfd.fd = _sock;
+    pfd.events = POLLRDNORM;
+    const int status = ::WSAPoll(&pfd, 1, ms);
+#else
+    ::pollfd pfd {};
+    pfd.fd = _sock;
+    pfd.events = POLLIN;
+    const int status = ::poll(&pfd, 1, ms);
+#endif
+
+    if (status < 0) {
+        const int err = LastSysErrorCode();
+#if defined(TS_UNIX)
+        if (err == EINTR) {
+            // Got a signal, the caller will wait again if necessary.
+            return true;
+        }
+#endif
+        report().error(u"error waiting for socket input: %s", SysErrorCodeMessage(err));
+        return false;
+    }
+
+    // Errors or hang-up are also reported as ready, the next receive operation reports them.
+    ready = status > 0;
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Set the "reuse port" option.
 //----------------------------------------------------------------------------
@@ -100,6 +100,15 @@ namespace ts {
         //!
         bool setReceiveTimeout(cn::milliseconds timeout);
 
+        //!
+        //! Wait until data can be received on the socket, with a timeout.
+        //! This is typically used with a blocking socket, to avoid waiting in a receive operation beyond some time.
+        //! @param [in] timeout Maximum time to wait, rounded up to the millisecond. Zero or negative means no wait.
+        //! @param [out] ready Set to true if a receive operation can be performed without blocking, false on timeout.
+        //! @return True on success, false on error.
+        //!
+        bool waitReadable(cn::microseconds timeout, bool& ready);
+
         //!
         //! Set the "reuse port" option.
         //! @param [in] reuse_port If true, the socket is allowed to reuse a local
@@ -118,6 +118,7 @@ bool ts::UDPSocket::closeImplementation(bool silent)
 {
     // Leave all multicast groups.
     const bool success = dropMembership();
+    _txtime = false;
 
     // Close socket
     return Socket::closeImplementation(silent) && success;
@@ -342,6 +343,37 @@ bool ts::UDPSocket::setReceiveTimestamps(bool on)
 }
 
 
+//----------------------------------------------------------------------------
+// Enable or disable the transmission of datagrams at a given time.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setTransmitTime(bool on)
+{
+    // SO_TXTIME cannot be removed from a socket. Disabling it only means that sendAt()
+    // no longer passes launch times to the kernel and datagrams are sent immediately.
+    if (!on) {
+        _txtime = false;
+        return true;
+    }
+#if defined(SO_TXTIME)
+    // The launch times are expressed on the monotonic clock, which is the steady clock on Linux.
+    ::sock_txtime config {};
+    config.clockid = CLOCK_MONOTONIC;
+    config.flags = 0;
+    report().debug(u"setting socket SO_TXTIME");
+    if (::setsockopt(getSocket(), SOL_SOCKET, SO_TXTIME, &config, sizeof(config)) != 0) {
+        report().error(u"socket option SO_TXTIME: %s", SysErrorCodeMessage());
+        return false;
+    }
+    _txtime = true;
+    return true;
+#else
+    report().error(u"transmission time (SO_TXTIME) is not supported on this system");
+    return false;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Enable or disable the broadcast option.
 //----------------------------------------------------------------------------
@@ -628,6 +660,50 @@ bool ts::UDPSocket::send(const void* data, size_t size, const IPSocketAddress& d
 }
 
 
+//----------------------------------------------------------------------------
+// Send a message to the default destination at a given time.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::sendAt(const void* data, size_t size, monotonic_time launch_time)
+{
+#if defined(SO_TXTIME)
+    if (_txtime) {
+        IPSocketAddress dest(_default_destination);
+        if (!checkNonBlocking(nullptr, u"UDPSocket::sendAt") || !convert(dest)) {
+            return false;
+        }
+        ::sockaddr_storage addr;
+        const size_t addr_size = dest.get(addr);
+
+        // The launch time is passed as ancillary data, in nanoseconds on the socket clock.
+        ::iovec vec {const_cast<void*>(data), size};
+        uint8_t control[CMSG_SPACE(sizeof(uint64_t))] {};
+        ::msghdr hdr {};
+        hdr.msg_name = &addr;
+        hdr.msg_namelen = socklen_t(addr_size);
+        hdr.msg_iov = &vec;
+        hdr.msg_iovlen = 1;
+        hdr.msg_control = control;
+        hdr.msg_controllen = sizeof(control);
+
+        ::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_TXTIME;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+        const uint64_t txtime = uint64_t(cn::duration_cast<cn::nanoseconds>(launch_time.time_since_epoch()).count());
+        MemCopy(CMSG_DATA(cmsg), &txtime, sizeof(txtime));
+
+        if (::sendmsg(getSocket(), &hdr, 0) < 0) {
+            report().error(u"error sending UDP message: %s", SysErrorCodeMessage());
+            return false;
+        }
+        return true;
+    }
+#endif
+    return send(data, size, _default_destination);
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 //----------------------------------------------------------------------------
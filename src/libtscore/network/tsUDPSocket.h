@@ -185,6 +185,32 @@ namespace ts {
         //!
         bool setReceiveTimestamps(bool on);
 
+        //!
+        //! Enable or disable the transmission of datagrams at a given time.
+        //!
+        //! When enabled, sendAt() passes the launch time of each datagram to the kernel, which
+        //! sends the datagram at that time. This is much more precise than waiting for the launch
+        //! time in the application. On Linux, this uses the socket option SO_TXTIME on the monotonic
+        //! clock and requires the "fq" queueing discipline on the outgoing network interface. With
+        //! other queueing disciplines, datagrams are sent immediately.
+        //!
+        //! This option is supported on Linux only. On other systems, enabling it is an error.
+        //!
+        //! The socket option cannot be removed from a socket. Disabling the transmission time is
+        //! always successful and makes sendAt() send the datagrams immediately, without launch time.
+        //!
+        //! @param [in] on If true, launch times are activated on the socket. Otherwise, they are disabled.
+        //! @return True on success, false on error.
+        //!
+        bool setTransmitTime(bool on);
+
+        //!
+        //! Check if the transmission of datagrams at a given time is enabled.
+        //! @return True if launch times are activated on the socket.
+        //! @see setTransmitTime()
+        //!
+        bool transmitTime() const { return _txtime; }
+
         //!
         //! Enable or disable the broadcast option.
         //!
@@ -314,6 +340,20 @@ namespace ts {
         //!
         virtual bool send(const void* data, size_t size, IOSB* iosb = nullptr);
 
+        //!
+        //! Send a message to the default destination address and port at a given time.
+        //!
+        //! When the transmission time is enabled using setTransmitTime(), the datagram is passed
+        //! immediately to the kernel, which sends it at @a launch_time. Otherwise, the datagram
+        //! is immediately sent. The socket must be in blocking mode.
+        //!
+        //! @param [in] data Address of the message to send.
+        //! @param [in] size Size in bytes of the message to send.
+        //! @param [in] launch_time Monotonic time at which the message shall be sent.
+        //! @return True on success, false on error.
+        //!
+        bool sendAt(const void* data, size_t size, monotonic_time launch_time);
+
         //!
         //! Type of timestamp which is returned by receive().
         //!
@@ -421,6 +461,7 @@ namespace ts {
 
         // Private members
         IPSocketAddress _default_destination {};
+        bool            _txtime = false;  // Transmission time is enabled (SO_TXTIME).
         MReqSet         _mcast {};    // Current set of IPv4 multicast memberships
         MReq6Set        _mcast6 {};   // Current set of IPv6 multicast memberships
 #if !defined(TS_NO_SSM)
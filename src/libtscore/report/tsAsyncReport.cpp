@@ -45,7 +45,7 @@ void ts::AsyncReport::terminate()
     if (!_terminated) {
         // Insert an "end of report" message in the queue.
         // This message will tell the logging thread to terminate.
-        _log_queue.forceEnqueue(new LogMessage {true, 0, UString()});
+        _log_queue.forceEnqueue(LogMessage {true, 0, UString()});
 
         // Wait for termination of the logging thread
         waitForTermination();
@@ -70,14 +70,14 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 #endif
 
     if (!_terminated) {
-        LogMessage* p = new LogMessage {false, severity, msg};
+        LogMessage lmsg {false, severity, msg};
         if (_synchronous) {
             // Synchronous mode, wait infinitely until the message is queued.
-            _log_queue.enqueue(p);
+            _log_queue.enqueue(std::move(lmsg));
         }
         else {
             // Enqueue the message immediately (timeout = 0), drop message on overflow.
-            _log_queue.enqueue(p, cn::milliseconds::zero());
+            _log_queue.enqueue(std::move(lmsg), cn::milliseconds::zero());
         }
     }
 }
@@ -89,7 +89,7 @@ void ts::AsyncReport::writeLog(int severity, const UString &msg)
 
 void ts::AsyncReport::main()
 {
-    LogMessagePtr msg;
+    LogMessage msg;
 
     // Notify subclasses (if any) of thread start.
     asyncThreadStarted();
@@ -99,15 +99,15 @@ void ts::AsyncReport::main()
         _log_queue.dequeue(msg);
 
         // Exit when received a termination message.
-        if (msg->terminate) {
+        if (msg.terminate) {
             break;
         }
 
         // Notify subclass of message (or log it on standard error).
-        asyncThreadLog(msg->severity, msg->message);
+        asyncThreadLog(msg.severity, msg.message);
 
         // Abort application on fatal error
-        if (msg->severity == Severity::Fatal) {
+        if (msg.severity == Severity::Fatal) {
             std::exit(EXIT_FAILURE);
         }
     }
@@ -14,7 +14,7 @@
 #pragma once
 #include "tsReport.h"
 #include "tsAsyncReportArgs.h"
-#include "tsMessageQueue.h"
+#include "tsBoundedMessageQueue.h"
 #include "tsThread.h"
 
 namespace ts {
@@ -113,14 +113,14 @@ namespace ts {
         virtual void main() override;
 
         // The application threads send that type of message to the logging thread
+        // Messages are stored by value in the queue, without allocation per message.
         struct LogMessage
         {
-            bool    terminate;
-            int     severity;
-            UString message;
+            bool    terminate = false;
+            int     severity = 0;
+            UString message {};
         };
-        using LogMessageQueue = MessageQueue<LogMessage>;
-        using LogMessagePtr = LogMessageQueue::MessagePtr;
+        using LogMessageQueue = BoundedMessageQueue<LogMessage>;
 
         // Private members:
         LogMessageQueue _log_queue {};
@@ -0,0 +1,481 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsDeferredLogger.h"
+#include "tsErrCodeReport.h"
+
+namespace {
+    // Maximum delay before writing pending lines in the output file.
+    constexpr cn::milliseconds FLUSH_INTERVAL = cn::milliseconds(100);
+
+    // Size of the output buffer after which the data are written in the file.
+    constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    // Unique identifiers of logging sessions. Never reused, even when a logger is deleted.
+    std::atomic<uint64_t> NextLoggerId {0};
+
+    // Cache of the rings of the current thread in the most recent logging sessions.
+    struct ThreadRing
+    {
+        uint64_t id = 0;
+        void*    ring = nullptr;
+    };
+    constexpr size_t MAX_THREAD_RINGS = 16;
+    thread_local std::vector<ThreadRing> ThreadRings;
+
+    // Format with a fixed number of arguments.
+    template <size_t... I>
+    void FormatArgs(ts::UString& text, const ts::UChar* fmt, ts::ArgMixIn* args, std::index_sequence<I...>)
+    {
+        text.format(fmt, args[I]...);
+    }
+
+    template <size_t N>
+    void FormatN(ts::UString& text, const ts::UChar* fmt, ts::ArgMixIn* args)
+    {
+        FormatArgs(text, fmt, args, std::make_index_sequence<N>());
+    }
+
+    // Table of formatting functions, indexed by number of arguments.
+    using FormatFunction = void (*)(ts::UString&, const ts::UChar*, ts::ArgMixIn*);
+
+    template <size_t... N>
+    constexpr std::array<FormatFunction, sizeof...(N)> MakeFormatTable(std::index_sequence<N...>)
+    {
+        return {&FormatN<N>...};
+    }
+
+    constexpr auto FormatTable = MakeFormatTable(std::make_index_sequence<ts::DeferredLogger::MAX_ARGS + 1>());
+}
+
+
+//----------------------------------------------------------------------------
+// Capture arguments in a line.
+//----------------------------------------------------------------------------
+
+bool ts::DeferredLogger::Line::captureValue(ArgType type, uint64_t value)
+{
+    if (_arg_count >= MAX_ARGS) {
+        return false;
+    }
+    Arg& arg(_args[_arg_count++]);
+    arg.type = type;
+    arg.offset = 0;
+    arg.value = value;
+    return true;
+}
+
+bool ts::DeferredLogger::Line::capture(const UChar* value)
+{
+    return value == nullptr ? captureString(value, 0) : captureString(value, std::char_traits<UChar>::length(value));
+}
+
+bool ts::DeferredLogger::Line::capture(const char* value)
+{
+    return value == nullptr ? captureString(value, 0) : captureString(value, std::char_traits<char>::length(value));
+}
+
+bool ts::DeferredLogger::Line::captureString(const UChar* str, size_t size)
+{
+    if (_arg_count >= MAX_ARGS || _char_count + size >= MAX_CHARS) {
+        return false;
+    }
+    UChar* const dest = _chars + _char_count;
+    for (size_t i = 0; i < size; ++i) {
+        // An embedded nul would truncate the reconstructed string.
+        if ((dest[i] = str[i]) == CHAR_NULL) {
+            return false;
+        }
+    }
+    dest[size] = CHAR_NULL;
+    Arg& arg(_args[_arg_count++]);
+    arg.type = STRING;
+    arg.offset = _char_count;
+    arg.value = 0;
+    _char_count += uint16_t(size + 1);
+    return true;
+}
+
+bool ts::DeferredLogger::Line::captureString(const char* str, size_t size)
+{
+    if (_arg_count >= MAX_ARGS || _char_count + size >= MAX_CHARS) {
+        return false;
+    }
+    UChar* const dest = _chars + _char_count;
+    for (size_t i = 0; i < size; ++i) {
+        // Only ASCII strings are captured, UTF-8 sequences are decoded by UString::Format().
+        const uint8_t c = uint8_t(str[i]);
+        if (c == 0 || c >= 0x80) {
+            return false;
+        }
+        dest[i] = UChar(c);
+    }
+    dest[size] = CHAR_NULL;
+    Arg& arg(_args[_arg_count++]);
+    arg.type = STRING;
+    arg.offset = _char_count;
+    arg.value = 0;
+    _char_count += uint16_t(size + 1);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Add segments in a line.
+//----------------------------------------------------------------------------
+
+void ts::DeferredLogger::Line::addSegment(const UChar* fmt, size_t arg_first)
+{
+    Segment& seg(_segments[_segment_count++]);
+    seg.format = fmt;
+    seg.arg_first = uint8_t(arg_first);
+    seg.arg_count = uint8_t(_arg_count - arg_first);
+    seg.text_first = seg.text_size = 0;
+}
+
+void ts::DeferredLogger::Line::addText(const UString& text)
+{
+    if (_segment_count > 0 && _segments[_segment_count - 1].format == nullptr) {
+        // Extend the previous pre-formatted segment.
+        _segments[_segment_count - 1].text_size += uint32_t(text.size());
+        _text.append(text);
+    }
+    else if (_segment_count < MAX_SEGMENTS) {
+        Segment& seg(_segments[_segment_count++]);
+        seg.format = nullptr;
+        seg.arg_first = seg.arg_count = 0;
+        seg.text_first = uint32_t(_text.size());
+        seg.text_size = uint32_t(text.size());
+        _text.append(text);
+    }
+    else {
+        // No more segment, format the complete line now.
+        UString line;
+        toString(line);
+        line.append(text);
+        _segment_count = 1;
+        _arg_count = 0;
+        _char_count = 0;
+        _segments[0].format = nullptr;
+        _segments[0].arg_first = _segments[0].arg_count = 0;
+        _segments[0].text_first = 0;
+        _segments[0].text_size = uint32_t(line.size());
+        _text.swap(line);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Format a line.
+//----------------------------------------------------------------------------
+
+ts::UString ts::DeferredLogger::Line::toString() const
+{
+    UString text;
+    toString(text);
+    return text;
+}
+
+void ts::DeferredLogger::Line::toString(UString& text) const
+{
+    text.clear();
+
+    // ArgMixIn instances cannot be assigned, they are rebuilt in place for each segment.
+    alignas(ArgMixIn) uint8_t storage[MAX_ARGS * sizeof(ArgMixIn)];
+    ArgMixIn* const args = reinterpret_cast<ArgMixIn*>(storage);
+
+    for (size_t iseg = 0; iseg < _segment_count; ++iseg) {
+        const Segment& seg(_segments[iseg]);
+        if (seg.format == nullptr) {
+            text.append(_text, seg.text_first, seg.text_size);
+            continue;
+        }
+        // Rebuild the arguments with the same types as the original ones.
+        for (size_t i = 0; i < seg.arg_count; ++i) {
+            const Arg& arg(_args[seg.arg_first + i]);
+            void* const place = args + i;
+            switch (arg.type) {
+                case BOOL: new (place) ArgMixIn(arg.value != 0); break;
+                case INT8: new (place) ArgMixIn(int8_t(arg.value)); break;
+                case UINT8: new (place) ArgMixIn(uint8_t(arg.value)); break;
+                case INT16: new (place) ArgMixIn(int16_t(arg.value)); break;
+                case UINT16: new (place) ArgMixIn(uint16_t(arg.value)); break;
+                case INT32: new (place) ArgMixIn(int32_t(arg.value)); break;
+                case UINT32: new (place) ArgMixIn(uint32_t(arg.value)); break;
+                case INT64: new (place) ArgMixIn(int64_t(arg.value)); break;
+                case UINT64: new (place) ArgMixIn(uint64_t(arg.value)); break;
+                case DOUBLE: new (place) ArgMixIn(std::bit_cast<double>(arg.value)); break;
+                case STRING: new (place) ArgMixIn(_chars + arg.offset); break;
+                default: new (place) ArgMixIn(); break;
+            }
+        }
+        FormatTable[seg.arg_count](text, seg.format, args);
+        for (size_t i = 0; i < seg.arg_count; ++i) {
+            args[i].~ArgMixIn();
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::DeferredLogger::DeferredLogger(Report& report, size_t ring_size) :
+    _report(report),
+    _ring_size(ring_size > 0 ? ring_size : DEFAULT_RING_SIZE)
+{
+}
+
+ts::DeferredLogger::~DeferredLogger()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Start and stop the logger.
+//----------------------------------------------------------------------------
+
+bool ts::DeferredLogger::open(const fs::path& file_name, uint64_t max_size, size_t max_files)
+{
+    if (_open) {
+        _report.error(u"deferred logger already started");
+        return false;
+    }
+
+    _file_name = file_name;
+    _max_size = max_size;
+    _max_files = max_files;
+    _file_error = false;
+    _buffer.clear();
+    _current_files.clear();
+    if (!_file_name.empty()) {
+        if (_max_size > 0) {
+            _name_gen.initCounter(_file_name);
+        }
+        if (!openFile()) {
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _rings.clear();
+        _terminate = false;
+        _flush_request = _flush_done = 0;
+    }
+    _pending = false;
+    _id = ++NextLoggerId;
+
+    if (!start()) {
+        _report.error(u"cannot start deferred logger thread");
+        _file.close();
+        return false;
+    }
+    _open = true;
+    return true;
+}
+
+void ts::DeferredLogger::close()
+{
+    if (_open) {
+        _open = false;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _terminate = true;
+        }
+        _wake.notify_one();
+        waitForTermination();
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _rings.clear();
+        _file.close();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the ring of the current thread, create it if necessary.
+//----------------------------------------------------------------------------
+
+ts::DeferredLogger::LineQueue* ts::DeferredLogger::threadRing()
+{
+    for (const auto& tr : ThreadRings) {
+        if (tr.id == _id) {
+            return reinterpret_cast<LineQueue*>(tr.ring);
+        }
+    }
+
+    // First line from this thread in this session.
+    LineQueue* ring = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _rings.push_back(std::make_unique<LineQueue>(_ring_size));
+        ring = _rings.back().get();
+    }
+    if (ThreadRings.size() >= MAX_THREAD_RINGS) {
+        ThreadRings.erase(ThreadRings.begin());
+    }
+    ThreadRings.push_back(ThreadRing{_id, ring});
+    return ring;
+}
+
+
+//----------------------------------------------------------------------------
+// Log a line.
+//----------------------------------------------------------------------------
+
+void ts::DeferredLogger::log(Line&& line)
+{
+    if (_open) {
+        // Wait when the ring is full, never drop a line.
+        threadRing()->enqueue(std::move(line));
+
+        // Wake up the background thread when it may be sleeping.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!_pending.load(std::memory_order_relaxed) && !_pending.exchange(true)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _wake.notify_one();
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Wait until all previous lines are written.
+//----------------------------------------------------------------------------
+
+void ts::DeferredLogger::flush()
+{
+    if (_open) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        const uint64_t request = ++_flush_request;
+        _wake.notify_one();
+        _flushed.wait(lock, [this, request]() { return _flush_done >= request; });
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Output files management.
+//----------------------------------------------------------------------------
+
+bool ts::DeferredLogger::openFile()
+{
+    const fs::path name(_max_size > 0 ? _name_gen.newFileName() : _file_name);
+    _report.verbose(u"creating %s", name);
+    _file.open(name, std::ios::out);
+    if (!_file) {
+        _report.error(u"cannot create %s", name);
+        _file_error = true;
+        return false;
+    }
+    _current_name = name;
+    _file_size = 0;
+
+    // Purge obsolete files.
+    if (_max_size > 0 && _max_files > 0) {
+        _current_files.push_back(name);
+        while (_current_files.size() > _max_files) {
+            const fs::path obsolete(_current_files.front());
+            _current_files.pop_front();
+            _report.verbose(u"deleting obsolete file %s", obsolete);
+            fs::remove(obsolete, &ErrCodeReport(_report, u"error deleting", obsolete));
+        }
+    }
+    return true;
+}
+
+void ts::DeferredLogger::writeBuffer()
+{
+    if (!_buffer.empty() && _file.is_open()) {
+        _file.write(_buffer.data(), std::streamsize(_buffer.size()));
+        if (!_file && !_file_error) {
+            _report.error(u"error writing %s", _current_name);
+            _file_error = true;
+        }
+        _file_size += _buffer.size();
+    }
+    _buffer.clear();
+}
+
+void ts::DeferredLogger::rotateFile()
+{
+    writeBuffer();
+    _file.close();
+    openFile();
+}
+
+
+//----------------------------------------------------------------------------
+// Background thread.
+//----------------------------------------------------------------------------
+
+void ts::DeferredLogger::main()
+{
+    std::vector<LineQueue*> rings;
+    Line line;
+    UString text;
+    monotonic_time last_flush = monotonic_time::clock::now();
+
+    for (;;) {
+        bool terminate = false;
+        uint64_t flush_request = 0;
+
+        // Wait for new lines or some request.
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _wake.wait_for(lock, FLUSH_INTERVAL, [this]() { return _pending || _terminate || _flush_request > _flush_done; });
+            _pending = false;
+            terminate = _terminate;
+            flush_request = _flush_request;
+            rings.clear();
+            for (const auto& r : _rings) {
+                rings.push_back(r.get());
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        // Format all pending lines.
+        for (auto ring : rings) {
+            while (ring->dequeue(line, cn::milliseconds::zero())) {
+                line.toString(text);
+                if (_file_name.empty()) {
+                    _report.log(line.severity(), text);
+                }
+                else if (_file.is_open()) {
+                    _buffer.append(text.toUTF8());
+                    _buffer.push_back('\n');
+                    if (_max_size > 0 && _file_size + _buffer.size() >= _max_size) {
+                        rotateFile();
+                    }
+                    else if (_buffer.size() >= BUFFER_SIZE) {
+                        writeBuffer();
+                    }
+                }
+            }
+        }
+
+        // Write the file periodically or on request.
+        const monotonic_time now = monotonic_time::clock::now();
+        if (terminate || flush_request > _flush_done || now >= last_flush + FLUSH_INTERVAL) {
+            writeBuffer();
+            if (_file.is_open()) {
+                _file.flush();
+            }
+            last_flush = now;
+            std::lock_guard<std::mutex> lock(_mutex);
+            _flush_done = flush_request;
+            _flushed.notify_all();
+        }
+        if (terminate) {
+            break;
+        }
+    }
+}
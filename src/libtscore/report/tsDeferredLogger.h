@@ -0,0 +1,314 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Logger with deferred formatting of messages in a background thread.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsReport.h"
+#include "tsBoundedMessageQueue.h"
+#include "tsFileNameGenerator.h"
+#include "tsThread.h"
+
+namespace ts {
+    //!
+    //! Logger with deferred formatting of messages in a background thread.
+    //! @ingroup libtscore log
+    //!
+    //! This class is designed for high-rate logging from packet processing threads.
+    //! The calling thread does not format the message. It only builds a compact binary
+    //! record, a DeferredLogger::Line, containing the address of the format string and
+    //! a copy of the arguments. The record is pushed into a ring which is private to the
+    //! calling thread. A background thread collects the records from all rings, formats
+    //! them using UString::Format(), and writes them in batch into a text file or logs
+    //! them on a Report.
+    //!
+    //! The formatted text is exactly the same as with UString::Format() on the same
+    //! format and arguments. Integers, booleans, floating point values and short strings
+    //! are captured in the record. Other types of arguments, as well as long strings, are
+    //! formatted immediately in the calling thread, as a fallback.
+    //!
+    //! When writing in a file, the file can be rotated: when its size exceeds a limit,
+    //! it is closed and another one is created, using the same naming rules as in
+    //! TSFileOutputArgs (@c foo-000000.txt, @c foo-000001.txt, etc). The number of
+    //! files can be limited, the oldest files are deleted.
+    //!
+    //! No line is ever dropped. When the ring of a thread is full, the thread waits until
+    //! the background thread makes some room. The lines from one thread are written in
+    //! their logging order. The relative order of lines from distinct threads is not
+    //! specified.
+    //!
+    class TSCOREDLL DeferredLogger : private Thread
+    {
+        TS_NOCOPY(DeferredLogger);
+    public:
+        //!
+        //! Maximum number of captured arguments in one line.
+        //!
+        static constexpr size_t MAX_ARGS = 12;
+        //!
+        //! Maximum number of format strings in one line.
+        //!
+        static constexpr size_t MAX_SEGMENTS = 4;
+        //!
+        //! Maximum number of characters in captured string arguments in one line.
+        //!
+        static constexpr size_t MAX_CHARS = 160;
+        //!
+        //! Default number of lines in the ring of each logging thread.
+        //!
+        static constexpr size_t DEFAULT_RING_SIZE = 1024;
+
+        //!
+        //! Binary record of one line to log.
+        //!
+        //! A line is made of one or more format strings with their arguments.
+        //! The formatted line is the concatenation of all formatted strings.
+        //! The format strings are not copied, only their addresses are stored.
+        //! They must remain valid until the line is written. This is always
+        //! the case with string literals.
+        //!
+        class TSCOREDLL Line
+        {
+        public:
+            //!
+            //! Constructor.
+            //! @param [in] severity Message severity, used when the lines are logged on a Report.
+            //!
+            Line(int severity = Severity::Info) : _severity(severity) {}
+
+            //!
+            //! Get the message severity.
+            //! @return The message severity.
+            //!
+            int severity() const { return _severity; }
+
+            //!
+            //! Append a format string and its arguments to the line.
+            //! @param [in] fmt Format string with embedded '\%' sequences, as in UString::Format().
+            //! It must remain valid until the line is written by the logger.
+            //! @param [in] args List of arguments to substitute in the format string.
+            //! @return A reference to this object.
+            //!
+            template <class... Args>
+            Line& format(const UChar* fmt, Args&&... args);
+
+            //!
+            //! Format the line.
+            //! This is what the background thread of the logger does.
+            //! @param [out] text Formatted text.
+            //!
+            void toString(UString& text) const;
+
+            //!
+            //! Format the line.
+            //! @return Formatted text.
+            //!
+            UString toString() const;
+
+        private:
+            // Type of a captured argument.
+            enum ArgType : uint8_t {BOOL, INT8, UINT8, INT16, UINT16, INT32, UINT32, INT64, UINT64, DOUBLE, STRING};
+
+            // A captured argument, strings are stored in _chars.
+            struct Arg
+            {
+                ArgType  type = BOOL;
+                uint16_t offset = 0;   // STRING: offset in _chars of the nul-terminated string.
+                uint64_t value = 0;    // Integer values, bit pattern of doubles.
+            };
+
+            // A segment of the line: a format string with its arguments, or pre-formatted text.
+            struct Segment
+            {
+                const UChar* format = nullptr;  // Null means pre-formatted text in _text.
+                uint8_t      arg_first = 0;
+                uint8_t      arg_count = 0;
+                uint32_t     text_first = 0;
+                uint32_t     text_size = 0;
+            };
+
+            int      _severity = Severity::Info;
+            uint8_t  _segment_count = 0;
+            uint8_t  _arg_count = 0;
+            uint16_t _char_count = 0;
+            Segment  _segments[MAX_SEGMENTS] {};
+            Arg      _args[MAX_ARGS] {};
+            UChar    _chars[MAX_CHARS] {};
+            UString  _text {};  // Pre-formatted text, when arguments cannot be captured.
+
+            // Capture arguments, return false when not possible.
+            bool capture(bool value) { return captureValue(BOOL, value); }
+            bool capture(const UChar* value);
+            bool capture(const char* value);
+            bool capture(const UString& value) { return captureString(value.data(), value.size()); }
+            bool capture(const std::string& value) { return captureString(value.data(), value.size()); }
+
+            template <typename T> requires ts::int_enum<T>
+            bool capture(const T& value);
+
+            template <typename T> requires std::floating_point<T>
+            bool capture(const T& value) { return captureValue(DOUBLE, std::bit_cast<uint64_t>(double(value))); }
+
+            template <typename T>
+            bool capture(const T&) { return false; }
+
+            bool captureValue(ArgType type, uint64_t value);
+            bool captureString(const UChar* str, size_t size);
+            bool captureString(const char* str, size_t size);
+
+            // Close the current segment of captured arguments.
+            void addSegment(const UChar* fmt, size_t arg_first);
+
+            // Add pre-formatted text, flatten the line if there is no more segment.
+            void addText(const UString& text);
+        };
+
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report errors. When the lines are not written in a file,
+        //! they are logged on this report. The @a report object must remain valid as long as this
+        //! object exists. It is used from the background thread.
+        //! @param [in] ring_size Number of lines in the ring of each logging thread.
+        //!
+        DeferredLogger(Report& report, size_t ring_size = DEFAULT_RING_SIZE);
+
+        //!
+        //! Destructor.
+        //! The background thread is terminated, all pending lines are written.
+        //!
+        virtual ~DeferredLogger() override;
+
+        //!
+        //! Start the logger.
+        //! @param [in] file_name Name of the output text file. If empty, the lines are logged on the report.
+        //! @param [in] max_size When non-zero, maximum size in bytes of an output file. When the file grows
+        //! beyond this size, it is closed and another file is created, with a counter in the file name.
+        //! @param [in] max_files When non-zero with @a max_size, maximum number of files to keep.
+        //! @return True on success, false on error.
+        //!
+        bool open(const fs::path& file_name = fs::path(), uint64_t max_size = 0, size_t max_files = 0);
+
+        //!
+        //! Stop the logger.
+        //! All pending lines are written, the background thread is terminated and the file is closed.
+        //! This method must not be called while other threads are still logging.
+        //!
+        void close();
+
+        //!
+        //! Check if the logger is started.
+        //! @return True if the logger is started.
+        //!
+        bool isOpen() const { return _open; }
+
+        //!
+        //! Log a line.
+        //! The line is ignored if the logger is not started.
+        //! @param [in,out] line The line to log. The line is moved into the ring of the calling thread.
+        //!
+        void log(Line&& line);
+
+        //!
+        //! Log a line with one format string and its arguments.
+        //! The line is ignored if the logger is not started.
+        //! @param [in] severity Message severity.
+        //! @param [in] fmt Format string with embedded '\%' sequences, as in UString::Format().
+        //! @param [in] args List of arguments to substitute in the format string.
+        //!
+        template <class... Args>
+        void log(int severity, const UChar* fmt, Args&&... args)
+        {
+            if (_open) {
+                Line line(severity);
+                line.format(fmt, std::forward<Args>(args)...);
+                log(std::move(line));
+            }
+        }
+
+        //!
+        //! Wait until all lines which were previously logged are written.
+        //!
+        void flush();
+
+    private:
+        using LineQueue = BoundedMessageQueue<Line>;
+
+        Report&                 _report;
+        const size_t            _ring_size;
+        volatile bool           _open = false;
+        uint64_t                _id = 0;                // Unique id of the current session, for thread-local rings.
+        std::atomic_bool        _pending {false};       // Some line was logged since last wake-up.
+        std::mutex              _mutex {};              // Protect all fields below.
+        std::condition_variable _wake {};               // Wake up the background thread.
+        std::condition_variable _flushed {};            // Signaled when _flush_done is updated.
+        std::vector<std::unique_ptr<LineQueue>> _rings {};
+        bool                    _terminate = false;
+        uint64_t                _flush_request = 0;
+        uint64_t                _flush_done = 0;
+
+        // Output file, used in background thread only after open().
+        fs::path                _file_name {};
+        fs::path                _current_name {};
+        uint64_t                _max_size = 0;
+        size_t                  _max_files = 0;
+        uint64_t                _file_size = 0;
+        bool                    _file_error = false;
+        std::ofstream           _file {};
+        std::string             _buffer {};
+        FileNameGenerator       _name_gen {};
+        std::list<fs::path>     _current_files {};
+
+        // Get the ring of the current thread, create it if necessary.
+        LineQueue* threadRing();
+
+        // Output files management.
+        bool openFile();
+        void writeBuffer();
+        void rotateFile();
+
+        // Implementation of Thread.
+        virtual void main() override;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+template <class... Args>
+ts::DeferredLogger::Line& ts::DeferredLogger::Line::format(const UChar* fmt, Args&&... args)
+{
+    const size_t arg_first = _arg_count;
+    const size_t char_count = _char_count;
+    if (_segment_count < MAX_SEGMENTS && (capture(args) && ...)) {
+        addSegment(fmt, arg_first);
+    }
+    else {
+        // Drop partially captured arguments and format now.
+        _arg_count = uint8_t(arg_first);
+        _char_count = uint16_t(char_count);
+        addText(UString::Format(fmt, std::forward<Args>(args)...));
+    }
+    return *this;
+}
+
+template <typename T> requires ts::int_enum<T>
+bool ts::DeferredLogger::Line::capture(const T& value)
+{
+    using U = typename ts::underlying_type<T>::type;
+    constexpr bool sign = std::is_signed<U>::value;
+    constexpr ArgType type =
+        sizeof(T) == 1 ? (sign ? INT8 : UINT8) :
+        sizeof(T) == 2 ? (sign ? INT16 : UINT16) :
+        sizeof(T) == 4 ? (sign ? INT32 : UINT32) : (sign ? INT64 : UINT64);
+    return captureValue(type, sign ? uint64_t(int64_t(static_cast<U>(value))) : uint64_t(static_cast<U>(value)));
+}
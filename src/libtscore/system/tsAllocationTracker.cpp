@@ -0,0 +1,116 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsAllocationTracker.h"
+
+bool ts::AllocationTracker::_enabled = false;
+
+// The counters are updated from the global operators new and delete.
+// They shall not allocate memory and shall not need dynamic initialization.
+namespace {
+    std::atomic<uint64_t> _process_allocations {0};
+    std::atomic<uint64_t> _process_deallocations {0};
+    std::atomic<uint64_t> _process_bytes {0};
+    thread_local uint64_t _thread_allocations = 0;
+    thread_local uint64_t _thread_deallocations = 0;
+    thread_local uint64_t _thread_bytes = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the allocation counters.
+//----------------------------------------------------------------------------
+
+ts::AllocationTracker::Counters ts::AllocationTracker::Counters::operator-(const Counters& other) const
+{
+    Counters diff;
+    diff.allocations = allocations - other.allocations;
+    diff.deallocations = deallocations - other.deallocations;
+    diff.bytes = bytes - other.bytes;
+    return diff;
+}
+
+ts::AllocationTracker::Counters ts::AllocationTracker::Process()
+{
+    Counters counters;
+    counters.allocations = _process_allocations.load(std::memory_order_relaxed);
+    counters.deallocations = _process_deallocations.load(std::memory_order_relaxed);
+    counters.bytes = _process_bytes.load(std::memory_order_relaxed);
+    return counters;
+}
+
+ts::AllocationTracker::Counters ts::AllocationTracker::CurrentThread()
+{
+    Counters counters;
+    counters.allocations = _thread_allocations;
+    counters.deallocations = _thread_deallocations;
+    counters.bytes = _thread_bytes;
+    return counters;
+}
+
+
+//----------------------------------------------------------------------------
+// Allocate and count memory.
+//----------------------------------------------------------------------------
+
+void* ts::AllocationTracker::Allocate(size_t size, size_t align) noexcept
+{
+    // Zero-size allocations shall return distinct addresses.
+    size = std::max<size_t>(size, 1);
+
+    void* ptr = nullptr;
+    if (align <= alignof(std::max_align_t)) {
+        ptr = std::malloc(size);
+    }
+    else {
+#if defined(TS_WINDOWS)
+        ptr = ::_aligned_malloc(size, align);
+#else
+        if (::posix_memalign(&ptr, align, size) != 0) {
+            ptr = nullptr;
+        }
+#endif
+    }
+
+    if (ptr != nullptr) {
+        _process_allocations.fetch_add(1, std::memory_order_relaxed);
+        _process_bytes.fetch_add(size, std::memory_order_relaxed);
+        _thread_allocations++;
+        _thread_bytes += size;
+    }
+    return ptr;
+}
+
+void* ts::AllocationTracker::AllocateOrThrow(size_t size, size_t align)
+{
+    void* ptr = Allocate(size, align);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Free and count memory.
+//----------------------------------------------------------------------------
+
+void ts::AllocationTracker::Deallocate(void* ptr, size_t align) noexcept
+{
+    if (ptr != nullptr) {
+        _process_deallocations.fetch_add(1, std::memory_order_relaxed);
+        _thread_deallocations++;
+#if defined(TS_WINDOWS)
+        if (align > alignof(std::max_align_t)) {
+            ::_aligned_free(ptr);
+            return;
+        }
+#endif
+        std::free(ptr);
+    }
+}
@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Count heap allocations, for benchmarking and profiling.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+#include "tsBeforeStandardHeaders.h"
+#include <new>
+#include "tsAfterStandardHeaders.h"
+
+namespace ts {
+    //!
+    //! Count heap allocations, for benchmarking and profiling.
+    //! @ingroup libtscore system
+    //!
+    //! This class counts the calls to the global operators new and delete, in the process and
+    //! in each thread. The counting is active only when the application replaces the global
+    //! operators using the macro TS_TRACK_ALLOCATIONS in one of its source files, typically
+    //! next to TS_MAIN. Otherwise, all counters remain zero.
+    //!
+    //! On Windows, the replacement operators are used by the executable only. The allocations
+    //! in the TSDuck DLL's are not counted. On UNIX systems, all allocations are counted.
+    //!
+    class TSCOREDLL AllocationTracker
+    {
+    public:
+        //!
+        //! Allocation counters.
+        //!
+        class TSCOREDLL Counters
+        {
+        public:
+            uint64_t allocations = 0;    //!< Number of allocations.
+            uint64_t deallocations = 0;  //!< Number of deallocations.
+            uint64_t bytes = 0;          //!< Total size in bytes of allocations.
+
+            //!
+            //! Difference between two sets of counters, typically after and before some processing.
+            //! @param [in] other Counters to subtract from this object.
+            //! @return The difference between the counters.
+            //!
+            Counters operator-(const Counters& other) const;
+        };
+
+        //!
+        //! Check if the allocations are counted.
+        //! @return True if the application uses TS_TRACK_ALLOCATIONS.
+        //!
+        static bool Enabled() { return _enabled; }
+
+        //!
+        //! Get the allocation counters of the process, in all threads.
+        //! @return The allocation counters of the process.
+        //!
+        static Counters Process();
+
+        //!
+        //! Get the allocation counters of the current thread.
+        //! @return The allocation counters of the current thread.
+        //!
+        static Counters CurrentThread();
+
+        //!
+        //! Allocate and count memory, used by TS_TRACK_ALLOCATIONS.
+        //! @param [in] size Size in bytes.
+        //! @param [in] align Alignment in bytes, zero for default alignment.
+        //! @return Address of the allocated memory or null pointer on error.
+        //!
+        static void* Allocate(size_t size, size_t align = 0) noexcept;
+
+        //!
+        //! Allocate and count memory, used by TS_TRACK_ALLOCATIONS.
+        //! @param [in] size Size in bytes.
+        //! @param [in] align Alignment in bytes, zero for default alignment.
+        //! @return Address of the allocated memory.
+        //! @throw std::bad_alloc When the memory cannot be allocated.
+        //!
+        static void* AllocateOrThrow(size_t size, size_t align = 0);
+
+        //!
+        //! Free and count memory, used by TS_TRACK_ALLOCATIONS.
+        //! @param [in] ptr Address of memory which was returned by Allocate(). Ignored when null.
+        //! @param [in] align Alignment in bytes, must be the same value as in Allocate().
+        //!
+        static void Deallocate(void* ptr, size_t align = 0) noexcept;
+
+        //!
+        //! Enable counting, used by TS_TRACK_ALLOCATIONS.
+        //! @return True.
+        //!
+        static bool Enable() { return _enabled = true; }
+
+    private:
+        static bool _enabled;
+    };
+}
+
+//!
+//! A macro which replaces the global operators new and delete with counting versions.
+//! Use it once in one source file of an executable, typically the one using TS_MAIN.
+//! @ingroup libtscore system
+//! @see ts::AllocationTracker
+//! @hideinitializer
+//!
+#define TS_TRACK_ALLOCATIONS()                                                                                                                                \
+    static const bool TS_UNIQUE_NAME(_ts_track_allocations) = ts::AllocationTracker::Enable();                                                                \
+    void* operator new(std::size_t size) { return ts::AllocationTracker::AllocateOrThrow(size); }                                                             \
+    void* operator new[](std::size_t size) { return ts::AllocationTracker::AllocateOrThrow(size); }                                                           \
+    void* operator new(std::size_t size, std::align_val_t al) { return ts::AllocationTracker::AllocateOrThrow(size, size_t(al)); }                            \
+    void* operator new[](std::size_t size, std::align_val_t al) { return ts::AllocationTracker::AllocateOrThrow(size, size_t(al)); }                          \
+    void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return ts::AllocationTracker::Allocate(size); }                                    \
+    void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return ts::AllocationTracker::Allocate(size); }                                  \
+    void* operator new(std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return ts::AllocationTracker::Allocate(size, size_t(al)); }   \
+    void* operator new[](std::size_t size, std::align_val_t al, const std::nothrow_t&) noexcept { return ts::AllocationTracker::Allocate(size, size_t(al)); } \
+    void operator delete(void* ptr) noexcept { ts::AllocationTracker::Deallocate(ptr); }                                                                      \
+    void operator delete[](void* ptr) noexcept { ts::AllocationTracker::Deallocate(ptr); }                                                                    \
+    void operator delete(void* ptr, std::size_t) noexcept { ts::AllocationTracker::Deallocate(ptr); }                                                         \
+    void operator delete[](void* ptr, std::size_t) noexcept { ts::AllocationTracker::Deallocate(ptr); }                                                       \
+    void operator delete(void* ptr, const std::nothrow_t&) noexcept { ts::AllocationTracker::Deallocate(ptr); }                                               \
+    void operator delete[](void* ptr, const std::nothrow_t&) noexcept { ts::AllocationTracker::Deallocate(ptr); }                                             \
+    void operator delete(void* ptr, std::align_val_t al) noexcept { ts::AllocationTracker::Deallocate(ptr, size_t(al)); }                                     \
+    void operator delete[](void* ptr, std::align_val_t al) noexcept { ts::AllocationTracker::Deallocate(ptr, size_t(al)); }                                   \
+    void operator delete(void* ptr, std::size_t, std::align_val_t al) noexcept { ts::AllocationTracker::Deallocate(ptr, size_t(al)); }                        \
+    void operator delete[](void* ptr, std::size_t, std::align_val_t al) noexcept { ts::AllocationTracker::Deallocate(ptr, size_t(al)); }                      \
+    void operator delete(void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept { ts::AllocationTracker::Deallocate(ptr, size_t(al)); }              \
+    void operator delete[](void* ptr, std::align_val_t al, const std::nothrow_t&) noexcept { ts::AllocationTracker::Deallocate(ptr, size_t(al)); }            \
+    /** @cond nodoxygen */                                                                                                                                    \
+    using TS_UNIQUE_NAME(for_trailing_semicolon) = int                                                                                                        \
+    /** @endcond */
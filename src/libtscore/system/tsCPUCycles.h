@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Low overhead CPU cycle counter, for benchmarking and profiling.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+#if defined(TS_MSC) && (defined(TS_X86_64) || defined(TS_I386))
+    #include "tsBeforeStandardHeaders.h"
+    #include <intrin.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+namespace ts {
+    //!
+    //! True when ReadCPUCycles() reads a hardware cycle counter.
+    //! When false, ReadCPUCycles() returns nanoseconds from the monotonic clock.
+    //! @ingroup libtscore system
+    //!
+#if defined(TS_X86_64) || defined(TS_I386)
+    constexpr bool CPU_CYCLES_COUNTER = true;
+#else
+    constexpr bool CPU_CYCLES_COUNTER = false;
+#endif
+
+    //!
+    //! Read the CPU cycle counter.
+    //! @ingroup libtscore system
+    //!
+    //! On Intel processors, this is the time stamp counter (@c rdtsc instruction). On modern
+    //! processors, it runs at a constant rate, the nominal frequency of the processor, and is
+    //! synchronized between cores. On other processors, this is the monotonic clock in nanoseconds.
+    //! Only differences between two values are meaningful, in the same thread.
+    //!
+    //! @return The current value of the CPU cycle counter.
+    //! @see CPU_CYCLES_COUNTER
+    //!
+    inline uint64_t ReadCPUCycles()
+    {
+#if defined(TS_MSC) && (defined(TS_X86_64) || defined(TS_I386))
+        return ::__rdtsc();
+#elif defined(TS_GCC) && (defined(TS_X86_64) || defined(TS_I386))
+        return __builtin_ia32_rdtsc();
+#else
+        return uint64_t(cn::duration_cast<cn::nanoseconds>(monotonic_time::clock::now().time_since_epoch()).count());
+#endif
+    }
+}
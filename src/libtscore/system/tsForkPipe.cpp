@@ -11,9 +11,19 @@
 #include "tsInitZero.h"
 #include "tsSysUtils.h"
 #include "tsIntegerUtils.h"
+#include "tsByteBlock.h"
+#include "tsMemory.h"
+#include "tsThread.h"
 #if defined(TS_WINDOWS)
     #include "tsWinUtils.h"
 #endif
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/uio.h>
+    #include <sys/ioctl.h>
+    #include <poll.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
 
 // Index of pipe file descriptors on UNIX.
 #define PIPE_READFD  0
@@ -29,11 +39,145 @@
     #define TS_SHELL_STRING TS_STRINGIFY(TS_SHELL_PATH)
 #endif
 
+// Maximum time to wait in close() for the process to read the data which were mapped in the pipe using vmsplice().
+#if defined(TS_LINUX)
+    constexpr cn::seconds SPLICE_DRAIN_TIMEOUT = cn::seconds(5);
+#endif
+
+
+//----------------------------------------------------------------------------
+// Asynchronous writer thread.
+//----------------------------------------------------------------------------
+
+class ts::ForkPipe::AsyncWriter : public Thread
+{
+    TS_NOBUILD_NOCOPY(AsyncWriter);
+public:
+    // The queue contains size bytes plus reserve bytes which may still be referenced by the pipe.
+    AsyncWriter(ForkPipe& pipe, size_t size, size_t reserve);
+    virtual ~AsyncWriter() override;
+
+    // Queue data, wait while the queue is full. Return false if the writer failed.
+    bool write(const void* addr, size_t size, int& errcode);
+
+    // Wait until all queued data are written, then terminate the thread.
+    void flushAndStop();
+
+    // Abort the thread, do not write the queued data.
+    void abort();
+
+private:
+    ForkPipe&               _pipe;
+    std::mutex              _mutex {};
+    std::condition_variable _not_empty {};
+    std::condition_variable _not_full {};
+    ByteBlock               _ring;
+    size_t                  _reserve = 0;
+    uint64_t                _queued = 0;      // Total number of bytes in the queue since start.
+    uint64_t                _written = 0;     // Total number of bytes written in the pipe since start.
+    bool                    _stop = false;
+    bool                    _failed = false;
+    int                     _errcode = 0;
+
+    // Free space in the queue, with mutex held. When vmsplice() is used, the last written bytes
+    // are still referenced by the pipe. Since the pipe never contains more than its capacity,
+    // the bytes which were written more than "reserve" bytes ago were read by the process.
+    size_t freeSpace() const { return _ring.size() - size_t(_queued - (_written - std::min<uint64_t>(_written, _reserve))); }
+
+    virtual void main() override;
+};
+
+ts::ForkPipe::AsyncWriter::AsyncWriter(ForkPipe& pipe, size_t size, size_t reserve) :
+    _pipe(pipe),
+    _ring(size + reserve),
+    _reserve(reserve)
+{
+}
+
+ts::ForkPipe::AsyncWriter::~AsyncWriter()
+{
+    abort();
+    waitForTermination();
+}
+
+bool ts::ForkPipe::AsyncWriter::write(const void* addr, size_t size, int& errcode)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(addr);
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (size > 0) {
+        _not_full.wait(lock, [this]() { return _failed || freeSpace() > 0; });
+        if (_failed) {
+            errcode = _errcode;
+            return false;
+        }
+        // The free area is not accessed by the writer thread, copy without the mutex.
+        const size_t pos = size_t(_queued % _ring.size());
+        const size_t chunk = std::min({size, freeSpace(), _ring.size() - pos});
+        lock.unlock();
+        MemCopy(_ring.data() + pos, data, chunk);
+        lock.lock();
+        _queued += chunk;
+        data += chunk;
+        size -= chunk;
+        _not_empty.notify_one();
+    }
+    return true;
+}
+
+void ts::ForkPipe::AsyncWriter::flushAndStop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _not_empty.notify_one();
+    waitForTermination();
+}
+
+void ts::ForkPipe::AsyncWriter::abort()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = _failed = true;
+    }
+    _not_empty.notify_one();
+    _not_full.notify_all();
+}
+
+void ts::ForkPipe::AsyncWriter::main()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        _not_empty.wait(lock, [this]() { return _failed || _stop || _queued > _written; });
+        if (_failed || (_stop && _queued == _written)) {
+            break;
+        }
+        // Write the contiguous part of the queue, without the mutex.
+        const size_t pos = size_t(_written % _ring.size());
+        const size_t chunk = size_t(std::min<uint64_t>(_queued - _written, _ring.size() - pos));
+        lock.unlock();
+        size_t outsize = 0;
+        int errcode = 0;
+        const bool ok = _pipe.writePipe(_ring.data() + pos, chunk, outsize, errcode);
+        lock.lock();
+        _written += outsize;
+        if (!ok) {
+            _failed = true;
+            _errcode = errcode;
+        }
+        _not_full.notify_all();
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Constructor / destructor
 //----------------------------------------------------------------------------
 
+ts::ForkPipe::ForkPipe()
+{
+}
+
 ts::ForkPipe::~ForkPipe()
 {
     close(NULLREP);
@@ -274,6 +418,14 @@ bool ts::ForkPipe::open(const UString& command, WaitMode wait_mode, size_t buffe
         return false;
     }
 
+#if defined(TS_LINUX)
+    // On Linux, the capacity of a pipe can be adjusted. Not an error if rejected, the default capacity is used.
+    // Unprivileged processes are limited by /proc/sys/fs/pipe-max-size.
+    if (_use_pipe && buffer_size > 0 && ::fcntl(filedes[PIPE_WRITEFD], F_SETPIPE_SZ, int(std::min<size_t>(buffer_size, INT_MAX))) < 0) {
+        report.verbose(u"cannot set pipe size to %'d bytes: %s", buffer_size, SysErrorCodeMessage());
+    }
+#endif
+
     // Create the forked process
     if (_wait_mode == EXIT_PROCESS) {
         // Don't fork, the parent process will directly call exec().
@@ -442,6 +594,20 @@ bool ts::ForkPipe::open(const UString& command, WaitMode wait_mode, size_t buffe
 
 #endif
 
+    // Start the asynchronous writer thread when requested.
+    if (_in_pipe && _async_size > 0) {
+        size_t reserve = 0;
+#if defined(TS_LINUX)
+        // With vmsplice(), the pipe references the pages of the queue, up to the pipe capacity.
+        const int capacity = ::fcntl(_fd, F_GETPIPE_SZ);
+        _splice = capacity > 0;
+        reserve = _splice ? size_t(capacity) : 0;
+        report.debug(u"asynchronous pipe writer, queue size: %'d bytes, pipe capacity: %'d bytes", _async_size, capacity);
+#endif
+        _async = std::make_unique<AsyncWriter>(*this, _async_size, reserve);
+        _async->start();
+    }
+
     _is_open = true;
     return true;
 }
@@ -464,6 +630,31 @@ bool ts::ForkPipe::close(Report& report)
         flush(); // from std::basic_ostream
     }
 
+    // Write all queued data, then terminate the asynchronous writer thread.
+    if (_async != nullptr) {
+        _async->flushAndStop();
+#if defined(TS_LINUX)
+        // With vmsplice(), the pipe references the pages of the queue until the process reads them.
+        // Wait for the pipe to be empty, or the process to close it, before freeing the queue.
+        // The wait is bounded: a process which no longer reads its input must not block us forever.
+        const monotonic_time deadline = monotonic_time::clock::now() + SPLICE_DRAIN_TIMEOUT;
+        bool drained = !_splice || _broken_pipe || _fd < 0;
+        while (!drained) {
+            int pending = 0;
+            ::pollfd pfd {_fd, 0, 0}; // POLLERR and POLLHUP are always reported, even without requested events.
+            drained = ::ioctl(_fd, FIONREAD, &pending) < 0 || pending <= 0 || (::poll(&pfd, 1, 10) > 0 && (pfd.revents & (POLLERR | POLLHUP)) != 0);
+            if (!drained && monotonic_time::clock::now() >= deadline) {
+                // The pipe may still reference the queue: never free it, the process would read reused memory.
+                report.warning(u"process does not read its input pipe, %'d bytes still pending after %s", pending, SPLICE_DRAIN_TIMEOUT);
+                [[maybe_unused]] AsyncWriter* leaked = _async.release();
+                break;
+            }
+        }
+        _splice = false;
+#endif
+        _async.reset();
+    }
+
     bool result = true;
 
 #if defined(TS_WINDOWS)
@@ -519,6 +710,11 @@ void ts::ForkPipe::abortPipeReadWrite()
         _broken_pipe = true;
         _eof = true;
 
+        // Unlock the application if blocked on a full asynchronous queue.
+        if (_async != nullptr) {
+            _async->abort();
+        }
+
         // Close pipe handle, ignore errors.
 #if defined(TS_WINDOWS)
         ::CloseHandle(_handle);
@@ -554,8 +750,50 @@ bool ts::ForkPipe::writeStream(const void* addr, size_t size, size_t& written_si
         return _ignore_abort;
     }
 
-    bool error = false;
     int errcode = 0;
+    bool error = false;
+
+    if (_async != nullptr) {
+        // Queue the data, the asynchronous writer thread will write them in the pipe.
+        error = !_async->write(addr, size, errcode);
+        written_size = error ? 0 : size;
+    }
+    else {
+        error = !writePipe(addr, size, written_size, errcode);
+    }
+
+    if (!error) {
+        return true;
+    }
+    else if (!_broken_pipe) {
+        // Always report non-pipe error (message + error status).
+        report.error(u"error writing to pipe: %s", SysErrorCodeMessage(errcode));
+        return false;
+    }
+    else if (_ignore_abort) {
+        // Broken pipe but must be ignored. Report a verbose message
+        // the first time to inform that data will continue to be
+        // processed but will be ignored by the forked process.
+        report.verbose(u"broken pipe, stopping transmission to forked process");
+        // Not an error (ignored)
+        return true;
+    }
+    else {
+        // Broken pipe. Do not report a message, but report as error
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Write data to the pipe, from the application or the asynchronous writer.
+//----------------------------------------------------------------------------
+
+bool ts::ForkPipe::writePipe(const void* addr, size_t size, size_t& written_size, int& errcode)
+{
+    written_size = 0;
+    bool error = false;
+    errcode = 0;
 
 #if defined(TS_WINDOWS)
 
@@ -568,7 +806,7 @@ bool ts::ForkPipe::writeStream(const void* addr, size_t size, size_t& written_si
             // Normal case, some data were written
             assert(outsize <= remain);
             data += outsize;
-            remain -= std::max(remain, outsize);
+            remain -= std::min(remain, outsize);
             written_size += size_t(outsize);
         }
         else {
@@ -587,12 +825,27 @@ bool ts::ForkPipe::writeStream(const void* addr, size_t size, size_t& written_si
     size_t remain = size;
 
     while (remain > 0 && !error) {
-        ssize_t outsize = ::write(_fd, data, remain);
+        ssize_t outsize = 0;
+#if defined(TS_LINUX)
+        if (_splice) {
+            // Map the user pages into the pipe, without copy. The queue of the asynchronous
+            // writer is not modified until the pages are read by the process, see AsyncWriter.
+            ::iovec iov {const_cast<char*>(data), remain};
+            outsize = ::vmsplice(_fd, &iov, 1, 0);
+            if (outsize < 0 && (errno == EINVAL || errno == ENOSYS)) {
+                // vmsplice() not supported, fallback to write().
+                _splice = false;
+                continue;
+            }
+        }
+        else
+#endif
+        outsize = ::write(_fd, data, remain);
         if (outsize > 0) {
             // Normal case, some data were written
             assert(size_t(outsize) <= remain);
             data += outsize;
-            remain -= std::max(remain, size_t(outsize));
+            remain -= std::min(remain, size_t(outsize));
             written_size += size_t(outsize);
         }
         else if ((errcode = errno) != EINTR) {
@@ -603,26 +856,7 @@ bool ts::ForkPipe::writeStream(const void* addr, size_t size, size_t& written_si
     }
 #endif
 
-    if (!error) {
-        return true;
-    }
-    else if (!_broken_pipe) {
-        // Always report non-pipe error (message + error status).
-        report.error(u"error writing to pipe: %s", SysErrorCodeMessage(errcode));
-        return false;
-    }
-    else if (_ignore_abort) {
-        // Broken pipe but must be ignored. Report a verbose message
-        // the first time to inform that data will continue to be
-        // processed but will be ignored by the forked process.
-        report.verbose(u"broken pipe, stopping transmission to forked process");
-        // Not an error (ignored)
-        return true;
-    }
-    else {
-        // Broken pipe. Do not report a message, but report as error
-        return false;
-    }
+    return !error;
 }
 
 
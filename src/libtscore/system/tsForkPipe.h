@@ -34,7 +34,7 @@ namespace ts {
         //!
         //! Default constructor.
         //!
-        ForkPipe() = default;
+        ForkPipe();
 
         //!
         //! Destructor.
@@ -80,7 +80,7 @@ namespace ts {
         //! Create the process, open the optional pipe.
         //! @param [in] command The command to execute.
         //! @param [in] wait_mode How to wait for process termination in close().
-        //! @param [in] buffer_size The pipe buffer size in bytes. Used on Windows only. Zero means default.
+        //! @param [in] buffer_size The pipe buffer size in bytes. Used on Windows and Linux only. Zero means default.
         //! @param [in,out] report Where to report errors.
         //! @param [in] out_mode How to handle stdout and stderr.
         //! @param [in] in_mode How to handle stdin. Use the pipe by default.
@@ -144,6 +144,22 @@ namespace ts {
             return _ignore_abort;
         }
 
+        //!
+        //! Set the size of the asynchronous write queue.
+        //!
+        //! When the size is not zero, the data which are written to the pipe are queued and
+        //! an internal thread transfers them to the created process. A slow process does not
+        //! block the application, unless the queue is full. On Linux, the internal thread
+        //! transfers the data using vmsplice(), without copy into the kernel.
+        //!
+        //! Must be called before open(). Used only when the pipe is the standard input of the process.
+        //! @param [in] size Size in bytes of the queue. Zero means synchronous write (the default).
+        //!
+        void setAsyncWriteSize(size_t size)
+        {
+            _async_size = size;
+        }
+
         //!
         //! Abort any currenly input/output operation in the pipe.
         //! The pipe is left in a broken state and can be only closed.
@@ -193,6 +209,8 @@ namespace ts {
         virtual bool writeStreamBuffer(const void* addr, size_t size) override;
 
     private:
+        class AsyncWriter;
+
         InputMode     _in_mode = STDIN_PIPE;     // Input mode for the created process.
         OutputMode    _out_mode = KEEP_BOTH;     // Output mode for the created process.
         volatile bool _is_open = false;          // Open and running.
@@ -203,12 +221,18 @@ namespace ts {
         bool          _ignore_abort = false;     // Ignore early termination of child process.
         volatile bool _broken_pipe = false;      // Pipe is broken, do not attempt to write.
         volatile bool _eof = false;              // Got end of file on input pipe.
+        size_t        _async_size = 0;           // Size of the asynchronous write queue.
+        std::unique_ptr<AsyncWriter> _async {};  // Asynchronous writer thread.
 #if defined(TS_WINDOWS)
         ::HANDLE      _handle = nullptr;         // Pipe output handle.
         ::HANDLE      _process = nullptr;        // Handle to child process.
 #else
         ::pid_t       _fpid = 0;                 // Forked process id (UNIX PID, not MPEG PID!)
         int           _fd = -1;                  // Pipe output file descriptor.
+        std::atomic_bool _splice = false;        // Use vmsplice() instead of write() (Linux only), cleared by the writer thread.
 #endif
+
+        // Write data to the pipe, from the application or the asynchronous writer thread.
+        bool writePipe(const void* addr, size_t size, size_t& written_size, int& errcode);
     };
 }
@@ -0,0 +1,145 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsPacingTimer.h"
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <sys/prctl.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+#if defined(TS_MSC) && (defined(TS_X86_64) || defined(TS_I386))
+    #include <intrin.h>
+#endif
+
+namespace {
+    // Number and duration of sleeps during calibration.
+    constexpr size_t CALIBRATION_COUNT = 32;
+    constexpr cn::microseconds CALIBRATION_SLEEP = cn::microseconds(100);
+
+    // Hint to the CPU that we are in a spin loop.
+    inline void CPURelax()
+    {
+#if defined(TS_MSC) && (defined(TS_X86_64) || defined(TS_I386))
+        ::_mm_pause();
+#elif defined(TS_GCC) && (defined(TS_X86_64) || defined(TS_I386))
+        __builtin_ia32_pause();
+#elif defined(TS_GCC) && (defined(TS_ARM64) || defined(TS_ARM32))
+        asm volatile("yield");
+#endif
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Sleep until a deadline, without spin.
+//----------------------------------------------------------------------------
+
+void ts::PacingTimer::SleepUntil(monotonic_time deadline)
+{
+#if defined(TS_LINUX)
+    // The steady clock is CLOCK_MONOTONIC on Linux. Use an absolute deadline to avoid drift on interrupted sleeps.
+    const auto ns = cn::duration_cast<cn::nanoseconds>(deadline.time_since_epoch()).count();
+    if (ns > 0) {
+        ::timespec tspec {};
+        tspec.tv_sec = ::time_t(ns / 1'000'000'000);
+        tspec.tv_nsec = long(ns % 1'000'000'000);
+        while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tspec, nullptr) == EINTR) {
+        }
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Wait until a deadline, using a sleep followed by a spin.
+//----------------------------------------------------------------------------
+
+ts::monotonic_time ts::PacingTimer::waitUntil(monotonic_time deadline)
+{
+    monotonic_time now = monotonic_time::clock::now();
+
+    // Sleep until the spin margin before the deadline.
+    const monotonic_time target = deadline - _margin;
+    if (now < target) {
+        SleepUntil(target);
+        now = monotonic_time::clock::now();
+        if (_adaptive) {
+            adapt(now - target);
+        }
+    }
+
+    // Spin until the deadline.
+    while (now < deadline) {
+        CPURelax();
+        now = monotonic_time::clock::now();
+    }
+
+    _jitter.recordDuration<cn::nanoseconds>(now - deadline);
+    return now;
+}
+
+
+//----------------------------------------------------------------------------
+// Set the spin margin.
+//----------------------------------------------------------------------------
+
+void ts::PacingTimer::setSpinMargin(cn::nanoseconds margin, bool adaptive, cn::nanoseconds max_spin)
+{
+    _max_spin = std::max(max_spin, cn::nanoseconds::zero());
+    _margin = std::clamp(margin, cn::nanoseconds::zero(), _max_spin);
+    _adaptive = adaptive;
+}
+
+
+//----------------------------------------------------------------------------
+// Adapt the spin margin to observed oversleeps.
+//----------------------------------------------------------------------------
+
+void ts::PacingTimer::adapt(cn::nanoseconds oversleep)
+{
+    if (oversleep > _margin) {
+        // Woke up too late, immediately enlarge the margin, with 25% more.
+        _margin = std::min(oversleep + oversleep / 4, _max_spin);
+    }
+    else {
+        // Slowly reduce the margin to save CPU.
+        _margin -= (_margin - oversleep) / 64;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Measure the oversleep of the system timer.
+//----------------------------------------------------------------------------
+
+cn::nanoseconds ts::PacingTimer::calibrate(cn::nanoseconds max_spin)
+{
+#if defined(TS_LINUX)
+    // The default timer slack of a thread is 50 us. Reduce it to the minimum.
+    ::prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+#endif
+
+    // Collect the oversleeps of short sleeps.
+    std::vector<cn::nanoseconds> oversleeps;
+    oversleeps.reserve(CALIBRATION_COUNT);
+    for (size_t i = 0; i < CALIBRATION_COUNT; ++i) {
+        const monotonic_time target = monotonic_time::clock::now() + CALIBRATION_SLEEP;
+        SleepUntil(target);
+        oversleeps.push_back(monotonic_time::clock::now() - target);
+    }
+
+    // Use the 90th percentile, the adaptation will handle the rest.
+    std::sort(oversleeps.begin(), oversleeps.end());
+    const cn::nanoseconds margin = oversleeps[(9 * oversleeps.size()) / 10];
+    setSpinMargin(margin + margin / 4, true, max_spin);
+    return _margin;
+}
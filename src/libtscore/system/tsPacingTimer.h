@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  High precision timer for output pacing, using a hybrid sleep and spin wait.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsLatencyHistogram.h"
+
+namespace ts {
+    //!
+    //! High precision timer for output pacing, using a hybrid sleep and spin wait.
+    //! @ingroup libtscore system
+    //!
+    //! A sleep on an operating system timer always wakes up late, typically by a few tens
+    //! of micro-seconds on Linux, more on other systems. This is too coarse to space datagrams
+    //! at high bitrates. A pure busy loop is precise but uses a full CPU core.
+    //!
+    //! A PacingTimer sleeps until shortly before the deadline, then spins until the deadline.
+    //! The duration of the spin, the "spin margin", is the expected oversleep of the system
+    //! timer. It is initially measured by calibrate() and then continuously adapted to the
+    //! observed oversleeps. The CPU usage is limited to the spin margin for each wait.
+    //!
+    //! On Linux, the sleep uses an absolute monotonic deadline (clock_nanosleep()) and calibrate()
+    //! reduces the timer slack of the calling thread. On other systems, the sleep uses
+    //! std::this_thread::sleep_until().
+    //!
+    //! The lateness of each wakeup, compared to the requested deadline, is recorded in a jitter
+    //! histogram in nanoseconds.
+    //!
+    class TSCOREDLL PacingTimer
+    {
+        TS_NOCOPY(PacingTimer);
+    public:
+        //!
+        //! Default maximum spin margin.
+        //!
+        static constexpr cn::nanoseconds DEFAULT_MAX_SPIN = cn::microseconds(500);
+
+        //!
+        //! Constructor.
+        //! The initial spin margin is zero, meaning sleep only. Use calibrate() or setSpinMargin().
+        //!
+        PacingTimer() = default;
+
+        //!
+        //! Measure the oversleep of the system timer and set the initial spin margin.
+        //! The calibration takes a few milliseconds. On Linux, the timer slack of the calling
+        //! thread is reduced. Therefore, this method should be called in the thread which waits.
+        //! @param [in] max_spin Maximum spin margin.
+        //! @return The new spin margin.
+        //!
+        cn::nanoseconds calibrate(cn::nanoseconds max_spin = DEFAULT_MAX_SPIN);
+
+        //!
+        //! Set the spin margin.
+        //! @param [in] margin The spin margin. Zero means sleep only, without spin.
+        //! @param [in] adaptive If true, the spin margin is then adapted to observed oversleeps.
+        //! @param [in] max_spin Maximum adapted spin margin.
+        //!
+        void setSpinMargin(cn::nanoseconds margin, bool adaptive = false, cn::nanoseconds max_spin = DEFAULT_MAX_SPIN);
+
+        //!
+        //! Get the current spin margin.
+        //! @return The current spin margin.
+        //!
+        cn::nanoseconds spinMargin() const { return _margin; }
+
+        //!
+        //! Wait until a deadline, using a sleep followed by a spin.
+        //! The lateness of the wakeup is recorded in the jitter histogram.
+        //! @param [in] deadline Monotonic time to wait for.
+        //! @return The actual wakeup time, never earlier than @a deadline.
+        //!
+        monotonic_time waitUntil(monotonic_time deadline);
+
+        //!
+        //! Sleep until a deadline, without spin.
+        //! The lateness of the wakeup is not recorded in the jitter histogram.
+        //! @param [in] deadline Monotonic time to wait for.
+        //!
+        static void SleepUntil(monotonic_time deadline);
+
+        //!
+        //! Get the jitter histogram, the lateness of all wakeups in nanoseconds.
+        //! @return A reference to the jitter histogram.
+        //!
+        LatencyHistogram& jitter() { return _jitter; }
+
+        //!
+        //! Get the jitter histogram, the lateness of all wakeups in nanoseconds.
+        //! @return A constant reference to the jitter histogram.
+        //!
+        const LatencyHistogram& jitter() const { return _jitter; }
+
+    private:
+        cn::nanoseconds  _margin {0};
+        cn::nanoseconds  _max_spin {DEFAULT_MAX_SPIN};
+        bool             _adaptive = false;
+        LatencyHistogram _jitter {};
+
+        // Adapt the spin margin after a sleep which ended 'oversleep' after its target.
+        void adapt(cn::nanoseconds oversleep);
+    };
+}
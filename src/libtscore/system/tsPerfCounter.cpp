@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsPerfCounter.h"
+#include "tsSysUtils.h"
+#include "tsMemory.h"
+
+#if defined(TS_LINUX)
+    #include "tsBeforeStandardHeaders.h"
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include "tsAfterStandardHeaders.h"
+#endif
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::PerfCounter::~PerfCounter()
+{
+    close();
+}
+
+
+//----------------------------------------------------------------------------
+// Check if hardware performance counters are supported.
+//----------------------------------------------------------------------------
+
+bool ts::PerfCounter::IsSupported()
+{
+#if defined(TS_LINUX)
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Open and start the counter.
+//----------------------------------------------------------------------------
+
+bool ts::PerfCounter::open(Event event, Report& report)
+{
+    close();
+
+#if defined(TS_LINUX)
+
+    ::perf_event_attr attr;
+    TS_ZERO(attr);
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    switch (event) {
+        case Event::CYCLES: attr.config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case Event::INSTRUCTIONS: attr.config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case Event::CACHE_REFS: attr.config = PERF_COUNT_HW_CACHE_REFERENCES; break;
+        case Event::CACHE_MISSES: attr.config = PERF_COUNT_HW_CACHE_MISSES; break;
+        case Event::BRANCH_MISSES: attr.config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        default: report.error(u"invalid performance event %d", int(event)); return false;
+    }
+
+    // Count events of the current thread (pid = 0) on any CPU (cpu = -1), no group (group_fd = -1).
+    const long fd = ::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0) {
+        report.error(u"error opening performance counter: %s", SysErrorCodeMessage());
+        return false;
+    }
+    _fd = int(fd);
+    return true;
+
+#else
+
+    report.error(u"hardware performance counters are not supported on this system");
+    return false;
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Close the counter.
+//----------------------------------------------------------------------------
+
+void ts::PerfCounter::close()
+{
+#if defined(TS_LINUX)
+    if (_fd >= 0) {
+        ::close(_fd);
+    }
+#endif
+    _fd = -1;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the current value of the counter.
+//----------------------------------------------------------------------------
+
+uint64_t ts::PerfCounter::value() const
+{
+    uint64_t count = 0;
+#if defined(TS_LINUX)
+    if (_fd >= 0 && ::read(_fd, &count, sizeof(count)) != ssize_t(sizeof(count))) {
+        count = 0;
+    }
+#endif
+    return count;
+}
@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Hardware performance counter of the current thread, for profiling.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsReport.h"
+#include "tsNullReport.h"
+
+namespace ts {
+    //!
+    //! Hardware performance counter of the current thread, for profiling.
+    //! @ingroup libtscore system
+    //!
+    //! The counter is implemented using @c perf_event_open() on Linux. It is not supported
+    //! on other systems and open() fails. On Linux, the counter may also be unavailable in
+    //! virtual machines or when restricted by @c /proc/sys/kernel/perf_event_paranoid.
+    //! Only the user-space events of the thread which opened the counter are counted.
+    //!
+    class TSCOREDLL PerfCounter
+    {
+        TS_NOCOPY(PerfCounter);
+    public:
+        //!
+        //! Type of hardware event to count.
+        //!
+        enum class Event {
+            CYCLES,         //!< CPU cycles.
+            INSTRUCTIONS,   //!< Executed instructions.
+            CACHE_REFS,     //!< Last level cache references.
+            CACHE_MISSES,   //!< Last level cache misses.
+            BRANCH_MISSES,  //!< Mispredicted branches.
+        };
+
+        //!
+        //! Constructor.
+        //!
+        PerfCounter() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~PerfCounter();
+
+        //!
+        //! Open and start the counter in the current thread.
+        //! @param [in] event Type of hardware event to count.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error or when not supported.
+        //!
+        bool open(Event event, Report& report = NULLREP);
+
+        //!
+        //! Close the counter.
+        //!
+        void close();
+
+        //!
+        //! Check if the counter is open.
+        //! @return True if the counter is open.
+        //!
+        bool isOpen() const { return _fd >= 0; }
+
+        //!
+        //! Get the current value of the counter.
+        //! Only differences between two values are meaningful.
+        //! @return The current value of the counter or zero if the counter is not open.
+        //!
+        uint64_t value() const;
+
+        //!
+        //! Check if hardware performance counters are supported on this operating system.
+        //! @return True if hardware performance counters are supported on this operating system.
+        //! The counters may still fail to open, for instance because of system restrictions.
+        //!
+        static bool IsSupported();
+
+    private:
+        int _fd = -1;
+    };
+}
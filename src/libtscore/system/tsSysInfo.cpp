@@ -10,6 +10,7 @@
 #include "tsEnvironment.h"
 #include "tsInitZero.h"
 #include "tsCryptoAcceleration.h"
+#include "tsMemoryAcceleration.h"
 #include "tsFeatures.h"
 
 #if defined(TS_LINUX)
@@ -28,6 +29,10 @@
     #include "tsWinUtils.h"
 #endif
 
+#if defined(TS_X86_64) && defined(TS_MSC)
+    #include <intrin.h>
+#endif
+
 TS_DEFINE_SINGLETON(ts::SysInfo);
 
 
@@ -325,6 +330,26 @@ ts::SysInfo::SysInfo() :
                 _crcInstructions = tsCRC32IsAccelerated && SysCtrlBool("hw.optional.armv8_crc32");
             #endif
         }
+        if (GetEnvironment(u"TS_NO_VECTOR_INSTRUCTIONS").empty()) {
+            #if defined(TS_X86_64) && defined(TS_MSC)
+                // CPUID leaf 1: ECX bit 20 = SSE4.2, bit 27 = OSXSAVE. Leaf 7: EBX bit 5 = AVX2.
+                // AVX2 also requires the OS to save the YMM registers (XCR0 bits 1 and 2).
+                int regs[4];
+                ::__cpuid(regs, 1);
+                const bool sse42 = (regs[2] & (1 << 20)) != 0;
+                const bool ymm = (regs[2] & (1 << 27)) != 0 && (::_xgetbv(0) & 0x06) == 0x06;
+                ::__cpuidex(regs, 7, 0);
+                _sse42Instructions = tsMemoryIsAccelerated128 && sse42;
+                _avx2Instructions = tsMemoryIsAccelerated256 && ymm && (regs[1] & (1 << 5)) != 0;
+            #elif defined(TS_X86_64)
+                __builtin_cpu_init();
+                _sse42Instructions = tsMemoryIsAccelerated128 && __builtin_cpu_supports("sse4.2");
+                _avx2Instructions = tsMemoryIsAccelerated256 && __builtin_cpu_supports("avx2");
+            #elif defined(TS_ARM64)
+                // Neon (Advanced SIMD) is mandatory in all Armv8-A implementations.
+                _neonInstructions = tsMemoryIsAccelerated128;
+            #endif
+        }
     }
 }
 
@@ -365,7 +390,15 @@ TS_REGISTER_FEATURE(u"acceleration", u"Acceleration", ts::Features::ALWAYS, ts::
 
 ts::UString ts::SysInfo::GetAccelerations()
 {
-    return UString::Format(u"CRC32: %s", UString::YesNo(Instance().crcInstructions()));
+    const SysInfo& info(Instance());
+    UString str(UString::Format(u"CRC32: %s", UString::YesNo(info.crcInstructions())));
+    if (info.arch() == INTEL64) {
+        str.format(u", SSE4.2: %s, AVX2: %s", UString::YesNo(info.sse42Instructions()), UString::YesNo(info.avx2Instructions()));
+    }
+    else if (info.arch() == ARM64) {
+        str.format(u", Neon: %s", UString::YesNo(info.neonInstructions()));
+    }
+    return str;
 }
 
 
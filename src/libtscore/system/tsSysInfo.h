@@ -90,6 +90,21 @@ namespace ts {
         //!
         bool crcInstructions() const { return _crcInstructions; }
         //!
+        //! Check if the CPU supports SSE4.2 vector instructions (Intel CPU only).
+        //! @return True if the CPU supports SSE4.2 instructions and they are used by TSDuck.
+        //!
+        bool sse42Instructions() const { return _sse42Instructions; }
+        //!
+        //! Check if the CPU supports AVX2 vector instructions (Intel CPU only).
+        //! @return True if the CPU supports AVX2 instructions and they are used by TSDuck.
+        //!
+        bool avx2Instructions() const { return _avx2Instructions; }
+        //!
+        //! Check if the CPU supports Neon vector instructions (Arm CPU only).
+        //! @return True if the CPU supports Neon instructions and they are used by TSDuck.
+        //!
+        bool neonInstructions() const { return _neonInstructions; }
+        //!
         //! Get the operating system version.
         //! @return The operating system version.
         //!
@@ -161,6 +176,9 @@ namespace ts {
         SysOS     _osFamily;
         SysFlavor _osFlavor = UNKNOWN;
         bool      _crcInstructions = false;
+        bool      _sse42Instructions = false;
+        bool      _avx2Instructions = false;
+        bool      _neonInstructions = false;
         int       _systemMajorVersion = -1;
         int       _systemBuild = -1;
         UString   _systemVersion {};
@@ -0,0 +1,332 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTaskPool.h"
+#include "tsSysInfo.h"
+
+namespace {
+    // Pool and index of the worker thread which runs in the current thread, if any.
+    thread_local const ts::TaskPool* current_pool = nullptr;
+    thread_local size_t current_index = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::TaskPool::TaskPool(size_t thread_count, size_t max_queued, const ThreadAttributes& attributes) :
+    _thread_count(thread_count > 0 ? thread_count : std::max<size_t>(1, SysInfo::Instance().cpuCoreCount())),
+    _max_queued(max_queued),
+    _attributes(attributes)
+{
+}
+
+ts::TaskPool::~TaskPool()
+{
+    terminate();
+}
+
+ts::TaskPool::Worker::Worker(TaskPool* pool, size_t index, const ThreadAttributes& attributes) :
+    Thread(attributes),
+    _pool(pool),
+    _index(index)
+{
+}
+
+ts::TaskPool::Worker::~Worker()
+{
+    waitForTermination();
+}
+
+
+//----------------------------------------------------------------------------
+// Start the worker threads.
+//----------------------------------------------------------------------------
+
+bool ts::TaskPool::start()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_started || _terminate) {
+        return false;
+    }
+    _started = true;
+
+    // Create all workers first, the vector of workers shall not be modified once the first one is started.
+    for (size_t i = 0; i < _thread_count; ++i) {
+        _workers.push_back(std::make_unique<Worker>(this, i, _attributes));
+    }
+    bool success = true;
+    for (const auto& worker : _workers) {
+        success = worker->start() && success;
+    }
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Wait for the completion of all queued tasks and terminate the worker threads.
+//----------------------------------------------------------------------------
+
+void ts::TaskPool::terminate()
+{
+    bool started = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+        started = _started;
+    }
+    _work.notify_all();
+    _space.notify_all();
+
+    if (started) {
+        // Wait for all workers to terminate, after the last queued task, before deallocating any of them.
+        // A running worker may still post a task in its own queue or steal a task from another worker.
+        for (const auto& worker : _workers) {
+            worker->waitForTermination();
+        }
+        _workers.clear();
+    }
+    else {
+        // Never started, the queued tasks will never be executed.
+        clear();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check if the caller is running in the context of one worker thread of this pool.
+//----------------------------------------------------------------------------
+
+bool ts::TaskPool::isWorkerThread() const
+{
+    return current_pool == this;
+}
+
+
+//----------------------------------------------------------------------------
+// Post a task, optionally wait for space in the shared queue.
+//----------------------------------------------------------------------------
+
+bool ts::TaskPool::postTask(Task&& task, bool wait)
+{
+    if (current_pool == this) {
+        // Posted from a worker thread, queue it in the queue of the worker.
+        // The pending count is incremented first, it is never lower than the actual number of tasks.
+        // Tasks from worker threads are accepted during termination, they are part of the queued work.
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending++;
+            _stats.submitted++;
+            _stats.max_queued = std::max(_stats.max_queued, _pending);
+        }
+        Worker& worker(*_workers[current_index]);
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            worker.tasks.push_back(std::move(task));
+        }
+    }
+    else {
+        // Posted from another thread, queue it in the shared queue.
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_max_queued > 0) {
+            if (!wait && _shared.size() >= _max_queued) {
+                return false;
+            }
+            _space.wait(lock, [this]() { return _terminate || _shared.size() < _max_queued; });
+        }
+        if (_terminate) {
+            return false;
+        }
+        _shared.push_back(std::move(task));
+        _pending++;
+        _stats.submitted++;
+        _stats.max_queued = std::max(_stats.max_queued, _pending);
+    }
+    _work.notify_one();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Pop a task from the queue of a worker.
+//----------------------------------------------------------------------------
+
+bool ts::TaskPool::PopTask(Worker& worker, Task& task, bool back)
+{
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) {
+        return false;
+    }
+    else if (back) {
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+    }
+    else {
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next task to execute in a worker thread.
+//----------------------------------------------------------------------------
+
+bool ts::TaskPool::nextTask(size_t index, Task& task)
+{
+    for (;;) {
+        // First, look in the queue of this worker, most recent task first.
+        bool found = PopTask(*_workers[index], task, true);
+        bool stolen = false;
+
+        // Then, look in the shared queue or wait for some work.
+        if (!found) {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!_shared.empty()) {
+                task = std::move(_shared.front());
+                _shared.pop_front();
+                _pending--;
+                _running++;
+                lock.unlock();
+                _space.notify_one();
+                return true;
+            }
+            else if (_pending == 0) {
+                if (_terminate) {
+                    return false;
+                }
+                _work.wait(lock, [this]() { return _pending > 0 || _terminate; });
+                continue;
+            }
+        }
+
+        // Finally, steal the oldest task of another worker.
+        for (size_t i = 1; !found && i < _workers.size(); ++i) {
+            found = stolen = PopTask(*_workers[(index + i) % _workers.size()], task, false);
+        }
+
+        if (found) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending--;
+            _running++;
+            if (stolen) {
+                _stats.stolen++;
+            }
+            return true;
+        }
+
+        // Some task is pending but not yet in its queue, or just taken by another worker.
+        Thread::Yield();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Execute a task in a worker thread.
+//----------------------------------------------------------------------------
+
+void ts::TaskPool::runTask(Task& task)
+{
+    bool failed = false;
+    const monotonic_time start = monotonic_time::clock::now();
+    try {
+        task();
+    }
+    catch (...) {
+        failed = true;
+    }
+    const cn::nanoseconds duration = monotonic_time::clock::now() - start;
+
+    // Release the resources of the task before signaling its completion.
+    task = nullptr;
+
+    bool idle = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running--;
+        _stats.executed++;
+        _stats.failed += failed;
+        _stats.busy_time += duration;
+        _stats.max_task_time = std::max(_stats.max_task_time, duration);
+        idle = _pending == 0 && _running == 0;
+    }
+    if (idle) {
+        _idle.notify_all();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Worker thread main code.
+//----------------------------------------------------------------------------
+
+void ts::TaskPool::Worker::main()
+{
+    current_pool = _pool;
+    current_index = _index;
+    Task task;
+    while (_pool->nextTask(_index, task)) {
+        _pool->runTask(task);
+    }
+    current_pool = nullptr;
+}
+
+
+//----------------------------------------------------------------------------
+// Remove all queued tasks which are not yet started.
+//----------------------------------------------------------------------------
+
+size_t ts::TaskPool::clear()
+{
+    // The tasks are deallocated outside the mutex.
+    std::deque<Task> removed;
+    bool idle = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        removed.swap(_shared);
+        for (const auto& worker : _workers) {
+            std::lock_guard<std::mutex> wlock(worker->mutex);
+            removed.insert(removed.end(), std::make_move_iterator(worker->tasks.begin()), std::make_move_iterator(worker->tasks.end()));
+            worker->tasks.clear();
+        }
+        _pending -= std::min(_pending, removed.size());
+        _stats.dropped += removed.size();
+        idle = _pending == 0 && _running == 0;
+    }
+    _space.notify_all();
+    if (idle) {
+        _idle.notify_all();
+    }
+    return removed.size();
+}
+
+
+//----------------------------------------------------------------------------
+// Wait until all queued tasks are executed.
+//----------------------------------------------------------------------------
+
+void ts::TaskPool::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_started) {
+        _idle.wait(lock, [this]() { return _pending == 0 && _running == 0; });
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the execution statistics of the pool.
+//----------------------------------------------------------------------------
+
+ts::TaskPool::Statistics ts::TaskPool::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stats;
+}
@@ -0,0 +1,287 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Pool of worker threads executing tasks, with work stealing.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsThread.h"
+#include "tsBeforeStandardHeaders.h"
+#include <functional>
+#include <future>
+#include "tsAfterStandardHeaders.h"
+
+namespace ts {
+    //!
+    //! Pool of worker threads executing tasks, with work stealing.
+    //! @ingroup libtscore thread
+    //!
+    //! A task is a function object without parameter. Tasks are executed in any order
+    //! by a fixed set of worker threads. All worker threads are created with the same
+    //! ThreadAttributes (stack size, priority).
+    //!
+    //! Each worker thread has its own queue of tasks. A task which is submitted from a
+    //! worker thread (typically a continuation or a sub-task) is queued in the queue of
+    //! this worker. It is the next task to be executed by this worker, while its data are
+    //! still in the CPU cache. A task which is submitted from any other thread is queued
+    //! in a shared queue. An idle worker thread first looks into its own queue, then into
+    //! the shared queue and finally steals the oldest task in the queue of another worker.
+    //!
+    //! The shared queue can be bounded. When it is full, submitting a task from a thread
+    //! outside the pool waits until some space becomes available. Tasks which are submitted
+    //! from the worker threads are never blocked, to avoid dead-locks.
+    //!
+    //! Sample use:
+    //! @code
+    //! ts::TaskPool pool;
+    //! pool.start();
+    //! std::future<int> f1 = pool.submit([]() { return 6 * 7; });
+    //! std::future<std::string> f2 = pool.submit([]() { return 6 * 7; }, [](int i) { return std::to_string(i); });
+    //! std::cout << f1.get() << ", " << f2.get() << std::endl;
+    //! @endcode
+    //!
+    class TSCOREDLL TaskPool
+    {
+        TS_NOCOPY(TaskPool);
+    public:
+        //!
+        //! Generic profile of a task without result.
+        //!
+        using Task = std::function<void()>;
+
+        //!
+        //! Execution statistics of the pool.
+        //!
+        class TSCOREDLL Statistics
+        {
+        public:
+            uint64_t        submitted = 0;                     //!< Number of submitted tasks.
+            uint64_t        executed = 0;                      //!< Number of executed tasks.
+            uint64_t        stolen = 0;                        //!< Number of tasks which were stolen from another worker.
+            uint64_t        failed = 0;                        //!< Number of posted tasks which exited with an exception.
+            uint64_t        dropped = 0;                       //!< Number of tasks which were removed from the queues without execution.
+            size_t          max_queued = 0;                    //!< Maximum observed number of queued tasks.
+            cn::nanoseconds busy_time = cn::nanoseconds::zero();  //!< Accumulated execution time of all tasks.
+            cn::nanoseconds max_task_time = cn::nanoseconds::zero();  //!< Longest execution time of a task.
+        };
+
+        //!
+        //! Constructor.
+        //! The worker threads are not started, use start().
+        //! @param [in] thread_count Number of worker threads. Zero means the number of CPU cores.
+        //! @param [in] max_queued Maximum number of tasks in the shared queue, zero means unlimited.
+        //! @param [in] attributes Attributes of the worker threads.
+        //!
+        TaskPool(size_t thread_count = 0, size_t max_queued = 0, const ThreadAttributes& attributes = ThreadAttributes());
+
+        //!
+        //! Destructor.
+        //! All queued tasks are executed and the worker threads are terminated.
+        //!
+        ~TaskPool();
+
+        //!
+        //! Start the worker threads.
+        //! Tasks which were submitted before start() are executed after start().
+        //! @return True on success, false on error.
+        //!
+        bool start();
+
+        //!
+        //! Wait for the completion of all queued tasks and terminate the worker threads.
+        //! After termination, all submissions are rejected.
+        //! This method is automatically invoked by the destructor.
+        //! It cannot be called from a worker thread.
+        //!
+        void terminate();
+
+        //!
+        //! Get the number of worker threads.
+        //! @return The number of worker threads.
+        //!
+        size_t threadCount() const { return _thread_count; }
+
+        //!
+        //! Check if the caller is running in the context of one worker thread of this pool.
+        //! @return True if the caller is one of the worker threads.
+        //!
+        bool isWorkerThread() const;
+
+        //!
+        //! Post a task without result.
+        //! If the shared queue is full and the caller is not a worker thread, wait until some space is available.
+        //! If the task exits with an exception, the exception is ignored and counted in the statistics.
+        //! @param [in] task The task to execute.
+        //! @return True on success, false if the pool is terminated.
+        //!
+        bool post(Task task) { return postTask(std::move(task), true); }
+
+        //!
+        //! Post a task without result, without waiting.
+        //! @param [in] task The task to execute.
+        //! @return True on success, false if the shared queue is full or the pool is terminated.
+        //!
+        bool tryPost(Task task) { return postTask(std::move(task), false); }
+
+        //!
+        //! Submit a task with a result.
+        //! If the shared queue is full and the caller is not a worker thread, wait until some space is available.
+        //! @tparam FUNC A callable type without parameter.
+        //! @param [in] func The task to execute.
+        //! @return A future to the result of @a func. If @a func exits with an exception, the exception
+        //! is rethrown by the get() method of the future. If the pool is terminated, the task is not executed
+        //! and the future reports a broken promise.
+        //!
+        template <class FUNC>
+        auto submit(FUNC&& func) -> std::future<std::invoke_result_t<std::decay_t<FUNC>>>;
+
+        //!
+        //! Submit a task with a result and its continuation.
+        //! When the task completes, the continuation is queued in the queue of the same worker thread
+        //! and receives the result of the task. If the task exits with an exception, the continuation
+        //! is not executed and the exception is passed to the future.
+        //! @tparam FUNC A callable type without parameter.
+        //! @tparam CONT A callable type which accepts the result of @a FUNC as parameter (or no parameter
+        //! if @a FUNC returns void).
+        //! @param [in] func The task to execute.
+        //! @param [in] cont The continuation to execute with the result of @a func.
+        //! @return A future to the result of @a cont.
+        //!
+        template <class FUNC, class CONT>
+        auto submit(FUNC&& func, CONT&& cont);
+
+        //!
+        //! Remove all queued tasks which are not yet started.
+        //! The futures of the removed tasks report a broken promise.
+        //! @return The number of removed tasks.
+        //!
+        size_t clear();
+
+        //!
+        //! Wait until all queued tasks are executed.
+        //! It cannot be called from a worker thread.
+        //!
+        void waitIdle();
+
+        //!
+        //! Get the execution statistics of the pool.
+        //! @return The execution statistics of the pool.
+        //!
+        Statistics getStatistics() const;
+
+    private:
+        // A worker thread, with its own queue of tasks.
+        class Worker : public Thread
+        {
+            TS_NOBUILD_NOCOPY(Worker);
+        public:
+            Worker(TaskPool* pool, size_t index, const ThreadAttributes& attributes);
+            virtual ~Worker() override;
+            std::mutex       mutex {};   // Protect the queue of the worker.
+            std::deque<Task> tasks {};   // Tasks which were submitted by this worker.
+        private:
+            TaskPool* _pool;
+            size_t    _index;
+            virtual void main() override;
+        };
+
+        const size_t           _thread_count;
+        const size_t           _max_queued;
+        const ThreadAttributes _attributes;
+        std::vector<std::unique_ptr<Worker>> _workers {};  // Not modified between start() and terminate().
+
+        // Global state, protected by the mutex.
+        // Lock order: when _mutex is held, the mutex of a worker can be acquired, not the other way.
+        mutable std::mutex      _mutex {};
+        std::condition_variable _work {};       // Signaled when some task is queued or on termination.
+        std::condition_variable _space {};      // Signaled when some task is removed from the shared queue.
+        std::condition_variable _idle {};       // Signaled when all tasks are executed.
+        bool                    _started = false;
+        bool                    _terminate = false;
+        std::deque<Task>        _shared {};     // Tasks which were submitted outside the worker threads.
+        size_t                  _pending = 0;   // Queued tasks in all queues, never lower than the actual number.
+        size_t                  _running = 0;   // Currently executing tasks.
+        Statistics              _stats {};
+
+        // Post a task, optionally wait for space in the shared queue.
+        bool postTask(Task&& task, bool wait);
+
+        // Get the next task to execute in a worker thread. Return false on termination.
+        bool nextTask(size_t index, Task& task);
+
+        // Pop a task from the queue of a worker, at the back (own queue) or at the front (stealing).
+        static bool PopTask(Worker& worker, Task& task, bool back);
+
+        // Execute a task in a worker thread.
+        void runTask(Task& task);
+
+        // Set the value of a promise from the result of a function call.
+        template <typename T, class FUNC, typename... ARGS>
+        static void SetPromise(std::promise<T>& promise, FUNC& func, ARGS&&... args);
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+template <class FUNC>
+auto ts::TaskPool::submit(FUNC&& func) -> std::future<std::invoke_result_t<std::decay_t<FUNC>>>
+{
+    using RESULT = std::invoke_result_t<std::decay_t<FUNC>>;
+    // std::function requires a copyable object, std::packaged_task is not.
+    auto ptask = std::make_shared<std::packaged_task<RESULT()>>(std::forward<FUNC>(func));
+    auto future = ptask->get_future();
+    postTask([ptask]() { (*ptask)(); }, true);
+    return future;
+}
+
+template <class FUNC, class CONT>
+auto ts::TaskPool::submit(FUNC&& func, CONT&& cont)
+{
+    using RESULT1 = std::invoke_result_t<std::decay_t<FUNC>>;
+    using RESULT2 = typename std::conditional_t<std::is_void_v<RESULT1>, std::invoke_result<std::decay_t<CONT>>, std::invoke_result<std::decay_t<CONT>, RESULT1>>::type;
+
+    auto promise = std::make_shared<std::promise<RESULT2>>();
+    auto future = promise->get_future();
+    postTask([this, promise, func = std::forward<FUNC>(func), cont = std::forward<CONT>(cont)]() mutable {
+        try {
+            if constexpr (std::is_void_v<RESULT1>) {
+                func();
+                postTask([promise, cont = std::move(cont)]() mutable { SetPromise(*promise, cont); }, false);
+            }
+            else {
+                postTask([promise, cont = std::move(cont), result = func()]() mutable { SetPromise(*promise, cont, std::move(result)); }, false);
+            }
+        }
+        catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    }, true);
+    return future;
+}
+
+template <typename T, class FUNC, typename... ARGS>
+void ts::TaskPool::SetPromise(std::promise<T>& promise, FUNC& func, ARGS&&... args)
+{
+    try {
+        if constexpr (std::is_void_v<T>) {
+            func(std::forward<ARGS>(args)...);
+            promise.set_value();
+        }
+        else {
+            promise.set_value(func(std::forward<ARGS>(args)...));
+        }
+    }
+    catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
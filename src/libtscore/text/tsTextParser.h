@@ -160,6 +160,14 @@ namespace ts {
         //!
         size_t lineNumber() const { return _pos._curLineNumber; }
 
+        //!
+        //! Set the line number of the current position.
+        //! This is useful when the text is a fragment of a larger document,
+        //! to report errors with line numbers in the complete document.
+        //! @param [in] line The line number of the current position.
+        //!
+        void setLineNumber(size_t line) { _pos._curLineNumber = line; }
+
         //!
         //! Skip all whitespaces, including end of lines.
         //! Note that the optional BOM at start of an UTF-8 file has already been removed by the UTF-16 conversion.
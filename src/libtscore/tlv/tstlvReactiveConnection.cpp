@@ -0,0 +1,162 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstlvReactiveConnection.h"
+#include "tstlvMessageFactory.h"
+#include "tstlvSerializer.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::tlv::ReactiveConnection::ReactiveConnection(ReactiveTCPConnection& socket, Logger& logger, const Protocol& protocol, bool auto_error_response, size_t max_invalid_msg, Object* owner) :
+    ReactiveSocketBase(socket.reactor(), socket.socket(), owner),
+    _socket(socket),
+    _logger(logger),
+    _protocol(protocol),
+    _auto_error_response(auto_error_response),
+    _max_invalid_msg(max_invalid_msg)
+{
+    // Get notified of connection.
+    _socket.socket().addSubscription(this);
+}
+
+ts::tlv::ReactiveConnection::~ReactiveConnection()
+{
+}
+
+ts::tlv::ReactiveConnection::SendUserData::~SendUserData()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Reset the count of invalid messages on connect.
+//----------------------------------------------------------------------------
+
+void ts::tlv::ReactiveConnection::handleSocketConnected(TCPConnection& sock)
+{
+    _invalid_msg_count = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Start the operation of sending a TLV message over the TCP connection.
+//----------------------------------------------------------------------------
+
+bool ts::tlv::ReactiveConnection::startSendMessage(const Message& msg)
+{
+    _logger.log(msg, u"sending message to " + _socket.socket().peerName());
+
+    auto data = std::make_shared<SendUserData>();
+    Serializer serial(data->buffer);
+    msg.serialize(serial);
+    return _socket.startSend(nullptr, data->buffer->data(), data->buffer->size(), data);
+}
+
+
+//----------------------------------------------------------------------------
+// Start the operation of receiving TLV messages from the socket.
+//----------------------------------------------------------------------------
+
+bool ts::tlv::ReactiveConnection::startReceive(ReactiveConnectionHandlerInterface* handler, size_t buffer_size)
+{
+    // The handler cannot be null because there is no other way to get received messages.
+    if (handler == nullptr) {
+        report().error(u"internal error: null handler in tlv::ReactiveConnection::startReceive");
+        return false;
+    }
+    else {
+        _receive_handler = handler;
+        return _socket.startReceive(this, buffer_size);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Invoked when binary data is received from the TCP connection.
+//----------------------------------------------------------------------------
+
+void ts::tlv::ReactiveConnection::handleTCPReceive(ReactiveTCPConnection& sock, const ByteBlock& data, ReactiveTCPInputControl& control, int error_code, const ObjectPtr& user_data)
+{
+    if (_receive_handler == nullptr) {
+        return;
+    }
+    if (!SysSuccess(error_code)) {
+        // Report an error to application.
+        _receive_handler->handleTLVMessage(*this, MessagePtr(), error_code);
+        return;
+    }
+
+    // Message header: [version (1 byte)] tag (2 bytes) length (2 bytes).
+    const size_t header_size = _protocol.hasVersion() ? 5 : 4;
+    const size_t length_offset = header_size - 2;
+
+    // Loop on all complete messages in the buffer. Stop if a handler stopped the socket.
+    size_t start = 0;
+    control.min_next_size = header_size;
+    while (data.size() - start >= header_size && sock.isOpen()) {
+        const size_t size = header_size + GetUInt16(data.data() + start + length_offset);
+        if (data.size() - start < size) {
+            // Wait for the rest of the message.
+            control.min_next_size = size;
+            break;
+        }
+        const bool ok = processMessage(data.data() + start, size);
+        start += size;
+        if (!ok) {
+            break;
+        }
+    }
+
+    // Indicate where we stopped consuming the buffer.
+    control.used_size = start;
+}
+
+
+//----------------------------------------------------------------------------
+// Process one complete message.
+//----------------------------------------------------------------------------
+
+bool ts::tlv::ReactiveConnection::processMessage(const uint8_t* data, size_t size)
+{
+    // Analyze the message.
+    MessageFactory mf(data, size, _protocol);
+    if (mf.errorStatus() == tlv::OK) {
+        _invalid_msg_count = 0;
+        MessagePtr msg;
+        mf.factory(msg);
+        if (msg != nullptr) {
+            _logger.log(*msg, u"received message from " + _socket.socket().peerName());
+            _receive_handler->handleTLVMessage(*this, msg, SYS_SUCCESS);
+        }
+        return true;
+    }
+
+    // Received an invalid message.
+    _invalid_msg_count++;
+
+    // Send back an error message if necessary.
+    if (_auto_error_response) {
+        MessagePtr resp;
+        mf.buildErrorResponse(resp);
+        if (resp != nullptr && !startSendMessage(*resp)) {
+            _receive_handler->handleTLVMessage(*this, MessagePtr(), SYS_ERROR);
+            return false;
+        }
+    }
+
+    // If invalid message max has been reached, notify the application.
+    if (_max_invalid_msg > 0 && _invalid_msg_count >= _max_invalid_msg) {
+        _logger.report().error(u"too many invalid messages from %s", _socket.socket().peerName());
+        _receive_handler->handleTLVMessage(*this, MessagePtr(), SYS_ERROR);
+        return false;
+    }
+    return true;
+}
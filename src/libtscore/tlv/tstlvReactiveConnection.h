@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  TCP connection using TLV messages for use in a Reactor environment.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsReactiveSocketBase.h"
+#include "tsReactiveTCPConnection.h"
+#include "tstlvReactiveConnectionHandlerInterface.h"
+#include "tstlvProtocol.h"
+#include "tstlvLogger.h"
+
+namespace ts::tlv {
+    //!
+    //! TCP connection using TLV messages for use in a Reactor environment.
+    //! @ingroup libtscore tlv reactor
+    //!
+    //! The class tlv::ReactiveConnection is a wrapper around ReactiveTCPConnection to handle reactive
+    //! I/O of TLV messages. This is the non-blocking equivalent of tlv::Connection. Incoming messages
+    //! are framed from the received data without blocking, deserialized and validated. Valid messages
+    //! are passed to the application handler. Invalid messages are processed as in tlv::Connection.
+    //!
+    class TSCOREDLL ReactiveConnection:
+        public ReactiveSocketBase,
+        private ReactiveTCPConnectionHandlerInterface,
+        private SocketHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(ReactiveConnection);
+    public:
+        //!
+        //! Constructor.
+        //! @param [in,out] socket Associated reactive TCP socket. The socket object must remain valid as long as this object is valid.
+        //! @param [in,out] logger Where to report errors and messages. An internal reference is kept.
+        //! The @a logger object must remain valid as long as this object exists.
+        //! @param [in] protocol The incoming messages are interpreted according to this protocol. The reference is kept in this object.
+        //! @param [in] auto_error_response When an invalid message is received, the corresponding error message is automatically
+        //! sent back to the sender when @a auto_error_response is true.
+        //! @param [in] max_invalid_msg When non-zero, the application handler is notified of an error when the number of
+        //! consecutive invalid messages has reached this value.
+        //! @param [in] owner Optional address of an "owner" object, typically an instance of class containing this object.
+        //!
+        ReactiveConnection(ReactiveTCPConnection& socket, Logger& logger, const Protocol& protocol, bool auto_error_response = true, size_t max_invalid_msg = 0, Object* owner = nullptr);
+
+        //!
+        //! Destructor.
+        //!
+        virtual ~ReactiveConnection() override;
+
+        //!
+        //! Get a reference to the associated socket.
+        //! @return A reference to the associated socket.
+        //!
+        ReactiveTCPConnection& socket() { return _socket; }
+
+        //!
+        //! Start the operation of sending a TLV message over the TCP connection.
+        //! There is no completion handler because the serialized message is kept in a dedicated buffer.
+        //! @param [in] msg The message to send. The message object is no longer used upon return.
+        //! @return True on success, false on error. Success means that the I/O was successfully started.
+        //!
+        bool startSendMessage(const Message& msg);
+
+        //!
+        //! Start the operation of receiving TLV messages from the socket.
+        //! @param [in] handler Handler class to call each time a valid message is received. The method handleTLVMessage()
+        //! will be called on each message. Cannot be null. If a previous receive handler was registered, it is replaced.
+        //! @param [in] buffer_size Size of input buffers to receive data.
+        //! @return True on success, false on error. Success means that the I/O was successfully started.
+        //! The final status of the I/O will be transmitted in the @a handler.
+        //!
+        bool startReceive(ReactiveConnectionHandlerInterface* handler, size_t buffer_size = ReactiveTCPConnection::DEFAULT_RECEIVE_BUFFER_SIZE);
+
+    private:
+        // The send user-data is a buffer containing the serialized message to send.
+        class TSCOREDLL SendUserData: public Object
+        {
+        public:
+            ByteBlockPtr buffer {std::make_shared<ByteBlock>()};
+            virtual ~SendUserData() override;
+        };
+
+        // ReactiveConnection private fields.
+        ReactiveTCPConnection&              _socket;
+        Logger&                             _logger;
+        const Protocol&                     _protocol;
+        bool                                _auto_error_response = false;
+        size_t                              _max_invalid_msg = 0;
+        size_t                              _invalid_msg_count = 0;
+        ReactiveConnectionHandlerInterface* _receive_handler = nullptr;
+
+        // Process one complete message. Return false if the connection shall no longer be used.
+        bool processMessage(const uint8_t* data, size_t size);
+
+        // Inherited methods.
+        virtual void handleTCPReceive(ReactiveTCPConnection& sock, const ByteBlock& data, ReactiveTCPInputControl& control, int error_code, const ObjectPtr& user_data) override;
+        virtual void handleSocketConnected(TCPConnection& sock) override;
+    };
+}
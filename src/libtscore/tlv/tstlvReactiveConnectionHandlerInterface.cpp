@@ -0,0 +1,11 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstlvReactiveConnectionHandlerInterface.h"
+
+ts::tlv::ReactiveConnectionHandlerInterface::~ReactiveConnectionHandlerInterface() {}
@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Interface class for TLV connection Reactor handlers.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tstlvMessage.h"
+
+namespace ts::tlv {
+
+    class ReactiveConnection;
+
+    //!
+    //! Interface class for TLV connection Reactor handlers.
+    //! @ingroup libtscore tlv reactor
+    //!
+    //! An application shall use ReactiveTCPConnectionHandlerInterface for the non-TLV parts of the connection.
+    //!
+    class TSCOREDLL ReactiveConnectionHandlerInterface
+    {
+        TS_INTERFACE(ReactiveConnectionHandlerInterface);
+    public:
+        //!
+        //! Handle the reception of one valid TLV message.
+        //! @param [in,out] conn TLV connection for which the handler is invoked.
+        //! @param [in] msg Received message. Null if @a error_code is not SYS_SUCCESS.
+        //! @param [in] error_code System-specific error code, SYS_SUCCESS on success, SYS_EOF if the peer has disconnected,
+        //! SYS_ERROR in case of unknown error or when too many consecutive invalid messages were received.
+        //!
+        virtual void handleTLVMessage(ReactiveConnection& conn, const MessagePtr& msg, int error_code) = 0;
+    };
+}
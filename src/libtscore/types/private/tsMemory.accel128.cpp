@@ -0,0 +1,170 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+// Implementation of memory scanning functions using 128-bit vector
+// instructions, SSE4.2 on Intel and Neon on Arm64, when available.
+// This module is compiled with special options to use optional instructions
+// for the target architecture. It may fail when these instructions are not
+// implemented in the current CPU. Consequently, this module shall not be
+// called when these instructions are not implemented.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMemoryAcceleration.h"
+
+#if defined(TS_X86_64) && (defined(__SSE4_2__) || defined(TS_MSC)) && !defined(TS_NO_SSE42_INSTRUCTIONS)
+    #define TS_SSE42_INSTRUCTIONS 1
+    #include <nmmintrin.h>
+#elif defined(TS_ARM64) && defined(__ARM_NEON) && !defined(TS_NO_NEON_INSTRUCTIONS)
+    #define TS_NEON_INSTRUCTIONS 1
+    #include <arm_neon.h>
+#endif
+
+// "Hidden" exported bool to inform the SysInfo class that we have compiled accelerated instructions.
+extern const bool tsMemoryIsAccelerated128 =
+#if defined(TS_SSE42_INSTRUCTIONS) || defined(TS_NEON_INSTRUCTIONS)
+    true;
+#else
+    false;
+#endif
+
+// Don't complain about assert(false) when acceleration is not implemented.
+TS_LLVM_NOWARNING(missing-noreturn)
+
+
+//----------------------------------------------------------------------------
+// Basic operations on 16-byte vectors.
+//----------------------------------------------------------------------------
+
+#if defined(TS_SSE42_INSTRUCTIONS)
+namespace {
+
+    using Vector = __m128i;
+
+    inline Vector Load(const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    inline Vector Splat(uint8_t x) { return _mm_set1_epi8(char(x)); }
+    inline Vector Equal(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+    inline Vector And(Vector a, Vector b) { return _mm_and_si128(a, b); }
+    inline bool IsZero(Vector a) { return _mm_testz_si128(a, a) != 0; }
+
+    // Bit mask of lanes with all bits set in a comparison result, one bit per lane.
+    constexpr size_t LANE_BITS = 1;
+    inline uint64_t LaneMask(Vector a) { return uint32_t(_mm_movemask_epi8(a)); }
+}
+#elif defined(TS_NEON_INSTRUCTIONS)
+namespace {
+
+    using Vector = uint8x16_t;
+
+    inline Vector Load(const uint8_t* p) { return vld1q_u8(p); }
+    inline Vector Splat(uint8_t x) { return vdupq_n_u8(x); }
+    inline Vector Equal(Vector a, Vector b) { return vceqq_u8(a, b); }
+    inline Vector And(Vector a, Vector b) { return vandq_u8(a, b); }
+    inline bool IsZero(Vector a) { return vmaxvq_u8(a) == 0; }
+
+    // There is no "movemask" on Neon. Narrowing each 16-bit lane by 4 bits produces
+    // a 64-bit value with 4 bits per byte lane.
+    constexpr size_t LANE_BITS = 4;
+    inline uint64_t LaneMask(Vector a) { return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(a), 4)), 0); }
+}
+#endif
+
+#if defined(TS_SSE42_INSTRUCTIONS) || defined(TS_NEON_INSTRUCTIONS)
+namespace {
+    constexpr size_t VECTOR_SIZE = 16;
+
+    // Index of the first lane in a mask, remove this lane from the mask.
+    inline size_t NextLane(uint64_t& mask)
+    {
+        const size_t index = size_t(std::countr_zero(mask)) / LANE_BITS;
+        mask &= ~(((uint64_t(1) << LANE_BITS) - 1) << (index * LANE_BITS));
+        return index;
+    }
+}
+#endif
+
+
+//----------------------------------------------------------------------------
+// Locate a pattern into a memory area.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::LocatePatternAccel128(const uint8_t* area, size_t area_size, const uint8_t* pattern, size_t pattern_size)
+{
+#if defined(TS_SSE42_INSTRUCTIONS) || defined(TS_NEON_INSTRUCTIONS)
+    // Compare the first and last bytes of the pattern at 16 consecutive positions.
+    // Only check the complete pattern at positions where both bytes match.
+    const Vector first = Splat(pattern[0]);
+    const Vector last = Splat(pattern[pattern_size - 1]);
+    size_t pos = 0;
+    for (; pos + pattern_size - 1 + VECTOR_SIZE <= area_size; pos += VECTOR_SIZE) {
+        uint64_t mask = LaneMask(And(Equal(Load(area + pos), first), Equal(Load(area + pos + pattern_size - 1), last)));
+        while (mask != 0) {
+            const uint8_t* const candidate = area + pos + NextLane(mask);
+            if (std::memcmp(candidate + 1, pattern + 1, pattern_size - 2) == 0) {
+                return candidate;
+            }
+        }
+    }
+
+    // Remaining positions, less than one vector.
+    for (; pos + pattern_size <= area_size; ++pos) {
+        if (area[pos] == pattern[0] && std::memcmp(area + pos + 1, pattern + 1, pattern_size - 1) == 0) {
+            return area + pos;
+        }
+    }
+    return nullptr;
+#else
+    // Shall not be called.
+    assert(false);
+    return nullptr;
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Locate a byte value which is repeated at regular intervals.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::LocateStridedByteAccel128(const uint8_t* area, size_t area_size, uint8_t value, size_t stride, size_t count)
+{
+#if defined(TS_SSE42_INSTRUCTIONS) || defined(TS_NEON_INSTRUCTIONS)
+    // Number of possible starting positions.
+    const size_t starts = area_size - (count - 1) * stride;
+
+    // Check 16 consecutive starting positions at a time. Most blocks are eliminated
+    // after the first comparison because the value is rarely found at all positions.
+    const Vector val = Splat(value);
+    size_t pos = 0;
+    for (; pos + VECTOR_SIZE <= starts; pos += VECTOR_SIZE) {
+        Vector match = Equal(Load(area + pos), val);
+        for (size_t i = 1; i < count && !IsZero(match); ++i) {
+            match = And(match, Equal(Load(area + pos + i * stride), val));
+        }
+        uint64_t mask = LaneMask(match);
+        if (mask != 0) {
+            return area + pos + NextLane(mask);
+        }
+    }
+
+    // Remaining positions, less than one vector.
+    for (; pos < starts; ++pos) {
+        size_t i = 0;
+        while (i < count && area[pos + i * stride] == value) {
+            ++i;
+        }
+        if (i == count) {
+            return area + pos;
+        }
+    }
+    return nullptr;
+#else
+    // Shall not be called.
+    assert(false);
+    return nullptr;
+#endif
+}
@@ -0,0 +1,34 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Declare the vector implementations of memory scanning functions.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+// Some global constant private booleans which are defined when the accelerated
+// modules are compiled with vector instructions. The 128-bit module uses SSE4.2
+// on Intel and Neon on Arm64. The 256-bit module uses AVX2 on Intel.
+extern const bool tsMemoryIsAccelerated128;
+extern const bool tsMemoryIsAccelerated256;
+
+namespace ts {
+    //
+    // Vector implementations of LocatePattern() and LocateStridedByte().
+    // The pattern size must be at least 2. The count must be at least 2 and
+    // (count - 1) * stride must be less than area_size.
+    // Shall not be called when the corresponding instructions are not available.
+    //
+    const uint8_t* LocatePatternAccel128(const uint8_t* area, size_t area_size, const uint8_t* pattern, size_t pattern_size);
+    const uint8_t* LocatePatternAccel256(const uint8_t* area, size_t area_size, const uint8_t* pattern, size_t pattern_size);
+    const uint8_t* LocateStridedByteAccel128(const uint8_t* area, size_t area_size, uint8_t value, size_t stride, size_t count);
+    const uint8_t* LocateStridedByteAccel256(const uint8_t* area, size_t area_size, uint8_t value, size_t stride, size_t count);
+}
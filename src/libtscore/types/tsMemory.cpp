@@ -7,6 +7,19 @@
 //----------------------------------------------------------------------------
 
 #include "tsMemory.h"
+#include "tsMemoryAcceleration.h"
+#include "tsSysInfo.h"
+
+namespace {
+    // Widest vector instructions which can be used on this CPU, in bits, zero if none.
+    size_t VectorWidth()
+    {
+        static const size_t width =
+            ts::SysInfo::Instance().avx2Instructions() ? 256 :
+            ts::SysInfo::Instance().sse42Instructions() || ts::SysInfo::Instance().neonInstructions() ? 128 : 0;
+        return width;
+    }
+}
 
 
 //----------------------------------------------------------------------------
@@ -34,6 +47,12 @@ const uint8_t* ts::LocatePattern(const void* area, size_t area_size, const void*
         const uint8_t val = *reinterpret_cast<const uint8_t*>(pattern);
         return reinterpret_cast<const uint8_t*>(std::memchr(area, val, area_size));
     }
+    else if (VectorWidth() == 256) {
+        return LocatePatternAccel256(reinterpret_cast<const uint8_t*>(area), area_size, reinterpret_cast<const uint8_t*>(pattern), pattern_size);
+    }
+    else if (VectorWidth() == 128) {
+        return LocatePatternAccel128(reinterpret_cast<const uint8_t*>(area), area_size, reinterpret_cast<const uint8_t*>(pattern), pattern_size);
+    }
     else {
         const uint8_t* a = reinterpret_cast<const uint8_t*>(area);
         const uint8_t* const p = reinterpret_cast<const uint8_t*>(pattern);
@@ -52,6 +71,47 @@ const uint8_t* ts::LocatePattern(const void* area, size_t area_size, const void*
 }
 
 
+//----------------------------------------------------------------------------
+// Locate a byte value which is repeated at regular intervals.
+//----------------------------------------------------------------------------
+
+const uint8_t* ts::LocateStridedByte(const void* area, size_t area_size, uint8_t value, size_t stride, size_t count)
+{
+    const uint8_t* a = reinterpret_cast<const uint8_t*>(area);
+    if (count == 0 || area_size == 0) {
+        return nullptr;
+    }
+    else if (count == 1 || stride == 0) {
+        return reinterpret_cast<const uint8_t*>(std::memchr(area, value, area_size));
+    }
+    else if (count - 1 > (area_size - 1) / stride) {
+        // The area is too short for the requested number of occurrences.
+        return nullptr;
+    }
+    else if (VectorWidth() == 256) {
+        return LocateStridedByteAccel256(a, area_size, value, stride, count);
+    }
+    else if (VectorWidth() == 128) {
+        return LocateStridedByteAccel128(a, area_size, value, stride, count);
+    }
+    else {
+        // Look for the first occurrence of the value, then check the next ones.
+        const uint8_t* const end = a + area_size - (count - 1) * stride;
+        while (a < end && (a = reinterpret_cast<const uint8_t*>(std::memchr(a, value, end - a))) != nullptr) {
+            size_t i = 1;
+            while (i < count && a[i * stride] == value) {
+                ++i;
+            }
+            if (i == count) {
+                return a;
+            }
+            ++a;
+        }
+        return nullptr;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Locate a 3-byte pattern 00 00 XY into a memory area.
 //----------------------------------------------------------------------------
@@ -123,6 +123,7 @@ namespace ts {
 
     //!
     //! Locate a pattern into a memory area.
+    //! Vector instructions are used when supported by the CPU.
     //! @ingroup cpp
     //! @param [in] area Address of a memory area to check.
     //! @param [in] area_size Size in bytes of the memory area.
@@ -132,6 +133,21 @@ namespace ts {
     //!
     TSCOREDLL const uint8_t* LocatePattern(const void* area, size_t area_size, const void* pattern, size_t pattern_size);
 
+    //!
+    //! Locate a byte value which is repeated at regular intervals into a memory area.
+    //! This is typically used to find the synchronization of a stream of fixed-size packets.
+    //! Vector instructions are used when supported by the CPU.
+    //! @ingroup cpp
+    //! @param [in] area Address of a memory area to check.
+    //! @param [in] area_size Size in bytes of the memory area.
+    //! @param [in] value Byte value to search.
+    //! @param [in] stride Distance in bytes between two consecutive occurrences of @a value.
+    //! @param [in] count Number of consecutive occurrences of @a value, each one @a stride bytes after the previous one.
+    //! @return Address of the first occurrence of @a value in @a area which is followed by @a count - 1
+    //! other occurrences at @a stride bytes intervals, or the null pointer if not found.
+    //!
+    TSCOREDLL const uint8_t* LocateStridedByte(const void* area, size_t area_size, uint8_t value, size_t stride, size_t count);
+
     //!
     //! Locate a 3-byte pattern 00 00 XY into a memory area.
     //! This is a specialized version of LocatePattern().
@@ -83,9 +83,10 @@ bool ts::xml::Document::parse(const UStringList& lines)
     return parseNode(parser, nullptr);
 }
 
-bool ts::xml::Document::parse(const UString& text)
+bool ts::xml::Document::parse(const UString& text, size_t first_line)
 {
     TextParser parser(text, report());
+    parser.setLineNumber(first_line);
     return parseNode(parser, nullptr);
 }
 
@@ -47,9 +47,10 @@ namespace ts::xml {
         //!
         //! Parse an XML document.
         //! @param [in] text The XML document.
+        //! @param [in] first_line Line number of the first line of @a text, when it is a fragment of a larger document.
         //! @return True on success, false on error.
         //!
-        bool parse(const UString& text);
+        bool parse(const UString& text, size_t first_line = 1);
 
         //!
         //! Load and parse an XML file.
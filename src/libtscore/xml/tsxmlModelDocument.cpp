@@ -66,20 +66,59 @@ bool ts::xml::ModelDocument::validate(const Document& doc) const
 
 
 //----------------------------------------------------------------------------
-// Validate an XML tree of elements, used by validate().
+// Validate an XML document which is read incrementally.
 //----------------------------------------------------------------------------
 
-bool ts::xml::ModelDocument::validateElement(const Element* model, const Element* doc) const
+bool ts::xml::ModelDocument::validateRoot(const Element* root) const
 {
-    if (model == nullptr) {
-        report().error(u"invalid XML model document");
+    const Element* modelRoot = rootElement();
+
+    if (modelRoot == nullptr) {
+        report().error(u"invalid XML model, no root element");
         return false;
     }
-    if (doc == nullptr) {
+    else if (root == nullptr) {
+        report().error(u"invalid XML document, no root element");
+        return false;
+    }
+    else if (modelRoot->nameMatch(root)) {
+        return validateAttributes(modelRoot, root);
+    }
+    else {
+        report().error(u"invalid XML document, expected <%s> as root, found <%s>", modelRoot->name(), root->name());
+        return false;
+    }
+}
+
+bool ts::xml::ModelDocument::validateTopLevel(const Element* elem) const
+{
+    const Element* modelRoot = rootElement();
+    const Element* model = elem == nullptr ? nullptr : findModelElement(modelRoot, elem->name());
+
+    if (modelRoot == nullptr) {
+        report().error(u"invalid XML model, no root element");
+        return false;
+    }
+    else if (elem == nullptr) {
         report().error(u"invalid XML document");
         return false;
     }
+    else if (model == nullptr) {
+        report().error(u"unexpected node <%s> in <%s>, line %d", elem->name(), modelRoot->name(), elem->lineNumber());
+        return false;
+    }
+    else {
+        return validateElement(model, elem);
+    }
+}
 
+
+//----------------------------------------------------------------------------
+// Validate an XML tree of elements, used by validate().
+//----------------------------------------------------------------------------
+
+bool ts::xml::ModelDocument::validateAttributes(const Element* model, const Element* doc) const
+{
     // Report all errors, return final status at the end.
     bool success = true;
 
@@ -96,6 +135,22 @@ bool ts::xml::ModelDocument::validateElement(const Element* model, const Element
             success = false;
         }
     }
+    return success;
+}
+
+bool ts::xml::ModelDocument::validateElement(const Element* model, const Element* doc) const
+{
+    if (model == nullptr) {
+        report().error(u"invalid XML model document");
+        return false;
+    }
+    if (doc == nullptr) {
+        report().error(u"invalid XML document");
+        return false;
+    }
+
+    // Report all errors, return final status at the end.
+    bool success = validateAttributes(model, doc);
 
     // Check that all children elements in doc exist in model.
     for (auto& doc_child : doc->children()) {
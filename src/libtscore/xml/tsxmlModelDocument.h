@@ -54,6 +54,25 @@ namespace ts::xml {
         //!
         bool validate(const Document& doc) const;
 
+        //!
+        //! Validate the root element of an XML document which is read incrementally.
+        //! Only the name and the attributes of the root element are validated, not its children.
+        //! @param [in] root The root element of the document to validate.
+        //! @return True if @a root matches the root of the model, false if it does not.
+        //! @see validateTopLevel()
+        //!
+        bool validateRoot(const Element* root) const;
+
+        //!
+        //! Validate one top-level element of an XML document which is read incrementally.
+        //! When a large document is read one top-level element at a time, the complete document
+        //! is never available. Each top-level element is validated as soon as it is complete.
+        //! @param [in] elem A direct child of the root element of the document to validate.
+        //! @return True if @a elem matches the model, false if it does not.
+        //! @see validateRoot()
+        //!
+        bool validateTopLevel(const Element* elem) const;
+
         // Inherited from xml::Node.
         virtual Node* clone() const override;
 
@@ -67,6 +86,14 @@ namespace ts::xml {
         const Element* findModelElement(const Element* elem, const UString& name) const;
 
     private:
+        //!
+        //! Validate the attributes of an XML element, used by validate().
+        //! @param [in] model The model element.
+        //! @param [in] doc The element to validate.
+        //! @return True if all attributes of @a doc exist in @a model, false otherwise.
+        //!
+        bool validateAttributes(const Element* model, const Element* doc) const;
+
         //!
         //! Validate an XML tree of elements, used by validate().
         //! @param [in] model The model element.
@@ -0,0 +1,18 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlStreamHandlerInterface.h"
+
+ts::xml::StreamHandlerInterface::~StreamHandlerInterface()
+{
+}
+
+bool ts::xml::StreamHandlerInterface::handleXMLRoot(StreamParser&, const Element&)
+{
+    return true;
+}
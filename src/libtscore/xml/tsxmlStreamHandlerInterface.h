@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Interface for classes which handle XML elements from an XML stream parser.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsPlatform.h"
+
+namespace ts::xml {
+
+    class Element;
+    class StreamParser;
+
+    //!
+    //! Interface for classes which handle XML elements from an XML stream parser.
+    //! @ingroup libtscore xml
+    //! @see StreamParser
+    //!
+    class TSCOREDLL StreamHandlerInterface
+    {
+        TS_INTERFACE(StreamHandlerInterface);
+    public:
+        //!
+        //! This hook is invoked when the start tag of the root element has been read.
+        //! The default implementation does nothing.
+        //! @param [in,out] parser The XML stream parser.
+        //! @param [in] root The root element, with its attributes but without children.
+        //! @return True to continue parsing, false to abort.
+        //!
+        virtual bool handleXMLRoot(StreamParser& parser, const Element& root);
+
+        //!
+        //! This hook is invoked when a complete top-level element (direct child of the root) has been read.
+        //! The element is deleted after return.
+        //! @param [in,out] parser The XML stream parser.
+        //! @param [in] element The top-level element, with all its children.
+        //! Its parent is the root element, without other children.
+        //! @return True to continue parsing, false to abort.
+        //!
+        virtual bool handleXMLElement(StreamParser& parser, const Element& element) = 0;
+    };
+}
@@ -0,0 +1,400 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsxmlStreamParser.h"
+#include "tsxmlDocument.h"
+#include "tsxmlElement.h"
+#include "tsFileUtils.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::xml::StreamParser::StreamParser(Report& report, StreamHandlerInterface* handler) :
+    _report(report),
+    _handler(handler)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Parse an XML document from various sources.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamParser::parse(const UString& text)
+{
+    std::istringstream strm(text.toUTF8());
+    return load(strm);
+}
+
+bool ts::xml::StreamParser::load(const UString& file_name, bool search)
+{
+    // Specific case of inline XML content, when the string is not the name of a file but directly an XML content.
+    if (Document::IsInlineXML(file_name)) {
+        return parse(file_name);
+    }
+
+    // Specific case of the standard input.
+    if (file_name.empty() || file_name == u"-") {
+        return load(std::cin);
+    }
+
+    // Actual file name to load after optional search in directories.
+    const UString actual_file_name(search ? SearchConfigurationFile(file_name) : file_name);
+    if (actual_file_name.empty()) {
+        _report.error(u"file not found: %s", file_name);
+        return false;
+    }
+
+    std::ifstream strm(actual_file_name.toUTF8(), std::ios::in | std::ios::binary);
+    if (!strm) {
+        _report.error(u"cannot open %s", actual_file_name);
+        return false;
+    }
+    _report.debug(u"loading XML file %s", actual_file_name);
+    return load(strm);
+}
+
+bool ts::xml::StreamParser::load(std::istream& strm)
+{
+    _in = &strm;
+    _buf.clear();
+    _pos = 0;
+    _mark = NPOS;
+    _line = 1;
+    const bool ok = parseDocument();
+    _in = nullptr;
+    _buf.clear();
+    _buf.shrink_to_fit();
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Input buffer management.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamParser::readChunk()
+{
+    if (_in == nullptr || !*_in) {
+        return false;
+    }
+
+    // Drop the part of the buffer which is no longer needed.
+    const size_t keep = std::min(_pos, _mark);
+    if (keep > 0) {
+        _buf.erase(0, keep);
+        _pos -= keep;
+        if (_mark != NPOS) {
+            _mark -= keep;
+        }
+    }
+
+    // Append a new chunk.
+    const size_t size = _buf.size();
+    _buf.resize(size + _chunk_size);
+    _in->read(&_buf[size], std::streamsize(_chunk_size));
+    const size_t count = size_t(_in->gcount());
+    _buf.resize(size + count);
+    return count > 0;
+}
+
+bool ts::xml::StreamParser::available(size_t size)
+{
+    while (_buf.size() - _pos < size) {
+        if (!readChunk()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ts::xml::StreamParser::advance(size_t count)
+{
+    _line += std::count(_buf.begin() + _pos, _buf.begin() + _pos + count, '\n');
+    _pos += count;
+}
+
+
+//----------------------------------------------------------------------------
+// Lexical elements.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamParser::skipSpaces()
+{
+    while (available(1)) {
+        const char c = _buf[_pos];
+        if (c != ' ' && c != '\t' && c != '\r' && c != '\n') {
+            return true;
+        }
+        advance(1);
+    }
+    return false;
+}
+
+bool ts::xml::StreamParser::skipPast(const char* token)
+{
+    const size_t len = std::strlen(token);
+    for (;;) {
+        const size_t found = _buf.find(token, _pos, len);
+        if (found != std::string::npos) {
+            advance(found + len - _pos);
+            return true;
+        }
+        // Keep the last bytes, they can be the start of the token.
+        if (_buf.size() - _pos >= len) {
+            advance(_buf.size() - _pos - len + 1);
+        }
+        if (!readChunk()) {
+            return false;
+        }
+    }
+}
+
+bool ts::xml::StreamParser::skipTag(bool& empty_element)
+{
+    // Skip quoted attribute values and brackets (DTD internal subset).
+    size_t off = 1;
+    char quote = 0;
+    size_t brackets = 0;
+    for (;; ++off) {
+        if (!available(off + 1)) {
+            return false;
+        }
+        const char c = _buf[_pos + off];
+        if (quote != 0) {
+            if (c == quote) {
+                quote = 0;
+            }
+        }
+        else if (c == '"' || c == '\'') {
+            quote = c;
+        }
+        else if (c == '[') {
+            brackets++;
+        }
+        else if (c == ']' && brackets > 0) {
+            brackets--;
+        }
+        else if (c == '>' && brackets == 0) {
+            empty_element = _buf[_pos + off - 1] == '/';
+            advance(off + 1);
+            return true;
+        }
+    }
+}
+
+std::string ts::xml::StreamParser::tagName(size_t offset)
+{
+    // Tag names are not case-sensitive in TSDuck, lower case in ASCII only.
+    std::string name;
+    while (available(offset + 1)) {
+        const char c = _buf[_pos + offset++];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '/' || c == '>') {
+            break;
+        }
+        name.push_back(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+    }
+    return name;
+}
+
+bool ts::xml::StreamParser::skipElement()
+{
+    // Stack of names of open elements. An unexpected end tag does not close an element,
+    // the syntax error is reported later by the parsing of the complete element.
+    std::vector<std::string> open;
+    for (;;) {
+        // Skip one markup, starting at '<'.
+        bool ok = true;
+        if (match("<!--")) {
+            ok = skipPast("-->");
+        }
+        else if (match("<![CDATA[")) {
+            ok = skipPast("]]>");
+        }
+        else if (match("<?")) {
+            ok = skipPast("?>");
+        }
+        else if (match("</")) {
+            const bool closing = !open.empty() && tagName(2) == open.back();
+            ok = skipPast(">");
+            if (ok && closing) {
+                open.pop_back();
+                if (open.empty()) {
+                    return true;
+                }
+            }
+        }
+        else {
+            std::string name(tagName(1));
+            bool empty_element = false;
+            ok = skipTag(empty_element);
+            if (ok && !empty_element) {
+                open.push_back(std::move(name));
+            }
+            else if (ok && open.empty()) {
+                return true;
+            }
+        }
+
+        // Skip text until next markup.
+        if (!ok) {
+            return false;
+        }
+        for (;;) {
+            const size_t found = _buf.find('<', _pos);
+            if (found != std::string::npos) {
+                advance(found - _pos);
+                break;
+            }
+            advance(_buf.size() - _pos);
+            if (!readChunk()) {
+                return false;
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Parse the document, once the input is open.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamParser::parseDocument()
+{
+    enum {PROLOG, ROOT, EPILOG} state = PROLOG;
+    Document doc(_report);
+    doc.setTweaks(_tweaks);
+    Element* root = nullptr;
+    size_t root_line = 0;
+    bool success = true;
+    bool truncated = false;
+
+    // Skip UTF-8 BOM.
+    if (match("\xEF\xBB\xBF")) {
+        advance(3);
+    }
+
+    while (!truncated && skipSpaces()) {
+        const size_t line = _line;
+        if (match("<!--")) {
+            truncated = !skipPast("-->");
+        }
+        else if (match("<?")) {
+            truncated = !skipPast("?>");
+        }
+        else if (state == PROLOG && match("<!")) {
+            // DOCTYPE, ignored.
+            bool empty_element = false;
+            truncated = !skipTag(empty_element);
+        }
+        else if (state == ROOT && match("</")) {
+            // End of root element.
+            _mark = _pos;
+            truncated = !skipPast(">");
+            if (!truncated) {
+                const UString name(UString::FromUTF8(_buf.data() + _mark + 2, _pos - _mark - 3).toTrimmed());
+                if (!name.similar(root->name())) {
+                    _report.error(u"line %d: parsing error, expected </%s> to match <%s> at line %d", line, root->name(), root->name(), root_line);
+                    return false;
+                }
+            }
+            _mark = NPOS;
+            state = EPILOG;
+        }
+        else if (state != EPILOG && match("<")) {
+            // Start of an element, keep it in the buffer.
+            _mark = _pos;
+            if (state == PROLOG) {
+                bool empty_element = false;
+                truncated = !skipTag(empty_element);
+                if (!truncated) {
+                    if (!parseRoot(doc, _mark, line, empty_element)) {
+                        return false;
+                    }
+                    root = doc.rootElement();
+                    root_line = line;
+                    state = empty_element ? EPILOG : ROOT;
+                }
+            }
+            else {
+                truncated = !skipElement();
+                if (!truncated && !parseTopLevel(root, _mark, line, success)) {
+                    // Aborted by the handler.
+                    return false;
+                }
+            }
+            _mark = NPOS;
+        }
+        else if (state == ROOT) {
+            // Text at top level, ignored.
+            truncated = !skipPast("<");
+            if (!truncated) {
+                _pos--;
+            }
+        }
+        else {
+            _report.error(u"line %d: trailing character sequence, invalid XML document", line);
+            return false;
+        }
+    }
+
+    if (state == PROLOG) {
+        _report.error(u"invalid XML document, no root element found");
+        return false;
+    }
+    else if (state == ROOT || truncated) {
+        _report.error(u"line %d: unexpected end of document, missing </%s> to match <%s> at line %d", _line, root->name(), root->name(), root_line);
+        return false;
+    }
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Build the root element from its start tag.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamParser::parseRoot(Document& doc, size_t start, size_t line, bool empty_element)
+{
+    // Parse the start tag as an empty element.
+    UString text(UString::FromUTF8(_buf.data() + start, _pos - start));
+    if (!empty_element) {
+        text.pop_back();
+        text.append(u"/>");
+    }
+    if (!doc.parse(text, line)) {
+        return false;
+    }
+    const Element* root = doc.rootElement();
+    return root != nullptr && (_handler == nullptr || _handler->handleXMLRoot(*this, *root));
+}
+
+
+//----------------------------------------------------------------------------
+// Build a top-level element and notify the handler.
+//----------------------------------------------------------------------------
+
+bool ts::xml::StreamParser::parseTopLevel(Element* root, size_t start, size_t line, bool& success)
+{
+    // Parse the complete element as a small document. In case of error, continue with next element.
+    Document frag(_report);
+    frag.setTweaks(_tweaks);
+    Element* elem = frag.parse(UString::FromUTF8(_buf.data() + start, _pos - start), line) ? frag.rootElement() : nullptr;
+    if (elem == nullptr) {
+        success = false;
+        return true;
+    }
+
+    // Move the element into the main document, under the root, and release it after use.
+    elem->reparent(root);
+    const bool ok = _handler == nullptr || _handler->handleXMLElement(*this, *elem);
+    delete elem;
+    return ok;
+}
@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Streaming parser for large XML documents.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsxmlStreamHandlerInterface.h"
+#include "tsxmlTweaks.h"
+#include "tsReport.h"
+
+namespace ts::xml {
+
+    class Document;
+    class Element;
+
+    //!
+    //! Streaming parser for large XML documents.
+    //! @ingroup libtscore xml
+    //!
+    //! A large XML document, typically a list of tables or an EPG, is a root element
+    //! with a large number of small top-level elements. The class xml::Document loads
+    //! the complete document in memory, first as text, then as a tree of nodes.
+    //!
+    //! This class reads the UTF-8 input by chunks and builds only one top-level element
+    //! at a time. Each top-level element is passed to a StreamHandlerInterface as soon
+    //! as its end tag is read and is deleted after that. The memory usage is bounded by
+    //! the size of the largest top-level element, not by the size of the document.
+    //!
+    //! Inside a top-level element, the syntax is the same as with xml::Document.
+    //!
+    class TSCOREDLL StreamParser
+    {
+        TS_NOBUILD_NOCOPY(StreamParser);
+    public:
+        //!
+        //! Default size in bytes of input chunks.
+        //!
+        static constexpr size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report errors.
+        //! @param [in] handler The object to notify of XML elements.
+        //!
+        StreamParser(Report& report, StreamHandlerInterface* handler = nullptr);
+
+        //!
+        //! Set a new handler.
+        //! @param [in] handler The object to notify of XML elements.
+        //!
+        void setHandler(StreamHandlerInterface* handler) { _handler = handler; }
+
+        //!
+        //! Set the XML tweaks to use in the parsed elements.
+        //! @param [in] tweaks The XML tweaks.
+        //!
+        void setTweaks(const Tweaks& tweaks) { _tweaks = tweaks; }
+
+        //!
+        //! Set the size of input chunks.
+        //! @param [in] size Size in bytes of each chunk which is read from the input.
+        //!
+        void setChunkSize(size_t size) { _chunk_size = std::max<size_t>(size, 16); }
+
+        //!
+        //! Get the report for errors.
+        //! @return A reference to the report for errors.
+        //!
+        Report& report() const { return _report; }
+
+        //!
+        //! Get the current line number in the input document.
+        //! @return The current line number.
+        //!
+        size_t lineNumber() const { return _line; }
+
+        //!
+        //! Parse an XML document from a text in memory.
+        //! @param [in] text The XML document.
+        //! @return True on success, false on error.
+        //!
+        bool parse(const UString& text);
+
+        //!
+        //! Load and parse an XML file.
+        //! @param [in] file_name Name of the XML file. Same semantics as xml::Document::load():
+        //! inline XML content when the name starts with "<?xml", standard input when empty or "-".
+        //! @param [in] search If true, search the XML file in the TSDuck configuration directories.
+        //! @return True on success, false on error.
+        //!
+        bool load(const UString& file_name, bool search = false);
+
+        //!
+        //! Load and parse an XML document from an open text stream.
+        //! @param [in,out] strm A standard text stream in input mode, in UTF-8 encoding.
+        //! @return True on success, false on error.
+        //!
+        bool load(std::istream& strm);
+
+    private:
+        Report&                 _report;
+        StreamHandlerInterface* _handler = nullptr;
+        Tweaks                  _tweaks {};
+        size_t                  _chunk_size = DEFAULT_CHUNK_SIZE;
+        std::istream*           _in = nullptr;
+        std::string             _buf {};           // Input buffer, UTF-8.
+        size_t                  _pos = 0;          // Current position in _buf.
+        size_t                  _mark = NPOS;      // Start of current top-level element in _buf.
+        size_t                  _line = 1;         // Line number at _pos.
+
+        // Read the next chunk of input. Return false at end of input.
+        bool readChunk();
+
+        // Check if at least 'size' bytes are available in the buffer.
+        bool available(size_t size);
+
+        // Check if the input matches a string at current position.
+        bool match(const char* str) { const size_t len = std::strlen(str); return available(len) && _buf.compare(_pos, len, str) == 0; }
+
+        // Move the current position forward, counting lines.
+        void advance(size_t count);
+
+        // Skip white spaces. Return false at end of input.
+        bool skipSpaces();
+
+        // Skip everything until and including a token. Return false at end of input.
+        bool skipPast(const char* token);
+
+        // Skip a tag, starting at '<', until and including the final '>'. Return false at end of input.
+        bool skipTag(bool& empty_element);
+
+        // Get the lower-case name of a tag, starting at some offset from current position.
+        std::string tagName(size_t offset);
+
+        // Skip a complete element, starting at '<'. Return false at end of input.
+        bool skipElement();
+
+        // Parse the document, once the input is open.
+        bool parseDocument();
+
+        // Build the root element from its start tag.
+        bool parseRoot(Document& doc, size_t start, size_t line, bool empty_element);
+
+        // Build a top-level element and notify the handler. Return false if aborted by the handler.
+        bool parseTopLevel(Element* root, size_t start, size_t line, bool& success);
+    };
+}
@@ -0,0 +1,232 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsParallelTSFileAnalyzer.h"
+#include "tsTSFile.h"
+#include "tsDuckContext.h"
+#include "tsReportBuffer.h"
+#include "tsErrCodeReport.h"
+#include "tsSysInfo.h"
+
+namespace {
+    // Number of TS packets per read operation in worker threads.
+    constexpr size_t READ_PACKETS = 1024;
+}
+
+
+//----------------------------------------------------------------------------
+// Analysis context of one chunk of the file.
+//----------------------------------------------------------------------------
+
+class ts::ParallelTSFileAnalyzer::Chunk
+{
+    TS_NOCOPY(Chunk);
+public:
+    Chunk() = default;
+    ReportBuffer<ThreadSafety::None> log {};  // Errors during the analysis of the chunk.
+    DuckContext duck {&log};                  // Separate TSDuck context per chunk.
+    TSAnalyzer  analyzer {duck};              // Chunk analyzer.
+    bool        success = false;              // All packets of the chunk were analyzed.
+};
+
+
+//----------------------------------------------------------------------------
+// Analyze a transport stream file.
+//----------------------------------------------------------------------------
+
+bool ts::ParallelTSFileAnalyzer::analyze(const fs::path& filename, TSPacketFormat format)
+{
+    Report& report(_duck.report());
+
+    // Open the file and read the first packet to get the actual packet format.
+    TSFile file;
+    TSPacket pkt;
+    TSPacketMetadata mdata;
+    if (!file.openRead(filename, 1, 0, report, format)) {
+        return false;
+    }
+    if (file.readPackets(&pkt, &mdata, 1, report) == 0) {
+        return file.close(report);
+    }
+
+    _filename = filename;
+    _format = file.packetFormat();
+    _packet_size = file.packetHeaderSize() + PKT_SIZE + file.packetTrailerSize();
+    _total_packets = 0;
+    if (!filename.empty() && fs::is_regular_file(filename, &ErrCodeReport())) {
+        _total_packets = fs::file_size(filename, &ErrCodeReport(report, u"error accessing", filename)) / _packet_size;
+    }
+    const size_t threads = _thread_count > 0 ? _thread_count : SysInfo::Instance().cpuCoreCount();
+    const size_t chunk_count = size_t((_total_packets + _chunk_size - 1) / _chunk_size);
+
+    // Sequential analysis when chunks cannot be located in the file or when there is no parallelism.
+    if (_format == TSPacketFormat::DUCK || threads <= 1 || chunk_count <= 1) {
+        _analyzer.feedPacket(pkt, mdata);
+        return analyzeSequential(file);
+    }
+    file.close(report);
+    report.debug(u"analyzing %'d packets in %d chunks, using %d threads", _total_packets, chunk_count, threads);
+
+    // Submit the analysis of the chunks to a pool of threads, without going too far ahead of the merge.
+    _standards = _duck.standards();
+    const size_t max_ahead = 2 * threads;
+    TaskPool pool(std::min(threads, chunk_count));
+    std::deque<std::future<ChunkPtr>> results;
+    size_t next = 0;
+    const auto submit_chunks = [&]() {
+        while (next < chunk_count && results.size() < max_ahead) {
+            const size_t index = next++;
+            results.push_back(pool.submit([this, index]() { return analyzeChunk(index); }));
+        }
+    };
+    submit_chunks();
+    if (!pool.start()) {
+        report.error(u"cannot start analysis threads");
+        return false;
+    }
+
+    // Read packets again when a merge needs them.
+    TSFile reread;
+    PacketCounter reread_next = 0;
+    const TSAnalyzer::PacketReader reader = [&](PacketCounter position, TSPacket* buffer, size_t count) -> size_t {
+        if (reread.isOpen() && reread_next != position) {
+            reread.close(report);
+        }
+        if (!reread.isOpen() && !reread.openRead(filename, 1, position * _packet_size, report, _format)) {
+            return 0;
+        }
+        count = reread.readPackets(buffer, nullptr, count, report);
+        reread_next = position + count;
+        return count;
+    };
+
+    // Merge the chunks in order, as soon as they are analyzed.
+    bool success = true;
+    for (size_t index = 0; success && index < chunk_count; ++index) {
+        const ChunkPtr chunk(results.front().get());
+        results.pop_front();
+        submit_chunks();
+        if (!chunk->success) {
+            report.error(u"%s", chunk->log.messages());
+            success = false;
+        }
+        else if (!_analyzer.canMergeChunk(chunk->analyzer)) {
+            // Invalid packets make the detection of suspect packets depend on the previous chunks.
+            report.debug(u"sequentially analyzing chunk %d", index);
+            success = analyzeChunkSequential(index);
+        }
+        else if (!_analyzer.mergeChunk(chunk->analyzer, reader)) {
+            report.error(u"cannot merge the analysis of %s, chunk %d", filename, index);
+            success = false;
+        }
+        else if (!_analyzer.isMergeExact()) {
+            report.error(u"error reading packets again in %s, chunk %d", filename, index);
+            success = false;
+        }
+    }
+
+    // In case of error, drop the chunks which are not yet analyzed.
+    pool.clear();
+    if (reread.isOpen()) {
+        reread.close(report);
+    }
+    return success;
+}
+
+
+//----------------------------------------------------------------------------
+// Sequentially analyze the rest of an open file.
+//----------------------------------------------------------------------------
+
+bool ts::ParallelTSFileAnalyzer::analyzeSequential(TSFile& file)
+{
+    Report& report(_duck.report());
+    TSPacket pkt;
+    TSPacketMetadata mdata;
+    while (file.readPackets(&pkt, &mdata, 1, report) > 0) {
+        _analyzer.feedPacket(pkt, mdata);
+    }
+    return file.close(report);
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze one chunk of the file.
+//----------------------------------------------------------------------------
+
+ts::ParallelTSFileAnalyzer::ChunkPtr ts::ParallelTSFileAnalyzer::analyzeChunk(size_t index) const
+{
+    ChunkPtr result(std::make_shared<Chunk>());
+    Chunk& chunk(*result);
+    chunk.duck.addStandards(_standards);
+    chunk.analyzer.startChunk(index * _chunk_size);
+    chunk.success = feedChunk(chunk.analyzer, index, chunk.log);
+    return result;
+}
+
+
+//----------------------------------------------------------------------------
+// Sequentially analyze one chunk of the file in the final analyzer.
+//----------------------------------------------------------------------------
+
+bool ts::ParallelTSFileAnalyzer::analyzeChunkSequential(size_t index)
+{
+    _analyzer.startSequentialChunk();
+    return feedChunk(_analyzer, index, _duck.report());
+}
+
+
+//----------------------------------------------------------------------------
+// Feed an analyzer with one chunk of the file, its warm-up and lookahead packets.
+//----------------------------------------------------------------------------
+
+bool ts::ParallelTSFileAnalyzer::feedChunk(TSAnalyzer& analyzer, size_t index, Report& report) const
+{
+    // The chunk is preceded by warm-up packets and followed by lookahead packets, at most one chunk.
+    const PacketCounter first = index * _chunk_size;
+    const PacketCounter count = std::min(_chunk_size, _total_packets - first);
+    const PacketCounter warmup = std::min(_warmup_size, first);
+    const PacketCounter last = warmup + count + _chunk_size;
+
+    TSFile file;
+    if (!file.openRead(_filename, 1, (first - warmup) * _packet_size, report, _format)) {
+        return false;
+    }
+
+    TSPacketVector pkt(READ_PACKETS);
+    TSPacketMetadataVector mdata(READ_PACKETS);
+    PacketCounter read_count = 0;
+    bool more = true;
+    while (more && read_count < last) {
+        const size_t max_count = size_t(std::min<PacketCounter>(READ_PACKETS, last - read_count));
+        const size_t pkt_count = file.readPackets(pkt.data(), mdata.data(), max_count, report);
+        if (pkt_count == 0) {
+            break;
+        }
+        for (size_t i = 0; more && i < pkt_count; ++i) {
+            const PacketCounter n = read_count + i;
+            if (n < warmup) {
+                analyzer.feedWarmupPacket(pkt[i]);
+            }
+            else if (n < warmup + count) {
+                analyzer.feedPacket(pkt[i], mdata[i]);
+            }
+            else {
+                more = analyzer.feedLookaheadPacket(pkt[i]);
+            }
+        }
+        read_count += pkt_count;
+    }
+    file.close(report);
+
+    const bool success = read_count >= warmup + count;
+    if (!success) {
+        report.error(u"error reading packets %'d to %'d in %s", first, first + count - 1, _filename);
+    }
+    return success;
+}
@@ -0,0 +1,117 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Analyze a transport stream file using several threads.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSAnalyzer.h"
+#include "tsTSPacketFormat.h"
+#include "tsTaskPool.h"
+
+namespace ts {
+
+    class TSFile;
+
+    //!
+    //! Analyze a transport stream file using several threads.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! The file is split into chunks of TS packets. Each chunk is analyzed by a separate
+    //! TSAnalyzer in chunk mode, as a task in a TaskPool. The chunk analyzers are then
+    //! merged, in order, into the final TSAnalyzer. The result is the same as the sequential
+    //! analysis of the file. See TSAnalyzer::startChunk() for the limitations. When one of them
+    //! may change the result, only the affected chunk is read again: either the rest of the
+    //! chunk is replayed during the merge or the chunk is sequentially analyzed in the final
+    //! TSAnalyzer.
+    //!
+    //! The parallel analysis is possible on regular files only. On other types of input
+    //! (standard input, pipes, etc.) or when the file format does not have a fixed packet
+    //! size, the file is sequentially analyzed.
+    //!
+    class TSDUCKDLL ParallelTSFileAnalyzer
+    {
+        TS_NOBUILD_NOCOPY(ParallelTSFileAnalyzer);
+    public:
+        //!
+        //! Default number of TS packets per chunk.
+        //!
+        static constexpr PacketCounter DEFAULT_CHUNK_SIZE = 1'000'000;
+
+        //!
+        //! Default number of warm-up TS packets before each chunk.
+        //! This should be larger than the interval between two PMT's.
+        //!
+        static constexpr PacketCounter DEFAULT_WARMUP_SIZE = 50'000;
+
+        //!
+        //! Constructor.
+        //! @param [in,out] duck TSDuck execution context of @a analyzer. The reference is kept inside the object.
+        //! @param [in,out] analyzer The analyzer to feed. The reference is kept inside the object.
+        //!
+        ParallelTSFileAnalyzer(DuckContext& duck, TSAnalyzer& analyzer) : _duck(duck), _analyzer(analyzer) {}
+
+        //!
+        //! Set the number of analysis threads.
+        //! @param [in] count Number of analysis threads. Zero means the number of CPU cores.
+        //! One means sequential analysis.
+        //!
+        void setThreadCount(size_t count) { _thread_count = count; }
+
+        //!
+        //! Set the number of TS packets per chunk.
+        //! @param [in] count Number of TS packets per chunk.
+        //!
+        void setChunkSize(PacketCounter count) { _chunk_size = std::max<PacketCounter>(count, 1); }
+
+        //!
+        //! Set the number of warm-up TS packets before each chunk.
+        //! @param [in] count Number of warm-up TS packets before each chunk.
+        //!
+        void setWarmupSize(PacketCounter count) { _warmup_size = count; }
+
+        //!
+        //! Analyze a transport stream file.
+        //! @param [in] filename Name of the file to analyze. If empty, use standard input.
+        //! @param [in] format Format of the file.
+        //! @return True on success, false on error.
+        //!
+        bool analyze(const fs::path& filename, TSPacketFormat format = TSPacketFormat::AUTODETECT);
+
+    private:
+        class Chunk;
+        using ChunkPtr = std::shared_ptr<Chunk>;
+
+        DuckContext&   _duck;
+        TSAnalyzer&    _analyzer;
+        size_t         _thread_count = 0;
+        PacketCounter  _chunk_size = DEFAULT_CHUNK_SIZE;
+        PacketCounter  _warmup_size = DEFAULT_WARMUP_SIZE;
+
+        // Description of the file being analyzed, constant during the analysis.
+        fs::path       _filename {};
+        TSPacketFormat _format = TSPacketFormat::AUTODETECT;
+        size_t         _packet_size = PKT_SIZE;
+        PacketCounter  _total_packets = 0;
+        Standards      _standards = Standards::NONE;
+
+        // Analyze one chunk of the file.
+        ChunkPtr analyzeChunk(size_t index) const;
+
+        // Sequentially analyze one chunk of the file in the final analyzer.
+        bool analyzeChunkSequential(size_t index);
+
+        // Feed an analyzer with one chunk of the file, its warm-up and lookahead packets.
+        bool feedChunk(TSAnalyzer& analyzer, size_t index, Report& report) const;
+
+        // Sequentially analyze the rest of an open file.
+        bool analyzeSequential(TSFile& file);
+    };
+}
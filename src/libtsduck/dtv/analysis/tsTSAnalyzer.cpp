@@ -29,6 +29,58 @@
 const ts::UString ts::TSAnalyzer::UNREFERENCED(u"Unreferenced");
 
 
+//----------------------------------------------------------------------------
+// Analysis state of a chunk of a larger stream.
+//----------------------------------------------------------------------------
+
+class ts::TSAnalyzer::ChunkContext
+{
+    TS_NOBUILD_NOCOPY(ChunkContext);
+public:
+    // Packet-level events on one PID which must be checked against the previous chunk.
+    class PIDBoundary
+    {
+    public:
+        uint8_t  first_cc = 0;             // Continuity counter of first packet.
+        bool     first_payload = false;    // First packet has a payload.
+        bool     first_discont = false;    // First packet has a discontinuity indicator.
+        bool     broken_rate = false;      // Bitrate evaluation broken before first PCR.
+        uint64_t first_pcr_pkt = 0;        // Index of first packet with PCR.
+        std::vector<std::pair<uint64_t, uint8_t>> scrambling {};  // Packet index and new scrambling control.
+    };
+
+    const uint64_t first_index;            // Number of packets in the stream before the chunk.
+    PacketCounter  pes_start;              // Index in PES demux of first packet in the chunk.
+    uint64_t       pes_index = 0;          // Packet index in the stream of packet in PES demux.
+    bool           lookahead = false;      // Lookahead phase started.
+    bool           suspect_dependent = false;  // Detection of suspect packets depends on PID's before the chunk.
+    PIDSet         pes_pids {};            // PID's carrying PES packets.
+    PIDSet         scrambled_pids {};      // PID's where the last collected packet is scrambled.
+    PIDSet         pending_pids {};        // PID's with a PES packet to complete in lookahead.
+    std::map<PID, PIDBoundary> pids {};    // Boundary events per PID.
+    std::vector<std::pair<uint64_t, TSPacket>> packets {};  // Packets which may carry sections.
+    std::vector<PESEvent> pes_events {};   // Results of PES analysis.
+    std::vector<uint64_t> suspects {};     // Indexes of ignored suspect packets.
+
+    ChunkContext(uint64_t first, PacketCounter pes) : first_index(first), pes_start(pes) {}
+
+    // Check if a PES packet was started in the chunk.
+    bool inChunk(const DemuxedData& pes) const { return pes.firstTSPacketIndex() >= pes_start; }
+
+    // Check if a clear packet is the start of a PES packet.
+    static bool IsPESStart(const TSPacket& pkt);
+
+    // Check if a PID is always demuxed for sections.
+    static bool IsPSIPID(PID pid) { return pid <= PID_ISDB_LAST || pid == PID_PSIP || pid == PID_IIP; }
+};
+
+bool ts::TSAnalyzer::ChunkContext::IsPESStart(const TSPacket& pkt)
+{
+    const uint8_t* const pl = pkt.getPayload();
+    return pkt.getPUSI() && pkt.getScrambling() == SC_CLEAR && pkt.getPayloadSize() >= 3 && pl[0] == 0x00 && pl[1] == 0x00 && pl[2] == 0x01;
+}
+
+
 //----------------------------------------------------------------------------
 // Constructor for the TS analyzer
 //----------------------------------------------------------------------------
@@ -106,6 +158,11 @@ void ts::TSAnalyzer::reset()
     _t2mi_demux.reset();
     _lcn.clear();
     _dct.invalidate();
+    _chunk.reset();
+    _seq_chunk.reset();
+    _merge_exact = true;
+    _pending_pes.clear();
+    _next_pes = 0;
 
     resetSectionDemux();
 }
@@ -415,7 +472,8 @@ void ts::TSAnalyzer::handleTable(SectionDemux&, const BinaryTable& table)
     // Process specific tables
     switch (tid) {
         case TID_PAT: {
-            const PAT pat(_duck, table);
+            // Read the PAT in place, without deserialization.
+            const PATView pat(table);
             if (pid == PID_PAT && pat.isValid()) {
                 analyzePAT(pat);
             }
@@ -443,7 +501,7 @@ void ts::TSAnalyzer::handleTable(SectionDemux&, const BinaryTable& table)
             break;
         }
         case TID_SDT_ACT: {
-            const SDT sdt(_duck, table);
+            const SDTView sdt(table);
             if (sdt.isValid()) {
                 analyzeSDT(sdt);
             }
@@ -521,15 +579,18 @@ void ts::TSAnalyzer::handleTable(SectionDemux&, const BinaryTable& table)
 // Analyze a PAT
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzePAT(const PAT& pat)
+void ts::TSAnalyzer::analyzePAT(const PATView& pat)
 {
     // Get the transport stream id
-    _ts_id = pat.ts_id;
+    _ts_id = pat.tsId();
 
     // Get all PMT PID's for all services
-    for (auto& it : pat.pmts) {
-        uint16_t service_id(it.first);
-        PID pmt_pid(it.second);
+    for (const auto& srv : pat) {
+        if (srv.id() == 0) {
+            continue; // NIT PID
+        }
+        uint16_t service_id(srv.id());
+        PID pmt_pid(srv.pmtPID());
         // Register the PMT PID
         PIDContextPtr ps(getPID(pmt_pid));
         ps->description = u"PMT";
@@ -659,13 +720,13 @@ void ts::TSAnalyzer::analyzeNIT(PID pid, const NIT& nit)
 // Analyze an SDT
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::analyzeSDT(const SDT& sdt)
+void ts::TSAnalyzer::analyzeSDT(const SDTView& sdt)
 {
     // Register characteristics of all services
-    for (auto& it : sdt.services) {
-        ServiceContextPtr svp(getService(it.first)); // it->first = map key = service id
-        svp->orig_netw_id = sdt.onetw_id;
-        svp->update(_duck, it.second.descs);
+    for (const auto& srv : sdt) {
+        ServiceContextPtr svp(getService(srv.id()));
+        svp->orig_netw_id = sdt.originalNetworkId();
+        svp->update(_duck, srv.descriptors());
     }
 }
 
@@ -1314,7 +1375,21 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
 
 void ts::TSAnalyzer::handleNewMPEG2AudioAttributes(PESDemux&, const PESPacket& pkt, const MPEG2AudioAttributes& attr)
 {
-    PIDContextPtr ps(getPID(pkt.sourcePID()));
+    if (_chunk == nullptr && _seq_chunk == nullptr) {
+        addMPEG2AudioAttributes(pkt.sourcePID(), attr);
+    }
+    else {
+        // In chunk mode, the stream type is not known, defer to merge.
+        PESEvent ev;
+        ev.pid = pkt.sourcePID();
+        ev.audio2 = attr;
+        processPESEvent(pkt, ev);
+    }
+}
+
+void ts::TSAnalyzer::addMPEG2AudioAttributes(PID pid, const MPEG2AudioAttributes& attr)
+{
+    PIDContextPtr ps(getPID(pid));
 
     // AAC audio streams have the same outer syntax and are sometimes incorrectly reported as MPEG-2 audio.
     if (ps->stream_type == ST_MPEG1_AUDIO || ps->stream_type == ST_MPEG2_AUDIO) {
@@ -1335,7 +1410,33 @@ void ts::TSAnalyzer::handleNewMPEG2AudioAttributes(PESDemux&, const PESPacket& p
 
 void ts::TSAnalyzer::handleInvalidPESPacket(PESDemux&, const DemuxedData& data)
 {
-    getPID(data.sourcePID())->inv_pes++;
+    if (_chunk == nullptr && _seq_chunk == nullptr) {
+        getPID(data.sourcePID())->inv_pes++;
+    }
+    else {
+        PESEvent ev;
+        ev.pid = data.sourcePID();
+        ev.invalid = true;
+        processPESEvent(data, ev);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Add audio or video attributes of a PES packet.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::addPESAttribute(const DemuxedData& pes, const UString& attr)
+{
+    if (_chunk == nullptr && _seq_chunk == nullptr) {
+        getPID(pes.sourcePID())->addAttribute(attr);
+    }
+    else {
+        PESEvent ev;
+        ev.pid = pes.sourcePID();
+        ev.attribute = attr;
+        processPESEvent(pes, ev);
+    }
 }
 
 
@@ -1346,7 +1447,7 @@ void ts::TSAnalyzer::handleInvalidPESPacket(PESDemux&, const DemuxedData& data)
 
 void ts::TSAnalyzer::handleNewAC3Attributes(PESDemux&, const PESPacket& pkt, const AC3Attributes& attr)
 {
-    getPID(pkt.sourcePID())->addAttribute(attr.toString());
+    addPESAttribute(pkt, attr.toString());
 }
 
 
@@ -1357,7 +1458,7 @@ void ts::TSAnalyzer::handleNewAC3Attributes(PESDemux&, const PESPacket& pkt, con
 
 void ts::TSAnalyzer::handleNewMPEG2VideoAttributes(PESDemux&, const PESPacket& pkt, const MPEG2VideoAttributes& attr)
 {
-    getPID(pkt.sourcePID())->addAttribute(attr.toString());
+    addPESAttribute(pkt, attr.toString());
 }
 
 
@@ -1368,7 +1469,7 @@ void ts::TSAnalyzer::handleNewMPEG2VideoAttributes(PESDemux&, const PESPacket& p
 
 void ts::TSAnalyzer::handleNewAVCAttributes(PESDemux&, const PESPacket& pkt, const AVCAttributes& attr)
 {
-    getPID(pkt.sourcePID())->addAttribute(attr.toString());
+    addPESAttribute(pkt, attr.toString());
 }
 
 
@@ -1379,7 +1480,7 @@ void ts::TSAnalyzer::handleNewAVCAttributes(PESDemux&, const PESPacket& pkt, con
 
 void ts::TSAnalyzer::handleNewHEVCAttributes(PESDemux&, const PESPacket& pkt, const HEVCAttributes& attr)
 {
-    getPID(pkt.sourcePID())->addAttribute(attr.toString());
+    addPESAttribute(pkt, attr.toString());
 }
 
 
@@ -1486,6 +1587,11 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     if (_min_error_before_suspect > 0 && _max_consecutive_suspects > 0 && !pidExists(pkt.getPID())) {
         // Suspect packet detection enabled and potential suspect packet
         if (_preceding_errors >= _min_error_before_suspect || (_preceding_suspects > 0 && _preceding_suspects < _max_consecutive_suspects)) {
+            if (_chunk != nullptr) {
+                // The PID may have been seen before the chunk, see canMergeChunk().
+                _chunk->suspect_dependent = true;
+                _chunk->suspects.push_back(packet_index);
+            }
             _suspect_ignored++;
             _preceding_suspects++;
             _preceding_errors = 0;
@@ -1498,9 +1604,24 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     _preceding_suspects = 0;
 
     // Feed packets into the various demux
-    _demux.feedPacket(pkt);
-    _pes_demux.feedPacket(pkt);
-    _t2mi_demux.feedPacket(pkt);
+    if (_chunk == nullptr) {
+        // PES packets from the previous chunk may complete in a sequentially analyzed chunk.
+        if (!_pending_pes.empty()) {
+            applyPendingPES(packet_index - 1);
+        }
+        _demux.feedPacket(pkt);
+        if (!_pending_pes.empty()) {
+            applyPendingPES(packet_index);
+        }
+        _pes_demux.feedPacket(pkt);
+        _t2mi_demux.feedPacket(pkt);
+    }
+    else {
+        // In chunk mode, the PSI/SI analysis is deferred to mergeChunk().
+        _chunk->pes_index = packet_index;
+        _pes_demux.feedPacket(pkt);
+        collectChunkPacket(pkt, packet_index);
+    }
 
     // Get PID context
     PIDContextPtr ps(getPID(pkt.getPID()));
@@ -1528,30 +1649,14 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     else if (pkt.getScrambling() != SC_CLEAR) {
         ps->ts_sc_cnt++;
     }
-    if (pkt.getScrambling() != ps->cur_ts_sc) {
-        // Change of crypto-period
-        if (ps->cur_ts_sc != SC_CLEAR) {
-            // End of a crypto-period, not a clear/scramble transition.
-            // Count number of crypto-periods:
-            ps->cryptop_cnt++;
-            // Count number of TS packets in all crypto-periods.
-            // Ignore first crypto-period since it is truncated and
-            // not significant for evaluation of duration.
-            if (ps->cryptop_cnt > 1) {
-                ps->cryptop_ts_cnt += packet_index - ps->cur_ts_sc_pkt;
-            }
-        }
-        ps->cur_ts_sc = pkt.getScrambling();
-        ps->cur_ts_sc_pkt = packet_index;
+    if (_chunk == nullptr) {
+        processScrambling(*ps, pkt.getScrambling(), packet_index);
+        checkIIP(*ps);
     }
-
-    // PID_IIP (0x1FF0) is a global PID with ISDB.
-    if (ps->pid == PID_IIP && !ps->carry_iip && bool(_duck.standards() & Standards::ISDB) && ps->services.empty()) {
-        // First time we can consider this PID as IIP. Can be first packet in the PID and we knwow that we use ISDB
-        // or not first packet in the PID but we didn(t know yet the TS was ISDB.
-        ps->carry_iip = true;
-        ps->referenced = true;
-        ps->description = u"ISDB IIP";
+    else if (ps->ts_pkt_cnt == 1 || pkt.getScrambling() != ps->cur_ts_sc) {
+        // In chunk mode, crypto-periods are evaluated in mergeChunk().
+        _chunk->pids[ps->pid].scrambling.emplace_back(packet_index, pkt.getScrambling());
+        ps->cur_ts_sc = pkt.getScrambling();
     }
 
     // Process discontinuities.
@@ -1560,6 +1665,13 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
         if (ps->ts_pkt_cnt == 1) {
             // First packet, initialize continuity
             ps->cur_continuity = pkt.getCC();
+            if (_chunk != nullptr) {
+                // In chunk mode, the continuity with the previous chunk is checked in mergeChunk().
+                ChunkContext::PIDBoundary& pb(_chunk->pids[ps->pid]);
+                pb.first_cc = pkt.getCC();
+                pb.first_payload = pkt.hasPayload();
+                pb.first_discont = pkt.getDiscontinuityIndicator();
+            }
         }
         else if (pkt.getDiscontinuityIndicator()) {
             // Expected discontinuity
@@ -1593,11 +1705,17 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
     if (broken_rate) {
         // Suspected packet loss, forget the last PCR with use to compute bitrate.
         ps->br_last_pcr = INVALID_PCR;
+        if (_chunk != nullptr && ps->pcr_cnt == 0) {
+            _chunk->pids[ps->pid].broken_rate = true;
+        }
     }
     if (pcr != INVALID_PCR) {
         // Count PID's with PCR
         if (ps->pcr_cnt++ == 0) {
             _pcr_pid_cnt++;
+            if (_chunk != nullptr) {
+                _chunk->pids[ps->pid].first_pcr_pkt = packet_index;
+            }
         }
         // If last PCR valid, compute transport rate between the two
         if (ps->br_last_pcr != INVALID_PCR && ps->br_last_pcr < pcr) {
@@ -1704,6 +1822,478 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt, const TSPacketMetadata& mda
 }
 
 
+//----------------------------------------------------------------------------
+// Process scrambling control in a TS packet for crypto-period evaluation.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::processScrambling(PIDContext& ps, uint8_t scrambling, uint64_t packet_index)
+{
+    if (scrambling != ps.cur_ts_sc) {
+        // Change of crypto-period
+        if (ps.cur_ts_sc != SC_CLEAR) {
+            // End of a crypto-period, not a clear/scramble transition.
+            // Count number of crypto-periods:
+            ps.cryptop_cnt++;
+            // Count number of TS packets in all crypto-periods.
+            // Ignore first crypto-period since it is truncated and
+            // not significant for evaluation of duration.
+            if (ps.cryptop_cnt > 1) {
+                ps.cryptop_ts_cnt += packet_index - ps.cur_ts_sc_pkt;
+            }
+        }
+        ps.cur_ts_sc = scrambling;
+        ps.cur_ts_sc_pkt = packet_index;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Check if the ISDB IIP PID can be identified.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::checkIIP(PIDContext& ps)
+{
+    // PID_IIP (0x1FF0) is a global PID with ISDB.
+    if (ps.pid == PID_IIP && !ps.carry_iip && bool(_duck.standards() & Standards::ISDB) && ps.services.empty()) {
+        // First time we can consider this PID as IIP. Can be first packet in the PID and we knwow that we use ISDB
+        // or not first packet in the PID but we didn(t know yet the TS was ISDB.
+        ps.carry_iip = true;
+        ps.referenced = true;
+        ps.description = u"ISDB IIP";
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Start the analysis of one chunk of a larger stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::startChunk(PacketCounter first_index)
+{
+    reset();
+    _ts_pkt_cnt = first_index;
+    _chunk = std::make_shared<ChunkContext>(first_index, _pes_demux.packetCount());
+}
+
+
+//----------------------------------------------------------------------------
+// Start the sequential analysis of one chunk of the stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::startSequentialChunk()
+{
+    // The PES packets which started before the chunk were analyzed with the previous chunk.
+    // Like in a chunk analyzer, the PES demux restarts with the warm-up packets.
+    _pes_demux.reset();
+    _seq_chunk = std::make_shared<ChunkContext>(_ts_pkt_cnt, _pes_demux.packetCount());
+}
+
+
+//----------------------------------------------------------------------------
+// Feed the chunk analyzer with a TS packet which precedes the chunk.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::feedWarmupPacket(const TSPacket& pkt)
+{
+    ChunkContext* const cc = _chunk != nullptr ? _chunk.get() : _seq_chunk.get();
+    if (cc != nullptr && pkt.hasValidSync() && !pkt.getTEI()) {
+        if (ChunkContext::IsPESStart(pkt)) {
+            cc->pes_pids.set(pkt.getPID());
+        }
+        // PES packets which complete during warm-up are ignored.
+        _pes_demux.feedPacket(pkt);
+        cc->pes_start = _pes_demux.packetCount();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Feed the chunk analyzer with a TS packet which follows the chunk.
+//----------------------------------------------------------------------------
+
+bool ts::TSAnalyzer::feedLookaheadPacket(const TSPacket& pkt)
+{
+    ChunkContext* const cc = _chunk != nullptr ? _chunk.get() : _seq_chunk.get();
+    if (cc == nullptr) {
+        return false;
+    }
+
+    // At the start of the lookahead phase, get the list of PES packets to complete.
+    if (!cc->lookahead) {
+        if (_chunk == nullptr) {
+            applyPendingPES(_ts_pkt_cnt);
+        }
+        cc->lookahead = true;
+        cc->pes_index = _ts_pkt_cnt;
+        for (PID pid = 0; pid < PID_MAX; ++pid) {
+            cc->pending_pids.set(pid, _pes_demux.hasPendingPES(pid));
+        }
+    }
+    cc->pes_index++;
+
+    // Only feed the PES demux with the packets of PES packets to complete.
+    // The PES packet which starts in a unit start packet belongs to the next chunk.
+    const PID pid = pkt.getPID();
+    if (pkt.hasValidSync() && !pkt.getTEI() && cc->pending_pids.test(pid)) {
+        _pes_demux.feedPacket(pkt);
+        if (pkt.getPUSI() || !_pes_demux.hasPendingPES(pid)) {
+            cc->pending_pids.reset(pid);
+        }
+    }
+    return cc->pending_pids.any();
+}
+
+
+//----------------------------------------------------------------------------
+// In chunk mode, collect a packet which may carry sections.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::collectChunkPacket(const TSPacket& pkt, uint64_t packet_index)
+{
+    const PID pid = pkt.getPID();
+    const bool psi_pid = ChunkContext::IsPSIPID(pid);
+
+    // Ignore packets which are known to never carry sections.
+    if (pid == PID_NULL || (!psi_pid && _chunk->pes_pids.test(pid))) {
+        return;
+    }
+
+    if (pkt.getScrambling() != SC_CLEAR) {
+        // A scrambled packet only breaks the section demux on this PID.
+        // Keep only the first one in a sequence of scrambled packets.
+        if (!_chunk->scrambled_pids.test(pid)) {
+            _chunk->scrambled_pids.set(pid);
+            _chunk->packets.emplace_back(packet_index, pkt);
+        }
+    }
+    else if (!psi_pid && ChunkContext::IsPESStart(pkt)) {
+        // This PID carries PES packets, no longer collect packets from it.
+        _chunk->pes_pids.set(pid);
+    }
+    else {
+        _chunk->scrambled_pids.reset(pid);
+        _chunk->packets.emplace_back(packet_index, pkt);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Merge the analysis of a chunk of the stream into this analyzer.
+//----------------------------------------------------------------------------
+
+bool ts::TSAnalyzer::canMergeChunk(const TSAnalyzer& chunk) const
+{
+    // Without invalid packets before or inside the chunk, there is no suspect packet at all.
+    // Otherwise, the chunk and the sequential analysis take the same decisions as long as
+    // the chunk analyzer already knew the PID of each potential suspect packet.
+    return chunk._chunk != nullptr &&
+        (_min_error_before_suspect == 0 || _max_consecutive_suspects == 0 ||
+         (_preceding_errors == 0 && _preceding_suspects == 0 && !chunk._chunk->suspect_dependent));
+}
+
+bool ts::TSAnalyzer::mergeChunk(TSAnalyzer& chunk, const PacketReader& reader)
+{
+    if (_chunk != nullptr || chunk._chunk == nullptr || chunk._chunk->first_index != _ts_pkt_cnt) {
+        return false;
+    }
+    ChunkContext& cc(*chunk._chunk);
+    if (!canMergeChunk(chunk)) {
+        _merge_exact = false;
+    }
+    _seq_chunk.reset();
+
+    // Global packet-level statistics.
+    if (_first_utc == Time::Epoch) {
+        _first_utc = chunk._first_utc;
+        _first_local = chunk._first_local;
+    }
+    _modified = true;
+    _invalid_sync += chunk._invalid_sync;
+    _transport_errors += chunk._transport_errors;
+    _suspect_ignored += chunk._suspect_ignored;
+    _preceding_errors = chunk._preceding_errors;
+    _preceding_suspects = chunk._preceding_suspects;
+    _ts_bitrate_sum += chunk._ts_bitrate_sum;
+    _ts_bitrate_cnt += chunk._ts_bitrate_cnt;
+
+    // Per-PID packet-level statistics.
+    for (const auto& it : chunk._pids) {
+        mergeChunkPID(chunk, *it.second);
+    }
+
+    // Replay packets which may carry sections and PES analysis results, in the same order as the
+    // sequential analysis: section demux, PES analysis, T2-MI demux, for each packet index.
+    _pending_pes.erase(_pending_pes.begin(), _pending_pes.begin() + _next_pes);
+    _pending_pes.insert(_pending_pes.end(), cc.pes_events.begin(), cc.pes_events.end());
+    std::stable_sort(_pending_pes.begin(), _pending_pes.end(), [](const PESEvent& e1, const PESEvent& e2) { return e1.index < e2.index; });
+    _next_pes = 0;
+
+    // The packets of PID's carrying PES packets were not collected. The PID filters of the demux are
+    // never reduced: as long as they don't include these PID's, the collected packets are sufficient.
+    std::vector<PID> pes_pids;
+    for (PID pid = 0; pid < PID_MAX; ++pid) {
+        if (cc.pes_pids.test(pid) && !ChunkContext::IsPSIPID(pid)) {
+            pes_pids.push_back(pid);
+        }
+    }
+    const auto demuxed = [this, &pes_pids]() {
+        return std::any_of(pes_pids.begin(), pes_pids.end(), [this](PID pid) { return _demux.hasPID(pid) || _t2mi_demux.hasPID(pid); });
+    };
+    bool reread = demuxed();
+    for (auto it = cc.packets.begin(); !reread && it != cc.packets.end(); ++it) {
+        replayChunkPacket(it->second, it->first);
+        reread = !pes_pids.empty() && demuxed();
+    }
+
+    // When one of these PID's is demuxed, replay all the rest of the chunk, read again from the stream.
+    // Invalid and suspect packets are skipped, as in the analysis of the chunk.
+    if (reread && reader == nullptr) {
+        _merge_exact = false;
+    }
+    else if (reread) {
+        uint64_t index = _ts_pkt_cnt;
+        auto suspect = std::upper_bound(cc.suspects.begin(), cc.suspects.end(), index);
+        TSPacketVector pkts(256);
+        while (index < chunk._ts_pkt_cnt) {
+            const size_t count = reader(index, pkts.data(), size_t(std::min<uint64_t>(pkts.size(), chunk._ts_pkt_cnt - index)));
+            if (count == 0) {
+                _merge_exact = false;
+                break;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                ++index;
+                if (suspect != cc.suspects.end() && *suspect == index) {
+                    ++suspect;
+                }
+                else if (pkts[i].hasValidSync() && !pkts[i].getTEI()) {
+                    replayChunkPacket(pkts[i], index);
+                }
+            }
+        }
+    }
+    _ts_pkt_cnt = chunk._ts_pkt_cnt;
+
+    // PES packets which were completed after the chunk are applied with the next chunk.
+    applyPendingPES(_ts_pkt_cnt);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Replay a packet of a chunk into the PSI/SI analysis.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::replayChunkPacket(const TSPacket& pkt, uint64_t packet_index)
+{
+    applyPendingPES(packet_index - 1);
+    _ts_pkt_cnt = packet_index;
+    _demux.feedPacket(pkt);
+    applyPendingPES(packet_index);
+    _t2mi_demux.feedPacket(pkt);
+    if (pkt.getPID() == PID_IIP) {
+        checkIIP(*getPID(PID_IIP));
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Apply the deferred PES analysis results up to a packet index.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::applyPendingPES(uint64_t last_index)
+{
+    while (_next_pes < _pending_pes.size() && _pending_pes[_next_pes].index <= last_index) {
+        applyPESEvent(_pending_pes[_next_pes++]);
+    }
+    if (_next_pes >= _pending_pes.size()) {
+        _pending_pes.clear();
+        _next_pes = 0;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Apply, defer or ignore a PES analysis result.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::processPESEvent(const DemuxedData& pes, PESEvent& ev)
+{
+    if (_chunk != nullptr) {
+        // In chunk mode, keep the PES packets which started in the chunk, apply them during merge.
+        if (_chunk->inChunk(pes)) {
+            ev.index = _chunk->pes_index;
+            _chunk->pes_events.push_back(std::move(ev));
+        }
+    }
+    else if (_seq_chunk == nullptr) {
+        applyPESEvent(ev);
+    }
+    else if (_seq_chunk->inChunk(pes)) {
+        // In a sequentially analyzed chunk, the PES packets which complete after the chunk
+        // are applied with the next chunk. Those which started before the chunk were analyzed
+        // with the previous chunk.
+        if (_seq_chunk->lookahead) {
+            ev.index = _seq_chunk->pes_index;
+            _pending_pes.push_back(std::move(ev));
+        }
+        else {
+            applyPESEvent(ev);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Apply the result of the analysis of a PES packet in a chunk.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::applyPESEvent(const PESEvent& ev)
+{
+    if (ev.invalid) {
+        getPID(ev.pid)->inv_pes++;
+    }
+    else if (ev.audio2.isValid()) {
+        addMPEG2AudioAttributes(ev.pid, ev.audio2);
+    }
+    else {
+        getPID(ev.pid)->addAttribute(ev.attribute);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Merge packet-level statistics of a PID from a chunk.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::mergeChunkPID(const TSAnalyzer& chunk, const PIDContext& cps)
+{
+    if (cps.ts_pkt_cnt == 0) {
+        return;
+    }
+    PIDContextPtr ps(getPID(cps.pid));
+    const auto cpb = chunk._chunk->pids.find(cps.pid);
+    const ChunkContext::PIDBoundary empty_boundary;
+    const ChunkContext::PIDBoundary& pb(cpb == chunk._chunk->pids.end() ? empty_boundary : cpb->second);
+
+    // Continuity between the last packet in this analyzer and the first packet in the chunk, same as feedPacket().
+    bool broken_rate = false;
+    if (ps->pid != PID_NULL && ps->ts_pkt_cnt > 0) {
+        if (pb.first_discont) {
+            ps->exp_discont++;
+            broken_rate = true;
+        }
+        else if (pb.first_payload) {
+            if (pb.first_cc == ps->cur_continuity) {
+                ps->duplicated++;
+            }
+            else if (pb.first_cc != (ps->cur_continuity + 1) % CC_MAX) {
+                ps->unexp_discont++;
+                broken_rate = true;
+            }
+        }
+        else if (pb.first_cc != ps->cur_continuity) {
+            ps->unexp_discont++;
+            broken_rate = true;
+        }
+    }
+    if (ps->pid != PID_NULL) {
+        ps->cur_continuity = cps.cur_continuity;
+    }
+
+    // Cumulated counters.
+    ps->ts_pkt_cnt += cps.ts_pkt_cnt;
+    ps->ts_af_cnt += cps.ts_af_cnt;
+    ps->unit_start_cnt += cps.unit_start_cnt;
+    ps->pl_start_cnt += cps.pl_start_cnt;
+    ps->unexp_discont += cps.unexp_discont;
+    ps->exp_discont += cps.exp_discont;
+    ps->duplicated += cps.duplicated;
+    ps->ts_sc_cnt += cps.ts_sc_cnt;
+    ps->inv_ts_sc_cnt += cps.inv_ts_sc_cnt;
+    ps->inv_pes_start += cps.inv_pes_start;
+    ps->pcr_cnt += cps.pcr_cnt;
+    ps->pts_cnt += cps.pts_cnt;
+    ps->dts_cnt += cps.dts_cnt;
+    ps->pcr_leap_cnt += cps.pcr_leap_cnt;
+    ps->pts_leap_cnt += cps.pts_leap_cnt;
+    ps->dts_leap_cnt += cps.dts_leap_cnt;
+    for (const auto& it : cps.isdb_layers) {
+        ps->isdb_layers[it.first] += it.second;
+    }
+
+    // Scrambling and crypto-periods.
+    if (cps.scrambled && !ps->scrambled) {
+        ps->scrambled = true;
+        _scrambled_pid_cnt++;
+    }
+    for (const auto& it : pb.scrambling) {
+        processScrambling(*ps, it.second, it.first);
+    }
+
+    // PCR's and bitrate evaluation.
+    if (cps.first_pcr != INVALID_PCR) {
+        if (ps->first_pcr == INVALID_PCR) {
+            _pcr_pid_cnt++;
+            ps->first_pcr = cps.first_pcr;
+        }
+        // Bitrate between last PCR in this analyzer and first PCR in the chunk.
+        if (!broken_rate && !pb.broken_rate && ps->br_last_pcr != INVALID_PCR && ps->br_last_pcr < cps.first_pcr) {
+            const BitRate ts_bitrate = BitRate((pb.first_pcr_pkt - ps->br_last_pcr_pkt) * SYSTEM_CLOCK_FREQ * PKT_SIZE_BITS) / (cps.first_pcr - ps->br_last_pcr);
+            ps->ts_bitrate_sum += ts_bitrate;
+            ps->ts_bitrate_cnt++;
+            _ts_bitrate_sum += ts_bitrate;
+            _ts_bitrate_cnt++;
+        }
+        // PCR leap between the two.
+        if (ps->last_pcr != INVALID_PCR && (ps->last_pcr > cps.first_pcr || (cps.first_pcr - ps->last_pcr) > SYSTEM_CLOCK_FREQ)) {
+            ps->pcr_leap_cnt++;
+        }
+        ps->last_pcr = cps.last_pcr;
+        ps->br_last_pcr = cps.br_last_pcr;
+        ps->br_last_pcr_pkt = cps.br_last_pcr_pkt;
+    }
+    else if (broken_rate || pb.broken_rate) {
+        ps->br_last_pcr = INVALID_PCR;
+    }
+    ps->ts_bitrate_sum += cps.ts_bitrate_sum;
+    ps->ts_bitrate_cnt += cps.ts_bitrate_cnt;
+
+    // PTS and DTS leaps between the two.
+    if (cps.first_pts != INVALID_PTS) {
+        if (ps->last_pts != INVALID_PTS) {
+            const uint64_t diff = cps.first_pts > ps->last_pts ? cps.first_pts - ps->last_pts : ps->last_pts - cps.first_pts;
+            if (diff > 3 * SYSTEM_CLOCK_SUBFREQ) {
+                ps->pts_leap_cnt++;
+            }
+        }
+        if (ps->first_pts == INVALID_PTS) {
+            ps->first_pts = cps.first_pts;
+        }
+        ps->last_pts = cps.last_pts;
+    }
+    if (cps.first_dts != INVALID_DTS) {
+        if (ps->last_dts != INVALID_DTS && (ps->last_dts > cps.first_dts || (cps.first_dts - ps->last_dts) > 3 * SYSTEM_CLOCK_SUBFREQ)) {
+            ps->dts_leap_cnt++;
+        }
+        if (ps->first_dts == INVALID_DTS) {
+            ps->first_dts = cps.first_dts;
+        }
+        ps->last_dts = cps.last_dts;
+    }
+
+    // PES stream id.
+    if (cps.pes_stream_id != 0) {
+        if (ps->pes_stream_id == 0) {
+            ps->pes_stream_id = cps.pes_stream_id;
+            ps->same_stream_id = cps.same_stream_id;
+        }
+        else {
+            ps->same_stream_id = ps->same_stream_id && cps.same_stream_id && ps->pes_stream_id == cps.pes_stream_id;
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Specify a "bitrate hint" for the analysis. It is the user-specified
 // bitrate in bits/seconds, based on 188-byte packets. The bitrate is
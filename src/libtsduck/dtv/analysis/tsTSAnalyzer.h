@@ -19,11 +19,11 @@
 #include "tsT2MIDemux.h"
 #include "tsISDB.h"
 #include "tsLogicalChannelNumbers.h"
-#include "tsPAT.h"
+#include "tsPATView.h"
 #include "tsCAT.h"
 #include "tsPMT.h"
 #include "tsNIT.h"
-#include "tsSDT.h"
+#include "tsSDTView.h"
 #include "tsTDT.h"
 #include "tsTOT.h"
 #include "tsMGT.h"
@@ -33,6 +33,9 @@
 #include "tsSGT.h"
 #include "tsTime.h"
 #include "tsUString.h"
+#include "tsBeforeStandardHeaders.h"
+#include <functional>
+#include "tsAfterStandardHeaders.h"
 
 namespace ts {
     //!
@@ -71,6 +74,118 @@ namespace ts {
         //!
         void feedPacket(const TSPacket& packet, const TSPacketMetadata& mdata);
 
+        //!
+        //! Start the analysis of one chunk of a larger stream.
+        //!
+        //! A large stream can be split into contiguous chunks of TS packets which are analyzed
+        //! in parallel, one analyzer per chunk. The analyzers of all chunks are then merged,
+        //! in order, into a main analyzer using mergeChunk(). The merged analysis is the same
+        //! as the sequential analysis of the complete stream.
+        //!
+        //! In chunk mode, feedPacket() accumulates the packet-level statistics of the chunk and
+        //! collects the TS packets which may carry sections. Audio/video attributes are extracted
+        //! from the PES packets which start in the chunk. The PSI/SI analysis is deferred to
+        //! mergeChunk(), where the collected packets are replayed in the main analyzer.
+        //!
+        //! The sequence of calls for one chunk is:
+        //! - startChunk()
+        //! - feedWarmupPacket() on some packets which precede the chunk, if any.
+        //! - feedPacket() on all packets of the chunk.
+        //! - feedLookaheadPacket() on the packets which follow the chunk, until it returns false.
+        //!
+        //! Limitations: the PSI/SI are not analyzed inside the chunk analyzer. The detection of
+        //! "suspect" packets only knows the PID's which were seen in the chunk. Packets of PID's
+        //! which were identified as carrying PES packets are not collected for the PSI/SI analysis.
+        //! When the detection of suspect packets in a chunk depends on PID's which were seen before
+        //! the chunk, canMergeChunk() returns false and the chunk must be analyzed again in the main
+        //! analyzer, using startSequentialChunk(). When the PSI/SI analysis starts to demux one of
+        //! the PES PID's of a chunk, mergeChunk() reads the rest of the chunk again.
+        //!
+        //! @param [in] first_index Number of packets in the stream before the chunk.
+        //! @see mergeChunk()
+        //!
+        void startChunk(PacketCounter first_index);
+
+        //!
+        //! Feed the chunk analyzer with a TS packet which precedes the chunk.
+        //! The warm-up packets do not contribute to the analysis. They are used to collect the
+        //! PMT's and the identification of PID's carrying PES packets before the chunk.
+        //! @param [in] packet One TS packet from the stream, before the chunk.
+        //! @see startChunk()
+        //!
+        void feedWarmupPacket(const TSPacket& packet);
+
+        //!
+        //! Feed the chunk analyzer with a TS packet which follows the chunk.
+        //! The lookahead packets do not contribute to the analysis. They are used to complete
+        //! the PES packets which started in the chunk.
+        //! @param [in] packet One TS packet from the stream, after the chunk.
+        //! @return True if more lookahead packets are needed, false when all PES packets
+        //! which started in the chunk are complete.
+        //! @see startChunk()
+        //!
+        bool feedLookaheadPacket(const TSPacket& packet);
+
+        //!
+        //! Profile of a function which reads TS packets from the analyzed stream again.
+        //! - Parameter @a position: Number of packets in the stream before the first packet to read.
+        //! - Parameter @a buffer: Address of the buffer of packets to read.
+        //! - Parameter @a count: Maximum number of packets to read.
+        //! - Return value: Number of packets which were read, zero on end of stream or error.
+        //!
+        using PacketReader = std::function<size_t(PacketCounter position, TSPacket* buffer, size_t count)>;
+
+        //!
+        //! Check if the analysis of a chunk of the stream can be merged into this analyzer.
+        //! The chunk cannot be merged when its detection of suspect packets depends on PID's which
+        //! were seen before the chunk: after invalid packets, either before the chunk or inside the
+        //! chunk, before the first packet of a PID in the chunk. This is rare in practice.
+        //! The chunk must then be analyzed again in this analyzer, using startSequentialChunk().
+        //! @param [in] chunk The analyzer of the chunk, in chunk mode.
+        //! @return True if @a chunk can be merged with the same result as a sequential analysis.
+        //!
+        bool canMergeChunk(const TSAnalyzer& chunk) const;
+
+        //!
+        //! Merge the analysis of a chunk of the stream into this analyzer.
+        //! The chunks must be merged in order. The chunk must start right after the last packet
+        //! which was either merged or passed to feedPacket() in this analyzer.
+        //!
+        //! The packets of PID's carrying PES packets are not collected by the chunk analyzer.
+        //! When the PSI/SI analysis starts to demux one of these PID's during the merge, the rest
+        //! of the chunk is read again using @a reader and all its packets are replayed.
+        //!
+        //! @param [in,out] chunk The analyzer of the chunk, in chunk mode. Its content is undefined after merge.
+        //! @param [in] reader Function to read the packets of the chunk again, when necessary.
+        //! @return True on success, false if @a chunk is not the next chunk of the stream.
+        //! @see startChunk()
+        //! @see isMergeExact()
+        //!
+        bool mergeChunk(TSAnalyzer& chunk, const PacketReader& reader = nullptr);
+
+        //!
+        //! Check if all chunks which were merged give the same analysis as a sequential analysis.
+        //! The merged analysis may differ when a chunk was merged while canMergeChunk() returned
+        //! false or when mergeChunk() needed to read packets again but had no @a reader or failed to read them.
+        //! @return True if the merged analysis is the same as the sequential analysis of the stream.
+        //! @see mergeChunk()
+        //!
+        bool isMergeExact() const { return _merge_exact; }
+
+        //!
+        //! Start the sequential analysis of one chunk of the stream, in this main analyzer.
+        //! This is used when a chunk cannot be merged, see canMergeChunk(). The sequence of calls is
+        //! the same as in a chunk analyzer, on the same packets:
+        //! - startSequentialChunk()
+        //! - feedWarmupPacket() on some packets which precede the chunk, if any.
+        //! - feedPacket() on all packets of the chunk.
+        //! - feedLookaheadPacket() on the packets which follow the chunk, until it returns false.
+        //!
+        //! The next chunk can then be merged using mergeChunk().
+        //! @see startChunk()
+        //!
+        void startSequentialChunk();
+
         //!
         //! Reset the analysis context.
         //!
@@ -201,6 +316,14 @@ namespace ts {
             //! @param [in] descs Descriptor list from SDT or PMT.
             //!
             void update(DuckContext& duck, const DescriptorList& descs);
+
+            //!
+            //! Update service information from a binary descriptor list.
+            //! Only the service_descriptor, if present, is deserialized.
+            //! @param [in,out] duck TSDuck execution context.
+            //! @param [in] descs View over a descriptor list from an SDT.
+            //!
+            void update(DuckContext& duck, const DescriptorListView& descs);
         };
 
         //!
@@ -517,11 +640,11 @@ namespace ts {
         void resetSectionDemux();
 
         // Analyze the various PSI tables
-        void analyzePAT(const PAT&);
+        void analyzePAT(const PATView&);
         void analyzeCAT(const CAT&);
         void analyzePMT(PID pid, const PMT&);
         void analyzeNIT(PID pid, const NIT&);
-        void analyzeSDT(const SDT&);
+        void analyzeSDT(const SDTView&);
         void analyzeTDT(const TDT&);
         void analyzeTOT(const TOT&);
         void analyzeMGT(const MGT&);
@@ -563,6 +686,49 @@ namespace ts {
         virtual void handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt) override;
         virtual void handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket& ts) override;
 
+        // Result of the analysis of a PES packet in a chunk, applied during merge.
+        class PESEvent
+        {
+        public:
+            uint64_t index = 0;            // Packet index in the complete stream.
+            PID      pid = PID_NULL;       // PID of the PES packet.
+            bool     invalid = false;      // Invalid PES packet.
+            UString  attribute {};         // Audio or video attributes, if not empty.
+            MPEG2AudioAttributes audio2 {};  // MPEG-2 audio attributes, if valid.
+        };
+
+        // Analysis state of a chunk of a larger stream.
+        class ChunkContext;
+        using ChunkContextPtr = std::shared_ptr<ChunkContext>;
+
+        // Record PES analysis results, or defer them in chunk mode.
+        void addPESAttribute(const DemuxedData& pes, const UString& attr);
+        void addMPEG2AudioAttributes(PID pid, const MPEG2AudioAttributes& attr);
+
+        // Process scrambling control in a TS packet for crypto-period evaluation.
+        static void processScrambling(PIDContext& ps, uint8_t scrambling, uint64_t packet_index);
+
+        // In chunk mode, collect a packet which may carry sections.
+        void collectChunkPacket(const TSPacket& pkt, uint64_t packet_index);
+
+        // Merge packet-level statistics of a PID from a chunk.
+        void mergeChunkPID(const TSAnalyzer& chunk, const PIDContext& cps);
+
+        // Apply the result of the analysis of a PES packet in a chunk.
+        void applyPESEvent(const PESEvent& ev);
+
+        // Apply, defer or ignore a PES analysis result, in chunk mode or in a sequential chunk.
+        void processPESEvent(const DemuxedData& pes, PESEvent& ev);
+
+        // Apply the deferred PES analysis results up to a packet index.
+        void applyPendingPES(uint64_t last_index);
+
+        // Replay a packet of a chunk into the PSI/SI analysis.
+        void replayChunkPacket(const TSPacket& pkt, uint64_t packet_index);
+
+        // Check if the ISDB IIP PID can be identified.
+        void checkIIP(PIDContext& ps);
+
         // TSAnalyzer private members (state data, used during analysis):
         bool         _modified = false;              // Internal data modified, need recomputeStatistics
         BitRate      _ts_bitrate_sum = 0;            // Sum of all computed TS bitrates
@@ -576,5 +742,10 @@ namespace ts {
         T2MIDemux    _t2mi_demux {_duck, this};      // T2-MI analysis
         LogicalChannelNumbers _lcn {_duck};          // Accumulate LCN and visible flags
         DCT          _dct {};                        // Last ISDB CDT waiting to be analyzed, waiting for TS id
+        ChunkContextPtr       _chunk {};             // Non-null in chunk mode
+        ChunkContextPtr       _seq_chunk {};         // Non-null in a chunk which is sequentially analyzed in the main analyzer
+        bool                  _merge_exact = true;   // All merged chunks give the same result as a sequential analysis
+        std::vector<PESEvent> _pending_pes {};       // Deferred PES events from merged chunks, after the last merged packet
+        size_t                _next_pes = 0;         // Index of next PES event to apply in _pending_pes
     };
 }
@@ -0,0 +1,395 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketMatcher.h"
+
+
+//----------------------------------------------------------------------------
+// Matching of one group of PID's.
+//----------------------------------------------------------------------------
+
+class ts::TSPacketMatcher::Group
+{
+    TS_NOBUILD_NOCOPY(Group);
+public:
+    // Constructor.
+    Group(const Options& opt) : _opt(opt) {}
+
+    // Events which were found in the last release().
+    std::vector<Event> events {};
+
+    // Add a packet from one stream, match it with an identical unmatched packet from the other stream.
+    void addPacket(size_t stream, PacketCounter index, const TSPacket& pkt);
+
+    // Release packets which are before the window, report missing, duplicated and reordered packets.
+    // The arrays are indexed by stream: index of next packet to add and end of stream indicator.
+    void release(const PacketCounter next[2], const bool eof[2]);
+
+    // Index in stream 0 of the last packet which was matched in order and current offset.
+    PacketCounter lastIndex() const { return _last[0]; }
+    int64_t offset() const { return _offset; }
+
+    static constexpr uint64_t NONE = std::numeric_limits<uint64_t>::max();
+
+private:
+    // A packet in the window.
+    struct Entry
+    {
+        PacketCounter index = 0;        // Packet index in its stream.
+        uint64_t      fingerprint = 0;  // Packet fingerprint.
+        PacketCounter partner = NONE;   // Index of the matching packet in the other stream.
+        uint64_t      next_same = NONE; // Sequence of next unmatched packet with same fingerprint.
+        bool          duplicate = false;// Same fingerprint as previous packet in same PID.
+        TSPacket      packet {};
+    };
+
+    // First and last unmatched packets with the same fingerprint, by sequence number.
+    struct Chain
+    {
+        uint64_t head = NONE;
+        uint64_t tail = NONE;
+    };
+    using ChainMap = std::unordered_map<uint64_t, Chain>;
+
+    // Packets from one stream.
+    struct Side
+    {
+        std::deque<Entry>      entries {};           // Window of packets.
+        uint64_t               first_seq = 0;        // Sequence number of entries.front().
+        ChainMap               unmatched {};         // Unmatched packets by fingerprint.
+        std::map<PID,uint64_t> last_fingerprint {};  // Last fingerprint in each PID.
+
+        // Access an entry by sequence number.
+        Entry& entry(uint64_t seq) { return entries[size_t(seq - first_seq)]; }
+
+        // Remove the first entry from a chain of unmatched packets.
+        void popChain(ChainMap::iterator chain);
+    };
+
+    // Order of the first matched packet of stream 0, relatively to the current offset.
+    enum class Order {IN_ORDER, REORDERED, WAIT};
+
+    const Options& _opt;
+    Side           _sides[2] {};
+    PacketCounter  _last[2] {NONE, NONE};  // Last packets which were matched in order, in each stream.
+    int64_t        _offset = 0;            // Offset between the last packets which were matched in order.
+
+    // Check if an unmatched packet can no longer be matched: the other stream is beyond the window around its expected position.
+    bool expired(size_t stream, const Entry& entry, const PacketCounter next[2], const bool eof[2]) const;
+
+    // Check the order of the first packet of stream 0, which is matched.
+    Order checkOrder(const PacketCounter next[2], const bool eof[2]) const;
+};
+
+
+// Remove the first entry from a chain of unmatched packets.
+void ts::TSPacketMatcher::Group::Side::popChain(ChainMap::iterator chain)
+{
+    const uint64_t next = entry(chain->second.head).next_same;
+    if (next == NONE) {
+        unmatched.erase(chain);
+    }
+    else {
+        chain->second.head = next;
+    }
+}
+
+
+// Add a packet from one stream.
+void ts::TSPacketMatcher::Group::addPacket(size_t stream, PacketCounter index, const TSPacket& pkt)
+{
+    Side& side(_sides[stream]);
+    Side& other(_sides[1 - stream]);
+
+    Entry& entry(side.entries.emplace_back());
+    const uint64_t seq = side.first_seq + side.entries.size() - 1;
+    entry.index = index;
+    entry.fingerprint = Fingerprint(pkt, _opt);
+    entry.packet = pkt;
+
+    // Check if this packet is identical to the previous one in the same PID.
+    const auto last = side.last_fingerprint.emplace(pkt.getPID(), entry.fingerprint);
+    entry.duplicate = !last.second && last.first->second == entry.fingerprint;
+    last.first->second = entry.fingerprint;
+
+    // Match with the oldest unmatched identical packet in the other stream.
+    // Compare the packet content to exclude fingerprint collisions.
+    const auto chain = other.unmatched.find(entry.fingerprint);
+    if (chain != other.unmatched.end()) {
+        Entry& match(other.entry(chain->second.head));
+        if (Equal(pkt, match.packet, _opt)) {
+            match.partner = index;
+            entry.partner = match.index;
+            other.popChain(chain);
+            return;
+        }
+    }
+
+    // Not found, wait for a matching packet in the other stream.
+    Chain& same(side.unmatched[entry.fingerprint]);
+    if (same.head == NONE) {
+        same.head = seq;
+    }
+    else {
+        side.entry(same.tail).next_same = seq;
+    }
+    same.tail = seq;
+}
+
+
+// Check if an unmatched packet can no longer be matched.
+bool ts::TSPacketMatcher::Group::expired(size_t stream, const Entry& entry, const PacketCounter next[2], const bool eof[2]) const
+{
+    const size_t other = 1 - stream;
+    const int64_t expected = int64_t(entry.index) + (stream == 0 ? _offset : -_offset);
+    return eof[other] || int64_t(next[other]) > expected + int64_t(_opt.window);
+}
+
+
+// Check the order of the first packet of stream 0, which is matched.
+ts::TSPacketMatcher::Group::Order ts::TSPacketMatcher::Group::checkOrder(const PacketCounter next[2], const bool eof[2]) const
+{
+    const std::deque<Entry>& entries(_sides[0].entries);
+    const Entry& entry(entries.front());
+
+    if (_last[1] != NONE && entry.partner <= _last[1]) {
+        // Before the last packet which was matched in order in the other stream.
+        return Order::REORDERED;
+    }
+    if (int64_t(entry.partner) <= int64_t(entry.index) + _offset) {
+        // At the expected position or after packets which are missing in stream 1.
+        return Order::IN_ORDER;
+    }
+
+    // After the expected position: either packets were inserted in stream 1 or this packet was moved ahead.
+    // This is a new offset only when the next matched packet in stream 0 confirms it.
+    for (size_t i = 1; i < entries.size(); ++i) {
+        if (entries[i].partner != NONE) {
+            return entries[i].partner > entry.partner ? Order::IN_ORDER : Order::REORDERED;
+        }
+        if (!expired(0, entries[i], next, eof)) {
+            return Order::WAIT;
+        }
+    }
+    return eof[0] ? Order::IN_ORDER : Order::WAIT;
+}
+
+
+// Release packets which are before the window.
+void ts::TSPacketMatcher::Group::release(const PacketCounter next[2], const bool eof[2])
+{
+    for (size_t stream = 0; stream < 2; ++stream) {
+        Side& side(_sides[stream]);
+        while (!side.entries.empty()) {
+            const Entry& entry(side.entries.front());
+            if (entry.partner != NONE) {
+                // Matched packet. The packets from the first stream are checked in order,
+                // their partners shall follow the current offset in the second stream.
+                if (stream == 0) {
+                    const Order order = checkOrder(next, eof);
+                    if (order == Order::WAIT) {
+                        break;
+                    }
+                    else if (order == Order::REORDERED) {
+                        events.push_back(Event{Event::REORDER, 0, entry.index, entry.partner, 1});
+                    }
+                    else {
+                        _last[0] = entry.index;
+                        _last[1] = entry.partner;
+                        _offset = int64_t(entry.partner) - int64_t(entry.index);
+                    }
+                }
+            }
+            else if (expired(stream, entry, next, eof)) {
+                // Not found in the window of the other stream.
+                events.push_back(Event{entry.duplicate ? Event::DUPLICATE : Event::MISSING, stream, entry.index, 0, 1});
+                side.popChain(side.unmatched.find(entry.fingerprint));
+            }
+            else {
+                // Can still be matched later.
+                break;
+            }
+            side.entries.pop_front();
+            side.first_seq++;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::TSPacketMatcher::TSPacketMatcher(const Options& options) :
+    _opt(options),
+    _pool(_opt.pid_ignore ? 1 : std::max<size_t>(1, _opt.threads))
+{
+    // Each group of PID's is processed by a distinct matcher.
+    const size_t group_count = _opt.pid_ignore ? 1 : std::max<size_t>(1, _opt.threads);
+    for (size_t i = 0; i < group_count; ++i) {
+        _groups.push_back(std::make_unique<Group>(_opt));
+    }
+    if (group_count > 1) {
+        _pool.start();
+    }
+}
+
+ts::TSPacketMatcher::~TSPacketMatcher()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Get the number of packets to read next in one stream.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacketMatcher::readCount(size_t stream) const
+{
+    // Streams are read by chunks, smaller than the search window.
+    // The stream which is late relatively to the current offset reads more packets.
+    const int64_t ahead = int64_t(_next[1]) - int64_t(_next[0]) - _offset;
+    const int64_t late = stream == 0 ? ahead : -ahead;
+    return std::max<size_t>(1, _opt.window / 4) + size_t(std::clamp<int64_t>(late, 0, int64_t(_opt.window)));
+}
+
+
+//----------------------------------------------------------------------------
+// Feed the matcher with the next chunks of packets from the two streams.
+//----------------------------------------------------------------------------
+
+void ts::TSPacketMatcher::feedPackets(const TSPacketVector packets[2], const bool eof[2], std::vector<Event>& events)
+{
+    const PacketCounter first[2] {_next[0], _next[1]};
+    _next[0] += packets[0].size();
+    _next[1] += packets[1].size();
+
+    // Process the chunks of packets in one group of PID's.
+    const size_t group_count = _groups.size();
+    const auto process = [&](size_t group) {
+        Group& matcher(*_groups[group]);
+        const size_t count = std::max(packets[0].size(), packets[1].size());
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t s = 0; s < 2; ++s) {
+                if (i < packets[s].size() && (group_count == 1 || packets[s][i].getPID() % group_count == group)) {
+                    matcher.addPacket(s, first[s] + i, packets[s][i]);
+                }
+            }
+        }
+        matcher.release(_next, eof);
+    };
+
+    // Match packets in all groups of PID's.
+    if (group_count == 1) {
+        process(0);
+    }
+    else {
+        std::vector<std::future<void>> results;
+        for (size_t group = 0; group < group_count; ++group) {
+            results.push_back(_pool.submit([&process, group]() { process(group); }));
+        }
+        for (auto& res : results) {
+            res.get();
+        }
+    }
+
+    // Report events in stream order. The current offset is given by the most recent match in order.
+    events.clear();
+    PacketCounter last = Group::NONE;
+    for (auto& group : _groups) {
+        events.insert(events.end(), group->events.begin(), group->events.end());
+        group->events.clear();
+        if (group->lastIndex() != Group::NONE && (last == Group::NONE || group->lastIndex() > last)) {
+            last = group->lastIndex();
+            _offset = group->offset();
+        }
+    }
+    std::sort(events.begin(), events.end());
+}
+
+
+//----------------------------------------------------------------------------
+// Packet comparison.
+//----------------------------------------------------------------------------
+
+// Reset the fields which are ignored in the comparison.
+void ts::TSPacketMatcher::Normalize(TSPacket& pkt, const Options& opt)
+{
+    if (opt.pcr_ignore) {
+        if (pkt.hasPCR()) {
+            pkt.setPCR(0);
+        }
+        if (pkt.hasOPCR()) {
+            pkt.setOPCR(0);
+        }
+    }
+    if (opt.pid_ignore) {
+        pkt.setPID(PID_NULL);
+    }
+    if (opt.cc_ignore) {
+        pkt.setCC(0);
+    }
+}
+
+// Check if two packets are identical, after normalization.
+bool ts::TSPacketMatcher::Equal(const TSPacket& pkt1, const TSPacket& pkt2, const Options& opt)
+{
+    if (pkt1.getPID() == PID_NULL || pkt2.getPID() == PID_NULL) {
+        // Null packets are always considered as identical and non-null packets are always considered as different from null packets.
+        return pkt1.getPID() == PID_NULL && pkt2.getPID() == PID_NULL;
+    }
+    else if (opt.payload_only) {
+        return pkt1.getPayloadSize() == pkt2.getPayloadSize() && MemEqual(pkt1.getPayload(), pkt2.getPayload(), pkt1.getPayloadSize());
+    }
+    else if (!opt.pcr_ignore && !opt.pid_ignore && !opt.cc_ignore) {
+        return pkt1 == pkt2;
+    }
+    else {
+        TSPacket p1(pkt1);
+        TSPacket p2(pkt2);
+        Normalize(p1, opt);
+        Normalize(p2, opt);
+        return p1 == p2;
+    }
+}
+
+// Compute the fingerprint of a packet.
+uint64_t ts::TSPacketMatcher::Fingerprint(const TSPacket& pkt, const Options& opt)
+{
+    // Null packets are always considered as identical.
+    const PID pid = pkt.getPID();
+    if (pid == PID_NULL) {
+        return 0;
+    }
+
+    TSPacket norm;
+    const uint8_t* data = pkt.b;
+    size_t size = PKT_SIZE;
+    if (opt.payload_only) {
+        data = pkt.getPayload();
+        size = pkt.getPayloadSize();
+    }
+    else if (opt.pcr_ignore || opt.pid_ignore || opt.cc_ignore) {
+        norm = pkt;
+        Normalize(norm, opt);
+        data = norm.b;
+    }
+
+    // Packets are matched in the same PID only, unless PID's are ignored.
+    uint64_t hash = (opt.pid_ignore ? 0 : uint64_t(pid) << 32) ^ size ^ 0x9E3779B97F4A7C15;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        hash = (hash ^ GetUInt64LE(data + i)) * 0xFF51AFD7ED558CCD;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ data[i]) * 0x100000001B3;
+    }
+    hash ^= hash >> 29;
+    // Zero is reserved for null packets.
+    return hash == 0 ? 1 : hash;
+}
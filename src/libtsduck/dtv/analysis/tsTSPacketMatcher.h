@@ -0,0 +1,145 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Match the TS packets of two streams using packet fingerprints.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSPacket.h"
+#include "tsTaskPool.h"
+
+namespace ts {
+    //!
+    //! Match the TS packets of two streams using packet fingerprints.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! The two streams are typically two versions of the same stream, before and after some
+    //! transmission or processing. Each packet is identified by a hash of its content and PID.
+    //! A packet is matched with the oldest unmatched identical packet from the other stream.
+    //!
+    //! The matcher tracks the current offset between the two streams, as given by the last
+    //! packets which were matched in order. An unmatched packet is reported as missing in the
+    //! other stream when the other stream is beyond the search window around the expected
+    //! position of the packet. It is reported as duplicated when it is identical to the previous
+    //! packet in the same PID. A matched packet is reported as reordered when its partner
+    //! is before the last packet which was matched in order or when it jumps ahead of the
+    //! expected position and the next matched packet does not confirm the new offset.
+    //!
+    //! The memory is bounded by the search window in each stream. The total offset between
+    //! the streams is not limited but each individual sequence of missing or inserted packets
+    //! must be shorter than the search window.
+    //!
+    //! The streams are read by chunks. Use readCount() to get the number of packets to read
+    //! in each stream, to keep the two streams aligned on their current offset.
+    //!
+    class TSDUCKDLL TSPacketMatcher
+    {
+        TS_NOBUILD_NOCOPY(TSPacketMatcher);
+    public:
+        //!
+        //! Matching options.
+        //!
+        class TSDUCKDLL Options
+        {
+        public:
+            Options() = default;          //!< Default constructor.
+            size_t window = 10'000;       //!< Size of the search window in packets.
+            size_t threads = 1;           //!< Number of threads, packets are matched by groups of PID's.
+            bool   payload_only = false;  //!< Compare only the payload of the packets.
+            bool   pcr_ignore = false;    //!< Ignore PCR and OPCR.
+            bool   pid_ignore = false;    //!< Ignore PID values, match packets from distinct PID's, in one single thread.
+            bool   cc_ignore = false;     //!< Ignore continuity counters.
+        };
+
+        //!
+        //! An event which is found by the packet matcher.
+        //!
+        class TSDUCKDLL Event
+        {
+        public:
+            //!
+            //! Type of event.
+            //!
+            enum Type {
+                MISSING,    //!< The packet is missing in the other stream.
+                DUPLICATE,  //!< The packet is missing in the other stream and is a duplicate of the previous packet in the same PID.
+                REORDER,    //!< The packet is out of order in the other stream.
+            };
+            Type          type = MISSING;   //!< Type of event.
+            size_t        stream = 0;       //!< Index of the stream containing the packet, 0 or 1.
+            PacketCounter index = 0;        //!< Packet index in that stream.
+            PacketCounter other_index = 0;  //!< With REORDER, index of the matching packet in the other stream.
+            PacketCounter count = 0;        //!< Number of consecutive packets.
+
+            //!
+            //! Comparison operator, to sort events in stream order.
+            //! @param [in] other Other event to compare.
+            //! @return True if this event is before @a other.
+            //!
+            bool operator<(const Event& other) const { return index != other.index ? index < other.index : stream < other.stream; }
+        };
+
+        //!
+        //! Constructor.
+        //! @param [in] options Matching options. The content is copied.
+        //!
+        TSPacketMatcher(const Options& options);
+
+        //!
+        //! Destructor.
+        //!
+        ~TSPacketMatcher();
+
+        //!
+        //! Get the number of packets to read next in one stream.
+        //! The streams are read by chunks which are smaller than the search window.
+        //! The stream which is late relatively to the current offset between the streams
+        //! shall read more packets.
+        //! @param [in] stream Index of the stream, 0 or 1.
+        //! @return Number of packets to read in the stream.
+        //!
+        size_t readCount(size_t stream) const;
+
+        //!
+        //! Get the current offset between the two streams.
+        //! @return The offset from the index of a packet in stream 0 to the index of the same packet in stream 1.
+        //!
+        int64_t offset() const { return _offset; }
+
+        //!
+        //! Feed the matcher with the next chunks of packets from the two streams.
+        //! The packets are numbered from zero in each stream, in the order in which they are fed.
+        //! @param [in] packets The next packets in each stream. Can be empty.
+        //! @param [in] eof End of stream indicator of each stream.
+        //! @param [out] events The events which were found in the packets which are no longer
+        //! in the search window, sorted in stream order.
+        //!
+        void feedPackets(const TSPacketVector packets[2], const bool eof[2], std::vector<Event>& events);
+
+    private:
+        // Matching of one group of PID's.
+        class Group;
+
+        const Options _opt;
+        std::vector<std::unique_ptr<Group>> _groups {};
+        TaskPool      _pool;
+        PacketCounter _next[2] {0, 0};  // Index of next packet in each stream.
+        int64_t       _offset = 0;      // Current offset between the streams.
+
+        // Compute the fingerprint of a packet.
+        static uint64_t Fingerprint(const TSPacket& pkt, const Options& opt);
+
+        // Check if two packets are identical, after normalization.
+        static bool Equal(const TSPacket& pkt1, const TSPacket& pkt2, const Options& opt);
+
+        // Reset the fields which are ignored in the comparison.
+        static void Normalize(TSPacket& pkt, const Options& opt);
+    };
+}
@@ -190,21 +190,81 @@ size_t ts::CASSelectionArgs::addMatchingPIDs(PIDSet& pids, const DescriptorList&
     else {
         // No filtering by operator, loop on all CA descriptors.
         for (size_t index = dlist.search(DID_MPEG_CA); index < dlist.count(); index = dlist.search(DID_MPEG_CA, index + 1)) {
-            const uint8_t* desc = dlist[index].payload();
-            const size_t size = dlist[index].payloadSize();
-            if (size >= 4) {
-                // Get CA_system_id and ECM/EMM PID
-                const uint16_t sysid = GetUInt16(desc);
-                const PID pid = GetUInt16(desc + 2) & 0x1FFF;
-                // Add ECM/EMM PID if it matches the required CAS id
-                if (casMatch(sysid)) {
-                    pids.set(pid);
-                    pid_count++;
-                    report.verbose(u"Filtering %s PID %n", tid == TID_CAT ? u"EMM" : u"ECM", pid);
-                }
-            }
+            pid_count += addMatchingPID(pids, dlist[index].payload(), dlist[index].payloadSize(), tid, report);
         }
     }
 
     return pid_count;
 }
+
+
+//----------------------------------------------------------------------------
+// Same as above, reading the descriptors in place from binary tables.
+//----------------------------------------------------------------------------
+
+size_t ts::CASSelectionArgs::addMatchingPIDs(PIDSet& pids, const CATView& cat, Report& report) const
+{
+    size_t pid_count = 0;
+    for (size_t i = 0; i < cat.sectionCount(); ++i) {
+        const Section* section = cat.sectionAt(i);
+        if (section != nullptr) {
+            pid_count += addMatchingPIDs(pids, DescriptorListView(section->payload(), section->payloadSize()), TID_CAT, report);
+        }
+    }
+    return pid_count;
+}
+
+size_t ts::CASSelectionArgs::addMatchingPIDs(PIDSet& pids, const PMTView& pmt, Report& report) const
+{
+    size_t pid_count = addMatchingPIDs(pids, pmt.descriptors(), TID_PMT, report);
+    for (const auto& stream : pmt) {
+        pid_count += addMatchingPIDs(pids, stream.descriptors(), TID_PMT, report);
+    }
+    return pid_count;
+}
+
+size_t ts::CASSelectionArgs::addMatchingPIDs(PIDSet& pids, const DescriptorListView& dlist, TID tid, Report& report) const
+{
+    // Filter out useless cases.
+    if ((tid == TID_CAT && !pass_emm) || (tid == TID_PMT && !pass_ecm) || (tid != TID_CAT && tid != TID_PMT)) {
+        return 0;
+    }
+
+    if (cas_oper != 0) {
+        // Operator ids are located in CAS-specific descriptors, use the deserialized descriptors.
+        DescriptorList full(nullptr);
+        dlist.addTo(full);
+        return addMatchingPIDs(pids, full, tid, report);
+    }
+
+    // No filtering by operator, loop on all CA descriptors.
+    size_t pid_count = 0;
+    for (auto it = dlist.search(DID_MPEG_CA, dlist.begin()); it != dlist.end(); it = dlist.search(DID_MPEG_CA, ++it)) {
+        pid_count += addMatchingPID(pids, it->payload(), it->payloadSize(), tid, report);
+    }
+    return pid_count;
+}
+
+
+//----------------------------------------------------------------------------
+// Add the PID of one CA_descriptor payload if it matches the CAS id.
+//----------------------------------------------------------------------------
+
+size_t ts::CASSelectionArgs::addMatchingPID(PIDSet& pids, const uint8_t* desc, size_t size, TID tid, Report& report) const
+{
+    if (size < 4) {
+        return 0;
+    }
+
+    // Get CA_system_id and ECM/EMM PID
+    const uint16_t sysid = GetUInt16(desc);
+    const PID pid = GetUInt16(desc + 2) & 0x1FFF;
+
+    // Add ECM/EMM PID if it matches the required CAS id
+    if (!casMatch(sysid)) {
+        return 0;
+    }
+    pids.set(pid);
+    report.verbose(u"Filtering %s PID %n", tid == TID_CAT ? u"EMM" : u"ECM", pid);
+    return 1;
+}
@@ -16,6 +16,8 @@
 #include "tsNullReport.h"
 #include "tsCAT.h"
 #include "tsPMT.h"
+#include "tsCATView.h"
+#include "tsPMTView.h"
 
 namespace ts {
 
@@ -101,7 +103,42 @@ namespace ts {
         //!
         size_t addMatchingPIDs(PIDSet& pids, const PMT& pmt, Report& report = NULLREP) const;
 
+        //!
+        //! Analyze all CA_descriptors in a binary descriptor list and locate all matching PID's.
+        //! The descriptors are read in place, they are deserialized only when filtering by operator id.
+        //! @param [in,out] pids All patching PID's are added in this PID set.
+        //! @param [in] dlist A view over a list of descriptors.
+        //! @param [in] tid Table id of the table from which the descriptor comes.
+        //! @param [in,out] report Where to log debug messages.
+        //! @return The number of matching PID's. Note that some of them may have been
+        //! already in @a pids, so this may not be the number of @e added PID's.
+        //!
+        size_t addMatchingPIDs(PIDSet& pids, const DescriptorListView& dlist, TID tid, Report& report = NULLREP) const;
+
+        //!
+        //! Analyze all CA_descriptors in a binary CAT and locate all matching EMM PID's.
+        //! @param [in,out] pids All patching PID's are added in this PID set.
+        //! @param [in] cat A view over a CAT.
+        //! @param [in,out] report Where to log debug messages.
+        //! @return The number of matching PID's. Note that some of them may have been
+        //! already in @a pids, so this may not be the number of @e added PID's.
+        //!
+        size_t addMatchingPIDs(PIDSet& pids, const CATView& cat, Report& report = NULLREP) const;
+
+        //!
+        //! Analyze all CA_descriptors in a binary PMT and locate all matching ECM PID's.
+        //! @param [in,out] pids All patching PID's are added in this PID set.
+        //! @param [in] pmt A view over a PMT.
+        //! @param [in,out] report Where to log debug messages.
+        //! @return The number of matching PID's. Note that some of them may have been
+        //! already in @a pids, so this may not be the number of @e added PID's.
+        //!
+        size_t addMatchingPIDs(PIDSet& pids, const PMTView& pmt, Report& report = NULLREP) const;
+
     private:
         std::map<UString, std::pair<CASID,CASID>> _cas_options {}; // CAS option names to min/max CAS ids.
+
+        // Add the PID of one CA_descriptor payload if it matches the CAS id.
+        size_t addMatchingPID(PIDSet& pids, const uint8_t* desc, size_t size, TID tid, Report& report) const;
     };
 }
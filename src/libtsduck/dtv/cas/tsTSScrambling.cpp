@@ -432,6 +432,28 @@ bool ts::TSScrambling::setEncryptParity(int parity)
 }
 
 
+//----------------------------------------------------------------------------
+// Encrypt or decrypt the payload of one packet.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::cipherPacket(BlockCipher* algo, TSPacket& pkt, bool encrypt)
+{
+    assert(algo != nullptr);
+
+    // Check if the residue shall be included in the scrambling.
+    size_t psize = pkt.getPayloadSize();
+    if (!algo->residueAllowed()) {
+        // Remove the residue from the payload.
+        assert(algo->blockSize() != 0);
+        psize -= psize % algo->blockSize();
+    }
+
+    // Encrypting or decrypting "in place" is handled by the API.
+    return psize == 0 ||
+        (encrypt ? algo->encrypt(pkt.getPayload(), psize, pkt.getPayload(), psize) : algo->decrypt(pkt.getPayload(), psize, pkt.getPayload(), psize));
+}
+
+
 //----------------------------------------------------------------------------
 // Encrypt a TS packet with the current parity and corresponding CW.
 //----------------------------------------------------------------------------
@@ -457,18 +479,9 @@ bool ts::TSScrambling::encrypt(TSPacket& pkt)
     // Select scrambling algo.
     assert(_encrypt_scv == SC_EVEN_KEY || _encrypt_scv == SC_ODD_KEY);
     BlockCipher* algo = _scrambler[_encrypt_scv & 1];
-    assert(algo != nullptr);
 
-    // Check if the residue shall be included in the scrambling.
-    size_t psize = pkt.getPayloadSize();
-    if (!algo->residueAllowed()) {
-        // Remove the residue from the payload.
-        assert(algo->blockSize() != 0);
-        psize -= psize % algo->blockSize();
-    }
-
-    // Encrypt the packet. Encrypting "in place" is handled by the API.
-    const bool ok = psize == 0 || algo->encrypt(pkt.getPayload(), psize, pkt.getPayload(), psize);
+    // Encrypt the packet.
+    const bool ok = cipherPacket(algo, pkt, true);
     if (ok) {
         pkt.setScrambling(_encrypt_scv);
     }
@@ -502,18 +515,9 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
 
     // Select descrambling algo.
     BlockCipher* algo = _scrambler[_decrypt_scv & 1];
-    assert(algo != nullptr);
-
-    // Check if the residue shall be included in the scrambling.
-    size_t psize = pkt.getPayloadSize();
-    if (!algo->residueAllowed()) {
-        // Remove the residue from the payload.
-        assert(algo->blockSize() != 0);
-        psize -= psize % algo->blockSize();
-    }
 
-    // Decrypt the packet. Decrypting "in place" is handled by the API.
-    const bool ok = psize == 0 || algo->decrypt(pkt.getPayload(), psize, pkt.getPayload(), psize);
+    // Decrypt the packet.
+    const bool ok = cipherPacket(algo, pkt, false);
     if (ok) {
         pkt.setScrambling(SC_CLEAR);
     }
@@ -522,3 +526,269 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt a batch of TS packets with the current parity and corresponding CW.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::encrypt(TSPacket* const* pkts, size_t count)
+{
+    // Filter out encrypted packets and silently pass packets without payload.
+    _batch.clear();
+    for (size_t i = 0; i < count; ++i) {
+        TSPacket* pkt = pkts[i];
+        if (pkt != nullptr && pkt->isScrambled()) {
+            _report.error(u"try to scramble an already scrambled packet");
+            return false;
+        }
+        if (pkt != nullptr && pkt->hasPayload()) {
+            _batch.push_back(pkt);
+        }
+    }
+    if (_batch.empty()) {
+        return true;
+    }
+
+    // If no current parity is set, start with even by default.
+    if (_encrypt_scv == SC_CLEAR && !setEncryptParity(SC_EVEN_KEY)) {
+        return false;
+    }
+    assert(_encrypt_scv == SC_EVEN_KEY || _encrypt_scv == SC_ODD_KEY);
+
+    // Encrypt all packets with the same key.
+    if (!cipherBatch(_encrypt_scv & 1, true)) {
+        return false;
+    }
+    for (auto pkt : _batch) {
+        pkt->setScrambling(_encrypt_scv);
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt a batch of TS packets with the CW corresponding to their parity.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::decrypt(TSPacket* const* pkts, size_t count)
+{
+    _batch.clear();
+    for (size_t i = 0; i <= count; ++i) {
+
+        // Clear or invalid packets are silently accepted.
+        const uint8_t scv = i < count && pkts[i] != nullptr ? pkts[i]->getScrambling() : uint8_t(SC_CLEAR);
+        if (i < count && scv != SC_EVEN_KEY && scv != SC_ODD_KEY) {
+            continue;
+        }
+
+        // Decrypt all accumulated packets on parity change and at end of batch.
+        if ((i == count || scv != _decrypt_scv) && !_batch.empty()) {
+            if (!cipherBatch(_decrypt_scv & 1, false)) {
+                return false;
+            }
+            for (auto pkt : _batch) {
+                pkt->setScrambling(SC_CLEAR);
+            }
+            _batch.clear();
+        }
+        if (i == count) {
+            break;
+        }
+
+        // Update current parity. In case of fixed control word, use next key when the scrambling control changes.
+        const uint8_t previous_scv = _decrypt_scv;
+        _decrypt_scv = scv;
+        if (hasFixedCW() && previous_scv != _decrypt_scv && !setNextFixedCW(_decrypt_scv)) {
+            return false;
+        }
+        _batch.push_back(pkts[i]);
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Check if the current scrambling algorithm benefits from batches.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::hasBatchEngine() const
+{
+    return _scrambler[0] == &_dvbcissa[0] || _scrambler[0] == &_idsa[0] || _scrambler[0] == &_aescbc[0];
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt the payloads of all packets in the batch.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::cipherBatch(int parity, bool encrypt)
+{
+    BlockCipher* algo = _scrambler[parity & 1];
+    ECB<AES128>& ecb(_aesecb[parity & 1]);
+    assert(algo != nullptr);
+
+    // The packets are individually processed until the first one which is actually encrypted or decrypted
+    // with the current key. This triggers the "first encryption/decryption" alerts, as in single packet mode.
+    size_t first = 0;
+    while (first < _batch.size() && (encrypt ? algo->encryptionCount() : algo->decryptionCount()) == 0) {
+        if (!cipherPacket(algo, *_batch[first++], encrypt)) {
+            _report.error(u"packet %s error using %s", encrypt ? u"encryption" : u"decryption", algo->name());
+            return false;
+        }
+    }
+    if (first >= _batch.size()) {
+        return true;
+    }
+
+    // Use the same key in the multi-buffer AES engine when the CBC chains can be interleaved.
+    bool ok = true;
+    const bool interleave = _batch.size() - first > 1 && hasBatchEngine() && algo->currentIV().size() == AES128::BLOCK_SIZE;
+    if (interleave && (!ecb.hasKey() || ecb.currentKey() != algo->currentKey())) {
+        ok = ecb.setKey(algo->currentKey());
+    }
+    if (ok && interleave) {
+        ok = encrypt ?
+            interleaveEncrypt(algo, ecb, _batch.data() + first, _batch.size() - first) :
+            interleaveDecrypt(algo, ecb, _batch.data() + first, _batch.size() - first);
+    }
+    else {
+        for (size_t i = first; ok && i < _batch.size(); ++i) {
+            ok = cipherPacket(algo, *_batch[i], encrypt);
+        }
+    }
+    if (!ok) {
+        _report.error(u"packet %s error using %s", encrypt ? u"encryption" : u"decryption", algo->name());
+    }
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Interleaved encryption of packets in AES CBC or DVS 042 modes.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::interleaveEncrypt(BlockCipher* algo, ECB<AES128>& ecb, TSPacket* const* pkts, size_t count)
+{
+    constexpr size_t bsize = AES128::BLOCK_SIZE;
+    const uint8_t* iv = algo->currentIV().data();
+    const bool residue = algo->residueAllowed();
+
+    // Number of full blocks in each payload.
+    size_t max_blocks = 0;
+    _batch_blocks.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        _batch_blocks[i] = pkts[i]->getPayloadSize() / bsize;
+        max_blocks = std::max(max_blocks, _batch_blocks[i]);
+    }
+    _batch_work.resize(count * bsize);
+    uint8_t* const work = _batch_work.data();
+
+    // Process the blocks of the same rank in all packets: Cj = encrypt (Cj-1 XOR Pj).
+    for (size_t blk = 0; blk < max_blocks; ++blk) {
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (blk < _batch_blocks[i]) {
+                const uint8_t* pt = pkts[i]->getPayload() + blk * bsize;
+                MemXor(work + n++ * bsize, blk == 0 ? iv : pt - bsize, pt, bsize);
+            }
+        }
+        if (!ecb.encrypt(work, n * bsize, work, n * bsize)) {
+            return false;
+        }
+        n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (blk < _batch_blocks[i]) {
+                MemCopy(pkts[i]->getPayload() + blk * bsize, work + n++ * bsize, bsize);
+            }
+        }
+    }
+
+    // DVS 042 residues: Cn = encrypt (Cn-1) XOR Pn, truncated. Cn-1 is the IV for short payloads.
+    if (residue) {
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (pkts[i]->getPayloadSize() % bsize != 0) {
+                MemCopy(work + n++ * bsize, _batch_blocks[i] == 0 ? iv : pkts[i]->getPayload() + (_batch_blocks[i] - 1) * bsize, bsize);
+            }
+        }
+        if (n > 0 && !ecb.encrypt(work, n * bsize, work, n * bsize)) {
+            return false;
+        }
+        n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t rsize = pkts[i]->getPayloadSize() % bsize;
+            if (rsize != 0) {
+                uint8_t* rt = pkts[i]->getPayload() + _batch_blocks[i] * bsize;
+                MemXor(rt, rt, work + n++ * bsize, rsize);
+            }
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Interleaved decryption of packets in AES CBC or DVS 042 modes.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::interleaveDecrypt(BlockCipher* algo, ECB<AES128>& ecb, TSPacket* const* pkts, size_t count)
+{
+    constexpr size_t bsize = AES128::BLOCK_SIZE;
+    const uint8_t* iv = algo->currentIV().data();
+    const bool residue = algo->residueAllowed();
+
+    // Number of full blocks in each payload and in total, number of residues.
+    size_t total_blocks = 0;
+    size_t residues = 0;
+    _batch_blocks.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        const size_t psize = pkts[i]->getPayloadSize();
+        _batch_blocks[i] = psize / bsize;
+        total_blocks += _batch_blocks[i];
+        residues += residue && psize % bsize != 0;
+    }
+    _batch_work.resize((total_blocks + residues) * bsize);
+    uint8_t* const work = _batch_work.data();
+    uint8_t* const rwork = work + total_blocks * bsize;
+
+    // Gather all cipher blocks, they are independent: Pj = decrypt (Cj) XOR Cj-1.
+    uint8_t* wt = work;
+    for (size_t i = 0; i < count; ++i) {
+        MemCopy(wt, pkts[i]->getPayload(), _batch_blocks[i] * bsize);
+        wt += _batch_blocks[i] * bsize;
+    }
+    if (total_blocks > 0 && !ecb.decrypt(work, total_blocks * bsize, work, total_blocks * bsize)) {
+        return false;
+    }
+
+    // DVS 042 residues: Pn = encrypt (Cn-1) XOR Cn, truncated. Cn-1 is the IV for short payloads.
+    if (residues > 0) {
+        size_t n = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (pkts[i]->getPayloadSize() % bsize != 0) {
+                MemCopy(rwork + n++ * bsize, _batch_blocks[i] == 0 ? iv : pkts[i]->getPayload() + (_batch_blocks[i] - 1) * bsize, bsize);
+            }
+        }
+        if (!ecb.encrypt(rwork, residues * bsize, rwork, residues * bsize)) {
+            return false;
+        }
+    }
+
+    // Scatter the plain text. Process the blocks of each packet backward, the previous cipher block is still in the payload.
+    wt = work;
+    size_t n = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t* const data = pkts[i]->getPayload();
+        const size_t rsize = residue ? pkts[i]->getPayloadSize() % bsize : 0;
+        if (rsize != 0) {
+            uint8_t* rt = data + _batch_blocks[i] * bsize;
+            MemXor(rt, rt, rwork + n++ * bsize, rsize);
+        }
+        for (size_t blk = _batch_blocks[i]; blk-- > 0; ) {
+            MemXor(data + blk * bsize, wt + blk * bsize, blk == 0 ? iv : data + (blk - 1) * bsize, bsize);
+        }
+        wt += _batch_blocks[i] * bsize;
+    }
+    return true;
+}
@@ -184,6 +184,41 @@ namespace ts {
         //!
         bool decrypt(TSPacket& pkt);
 
+        //!
+        //! Encrypt a batch of TS packets with the current parity and corresponding CW.
+        //!
+        //! The result is identical to calling encrypt() on each packet in sequence. With the
+        //! AES-based scrambling modes in CBC chaining (DVB-CISSA, ATIS-IDSA, AES-CBC), the CBC
+        //! chains of all packets are interleaved: the blocks of the same rank in all packets are
+        //! processed in one single call to the AES engine, followed by the DVS 042 residues.
+        //! This keeps the AES pipeline of the CPU busy, instead of waiting for the result of each
+        //! block before processing the next block of the same packet.
+        //!
+        //! @param [in,out] pkts Array of addresses of the packets to encrypt. Null pointers are ignored.
+        //! @param [in] count Number of packet addresses in @a pkts.
+        //! @return True on success, false on error. An already encrypted packet is an error.
+        //! In that case, no packet is encrypted.
+        //!
+        bool encrypt(TSPacket* const* pkts, size_t count);
+
+        //!
+        //! Decrypt a batch of TS packets with the CWs corresponding to the parity in each packet.
+        //!
+        //! The result is identical to calling decrypt() on each packet in sequence. Consecutive
+        //! packets with the same parity are decrypted together, see encrypt(TSPacket* const*, size_t).
+        //!
+        //! @param [in,out] pkts Array of addresses of the packets to decrypt. Null pointers are ignored.
+        //! @param [in] count Number of packet addresses in @a pkts.
+        //! @return True on success, false on error. A clear packet is not an error.
+        //!
+        bool decrypt(TSPacket* const* pkts, size_t count);
+
+        //!
+        //! Check if the current scrambling algorithm benefits from batch encryption or decryption.
+        //! @return True if the CBC chains of packets are interleaved by the batch methods.
+        //!
+        bool hasBatchEngine() const;
+
     private:
         // List of control words
         using CWList = std::list<ByteBlock>;
@@ -203,10 +238,24 @@ namespace ts {
         CBC<AES128>      _aescbc[2] {};
         CTR<AES128>      _aesctr[2] {};
         BlockCipher*     _scrambler[2] {nullptr, nullptr};
+        ECB<AES128>      _aesecb[2] {};            // Multi-buffer engine for AES in CBC chaining, same key as _scrambler.
+        std::vector<TSPacket*> _batch {};          // Packets with payload in the current batch.
+        std::vector<size_t>    _batch_blocks {};   // Number of full blocks in each packet of the batch.
+        ByteBlock        _batch_work {};           // Work buffer for interleaved blocks.
 
         // Set the next fixed control word as scrambling key.
         bool setNextFixedCW(int parity);
 
+        // Encrypt or decrypt the payload of one packet, without changing the scrambling control.
+        bool cipherPacket(BlockCipher* algo, TSPacket& pkt, bool encrypt);
+
+        // Encrypt or decrypt the payloads of all packets in _batch with the key of the given parity.
+        bool cipherBatch(int parity, bool encrypt);
+
+        // Encrypt or decrypt packet payloads in AES CBC or DVS 042 modes, interleaving the CBC chains.
+        bool interleaveEncrypt(BlockCipher* algo, ECB<AES128>& ecb, TSPacket* const* pkts, size_t count);
+        bool interleaveDecrypt(BlockCipher* algo, ECB<AES128>& ecb, TSPacket* const* pkts, size_t count);
+
         // Implementation of BlockCipherAlertInterface.
         virtual bool handleBlockCipherAlert(BlockCipher& cipher, AlertReason reason) override;
 
@@ -8,6 +8,13 @@
 
 #include "tsAbstractDemux.h"
 
+// Reassembly counters of all demux instances in the current thread.
+namespace {
+    thread_local ts::AbstractDemux::Counters _thread_counters;
+}
+
+bool ts::AbstractDemux::_counters_enabled = false;
+
 
 //----------------------------------------------------------------------------
 // Constructor / destructor.
@@ -120,6 +127,35 @@ void ts::AbstractDemux::feedPacket(const TSPacket& pkt)
     // At this stage, we only count packets.
     // More interesting stuff in subclasses.
     _packet_count++;
+    if (_counters_enabled) {
+        _thread_counters.packets++;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Reassembly counters of the current thread.
+//----------------------------------------------------------------------------
+
+ts::AbstractDemux::Counters ts::AbstractDemux::Counters::operator-(const Counters& other) const
+{
+    Counters diff;
+    diff.packets = packets - other.packets;
+    diff.sections = sections - other.sections;
+    diff.tables = tables - other.tables;
+    diff.pes_packets = pes_packets - other.pes_packets;
+    diff.invalid = invalid - other.invalid;
+    return diff;
+}
+
+ts::AbstractDemux::Counters ts::AbstractDemux::CurrentThreadCounters()
+{
+    return _thread_counters;
+}
+
+ts::AbstractDemux::Counters& ts::AbstractDemux::ThreadCounters()
+{
+    return _thread_counters;
 }
 
 
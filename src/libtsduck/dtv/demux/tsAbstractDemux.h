@@ -117,6 +117,54 @@ namespace ts {
         //!
         int demuxId() const { return _demux_id; }
 
+        //!
+        //! Get the number of TS packets which were passed to the demux.
+        //! This is also the index of the next TS packet in the demultiplexed stream.
+        //! @return The number of TS packets which were passed to the demux.
+        //!
+        PacketCounter packetCount() const { return _packet_count; }
+
+        //!
+        //! Reassembly counters of all demux instances in one thread, for profiling.
+        //!
+        class TSDUCKDLL Counters
+        {
+        public:
+            uint64_t packets = 0;      //!< Number of TS packets which were passed to all demux.
+            uint64_t sections = 0;     //!< Number of complete sections (SectionDemux).
+            uint64_t tables = 0;       //!< Number of complete tables which were notified (SectionDemux).
+            uint64_t pes_packets = 0;  //!< Number of complete valid PES packets (PESDemux).
+            uint64_t invalid = 0;      //!< Number of invalid sections and PES packets.
+
+            //!
+            //! Difference between two sets of counters, typically after and before some processing.
+            //! @param [in] other Counters to subtract from this object.
+            //! @return The difference between the counters.
+            //!
+            Counters operator-(const Counters& other) const;
+        };
+
+        //!
+        //! Get the reassembly counters of all demux instances in the current thread.
+        //! @return The reassembly counters of the current thread.
+        //! @see EnableCounters()
+        //!
+        static Counters CurrentThreadCounters();
+
+        //!
+        //! Check if the reassembly counters are enabled.
+        //! @return True if the reassembly counters are enabled.
+        //!
+        static bool CountersEnabled() { return _counters_enabled; }
+
+        //!
+        //! Enable or disable the reassembly counters in all threads.
+        //! The counters are disabled by default and are typically enabled by profiling tools.
+        //! They should be enabled before starting any demux.
+        //! @param [in] on True to enable the counters, false to disable them.
+        //!
+        static void EnableCounters(bool on = true) { _counters_enabled = on; }
+
         //!
         //! Destructor.
         //!
@@ -177,12 +225,21 @@ namespace ts {
         //!
         virtual void immediateResetPID(PID pid);
 
+        //!
+        //! Get a modifiable reference to the reassembly counters of the current thread.
+        //! Use it only when CountersEnabled() is true.
+        //! @return A reference to the reassembly counters of the current thread.
+        //!
+        static Counters& ThreadCounters();
+
         // Protected directly accessible to subclasses.
         DuckContext&  _duck;             //!< The TSDuck execution context is accessible to all subclasses.
         PIDSet        _pid_filter {};    //!< Current set of filtered PID's.
         PacketCounter _packet_count = 0; //!< Number of TS packets in the demultiplexed stream.
 
     private:
+        static bool _counters_enabled;   // Reassembly counters are enabled in all threads.
+
         bool _in_handler = false;        // True when in the context of an application-defined handler
         PID  _pid_in_handler = PID_NULL; // PID which is currently processed by the handler
         bool _reset_pending = false;     // Delayed reset()
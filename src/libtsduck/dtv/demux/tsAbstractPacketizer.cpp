@@ -34,6 +34,22 @@ void ts::AbstractPacketizer::reset()
 }
 
 
+//----------------------------------------------------------------------------
+// Build the next MPEG packets. Default implementation, one by one.
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractPacketizer::getNextPackets(TSPacket* packets, size_t count)
+{
+    size_t real = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (getNextPacket(packets[i])) {
+            real++;
+        }
+    }
+    return real;
+}
+
+
 //----------------------------------------------------------------------------
 // Configure a TS packet with continuity and PID.
 //----------------------------------------------------------------------------
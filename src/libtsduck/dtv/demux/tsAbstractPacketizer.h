@@ -64,6 +64,16 @@ namespace ts {
         //!
         virtual bool getNextPacket(TSPacket& packet) = 0;
 
+        //!
+        //! Build the next MPEG packets for the list of items (sections or PES) to packetize.
+        //! This is equivalent to calling getNextPacket() @a count times. The default implementation
+        //! does exactly this. Subclasses may provide a faster implementation for bulk emission.
+        //! @param [out] packets Address of an array of @a count TS packets.
+        //! @param [in] count Number of packets to build.
+        //! @return The number of real packets, not counting null packets.
+        //!
+        virtual size_t getNextPackets(TSPacket* packets, size_t count);
+
         //!
         //! Get the number of generated TS packets so far.
         //! @return The number of generated TS packets so far.
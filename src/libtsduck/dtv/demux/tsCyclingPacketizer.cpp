@@ -149,6 +149,7 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, cn::milliseconds
 
         _section_count++;
         _remain_in_cycle++;
+        invalidateCycle();
     }
 }
 
@@ -198,6 +199,7 @@ void ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint1
                 _sched_packets -= sect.packetCount();
             }
             it = list.erase(it);
+            invalidateCycle();
         }
         else {
             ++it;
@@ -217,6 +219,7 @@ void ts::CyclingPacketizer::removeAll()
     _sched_packets = 0;
     _sched_sections.clear();
     _other_sections.clear();
+    invalidateCycle();
 }
 
 
@@ -229,6 +232,8 @@ void ts::CyclingPacketizer::removeAll()
 void ts::CyclingPacketizer::reset()
 {
     removeAll();
+    _ring_next = 0;
+    dropCycle();
     Packetizer::reset();
 }
 
@@ -289,6 +294,196 @@ void ts::CyclingPacketizer::setBitRate(const BitRate& new_bitrate)
 
     // Remember new bitrate
     _bitrate = new_bitrate;
+    invalidateCycle();
+}
+
+
+//----------------------------------------------------------------------------
+// Set the TS packet stuffing policy at end of packet.
+//----------------------------------------------------------------------------
+
+void ts::CyclingPacketizer::setStuffingPolicy(StuffingPolicy sp)
+{
+    if (sp != _stuffing) {
+        _stuffing = sp;
+        invalidateCycle();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Enable or disable the precompiled mode.
+//----------------------------------------------------------------------------
+
+void ts::CyclingPacketizer::setPrecompiled(bool on)
+{
+    if (on != _precompiled) {
+        _precompiled = on;
+        invalidateCycle();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Invalidate or clear the precompiled cycle.
+//----------------------------------------------------------------------------
+
+void ts::CyclingPacketizer::invalidateCycle()
+{
+    // Stop recording. If a precompiled cycle is being replayed, complete it first.
+    _recording = false;
+    if (_ring_next == 0) {
+        dropCycle();
+    }
+    else {
+        _ring_stale = true;
+    }
+}
+
+void ts::CyclingPacketizer::dropCycle()
+{
+    _ring_stale = false;
+    _ring.clear();
+    _ring_sections.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Check if the current cycle is static and can be precompiled.
+//----------------------------------------------------------------------------
+
+bool ts::CyclingPacketizer::staticCycle() const
+{
+    return _precompiled &&
+           _section_count > 0 &&
+           _sched_sections.empty() &&
+           _stuffing != StuffingPolicy::NEVER;
+}
+
+
+//----------------------------------------------------------------------------
+// Build the next MPEG packets.
+//----------------------------------------------------------------------------
+
+bool ts::CyclingPacketizer::getNextPacket(TSPacket& pkt)
+{
+    return replayReady() ? replayPackets(&pkt, 1) > 0 : generatePacket(pkt);
+}
+
+size_t ts::CyclingPacketizer::getNextPackets(TSPacket* packets, size_t count)
+{
+    size_t real = 0;
+    while (count > 0) {
+        if (replayReady()) {
+            // Emit a contiguous block of precompiled packets, all of them are real packets.
+            const size_t n = replayPackets(packets, count);
+            real += n;
+            packets += n;
+            count -= n;
+        }
+        else {
+            if (generatePacket(*packets)) {
+                real++;
+            }
+            packets++;
+            count--;
+        }
+    }
+    return real;
+}
+
+
+//----------------------------------------------------------------------------
+// Check if the next packet can be replayed from a precompiled cycle.
+//----------------------------------------------------------------------------
+
+bool ts::CyclingPacketizer::replayReady()
+{
+    if (_recording || _ring.empty()) {
+        return false;
+    }
+    else if (_ring_next > 0) {
+        // Always complete a cycle which is being replayed.
+        return true;
+    }
+    else if (_ring_stale || !staticCycle() || _ring_split != headerSplitAllowed()) {
+        // At cycle boundary and the precompiled cycle is obsolete.
+        dropCycle();
+        return false;
+    }
+    else {
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Replay packets from the precompiled cycle, up to the end of the cycle.
+//----------------------------------------------------------------------------
+
+size_t ts::CyclingPacketizer::replayPackets(TSPacket* packets, size_t count)
+{
+    assert(_ring_next < _ring.size());
+    assert(_ring.size() == _ring_sections.size());
+
+    // A new cycle starts, the end of the previous one is no longer the last packet.
+    if (_ring_next == 0) {
+        _cycle_end = UNDEFINED;
+    }
+
+    // Copy a contiguous block from the ring, then patch PID and continuity counter.
+    count = std::min(count, _ring.size() - _ring_next);
+    TSPacket::Copy(packets, &_ring[_ring_next], count);
+    SectionCounter sections = 0;
+    for (size_t i = 0; i < count; ++i) {
+        configurePacket(packets[i], false);
+        sections += _ring_sections[_ring_next + i] & ~RING_BOUNDARY;
+    }
+    countSections(sections);
+    _ring_next += count;
+
+    // At end of cycle, update the cycle state as provideSection() would have done.
+    if (_ring_next >= _ring.size()) {
+        _ring_next = 0;
+        _cycle_end = sectionCount() - 1;
+        _current_cycle++;
+        _remain_in_cycle = _section_count;
+        if (_ring_stale) {
+            dropCycle();
+        }
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Generate one packet from the sections, possibly recording it.
+//----------------------------------------------------------------------------
+
+bool ts::CyclingPacketizer::generatePacket(TSPacket& pkt)
+{
+    // Start recording a precompiled cycle when a static cycle starts on a packet boundary.
+    if (!_recording && _ring.empty() && staticCycle() && noPendingSection() && _remain_in_cycle == _section_count) {
+        _recording = true;
+        _ring_split = headerSplitAllowed();
+        _ring.reserve(_section_count);
+        _ring_sections.reserve(_section_count);
+    }
+
+    const SectionCounter previous_count = sectionCount();
+    const bool real = Packetizer::getNextPacket(pkt);
+
+    if (_recording) {
+        _ring.push_back(pkt);
+        _ring_sections.push_back(uint8_t(sectionCount() - previous_count) | (Packetizer::atSectionBoundary() ? RING_BOUNDARY : 0));
+        if (atCycleBoundary()) {
+            // The precompiled cycle is complete, replay it from now on.
+            _recording = false;
+            _ring_next = 0;
+            report().debug(u"precompiled cycle on PID %n: %d sections, %d packets", getPID(), _section_count, _ring.size());
+        }
+    }
+    return real;
 }
 
 
@@ -377,9 +572,17 @@ bool ts::CyclingPacketizer::doStuffing()
 
 
 //----------------------------------------------------------------------------
-// Return true when the last generated packet was the last packet in the cycle.
+// Return true when the last generated packet was the last packet of a section
+// or the last packet in the cycle.
 //----------------------------------------------------------------------------
 
+bool ts::CyclingPacketizer::atSectionBoundary() const
+{
+    // While replaying a precompiled cycle, the state of the superclass remains at the end of the
+    // recorded cycle. The section boundaries were recorded with the packets.
+    return _ring_next > 0 ? (_ring_sections[_ring_next - 1] & RING_BOUNDARY) != 0 : Packetizer::atSectionBoundary();
+}
+
 bool ts::CyclingPacketizer::atCycleBoundary() const
 {
     // Coverity false positive:  _cycle_end + 1 overflows only if _cycle_end == UNDEFINED, which is excluded just before.
@@ -416,7 +619,9 @@ std::ostream& ts::CyclingPacketizer::display(std::ostream& strm) const
         << "  Section cycle end: " << (_cycle_end == UNDEFINED ? u"undefined" : UString::Decimal(_cycle_end)) << std::endl
         << "  Stored sections: " << _section_count << std::endl
         << "  Scheduled sections: " << _sched_sections.size() << std::endl
-        << "  Scheduled packets max: " << _sched_packets << std::endl;
+        << "  Scheduled packets max: " << _sched_packets << std::endl
+        << "  Precompiled mode: " << UString::OnOff(_precompiled) << std::endl
+        << "  Precompiled packets: " << precompiledPacketCount() << std::endl;
     for (auto& it : _sched_sections) {
         it->display(duck(), strm);
     }
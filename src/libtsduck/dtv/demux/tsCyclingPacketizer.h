@@ -16,6 +16,7 @@
 #include "tsSectionProviderInterface.h"
 #include "tsBinaryTable.h"
 #include "tsAbstractTable.h"
+#include "tsTSPacket.h"
 
 namespace ts {
     //!
@@ -53,6 +54,9 @@ namespace ts {
     //! A bitrate is specified in bits/second. Zero means undefined.
     //! A repetition rate is specified in milliseconds. Zero means undefined.
     //!
+    //! When the cycle is static, the packetizer can optionally work in "precompiled" mode.
+    //! See setPrecompiled() for details.
+    //!
     class TSDUCKDLL CyclingPacketizer: public Packetizer, private SectionProviderInterface
     {
         TS_NOBUILD_NOCOPY(CyclingPacketizer);
@@ -85,7 +89,7 @@ namespace ts {
         //! Set the TS packet stuffing policy at end of packet.
         //! @param [in] sp TS packet stuffing policy at end of packet.
         //!
-        void setStuffingPolicy(StuffingPolicy sp) { _stuffing = sp; }
+        void setStuffingPolicy(StuffingPolicy sp);
 
         //!
         //! Get the TS packet stuffing policy at end of packet.
@@ -187,7 +191,42 @@ namespace ts {
         //!
         bool atCycleBoundary() const;
 
+        //!
+        //! Enable or disable the precompiled mode.
+        //!
+        //! In precompiled mode, when the cycle is static, one complete cycle is packetized once into
+        //! a ring of TS packets. The subsequent cycles are emitted from that ring, only patching the PID
+        //! and continuity counter. The generated packets are identical to the non-precompiled mode.
+        //!
+        //! The cycle is static when no section uses a repetition rate (or the bitrate is zero)
+        //! and the stuffing policy is not NEVER (the cycle must end on a packet boundary).
+        //! When the cycle is not static, the precompiled mode has no effect.
+        //!
+        //! When sections are added or removed while a precompiled cycle is being emitted, the
+        //! modification takes effect at the end of that cycle. The sections must not be modified
+        //! in place while the packetizer is in precompiled mode.
+        //!
+        //! @param [in] on True to enable the precompiled mode, false to disable it.
+        //!
+        void setPrecompiled(bool on);
+
+        //!
+        //! Check if the precompiled mode is enabled.
+        //! @return True if the precompiled mode is enabled.
+        //! @see setPrecompiled()
+        //!
+        bool precompiled() const { return _precompiled; }
+
+        //!
+        //! Get the number of TS packets in the precompiled cycle.
+        //! @return The number of TS packets in the precompiled cycle, zero if no cycle is precompiled yet.
+        //!
+        size_t precompiledPacketCount() const { return _recording ? 0 : _ring.size(); }
+
         // Inherited from Packetizer.
+        virtual bool getNextPacket(TSPacket& packet) override;
+        virtual size_t getNextPackets(TSPacket* packets, size_t count) override;
+        virtual bool atSectionBoundary() const override;
         virtual void reset() override;
         virtual std::ostream& display(std::ostream& strm) const override;
 
@@ -227,12 +266,41 @@ namespace ts {
         SectionCounter  _current_cycle {1};      // Cycle number (start at 1, always increasing)
         size_t          _remain_in_cycle = 0;    // Number of unsent sections in this cycle
         SectionCounter  _cycle_end = UNDEFINED;  // At end of cycle, contains the index of last section
+        bool            _precompiled = false;    // Precompiled mode is enabled.
+        bool            _recording = false;      // Currently packetizing a cycle into _ring.
+        bool            _ring_stale = false;     // Sections changed, drop _ring at end of current replayed cycle.
+        bool            _ring_split = false;     // Header split mode when _ring was recorded.
+        size_t          _ring_next = 0;          // Index of next packet to replay in _ring, zero at cycle boundary.
+        TSPacketVector  _ring {};                // Precompiled packets of one cycle.
+        ByteBlock       _ring_sections {};       // Number of sections which end in each packet of _ring, plus RING_BOUNDARY.
 
         static constexpr SectionCounter UNDEFINED = std::numeric_limits<SectionCounter>::max();
 
+        // Flag in _ring_sections: the packet stream is at a section boundary after this packet.
+        // A packet cannot contain more than 61 complete sections, the MSB is never used by the count.
+        static constexpr uint8_t RING_BOUNDARY = 0x80;
+
         // Insert a scheduled section in the list, sorted by due_packet.
         void addScheduledSection(const SectionDescPtr&);
 
+        // Check if the current cycle is static and can be precompiled.
+        bool staticCycle() const;
+
+        // Check if the next packet can be replayed from a precompiled cycle. Drop an obsolete cycle.
+        bool replayReady();
+
+        // Replay packets from the precompiled cycle, up to the end of the cycle. Return the number of packets.
+        size_t replayPackets(TSPacket* packets, size_t count);
+
+        // Generate one packet from the sections, possibly recording it in the precompiled cycle.
+        bool generatePacket(TSPacket& packet);
+
+        // Invalidate the precompiled cycle when the sections or the packetization rules change.
+        void invalidateCycle();
+
+        // Clear the precompiled cycle.
+        void dropCycle();
+
         // Remove all sections with the specified tid/tid_ext in the specified list.
         void removeSections(SectionDescList&, TID tid, uint16_t tid_ext, uint8_t sec_number, bool use_tid_ext, bool use_sec_number, bool scheduled);
 
@@ -48,3 +48,8 @@ bool ts::OneShotPacketizer::getNextPacket(TSPacket&)
 {
     return false;
 }
+
+size_t ts::OneShotPacketizer::getNextPackets(TSPacket*, size_t)
+{
+    return 0;
+}
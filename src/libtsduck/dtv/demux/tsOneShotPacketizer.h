@@ -58,5 +58,6 @@ namespace ts {
         // Hide these methods
         void setStuffingPolicy(StuffingPolicy) = delete;
         virtual bool getNextPacket(TSPacket&) override;
+        virtual size_t getNextPackets(TSPacket*, size_t) override;
     };
 }
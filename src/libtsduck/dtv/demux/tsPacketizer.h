@@ -56,7 +56,7 @@ namespace ts {
         //! @return True if the last returned packet contained
         //! the end of a section and no unfinished section.
         //!
-        bool atSectionBoundary() const { return _next_byte == 0; }
+        virtual bool atSectionBoundary() const { return _next_byte == 0; }
 
         //!
         //! Get the number of completely packetized sections so far.
@@ -83,6 +83,24 @@ namespace ts {
         virtual bool getNextPacket(TSPacket& packet) override;
         virtual std::ostream& display(std::ostream& strm) const override;
 
+    protected:
+        //!
+        //! Check if there is no pending section in the packetizer.
+        //! @return True if all sections which were returned by the section provider are completely packetized.
+        //!
+        bool noPendingSection() const { return _section == nullptr; }
+
+        //!
+        //! Account for complete sections which were packetized outside getNextPacket().
+        //! This is used by subclasses which replay previously generated packets.
+        //! @param [in] count Number of sections which were provided and completely packetized.
+        //!
+        void countSections(SectionCounter count)
+        {
+            _section_in_count += count;
+            _section_out_count += count;
+        }
+
     private:
         SectionProviderInterface* _provider = nullptr;
         bool           _split_headers = false;  // Allowed to split section header beetwen TS packets.
@@ -154,6 +154,9 @@ void ts::SectionDemux::XTIDContext::notify(SectionDemux& demux, bool pack, bool
         // Invoke the table handler.
         if (table.isValid()) {
             notified = true;
+            if (CountersEnabled()) {
+                ThreadCounters().tables++;
+            }
             demux._table_handler->handleTable(demux, table);
         }
     }
@@ -401,6 +404,9 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
         }
 
         // We have a complete section in the pc.ts buffer. Analyze it.
+        if (CountersEnabled()) {
+            ThreadCounters().sections++;
+        }
         uint8_t version = 0;
         bool is_next = false;
         uint8_t section_number = 0;
@@ -594,6 +600,9 @@ void ts::SectionDemux::fixAndFlush(bool pack, bool fill_eit)
 
 bool ts::SectionDemux::notifyInvalid(PID pid, Section::Status status, const uint8_t* ts_start, size_t ts_size)
 {
+    if (CountersEnabled()) {
+        ThreadCounters().invalid++;
+    }
     if (_invalid_handler != nullptr) {
         // Build a demuxed data from the TS payload buffer.
         PIDContext& pc(_pids[pid]);
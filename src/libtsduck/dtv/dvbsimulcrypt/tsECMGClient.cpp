@@ -125,17 +125,44 @@ bool ts::ECMGClient::connect(const ECMGClientArgs& args,
     assert(csp != nullptr);
     channel_status = _channel_status = *csp;
 
+    // Setup the first stream.
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _streams.clear();
+    }
+    if (!setupStream(args.ecm_stream_id, args.ecm_id, args.cp_duration, stream_status)) {
+        return false;
+    }
+    _stream_status = stream_status;
+
+    // ECM stream now established
+    {
+        std::lock_guard<std::recursive_mutex> lock(_mutex);
+        _state = CONNECTED;
+    }
+
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Setup a stream in the channel and wait for the stream_status.
+//----------------------------------------------------------------------------
+
+bool ts::ECMGClient::setupStream(uint16_t stream_id, uint16_t ecm_id, const ts::deciseconds& cp_duration, ecmgscs::StreamStatus& stream_status)
+{
     // Send a stream_setup message to ECMG
     ecmgscs::StreamSetup stream_setup(_protocol);
-    stream_setup.channel_id = args.ecm_channel_id;
-    stream_setup.stream_id = args.ecm_stream_id;
-    stream_setup.ECM_id = args.ecm_id;
-    stream_setup.nominal_CP_duration = uint16_t(args.cp_duration.count()); // unit is 1/10 second
+    stream_setup.channel_id = _channel_status.channel_id;
+    stream_setup.stream_id = stream_id;
+    stream_setup.ECM_id = ecm_id;
+    stream_setup.nominal_CP_duration = uint16_t(cp_duration.count()); // unit is 1/10 second
     if (!_connection.sendMessage(stream_setup)) {
         return abortConnection();
     }
 
     // Wait for a stream_status from the ECMG
+    tlv::MessagePtr msg;
     if (!_response_queue.dequeue(msg, RESPONSE_TIMEOUT)) {
         return abortConnection(u"ECMG stream_setup response timeout");
     }
@@ -144,15 +171,32 @@ bool ts::ECMGClient::connect(const ECMGClientArgs& args,
     }
     const auto ssp = std::dynamic_pointer_cast<ecmgscs::StreamStatus>(msg);
     assert(ssp != nullptr);
-    stream_status = _stream_status = *ssp;
+    stream_status = *ssp;
 
-    // ECM stream now established
+    std::lock_guard<std::recursive_mutex> lock(_mutex);
+    _streams.insert_or_assign(stream_id, *ssp);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Create an additional ECM stream in the channel.
+//----------------------------------------------------------------------------
+
+bool ts::ECMGClient::addStream(uint16_t stream_id, uint16_t ecm_id, const ts::deciseconds& cp_duration, ecmgscs::StreamStatus& stream_status)
+{
     {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
-        _state = CONNECTED;
+        if (_state != CONNECTED) {
+            _logger.report().error(u"ECMG client not connected");
+            return false;
+        }
+        if (_streams.contains(stream_id)) {
+            _logger.report().error(u"ECM stream id %n already used", stream_id);
+            return false;
+        }
     }
-
-    return true;
+    return setupStream(stream_id, ecm_id, cp_duration, stream_status);
 }
 
 
@@ -186,17 +230,27 @@ bool ts::ECMGClient::disconnect()
     // Disconnection sequence
     bool ok = previous_state == CONNECTED;
     if (ok) {
-        // Politely send a stream_close_request
-        ecmgscs::StreamCloseRequest req(_protocol);
-        req.channel_id = _stream_status.channel_id;
-        req.stream_id = _stream_status.stream_id;
-        tlv::MessagePtr resp;
-        // Politely send a stream_close_request
-        // and wait for a stream_close_response
-        ok = _connection.sendMessage(req) &&
-             _response_queue.dequeue(resp, RESPONSE_TIMEOUT) &&
-             resp->tag() == ecmgscs::Tags::stream_close_response;
-        // If we get a polite reply, send a channel_close
+        std::vector<uint16_t> stream_ids;
+        {
+            std::lock_guard<std::recursive_mutex> lock(_mutex);
+            for (const auto& it : _streams) {
+                stream_ids.push_back(it.first);
+            }
+        }
+        // Close all streams, even when the closure of a previous one failed.
+        for (uint16_t stream_id : stream_ids) {
+            ecmgscs::StreamCloseRequest req(_protocol);
+            req.channel_id = _channel_status.channel_id;
+            req.stream_id = stream_id;
+            tlv::MessagePtr resp;
+            // Politely send a stream_close_request
+            // and wait for a stream_close_response
+            const bool closed = _connection.sendMessage(req) &&
+                                _response_queue.dequeue(resp, RESPONSE_TIMEOUT) &&
+                                resp->tag() == ecmgscs::Tags::stream_close_response;
+            ok = closed && ok;
+        }
+        // If we get polite replies for all streams, send a channel_close
         if (ok) {
             ecmgscs::ChannelClose cc(_protocol);
             cc.channel_id = _channel_status.channel_id;
@@ -222,14 +276,15 @@ bool ts::ECMGClient::disconnect()
 //----------------------------------------------------------------------------
 
 void ts::ECMGClient::buildCWProvision(ecmgscs::CWProvision& msg,
+                                      uint16_t stream_id,
                                       uint16_t cp_number,
                                       const ByteBlock& current_cw,
                                       const ByteBlock& next_cw,
                                       const ByteBlock& ac,
                                       const ts::deciseconds& cp_duration)
 {
-    msg.channel_id = _stream_status.channel_id;
-    msg.stream_id = _stream_status.stream_id;
+    msg.channel_id = _channel_status.channel_id;
+    msg.stream_id = stream_id;
     msg.CP_number = cp_number;
     msg.has_CW_encryption = false;
     msg.has_CP_duration = cp_duration.count() != 0;
@@ -251,7 +306,8 @@ void ts::ECMGClient::buildCWProvision(ecmgscs::CWProvision& msg,
 // Synchronously generate an ECM.
 //----------------------------------------------------------------------------
 
-bool ts::ECMGClient::generateECM(uint16_t cp_number,
+bool ts::ECMGClient::generateECM(uint16_t stream_id,
+                                 uint16_t cp_number,
                                  const ByteBlock& current_cw,
                                  const ByteBlock& next_cw,
                                  const ByteBlock& ac,
@@ -260,7 +316,7 @@ bool ts::ECMGClient::generateECM(uint16_t cp_number,
 {
     // Build a CW_provision message
     ecmgscs::CWProvision msg(_protocol);
-    buildCWProvision(msg, cp_number, current_cw, next_cw, ac, cp_duration);
+    buildCWProvision(msg, stream_id, cp_number, current_cw, next_cw, ac, cp_duration);
 
     // Send the CW_provision message
     if (!_connection.sendMessage(msg)) {
@@ -282,7 +338,7 @@ bool ts::ECMGClient::generateECM(uint16_t cp_number,
     if (resp->tag() == ecmgscs::Tags::ECM_response) {
         const auto ep = std::dynamic_pointer_cast<ecmgscs::ECMResponse>(resp);
         assert(ep != nullptr);
-        if (ep->CP_number == cp_number) {
+        if (ep->stream_id == stream_id && ep->CP_number == cp_number) {
             // This is our ECM
             ecm_response = *ep;
             return true;
@@ -302,7 +358,8 @@ bool ts::ECMGClient::generateECM(uint16_t cp_number,
 // Asynchronously generate an ECM.
 //----------------------------------------------------------------------------
 
-bool ts::ECMGClient::submitECM(uint16_t cp_number,
+bool ts::ECMGClient::submitECM(uint16_t stream_id,
+                               uint16_t cp_number,
                                const ByteBlock& current_cw,
                                const ByteBlock& next_cw,
                                const ByteBlock& ac,
@@ -311,12 +368,13 @@ bool ts::ECMGClient::submitECM(uint16_t cp_number,
 {
     // Build a CW_provision message
     ecmgscs::CWProvision msg(_protocol);
-    buildCWProvision(msg, cp_number, current_cw, next_cw, ac, cp_duration);
+    buildCWProvision(msg, stream_id, cp_number, current_cw, next_cw, ac, cp_duration);
 
     // Register an asynchronous request
+    const auto key = std::make_pair(stream_id, cp_number);
     {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
-        _async_requests.insert(std::make_pair(cp_number, ecm_handler));
+        _async_requests.insert(std::make_pair(key, ecm_handler));
     }
 
     // Send the CW_provision message
@@ -325,7 +383,7 @@ bool ts::ECMGClient::submitECM(uint16_t cp_number,
     // Clear asynchronous request on error
     if (!ok) {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
-        _async_requests.erase(cp_number);
+        _async_requests.erase(key);
     }
 
     return ok;
@@ -372,8 +430,18 @@ void ts::ECMGClient::main()
                     break;
                 }
                 case ecmgscs::Tags::stream_test: {
-                    // Automatic reply to stream_test
-                    ok = _connection.sendMessage(_stream_status);
+                    // Automatic reply to stream_test, using the status of the corresponding stream.
+                    const auto test = std::dynamic_pointer_cast<ecmgscs::StreamTest>(msg);
+                    assert(test != nullptr);
+                    ecmgscs::StreamStatus status(_stream_status);
+                    {
+                        std::lock_guard<std::recursive_mutex> lock(_mutex);
+                        const auto it = _streams.find(test->stream_id);
+                        if (it != _streams.end()) {
+                            status = it->second;
+                        }
+                    }
+                    ok = _connection.sendMessage(status);
                     break;
                 }
                 case ecmgscs::Tags::ECM_response: {
@@ -383,10 +451,10 @@ void ts::ECMGClient::main()
                     ECMGClientHandlerInterface* handler = nullptr;
                     {
                         std::lock_guard<std::recursive_mutex> lock(_mutex);
-                        auto it = _async_requests.find(resp->CP_number);
+                        auto it = _async_requests.find(std::make_pair(resp->stream_id, resp->CP_number));
                         if (it != _async_requests.end()) {
                             handler = it->second;
-                            _async_requests.erase(resp->CP_number);
+                            _async_requests.erase(it);
                         }
                     }
                     if (handler == nullptr) {
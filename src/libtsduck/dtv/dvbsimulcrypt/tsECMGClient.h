@@ -28,6 +28,10 @@ namespace ts {
     //! Restriction: The target ECMG shall support only current or current/next control
     //! words in ECM, meaning CW_per_msg = 1 or 2 and lead_CW = 0 or 1.
     //!
+    //! One ECMG channel is used. The first ECM stream is created by connect(). Additional
+    //! ECM streams can be created in the same channel using addStream(). This is typically
+    //! used to generate the ECM's of several services using one single ECMG connection.
+    //!
     //! @see DVB standard ETSI TS 103.197 V1.4.1 for ECMG <=> SCS protocol.
     //! @ingroup libtsduck mpeg
     //!
@@ -67,6 +71,18 @@ namespace ts {
                      ecmgscs::StreamStatus& stream_status,
                      const AbortInterface* abort = nullptr);
 
+        //!
+        //! Create an additional ECM stream in the channel.
+        //! The channel and the first ECM stream must have been established using connect().
+        //!
+        //! @param [in] stream_id ECM_stream_id of the new stream. Must be different from all other streams in the channel.
+        //! @param [in] ecm_id ECM_id of the new stream.
+        //! @param [in] cp_duration Nominal crypto-period in 100 ms units.
+        //! @param [out] stream_status Initial response to stream_setup
+        //! @return True on success, false on error.
+        //!
+        bool addStream(uint16_t stream_id, uint16_t ecm_id, const ts::deciseconds& cp_duration, ecmgscs::StreamStatus& stream_status);
+
         //!
         //! Synchronously generate an ECM.
         //!
@@ -80,6 +96,30 @@ namespace ts {
         //! @return True on success, false on error.
         //!
         bool generateECM(uint16_t cp_number,
+                         const ByteBlock& current_cw,
+                         const ByteBlock& next_cw,
+                         const ByteBlock& ac,
+                         const ts::deciseconds& cp_duration,
+                         ecmgscs::ECMResponse& response)
+        {
+            return generateECM(_stream_status.stream_id, cp_number, current_cw, next_cw, ac, cp_duration, response);
+        }
+
+        //!
+        //! Synchronously generate an ECM in a given ECM stream.
+        //!
+        //! @param [in] stream_id ECM_stream_id of the ECM stream.
+        //! @param [in] cp_number Current crypto-period number.
+        //! @param [in] current_cw Control word for current crypto-period.
+        //! @param [in] next_cw Control word for next crypto-period.
+        //! If empty, the ECMG must work with CW_per_msg = 1.
+        //! @param [in] ac Access criteria, can be empty.
+        //! @param [in] cp_duration Crypto-period in 100 ms units, unspecified if zero.
+        //! @param [out] response Returned ECM.
+        //! @return True on success, false on error.
+        //!
+        bool generateECM(uint16_t stream_id,
+                         uint16_t cp_number,
                          const ByteBlock& current_cw,
                          const ByteBlock& next_cw,
                          const ByteBlock& ac,
@@ -101,6 +141,32 @@ namespace ts {
         //! @return True on success, false on error.
         //!
         bool submitECM(uint16_t cp_number,
+                       const ByteBlock& current_cw,
+                       const ByteBlock& next_cw,
+                       const ByteBlock& ac,
+                       const ts::deciseconds& cp_duration,
+                       ECMGClientHandlerInterface* handler)
+        {
+            return submitECM(_stream_status.stream_id, cp_number, current_cw, next_cw, ac, cp_duration, handler);
+        }
+
+        //!
+        //! Asynchronously generate an ECM in a given ECM stream.
+        //! Submit the ECM request and return immediately.
+        //! The notification of the ECM generation or error is performed through the specified handler.
+        //!
+        //! @param [in] stream_id ECM_stream_id of the ECM stream.
+        //! @param [in] cp_number Current crypto-period number.
+        //! @param [in] current_cw Control word for current crypto-period.
+        //! @param [in] next_cw Control word for next crypto-period.
+        //! If empty, the ECMG must work with CW_per_msg = 1.
+        //! @param [in] ac Access criteria, can be empty.
+        //! @param [in] cp_duration Crypto-period in 100 ms units, unspecified if zero.
+        //! @param [in] handler Object which will be notified of the returned ECM.
+        //! @return True on success, false on error.
+        //!
+        bool submitECM(uint16_t stream_id,
+                       uint16_t cp_number,
                        const ByteBlock& current_cw,
                        const ByteBlock& next_cw,
                        const ByteBlock& ac,
@@ -109,7 +175,7 @@ namespace ts {
 
         //!
         //! Disconnect from remote ECMG.
-        //! Close stream and channel.
+        //! Close all streams and channel.
         //! @return True on success, false on error.
         //!
         bool disconnect();
@@ -140,8 +206,8 @@ namespace ts {
         // Timeout for responses from ECMG (except ECM generation)
         static constexpr cn::seconds RESPONSE_TIMEOUT = cn::seconds(5);
 
-        // List of asynchronous ECM requests: key=cp_number, value=handler
-        using AsyncRequests = std::map <uint16_t, ECMGClientHandlerInterface*>;
+        // List of asynchronous ECM requests: key=(stream_id, cp_number), value=handler
+        using AsyncRequests = std::map<std::pair<uint16_t, uint16_t>, ECMGClientHandlerInterface*>;
 
         // Private members
         tlv::Logger&                 _logger;
@@ -150,7 +216,8 @@ namespace ts {
         const AbortInterface*        _abort = nullptr;
         tlv::Connection<ThreadSafety::None> _connection {_logger, _protocol, true, 3}; // connection with ECMG server
         ecmgscs::ChannelStatus       _channel_status {_protocol};   // initial response to channel_setup
-        ecmgscs::StreamStatus        _stream_status {_protocol};    // initial response to stream_setup
+        ecmgscs::StreamStatus        _stream_status {_protocol};    // initial response to stream_setup (first stream)
+        std::map<uint16_t, ecmgscs::StreamStatus> _streams {};      // all streams in the channel, indexed by stream_id
         mutable std::recursive_mutex _mutex {};                     // exclusive access to protected fields
         std::condition_variable_any  _work_to_do {};                // notify receiver thread to do some work
         AsyncRequests                _async_requests {};
@@ -158,6 +225,7 @@ namespace ts {
 
         // Build a CW_provision message.
         void buildCWProvision(ecmgscs::CWProvision& msg,
+                              uint16_t stream_id,
                               uint16_t cp_number,
                               const ByteBlock& current_cw,
                               const ByteBlock& next_cw,
@@ -167,6 +235,9 @@ namespace ts {
         // Receiver thread main code
         virtual void main() override;
 
+        // Setup a stream in the channel and wait for the stream_status.
+        bool setupStream(uint16_t stream_id, uint16_t ecm_id, const ts::deciseconds& cp_duration, ecmgscs::StreamStatus& stream_status);
+
         // Report specified error message if not empty, abort connection and return false
         bool abortConnection(const UString& = UString());
     };
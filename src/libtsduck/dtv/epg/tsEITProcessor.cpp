@@ -9,6 +9,7 @@
 #include "tsEITProcessor.h"
 #include "tsDuckContext.h"
 #include "tsSection.h"
+#include "tsEITView.h"
 #include "tsTime.h"
 #include "tsMJD.h"
 
@@ -286,7 +287,6 @@ bool ts::EITProcessor::Match(const Service& srv, uint16_t srv_id, uint16_t ts_id
 void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section)
 {
     const TID tid = section.tableId();
-    const size_t pl_size = section.payloadSize();
 
     // Eliminate sections by table id.
     if (_removed_tids.contains(tid)) {
@@ -297,15 +297,16 @@ void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section
     // Check if the table is an EIT. Use the fact that all EIT ids are contiguous.
     const bool is_eit = tid >= TID_EIT_PF_ACT && tid <= TID_EIT_S_OTH_MAX;
 
-    // The minimal payload size for EIT's is 6 bytes. Eliminate invalid EIT's.
-    if (is_eit && pl_size < 6) {
+    // Read the EIT in place. Eliminate invalid EIT's, shorter than the fixed part.
+    const EITView eit(section);
+    if (is_eit && !eit.isValid()) {
         return;
     }
 
     // Get EIT's characteristics.
     const uint16_t srv_id = section.tableIdExtension();
-    const uint16_t ts_id  = pl_size < 2 ? 0 : GetUInt16(section.payload());
-    const uint16_t net_id = pl_size < 4 ? 0 : GetUInt16(section.payload() + 2);
+    const uint16_t ts_id  = eit.tsId();
+    const uint16_t net_id = eit.originalNetworkId();
 
     // Look for EIT's in services to keep or remove.
     if (is_eit) {
@@ -360,12 +361,12 @@ void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section
 
         // Update all events start times.
         if (_start_time_offset != cn::milliseconds::zero()) {
-            uint8_t* data = const_cast<uint8_t*>(sp->payload() + 6);
-            const uint8_t* const end = sp->payload() + sp->payloadSize();
-            while (data + 12 <= end) {
-                // Update event start time.
+            const EITView copy(*sp);
+            for (const auto& ev : copy) {
+                // Update event start time, in place in the copy of the section.
+                uint8_t* const data = const_cast<uint8_t*>(ev.data());
                 Time time;
-                if (!DecodeMJD(data + 2, MJD_FULL, time)) {
+                if (!ev.startTime(time)) {
                     _duck.report().warning(u"error decoding event start time from EIT");
                 }
                 else {
@@ -377,7 +378,6 @@ void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section
                         modified = true;
                     }
                 }
-                data += 12 + (GetUInt16(data + 10) & 0x0FFF);
             }
         }
 
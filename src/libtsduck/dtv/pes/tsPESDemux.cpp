@@ -142,6 +142,17 @@ bool ts::PESDemux::allAC3(PID pid) const
 }
 
 
+//----------------------------------------------------------------------------
+// Check if a PES packet is partially demuxed on the specified PID.
+//----------------------------------------------------------------------------
+
+bool ts::PESDemux::hasPendingPES(PID pid) const
+{
+    const auto pci = _pids.find(pid);
+    return pci != _pids.end() && pci->second.sync && pci->second.ts != nullptr && !pci->second.ts->empty();
+}
+
+
 //----------------------------------------------------------------------------
 // Feed the demux with a TS packet.
 //----------------------------------------------------------------------------
@@ -380,6 +391,9 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
         if (pes.isValid()) {
             // Count valid PES packets
             pc.pes_count++;
+            if (CountersEnabled()) {
+                ThreadCounters().pes_packets++;
+            }
 
             // Location of the PES packet inside the demultiplexed stream
             pes.setFirstTSPacketIndex(pc.first_pkt);
@@ -405,12 +419,18 @@ void ts::PESDemux::processPESPacket(PID pid, PIDContext& pc)
                 handlePESContent(pc, pes);
             }
         }
-        else if (_pes_handler != nullptr) {
-            // Handle an invalid PES packet. Prepare raw demuxed data.
-            DemuxedData data(pc.ts, pid);
-            data.setFirstTSPacketIndex(pc.first_pkt);
-            data.setLastTSPacketIndex(pc.last_pkt);
-            _pes_handler->handleInvalidPESPacket(*this, data);
+        else {
+            // Count invalid PES packets
+            if (CountersEnabled()) {
+                ThreadCounters().invalid++;
+            }
+            if (_pes_handler != nullptr) {
+                // Handle an invalid PES packet. Prepare raw demuxed data.
+                DemuxedData data(pc.ts, pid);
+                data.setFirstTSPacketIndex(pc.first_pkt);
+                data.setLastTSPacketIndex(pc.last_pkt);
+                _pes_handler->handleInvalidPESPacket(*this, data);
+            }
         }
     }
     catch (...) {
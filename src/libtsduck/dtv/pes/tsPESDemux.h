@@ -157,6 +157,14 @@ namespace ts {
         //!
         bool allAC3(PID pid) const;
 
+        //!
+        //! Check if a PES packet is partially demuxed on the specified PID.
+        //! This is a PES packet which has started but which is not yet complete.
+        //! @param [in] pid The PID to check.
+        //! @return True if a PES packet is in progress on @a pid.
+        //!
+        bool hasPendingPES(PID pid) const;
+
     protected:
         //!
         //! This hook is invoked when a complete PES packet is available.
@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsAbstractTableView.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::AbstractTableView::AbstractTableView(const BinaryTable& table, TID min_tid, TID max_tid, size_t min_payload) :
+    _table(&table)
+{
+    const Section* section = table.isValid() ? sectionAt(0) : nullptr;
+    _valid = section != nullptr && section->tableId() >= min_tid && section->tableId() <= max_tid && section->payloadSize() >= min_payload;
+}
+
+ts::AbstractTableView::AbstractTableView(const Section& section, TID min_tid, TID max_tid, size_t min_payload) :
+    _section(&section),
+    _valid(section.isValid() && section.tableId() >= min_tid && section.tableId() <= max_tid && section.payloadSize() >= min_payload)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Get a section in the view.
+//----------------------------------------------------------------------------
+
+const ts::Section* ts::AbstractTableView::sectionAt(size_t index) const
+{
+    if (_table != nullptr) {
+        return index < _table->sectionCount() ? _table->sectionAt(index).get() : nullptr;
+    }
+    else {
+        return index == 0 ? _section : nullptr;
+    }
+}
@@ -0,0 +1,208 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Abstract base class for read-only views over binary tables.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsBinaryTable.h"
+#include "tsSection.h"
+#include "tsDescriptorListView.h"
+
+namespace ts {
+    //!
+    //! Abstract base class for read-only views over binary tables.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! Deserializing a table, a subclass of AbstractTable, builds the complete structure of the
+    //! table, including descriptor lists and decoded strings. When only a few fields are needed,
+    //! a "table view" reads them directly from the section data, without allocation.
+    //!
+    //! A table view is built over a BinaryTable or a single Section. The view does not copy
+    //! the data. The table or section must remain valid and unmodified while the view is used.
+    //!
+    //! The entries of the main loop of a table (services, events, streams, etc.) are accessed
+    //! using forward iterators over all sections of the table. A truncated entry ends the loop
+    //! in the current section.
+    //!
+    class TSDUCKDLL AbstractTableView
+    {
+    public:
+        //!
+        //! Check if the view is valid.
+        //! @return True if the binary table or section is valid and has the expected table id and minimum size.
+        //!
+        bool isValid() const { return _valid; }
+
+        //!
+        //! Get the table id.
+        //! @return The table id or TID_NULL if the view is invalid.
+        //!
+        TID tableId() const { return _valid ? sectionAt(0)->tableId() : TID(TID_NULL); }
+
+        //!
+        //! Get the table id extension.
+        //! @return The table id extension or zero if the view is invalid.
+        //!
+        uint16_t tableIdExtension() const { return _valid ? sectionAt(0)->tableIdExtension() : 0; }
+
+        //!
+        //! Get the table version.
+        //! @return The table version or zero if the view is invalid.
+        //!
+        uint8_t version() const { return _valid ? sectionAt(0)->version() : 0; }
+
+        //!
+        //! Get the number of sections in the view.
+        //! @return The number of sections in the view.
+        //!
+        size_t sectionCount() const { return !_valid ? 0 : (_table != nullptr ? _table->sectionCount() : 1); }
+
+        //!
+        //! Get a section in the view.
+        //! @param [in] index Index of the section in the view.
+        //! @return The address of the section or a null pointer if not present.
+        //!
+        const Section* sectionAt(size_t index) const;
+
+        //!
+        //! Forward iterator over the entries of a loop in all sections of the view.
+        //!
+        //! The class @a ENTRY is a view over one entry. It must define the following members:
+        //! - A default constructor.
+        //! - @c static @c bool @c Area(const Section& section, const uint8_t*& begin, const uint8_t*& end):
+        //!   locate the loop in a section, return false if the section is invalid.
+        //! - @c size_t @c assign(const uint8_t* data, size_t max_size): point to a new entry,
+        //!   return the entry size or zero if the entry is truncated.
+        //!
+        //! @tparam ENTRY The view over one entry.
+        //!
+        template <class ENTRY>
+        class Iterator
+        {
+        public:
+            //! @cond nodoxygen
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = ENTRY;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const ENTRY*;
+            using reference = const ENTRY&;
+            //! @endcond
+
+            //!
+            //! Default constructor, an end iterator.
+            //!
+            Iterator() = default;
+
+            //!
+            //! Constructor, pointing to the first entry of a table view.
+            //! @param [in] view The table view.
+            //!
+            Iterator(const AbstractTableView& view) : _view(&view) { seek(); }
+
+            //! @cond nodoxygen
+            const ENTRY& operator*() const { return _entry; }
+            const ENTRY* operator->() const { return &_entry; }
+            Iterator& operator++() { next(); return *this; }
+            Iterator operator++(int) { Iterator it(*this); next(); return it; }
+            bool operator==(const Iterator& other) const { return _view == other._view && _cur == other._cur; }
+            //! @endcond
+
+        private:
+            const AbstractTableView* _view = nullptr;  // Null at end.
+            size_t         _index = 0;                 // Current section index.
+            const uint8_t* _cur = nullptr;             // Current entry.
+            const uint8_t* _end = nullptr;             // End of loop in current section.
+            size_t         _size = 0;                  // Size of current entry.
+            ENTRY          _entry {};
+
+            // Load the entry at _cur, return false if there is none.
+            bool load();
+
+            // Find the first entry, starting at section _index.
+            void seek();
+
+            // Move to next entry.
+            void next();
+        };
+
+    protected:
+        //!
+        //! Constructor for subclasses, from a binary table.
+        //! @param [in] table The binary table.
+        //! @param [in] min_tid Minimum valid table id.
+        //! @param [in] max_tid Maximum valid table id.
+        //! @param [in] min_payload Minimum payload size of the first section.
+        //!
+        AbstractTableView(const BinaryTable& table, TID min_tid, TID max_tid, size_t min_payload);
+
+        //!
+        //! Constructor for subclasses, from a single section.
+        //! @param [in] section The section.
+        //! @param [in] min_tid Minimum valid table id.
+        //! @param [in] max_tid Maximum valid table id.
+        //! @param [in] min_payload Minimum payload size of the section.
+        //!
+        AbstractTableView(const Section& section, TID min_tid, TID max_tid, size_t min_payload);
+
+        //!
+        //! Get the payload of the first section.
+        //! @return The address of the payload of the first section or a null pointer if the view is invalid.
+        //! When not null, the payload contains at least the minimum payload size from the constructor.
+        //!
+        const uint8_t* header() const { return _valid ? sectionAt(0)->payload() : nullptr; }
+
+    private:
+        const BinaryTable* _table = nullptr;
+        const Section*     _section = nullptr;
+        bool               _valid = false;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Template definitions.
+//----------------------------------------------------------------------------
+
+#if !defined(DOXYGEN)
+
+template <class ENTRY>
+bool ts::AbstractTableView::Iterator<ENTRY>::load()
+{
+    _size = _cur < _end ? _entry.assign(_cur, size_t(_end - _cur)) : 0;
+    return _size > 0;
+}
+
+template <class ENTRY>
+void ts::AbstractTableView::Iterator<ENTRY>::seek()
+{
+    for (const size_t count = _view->sectionCount(); _index < count; ++_index) {
+        const Section* section = _view->sectionAt(_index);
+        if (section != nullptr && ENTRY::Area(*section, _cur, _end) && load()) {
+            return;
+        }
+    }
+    _view = nullptr;
+    _cur = nullptr;
+}
+
+template <class ENTRY>
+void ts::AbstractTableView::Iterator<ENTRY>::next()
+{
+    if (_view != nullptr) {
+        _cur += _size;
+        if (!load()) {
+            ++_index;
+            seek();
+        }
+    }
+}
+
+#endif
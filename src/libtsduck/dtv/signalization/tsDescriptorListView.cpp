@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsDescriptorListView.h"
+#include "tsDescriptorList.h"
+
+
+//----------------------------------------------------------------------------
+// Get the number of valid descriptors in the loop.
+//----------------------------------------------------------------------------
+
+size_t ts::DescriptorListView::count() const
+{
+    return size_t(std::distance(begin(), end()));
+}
+
+
+//----------------------------------------------------------------------------
+// Search a descriptor with the specified tag.
+//----------------------------------------------------------------------------
+
+ts::DescriptorListView::Iterator ts::DescriptorListView::search(DID tag, Iterator start) const
+{
+    while (start != end() && start->tag() != tag) {
+        ++start;
+    }
+    return start;
+}
+
+
+//----------------------------------------------------------------------------
+// Copy all descriptors in a descriptor list.
+//----------------------------------------------------------------------------
+
+size_t ts::DescriptorListView::addTo(DescriptorList& dlist) const
+{
+    size_t count = 0;
+    for (const auto& desc : *this) {
+        if (dlist.add(desc.content(), desc.size())) {
+            count++;
+        }
+    }
+    return count;
+}
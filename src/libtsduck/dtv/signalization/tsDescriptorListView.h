@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary descriptor loop inside a section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsDescriptorView.h"
+
+namespace ts {
+
+    class DescriptorList;
+
+    //!
+    //! Read-only view over a binary descriptor loop inside a section.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! The descriptors are directly read from the section data, without allocation.
+    //! The view is invalidated when the section is modified or deallocated.
+    //! A truncated descriptor ends the loop.
+    //!
+    class TSDUCKDLL DescriptorListView
+    {
+    public:
+        //!
+        //! Default constructor, an empty descriptor loop.
+        //!
+        DescriptorListView() = default;
+
+        //!
+        //! Constructor.
+        //! @param [in] data Address of the first descriptor.
+        //! @param [in] size Size in bytes of the descriptor loop.
+        //!
+        DescriptorListView(const uint8_t* data, size_t size) : _data(data), _size(data == nullptr ? 0 : size) {}
+
+        //!
+        //! Forward iterator over the descriptors in the loop.
+        //!
+        class TSDUCKDLL Iterator
+        {
+        public:
+            //! @cond nodoxygen
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = DescriptorView;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const DescriptorView*;
+            using reference = const DescriptorView&;
+            //! @endcond
+
+            //!
+            //! Default constructor, an end iterator.
+            //!
+            Iterator() = default;
+
+            //!
+            //! Constructor.
+            //! @param [in] data Address of the first descriptor.
+            //! @param [in] size Size in bytes of the descriptor loop.
+            //!
+            Iterator(const uint8_t* data, size_t size) : _end(data + size) { load(data); }
+
+            //! @cond nodoxygen
+            const DescriptorView& operator*() const { return _desc; }
+            const DescriptorView* operator->() const { return &_desc; }
+            Iterator& operator++() { load(_desc.content() + _desc.size()); return *this; }
+            Iterator operator++(int) { Iterator it(*this); ++*this; return it; }
+            bool operator==(const Iterator& other) const { return _desc.content() == other._desc.content(); }
+            //! @endcond
+
+        private:
+            const uint8_t* _end = nullptr;
+            DescriptorView _desc {};
+            void load(const uint8_t* data) { _desc.assign(data, data < _end ? size_t(_end - data) : 0); }
+        };
+
+        //!
+        //! Get an iterator to the first descriptor.
+        //! @return An iterator to the first descriptor.
+        //!
+        Iterator begin() const { return Iterator(_data, _size); }
+
+        //!
+        //! Get an iterator after the last descriptor.
+        //! @return An iterator after the last descriptor.
+        //!
+        Iterator end() const { return Iterator(); }
+
+        //!
+        //! Get the address of the descriptor loop.
+        //! @return The address of the descriptor loop.
+        //!
+        const uint8_t* data() const { return _data; }
+
+        //!
+        //! Get the size of the descriptor loop.
+        //! @return The size in bytes of the descriptor loop.
+        //!
+        size_t size() const { return _size; }
+
+        //!
+        //! Check if the descriptor loop is empty.
+        //! @return True if the descriptor loop contains no valid descriptor.
+        //!
+        bool empty() const { return begin() == end(); }
+
+        //!
+        //! Get the number of valid descriptors in the loop.
+        //! @return The number of valid descriptors in the loop.
+        //!
+        size_t count() const;
+
+        //!
+        //! Search a descriptor with the specified tag.
+        //! @param [in] tag Tag of descriptor to search.
+        //! @param [in] start Start searching at this position.
+        //! @return An iterator to the first descriptor with @a tag, starting at @a start, or end() if not found.
+        //!
+        Iterator search(DID tag, Iterator start) const;
+
+        //!
+        //! Search a descriptor with the specified tag.
+        //! @param [in] tag Tag of descriptor to search.
+        //! @return A view of the first descriptor with @a tag. The view is invalid if not found.
+        //!
+        DescriptorView search(DID tag) const { const Iterator it(search(tag, begin())); return it == end() ? DescriptorView() : *it; }
+
+        //!
+        //! Check if the loop contains a descriptor with the specified tag.
+        //! @param [in] tag Tag of descriptor to search.
+        //! @return True if a descriptor with @a tag is present.
+        //!
+        bool contains(DID tag) const { return search(tag, begin()) != end(); }
+
+        //!
+        //! Copy all descriptors in a descriptor list.
+        //! This method allocates the descriptors. Use it only when the descriptors must be deserialized.
+        //! @param [in,out] dlist The descriptor list into which all descriptors are added.
+        //! @return The number of added descriptors.
+        //!
+        size_t addTo(DescriptorList& dlist) const;
+
+    private:
+        const uint8_t* _data = nullptr;
+        size_t         _size = 0;
+    };
+}
@@ -0,0 +1,26 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsDescriptorView.h"
+
+
+//----------------------------------------------------------------------------
+// Point a descriptor view to a new descriptor.
+//----------------------------------------------------------------------------
+
+size_t ts::DescriptorView::assign(const uint8_t* data, size_t max_size)
+{
+    if (data == nullptr || max_size < 2 || max_size < 2 + size_t(data[1])) {
+        _data = nullptr;
+        return 0;
+    }
+    else {
+        _data = data;
+        return 2 + size_t(data[1]);
+    }
+}
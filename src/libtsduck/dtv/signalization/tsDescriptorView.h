@@ -0,0 +1,89 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary descriptor inside a section.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsDID.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary descriptor inside a section.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! A descriptor view does not copy the descriptor data. It only points into the
+    //! memory of a section. The view is invalidated when the section is modified or
+    //! deallocated. Use a Descriptor object to keep a copy of the descriptor.
+    //!
+    class TSDUCKDLL DescriptorView
+    {
+    public:
+        //!
+        //! Default constructor, an invalid view.
+        //!
+        DescriptorView() = default;
+
+        //!
+        //! Constructor.
+        //! @param [in] data Address of the descriptor tag.
+        //! @param [in] max_size Maximum size in bytes of the descriptor, typically the remaining size of a descriptor loop.
+        //!
+        DescriptorView(const uint8_t* data, size_t max_size) { assign(data, max_size); }
+
+        //!
+        //! Point to a new descriptor.
+        //! @param [in] data Address of the descriptor tag.
+        //! @param [in] max_size Maximum size in bytes of the descriptor.
+        //! @return The size in bytes of the descriptor or zero if the descriptor is truncated.
+        //! In the latter case, the view is invalid.
+        //!
+        size_t assign(const uint8_t* data, size_t max_size);
+
+        //!
+        //! Check if the view points to a valid descriptor.
+        //! @return True if the view points to a valid descriptor.
+        //!
+        bool isValid() const { return _data != nullptr; }
+
+        //!
+        //! Get the descriptor tag.
+        //! @return The descriptor tag or zero if the view is invalid.
+        //!
+        DID tag() const { return _data == nullptr ? 0 : _data[0]; }
+
+        //!
+        //! Get the address of the complete descriptor.
+        //! @return The address of the complete descriptor or a null pointer if the view is invalid.
+        //!
+        const uint8_t* content() const { return _data; }
+
+        //!
+        //! Get the size of the complete descriptor.
+        //! @return The size in bytes of the complete descriptor, including tag and length.
+        //!
+        size_t size() const { return _data == nullptr ? 0 : 2 + size_t(_data[1]); }
+
+        //!
+        //! Get the address of the descriptor payload, after tag and length.
+        //! @return The address of the descriptor payload or a null pointer if the view is invalid.
+        //!
+        const uint8_t* payload() const { return _data == nullptr ? nullptr : _data + 2; }
+
+        //!
+        //! Get the size of the descriptor payload.
+        //! @return The size in bytes of the descriptor payload.
+        //!
+        size_t payloadSize() const { return _data == nullptr ? 0 : size_t(_data[1]); }
+
+    private:
+        const uint8_t* _data = nullptr;
+    };
+}
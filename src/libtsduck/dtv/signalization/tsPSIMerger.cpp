@@ -99,18 +99,23 @@ void ts::PSIMerger::reset(Options options)
         _merge_eit_demux.removePID(PID_EIT);
     }
 
-    // Configure the packetizers.
+    // Configure the packetizers. Since merged tables are replaced only when they
+    // change, their cycles are usually static and can be precompiled.
     _pat_pzer.reset();
     _pat_pzer.setPID(PID_PAT);
+    _pat_pzer.setPrecompiled(true);
 
     _cat_pzer.reset();
     _cat_pzer.setPID(PID_CAT);
+    _cat_pzer.setPrecompiled(true);
 
     _nit_pzer.reset();
     _nit_pzer.setPID(PID_NIT);
+    _nit_pzer.setPrecompiled(true);
 
     _sdt_bat_pzer.reset();
     _sdt_bat_pzer.setPID(PID_SDT);
+    _sdt_bat_pzer.setPrecompiled(true);
 
     _eit_pzer.reset();
     _eit_pzer.setPID(PID_EIT);
@@ -128,6 +133,43 @@ void ts::PSIMerger::reset(Options options)
     _main_bats.clear();
     _merge_bats.clear();
     _eits.clear();
+
+    // Forget previous output tables.
+    _out_pat = OutputTable();
+    _out_cat = OutputTable();
+    _out_sdt = OutputTable();
+    _out_nit = OutputTable();
+    _out_bats.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the origin of entries in the output merged tables.
+//----------------------------------------------------------------------------
+
+std::optional<ts::PSIMerger::Origin> ts::PSIMerger::serviceOrigin(uint16_t service_id) const
+{
+    auto it = _out_pat.origins.find(service_id);
+    if (it != _out_pat.origins.end()) {
+        return it->second;
+    }
+    it = _out_sdt.origins.find(service_id);
+    if (it != _out_sdt.origins.end()) {
+        return it->second;
+    }
+    return std::nullopt;
+}
+
+std::optional<ts::PSIMerger::Origin> ts::PSIMerger::emmOrigin(PID pid) const
+{
+    const auto it = _out_cat.origins.find(pid);
+    return it == _out_cat.origins.end() ? std::nullopt : std::make_optional(it->second);
+}
+
+bool ts::PSIMerger::OutputTable::isMerged(uint16_t id) const
+{
+    const auto it = origins.find(id);
+    return it != origins.end() && it->second == Origin::MERGED;
 }
 
 
@@ -411,7 +453,7 @@ void ts::PSIMerger::handleMainTable(const BinaryTable& table)
             const PAT pat(_duck, table);
             if (pat.isValid() && table.sourcePID() == PID_PAT) {
                 _main_tsid = pat.ts_id;
-                copyTableKeepVersion(_main_pat, pat);
+                _main_pat = pat;
                 mergePAT();
             }
             break;
@@ -419,7 +461,7 @@ void ts::PSIMerger::handleMainTable(const BinaryTable& table)
         case TID_CAT: {
             const CAT cat(_duck, table);
             if (cat.isValid() && table.sourcePID() == PID_CAT) {
-                copyTableKeepVersion(_main_cat, cat);
+                _main_cat = cat;
                 mergeCAT();
             }
             break;
@@ -427,7 +469,7 @@ void ts::PSIMerger::handleMainTable(const BinaryTable& table)
         case TID_NIT_ACT: {
             const NIT nit(_duck, table);
             if (nit.isValid() && table.sourcePID() == PID_NIT) {
-                copyTableKeepVersion(_main_nit, nit);
+                _main_nit = nit;
                 mergeNIT();
             }
             break;
@@ -444,7 +486,7 @@ void ts::PSIMerger::handleMainTable(const BinaryTable& table)
             const SDT sdt(_duck, table);
             if (sdt.isValid() && table.sourcePID() == PID_SDT) {
                 _main_tsid = sdt.ts_id;
-                copyTableKeepVersion(_main_sdt, sdt);
+                _main_sdt = sdt;
                 mergeSDT();
             }
             break;
@@ -460,13 +502,7 @@ void ts::PSIMerger::handleMainTable(const BinaryTable& table)
         case TID_BAT: {
             const BAT bat(_duck, table);
             if (bat.isValid() && table.sourcePID() == PID_BAT) {
-                if (!_main_bats.contains(bat.bouquet_id)) {
-                    // No previous BAT for this bouquet.
-                    _main_bats[bat.bouquet_id] = bat;
-                }
-                else {
-                    copyTableKeepVersion(_main_bats[bat.bouquet_id], bat);
-                }
+                _main_bats[bat.bouquet_id] = bat;
                 mergeBAT(bat.bouquet_id);
             }
             break;
@@ -534,6 +570,50 @@ void ts::PSIMerger::handleMergeTable(const BinaryTable& table)
 }
 
 
+//----------------------------------------------------------------------------
+// Replace a merged table in a packetizer, only when its content changed.
+//----------------------------------------------------------------------------
+
+bool ts::PSIMerger::updateOutput(OutputTable& out, const AbstractLongTable& table, const OriginMap& origins, CyclingPacketizer& pzer, const UChar* entry_name)
+{
+    const UString name(TIDName(_duck, table.tableId()));
+
+    // Report entries from the merged stream which are no longer present.
+    for (const auto& it : out.origins) {
+        if (it.second == Origin::MERGED && !origins.contains(it.first)) {
+            _duck.report().verbose(u"removing %s %n from %s, no longer in merged stream", entry_name, it.first, name);
+        }
+    }
+    out.origins = origins;
+
+    BinaryTable bin;
+    if (!table.serialize(_duck, bin) || !bin.isValid()) {
+        _duck.report().error(u"error serializing merged %s", name);
+        return false;
+    }
+
+    if (!out.table.isValid()) {
+        // First output table, the version is the next one after the main input table.
+        bin.setVersion((table.version() + 1) & SVERSION_MASK);
+    }
+    else {
+        // Compare with the previous output table, using the same version.
+        bin.setVersion(out.table.version());
+        if (bin == out.table) {
+            _duck.report().debug(u"merged %s unchanged, keeping version %d", name, out.table.version());
+            return false;
+        }
+        bin.setVersion((out.table.version() + 1) & SVERSION_MASK);
+        pzer.removeSections(out.table.tableId(), out.table.tableIdExtension());
+    }
+
+    _duck.report().debug(u"new merged %s, version %d, %d sections", name, bin.version(), bin.sectionCount());
+    pzer.addTable(bin);
+    out.table = std::move(bin);
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Merge the PAT's and build a new one into the packetizer.
 //----------------------------------------------------------------------------
@@ -547,9 +627,12 @@ void ts::PSIMerger::mergePAT()
 
     _duck.report().debug(u"merging PAT");
 
-    // Build a new PAT based on last main PAT with incremented version number.
+    // Build a new PAT based on last main PAT.
     PAT pat(_main_pat);
-    pat.incrementVersion();
+    OriginMap origins;
+    for (const auto& main : pat.pmts) {
+        origins[main.first] = Origin::MAIN;
+    }
 
     // Add all services from merged stream into main PAT.
     for (const auto& merge : _merge_pat.pmts) {
@@ -559,16 +642,15 @@ void ts::PSIMerger::mergePAT()
         }
         else {
             pat.pmts[merge.first] = merge.second;
-            _duck.report().verbose(u"adding service %n in PAT from merged stream", merge.first);
+            origins[merge.first] = Origin::MERGED;
+            if (!_out_pat.isMerged(merge.first)) {
+                _duck.report().verbose(u"adding service %n in PAT from merged stream", merge.first);
+            }
         }
     }
 
-    // Replace the PAT in the packetizer.
-    _pat_pzer.removeSections(TID_PAT);
-    _pat_pzer.addTable(_duck, pat);
-
-    // Save PAT version number for later increment.
-    _main_pat.setVersion(pat.version());
+    // Replace the PAT in the packetizer if modified.
+    updateOutput(_out_pat, pat, origins, _pat_pzer, u"service");
 }
 
 
@@ -585,9 +667,13 @@ void ts::PSIMerger::mergeCAT()
 
     _duck.report().debug(u"merging CAT");
 
-    // Build a new CAT based on last main CAT with incremented version number.
+    // Build a new CAT based on last main CAT.
     CAT cat(_main_cat);
-    cat.incrementVersion();
+    OriginMap origins;
+    for (size_t index = _main_cat.descs.search(DID_MPEG_CA); index < _main_cat.descs.count(); index = _main_cat.descs.search(DID_MPEG_CA, index + 1)) {
+        const CADescriptor ca(_duck, _main_cat.descs[index]);
+        origins[ca.ca_pid] = Origin::MAIN;
+    }
 
     // Add all CA descriptors from merged stream into main CAT.
     for (size_t index = _merge_cat.descs.search(DID_MPEG_CA); index < _merge_cat.descs.count(); index = _merge_cat.descs.search(DID_MPEG_CA, index + 1)) {
@@ -598,16 +684,15 @@ void ts::PSIMerger::mergeCAT()
         }
         else {
             cat.descs.add(_merge_cat.descs[index]);
-            _duck.report().verbose(u"adding EMM PID %n in CAT from merged stream", ca.ca_pid);
+            origins[ca.ca_pid] = Origin::MERGED;
+            if (!_out_cat.isMerged(ca.ca_pid)) {
+                _duck.report().verbose(u"adding EMM PID %n in CAT from merged stream", ca.ca_pid);
+            }
         }
     }
 
-    // Replace the CAT in the packetizer.
-    _cat_pzer.removeSections(TID_CAT);
-    _cat_pzer.addTable(_duck, cat);
-
-    // Save CAT version number for later increment.
-    _main_cat.setVersion(cat.version());
+    // Replace the CAT in the packetizer if modified.
+    updateOutput(_out_cat, cat, origins, _cat_pzer, u"EMM PID");
 }
 
 
@@ -624,9 +709,12 @@ void ts::PSIMerger::mergeSDT()
 
     _duck.report().debug(u"merging SDT");
 
-    // Build a new SDT based on last main SDT with incremented version number.
+    // Build a new SDT based on last main SDT.
     SDT sdt(_main_sdt);
-    sdt.incrementVersion();
+    OriginMap origins;
+    for (const auto& main : sdt.services) {
+        origins[main.first] = Origin::MAIN;
+    }
 
     // Add all services from merged stream into main SDT.
     for (const auto& merge : _merge_sdt.services) {
@@ -636,16 +724,15 @@ void ts::PSIMerger::mergeSDT()
         }
         else {
             sdt.services[merge.first] = merge.second;
-            _duck.report().verbose(u"adding service \"%s\", id %n in SDT from merged stream", merge.second.serviceName(_duck), merge.first);
+            origins[merge.first] = Origin::MERGED;
+            if (!_out_sdt.isMerged(merge.first)) {
+                _duck.report().verbose(u"adding service \"%s\", id %n in SDT from merged stream", merge.second.serviceName(_duck), merge.first);
+            }
         }
     }
 
-    // Replace the SDT in the packetizer.
-    _sdt_bat_pzer.removeSections(TID_SDT_ACT, sdt.ts_id);
-    _sdt_bat_pzer.addTable(_duck, sdt);
-
-    // Save SDT version number for later increment.
-    _main_sdt.setVersion(sdt.version());
+    // Replace the SDT in the packetizer if modified.
+    updateOutput(_out_sdt, sdt, origins, _sdt_bat_pzer, u"service");
 }
 
 
@@ -665,9 +752,8 @@ void ts::PSIMerger::mergeNIT()
 
     _duck.report().debug(u"merging NIT");
 
-    // Build a new NIT based on last main NIT with incremented version number.
+    // Build a new NIT based on last main NIT.
     NIT nit(_main_nit);
-    nit.incrementVersion();
 
     // If the two TS are from the same network and have distinct TS ids, remove the
     // description of the merged TS since it is now merged.
@@ -687,12 +773,8 @@ void ts::PSIMerger::mergeNIT()
         nit.transports[main_tsid].descs.add(merge_ts->second.descs);
     }
 
-    // Replace the NIT in the packetizer.
-    _nit_pzer.removeSections(TID_NIT_ACT, nit.network_id);
-    _nit_pzer.addTable(_duck, nit);
-
-    // Save NIT version number for later increment.
-    _main_nit.setVersion(nit.version());
+    // Replace the NIT in the packetizer if modified. The transport streams are not tracked by origin.
+    updateOutput(_out_nit, nit, OriginMap(), _nit_pzer, u"transport stream");
 }
 
 
@@ -716,9 +798,8 @@ void ts::PSIMerger::mergeBAT(uint16_t bouquet_id)
 
     _duck.report().debug(u"merging BAT for bouquet id %n", bouquet_id);
 
-    // Build a new BAT based on last main BAT with incremented version number.
+    // Build a new BAT based on last main BAT.
     BAT bat(main->second);
-    bat.incrementVersion();
 
     // If the two TS have distinct TS ids, remove the description of the merged TS since it is now merged.
     if (main_tsid != merge_tsid) {
@@ -737,10 +818,6 @@ void ts::PSIMerger::mergeBAT(uint16_t bouquet_id)
         bat.transports[main_tsid].descs.add(merge_ts->second.descs);
     }
 
-    // Replace the BAT in the packetizer.
-    _sdt_bat_pzer.removeSections(TID_BAT, bouquet_id);
-    _sdt_bat_pzer.addTable(_duck, bat);
-
-    // Save NIT version number for later increment.
-    main->second.setVersion(bat.version());
+    // Replace the BAT in the packetizer if modified. The transport streams are not tracked by origin.
+    updateOutput(_out_bats[bouquet_id], bat, OriginMap(), _sdt_bat_pzer, u"transport stream");
 }
@@ -45,6 +45,12 @@ namespace ts {
     //! mixed stream of EIT's is written in replacement of the EIT streams from
     //! the two streams.
     //!
+    //! The merged tables are regenerated incrementally. The origin of each entry
+    //! (service, EMM PID) in a merged table is recorded. When an input table changes,
+    //! the merged table is rebuilt and compared with the previous output. It is
+    //! replaced in the packetizer and its version is incremented only when its
+    //! content actually changed.
+    //!
     class TSDUCKDLL PSIMerger:
         private TableHandlerInterface,
         private SectionHandlerInterface,
@@ -80,6 +86,28 @@ namespace ts {
         //!
         explicit PSIMerger(DuckContext& duck, Options options = DEFAULT);
 
+        //!
+        //! Origin of an entry in a merged table.
+        //!
+        enum class Origin {
+            MAIN,    //!< The entry comes from the main stream.
+            MERGED,  //!< The entry comes from the merged stream.
+        };
+
+        //!
+        //! Get the origin of a service in the output merged PAT or SDT.
+        //! @param [in] service_id Service id.
+        //! @return The origin of the service or no value if the service is not in the output merged PAT or SDT.
+        //!
+        std::optional<Origin> serviceOrigin(uint16_t service_id) const;
+
+        //!
+        //! Get the origin of an EMM PID in the output merged CAT.
+        //! @param [in] pid EMM PID.
+        //! @return The origin of the EMM PID or no value if the EMM PID is not in the output merged CAT.
+        //!
+        std::optional<Origin> emmOrigin(PID pid) const;
+
         //!
         //! Feed a packet from the main stream.
         //! @param [in,out] pkt A packet from the first stream. When the packet contains tables to merge, it is replaced.
@@ -109,6 +137,20 @@ namespace ts {
         void reset(Options options);
 
     private:
+        // Origin of each entry in a merged table, indexed by service id or EMM PID.
+        using OriginMap = std::map<uint16_t, Origin>;
+
+        // Description of the last output merged table.
+        class OutputTable
+        {
+        public:
+            BinaryTable table {};    // Last output table, invalid if not yet generated (version# is current output version).
+            OriginMap   origins {};  // Origin of each entry in the output table.
+
+            // Check if an entry comes from the merged stream.
+            bool isMerged(uint16_t id) const;
+        };
+
         DuckContext&       _duck;                                    // Reference to TSDuck context.
         Options            _options = DEFAULT;                       // Merging options.
         SectionDemux       _main_demux {_duck, this};                // Demux on main transport stream. Complete table handler only.
@@ -121,16 +163,21 @@ namespace ts {
         CyclingPacketizer  _sdt_bat_pzer {_duck};                    // Packetizer for modified SDT/BAT in main TS.
         Packetizer         _eit_pzer {_duck, PID_EIT, this};         // Packetizer for the mixed EIT's.
         std::optional<uint16_t> _main_tsid {};     // TS id of the main stream.
-        PAT                     _main_pat {};      // Last input PAT from main TS (version# is current output version).
+        PAT                     _main_pat {};      // Last input PAT from main TS.
         PAT                     _merge_pat {};     // Last input PAT from merged TS.
-        CAT                     _main_cat {};      // Last input CAT from main TS (version# is current output version).
+        CAT                     _main_cat {};      // Last input CAT from main TS.
         CAT                     _merge_cat {};     // Last input CAT from merged TS.
-        SDT                     _main_sdt {};      // Last input SDT Actual from main TS (version# is current output version).
+        SDT                     _main_sdt {};      // Last input SDT Actual from main TS.
         SDT                     _merge_sdt {};     // Last input SDT Actual from merged TS.
-        NIT                     _main_nit {};      // Last input NIT Actual from main TS (version# is current output version).
+        NIT                     _main_nit {};      // Last input NIT Actual from main TS.
         NIT                     _merge_nit {};     // Last input NIT Actual from merged TS.
-        std::map<uint16_t, BAT> _main_bats {};     // Map of last input BAT/bouquet_it from main TS (version# is current output version).
+        std::map<uint16_t, BAT> _main_bats {};     // Map of last input BAT/bouquet_it from main TS.
         std::map<uint16_t, BAT> _merge_bats {};    // Map of last input BAT/bouquet_it from merged TS.
+        OutputTable             _out_pat {};       // Last output merged PAT.
+        OutputTable             _out_cat {};       // Last output merged CAT.
+        OutputTable             _out_sdt {};       // Last output merged SDT Actual.
+        OutputTable             _out_nit {};       // Last output merged NIT Actual.
+        std::map<uint16_t, OutputTable> _out_bats {};  // Map of last output merged BAT/bouquet_it.
         std::list<SectionPtr>   _eits {};          // List of EIT sections to insert.
         size_t                  _max_eits = 128;   // Maximum number of buffered EIT sections (hard-coded for now).
 
@@ -166,18 +213,11 @@ namespace ts {
         void mergeNIT();
         void mergeBAT(uint16_t bouquet_id);
 
-        // Copy a table into another, preserving the previous version number if the table is valid.
-        template<class TABLE>
-            requires std::derived_from<TABLE, AbstractLongTable>
-        void copyTableKeepVersion(TABLE& dest, const TABLE& src)
-        {
-            const bool was_valid = dest.isValid();
-            const uint8_t version = dest.version();
-            dest = src;
-            if (was_valid) {
-                dest.setVersion(version);
-            }
-        }
+        // Replace a merged table in a packetizer, only when its content changed.
+        // The version of the new table is the next version of the previous output table.
+        // The origins of the entries replace the previous ones. Removed merged entries are logged.
+        // Return true when the table was replaced in the packetizer.
+        bool updateOutput(OutputTable& out, const AbstractLongTable& table, const OriginMap& origins, CyclingPacketizer& pzer, const UChar* entry_name);
     };
 }
 
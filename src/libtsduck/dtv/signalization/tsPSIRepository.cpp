@@ -15,6 +15,16 @@
 
 TS_DEFINE_SINGLETON(ts::PSIRepository);
 
+// Queue of registrations, until the repository is built. The registration instances
+// are static objects. Everything here is statically initialized, before the first
+// registration instance is constructed.
+namespace {
+    std::mutex queue_mutex;
+    ts::PSIRepository::Registrar* queue_first = nullptr;
+    ts::PSIRepository::Registrar* queue_last = nullptr;
+    bool repository_built = false;
+}
+
 
 //----------------------------------------------------------------------------
 // Repository singleton constructor.
@@ -23,6 +33,7 @@ TS_DEFINE_SINGLETON(ts::PSIRepository);
 ts::PSIRepository::PSIRepository()
 {
     CERR.debug(u"creating PSIRepository");
+    const monotonic_time start = monotonic_time::clock::now();
 
     // Load all table names from a ".names" file.
     const NamesPtr tid_repo = Names::GetSection(u"dtv", u"TableId", true);
@@ -33,6 +44,66 @@ ts::PSIRepository::PSIRepository()
     // Subscribe to further modifications (merge of extension files).
     tid_repo->subscribe(this);
     did_repo->subscribe(this);
+
+    // Apply all queued registrations, in registration order. All subsequent registrations
+    // are directly applied by the registration instances, after the end of this constructor.
+    size_t count = 0;
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    while (queue_first != nullptr) {
+        Registrar* reg = queue_first;
+        queue_first = reg->_next;
+        reg->_next = nullptr;
+        reg->_queued = false;
+        reg->apply(*this);
+        count++;
+    }
+    queue_last = nullptr;
+    repository_built = true;
+
+    CERR.debug(u"PSIRepository created with %d registrations in %s", count, cn::duration_cast<cn::microseconds>(monotonic_time::clock::now() - start));
+}
+
+
+//----------------------------------------------------------------------------
+// Registration base class.
+//----------------------------------------------------------------------------
+
+void ts::PSIRepository::Registrar::enqueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (!repository_built) {
+            // Queue the registration, it will be applied when the repository is built.
+            _queued = true;
+            if (queue_last == nullptr) {
+                queue_first = this;
+            }
+            else {
+                queue_last->_next = this;
+            }
+            queue_last = this;
+            return;
+        }
+    }
+    // The repository is already built, apply the registration now.
+    apply(PSIRepository::Instance());
+}
+
+ts::PSIRepository::Registrar::~Registrar()
+{
+    // Remove a queued registration from a shared library which is unloaded before the repository is built.
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    if (_queued) {
+        Registrar* prev = nullptr;
+        for (Registrar* reg = queue_first; reg != nullptr && reg != this; reg = reg->_next) {
+            prev = reg;
+        }
+        (prev == nullptr ? queue_first : prev->_next) = _next;
+        if (queue_last == this) {
+            queue_last = prev;
+        }
+        _queued = false;
+    }
 }
 
 
@@ -40,10 +111,16 @@ ts::PSIRepository::PSIRepository()
 // Constructors to register extension files.
 //----------------------------------------------------------------------------
 
-ts::PSIRepository::RegisterXML::RegisterXML(const UString& file_name)
+ts::PSIRepository::RegisterXML::RegisterXML(const UString& file_name) :
+    _file_name(file_name)
+{
+    enqueue();
+}
+
+void ts::PSIRepository::RegisterXML::apply(PSIRepository& repo) const
 {
-    CERR.debug(u"registering XML file %s", file_name);
-    PSIRepository::Instance()._xml_extension_files.push_back(file_name);
+    CERR.debug(u"registering XML file %s", _file_name);
+    repo._xml_extension_files.push_back(_file_name);
 }
 
 
@@ -126,21 +203,47 @@ ts::PSIRepository::RegisterTable::RegisterTable(TableFactory factory,
                                                 LogSectionFunction log,
                                                 std::initializer_list<PID> pids,
                                                 CASID min_cas,
-                                                CASID max_cas)
+                                                CASID max_cas) :
+    _factory(factory),
+    _index(index),
+    _tids(tids),
+    _standards(standards),
+    _xml_name(xml_name),
+    _display(display),
+    _log(log),
+    _pids(pids),
+    _min_cas(min_cas),
+    _max_cas(max_cas)
 {
-    CERR.log(2, u"registering table <%s>", xml_name);
-    PSIRepository& repo(PSIRepository::Instance());
+    enqueue();
+}
+
+ts::PSIRepository::RegisterTable::RegisterTable(const std::vector<TID>& tids,
+                                                Standards standards,
+                                                DisplaySectionFunction display,
+                                                LogSectionFunction log,
+                                                std::initializer_list<PID> pids,
+                                                CASID min_cas,
+                                                CASID max_cas) :
+    // Use the complete constructor for actual registration.
+    RegisterTable(nullptr, NullIndex(), tids, standards, UString(), display, log, pids, min_cas, max_cas)
+{
+}
+
+void ts::PSIRepository::RegisterTable::apply(PSIRepository& repo) const
+{
+    CERR.log(2, u"registering table <%s>", _xml_name);
     bool xml_done = false;
 
     // Separately store each TID. They may not hold the same content in the end (eg. distinct display names for EIT).
-    for (auto tid : tids) {
+    for (auto tid : _tids) {
         TableClassPtr tc;
 
         // Search an existing entry.
         const auto bounds(repo._tables_by_tid.equal_range(tid));
         for (auto it = bounds.first; tc == nullptr && it != bounds.second; ++it) {
             const auto& tc1(it->second);
-            if ((standards == tc1->standards || bool(standards & tc1->standards)) && min_cas >= tc1->min_cas && max_cas <= tc1->max_cas) {
+            if ((_standards == tc1->standards || bool(_standards & tc1->standards)) && _min_cas >= tc1->min_cas && _max_cas <= tc1->max_cas) {
                 // Found a compatible entry.
                 tc = tc1;
             }
@@ -153,36 +256,24 @@ ts::PSIRepository::RegisterTable::RegisterTable(TableFactory factory,
         }
 
         // Fill the entry with new data.
-        tc->index = index;
-        tc->standards = standards;
-        tc->min_cas = min_cas;
-        tc->max_cas = max_cas;
-        tc->factory = factory;
-        tc->display = display;
-        tc->log = log;
-        tc->xml_name = xml_name;
-        tc->pids.insert(pids);
+        tc->index = _index;
+        tc->standards = _standards;
+        tc->min_cas = _min_cas;
+        tc->max_cas = _max_cas;
+        tc->factory = _factory;
+        tc->display = _display;
+        tc->log = _log;
+        tc->xml_name = _xml_name;
+        tc->pids.insert(_pids.begin(), _pids.end());
 
         // Store the first description as XML name.
-        if (!xml_done && !xml_name.empty()) {
+        if (!xml_done && !_xml_name.empty()) {
             xml_done = true;
-            repo._tables_by_xml_name.insert(std::make_pair(xml_name, tc));
+            repo._tables_by_xml_name.insert(std::make_pair(_xml_name, tc));
         }
     }
 }
 
-ts::PSIRepository::RegisterTable::RegisterTable(const std::vector<TID>& tids,
-                                                Standards standards,
-                                                DisplaySectionFunction display,
-                                                LogSectionFunction log,
-                                                std::initializer_list<PID> pids,
-                                                CASID min_cas,
-                                                CASID max_cas)
-{
-    // Use the complete constructor for actual registration.
-    RegisterTable reg(nullptr, NullIndex(), tids, standards, UString(), display, log, pids, min_cas, max_cas);
-}
-
 
 //----------------------------------------------------------------------------
 // Constructors to register a fully or partially implemented descriptor.
@@ -193,16 +284,45 @@ ts::PSIRepository::RegisterDescriptor::RegisterDescriptor(DescriptorFactory fact
                                                           const EDID& edid,
                                                           const UString& xml_name,
                                                           DisplayDescriptorFunction display,
-                                                          const UString& legacy_xml_name)
+                                                          const UString& legacy_xml_name) :
+    _factory(factory),
+    _index(index),
+    _edid(edid),
+    _xml_name(xml_name),
+    _display(display),
+    _legacy_xml_name(legacy_xml_name)
+{
+    enqueue();
+}
+
+ts::PSIRepository::RegisterDescriptor::RegisterDescriptor(DisplayCADescriptorFunction display, CASID min_cas, CASID max_cas) :
+    _ca_display(display),
+    _min_cas(min_cas),
+    _max_cas(max_cas)
+{
+    if (display != nullptr) {
+        enqueue();
+    }
+}
+
+void ts::PSIRepository::RegisterDescriptor::apply(PSIRepository& repo) const
 {
-    CERR.log(2, u"registering descriptor <%s>", xml_name);
-    PSIRepository& repo(PSIRepository::Instance());
+    // Registration of a CA_descriptor display function.
+    if (_ca_display != nullptr) {
+        CASID cas = _min_cas;
+        do {
+            repo._casid_descriptor_displays.insert(std::make_pair(cas, _ca_display));
+        } while (cas++ < _max_cas);
+        return;
+    }
+
+    CERR.log(2, u"registering descriptor <%s>", _xml_name);
     DescriptorClassPtr dc;
 
     // Search an existing entry.
-    const auto bounds(repo._descriptors_by_xdid.equal_range(edid.xdid()));
+    const auto bounds(repo._descriptors_by_xdid.equal_range(_edid.xdid()));
     for (auto it = bounds.first; it != bounds.second; ++it) {
-        if (it->second->edid == edid) {
+        if (it->second->edid == _edid) {
             // Found a compatible entry.
             dc = it->second;
         }
@@ -211,48 +331,38 @@ ts::PSIRepository::RegisterDescriptor::RegisterDescriptor(DescriptorFactory fact
     // Build a new entry if none found.
     if (dc == nullptr) {
         dc = std::make_shared<DescriptorClass>();
-        repo._descriptors_by_xdid.insert(std::make_pair(edid.xdid(), dc));
+        repo._descriptors_by_xdid.insert(std::make_pair(_edid.xdid(), dc));
     }
 
     // Build a description for this descriptor.
-    dc->index = index;
-    dc->edid = edid;
-    dc->factory = factory;
-    dc->display = display;
-    dc->xml_name = xml_name;
+    dc->index = _index;
+    dc->edid = _edid;
+    dc->factory = _factory;
+    dc->display = _display;
+    dc->xml_name = _xml_name;
 
     // Store the descriptor description.
-    repo._descriptors_by_type_index.insert(std::make_pair(index, dc));
+    repo._descriptors_by_type_index.insert(std::make_pair(_index, dc));
 
     // Associate XML names with descriptor classes and allowed table ids.
-    if (!xml_name.empty()) {
-        repo._descriptors_by_xml_name.insert(std::make_pair(xml_name, dc));
+    if (!_xml_name.empty()) {
+        repo._descriptors_by_xml_name.insert(std::make_pair(_xml_name, dc));
     }
-    if (!legacy_xml_name.empty()) {
-        repo._descriptors_by_xml_name.insert(std::make_pair(legacy_xml_name, dc));
+    if (!_legacy_xml_name.empty()) {
+        repo._descriptors_by_xml_name.insert(std::make_pair(_legacy_xml_name, dc));
     }
-    if (edid.isTableSpecific()) {
-        for (TID tid : edid.tableIds()) {
-            if (!xml_name.empty()) {
-                repo._descriptor_tids.insert(std::make_pair(xml_name, tid));
+    if (_edid.isTableSpecific()) {
+        for (TID tid : _edid.tableIds()) {
+            if (!_xml_name.empty()) {
+                repo._descriptor_tids.insert(std::make_pair(_xml_name, tid));
             }
-            if (!legacy_xml_name.empty()) {
-                repo._descriptor_tids.insert(std::make_pair(legacy_xml_name, tid));
+            if (!_legacy_xml_name.empty()) {
+                repo._descriptor_tids.insert(std::make_pair(_legacy_xml_name, tid));
             }
         }
     }
 }
 
-ts::PSIRepository::RegisterDescriptor::RegisterDescriptor(DisplayCADescriptorFunction display, CASID min_cas, CASID max_cas)
-{
-    if (display != nullptr) {
-        PSIRepository& repo(PSIRepository::Instance());
-        do {
-            repo._casid_descriptor_displays.insert(std::make_pair(min_cas, display));
-        } while (min_cas++ < max_cas);
-    }
-}
-
 
 //----------------------------------------------------------------------------
 // Signalization classes.
@@ -34,6 +34,13 @@ namespace ts {
     //! single thread). Then, the singleton is only read during the execution of the
     //! application. So, no explicit synchronization is required.
     //!
+    //! Lazy construction: The static registration instances do not access the repository.
+    //! They are only queued, without any processing. The repository is built and all queued
+    //! registrations are applied on the first call to Instance(). Therefore, an application
+    //! which never uses tables or descriptors does not pay the cost of the repository.
+    //! Registrations which occur after the construction of the singleton (typically when a
+    //! shared library is dynamically loaded) are immediately applied.
+    //!
     //! Mixed ISDB-DVB compatibility. ISDB is based on a subset of DVB and adds other tables and
     //! descriptors. The DVB subset is compatible with ISDB. When another DID or TID is defined
     //! with two distinct semantics, one for DVB and one for ISDB, if ISDB is part of the current
@@ -243,12 +250,50 @@ namespace ts {
         //!
         void getRegisteredTablesModels(UStringList& names) const;
 
+        //!
+        //! Base class of all registration classes.
+        //! Registration instances are queued until the construction of the repository.
+        //!
+        class TSDUCKDLL Registrar
+        {
+            TS_NOCOPY(Registrar);
+        public:
+            //!
+            //! Destructor.
+            //! If the registration is still queued, it is removed from the queue.
+            //!
+            virtual ~Registrar();
+
+        protected:
+            //!
+            //! Default constructor.
+            //!
+            Registrar() = default;
+
+            //!
+            //! Queue the registration or apply it when the repository is already built.
+            //! Must be called at the end of the constructor of the concrete subclasses.
+            //!
+            void enqueue();
+
+            //!
+            //! Apply the registration in the repository.
+            //! @param [in,out] repo The repository to update.
+            //!
+            virtual void apply(PSIRepository& repo) const = 0;
+
+        private:
+            friend class PSIRepository;
+            Registrar* _next = nullptr;  // Next registration in the queue.
+            bool       _queued = false;  // The registration is in the queue.
+        };
+
         //!
         //! A class to register fully implemented tables.
         //! The registration is performed using constructors.
         //! Thus, it is possible to perform a registration in the declaration of a static object.
         //!
-        class TSDUCKDLL RegisterTable
+        class TSDUCKDLL RegisterTable : public Registrar
         {
             TS_NOBUILD_NOCOPY(RegisterTable);
         public:
@@ -295,6 +340,22 @@ namespace ts {
                           std::initializer_list<PID> pids = {},
                           CASID min_cas = CASID_NULL,
                           CASID max_cas = CASID_NULL);
+
+        protected:
+            // Inherited methods.
+            virtual void apply(PSIRepository& repo) const override;
+
+        private:
+            TableFactory           _factory = nullptr;
+            std::type_index        _index = NullIndex();
+            std::vector<TID>       _tids {};
+            Standards              _standards = Standards::NONE;
+            UString                _xml_name {};
+            DisplaySectionFunction _display = nullptr;
+            LogSectionFunction     _log = nullptr;
+            std::vector<PID>       _pids {};
+            CASID                  _min_cas = CASID_NULL;
+            CASID                  _max_cas = CASID_NULL;
         };
 
         //!
@@ -302,7 +363,7 @@ namespace ts {
         //! The registration is performed using constructors.
         //! Thus, it is possible to perform a registration in the declaration of a static object.
         //!
-        class TSDUCKDLL RegisterDescriptor
+        class TSDUCKDLL RegisterDescriptor : public Registrar
         {
             TS_NOBUILD_NOCOPY(RegisterDescriptor);
         public:
@@ -332,6 +393,21 @@ namespace ts {
             //! @see TS_REGISTER_CA_DESCRIPTOR
             //!
             RegisterDescriptor(DisplayCADescriptorFunction display, CASID min_cas, CASID max_cas = CASID_NULL);
+
+        protected:
+            // Inherited methods.
+            virtual void apply(PSIRepository& repo) const override;
+
+        private:
+            DescriptorFactory           _factory = nullptr;
+            std::type_index             _index = NullIndex();
+            EDID                        _edid {};
+            UString                     _xml_name {};
+            DisplayDescriptorFunction   _display = nullptr;
+            UString                     _legacy_xml_name {};
+            DisplayCADescriptorFunction _ca_display = nullptr;
+            CASID                       _min_cas = CASID_NULL;
+            CASID                       _max_cas = CASID_NULL;
         };
 
         //!
@@ -339,7 +415,7 @@ namespace ts {
         //! The registration is performed using constructors.
         //! Thus, it is possible to perform a registration in the declaration of a static object.
         //!
-        class TSDUCKDLL RegisterXML
+        class TSDUCKDLL RegisterXML : public Registrar
         {
             TS_NOBUILD_NOCOPY(RegisterXML);
         public:
@@ -353,6 +429,13 @@ namespace ts {
             //! @see TS_REGISTER_XML_FILE
             //!
             RegisterXML(const UString& file_name);
+
+        protected:
+            // Inherited methods.
+            virtual void apply(PSIRepository& repo) const override;
+
+        private:
+            UString _file_name {};
         };
 
         //!
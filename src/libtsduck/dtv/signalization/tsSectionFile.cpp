@@ -13,6 +13,7 @@
 #include "tsDuckContext.h"
 #include "tsxmlElement.h"
 #include "tsxmlJSONConverter.h"
+#include "tsxmlStreamParser.h"
 #include "tsjsonNull.h"
 #include "tsEIT.h"
 
@@ -530,23 +531,46 @@ bool ts::SectionFile::LoadModel(xml::Document& doc, bool load_extensions)
 
 bool ts::SectionFile::loadXML(const UString& file_name)
 {
-    xml::Document doc(_report);
-    doc.setTweaks(_xmlTweaks);
-    return doc.load(file_name, false) && parseDocument(doc);
+    xml::StreamParser parser(_report, this);
+    return startStream(parser) && parser.load(file_name, false) && _xml_success;
 }
 
 bool ts::SectionFile::loadXML(std::istream& strm)
 {
-    xml::Document doc(_report);
-    doc.setTweaks(_xmlTweaks);
-    return doc.load(strm) && parseDocument(doc);
+    xml::StreamParser parser(_report, this);
+    return startStream(parser) && parser.load(strm) && _xml_success;
 }
 
 bool ts::SectionFile::parseXML(const UString& xml_content)
 {
-    xml::Document doc(_report);
-    doc.setTweaks(_xmlTweaks);
-    return doc.parse(xml_content) && parseDocument(doc);
+    xml::StreamParser parser(_report, this);
+    return startStream(parser) && parser.parse(xml_content) && _xml_success;
+}
+
+bool ts::SectionFile::startStream(xml::StreamParser& parser)
+{
+    // Load the XML model for TSDuck files, if not already done.
+    if (!loadThisModel()) {
+        return false;
+    }
+    parser.setTweaks(_xmlTweaks);
+    _xml_success = true;
+    return true;
+}
+
+bool ts::SectionFile::handleXMLRoot(xml::StreamParser&, const xml::Element& root)
+{
+    // Invalid root: abort parsing.
+    return _model.validateRoot(&root);
+}
+
+bool ts::SectionFile::handleXMLElement(xml::StreamParser& parser, const xml::Element& element)
+{
+    // Validate and build each table as soon as it is parsed. In case of error, continue with next table.
+    if (!_model.validateTopLevel(&element) || !parseTable(&element, parser.report())) {
+        _xml_success = false;
+    }
+    return true;
 }
 
 bool ts::SectionFile::parseDocument(const xml::Document& doc)
@@ -567,18 +591,24 @@ bool ts::SectionFile::parseDocument(const xml::Document& doc)
 
     // Analyze all tables in the document.
     for (const xml::Element* node = root == nullptr ? nullptr : root->firstChildElement(); node != nullptr; node = node->nextSiblingElement()) {
-        BinaryTablePtr bin = std::make_shared<BinaryTable>();
-        if (bin->fromXML(_duck, node) && bin->isValid()) {
-            add(bin);
-        }
-        else {
-            doc.report().error(u"Error in table <%s> at line %d", node->name(), node->lineNumber());
-            success = false;
-        }
+        success = parseTable(node, doc.report()) && success;
     }
     return success;
 }
 
+bool ts::SectionFile::parseTable(const xml::Element* node, Report& report)
+{
+    BinaryTablePtr bin = std::make_shared<BinaryTable>();
+    if (bin->fromXML(_duck, node) && bin->isValid()) {
+        add(bin);
+        return true;
+    }
+    else {
+        report.error(u"Error in table <%s> at line %d", node->name(), node->lineNumber());
+        return false;
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Create XML file or text.
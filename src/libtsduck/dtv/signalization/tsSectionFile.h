@@ -22,6 +22,7 @@
 #include "tsUString.h"
 #include "tsEITOptions.h"
 #include "tsxmlTweaks.h"
+#include "tsxmlStreamHandlerInterface.h"
 #include "tsTablesPtr.h"
 
 namespace ts {
@@ -78,7 +79,7 @@ namespace ts {
     //! Each XML node describes a complete table. As a consequence, an XML section
     //! file contains complete tables only. There is no orphan section.
     //!
-    class TSDUCKDLL SectionFile
+    class TSDUCKDLL SectionFile: private xml::StreamHandlerInterface
     {
         TS_NOBUILD_NOCOPY(SectionFile);
     public:
@@ -148,6 +149,8 @@ namespace ts {
         //!
         //! Load an XML file.
         //! The loaded tables are added to the content of this object.
+        //! The XML file is read incrementally: each table is validated and built as soon as
+        //! its XML element is complete, the complete XML document is never loaded in memory.
         //! @param [in] file_name XML file name.
         //! If the file name starts with "<?xml", this is considered as "inline XML content".
         //! If the file name is empty or "-", the standard input is used.
@@ -440,6 +443,7 @@ namespace ts {
         xml::JSONConverter   _model {_report};        // XML model for tables.
         xml::Tweaks          _xmlTweaks {};           // XML formatting and parsing tweaks.
         CRC32::Validation    _crc_op = CRC32::IGNORE; // Processing of CRC32 when loading sections.
+        bool                 _xml_success = true;     // No error while streaming an XML file.
 
         // Load the XML model in this instance, if not already done.
         bool loadThisModel();
@@ -454,6 +458,16 @@ namespace ts {
         // Parse an XML document.
         bool parseDocument(const xml::Document& doc);
 
+        // Prepare a stream parser to load tables, one at a time.
+        bool startStream(xml::StreamParser& parser);
+
+        // Build a table from an XML element.
+        bool parseTable(const xml::Element* node, Report& report);
+
+        // Implementation of xml::StreamHandlerInterface.
+        virtual bool handleXMLRoot(xml::StreamParser& parser, const xml::Element& root) override;
+        virtual bool handleXMLElement(xml::StreamParser& parser, const xml::Element& element) override;
+
         // Generate an XML document.
         bool generateDocument(xml::Document& doc) const;
 
@@ -0,0 +1,57 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsAbstractTransportListView.h"
+
+
+//----------------------------------------------------------------------------
+// Top-level descriptors, the first loop in each section.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractTransportListView::Descriptor::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    const uint8_t* const data = section.payload();
+    const size_t size = section.payloadSize();
+    if (size < 2) {
+        return false;
+    }
+    begin = data + 2;
+    end = begin + std::min<size_t>(GetUInt16(data) & 0x0FFF, size - 2);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Transport streams, the second loop in each section.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractTransportListView::Transport::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    const uint8_t* const data = section.payload();
+    const size_t size = section.payloadSize();
+    if (size < 4) {
+        return false;
+    }
+    const size_t skip = 2 + size_t(GetUInt16(data) & 0x0FFF);
+    if (skip + 2 > size) {
+        return false;
+    }
+    begin = data + skip + 2;
+    end = begin + std::min<size_t>(GetUInt16(data + skip) & 0x0FFF, size - skip - 2);
+    return true;
+}
+
+size_t ts::AbstractTransportListView::Transport::assign(const uint8_t* data, size_t max_size)
+{
+    _data = data;
+    if (max_size < 6) {
+        return 0;
+    }
+    const size_t size = 6 + size_t(GetUInt16(data + 4) & 0x0FFF);
+    return size > max_size ? 0 : size;
+}
@@ -0,0 +1,114 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Abstract base class for read-only views over binary NIT and BAT.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+
+namespace ts {
+    //!
+    //! Abstract base class for read-only views over binary NIT and BAT.
+    //! @see AbstractTableView
+    //! @ingroup libtsduck table
+    //!
+    //! The two loops of the table are iterated over all sections: the top-level descriptors
+    //! (network or bouquet descriptors) and the transport streams.
+    //!
+    class TSDUCKDLL AbstractTransportListView : public AbstractTableView
+    {
+    public:
+        //!
+        //! View over one top-level descriptor in a NIT or BAT.
+        //!
+        class TSDUCKDLL Descriptor : public DescriptorView
+        {
+        public:
+            //! @cond nodoxygen
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            //! @endcond
+        };
+
+        //!
+        //! View over one transport stream in a NIT or BAT.
+        //!
+        class TSDUCKDLL Transport
+        {
+        public:
+            //!
+            //! Get the transport stream id.
+            //! @return The transport stream id.
+            //!
+            uint16_t tsId() const { return GetUInt16(_data); }
+
+            //!
+            //! Get the original network id.
+            //! @return The original network id.
+            //!
+            uint16_t originalNetworkId() const { return GetUInt16(_data + 2); }
+
+            //!
+            //! Get the transport stream descriptors.
+            //! @return A view over the transport stream descriptors.
+            //!
+            DescriptorListView descriptors() const { return DescriptorListView(_data + 6, GetUInt16(_data + 4) & 0x0FFF); }
+
+            //! @cond nodoxygen
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            size_t assign(const uint8_t* data, size_t max_size);
+            //! @endcond
+
+        private:
+            const uint8_t* _data = nullptr;
+        };
+
+        //!
+        //! Get an iterator to the first top-level descriptor in all sections of the table.
+        //! @return An iterator to the first top-level descriptor.
+        //!
+        Iterator<Descriptor> descriptorsBegin() const { return Iterator<Descriptor>(*this); }
+
+        //!
+        //! Get an iterator after the last top-level descriptor in the table.
+        //! @return An iterator after the last top-level descriptor.
+        //!
+        Iterator<Descriptor> descriptorsEnd() const { return Iterator<Descriptor>(); }
+
+        //!
+        //! Get an iterator to the first transport stream in the table.
+        //! @return An iterator to the first transport stream.
+        //!
+        Iterator<Transport> begin() const { return Iterator<Transport>(*this); }
+
+        //!
+        //! Get an iterator after the last transport stream in the table.
+        //! @return An iterator after the last transport stream.
+        //!
+        Iterator<Transport> end() const { return Iterator<Transport>(); }
+
+    protected:
+        //!
+        //! Constructor for subclasses, from a binary table.
+        //! @param [in] table The binary table.
+        //! @param [in] min_tid Minimum valid table id.
+        //! @param [in] max_tid Maximum valid table id.
+        //!
+        AbstractTransportListView(const BinaryTable& table, TID min_tid, TID max_tid) : AbstractTableView(table, min_tid, max_tid, 4) {}
+
+        //!
+        //! Constructor for subclasses, from a single section.
+        //! @param [in] section The section.
+        //! @param [in] min_tid Minimum valid table id.
+        //! @param [in] max_tid Maximum valid table id.
+        //!
+        AbstractTransportListView(const Section& section, TID min_tid, TID max_tid) : AbstractTableView(section, min_tid, max_tid, 4) {}
+    };
+}
@@ -0,0 +1,45 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary Bouquet Association Table (BAT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTransportListView.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary Bouquet Association Table (BAT).
+    //! @see ETSI EN 300 468, 5.2.2
+    //! @see AbstractTransportListView
+    //! @ingroup libtsduck table
+    //!
+    class TSDUCKDLL BATView : public AbstractTransportListView
+    {
+    public:
+        //!
+        //! Constructor from a binary table.
+        //! @param [in] table The binary table. Must remain valid while the view is used.
+        //!
+        BATView(const BinaryTable& table) : AbstractTransportListView(table, TID_BAT, TID_BAT) {}
+
+        //!
+        //! Constructor from a section.
+        //! @param [in] section The section. Must remain valid while the view is used.
+        //!
+        BATView(const Section& section) : AbstractTransportListView(section, TID_BAT, TID_BAT) {}
+
+        //!
+        //! Get the bouquet id.
+        //! @return The bouquet id.
+        //!
+        uint16_t bouquetId() const { return tableIdExtension(); }
+    };
+}
@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITView.h"
+#include "tsMJD.h"
+#include "tsBCD.h"
+
+
+//----------------------------------------------------------------------------
+// Events in the EIT, after the fixed part.
+//----------------------------------------------------------------------------
+
+bool ts::EITView::Event::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    const size_t size = section.payloadSize();
+    if (size < EIT_PAYLOAD_FIXED_SIZE) {
+        return false;
+    }
+    begin = section.payload() + EIT_PAYLOAD_FIXED_SIZE;
+    end = section.payload() + size;
+    return true;
+}
+
+size_t ts::EITView::Event::assign(const uint8_t* data, size_t max_size)
+{
+    _data = data;
+    if (max_size < EIT_EVENT_FIXED_SIZE) {
+        return 0;
+    }
+    const size_t size = EIT_EVENT_FIXED_SIZE + size_t(GetUInt16(data + 10) & 0x0FFF);
+    return size > max_size ? 0 : size;
+}
+
+
+//----------------------------------------------------------------------------
+// Event start time and duration.
+//----------------------------------------------------------------------------
+
+bool ts::EITView::Event::startTime(Time& time) const
+{
+    return DecodeMJD(_data + 2, MJD_FULL, time);
+}
+
+cn::seconds ts::EITView::Event::duration() const
+{
+    return cn::hours(DecodeBCD(_data[7])) + cn::minutes(DecodeBCD(_data[8])) + cn::seconds(DecodeBCD(_data[9]));
+}
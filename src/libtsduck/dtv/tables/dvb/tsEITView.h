@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary Event Information Table (EIT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+#include "tsTime.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary Event Information Table (EIT).
+    //! @see ETSI EN 300 468, 5.2.4
+    //! @see AbstractTableView
+    //! @ingroup libtsduck table
+    //!
+    //! All flavors of EIT are accepted: present/following or schedule, actual or other.
+    //! The view is typically built over individual sections since the EIT schedule
+    //! sections are usually processed one by one.
+    //!
+    class TSDUCKDLL EITView : public AbstractTableView
+    {
+    public:
+        //!
+        //! Size in bytes of the fixed part of an EIT section payload.
+        //!
+        static constexpr size_t EIT_PAYLOAD_FIXED_SIZE = 6;
+
+        //!
+        //! Size in bytes of the fixed part of an event description.
+        //!
+        static constexpr size_t EIT_EVENT_FIXED_SIZE = 12;
+
+        //!
+        //! Constructor from a binary table.
+        //! @param [in] table The binary table. Must remain valid while the view is used.
+        //!
+        EITView(const BinaryTable& table) : AbstractTableView(table, TID_EIT_MIN, TID_EIT_MAX, EIT_PAYLOAD_FIXED_SIZE) {}
+
+        //!
+        //! Constructor from a section.
+        //! @param [in] section The section. Must remain valid while the view is used.
+        //!
+        EITView(const Section& section) : AbstractTableView(section, TID_EIT_MIN, TID_EIT_MAX, EIT_PAYLOAD_FIXED_SIZE) {}
+
+        //!
+        //! Get the service id.
+        //! @return The service id.
+        //!
+        uint16_t serviceId() const { return tableIdExtension(); }
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id or zero if the view is invalid.
+        //!
+        uint16_t tsId() const { return isValid() ? GetUInt16(header()) : 0; }
+
+        //!
+        //! Get the original network id.
+        //! @return The original network id or zero if the view is invalid.
+        //!
+        uint16_t originalNetworkId() const { return isValid() ? GetUInt16(header() + 2) : 0; }
+
+        //!
+        //! Get the segment last section number of the first section.
+        //! @return The segment last section number or zero if the view is invalid.
+        //!
+        uint8_t segmentLastSectionNumber() const { return isValid() ? header()[4] : 0; }
+
+        //!
+        //! Get the last table id.
+        //! @return The last table id or TID_NULL if the view is invalid.
+        //!
+        TID lastTableId() const { return isValid() ? header()[5] : TID(TID_NULL); }
+
+        //!
+        //! View over one event in an EIT.
+        //!
+        class TSDUCKDLL Event
+        {
+        public:
+            //!
+            //! Get the address of the event description in the section.
+            //! @return The address of the event description, starting with the event id.
+            //!
+            const uint8_t* data() const { return _data; }
+
+            //!
+            //! Get the event id.
+            //! @return The event id.
+            //!
+            uint16_t id() const { return GetUInt16(_data); }
+
+            //!
+            //! Get the event start time.
+            //! @param [out] time The event start time, as encoded in the EIT (UTC in DVB).
+            //! @return True on success, false if the start time is invalid.
+            //!
+            bool startTime(Time& time) const;
+
+            //!
+            //! Get the event duration.
+            //! @return The event duration.
+            //!
+            cn::seconds duration() const;
+
+            //!
+            //! Get the running status.
+            //! @return The running status of the event.
+            //!
+            uint8_t runningStatus() const { return _data[10] >> 5; }
+
+            //!
+            //! Get the free CA mode.
+            //! @return True if some components of the event are controlled by a CA system.
+            //!
+            bool CAControlled() const { return (_data[10] & 0x10) != 0; }
+
+            //!
+            //! Get the event descriptors.
+            //! @return A view over the event descriptors.
+            //!
+            DescriptorListView descriptors() const { return DescriptorListView(_data + EIT_EVENT_FIXED_SIZE, GetUInt16(_data + 10) & 0x0FFF); }
+
+            //! @cond nodoxygen
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            size_t assign(const uint8_t* data, size_t max_size);
+            //! @endcond
+
+        private:
+            const uint8_t* _data = nullptr;
+        };
+
+        //!
+        //! Get an iterator to the first event in the EIT.
+        //! @return An iterator to the first event.
+        //!
+        Iterator<Event> begin() const { return Iterator<Event>(*this); }
+
+        //!
+        //! Get an iterator after the last event in the EIT.
+        //! @return An iterator after the last event.
+        //!
+        Iterator<Event> end() const { return Iterator<Event>(); }
+    };
+}
@@ -0,0 +1,51 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary Network Information Table (NIT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTransportListView.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary Network Information Table (NIT).
+    //! @see ETSI EN 300 468, 5.2.1
+    //! @see AbstractTransportListView
+    //! @ingroup libtsduck table
+    //!
+    class TSDUCKDLL NITView : public AbstractTransportListView
+    {
+    public:
+        //!
+        //! Constructor from a binary table, NIT Actual or Other.
+        //! @param [in] table The binary table. Must remain valid while the view is used.
+        //!
+        NITView(const BinaryTable& table) : AbstractTransportListView(table, TID_NIT_ACT, TID_NIT_OTH) {}
+
+        //!
+        //! Constructor from a section, NIT Actual or Other.
+        //! @param [in] section The section. Must remain valid while the view is used.
+        //!
+        NITView(const Section& section) : AbstractTransportListView(section, TID_NIT_ACT, TID_NIT_OTH) {}
+
+        //!
+        //! Check if this is a NIT Actual.
+        //! @return True for NIT Actual, false for NIT Other.
+        //!
+        bool isActual() const { return tableId() == TID_NIT_ACT; }
+
+        //!
+        //! Get the network id.
+        //! @return The network id.
+        //!
+        uint16_t networkId() const { return tableIdExtension(); }
+    };
+}
@@ -0,0 +1,50 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsSDTView.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::SDTView::SDTView(const BinaryTable& table) :
+    AbstractTableView(table, TID_SDT_ACT, TID_SDT_OTH, 3)
+{
+}
+
+ts::SDTView::SDTView(const Section& section) :
+    AbstractTableView(section, TID_SDT_ACT, TID_SDT_OTH, 3)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Services in the SDT, after original_network_id and a reserved byte.
+//----------------------------------------------------------------------------
+
+bool ts::SDTView::Service::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    const size_t size = section.payloadSize();
+    if (size < 3) {
+        return false;
+    }
+    begin = section.payload() + 3;
+    end = section.payload() + size;
+    return true;
+}
+
+size_t ts::SDTView::Service::assign(const uint8_t* data, size_t max_size)
+{
+    _data = data;
+    if (max_size < 5) {
+        return 0;
+    }
+    const size_t size = 5 + size_t(GetUInt16(data + 3) & 0x0FFF);
+    return size > max_size ? 0 : size;
+}
@@ -0,0 +1,120 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary Service Description Table (SDT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary Service Description Table (SDT).
+    //! @see ETSI EN 300 468, 5.2.3
+    //! @see AbstractTableView
+    //! @ingroup libtsduck table
+    //!
+    class TSDUCKDLL SDTView : public AbstractTableView
+    {
+    public:
+        //!
+        //! Constructor from a binary table, SDT Actual or Other.
+        //! @param [in] table The binary table. Must remain valid while the view is used.
+        //!
+        SDTView(const BinaryTable& table);
+
+        //!
+        //! Constructor from a section, SDT Actual or Other.
+        //! @param [in] section The section. Must remain valid while the view is used.
+        //!
+        SDTView(const Section& section);
+
+        //!
+        //! Check if this is an SDT Actual.
+        //! @return True for SDT Actual, false for SDT Other.
+        //!
+        bool isActual() const { return tableId() == TID_SDT_ACT; }
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return tableIdExtension(); }
+
+        //!
+        //! Get the original network id.
+        //! @return The original network id or zero if the view is invalid.
+        //!
+        uint16_t originalNetworkId() const { return isValid() ? GetUInt16(header()) : 0; }
+
+        //!
+        //! View over one service in an SDT.
+        //!
+        class TSDUCKDLL Service
+        {
+        public:
+            //!
+            //! Get the service id.
+            //! @return The service id.
+            //!
+            uint16_t id() const { return GetUInt16(_data); }
+
+            //!
+            //! Get the EIT schedule flag.
+            //! @return True if EIT schedule information is present for the service.
+            //!
+            bool eitSchedule() const { return (_data[2] & 0x02) != 0; }
+
+            //!
+            //! Get the EIT present/following flag.
+            //! @return True if EIT present/following information is present for the service.
+            //!
+            bool eitPresentFollowing() const { return (_data[2] & 0x01) != 0; }
+
+            //!
+            //! Get the running status.
+            //! @return The running status of the service.
+            //!
+            uint8_t runningStatus() const { return _data[3] >> 5; }
+
+            //!
+            //! Get the free CA mode.
+            //! @return True if some components of the service are controlled by a CA system.
+            //!
+            bool CAControlled() const { return (_data[3] & 0x10) != 0; }
+
+            //!
+            //! Get the service descriptors.
+            //! @return A view over the service descriptors.
+            //!
+            DescriptorListView descriptors() const { return DescriptorListView(_data + 5, GetUInt16(_data + 3) & 0x0FFF); }
+
+            //! @cond nodoxygen
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            size_t assign(const uint8_t* data, size_t max_size);
+            //! @endcond
+
+        private:
+            const uint8_t* _data = nullptr;
+        };
+
+        //!
+        //! Get an iterator to the first service in the SDT.
+        //! @return An iterator to the first service.
+        //!
+        Iterator<Service> begin() const { return Iterator<Service>(*this); }
+
+        //!
+        //! Get an iterator after the last service in the SDT.
+        //! @return An iterator after the last service.
+        //!
+        Iterator<Service> end() const { return Iterator<Service>(); }
+    };
+}
@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsTOTView.h"
+#include "tsMJD.h"
+
+
+//----------------------------------------------------------------------------
+// Get the UTC time.
+//----------------------------------------------------------------------------
+
+bool ts::TOTView::utcTime(Time& time) const
+{
+    return isValid() && DecodeMJD(header(), MJD_FULL, time);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the descriptors, between the time and the CRC32.
+//----------------------------------------------------------------------------
+
+ts::DescriptorListView ts::TOTView::descriptors() const
+{
+    const uint8_t* data = header();
+    if (data == nullptr) {
+        return DescriptorListView();
+    }
+    const size_t max_size = sectionAt(0)->payloadSize() - 11;
+    return DescriptorListView(data + 7, std::min<size_t>(GetUInt16(data + 5) & 0x0FFF, max_size));
+}
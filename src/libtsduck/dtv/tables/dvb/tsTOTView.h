@@ -0,0 +1,56 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary Time Offset Table (TOT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+#include "tsTime.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary Time Offset Table (TOT).
+    //! @see ETSI EN 300 468, 5.2.6
+    //! @see AbstractTableView
+    //! @ingroup libtsduck table
+    //!
+    //! The TOT is a short section with a trailing CRC32 which is part of the section payload.
+    //!
+    class TSDUCKDLL TOTView : public AbstractTableView
+    {
+    public:
+        //!
+        //! Constructor from a binary table.
+        //! @param [in] table The binary table. Must remain valid while the view is used.
+        //!
+        TOTView(const BinaryTable& table) : AbstractTableView(table, TID_TOT, TID_TOT, 11) {}
+
+        //!
+        //! Constructor from a section.
+        //! @param [in] section The section. Must remain valid while the view is used.
+        //!
+        TOTView(const Section& section) : AbstractTableView(section, TID_TOT, TID_TOT, 11) {}
+
+        //!
+        //! Get the UTC time.
+        //! @param [out] time The time, as encoded in the TOT. This is UTC in DVB. With a non-standard
+        //! time reference, the caller shall apply the time reference offset (see DuckContext).
+        //! @return True on success, false if the view or the time is invalid.
+        //!
+        bool utcTime(Time& time) const;
+
+        //!
+        //! Get the descriptors of the TOT.
+        //! @return A view over the descriptors, empty if the view is invalid.
+        //!
+        DescriptorListView descriptors() const;
+    };
+}
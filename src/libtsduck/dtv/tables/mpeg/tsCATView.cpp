@@ -0,0 +1,21 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsCATView.h"
+
+
+//----------------------------------------------------------------------------
+// Descriptors in the CAT, the complete payload of all sections.
+//----------------------------------------------------------------------------
+
+bool ts::CATView::Descriptor::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    begin = section.payload();
+    end = begin + section.payloadSize();
+    return true;
+}
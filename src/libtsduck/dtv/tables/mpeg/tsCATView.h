@@ -0,0 +1,62 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary Conditional Access Table (CAT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary Conditional Access Table (CAT).
+    //! @see ISO/IEC 13818-1, ITU-T Rec. H.222.0, 2.4.4.6
+    //! @see AbstractTableView
+    //! @ingroup libtsduck table
+    //!
+    class TSDUCKDLL CATView : public AbstractTableView
+    {
+    public:
+        //!
+        //! Constructor from a binary table.
+        //! @param [in] table The binary table. Must remain valid while the view is used.
+        //!
+        CATView(const BinaryTable& table) : AbstractTableView(table, TID_CAT, TID_CAT, 0) {}
+
+        //!
+        //! Constructor from a section.
+        //! @param [in] section The section. Must remain valid while the view is used.
+        //!
+        CATView(const Section& section) : AbstractTableView(section, TID_CAT, TID_CAT, 0) {}
+
+        //!
+        //! View over one descriptor in a CAT.
+        //!
+        class TSDUCKDLL Descriptor : public DescriptorView
+        {
+        public:
+            //! @cond nodoxygen
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            //! @endcond
+        };
+
+        //!
+        //! Get an iterator to the first descriptor in all sections of the CAT.
+        //! @return An iterator to the first descriptor.
+        //!
+        Iterator<Descriptor> begin() const { return Iterator<Descriptor>(*this); }
+
+        //!
+        //! Get an iterator after the last descriptor in the CAT.
+        //! @return An iterator after the last descriptor.
+        //!
+        Iterator<Descriptor> end() const { return Iterator<Descriptor>(); }
+    };
+}
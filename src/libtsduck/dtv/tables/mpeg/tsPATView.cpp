@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsPATView.h"
+
+
+//----------------------------------------------------------------------------
+// Get the PID of the NIT.
+//----------------------------------------------------------------------------
+
+ts::PID ts::PATView::nitPID() const
+{
+    for (const auto& srv : *this) {
+        if (srv.id() == 0) {
+            return srv.pmtPID();
+        }
+    }
+    return PID_NULL;
+}
+
+
+//----------------------------------------------------------------------------
+// Entries in the PAT.
+//----------------------------------------------------------------------------
+
+bool ts::PATView::Service::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    begin = section.payload();
+    end = begin + section.payloadSize();
+    return true;
+}
+
+size_t ts::PATView::Service::assign(const uint8_t* data, size_t max_size)
+{
+    _data = data;
+    return max_size < 4 ? 0 : 4;
+}
@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary Program Association Table (PAT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary Program Association Table (PAT).
+    //! @see ISO/IEC 13818-1, ITU-T Rec. H.222.0, 2.4.4.3
+    //! @see AbstractTableView
+    //! @ingroup libtsduck table
+    //!
+    class TSDUCKDLL PATView : public AbstractTableView
+    {
+    public:
+        //!
+        //! Constructor from a binary table.
+        //! @param [in] table The binary table. Must remain valid while the view is used.
+        //!
+        PATView(const BinaryTable& table) : AbstractTableView(table, TID_PAT, TID_PAT, 0) {}
+
+        //!
+        //! Constructor from a section.
+        //! @param [in] section The section. Must remain valid while the view is used.
+        //!
+        PATView(const Section& section) : AbstractTableView(section, TID_PAT, TID_PAT, 0) {}
+
+        //!
+        //! Get the transport stream id.
+        //! @return The transport stream id.
+        //!
+        uint16_t tsId() const { return tableIdExtension(); }
+
+        //!
+        //! Get the PID of the NIT.
+        //! @return The PID of the NIT, as declared with service id zero, or PID_NULL if there is none.
+        //!
+        PID nitPID() const;
+
+        //!
+        //! View over one entry in a PAT, a service and its PMT PID.
+        //! The entry with service id zero, if any, is the NIT PID.
+        //!
+        class TSDUCKDLL Service
+        {
+        public:
+            //!
+            //! Get the service id.
+            //! @return The service id.
+            //!
+            uint16_t id() const { return GetUInt16(_data); }
+
+            //!
+            //! Get the PMT PID of the service.
+            //! @return The PMT PID of the service, or the NIT PID if the service id is zero.
+            //!
+            PID pmtPID() const { return GetUInt16(_data + 2) & 0x1FFF; }
+
+            //! @cond nodoxygen
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            size_t assign(const uint8_t* data, size_t max_size);
+            //! @endcond
+
+        private:
+            const uint8_t* _data = nullptr;
+        };
+
+        //!
+        //! Get an iterator to the first service in the PAT.
+        //! @return An iterator to the first service.
+        //!
+        Iterator<Service> begin() const { return Iterator<Service>(*this); }
+
+        //!
+        //! Get an iterator after the last service in the PAT.
+        //! @return An iterator after the last service.
+        //!
+        Iterator<Service> end() const { return Iterator<Service>(); }
+    };
+}
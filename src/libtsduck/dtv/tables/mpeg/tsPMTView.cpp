@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsPMTView.h"
+
+
+//----------------------------------------------------------------------------
+// Get the program-level descriptors.
+//----------------------------------------------------------------------------
+
+ts::DescriptorListView ts::PMTView::descriptors() const
+{
+    const uint8_t* data = header();
+    if (data == nullptr) {
+        return DescriptorListView();
+    }
+    const size_t size = sectionAt(0)->payloadSize() - 4;
+    return DescriptorListView(data + 4, std::min<size_t>(GetUInt16(data + 2) & 0x0FFF, size));
+}
+
+
+//----------------------------------------------------------------------------
+// Elementary streams in the PMT, after the program-level descriptors.
+//----------------------------------------------------------------------------
+
+bool ts::PMTView::Stream::Area(const Section& section, const uint8_t*& begin, const uint8_t*& end)
+{
+    const uint8_t* data = section.payload();
+    const size_t size = section.payloadSize();
+    const size_t skip = size < 4 ? 0 : 4 + size_t(GetUInt16(data + 2) & 0x0FFF);
+    if (skip == 0 || skip > size) {
+        return false;
+    }
+    begin = data + skip;
+    end = data + size;
+    return true;
+}
+
+size_t ts::PMTView::Stream::assign(const uint8_t* data, size_t max_size)
+{
+    _data = data;
+    if (max_size < 5) {
+        return 0;
+    }
+    const size_t size = 5 + size_t(GetUInt16(data + 3) & 0x0FFF);
+    return size > max_size ? 0 : size;
+}
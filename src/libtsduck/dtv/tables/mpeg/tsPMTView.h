@@ -0,0 +1,102 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Read-only view over a binary Program Map Table (PMT).
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsAbstractTableView.h"
+
+namespace ts {
+    //!
+    //! Read-only view over a binary Program Map Table (PMT).
+    //! @see ISO/IEC 13818-1, ITU-T Rec. H.222.0, 2.4.4.8
+    //! @see AbstractTableView
+    //! @ingroup libtsduck table
+    //!
+    class TSDUCKDLL PMTView : public AbstractTableView
+    {
+    public:
+        //!
+        //! Constructor from a binary table.
+        //! @param [in] table The binary table. Must remain valid while the view is used.
+        //!
+        PMTView(const BinaryTable& table) : AbstractTableView(table, TID_PMT, TID_PMT, 4) {}
+
+        //!
+        //! Constructor from a section.
+        //! @param [in] section The section. Must remain valid while the view is used.
+        //!
+        PMTView(const Section& section) : AbstractTableView(section, TID_PMT, TID_PMT, 4) {}
+
+        //!
+        //! Get the service id.
+        //! @return The service id.
+        //!
+        uint16_t serviceId() const { return tableIdExtension(); }
+
+        //!
+        //! Get the PCR PID.
+        //! @return The PCR PID or PID_NULL if the view is invalid.
+        //!
+        PID pcrPID() const { return isValid() ? GetUInt16(header()) & 0x1FFF : PID(PID_NULL); }
+
+        //!
+        //! Get the program-level descriptors.
+        //! @return A view over the program-level descriptors of the first section.
+        //!
+        DescriptorListView descriptors() const;
+
+        //!
+        //! View over one elementary stream in a PMT.
+        //!
+        class TSDUCKDLL Stream
+        {
+        public:
+            //!
+            //! Get the stream type.
+            //! @return The stream type.
+            //!
+            uint8_t streamType() const { return _data[0]; }
+
+            //!
+            //! Get the elementary stream PID.
+            //! @return The elementary stream PID.
+            //!
+            PID pid() const { return GetUInt16(_data + 1) & 0x1FFF; }
+
+            //!
+            //! Get the elementary stream descriptors.
+            //! @return A view over the elementary stream descriptors.
+            //!
+            DescriptorListView descriptors() const { return DescriptorListView(_data + 5, GetUInt16(_data + 3) & 0x0FFF); }
+
+            //! @cond nodoxygen
+            static bool Area(const Section& section, const uint8_t*& begin, const uint8_t*& end);
+            size_t assign(const uint8_t* data, size_t max_size);
+            //! @endcond
+
+        private:
+            const uint8_t* _data = nullptr;
+        };
+
+        //!
+        //! Get an iterator to the first elementary stream in the PMT.
+        //! @return An iterator to the first elementary stream.
+        //!
+        Iterator<Stream> begin() const { return Iterator<Stream>(*this); }
+
+        //!
+        //! Get an iterator after the last elementary stream in the PMT.
+        //! @return An iterator after the last elementary stream.
+        //!
+        Iterator<Stream> end() const { return Iterator<Stream>(); }
+    };
+}
@@ -0,0 +1,287 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tstr101290MultiStreamAnalyzer.h"
+#include "tstr101290Analyzer.h"
+#include "tsDuckContext.h"
+#include "tsjsonArray.h"
+#include "tsSysInfo.h"
+
+
+//----------------------------------------------------------------------------
+// Analysis context of one stream.
+//----------------------------------------------------------------------------
+
+class ts::tr101290::MultiStreamAnalyzer::Stream
+{
+    TS_NOBUILD_NOCOPY(Stream);
+public:
+    Stream(Report& report, const UString& name) : duck(&report) { status.name = name; }
+
+    // Used by the worker thread only.
+    DuckContext           duck;
+    Analyzer              analyzer {duck};
+    std::vector<TSPacket> work_packets {};  // Packets being analyzed.
+    std::vector<PCR>      work_times {};    // Timestamps of packets being analyzed.
+    Worker*               worker = nullptr; // Worker thread for this stream.
+
+    // Protected by the mutex.
+    mutable std::mutex    mutex {};
+    std::vector<TSPacket> packets {};       // Packets waiting for analysis.
+    std::vector<PCR>      times {};         // Timestamps of packets waiting for analysis.
+    Status                status {};        // Last published status.
+};
+
+
+//----------------------------------------------------------------------------
+// Worker thread, analyzing a subset of the streams.
+//----------------------------------------------------------------------------
+
+class ts::tr101290::MultiStreamAnalyzer::Worker : public Thread
+{
+    TS_NOCOPY(Worker);
+public:
+    Worker() = default;
+    virtual ~Worker() override;
+
+    // Streams to analyze in this thread, set before start.
+    std::vector<Stream*> streams {};
+
+    // Notify the thread that packets are available.
+    void notify();
+
+    // Request the termination of the thread.
+    void terminate();
+
+private:
+    std::mutex              _mutex {};
+    std::condition_variable _cond {};
+    bool                    _ready = false;
+    bool                    _terminate = false;
+
+    virtual void main() override;
+};
+
+ts::tr101290::MultiStreamAnalyzer::Worker::~Worker()
+{
+    terminate();
+    waitForTermination();
+}
+
+void ts::tr101290::MultiStreamAnalyzer::Worker::notify()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _ready = true;
+    }
+    _cond.notify_one();
+}
+
+void ts::tr101290::MultiStreamAnalyzer::Worker::terminate()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminate = true;
+    }
+    _cond.notify_one();
+}
+
+void ts::tr101290::MultiStreamAnalyzer::Worker::main()
+{
+    for (;;) {
+        // Wait for packets to analyze.
+        bool terminate = false;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cond.wait(lock, [this]() { return _ready || _terminate; });
+            _ready = false;
+            terminate = _terminate;
+        }
+
+        // Analyze all pending packets in all streams of this thread.
+        // The buffers are swapped, their capacity is preserved, there is no reallocation.
+        for (Stream* st : streams) {
+            {
+                std::lock_guard<std::mutex> lock(st->mutex);
+                st->packets.swap(st->work_packets);
+                st->times.swap(st->work_times);
+            }
+            if (!st->work_packets.empty()) {
+                for (size_t i = 0; i < st->work_packets.size(); ++i) {
+                    st->analyzer.feedPacket(st->work_times[i], st->work_packets[i]);
+                }
+                Counters counters;
+                st->analyzer.getCounters(counters);
+                std::lock_guard<std::mutex> lock(st->mutex);
+                st->status.packets += st->work_packets.size();
+                st->status.counters = counters;
+                st->work_packets.clear();
+                st->work_times.clear();
+            }
+        }
+
+        // Pending packets are analyzed before terminating.
+        if (terminate) {
+            return;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::tr101290::MultiStreamAnalyzer::~MultiStreamAnalyzer()
+{
+    stop();
+}
+
+
+//----------------------------------------------------------------------------
+// Add a new stream to analyze.
+//----------------------------------------------------------------------------
+
+size_t ts::tr101290::MultiStreamAnalyzer::addStream(const UString& name)
+{
+    if (!_workers.empty()) {
+        _report.error(u"cannot add a stream after starting the TR 101 290 analysis");
+        return NPOS;
+    }
+    _streams.push_back(std::make_shared<Stream>(_report, name));
+    return _streams.size() - 1;
+}
+
+
+//----------------------------------------------------------------------------
+// Start and stop the worker threads.
+//----------------------------------------------------------------------------
+
+bool ts::tr101290::MultiStreamAnalyzer::start()
+{
+    if (!_workers.empty()) {
+        _report.error(u"TR 101 290 analysis already started");
+        return false;
+    }
+
+    // Distribute the streams over the worker threads.
+    const size_t threads = std::max<size_t>(1, std::min(_streams.size(), _thread_count > 0 ? _thread_count : SysInfo::Instance().cpuCoreCount()));
+    for (size_t i = 0; i < threads; ++i) {
+        _workers.push_back(std::make_shared<Worker>());
+    }
+    for (size_t i = 0; i < _streams.size(); ++i) {
+        Stream* st = _streams[i].get();
+        st->worker = _workers[i % threads].get();
+        st->worker->streams.push_back(st);
+        st->packets.reserve(_max_pending);
+        st->times.reserve(_max_pending);
+        st->work_packets.reserve(_max_pending);
+        st->work_times.reserve(_max_pending);
+    }
+    _report.debug(u"analyzing %d streams using %d threads", _streams.size(), threads);
+
+    bool ok = true;
+    for (const auto& wk : _workers) {
+        ok = wk->start() && ok;
+    }
+    if (!ok) {
+        stop();
+    }
+    return ok;
+}
+
+void ts::tr101290::MultiStreamAnalyzer::stop()
+{
+    // Stop accepting packets, then terminate the threads (in the destructor of the workers).
+    for (const auto& st : _streams) {
+        std::lock_guard<std::mutex> lock(st->mutex);
+        st->worker = nullptr;
+    }
+    _workers.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Feed a batch of TS packets of a stream.
+//----------------------------------------------------------------------------
+
+void ts::tr101290::MultiStreamAnalyzer::feedPackets(size_t index, const PCR& timestamp, const TSPacket* packets, size_t count)
+{
+    if (index >= _streams.size() || packets == nullptr || count == 0) {
+        return;
+    }
+    Stream& st(*_streams[index]);
+    std::lock_guard<std::mutex> lock(st.mutex);
+    if (st.worker != nullptr) {
+        const size_t pending = st.packets.size();
+        const size_t accepted = std::min(count, _max_pending - std::min(_max_pending, pending));
+        st.packets.insert(st.packets.end(), packets, packets + accepted);
+        st.times.insert(st.times.end(), accepted, timestamp);
+        st.status.dropped += count - accepted;
+        // The worker needs to be notified when the list was empty only.
+        // Otherwise, the previous notification is still pending.
+        if (pending == 0 && accepted > 0) {
+            st.worker->notify();
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get a snapshot of the status of one stream.
+//----------------------------------------------------------------------------
+
+bool ts::tr101290::MultiStreamAnalyzer::getStatus(size_t index, Status& status) const
+{
+    if (index >= _streams.size()) {
+        return false;
+    }
+    const Stream& st(*_streams[index]);
+    std::lock_guard<std::mutex> lock(st.mutex);
+    status = st.status;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get a snapshot of the status of all streams, as a JSON object.
+//----------------------------------------------------------------------------
+
+void ts::tr101290::MultiStreamAnalyzer::getStatus(json::Object& root) const
+{
+    root.clear();
+    Status total;
+    auto streams = std::make_shared<json::Array>();
+    for (size_t index = 0; index < _streams.size(); ++index) {
+        Status status;
+        getStatus(index, status);
+        total.packets += status.packets;
+        total.dropped += status.dropped;
+        for (size_t i = 0; i < total.counters.size(); ++i) {
+            total.counters[i] += status.counters[i];
+        }
+        auto obj = std::make_shared<json::Object>();
+        obj->add(u"name", status.name);
+        AddStatus(*obj, status);
+        streams->set(obj);
+    }
+    AddStatus(root.query(u"total", true), total);
+    root.add(u"streams", streams);
+}
+
+void ts::tr101290::MultiStreamAnalyzer::AddStatus(json::Value& obj, const Status& status)
+{
+    obj.add(u"packets", status.packets);
+    obj.add(u"dropped", status.dropped);
+    obj.add(u"errors", status.counters.errorCount());
+    json::Value& counters(obj.query(u"counters", true));
+    const auto& desc(GetCounterDescriptions());
+    for (size_t i = 0; i < status.counters.size(); ++i) {
+        counters.add(desc[i].name, status.counters[i]);
+    }
+}
@@ -0,0 +1,152 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Analyze many transport streams in parallel according to ETSI TR 101 290.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tstr101290.h"
+#include "tsTSPacket.h"
+#include "tsThread.h"
+#include "tsjsonObject.h"
+
+namespace ts::tr101290 {
+    //!
+    //! Analyze many transport streams in parallel according to ETSI TR 101 290.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! Each transport stream is analyzed by its own instance of tr101290::Analyzer. The streams
+    //! are distributed over a pool of worker threads. All packets of a stream are always analyzed
+    //! by the same thread, in order, so that no synchronization is required on the analyzers.
+    //!
+    //! The application feeds batches of packets, typically the content of one UDP datagram, from
+    //! any thread. Feeding packets never blocks on the analysis. When the analysis of a stream is
+    //! late by more than a maximum number of packets, the new packets are dropped and counted.
+    //! This bounds the memory which is used per stream.
+    //!
+    //! The error counters are published by the worker threads after each batch of packets.
+    //! They can be read at any time, from any thread, without interfering with the analysis.
+    //!
+    class TSDUCKDLL MultiStreamAnalyzer
+    {
+        TS_NOBUILD_NOCOPY(MultiStreamAnalyzer);
+    public:
+        //!
+        //! Default maximum number of packets which are waiting for analysis in a stream.
+        //!
+        static constexpr size_t DEFAULT_MAX_PENDING = 10'000;
+
+        //!
+        //! Status of the analysis of one stream.
+        //!
+        class TSDUCKDLL Status
+        {
+        public:
+            Status() = default;                //!< Constructor.
+            UString       name {};             //!< Stream name.
+            PacketCounter packets = 0;         //!< Number of analyzed packets.
+            PacketCounter dropped = 0;         //!< Number of dropped packets because the analysis was late.
+            Counters      counters {};         //!< Error counters since the start of the analysis.
+        };
+
+        //!
+        //! Constructor.
+        //! @param [in,out] report Where to report errors. The reference is kept inside the object.
+        //! It must be thread-safe since it is used by all analyzers, from all worker threads.
+        //!
+        explicit MultiStreamAnalyzer(Report& report) : _report(report) {}
+
+        //!
+        //! Destructor.
+        //! The worker threads are stopped.
+        //!
+        ~MultiStreamAnalyzer();
+
+        //!
+        //! Set the number of worker threads.
+        //! Must be called before start().
+        //! @param [in] count Number of worker threads. Zero means the number of CPU cores.
+        //!
+        void setThreadCount(size_t count) { _thread_count = count; }
+
+        //!
+        //! Set the maximum number of packets which are waiting for analysis in a stream.
+        //! @param [in] count Maximum number of packets per stream.
+        //!
+        void setMaxPendingPackets(size_t count) { _max_pending = std::max<size_t>(count, 1); }
+
+        //!
+        //! Add a new stream to analyze.
+        //! Must be called before start().
+        //! @param [in] name Stream name, for display only.
+        //! @return The index of the new stream, to use in feedPackets().
+        //!
+        size_t addStream(const UString& name);
+
+        //!
+        //! Get the number of streams.
+        //! @return The number of streams.
+        //!
+        size_t streamCount() const { return _streams.size(); }
+
+        //!
+        //! Start the worker threads.
+        //! @return True on success, false on error.
+        //!
+        bool start();
+
+        //!
+        //! Stop the worker threads.
+        //! The packets which are waiting for analysis are analyzed first.
+        //!
+        void stop();
+
+        //!
+        //! Feed a batch of TS packets of a stream.
+        //! This method is thread-safe and never waits for the analysis.
+        //! @param [in] index Index of the stream, as returned by addStream().
+        //! @param [in] timestamp Common timestamp for all packets in the batch, in PCR units. This must
+        //! be a monotonic clock which never wraps, typically the reception time of the UDP datagram.
+        //! @param [in] packets Address of the TS packets.
+        //! @param [in] count Number of TS packets.
+        //!
+        void feedPackets(size_t index, const PCR& timestamp, const TSPacket* packets, size_t count);
+
+        //!
+        //! Get a snapshot of the status of one stream.
+        //! @param [in] index Index of the stream, as returned by addStream().
+        //! @param [out] status Returned status.
+        //! @return True on success, false if @a index is invalid.
+        //!
+        bool getStatus(size_t index, Status& status) const;
+
+        //!
+        //! Get a snapshot of the status of all streams, as a JSON object.
+        //! The object contains the aggregated counters in "total" and one entry per stream in "streams".
+        //! @param [out] root Returned JSON object.
+        //!
+        void getStatus(json::Object& root) const;
+
+    private:
+        class Stream;
+        class Worker;
+        using StreamPtr = std::shared_ptr<Stream>;
+        using WorkerPtr = std::shared_ptr<Worker>;
+
+        Report&                _report;
+        size_t                 _thread_count = 0;
+        size_t                 _max_pending = DEFAULT_MAX_PENDING;
+        std::vector<StreamPtr> _streams {};
+        std::vector<WorkerPtr> _workers {};
+
+        // Add a status in a JSON object.
+        static void AddStatus(json::Value& obj, const Status& status);
+    };
+}
@@ -0,0 +1,306 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsRTPReorderBuffer.h"
+#include "tsIPProtocols.h"
+#include "tsNullReport.h"
+#include "tsMemory.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor and reset.
+//----------------------------------------------------------------------------
+
+ts::RTPReorderBuffer::RTPReorderBuffer(Report* report) :
+    _report(report != nullptr ? report : &NULLREP)
+{
+}
+
+void ts::RTPReorderBuffer::setReport(Report* report)
+{
+    _report = report != nullptr ? report : &NULLREP;
+}
+
+void ts::RTPReorderBuffer::reset(size_t window, cn::milliseconds max_delay, size_t datagram_size)
+{
+    // The window must remain far below half the range of sequence numbers.
+    window = std::clamp<size_t>(window, 1, 16000);
+
+    _stats = Statistics();
+    _max_delay = max_delay;
+    _datagram_size = std::max<size_t>(datagram_size, RTP_HEADER_SIZE);
+
+    // Datagrams are received in one buffer of maximum size. The buffers of the held datagrams,
+    // one per datagram in the window plus the one being received, are allocated on first use.
+    _recv_data.resize(_datagram_size);
+    _in_recv = NONE;
+    _slots.resize(window + 1);
+    _free.clear();
+    _free.reserve(window + 1);
+    for (size_t i = window + 1; i > 0; --i) {
+        _free.push_back(i - 1);
+    }
+    _ring.assign(window, NONE);
+
+    _head = _held = 0;
+    _receiving = _parked = _bypass = NONE;
+    _resync = _started = false;
+    _next = _highest = 0;
+    _ssrc = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Reception of datagrams.
+//----------------------------------------------------------------------------
+
+uint8_t* ts::RTPReorderBuffer::receiveBuffer()
+{
+    if (_receiving == NONE) {
+        // The previous datagram is still held, move it out of the reception buffer, with its actual size.
+        if (_in_recv != NONE) {
+            Slot& slot(_slots[_in_recv]);
+            slot.data.copy(_recv_data.data(), slot.size);
+        }
+        // There is always one free buffer when getDatagram() has returned false.
+        assert(!_free.empty());
+        _receiving = _in_recv = _free.back();
+        _free.pop_back();
+    }
+    return _recv_data.data();
+}
+
+void ts::RTPReorderBuffer::commit(size_t size, cn::microseconds timestamp, TimeSource timesource, monotonic_time now)
+{
+    if (_receiving == NONE) {
+        return;
+    }
+    const size_t index = _receiving;
+    _receiving = NONE;
+
+    // A datagram which did not fit in the buffer is truncated, don't return it.
+    if (size > _datagram_size) {
+        _stats.oversized_datagrams++;
+        _report->log(_severity, u"%sdatagram too large (%'d bytes, max: %'d), dropped", _prefix, size, _datagram_size);
+        release(index);
+        return;
+    }
+
+    Slot& slot(_slots[index]);
+    const uint8_t* const dg = data(index);
+    slot.size = size;
+    slot.timestamp = timestamp;
+    slot.timesource = timesource;
+    slot.arrival = now;
+
+    // Non-RTP datagrams are returned immediately.
+    if (slot.size < RTP_HEADER_SIZE || (dg[0] & 0xC0) != 0x80) {
+        _stats.non_rtp_datagrams++;
+        _bypass = index;
+        return;
+    }
+
+    _stats.rtp_datagrams++;
+    slot.seq = GetUInt16(dg + 2);
+    const uint32_t ssrc = GetUInt32(dg + 8);
+
+    if (!_started) {
+        _started = true;
+        _ssrc = ssrc;
+        restart(index, now);
+        return;
+    }
+
+    const int diff = RTPSequenceDiff(_next, slot.seq);
+    const int win = int(_ring.size());
+
+    if (ssrc != _ssrc || diff < -2 * win || diff >= 2 * win) {
+        // New RTP stream or large sequence jump, return the held datagrams and restart from this one.
+        _stats.resync_count++;
+        _report->log(_severity, u"%sRTP sequence: %d, resynchronization, expected %d", _prefix, slot.seq, _next);
+        _ssrc = ssrc;
+        _parked = index;
+        _resync = true;
+    }
+    else if (diff < 0) {
+        // Already returned or declared lost.
+        _stats.late_datagrams++;
+        _report->log(_severity, u"%sRTP sequence: %d, late datagram", _prefix, slot.seq);
+        release(index);
+    }
+    else if (diff >= win) {
+        // Too far ahead, the window must be moved forward first.
+        _parked = index;
+        _resync = false;
+    }
+    else {
+        place(index, now);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a datagram in the reorder window.
+//----------------------------------------------------------------------------
+
+void ts::RTPReorderBuffer::place(size_t index, monotonic_time now)
+{
+    const Slot& slot(_slots[index]);
+    const size_t diff = size_t(RTPSequenceDiff(_next, slot.seq));
+    assert(diff < _ring.size());
+    const size_t pos = (_head + diff) % _ring.size();
+
+    if (_ring[pos] != NONE) {
+        _stats.duplicate_datagrams++;
+        _report->log(_severity, u"%sRTP sequence: %d, duplicate datagram", _prefix, slot.seq);
+        release(index);
+        return;
+    }
+
+    if (_held == 0 && diff > 0) {
+        // First datagram which waits for a missing one.
+        _blocked_since = now;
+    }
+    if (RTPSequenceDiff(_highest, slot.seq) < 0) {
+        _stats.reordered_datagrams++;
+    }
+    else {
+        _highest = slot.seq;
+    }
+    _ring[pos] = index;
+    _held++;
+}
+
+void ts::RTPReorderBuffer::restart(size_t index, monotonic_time now)
+{
+    assert(_held == 0);
+    _next = _highest = _slots[index].seq;
+    _head = 0;
+    place(index, now);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next datagram in sequence order.
+//----------------------------------------------------------------------------
+
+bool ts::RTPReorderBuffer::getDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource, monotonic_time now)
+{
+    if (_bypass != NONE) {
+        const size_t index = _bypass;
+        _bypass = NONE;
+        output(index, buffer, buffer_size, ret_size, timestamp, timesource);
+        return true;
+    }
+    if (_ring.empty()) {
+        return false;
+    }
+
+    for (;;) {
+        if (_parked != NONE) {
+            // A datagram is waiting outside the window, move the window forward.
+            size_t skip = _ring.size();
+            if (_resync && _held == 0) {
+                const size_t index = _parked;
+                _parked = NONE;
+                _resync = false;
+                restart(index, now);
+                continue;
+            }
+            else if (!_resync) {
+                const int diff = RTPSequenceDiff(_next, _slots[_parked].seq);
+                if (diff < int(_ring.size())) {
+                    const size_t index = _parked;
+                    _parked = NONE;
+                    place(index, now);
+                    continue;
+                }
+                skip = size_t(diff) - _ring.size() + 1;
+            }
+            if (_ring[_head] == NONE) {
+                skipMissing(skip, !_resync);
+                continue;
+            }
+        }
+        else if (_ring[_head] == NONE) {
+            if (_held > 0 && _max_delay > cn::milliseconds::zero() && now - _blocked_since >= _max_delay) {
+                // Waited too long for the missing datagrams.
+                skipMissing(_ring.size(), true);
+                continue;
+            }
+            return false;
+        }
+
+        // Return the datagram at head of the window.
+        const size_t index = _ring[_head];
+        _ring[_head] = NONE;
+        _head = (_head + 1) % _ring.size();
+        _next++;
+        _held--;
+        _blocked_since = _slots[index].arrival;
+        output(index, buffer, buffer_size, ret_size, timestamp, timesource);
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get the time when the held datagrams will be returned.
+//----------------------------------------------------------------------------
+
+bool ts::RTPReorderBuffer::expiration(monotonic_time& expiration) const
+{
+    if (_held > 0 && _max_delay > cn::milliseconds::zero() && !_ring.empty() && _ring[_head] == NONE) {
+        expiration = _blocked_since + _max_delay;
+        return true;
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Return the content of a datagram buffer and release it.
+//----------------------------------------------------------------------------
+
+void ts::RTPReorderBuffer::output(size_t index, uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource)
+{
+    const Slot& slot(_slots[index]);
+    ret_size = std::min(slot.size, buffer_size);
+    MemCopy(buffer, data(index), ret_size);
+    timestamp = slot.timestamp;
+    timesource = slot.timesource;
+    release(index);
+}
+
+void ts::RTPReorderBuffer::release(size_t index)
+{
+    if (index == _in_recv) {
+        _in_recv = NONE;
+    }
+    _free.push_back(index);
+}
+
+
+//----------------------------------------------------------------------------
+// Skip missing datagrams at head of the window.
+//----------------------------------------------------------------------------
+
+void ts::RTPReorderBuffer::skipMissing(size_t max, bool count)
+{
+    const uint16_t first = _next;
+    size_t skipped = 0;
+    while (skipped < max && _ring[_head] == NONE) {
+        _head = (_head + 1) % _ring.size();
+        _next++;
+        skipped++;
+    }
+    if (count && skipped > 0) {
+        _stats.missing_datagrams += skipped;
+        _report->log(_severity, u"%sRTP sequence: %d, missing %d datagrams", _prefix, first, skipped);
+    }
+}
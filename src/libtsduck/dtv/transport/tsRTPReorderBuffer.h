@@ -0,0 +1,214 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Reorder buffer for RTP datagrams.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsByteBlock.h"
+#include "tsTimeSource.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! Reorder buffer for RTP datagrams, based on RTP sequence numbers.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! Datagrams are received directly into a buffer which is provided by receiveBuffer() and
+    //! then committed using commit(). Datagrams are returned by getDatagram() in RTP sequence order.
+    //!
+    //! When a datagram is missing, the following datagrams are held until the missing one is
+    //! received. The missing datagram is declared lost when the reorder window is full or when
+    //! the held datagrams are waiting for more than a maximum delay. Datagrams which are received
+    //! after being declared lost are late and dropped. Datagrams which are not RTP packets are
+    //! returned immediately, without reordering.
+    //!
+    //! Datagrams are received in one single buffer of the maximum datagram size. Only the datagrams
+    //! which must be held beyond the next reception are copied into their own buffer, which is sized
+    //! to the datagram. These buffers are allocated on first use and then reused. The memory remains
+    //! proportional to the number of held datagrams and their actual size, not to the maximum size.
+    //! Missing, late and duplicate datagrams are reported on a Report object, in the same way as
+    //! the TS packets in class ContinuityAnalyzer.
+    //!
+    class TSDUCKDLL RTPReorderBuffer
+    {
+        TS_NOCOPY(RTPReorderBuffer);
+    public:
+        //!
+        //! Default size of the reorder window in datagrams.
+        //!
+        static constexpr size_t DEFAULT_WINDOW = 128;
+
+        //!
+        //! Default maximum size of datagrams (payload of a jumbo Ethernet frame).
+        //!
+        static constexpr size_t DEFAULT_DATAGRAM_SIZE = 9000;
+
+        //!
+        //! Constructor.
+        //! @param [in] report Where to report missing, late and duplicate datagrams. Drop messages if null.
+        //!
+        RTPReorderBuffer(Report* report = nullptr);
+
+        //!
+        //! Reset the reorder buffer and allocate the reception buffer.
+        //! @param [in] window Size of the reorder window in datagrams.
+        //! @param [in] max_delay Maximum time to hold received datagrams while waiting for a missing one.
+        //! Zero means no time limit, only the size of the reorder window applies.
+        //! @param [in] datagram_size Maximum size in bytes of a datagram.
+        //!
+        void reset(size_t window = DEFAULT_WINDOW, cn::milliseconds max_delay = cn::milliseconds::zero(), size_t datagram_size = DEFAULT_DATAGRAM_SIZE);
+
+        //!
+        //! Replace the report for missing, late and duplicate datagrams.
+        //! @param [in] report Where to report messages. Drop messages if null.
+        //!
+        void setReport(Report* report);
+
+        //!
+        //! Set the severity level of messages.
+        //! @param [in] level Severity level of messages. The default is Severity::Info.
+        //!
+        void setMessageSeverity(int level) { _severity = level; }
+
+        //!
+        //! Set a prefix for messages.
+        //! @param [in] prefix Prefix string for messages. The default is an empty string.
+        //!
+        void setMessagePrefix(const UString& prefix) { _prefix = prefix; }
+
+        //!
+        //! Get the size of the reorder window.
+        //! @return The size of the reorder window in datagrams.
+        //!
+        size_t window() const { return _ring.size(); }
+
+        //!
+        //! Get the address of the buffer where the next datagram shall be received.
+        //! @return The address of the reception buffer. Its size is given by receiveBufferSize().
+        //!
+        uint8_t* receiveBuffer();
+
+        //!
+        //! Get the size of the reception buffer.
+        //! @return The size in bytes of the buffer which is returned by receiveBuffer().
+        //!
+        size_t receiveBufferSize() const { return _datagram_size; }
+
+        //!
+        //! Commit the datagram which was received in the reception buffer.
+        //! @param [in] size Size in bytes of the received datagram. A datagram which is larger than
+        //! receiveBufferSize() was truncated on reception: it is dropped and counted in the statistics.
+        //! @param [in] timestamp Receive timestamp in micro-seconds or -1 if not available.
+        //! @param [in] timesource Type of timestamp.
+        //! @param [in] now Current monotonic time, used to enforce the maximum delay.
+        //!
+        void commit(size_t size, cn::microseconds timestamp, TimeSource timesource, monotonic_time now = monotonic_time::clock::now());
+
+        //!
+        //! Get the next datagram in sequence order, when available.
+        //! @param [out] buffer Address of the buffer for the returned datagram.
+        //! @param [in] buffer_size Size in bytes of the buffer.
+        //! @param [out] ret_size Size in bytes of the returned datagram, truncated to @a buffer_size.
+        //! @param [out] timestamp Receive timestamp of the datagram in micro-seconds or -1 if not available.
+        //! @param [out] timesource Type of timestamp.
+        //! @param [in] now Current monotonic time, used to enforce the maximum delay.
+        //! When false is returned, the next datagram can be received using receiveBuffer().
+        //! @return True if a datagram was returned, false if no datagram is currently available.
+        //!
+        bool getDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource, monotonic_time now = monotonic_time::clock::now());
+
+        //!
+        //! Get the time when the held datagrams will be returned, even if the missing datagrams are not received.
+        //! This is meaningful after getDatagram() returned false, to limit the wait for the next datagram.
+        //! @param [out] expiration Time when the missing datagrams will be declared lost.
+        //! @return True if @a expiration is set, false if there is no time limit (no held datagram or no maximum delay).
+        //!
+        bool expiration(monotonic_time& expiration) const;
+
+        //!
+        //! Statistics of the reorder buffer.
+        //!
+        class TSDUCKDLL Statistics
+        {
+        public:
+            uint64_t rtp_datagrams = 0;        //!< Number of received RTP datagrams.
+            uint64_t non_rtp_datagrams = 0;    //!< Number of received datagrams which are not RTP packets.
+            uint64_t reordered_datagrams = 0;  //!< Number of RTP datagrams which were received out of order and reordered.
+            uint64_t missing_datagrams = 0;    //!< Number of RTP datagrams which were declared lost.
+            uint64_t late_datagrams = 0;       //!< Number of RTP datagrams received after being declared lost or returned.
+            uint64_t duplicate_datagrams = 0;  //!< Number of duplicate RTP datagrams in the reorder window.
+            uint64_t resync_count = 0;         //!< Number of resynchronizations on large sequence number jumps or SSRC changes.
+            uint64_t oversized_datagrams = 0;  //!< Number of datagrams which were larger than the reception buffer and dropped.
+        };
+
+        //!
+        //! Get the reorder buffer statistics.
+        //! @return A constant reference to the statistics.
+        //!
+        const Statistics& statistics() const { return _stats; }
+
+    private:
+        static constexpr size_t NONE = NPOS;
+
+        // Description of a datagram in one buffer.
+        class Slot
+        {
+        public:
+            ByteBlock        data {};  // Held datagram, when not in the reception buffer.
+            size_t           size = 0;
+            uint16_t         seq = 0;
+            cn::microseconds timestamp {-1};
+            TimeSource       timesource = TimeSource::UNDEFINED;
+            monotonic_time   arrival {};
+        };
+
+        Report*             _report;
+        int                 _severity = Severity::Info;
+        UString             _prefix {};
+        Statistics          _stats {};
+        cn::milliseconds    _max_delay {};
+        size_t              _datagram_size = 0;
+        ByteBlock           _recv_data {};     // Reception buffer, maximum datagram size.
+        size_t              _in_recv = NONE;   // Datagram which is still in the reception buffer.
+        std::vector<Slot>   _slots {};         // Description of each datagram, window + 1.
+        std::vector<size_t> _free {};          // Stack of free buffer indexes.
+        std::vector<size_t> _ring {};          // Reorder window, buffer index or NONE, from _head.
+        size_t              _head = 0;         // Index in _ring of the next sequence number to return.
+        size_t              _held = 0;         // Number of datagrams in _ring.
+        size_t              _receiving = NONE; // Buffer which was given to the receiver.
+        size_t              _parked = NONE;    // Datagram which is too far ahead of the window.
+        bool                _resync = false;   // The parked datagram starts a new sequence.
+        size_t              _bypass = NONE;    // Non-RTP datagram to return immediately.
+        bool                _started = false;
+        uint16_t            _next = 0;         // Next sequence number to return.
+        uint16_t            _highest = 0;      // Highest received sequence number.
+        uint32_t            _ssrc = 0;         // SSRC of the RTP stream.
+        monotonic_time      _blocked_since {}; // Time since the held datagrams are waiting for a missing one.
+
+        // Address of a datagram buffer.
+        uint8_t* data(size_t index) { return index == _in_recv ? _recv_data.data() : _slots[index].data.data(); }
+
+        // Insert a datagram in the reorder window. The sequence number must be in the window.
+        void place(size_t index, monotonic_time now);
+
+        // Restart the sequence with a datagram.
+        void restart(size_t index, monotonic_time now);
+
+        // Return the content of a datagram buffer and release it.
+        void output(size_t index, uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource);
+
+        // Skip up to 'max' missing datagrams at head of the window.
+        void skipMissing(size_t max, bool count);
+
+        // Release a datagram buffer.
+        void release(size_t index);
+    };
+}
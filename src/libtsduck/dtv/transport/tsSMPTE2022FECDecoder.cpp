@@ -0,0 +1,311 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsSMPTE2022FECDecoder.h"
+#include "tsMemory.h"
+
+
+//----------------------------------------------------------------------------
+// Constructor and reset.
+//----------------------------------------------------------------------------
+
+ts::SMPTE2022FECDecoder::SMPTE2022FECDecoder(size_t window)
+{
+    reset(window);
+}
+
+void ts::SMPTE2022FECDecoder::reset(size_t window)
+{
+    _stats = Statistics();
+    _window = std::clamp<size_t>(window, 1, 16000);
+    _started = false;
+    _next = _last = 0;
+    _ssrc = 0;
+
+    // The slot ring contains the history of past packets (for recovery) and up to twice
+    // the reorder window of future packets. Its size must be a power of 2 to keep the
+    // mapping of sequence numbers consistent when they wrap up after 0xFFFF.
+    size_t size = 1;
+    while (size < 2 * _window + FEC2022_MAX_MATRIX) {
+        size *= 2;
+    }
+    _slots.resize(size);
+    for (auto& s : _slots) {
+        s.valid = false;
+    }
+
+    // Number of pending FEC packets: typically a few matrices.
+    _fec.resize(std::max(_window, 2 * (FEC2022_MAX_COLUMNS + FEC2022_MAX_ROWS)));
+    for (auto& f : _fec) {
+        f.valid = false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Add a media RTP packet.
+//----------------------------------------------------------------------------
+
+bool ts::SMPTE2022FECDecoder::addMediaPacket(const uint8_t* data, size_t size)
+{
+    if (RTPHeaderSize(data, size) == 0) {
+        _stats.invalid_packets++;
+        return false;
+    }
+
+    _stats.media_packets++;
+    const uint16_t seq = GetUInt16(data + 2);
+
+    if (!_started) {
+        _started = true;
+        _next = _last = seq;
+    }
+    else {
+        const int diff = RTPSequenceDiff(_next, seq);
+        if (diff < 0) {
+            // The packet was already returned, recovered or declared lost.
+            if (hasPacket(seq)) {
+                _stats.duplicate_packets++;
+            }
+            else {
+                _stats.late_packets++;
+            }
+            return true;
+        }
+        else if (diff >= int(2 * _window)) {
+            // Large jump in sequence numbers, probably a restart of the source, forget the past.
+            _stats.resync_count++;
+            for (auto& s : _slots) {
+                s.valid = false;
+            }
+            for (auto& f : _fec) {
+                f.valid = false;
+            }
+            _next = _last = seq;
+        }
+        else if (RTPSequenceDiff(_last, seq) > 0) {
+            _last = seq;
+        }
+    }
+
+    Slot& sl(slot(seq));
+    if (sl.valid && sl.seq == seq) {
+        _stats.duplicate_packets++;
+        return true;
+    }
+
+    // Reuse the slot buffer, no reallocation when the size does not increase.
+    sl.valid = true;
+    sl.seq = seq;
+    sl.data.resize(size);
+    MemCopy(sl.data.data(), data, size);
+    _ssrc = GetUInt32(data + 8);
+
+    // Try to recover when the next packet to return is missing.
+    if (!hasPacket(_next)) {
+        recover();
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Add a column or row FEC packet.
+//----------------------------------------------------------------------------
+
+bool ts::SMPTE2022FECDecoder::addFECPacket(const uint8_t* data, size_t size)
+{
+    const size_t header_size = RTPHeaderSize(data, size);
+    if (header_size == 0 || size < header_size + FEC2022_HEADER_SIZE) {
+        _stats.invalid_packets++;
+        return false;
+    }
+
+    // Parse the FEC header. Only XOR-based FEC is defined in SMPTE 2022-1 (type 0).
+    const uint8_t* fh = data + header_size;
+    const uint16_t sn_base = GetUInt16(fh);
+    const uint8_t offset = fh[13];
+    const uint8_t na = fh[14];
+    if ((fh[12] & 0x80) != 0 || ((fh[12] >> 3) & 0x07) != 0 || offset == 0 || na == 0) {
+        _stats.invalid_packets++;
+        return false;
+    }
+    if ((fh[12] & 0x40) != 0) {
+        _stats.row_packets++;
+    }
+    else {
+        _stats.column_packets++;
+    }
+
+    // Ignore obsolete FEC packets, when all protected packets are already returned.
+    if (_started && RTPSequenceDiff(_next, uint16_t(sn_base + (na - 1) * offset)) < 0) {
+        return true;
+    }
+
+    // Find a free entry in the pool of FEC packets. If there is none, replace the oldest one.
+    FECPacket* fec = nullptr;
+    for (auto& f : _fec) {
+        if (!f.valid) {
+            fec = &f;
+            break;
+        }
+        else if (fec == nullptr || RTPSequenceDiff(fec->sn_base, f.sn_base) < 0) {
+            fec = &f;
+        }
+    }
+    assert(fec != nullptr);
+
+    fec->valid = true;
+    fec->sn_base = sn_base;
+    fec->length = GetUInt16(fh + 2);
+    fec->pt = fh[4] & 0x7F;
+    fec->timestamp = GetUInt32(fh + 8);
+    fec->offset = offset;
+    fec->na = na;
+    fec->payload.resize(size - header_size - FEC2022_HEADER_SIZE);
+    MemCopy(fec->payload.data(), fh + FEC2022_HEADER_SIZE, fec->payload.size());
+
+    if (_started && !hasPacket(_next)) {
+        recover();
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next media packet in sequence order, when available.
+//----------------------------------------------------------------------------
+
+bool ts::SMPTE2022FECDecoder::getPacket(uint8_t* buffer, size_t buffer_size, size_t& ret_size)
+{
+    ret_size = 0;
+    while (_started && RTPSequenceDiff(_next, _last) >= 0) {
+        const Slot& sl(slot(_next));
+        if (sl.valid && sl.seq == _next) {
+            // The next packet is available. The slot remains valid as history for future recoveries.
+            ret_size = std::min(buffer_size, sl.data.size());
+            MemCopy(buffer, sl.data.data(), ret_size);
+            _next++;
+            if (!hasPacket(_next) && RTPSequenceDiff(_next, _last) > 0) {
+                recover();
+            }
+            return true;
+        }
+        else if (RTPSequenceDiff(_next, _last) >= int(_window)) {
+            // Reorder window is full, the next packet is lost.
+            _stats.lost_packets++;
+            _next++;
+            if (!hasPacket(_next)) {
+                recover();
+            }
+        }
+        else {
+            // Wait for the missing packet.
+            break;
+        }
+    }
+    return false;
+}
+
+
+//----------------------------------------------------------------------------
+// Try to recover missing packets in the reorder window.
+//----------------------------------------------------------------------------
+
+void ts::SMPTE2022FECDecoder::recover()
+{
+    // Loop until no more packet can be recovered. Recovering a packet using a row FEC
+    // packet may allow the recovery of another packet using a column FEC packet.
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (auto& fec : _fec) {
+            if (!fec.valid) {
+                continue;
+            }
+
+            // Look for missing protected packets, stop at two since recovery is impossible.
+            size_t missing_count = 0;
+            uint16_t missing = 0;
+            for (size_t i = 0; i < fec.na && missing_count < 2; ++i) {
+                const uint16_t seq = uint16_t(fec.sn_base + i * fec.offset);
+                if (!hasPacket(seq)) {
+                    missing_count++;
+                    missing = seq;
+                }
+            }
+
+            if (missing_count == 0 || RTPSequenceDiff(_next, uint16_t(fec.sn_base + (fec.na - 1) * fec.offset)) < 0) {
+                // Nothing to recover, or all protected packets were already returned.
+                fec.valid = false;
+            }
+            else if (missing_count == 1 && RTPSequenceDiff(_next, missing) >= 0 && RTPSequenceDiff(missing, _last) > 0) {
+                // Exactly one missing packet, not yet returned, followed by received packets.
+                // Don't recover packets after the last received one, they are probably just not received yet.
+                progress = recoverPacket(fec, missing) || progress;
+                fec.valid = false;
+            }
+            else if (missing_count == 1 && RTPSequenceDiff(_next, missing) < 0) {
+                // The only missing packet is already declared lost.
+                fec.valid = false;
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Recover one media packet from a FEC packet.
+//----------------------------------------------------------------------------
+
+bool ts::SMPTE2022FECDecoder::recoverPacket(const FECPacket& fec, uint16_t seq)
+{
+    Slot& dst(slot(seq));
+    const size_t fec_size = fec.payload.size();
+    dst.valid = false;
+    dst.data.resize(RTP_HEADER_SIZE + fec_size);
+    uint8_t* payload = dst.data.data() + RTP_HEADER_SIZE;
+    MemCopy(payload, fec.payload.data(), fec_size);
+
+    // XOR all other protected packets. Shorter payloads are virtually padded with zeroes.
+    uint16_t length = fec.length;
+    uint8_t pt = fec.pt;
+    uint32_t timestamp = fec.timestamp;
+    for (size_t i = 0; i < fec.na; ++i) {
+        const uint16_t other = uint16_t(fec.sn_base + i * fec.offset);
+        if (other != seq) {
+            // The protected payload starts after the complete RTP header, including CSRC and extension.
+            const Slot& src(slot(other));
+            const size_t src_header = RTPHeaderSize(src.data.data(), src.data.size());
+            const size_t src_size = src.data.size() - src_header;
+            length ^= uint16_t(src_size);
+            pt ^= src.data[1] & 0x7F;
+            timestamp ^= GetUInt32(src.data.data() + 4);
+            MemXor(payload, payload, src.data.data() + src_header, std::min(src_size, fec_size));
+        }
+    }
+
+    if (length > fec_size) {
+        // Inconsistent FEC packet.
+        _stats.invalid_packets++;
+        return false;
+    }
+
+    // Rebuild the RTP header: V=2, no padding, no extension, no CSRC, no marker.
+    uint8_t* rtp = dst.data.data();
+    rtp[0] = 0x80;
+    rtp[1] = pt;
+    PutUInt16(rtp + 2, seq);
+    PutUInt32(rtp + 4, timestamp);
+    PutUInt32(rtp + 8, _ssrc);
+    dst.data.resize(RTP_HEADER_SIZE + length);
+    dst.seq = seq;
+    dst.valid = true;
+    _stats.recovered_packets++;
+    return true;
+}
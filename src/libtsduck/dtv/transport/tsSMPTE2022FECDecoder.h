@@ -0,0 +1,147 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  SMPTE 2022-1 FEC decoder for RTP streams.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsByteBlock.h"
+#include "tsIPProtocols.h"
+
+namespace ts {
+    //!
+    //! SMPTE 2022-1 Forward Error Correction (FEC) decoder for RTP streams.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! Media RTP packets and column or row FEC packets are passed to the decoder in their
+    //! order of arrival. Media packets are returned by getPacket() in RTP sequence order.
+    //!
+    //! The decoder uses a bounded reorder buffer. When a media packet is missing, the following
+    //! packets are held until the missing packet is received, recovered from FEC packets, or
+    //! declared lost when the number of held packets reaches the size of the reorder window.
+    //! Recovery is iterative: a packet which is recovered from a row FEC packet may be used to
+    //! recover another packet from a column FEC packet and vice versa.
+    //!
+    //! All buffers are allocated when the decoder is reset. There is no memory allocation
+    //! during reception, except when a datagram is larger than all previous ones in a buffer slot.
+    //!
+    class TSDUCKDLL SMPTE2022FECDecoder
+    {
+        TS_NOCOPY(SMPTE2022FECDecoder);
+    public:
+        //!
+        //! Default size of the reorder window in media packets (two FEC matrices of maximum size).
+        //!
+        static constexpr size_t DEFAULT_WINDOW = 2 * FEC2022_MAX_MATRIX;
+
+        //!
+        //! Constructor.
+        //! @param [in] window Size of the reorder window in media packets.
+        //!
+        SMPTE2022FECDecoder(size_t window = DEFAULT_WINDOW);
+
+        //!
+        //! Reset the decoder.
+        //! @param [in] window Size of the reorder window in media packets.
+        //!
+        void reset(size_t window = DEFAULT_WINDOW);
+
+        //!
+        //! Add a media RTP packet.
+        //! @param [in] data Address of the complete RTP packet, including the RTP header.
+        //! @param [in] size Size in bytes of the RTP packet.
+        //! @return True on success, false if the packet is not a valid RTP packet (and is ignored).
+        //!
+        bool addMediaPacket(const uint8_t* data, size_t size);
+
+        //!
+        //! Add a column or row FEC packet.
+        //! @param [in] data Address of the complete RTP packet, including the RTP and FEC headers.
+        //! @param [in] size Size in bytes of the RTP packet.
+        //! @return True on success, false if the packet is not a valid SMPTE 2022-1 FEC packet (and is ignored).
+        //!
+        bool addFECPacket(const uint8_t* data, size_t size);
+
+        //!
+        //! Get the next media packet in sequence order, when available.
+        //! @param [out] buffer Address of the buffer for the returned RTP packet.
+        //! @param [in] buffer_size Size in bytes of the buffer.
+        //! @param [out] ret_size Size in bytes of the returned RTP packet.
+        //! @return True if a media packet was returned, false if no packet is currently available.
+        //!
+        bool getPacket(uint8_t* buffer, size_t buffer_size, size_t& ret_size);
+
+        //!
+        //! Statistics of the decoder.
+        //!
+        class TSDUCKDLL Statistics
+        {
+        public:
+            uint64_t media_packets = 0;      //!< Number of received media packets.
+            uint64_t column_packets = 0;     //!< Number of received column FEC packets.
+            uint64_t row_packets = 0;        //!< Number of received row FEC packets.
+            uint64_t recovered_packets = 0;  //!< Number of media packets which were recovered using FEC.
+            uint64_t lost_packets = 0;       //!< Number of media packets which were lost and not recovered.
+            uint64_t duplicate_packets = 0;  //!< Number of duplicate media packets.
+            uint64_t late_packets = 0;       //!< Number of media packets received after being recovered or declared lost.
+            uint64_t invalid_packets = 0;    //!< Number of invalid media or FEC packets.
+            uint64_t resync_count = 0;       //!< Number of resynchronizations on large sequence number jumps.
+        };
+
+        //!
+        //! Get the decoder statistics.
+        //! @return A constant reference to the decoder statistics.
+        //!
+        const Statistics& statistics() const { return _stats; }
+
+    private:
+        // One media packet in the reorder buffer.
+        class Slot
+        {
+        public:
+            bool      valid = false;
+            uint16_t  seq = 0;
+            ByteBlock data {};
+        };
+
+        // One FEC packet, waiting to be used.
+        class FECPacket
+        {
+        public:
+            bool      valid = false;
+            uint16_t  sn_base = 0;
+            uint16_t  length = 0;     // Length recovery.
+            uint8_t   pt = 0;         // PT recovery.
+            uint32_t  timestamp = 0;  // TS recovery.
+            uint8_t   offset = 0;
+            uint8_t   na = 0;
+            ByteBlock payload {};
+        };
+
+        Statistics             _stats {};
+        size_t                 _window = DEFAULT_WINDOW;
+        bool                   _started = false;
+        uint16_t               _next = 0;    // Next sequence number to return.
+        uint16_t               _last = 0;    // Highest received sequence number.
+        uint32_t               _ssrc = 0;    // SSRC of the media stream.
+        std::vector<Slot>      _slots {};    // Reorder buffer and history, indexed by sequence number.
+        std::vector<FECPacket> _fec {};      // Pool of FEC packets.
+
+        // Get the slot for a sequence number.
+        Slot& slot(uint16_t seq) { return _slots[seq % _slots.size()]; }
+        bool hasPacket(uint16_t seq) { const Slot& s(slot(seq)); return s.valid && s.seq == seq; }
+
+        // Try to recover missing packets in the reorder window.
+        void recover();
+
+        // Recover one media packet from a FEC packet. Return true if the packet was recovered.
+        bool recoverPacket(const FECPacket& fec, uint16_t seq);
+    };
+}
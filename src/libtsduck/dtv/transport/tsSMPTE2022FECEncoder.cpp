@@ -0,0 +1,151 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsSMPTE2022FECEncoder.h"
+#include "tsMemory.h"
+
+
+//----------------------------------------------------------------------------
+// Reset the encoder with a new FEC matrix.
+//----------------------------------------------------------------------------
+
+bool ts::SMPTE2022FECEncoder::reset(size_t columns, size_t rows, bool row_fec, Report& report)
+{
+    if (columns < FEC2022_MIN_COLUMNS || columns > FEC2022_MAX_COLUMNS ||
+        rows < FEC2022_MIN_ROWS || rows > FEC2022_MAX_ROWS ||
+        columns * rows > FEC2022_MAX_MATRIX)
+    {
+        report.error(u"invalid SMPTE 2022-1 FEC matrix %dx%d, L must be in %d-%d, D in %d-%d, LxD up to %d",
+                     columns, rows, FEC2022_MIN_COLUMNS, FEC2022_MAX_COLUMNS, FEC2022_MIN_ROWS, FEC2022_MAX_ROWS, FEC2022_MAX_MATRIX);
+        return false;
+    }
+
+    // Keep the allocated packet buffers when the number of columns does not change.
+    _columns.resize(columns);
+    for (auto& col : _columns) {
+        col.count = 0;
+    }
+    _row.count = 0;
+    _rows = rows;
+    _row_fec = row_fec;
+    _position = 0;
+    _last_column = 0;
+    _column_ready = _row_ready = false;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Add a media RTP packet.
+//----------------------------------------------------------------------------
+
+bool ts::SMPTE2022FECEncoder::addPacket(const uint8_t* data, size_t size)
+{
+    _column_ready = _row_ready = false;
+    if (_columns.empty() || RTPHeaderSize(data, size) == 0) {
+        return false;
+    }
+
+    // Position of the packet in the matrix.
+    const size_t cols = _columns.size();
+    const size_t col = _position % cols;
+    const size_t row = _position / cols;
+
+    // Column FEC: completed on the last row.
+    Group& column(_columns[col]);
+    column.add(data, size);
+    if (row + 1 == _rows) {
+        column.build(_column_sequence++, false, uint8_t(cols), uint8_t(_rows));
+        _last_column = col;
+        _column_ready = true;
+    }
+
+    // Row FEC: completed on the last column.
+    if (_row_fec) {
+        _row.add(data, size);
+        if (col + 1 == cols) {
+            _row.build(_row_sequence++, true, 1, uint8_t(cols));
+            _row_ready = true;
+        }
+    }
+
+    _position = (_position + 1) % (cols * _rows);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Accumulate one media packet in a FEC packet.
+//----------------------------------------------------------------------------
+
+void ts::SMPTE2022FECEncoder::Group::add(const uint8_t* data, size_t size)
+{
+    constexpr size_t header_size = RTP_HEADER_SIZE + FEC2022_HEADER_SIZE;
+    // The protected payload starts after the complete RTP header of the media packet.
+    const size_t rtp_size = RTPHeaderSize(data, size);
+    const uint8_t* payload = data + rtp_size;
+    const size_t payload_size = size - rtp_size;
+    const uint32_t ts = GetUInt32(data + 4);
+
+    if (count == 0) {
+        // First protected packet, simply copy the payload.
+        sn_base = GetUInt16(data + 2);
+        length = uint16_t(payload_size);
+        pt = data[1] & 0x7F;
+        timestamp = ts;
+        packet.resize(header_size + payload_size);
+        MemCopy(packet.data() + header_size, payload, payload_size);
+    }
+    else {
+        length ^= uint16_t(payload_size);
+        pt ^= data[1] & 0x7F;
+        timestamp ^= ts;
+        // Shorter payloads are virtually padded with zeroes.
+        const size_t previous_size = packet.size() - header_size;
+        if (payload_size > previous_size) {
+            packet.resize(header_size + payload_size);
+            MemCopy(packet.data() + header_size + previous_size, payload + previous_size, payload_size - previous_size);
+        }
+        uint8_t* fec = packet.data() + header_size;
+        MemXor(fec, fec, payload, std::min(payload_size, previous_size));
+    }
+    last_ts = ts;
+    count++;
+}
+
+
+//----------------------------------------------------------------------------
+// Finalize the FEC packet.
+//----------------------------------------------------------------------------
+
+void ts::SMPTE2022FECEncoder::Group::build(uint16_t sequence, bool row, uint8_t offset, uint8_t na)
+{
+    uint8_t* p = packet.data();
+
+    // RTP header: V=2, no padding, no extension, no CSRC, SSRC=0.
+    p[0] = 0x80;
+    p[1] = FEC2022_RTP_PT;
+    PutUInt16(p + 2, sequence);
+    PutUInt32(p + 4, last_ts);
+    PutUInt32(p + 8, 0);
+
+    // SMPTE 2022-1 FEC header.
+    p += RTP_HEADER_SIZE;
+    PutUInt16(p, sn_base);
+    PutUInt16(p + 2, length);
+    p[4] = 0x80 | pt;             // E=1, PT recovery
+    PutUInt24(p + 5, 0);          // Mask
+    PutUInt32(p + 8, timestamp);  // TS recovery
+    p[12] = row ? 0x40 : 0x00;    // X=0, D, type=0 (XOR), index=0
+    p[13] = offset;
+    p[14] = na;
+    p[15] = 0;                    // SNBase ext bits
+
+    // Next FEC packet starts from scratch.
+    count = 0;
+}
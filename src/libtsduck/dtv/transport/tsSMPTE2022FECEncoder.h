@@ -0,0 +1,127 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  SMPTE 2022-1 FEC encoder for RTP streams.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsByteBlock.h"
+#include "tsIPProtocols.h"
+#include "tsReport.h"
+
+namespace ts {
+    //!
+    //! SMPTE 2022-1 Forward Error Correction (FEC) encoder for RTP streams.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! Media RTP packets are logically arranged in a matrix of L columns and D rows.
+    //! A column FEC packet protects the D packets in a column. A row FEC packet protects
+    //! the L packets in a row. FEC packets are built as an XOR of the protected RTP packets.
+    //! In SMPTE 2022-1, column FEC packets are sent on the UDP port of the media stream plus 2
+    //! and row FEC packets are sent on the UDP port of the media stream plus 4.
+    //!
+    //! The media packets must be passed to the encoder in the order of their transmission.
+    //! After each media packet, at most one column FEC packet and one row FEC packet are
+    //! completed and ready to be sent.
+    //!
+    class TSDUCKDLL SMPTE2022FECEncoder
+    {
+        TS_NOCOPY(SMPTE2022FECEncoder);
+    public:
+        //!
+        //! Constructor.
+        //!
+        SMPTE2022FECEncoder() = default;
+
+        //!
+        //! Reset the encoder with a new FEC matrix.
+        //! @param [in] columns Number of columns (L) in the FEC matrix.
+        //! @param [in] rows Number of rows (D) in the FEC matrix.
+        //! @param [in] row_fec When false, generate column FEC packets only (1-D FEC).
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on invalid matrix size.
+        //!
+        bool reset(size_t columns, size_t rows, bool row_fec, Report& report);
+
+        //!
+        //! Add a media RTP packet.
+        //! @param [in] data Address of the complete RTP packet, including the RTP header.
+        //! @param [in] size Size in bytes of the RTP packet.
+        //! @return True on success, false if the packet is not a valid RTP packet (and is ignored).
+        //!
+        bool addPacket(const uint8_t* data, size_t size);
+
+        //!
+        //! Check if a column FEC packet was completed by the last media packet.
+        //! @return True if a column FEC packet is ready.
+        //!
+        bool columnPacketReady() const { return _column_ready; }
+
+        //!
+        //! Check if a row FEC packet was completed by the last media packet.
+        //! @return True if a row FEC packet is ready.
+        //!
+        bool rowPacketReady() const { return _row_ready; }
+
+        //!
+        //! Get the last completed column FEC packet.
+        //! @return A constant reference to the complete RTP packet. Valid when columnPacketReady() is true.
+        //!
+        const ByteBlock& columnPacket() const { return _columns[_last_column].packet; }
+
+        //!
+        //! Get the last completed row FEC packet.
+        //! @return A constant reference to the complete RTP packet. Valid when rowPacketReady() is true.
+        //!
+        const ByteBlock& rowPacket() const { return _row.packet; }
+
+        //!
+        //! Get the number of columns (L) in the FEC matrix.
+        //! @return The number of columns in the FEC matrix.
+        //!
+        size_t columns() const { return _columns.size(); }
+
+        //!
+        //! Get the number of rows (D) in the FEC matrix.
+        //! @return The number of rows in the FEC matrix.
+        //!
+        size_t rows() const { return _rows; }
+
+    private:
+        // Computation of one FEC packet.
+        class Group
+        {
+        public:
+            uint16_t  sn_base = 0;    // Sequence number of first protected packet.
+            size_t    count = 0;      // Number of protected packets so far.
+            uint16_t  length = 0;     // XOR of payload lengths.
+            uint8_t   pt = 0;         // XOR of payload types.
+            uint32_t  timestamp = 0;  // XOR of timestamps.
+            uint32_t  last_ts = 0;    // Timestamp of last protected packet.
+            ByteBlock packet {};      // RTP FEC packet, XOR of payloads after the headers.
+
+            // Accumulate one media packet.
+            void add(const uint8_t* data, size_t size);
+            // Finalize the FEC packet.
+            void build(uint16_t sequence, bool row, uint8_t offset, uint8_t na);
+        };
+
+        size_t             _rows = 0;
+        size_t             _position = 0;      // Position of next media packet in the FEC matrix.
+        size_t             _last_column = 0;   // Index of last completed column FEC.
+        bool               _row_fec = false;
+        bool               _column_ready = false;
+        bool               _row_ready = false;
+        uint16_t           _column_sequence = 0;  // Next RTP sequence number in column FEC stream.
+        uint16_t           _row_sequence = 0;     // Next RTP sequence number in row FEC stream.
+        Group              _row {};
+        std::vector<Group> _columns {};
+    };
+}
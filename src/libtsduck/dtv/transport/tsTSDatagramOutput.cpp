@@ -60,8 +60,8 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
 
         args.option(u"pcr-pid", 0, Args::PIDVAL);
         args.help(u"pcr-pid",
-                  u"With --rtp, specify the PID containing the PCR's which are used as reference for RTP timestamps. "
-                  u"By default, use the first PID containing PCR's.");
+                  u"With --rtp or --pacing, specify the PID containing the PCR's which are used as reference "
+                  u"for RTP timestamps and launch times. By default, use the first PID containing PCR's.");
 
         args.option(u"start-sequence-number", 0, Args::UINT16);
         args.help(u"start-sequence-number",
@@ -74,6 +74,20 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"By default, use a random value. Do not modify unless there is a good reason to do so.");
     }
 
+    // Pacing is available with all types of output.
+    args.option(u"pacing");
+    args.help(u"pacing",
+              u"Send each datagram at its theoretical time, as computed from the PCR's and the bitrate, "
+              u"using a high precision timer. By default, datagrams are sent as soon as the packets are available, "
+              u"possibly in bursts. Use this option after the plugin 'regulate' for instance, to get evenly spaced "
+              u"datagrams at high bitrates. See also option --pcr-pid.");
+
+    args.option<cn::milliseconds>(u"pacing-delay");
+    args.help(u"pacing-delay",
+              u"With --pacing, specify the output latency. Each datagram is sent this delay after its theoretical time, "
+              u"to absorb the irregularities of the flow of packets. "
+              u"The default is " + UString::Chrono(DEFAULT_PACING_DELAY, true) + u".");
+
     // The following options are defined only when 204-byte packets are allowed.
     if (bool(_flags & TSDatagramOutputOptions::ALLOW_RS204)) {
         args.option(u"rs204");
@@ -124,6 +138,16 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"Specify the local UDP source port for outgoing packets. "
                   u"By default, a random source port is used.");
 
+        args.option(u"txtime");
+        args.help(u"txtime",
+                  u"With --pacing, pass the launch time of each datagram to the kernel (socket option SO_TXTIME) "
+                  u"instead of waiting for it in the application. "
+                  u"The datagram spacing is more precise and the CPU load is lower. "
+                  u"This option is supported on Linux only and requires the 'fq' queueing discipline "
+                  u"on the outgoing network interface. "
+                  u"The actual launch time of the datagrams is managed by the kernel. "
+                  u"Therefore, the pacing jitter is not reported with --verbose.");
+
         args.option(u"tos", 's', Args::INTEGER, 0, 1, 1, 255);
         args.help(u"tos",
                   u"Specifies the TOS (Type-Of-Service) socket option. Setting this value "
@@ -136,6 +160,29 @@ void ts::TSDatagramOutput::defineArgs(Args& args)
                   u"destination address. Remember that the default Multicast TTL is 1 "
                   u"on most systems.");
     }
+
+    // SMPTE 2022-1 FEC is sent on distinct UDP ports and is defined only with raw UDP and RTP.
+    if (_raw_udp && bool(_flags & TSDatagramOutputOptions::ALLOW_RTP)) {
+        args.option(u"fec-columns", 0, Args::INTEGER, 0, 1, FEC2022_MIN_COLUMNS, FEC2022_MAX_COLUMNS);
+        args.help(u"fec-columns", u"L",
+                  u"With --rtp, generate SMPTE 2022-1 Forward Error Correction (FEC) packets. "
+                  u"Specify the number of columns L in the FEC matrix. "
+                  u"Column FEC packets are sent to the destination UDP port plus " + UString::Decimal(FEC2022_COLUMN_PORT_OFFSET) +
+                  u" and row FEC packets are sent to the destination UDP port plus " + UString::Decimal(FEC2022_ROW_PORT_OFFSET) + u". "
+                  u"The product L x D cannot exceed " + UString::Decimal(FEC2022_MAX_MATRIX) + u". "
+                  u"The default is 10 when --fec-rows is specified.");
+
+        args.option(u"fec-rows", 0, Args::INTEGER, 0, 1, FEC2022_MIN_ROWS, FEC2022_MAX_ROWS);
+        args.help(u"fec-rows", u"D",
+                  u"With --rtp, generate SMPTE 2022-1 FEC packets. "
+                  u"Specify the number of rows D in the FEC matrix. "
+                  u"The default is 10 when --fec-columns is specified.");
+
+        args.option(u"fec-column-only");
+        args.help(u"fec-column-only",
+                  u"With --fec-columns or --fec-rows, generate column FEC packets only (1-D FEC). "
+                  u"By default, column and row FEC packets are generated (2-D FEC).");
+    }
 }
 
 
@@ -158,7 +205,15 @@ bool ts::TSDatagramOutput::loadArgs(DuckContext& duck, Args& args)
         args.getIntValue(_pcr_user_pid, u"pcr-pid", PID_NULL);
     }
 
+    _pacing = args.present(u"pacing");
+    args.getChronoValue(_pacing_delay, u"pacing-delay", DEFAULT_PACING_DELAY);
+
     if (_raw_udp) {
+        _use_txtime = args.present(u"txtime");
+        if (_use_txtime && !_pacing) {
+            args.error(u"--txtime requires --pacing");
+            return false;
+        }
         args.getSocketValue(_destination, u"");
         args.getIPValue(_local_addr, u"local-address");
         args.getIntValue(_local_port, u"local-port", IPAddress::AnyPort);
@@ -169,6 +224,21 @@ bool ts::TSDatagramOutput::loadArgs(DuckContext& duck, Args& args)
         _force_mc_local = args.present(u"force-local-multicast-outgoing");
     }
 
+    if (_raw_udp && bool(_flags & TSDatagramOutputOptions::ALLOW_RTP)) {
+        _use_fec = args.present(u"fec-columns") || args.present(u"fec-rows");
+        _fec_row = !args.present(u"fec-column-only");
+        args.getIntValue(_fec_columns, u"fec-columns", 10);
+        args.getIntValue(_fec_rows, u"fec-rows", 10);
+        if (_use_fec && !_use_rtp) {
+            args.error(u"SMPTE 2022-1 FEC requires --rtp");
+            return false;
+        }
+        if (_use_fec && _fec_columns * _fec_rows > FEC2022_MAX_MATRIX) {
+            args.error(u"SMPTE 2022-1 FEC matrix too large, L x D cannot exceed %d", FEC2022_MAX_MATRIX);
+            return false;
+        }
+    }
+
     if (bool(_flags & TSDatagramOutputOptions::ALLOW_RS204)) {
         _rs204_format = args.present(u"rs204");
     }
@@ -216,25 +286,30 @@ bool ts::TSDatagramOutput::open()
     }
 
     // Initialize raw UDP socket
-    if (_raw_udp) {
-        // IP generation selection
-        const IPSocketAddress local(_local_addr, _local_port);
-        const IP gen = (local.hasAddress() && local.generation() != _destination.generation()) ? IP::v6 : _destination.generation();
-        if (!_sock.open(gen)) {
+    if (_raw_udp && (!openSocket(_sock, _destination, _local_port) || (_use_txtime && !_sock.setTransmitTime(true)))) {
+        _sock.close();
+        return false;
+    }
+
+    // Initialize SMPTE 2022-1 FEC sockets on UDP ports +2 (columns) and +4 (rows).
+    if (_raw_udp && _use_fec) {
+        IPSocketAddress column_dest(_destination);
+        IPSocketAddress row_dest(_destination);
+        column_dest.setPort(_destination.port() + FEC2022_COLUMN_PORT_OFFSET);
+        row_dest.setPort(_destination.port() + FEC2022_ROW_PORT_OFFSET);
+        const bool fixed_port = _local_port != IPAddress::AnyPort;
+        if (!_fec.reset(_fec_columns, _fec_rows, _fec_row, _report) ||
+            !openSocket(_fec_column_sock, column_dest, fixed_port ? uint16_t(_local_port + FEC2022_COLUMN_PORT_OFFSET) : IPAddress::AnyPort))
+        {
+            _sock.close();
             return false;
         }
-        if ((_local_port != IPAddress::AnyPort && !_sock.reusePort(true)) ||
-            !_sock.bind(local) ||
-            !_sock.setDefaultDestination(_destination) ||
-            !_sock.setMulticastLoop(_mc_loopback) ||
-            (_force_mc_local && _destination.isMulticast() && _local_addr.hasAddress() && !_sock.setOutgoingMulticast(_local_addr)) ||
-            (_send_bufsize > 0 && !_sock.setSendBufferSize(_send_bufsize)) ||
-            (_tos >= 0 && !_sock.setTOS(_tos)) ||
-            (_ttl > 0 && !_sock.setTTL(_ttl)))
-        {
+        if (_fec_row && !openSocket(_fec_row_sock, row_dest, fixed_port ? uint16_t(_local_port + FEC2022_ROW_PORT_OFFSET) : IPAddress::AnyPort)) {
             _sock.close();
+            _fec_column_sock.close();
             return false;
         }
+        _report.verbose(u"SMPTE 2022-1 FEC, matrix L=%d, D=%d, %s", _fec_columns, _fec_rows, _fec_row ? u"column and row FEC" : u"column FEC only");
     }
 
     // Other states.
@@ -244,6 +319,10 @@ bool ts::TSDatagramOutput::open()
     _last_rtp_pcr_pkt = 0;
     _rtp_pcr_offset = 0;
     _pkt_count = 0;
+    _pace_started = false;
+    _pace_pcr = INVALID_PCR;
+    _pace_pcr_offset = 0;
+    _pacer.jitter().reset();
 
     _is_open = true;
     return true;
@@ -263,8 +342,17 @@ bool ts::TSDatagramOutput::close(const BitRate& bitrate, bool abort)
             success = sendPackets(_out_buffer.data(), _out_buffer_rs.data(), _out_count, bitrate);
             _out_count = 0;
         }
+        if (_pacing && !_use_txtime) {
+            _report.verbose(u"pacing jitter: %s", _pacer.jitter().summary(u"ns"));
+        }
         if (_raw_udp) {
             _sock.close();
+            if (_use_fec) {
+                _fec_column_sock.close();
+                if (_fec_row) {
+                    _fec_row_sock.close();
+                }
+            }
         }
         _is_open = false;
     }
@@ -272,6 +360,34 @@ bool ts::TSDatagramOutput::close(const BitRate& bitrate, bool abort)
 }
 
 
+//----------------------------------------------------------------------------
+// Open and configure a raw UDP socket.
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::openSocket(UDPSocket& sock, const IPSocketAddress& destination, uint16_t local_port)
+{
+    // IP generation selection
+    const IPSocketAddress local(_local_addr, local_port);
+    const IP gen = (local.hasAddress() && local.generation() != destination.generation()) ? IP::v6 : destination.generation();
+    if (!sock.open(gen)) {
+        return false;
+    }
+    if ((local_port != IPAddress::AnyPort && !sock.reusePort(true)) ||
+        !sock.bind(local) ||
+        !sock.setDefaultDestination(destination) ||
+        !sock.setMulticastLoop(_mc_loopback) ||
+        (_force_mc_local && destination.isMulticast() && _local_addr.hasAddress() && !sock.setOutgoingMulticast(_local_addr)) ||
+        (_send_bufsize > 0 && !sock.setSendBufferSize(_send_bufsize)) ||
+        (_tos >= 0 && !sock.setTOS(_tos)) ||
+        (_ttl > 0 && !sock.setTTL(_ttl)))
+    {
+        sock.close();
+        return false;
+    }
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Copy packets in the internal buffer.
 //----------------------------------------------------------------------------
@@ -383,6 +499,14 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
 {
     bool status = true;
 
+    // Look for a PCR in one of the packets to send, adjusted for the first packet in the datagram.
+    const uint64_t pcr = _use_rtp || _pacing ? datagramPCR(pkt, packet_count, bitrate) : INVALID_PCR;
+
+    // Compute the time at which the datagram shall be sent.
+    if (_pacing) {
+        _launch_time = launchTime(pcr, bitrate);
+    }
+
     if (_use_rtp) {
         // RTP datagram are relatively trivial to build, except the time stamp.
         // We cannot use the wall clock time because the plugin is likely to burst its output.
@@ -402,30 +526,6 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
         PutUInt16(&buffer[2], _rtp_sequence++);
         PutUInt32(&buffer[8], _rtp_ssrc);
 
-        // Look for a PCR in one of the packets to send.
-        // If found, we adjust this PCR for the first packet in the datagram.
-        uint64_t pcr = INVALID_PCR;
-        for (size_t i = 0; i < packet_count; i++) {
-            const bool hasPCR = pkt[i].hasPCR();
-            const PID pid = pkt[i].getPID();
-
-            // Detect PCR PID if not yet known.
-            if (hasPCR && _pcr_pid == PID_NULL) {
-                _pcr_pid = pid;
-            }
-
-            // Detect PCR presence.
-            if (hasPCR && pid == _pcr_pid) {
-                pcr = pkt[i].getPCR();
-                // If the bitrate is known and the packet containing the PCR is not the first one,
-                // compute the theoretical timestamp of the first packet in the datagram.
-                if (i > 0 && bitrate > 0) {
-                    pcr -= ((i * PKT_SIZE_BITS * uint64_t(SYSTEM_CLOCK_FREQ)) / bitrate).toInt();
-                }
-                break;
-            }
-        }
-
         // Extrapolate the RTP timestamp from the previous one, using current bitrate.
         // This value may be replaced if a valid PCR is present in this datagram.
         uint64_t rtp_pcr = _last_rtp_pcr;
@@ -477,17 +577,27 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
             MemCopy(buf, pkt, packet_count * PKT_SIZE);
             buffer.resize(RTP_HEADER_SIZE + packet_count * PKT_SIZE);
         }
-        status = _output->sendDatagram(buffer.data(), buffer.size());
+        status = sendDatagramAt(buffer.data(), buffer.size());
+
+        // Generate SMPTE 2022-1 FEC packets, when some of them are completed by this datagram.
+        if (_use_fec && _fec.addPacket(buffer.data(), buffer.size())) {
+            if (_fec.columnPacketReady()) {
+                status = _fec_column_sock.send(_fec.columnPacket().data(), _fec.columnPacket().size()) && status;
+            }
+            if (_fec.rowPacketReady()) {
+                status = _fec_row_sock.send(_fec.rowPacket().data(), _fec.rowPacket().size()) && status;
+            }
+        }
     }
     else if (_rs204_format) {
         // No RTP header, add TS trailer after each packet.
         ByteBlock buffer(packet_count * PKT_RS_SIZE);
         serialize(buffer.data(), buffer.size(), pkt, metadata, packet_count);
-        status = _output->sendDatagram(buffer.data(), buffer.size());
+        status = sendDatagramAt(buffer.data(), buffer.size());
     }
     else {
         // No RTP, no trailer, send TS packets directly as datagram.
-        status = _output->sendDatagram(pkt, packet_count * PKT_SIZE);
+        status = sendDatagramAt(pkt, packet_count * PKT_SIZE);
     }
 
     // Count packets datagram per datagram.
@@ -497,6 +607,112 @@ bool ts::TSDatagramOutput::sendPackets(const TSPacket* pkt, const TSPacketMetada
 }
 
 
+//----------------------------------------------------------------------------
+// Get the PCR of the first packet in a datagram.
+//----------------------------------------------------------------------------
+
+uint64_t ts::TSDatagramOutput::datagramPCR(const TSPacket* pkt, size_t packet_count, const BitRate& bitrate)
+{
+    for (size_t i = 0; i < packet_count; i++) {
+        const bool hasPCR = pkt[i].hasPCR();
+        const PID pid = pkt[i].getPID();
+
+        // Detect PCR PID if not yet known.
+        if (hasPCR && _pcr_pid == PID_NULL) {
+            _pcr_pid = pid;
+        }
+
+        // Detect PCR presence.
+        if (hasPCR && pid == _pcr_pid) {
+            uint64_t pcr = pkt[i].getPCR();
+            // If the bitrate is known and the packet containing the PCR is not the first one,
+            // compute the theoretical timestamp of the first packet in the datagram.
+            if (i > 0 && bitrate > 0) {
+                pcr -= ((i * PKT_SIZE_BITS * uint64_t(SYSTEM_CLOCK_FREQ)) / bitrate).toInt();
+            }
+            return pcr;
+        }
+    }
+    return INVALID_PCR;
+}
+
+
+//----------------------------------------------------------------------------
+// Compute the launch time of a datagram with --pacing.
+//----------------------------------------------------------------------------
+
+ts::monotonic_time ts::TSDatagramOutput::launchTime(uint64_t pcr, const BitRate& bitrate)
+{
+    // Maximum acceptable distance between the launch time and the current time, beyond the pacing delay.
+    constexpr cn::seconds max_drift = cn::seconds(1);
+
+    const monotonic_time now = monotonic_time::clock::now();
+    monotonic_time launch = now;
+
+    if (pcr != INVALID_PCR) {
+        // Accumulate all PCR wrap-down sequences, as in PCRRegulator.
+        if (_pace_pcr != INVALID_PCR && pcr < _pace_pcr && _pace_pcr - pcr > PCR_SCALE / 2) {
+            _pace_pcr_offset += PCR_SCALE;
+        }
+        _pace_pcr = pcr;
+        const uint64_t xpcr = _pace_pcr_offset + pcr;
+
+        // The launch time is the PCR, relative to the reference PCR.
+        if (_pace_started && xpcr >= _pace_pcr_base) {
+            launch = _pace_origin + cn::duration_cast<monotonic_time::duration>(PCR(xpcr - _pace_pcr_base));
+        }
+
+        // Resynchronize at the first PCR, on PCR discontinuities and when the output cannot follow.
+        if (!_pace_started || xpcr < _pace_pcr_base || launch < now - max_drift || launch > now + _pacing_delay + max_drift) {
+            if (_pace_started) {
+                _report.verbose(u"pacing resynchronized on PCR PID %n", _pcr_pid);
+            }
+            _pace_started = true;
+            _pace_pcr_base = xpcr;
+            _pace_origin = launch = now + _pacing_delay;
+        }
+    }
+    else if (_pace_started && bitrate > 0) {
+        // No PCR in this datagram, extrapolate from the previous datagram using the bitrate.
+        const monotonic_time next = _pace_last + PacketInterval<monotonic_time::duration>(bitrate, _pkt_count - _pace_last_pkt);
+        launch = std::min(next, now + _pacing_delay + max_drift);
+    }
+
+    _pace_last = launch;
+    _pace_last_pkt = _pkt_count;
+    return launch;
+}
+
+
+//----------------------------------------------------------------------------
+// Send one datagram to the output handler, at its launch time with --pacing.
+//----------------------------------------------------------------------------
+
+bool ts::TSDatagramOutput::sendDatagramAt(const void* address, size_t size)
+{
+    if (!_pacing) {
+        return _output->sendDatagram(address, size);
+    }
+
+    // Calibrate the timer in the output thread, on first datagram.
+    if (!_pace_calibrated) {
+        _pace_calibrated = true;
+        _report.debug(u"pacing timer spin margin: %s", _pacer.calibrate());
+    }
+
+    if (_use_txtime) {
+        // Let the kernel send the datagram at its launch time. Only wait to limit the advance.
+        // The actual launch time is not known here, the jitter is not recorded.
+        PacingTimer::SleepUntil(_launch_time - TXTIME_ADVANCE);
+        return _sock.sendAt(address, size, _launch_time);
+    }
+    else {
+        _pacer.waitUntil(_launch_time);
+        return _output->sendDatagram(address, size);
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of TSDatagramOutputHandlerInterface.
 // The object is its own handler in case of raw UDP output.
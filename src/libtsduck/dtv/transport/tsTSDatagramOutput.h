@@ -16,6 +16,8 @@
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsUDPSocket.h"
+#include "tsSMPTE2022FECEncoder.h"
+#include "tsPacingTimer.h"
 #include "tsIPProtocols.h"
 #include "tsEnumUtils.h"
 
@@ -60,6 +62,17 @@ namespace ts {
         //!
         static constexpr size_t MAX_PACKET_BURST = 128;
 
+        //!
+        //! Default output latency with --pacing. Datagrams are sent this delay after their
+        //! theoretical time, to absorb the irregularities of the upstream packet flow.
+        //!
+        static constexpr cn::milliseconds DEFAULT_PACING_DELAY = cn::milliseconds(20);
+
+        //!
+        //! With --txtime, datagrams are passed to the kernel this delay before their launch time.
+        //!
+        static constexpr cn::microseconds TXTIME_ADVANCE = cn::milliseconds(1);
+
         //!
         //! Constructor.
         //! @param [in,out] report Where to report errors.
@@ -143,6 +156,13 @@ namespace ts {
         bool            _mc_loopback = true;         // Multicast loopback option
         bool            _force_mc_local = false;     // Force multicast outgoing local interface
         size_t          _send_bufsize = 0;           // Socket send buffer size.
+        bool            _use_fec = false;            // Generate SMPTE 2022-1 FEC.
+        bool            _fec_row = true;             // Generate SMPTE 2022-1 row FEC.
+        size_t          _fec_columns = 0;            // SMPTE 2022-1 FEC matrix, number of columns (L).
+        size_t          _fec_rows = 0;               // SMPTE 2022-1 FEC matrix, number of rows (D).
+        bool            _pacing = false;             // Send each datagram at its theoretical time.
+        bool            _use_txtime = false;         // Pass the launch time of datagrams to the kernel (SO_TXTIME).
+        cn::milliseconds _pacing_delay {};           // Output latency with --pacing.
 
         // Working data.
         bool            _is_open = false;            // Currently in progress
@@ -158,11 +178,36 @@ namespace ts {
         TSPacketVector  _out_buffer {};              // Buffered packets for output with --enforce-burst
         TSPacketMetadataVector _out_buffer_rs {};    // Buffered RS trailers with --enforce-burst --rs204
         UDPSocket       _sock {&_report};            // Outgoing socket for raw UDP
+        UDPSocket       _fec_column_sock {&_report}; // Outgoing socket for SMPTE 2022-1 column FEC
+        UDPSocket       _fec_row_sock {&_report};    // Outgoing socket for SMPTE 2022-1 row FEC
+        SMPTE2022FECEncoder _fec {};                 // SMPTE 2022-1 FEC encoder
+        PacingTimer     _pacer {};                   // Hybrid sleep/spin timer with --pacing
+        bool            _pace_calibrated = false;    // The pacing timer was calibrated in the output thread.
+        bool            _pace_started = false;       // Pacing reference is set.
+        uint64_t        _pace_pcr = INVALID_PCR;     // Last PCR in PCR PID, for pacing.
+        uint64_t        _pace_pcr_base = 0;          // PCR value at _pace_origin, accumulated over PCR wrap-down.
+        uint64_t        _pace_pcr_offset = 0;        // Offset to add to PCR value, accumulate all PCR wrap-down sequences.
+        monotonic_time  _pace_origin {};             // Monotonic time of _pace_pcr_base.
+        monotonic_time  _pace_last {};               // Launch time of last datagram.
+        PacketCounter   _pace_last_pkt = 0;          // Packet index of last datagram.
+        monotonic_time  _launch_time {};             // Launch time of the datagram being sent.
+
+        // Get the PCR of the first packet in a datagram, INVALID_PCR if there is none.
+        uint64_t datagramPCR(const TSPacket* pkt, size_t packet_count, const BitRate& bitrate);
+
+        // Compute the launch time of a datagram with --pacing.
+        monotonic_time launchTime(uint64_t pcr, const BitRate& bitrate);
+
+        // Send one datagram to the output handler, at its launch time with --pacing.
+        bool sendDatagramAt(const void* address, size_t size);
 
         // Implementation of TSDatagramOutputHandlerInterface.
         // The object is its own handler in case of raw UDP output.
         virtual bool sendDatagram(const void* address, size_t size) override;
 
+        // Open and configure a raw UDP socket.
+        bool openSocket(UDPSocket& sock, const IPSocketAddress& destination, uint16_t local_port);
+
         // Copy packets in the internal buffer.
         void bufferPackets(const TSPacket* packet, const TSPacketMetadata* metadata, size_t count);
 
@@ -35,6 +35,8 @@
 #define JCN_CLASS  "java/lang/Class"
 #define JCN_OBJECT "java/lang/Object"
 #define JCN_STRING "java/lang/String"
+#define JCN_BUFFER "java/nio/Buffer"
+#define JCN_BYTE_BUFFER "java/nio/ByteBuffer"
 #define JCN_PLUGIN_EVENT_CONTEXT "io/tsduck/PluginEventContext"
 
 //
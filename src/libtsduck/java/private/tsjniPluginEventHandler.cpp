@@ -8,6 +8,7 @@
 
 #include "tsjniPluginEventHandler.h"
 #include "tsPluginEventData.h"
+#include "tsTSPacketMetadata.h"
 
 #if !defined(TS_NO_JAVA)
 
@@ -15,8 +16,9 @@
 // Constructors and destructors.
 //----------------------------------------------------------------------------
 
-ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method) :
-    _env(env)
+ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method, bool zero_copy) :
+    _env(env),
+    _zero_copy(zero_copy)
 {
     if (env != nullptr && obj != nullptr) {
         _obj_ref = env->NewGlobalRef(obj);
@@ -24,7 +26,13 @@ ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstrin
         // Cache the method id of the handler method in the io.tsduck.PluginEventContext class.
         if (handle_str != nullptr) {
             // Expected profile: boolean handlePluginEvent(PluginEventContext context, byte[] data);
-            _obj_method = env->GetMethodID(env->GetObjectClass(_obj_ref), handle_str, "(" JCS(JCN_PLUGIN_EVENT_CONTEXT) JCS_ARRAY(JCS_BYTE) ")" JCS_BOOLEAN);
+            // In zero-copy mode: boolean handlePluginEvent(PluginEventContext context, ByteBuffer data);
+            if (_zero_copy) {
+                _obj_method = env->GetMethodID(env->GetObjectClass(_obj_ref), handle_str, "(" JCS(JCN_PLUGIN_EVENT_CONTEXT) JCS(JCN_BYTE_BUFFER) ")" JCS_BOOLEAN);
+            }
+            else {
+                _obj_method = env->GetMethodID(env->GetObjectClass(_obj_ref), handle_str, "(" JCS(JCN_PLUGIN_EVENT_CONTEXT) JCS_ARRAY(JCS_BYTE) ")" JCS_BOOLEAN);
+            }
             env->ReleaseStringUTFChars(handle_method, handle_str);
         }
         // Get a global reference to class io.tsduck.PluginEventContext.
@@ -39,14 +47,45 @@ ts::jni::PluginEventHandler::PluginEventHandler(JNIEnv* env, jobject obj, jstrin
             _pec_constructor = env->GetMethodID(_pec_class, JCS_CONSTRUCTOR, "(" JCS_INT JCS_STRING JCS_INT JCS_INT JCS_INT JCS_LONG JCS_LONG JCS_BOOLEAN JCS_INT ")" JCS_VOID);
             // Get the id of the private field "byte[] _outputData":
             _pec_outdata = env->GetFieldID(_pec_class, "_outputData", JCS_ARRAY(JCS_BYTE));
+            // Get the id of the private method and field which are used in zero-copy mode:
+            // void reset(int ecode, String pname, int pindex, int pcount, int brate, long ppackets, long tpackets, boolean rdonly, int maxdsize, int dsize, ByteBuffer mdata)
+            _pec_reset = env->GetMethodID(_pec_class, "reset", "(" JCS_INT JCS_STRING JCS_INT JCS_INT JCS_INT JCS_LONG JCS_LONG JCS_BOOLEAN JCS_INT JCS_INT JCS(JCN_BYTE_BUFFER) ")" JCS_VOID);
+            _pec_outsize = env->GetFieldID(_pec_class, "_outputSize", JCS_INT);
+        }
+        // Methods of java.nio.Buffer and java.nio.ByteBuffer, used in zero-copy mode.
+        if (_zero_copy) {
+            clazz = env->FindClass(JCN_BUFFER);
+            if (clazz != nullptr) {
+                _buf_clear = env->GetMethodID(clazz, "clear", "()" JCS(JCN_BUFFER));
+                env->DeleteLocalRef(clazz);
+            }
+            clazz = env->FindClass(JCN_BYTE_BUFFER);
+            if (clazz != nullptr) {
+                _buf_read_only = env->GetMethodID(clazz, "asReadOnlyBuffer", "()" JCS(JCN_BYTE_BUFFER));
+                env->DeleteLocalRef(clazz);
+            }
         }
     }
-    _valid = _env != nullptr && _obj_ref != nullptr && _obj_method != nullptr && _pec_class != nullptr && _pec_constructor != nullptr && _pec_outdata != nullptr;
+    _valid = _env != nullptr && _obj_ref != nullptr && _obj_method != nullptr && _pec_class != nullptr && _pec_constructor != nullptr && _pec_outdata != nullptr &&
+        (!_zero_copy || (_pec_reset != nullptr && _pec_outsize != nullptr && _buf_clear != nullptr && _buf_read_only != nullptr));
 }
 
 ts::jni::PluginEventHandler::~PluginEventHandler()
 {
     if (_env != nullptr) {
+        clearCache(_env);
+        if (_pec_ref != nullptr) {
+            _env->DeleteGlobalRef(_pec_ref);
+            _pec_ref = nullptr;
+        }
+        if (_name_ref != nullptr) {
+            _env->DeleteGlobalRef(_name_ref);
+            _name_ref = nullptr;
+        }
+        if (_mdata_ref != nullptr) {
+            _env->DeleteGlobalRef(_mdata_ref);
+            _mdata_ref = nullptr;
+        }
         if (_obj_ref != nullptr) {
             _env->DeleteGlobalRef(_obj_ref);
             _obj_ref = nullptr;
@@ -68,7 +107,10 @@ ts::jni::PluginEventHandler::~PluginEventHandler()
 void ts::jni::PluginEventHandler::handlePluginEvent(const PluginEventContext& context)
 {
     JNIEnv* env = JNIEnvForCurrentThead();
-    if (env != nullptr && _valid) {
+    if (env != nullptr && _valid && _zero_copy) {
+        handleZeroCopy(env, context);
+    }
+    else if (env != nullptr && _valid) {
         PluginEventData* event_data = dynamic_cast<PluginEventData*>(context.pluginData());
         const bool valid_data = event_data != nullptr && event_data->data() != nullptr;
         const bool read_only_data = event_data == nullptr || event_data->readOnly();
@@ -132,19 +174,196 @@ void ts::jni::PluginEventHandler::handlePluginEvent(const PluginEventContext& co
 }
 
 
+//----------------------------------------------------------------------------
+// Event handling method in zero-copy mode.
+//----------------------------------------------------------------------------
+
+void ts::jni::PluginEventHandler::handleZeroCopy(JNIEnv* env, const PluginEventContext& context)
+{
+    PluginEventData* event_data = dynamic_cast<PluginEventData*>(context.pluginData());
+    const bool valid_data = event_data != nullptr && event_data->data() != nullptr;
+    const bool read_only_data = !valid_data || event_data->readOnly();
+    const size_t data_size = valid_data ? event_data->size() : 0;
+    const size_t max_data_size = read_only_data ? 0 : event_data->maxSize();
+
+    // The cached objects are shared by all plugins in which this handler is registered.
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Reuse the same context object and plugin name string.
+    if (_pec_ref == nullptr) {
+        const jobject pec = env->NewObject(_pec_class, _pec_constructor, jint(0), nullptr, jint(0), jint(0), jint(0), jlong(0), jlong(0), jboolean(true), jint(0));
+        if (pec != nullptr) {
+            _pec_ref = env->NewGlobalRef(pec);
+            env->DeleteLocalRef(pec);
+        }
+    }
+    if (_name_ref == nullptr || _name != context.pluginName()) {
+        if (_name_ref != nullptr) {
+            env->DeleteGlobalRef(_name_ref);
+            _name_ref = nullptr;
+        }
+        const jstring jname = ToJString(env, context.pluginName());
+        if (jname != nullptr) {
+            _name_ref = jstring(env->NewGlobalRef(jname));
+            _name = context.pluginName();
+            env->DeleteLocalRef(jname);
+        }
+    }
+
+    // Serialize the packet metadata in a reused direct ByteBuffer.
+    const TSPacketMetadata* mdata = valid_data ? event_data->metadata() : nullptr;
+    const size_t mdata_count = mdata == nullptr ? 0 : std::min(event_data->metadataCount(), (read_only_data ? data_size : max_data_size) / PKT_SIZE);
+    jobject jmdata = nullptr;
+    if (mdata_count > 0) {
+        const size_t mdata_size = mdata_count * TSPacketMetadata::SERIALIZATION_SIZE;
+        if (_mdata_ref == nullptr || _mdata.size() < mdata_size) {
+            if (_mdata_ref != nullptr) {
+                env->DeleteGlobalRef(_mdata_ref);
+                _mdata_ref = nullptr;
+            }
+            _mdata.resize(mdata_size);
+            const jobject buf = env->NewDirectByteBuffer(_mdata.data(), jlong(_mdata.size()));
+            if (buf != nullptr) {
+                _mdata_ref = env->NewGlobalRef(buf);
+                env->DeleteLocalRef(buf);
+            }
+        }
+        for (size_t i = 0; i < mdata_count; ++i) {
+            mdata[i].serialize(_mdata.data() + i * TSPacketMetadata::SERIALIZATION_SIZE, TSPacketMetadata::SERIALIZATION_SIZE);
+        }
+        if (_mdata_ref != nullptr) {
+            env->DeleteLocalRef(env->CallObjectMethod(_mdata_ref, _buf_clear));
+            jmdata = _mdata_ref;
+        }
+    }
+
+    // Direct ByteBuffer over the event data.
+    const jobject jdata = valid_data ? directBuffer(env, event_data->data(), read_only_data ? data_size : max_data_size, read_only_data) : nullptr;
+
+    // Call the Java event handler.
+    jboolean success = true;
+    if (_pec_ref != nullptr && _name_ref != nullptr) {
+        env->CallVoidMethod(_pec_ref, _pec_reset,
+                            jint(context.eventCode()), _name_ref,
+                            jint(context.pluginIndex()), jint(context.pluginCount()),
+                            jint(context.bitrate().toInt()),
+                            jlong(context.pluginPackets()),
+                            jlong(context.totalPackets()),
+                            jboolean(read_only_data),
+                            jint(max_data_size),
+                            jint(data_size),
+                            jmdata);
+        success = env->CallBooleanMethod(_obj_ref, _obj_method, _pec_ref, jdata);
+    }
+
+    // If the event data are modifiable, check if the Java handler set some output data.
+    if (success && valid_data && !read_only_data) {
+        const jbyteArray joutdata = jbyteArray(env->GetObjectField(_pec_ref, _pec_outdata));
+        const jint outsize = env->GetIntField(_pec_ref, _pec_outsize);
+        size_t new_size = data_size;
+        if (joutdata != nullptr) {
+            // Output data were returned in a byte array.
+            const jsize arrsize = env->GetArrayLength(joutdata);
+            if (size_t(arrsize) <= max_data_size) {
+                env->GetByteArrayRegion(joutdata, 0, arrsize, reinterpret_cast<jbyte*>(event_data->outputData()));
+                new_size = size_t(arrsize);
+            }
+            env->DeleteLocalRef(joutdata);
+        }
+        else if (outsize >= 0 && size_t(outsize) <= max_data_size) {
+            // Output data were directly written in the buffer.
+            new_size = size_t(outsize);
+        }
+        event_data->updateSize(new_size);
+
+        // Get back the metadata of the returned packets.
+        TSPacketMetadata* outmdata = event_data->outputMetadata();
+        if (outmdata != nullptr && jmdata != nullptr) {
+            for (size_t i = 0; i < std::min(mdata_count, new_size / PKT_SIZE); ++i) {
+                outmdata[i].deserialize(_mdata.data() + i * TSPacketMetadata::SERIALIZATION_SIZE, TSPacketMetadata::SERIALIZATION_SIZE);
+            }
+        }
+    }
+
+    // Set error indicator if the Java callback returned false.
+    if (!success && event_data != nullptr) {
+        event_data->setError(true);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Get a direct ByteBuffer over a memory area.
+//----------------------------------------------------------------------------
+
+jobject ts::jni::PluginEventHandler::directBuffer(JNIEnv* env, const uint8_t* data, size_t size, bool read_only)
+{
+    // The plugins typically pass slices of the tsp buffer, the same areas are often reused.
+    // A buffer over a new area is cached. When the cache is full, it is reset.
+    auto it = _buffers.find(std::make_pair(data, size));
+    if (it == _buffers.end()) {
+        if (_buffers.size() >= MAX_CACHED_BUFFERS) {
+            clearCache(env);
+        }
+        it = _buffers.emplace(std::make_pair(data, size), DirectBuffers()).first;
+    }
+    DirectBuffers& bufs(it->second);
+
+    if (bufs.read_write == nullptr) {
+        const jobject buf = env->NewDirectByteBuffer(const_cast<uint8_t*>(data), jlong(size));
+        if (buf == nullptr) {
+            return nullptr;
+        }
+        bufs.read_write = env->NewGlobalRef(buf);
+        env->DeleteLocalRef(buf);
+    }
+    if (read_only && bufs.read_only == nullptr) {
+        const jobject buf = env->CallObjectMethod(bufs.read_write, _buf_read_only);
+        if (buf == nullptr) {
+            return nullptr;
+        }
+        bufs.read_only = env->NewGlobalRef(buf);
+        env->DeleteLocalRef(buf);
+    }
+
+    // Reset position and limit, the handler may have moved them in a previous event.
+    const jobject result = read_only ? bufs.read_only : bufs.read_write;
+    env->DeleteLocalRef(env->CallObjectMethod(result, _buf_clear));
+    return result;
+}
+
+
+//----------------------------------------------------------------------------
+// Release all cached direct ByteBuffer.
+//----------------------------------------------------------------------------
+
+void ts::jni::PluginEventHandler::clearCache(JNIEnv* env)
+{
+    for (auto& it : _buffers) {
+        if (it.second.read_write != nullptr) {
+            env->DeleteGlobalRef(it.second.read_write);
+        }
+        if (it.second.read_only != nullptr) {
+            env->DeleteGlobalRef(it.second.read_only);
+        }
+    }
+    _buffers.clear();
+}
+
+
 //----------------------------------------------------------------------------
 // Implementation of native methods of Java class io.tsduck.AbstractPluginEventHandler
 //----------------------------------------------------------------------------
 
 //
-// private native void initNativeObject(String methodName);
+// private native void initNativeObject(String methodName, boolean zeroCopy);
 //
-TSDUCKJNI void JNICALL Java_io_tsduck_AbstractPluginEventHandler_initNativeObject(JNIEnv* env, jobject obj, jstring method)
+TSDUCKJNI void JNICALL Java_io_tsduck_AbstractPluginEventHandler_initNativeObject(JNIEnv* env, jobject obj, jstring method, jboolean zero_copy)
 {
     // Make sure we do not allocate twice (and lose previous instance).
     ts::jni::PluginEventHandler* handler = ts::jni::GetPointerField<ts::jni::PluginEventHandler>(env, obj, "nativeObject");
     if (env != nullptr && handler == nullptr) {
-        ts::jni::SetPointerField(env, obj, "nativeObject", new ts::jni::PluginEventHandler(env, obj, method));
+        ts::jni::SetPointerField(env, obj, "nativeObject", new ts::jni::PluginEventHandler(env, obj, method, bool(zero_copy)));
     }
 }
 
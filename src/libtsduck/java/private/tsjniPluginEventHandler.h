@@ -14,6 +14,7 @@
 #pragma once
 #include "tsPluginEventHandlerInterface.h"
 #include "tsjni.h"
+#include "tsByteBlock.h"
 
 #if !defined(TS_NO_JAVA)
 namespace ts {
@@ -37,8 +38,13 @@ namespace ts {
             //! @code
             //! boolean handlePluginEvent(PluginEventContext context, byte[] data);
             //! @endcode
+            //! @param [in] zero_copy If true, the event data are passed as a direct ByteBuffer over the
+            //! plugin buffer and the Java profile of the method shall be
+            //! @code
+            //! boolean handlePluginEvent(PluginEventContext context, java.nio.ByteBuffer data);
+            //! @endcode
             //!
-            PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method);
+            PluginEventHandler(JNIEnv* env, jobject obj, jstring handle_method, bool zero_copy = false);
 
             //!
             //! Destructor.
@@ -50,6 +56,25 @@ namespace ts {
             // Inherited from ts::PluginEventHandlerInterface
             virtual void handlePluginEvent(const PluginEventContext& context) override;
 
+            // Maximum number of cached direct ByteBuffer.
+            static constexpr size_t MAX_CACHED_BUFFERS = 64;
+
+            // Direct ByteBuffer objects over one memory area, global references.
+            struct DirectBuffers
+            {
+                jobject read_write = nullptr;
+                jobject read_only = nullptr;
+            };
+
+            // Zero-copy version of handlePluginEvent().
+            void handleZeroCopy(JNIEnv* env, const PluginEventContext& context);
+
+            // Get a direct ByteBuffer over a memory area, position zero, limit at capacity.
+            jobject directBuffer(JNIEnv* env, const uint8_t* data, size_t size, bool read_only);
+
+            // Release all cached references.
+            void clearCache(JNIEnv* env);
+
             bool      _valid = false;              // If true, all JNI references are valid.
             JNIEnv*   _env = nullptr;              // JNI environment in the thread which called the constructor.
             jobject   _obj_ref = nullptr;          // Global JNI reference to the Java object to notify.
@@ -57,6 +82,20 @@ namespace ts {
             jclass    _pec_class = nullptr;        // Global reference to Java class io.tsduck.PluginEventContext
             jmethodID _pec_constructor = nullptr;  // Constructor method to create a io.tsduck.PluginEventContext
             jfieldID  _pec_outdata = nullptr;      // Internal private field "_outputData" in io.tsduck.PluginEventContext
+
+            // Zero-copy mode: the context object and the direct ByteBuffer objects are reused.
+            bool      _zero_copy = false;
+            jmethodID _pec_reset = nullptr;        // Private method "reset" in io.tsduck.PluginEventContext
+            jfieldID  _pec_outsize = nullptr;      // Internal private field "_outputSize" in io.tsduck.PluginEventContext
+            jmethodID _buf_clear = nullptr;        // Method java.nio.Buffer.clear()
+            jmethodID _buf_read_only = nullptr;    // Method java.nio.ByteBuffer.asReadOnlyBuffer()
+            std::mutex _mutex {};                  // Protect the cached objects, the handler may be registered in several plugins.
+            jobject   _pec_ref = nullptr;          // Global reference to the reused io.tsduck.PluginEventContext.
+            jstring   _name_ref = nullptr;         // Global reference to the last plugin name.
+            UString   _name {};                    // Last plugin name.
+            ByteBlock _mdata {};                   // Serialized packet metadata.
+            jobject   _mdata_ref = nullptr;        // Global reference to a direct ByteBuffer over _mdata.
+            std::map<std::pair<const uint8_t*, size_t>, DirectBuffers> _buffers {};
         };
     }
 }
@@ -8,6 +8,8 @@
 
 package io.tsduck;
 
+import java.nio.ByteBuffer;
+
 /**
  * An abstract class which can be derived by applications to get plugin events.
  * @ingroup java
@@ -17,13 +19,24 @@ public abstract class AbstractPluginEventHandler extends NativeObject {
     /*
      * Set the address of the C++ object.
      */
-    private native void initNativeObject(String handlerMethodName);
+    private native void initNativeObject(String handlerMethodName, boolean zeroCopy);
 
     /**
      * Constructor (for subclasses).
+     * The event data are passed as a byte array to handlePluginEvent(PluginEventContext, byte[]).
      */
     protected AbstractPluginEventHandler() {
-        initNativeObject("handlePluginEvent");
+        this(false);
+    }
+
+    /**
+     * Constructor (for subclasses).
+     * @param zeroCopy If true, the event data are passed to handlePluginEvent(PluginEventContext, ByteBuffer)
+     * as a direct ByteBuffer which maps the plugin buffer, without copy. Otherwise, the event data are
+     * passed as a byte array to handlePluginEvent(PluginEventContext, byte[]).
+     */
+    protected AbstractPluginEventHandler(boolean zeroCopy) {
+        initNativeObject("handlePluginEvent", zeroCopy);
     }
 
     /**
@@ -43,10 +56,51 @@ public abstract class AbstractPluginEventHandler extends NativeObject {
      * The size of the returned data shall not exceed @a context.maxDataSize(). Otherwise,
      * it will be ignored.
      *
+     * This handler is used when the object was created without zero-copy mode.
+     * The default implementation does nothing and returns true.
+     *
      * @param context An instance of PluginEventContext containing the details of the event.
      * @param data A byte array containing the data of the event. This is a read-only
-     * sequence of bytes. There is no way to return data from Java to the plugin.
+     * sequence of bytes. Updated data are returned using @a context.setOutputData().
+     * @return True in case of success, false to set the error indicator of the event.
+     */
+    public boolean handlePluginEvent(PluginEventContext context, byte[] data) {
+        return true;
+    }
+
+    /**
+     * This handler is invoked when a plugin signals an event for which this object is registered,
+     * when the object was created in zero-copy mode.
+     *
+     * The event data are passed in @a data, a direct ByteBuffer which maps the plugin buffer,
+     * typically the packet buffer of tsp in the @e memory plugins. The ByteBuffer objects are
+     * reused by subsequent events: they are valid during the execution of handlePluginEvent()
+     * only and must not be kept or used after returning. The PluginEventContext object is
+     * reused in the same way.
+     *
+     * If @a context.readOnlyData() is true, @a data is a read-only buffer containing the
+     * @a context.dataSize() bytes of the event. Otherwise, @a data is a writable buffer of
+     * @a context.maxDataSize() bytes, starting with the @a context.dataSize() input bytes.
+     * The handler directly writes the output data in @a data and calls @a context.setOutputSize()
+     * with their size in bytes. In both cases, the position of @a data is zero and its limit
+     * is its capacity.
+     *
+     * When the plugin passes packet metadata, @a context.packetMetadata() returns a buffer
+     * with one serialized metadata structure per TS packet, see PluginEventContext.
+     *
+     * The number of packets per event is the number of packets per input or output operation
+     * in tsp, see the fields @a maxInputPackets and @a maxOutputPackets in TSProcessor.
+     *
+     * The default implementation copies the data into a byte array and invokes
+     * handlePluginEvent(PluginEventContext, byte[]).
+     *
+     * @param context An instance of PluginEventContext containing the details of the event.
+     * @param data A direct ByteBuffer over the data of the event.
      * @return True in case of success, false to set the error indicator of the event.
      */
-    abstract public boolean handlePluginEvent(PluginEventContext context, byte[] data);
+    public boolean handlePluginEvent(PluginEventContext context, ByteBuffer data) {
+        byte[] bytes = new byte[context.dataSize()];
+        data.duplicate().get(bytes);
+        return handlePluginEvent(context, bytes);
+    }
 }
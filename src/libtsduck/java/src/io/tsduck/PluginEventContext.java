@@ -8,6 +8,8 @@
 
 package io.tsduck;
 
+import java.nio.ByteBuffer;
+
 /**
  * Context of a plugin event.
  * Each time a plugin signals an event for the application, a PluginEventContext
@@ -16,6 +18,18 @@ package io.tsduck;
  */
 public class PluginEventContext {
 
+    /**
+     * Size in bytes of the serialized metadata of one TS packet in packetMetadata().
+     * The layout of the serialized metadata is:
+     * - byte 0: 0xB8 (constant).
+     * - bytes 1-8: input time stamp in PCR units (27 MHz), -1 if there is none.
+     * - bytes 9-12: bit mask of packet labels, bit N is label N.
+     * - byte 13: flags (0x80: input stuffing, 0x40: nullified, 0x20: datagram), type of input time stamp in the 4 LSB.
+     *
+     * Multi-byte values are big-endian, the default order of ByteBuffer.
+     */
+    static public final int METADATA_SIZE = 14;
+
     private int     _eventCode = 0;
     private String  _pluginName = "";
     private int     _pluginIndex = 0;
@@ -26,6 +40,9 @@ public class PluginEventContext {
     private boolean _readOnlyData = true;
     private int     _maxDataSize = 0;
     private byte[]  _outputData = null;
+    private int     _dataSize = 0;
+    private int     _outputSize = -1;
+    private ByteBuffer _packetMetadata = null;
 
     /**
      * Constructor.
@@ -59,6 +76,26 @@ public class PluginEventContext {
         _maxDataSize = maxdsize;
     }
 
+    /*
+     * Reinitialize the context for a new event, in zero-copy mode.
+     * Called from native code, the object is reused from one event to another.
+     */
+    private void reset(int ecode, String pname, int pindex, int pcount, int brate, long ppackets, long tpackets, boolean rdonly, int maxdsize, int dsize, ByteBuffer mdata) {
+        _eventCode = ecode;
+        _pluginName = pname;
+        _pluginIndex = pindex;
+        _pluginCount = pcount;
+        _bitrate = brate;
+        _pluginPackets = ppackets;
+        _totalPackets = tpackets;
+        _readOnlyData = rdonly;
+        _maxDataSize = maxdsize;
+        _dataSize = dsize;
+        _packetMetadata = mdata;
+        _outputData = null;
+        _outputSize = -1;
+    }
+
     /**
      * Get the event code.
      * @return A plugin-defined 32-bit code describing the event type.
@@ -133,6 +170,87 @@ public class PluginEventContext {
         return _readOnlyData ? 0 : _maxDataSize;
     }
 
+    /**
+     * Get the size in bytes of the input event data.
+     * This is useful in zero-copy mode when the event data buffer can be updated.
+     * Then, the capacity of the buffer is the maximum data size.
+     * @return Size in bytes of the input event data.
+     */
+    public int dataSize() {
+        return _dataSize;
+    }
+
+    /**
+     * Set the size of the event returned data, in zero-copy mode.
+     * The event handler directly writes the returned data in the event data buffer.
+     * @param size Size in bytes of the returned data. Ignored is returned data is read-only or larger than its max size.
+     */
+    public void setOutputSize(int size) {
+        _outputSize = _readOnlyData || size < 0 || size > _maxDataSize ? -1 : size;
+    }
+
+    /**
+     * Get the size of the event returned data, in zero-copy mode.
+     * @return Size in bytes of the returned data or -1 if not set.
+     */
+    public int outputSize() {
+        return _outputSize;
+    }
+
+    /**
+     * Get the metadata of the TS packets in the event data, in zero-copy mode.
+     *
+     * The returned buffer contains one serialized structure of METADATA_SIZE bytes per TS
+     * packet in the event data buffer. If the event data can be updated, the metadata of
+     * the returned packets can be updated in the buffer. The buffer is reused from one event
+     * to another and must not be used after returning from the event handler.
+     *
+     * @return A ByteBuffer containing the packet metadata or null if the plugin does not pass packet metadata.
+     */
+    public ByteBuffer packetMetadata() {
+        return _packetMetadata;
+    }
+
+    /**
+     * Get the input time stamp of a TS packet from the packet metadata.
+     * @param index Index of the packet in the event data.
+     * @return The input time stamp in PCR units (27 MHz) or -1 if there is none or no packet metadata.
+     */
+    public long inputTimeStamp(int index) {
+        return _packetMetadata == null ? -1 : _packetMetadata.getLong(index * METADATA_SIZE + 1);
+    }
+
+    /**
+     * Set the input time stamp of a TS packet in the packet metadata, if the event data can be updated.
+     * @param index Index of the packet in the event data.
+     * @param timeStamp The input time stamp in PCR units (27 MHz) or -1 if there is none.
+     */
+    public void setInputTimeStamp(int index, long timeStamp) {
+        if (_packetMetadata != null && !_readOnlyData) {
+            _packetMetadata.putLong(index * METADATA_SIZE + 1, timeStamp);
+        }
+    }
+
+    /**
+     * Get the labels of a TS packet from the packet metadata.
+     * @param index Index of the packet in the event data.
+     * @return A bit mask of packet labels, bit N is label N.
+     */
+    public int labels(int index) {
+        return _packetMetadata == null ? 0 : _packetMetadata.getInt(index * METADATA_SIZE + 9);
+    }
+
+    /**
+     * Set the labels of a TS packet in the packet metadata, if the event data can be updated.
+     * @param index Index of the packet in the event data.
+     * @param labels A bit mask of packet labels, bit N is label N.
+     */
+    public void setLabels(int index, int labels) {
+        if (_packetMetadata != null && !_readOnlyData) {
+            _packetMetadata.putInt(index * METADATA_SIZE + 9, labels);
+        }
+    }
+
     /**
      * Set the event returned data.
      * @param data Event returned data. Ignored is returned data is read-only or larger than its max size.
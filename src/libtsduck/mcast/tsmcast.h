@@ -64,6 +64,7 @@ namespace ts {
         //!
         enum : uint8_t {
             FEI_COMPACT_NOCODE =   0,  //!< Compact No-Code FEC (Fully-Specified)
+            FEI_REED_SOLOMON   =   2,  //!< Reed-Solomon Codes over GF(2^m) (RFC 5510, section 5)
             FEI_RAPTORQ        =   6,  //!< RaptorQ FEC Scheme (RFC 6330)
             FEI_EXPANDABLE     = 128,  //!< Small Block, Large Block and Expandable FEC (Under-Specified)
             FEI_SMALL_BLOCK    = 129,  //!< Small Block Systematic FEC (Under-Specified)
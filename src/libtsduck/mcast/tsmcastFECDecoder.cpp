@@ -0,0 +1,570 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "tsmcastFECDecoder.h"
+#include "tsmcast.h"
+
+
+//----------------------------------------------------------------------------
+// Arithmetics in GF(2^8) with primitive polynomial x^8 + x^4 + x^3 + x^2 + 1.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Exponential and logarithm tables, built once.
+    class GF256
+    {
+    public:
+        uint8_t exp[512];
+        uint8_t log[256];
+
+        GF256()
+        {
+            unsigned int x = 1;
+            for (size_t i = 0; i < 255; ++i) {
+                exp[i] = exp[i + 255] = uint8_t(x);
+                log[x] = uint8_t(i);
+                x <<= 1;
+                if (x & 0x100) {
+                    x ^= 0x11D;
+                }
+            }
+            exp[510] = exp[511] = 0;
+            log[0] = 0; // undefined, never used
+        }
+
+        uint8_t mul(uint8_t a, uint8_t b) const { return a == 0 || b == 0 ? 0 : exp[log[a] + log[b]]; }
+        uint8_t inv(uint8_t a) const { return exp[255 - log[a]]; }
+        uint8_t power(size_t e) const { return exp[e % 255]; }
+
+        // dst[i] += c * src[i]
+        void mulAdd(uint8_t* dst, const uint8_t* src, uint8_t c, size_t size) const
+        {
+            if (c == 1) {
+                for (size_t i = 0; i < size; ++i) {
+                    dst[i] ^= src[i];
+                }
+            }
+            else if (c != 0) {
+                const size_t lc = log[c];
+                for (size_t i = 0; i < size; ++i) {
+                    if (src[i] != 0) {
+                        dst[i] ^= exp[log[src[i]] + lc];
+                    }
+                }
+            }
+        }
+
+        // buf[i] *= c
+        void mul(uint8_t* buf, uint8_t c, size_t size) const
+        {
+            if (c != 1) {
+                const size_t lc = log[c];
+                for (size_t i = 0; i < size; ++i) {
+                    if (buf[i] != 0) {
+                        buf[i] = exp[log[buf[i]] + lc];
+                    }
+                }
+            }
+        }
+    };
+
+    const GF256& GF()
+    {
+        static const GF256 gf;
+        return gf;
+    }
+
+    // Compute the inverse of the k x k Vandermonde matrix V[i][j] = alpha^(i*j), row by row.
+    void InverseVandermonde(size_t k, std::vector<uint8_t>& inv)
+    {
+        const GF256& gf(GF());
+        std::vector<uint8_t> mat(k * k);
+        inv.assign(k * k, 0);
+        for (size_t i = 0; i < k; ++i) {
+            inv[i * k + i] = 1;
+            for (size_t j = 0; j < k; ++j) {
+                mat[i * k + j] = gf.power(i * j);
+            }
+        }
+        // Gauss-Jordan elimination. The matrix is always invertible for k <= 255.
+        for (size_t col = 0; col < k; ++col) {
+            size_t piv = col;
+            while (piv < k && mat[piv * k + col] == 0) {
+                ++piv;
+            }
+            assert(piv < k);
+            if (piv != col) {
+                std::swap_ranges(mat.begin() + piv * k, mat.begin() + (piv + 1) * k, mat.begin() + col * k);
+                std::swap_ranges(inv.begin() + piv * k, inv.begin() + (piv + 1) * k, inv.begin() + col * k);
+            }
+            const uint8_t f = gf.inv(mat[col * k + col]);
+            gf.mul(&mat[col * k], f, k);
+            gf.mul(&inv[col * k], f, k);
+            for (size_t row = 0; row < k; ++row) {
+                const uint8_t c = mat[row * k + col];
+                if (row != col && c != 0) {
+                    gf.mulAdd(&mat[row * k], &mat[col * k], c, k);
+                    gf.mulAdd(&inv[row * k], &inv[col * k], c, k);
+                }
+            }
+        }
+    }
+
+    // Coefficients of encoding symbol esi, column esi of GM = (V_k,k)^-1 x V_k,n.
+    void GeneratorColumn(const std::vector<uint8_t>& inv, size_t k, size_t esi, std::vector<uint8_t>& coef)
+    {
+        const GF256& gf(GF());
+        coef.assign(k, 0);
+        for (size_t l = 0; l < k; ++l) {
+            const uint8_t v = gf.power(l * esi);
+            for (size_t i = 0; i < k; ++i) {
+                coef[i] ^= gf.mul(inv[i * k + l], v);
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Destructor.
+//----------------------------------------------------------------------------
+
+ts::mcast::FECDecoder::~FECDecoder()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a FEC scheme is supported by this class.
+//----------------------------------------------------------------------------
+
+bool ts::mcast::FECDecoder::IsSupported(uint8_t fec_encoding_id, uint16_t fec_instance_id)
+{
+    return fec_encoding_id == FEI_REED_SOLOMON ||
+           fec_encoding_id == FEI_RAPTORQ ||
+           (fec_encoding_id == FEI_SMALL_BLOCK && fec_instance_id == 0);
+}
+
+
+//----------------------------------------------------------------------------
+// Partition function from RFC 6330, section 4.4.1.2.
+//----------------------------------------------------------------------------
+
+void ts::mcast::FECDecoder::Partition(size_t i, size_t j, size_t& il, size_t& is, size_t& jl, size_t& js)
+{
+    il = (i + j - 1) / j;
+    is = i / j;
+    jl = i - is * j;
+    js = j - jl;
+}
+
+
+//----------------------------------------------------------------------------
+// Reset the decoder for a new transport object.
+//----------------------------------------------------------------------------
+
+bool ts::mcast::FECDecoder::reset(const FECTransmissionInformation& fti, Report& report)
+{
+    _report = &report;
+    _valid = false;
+    _repair_ignored = false;
+    _fec_encoding_id = fti.fec_encoding_id;
+    _transfer_length = fti.transfer_length;
+    _symbol_size = fti.encoding_symbol_length;
+    _symbols_per_packet = 1;
+    _max_esi = 255;
+    _sub_blocks = _symbol_alignment = 1;
+    _solved_blocks = _source_symbols = _repair_symbols = _recovered_symbols = 0;
+    _blocks.clear();
+    _inv_vandermonde.clear();
+
+    if (!IsSupported(fti.fec_encoding_id, fti.fec_instance_id)) {
+        report.error(u"unsupported FEC Encoding ID %d, FEC Instance ID %d", fti.fec_encoding_id, fti.fec_instance_id);
+        return false;
+    }
+    if (_symbol_size == 0 || _transfer_length == 0) {
+        report.error(u"invalid FEC parameters, symbol size: %d, transfer length: %d", _symbol_size, _transfer_length);
+        return false;
+    }
+
+    // Total number of source symbols in the object.
+    const uint64_t total_symbols = (_transfer_length + _symbol_size - 1) / _symbol_size;
+
+    if (_fec_encoding_id == FEI_RAPTORQ) {
+        // RFC 6330, section 4.4.1.2.
+        _max_esi = 1 << 24;
+        _symbol_alignment = std::max<size_t>(1, fti.symbol_alignment);
+        _sub_blocks = std::max<size_t>(1, fti.sub_blocks);
+        if (fti.source_blocks == 0 || _symbol_size % _symbol_alignment != 0 || total_symbols > 56403 * size_t(fti.source_blocks)) {
+            report.error(u"invalid RaptorQ parameters, %s", fti);
+            return false;
+        }
+        size_t kl = 0, ks = 0, zl = 0, zs = 0;
+        Partition(size_t(total_symbols), fti.source_blocks, kl, ks, zl, zs);
+        _blocks.resize(zl + zs);
+        for (size_t i = 0; i < _blocks.size(); ++i) {
+            _blocks[i].k = i < zl ? kl : ks;
+        }
+    }
+    else {
+        // Reed-Solomon over GF(2^8).
+        if (_fec_encoding_id == FEI_REED_SOLOMON) {
+            if (fti.field_size != 0 && fti.field_size != 8) {
+                report.error(u"unsupported Reed-Solomon field size m = %d, only m = 8 is supported", fti.field_size);
+                return false;
+            }
+            _symbols_per_packet = std::max<size_t>(1, fti.symbols_per_packet);
+        }
+        if (fti.max_encoding_symbols > 0) {
+            _max_esi = std::min<size_t>(_max_esi, fti.max_encoding_symbols);
+        }
+        if (fti.max_source_block_length == 0 || fti.max_source_block_length >= _max_esi) {
+            report.error(u"invalid Reed-Solomon parameters, %s", fti);
+            return false;
+        }
+        // Block partitioning algorithm, RFC 5052, section 9.1.
+        const uint64_t n = (total_symbols + fti.max_source_block_length - 1) / fti.max_source_block_length;
+        const size_t a_large = size_t((total_symbols + n - 1) / n);
+        const size_t a_small = size_t(total_symbols / n);
+        const size_t i_large = size_t(total_symbols - a_small * n);
+        _blocks.resize(size_t(n));
+        for (size_t i = 0; i < _blocks.size(); ++i) {
+            _blocks[i].k = i < i_large ? a_large : a_small;
+        }
+    }
+
+    _valid = true;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Add an encoding symbol (or a group of encoding symbols) from a FLUTE packet.
+//----------------------------------------------------------------------------
+
+bool ts::mcast::FECDecoder::addSymbol(const FECPayloadId& fpi, const uint8_t* data, size_t size)
+{
+    if (!_valid || !fpi.valid || data == nullptr || fpi.source_block_number >= _blocks.size()) {
+        return false;
+    }
+
+    Block& block(_blocks[fpi.source_block_number]);
+
+    // With Small Block Systematic FEC, the block length is in each packet.
+    if (fpi.source_block_length > 0 && fpi.source_block_length != block.k && block.known == 0 && block.rows.empty() && fpi.source_block_length < _max_esi) {
+        block.k = fpi.source_block_length;
+        block.symbols.clear();
+        block.pivot.clear();
+    }
+
+    // Loop on all symbols in the packet (only one, except with Reed-Solomon when G > 1).
+    bool useful = false;
+    size_t esi = fpi.encoding_symbol_id;
+    for (size_t count = 0; count < _symbols_per_packet && size > 0; ++count, ++esi) {
+        const size_t len = std::min(size, _symbol_size);
+        useful = addOneSymbol(block, esi, data, len) || useful;
+        data += len;
+        size -= len;
+    }
+    return useful;
+}
+
+
+//----------------------------------------------------------------------------
+// Add one encoding symbol in a source block.
+//----------------------------------------------------------------------------
+
+bool ts::mcast::FECDecoder::addOneSymbol(Block& block, size_t esi, const uint8_t* data, size_t size)
+{
+    if (esi >= _max_esi) {
+        return false;
+    }
+
+    if (esi < block.k) {
+        // Source symbol, directly stored in the block.
+        ++_source_symbols;
+        if (block.isKnown(esi)) {
+            return false;
+        }
+        if (block.symbols.empty()) {
+            block.symbols.resize(block.k);
+        }
+        // Short symbols (typically the last source symbol of the object) are zero-padded.
+        block.symbols[esi].copy(data, size);
+        block.symbols[esi].resize(_symbol_size, 0);
+        ++block.known;
+        if (!block.rows.empty()) {
+            eliminateSource(block, esi);
+        }
+    }
+    else if (_fec_encoding_id == FEI_RAPTORQ) {
+        // RaptorQ FEC decoding is not implemented, repair symbols are ignored.
+        ++_repair_symbols;
+        if (!_repair_ignored) {
+            _repair_ignored = true;
+            _report->warning(u"RaptorQ FEC decoding not supported, repair symbols are ignored, all source symbols are required");
+        }
+        return false;
+    }
+    else if (block.solved()) {
+        // Repair symbols are useless once the block is decoded.
+        ++_repair_symbols;
+        return false;
+    }
+    else {
+        // Reed-Solomon repair symbol, zero-padded like source symbols.
+        ++_repair_symbols;
+        Row row;
+        repairCoefficients(row.coef, block.k, esi);
+        row.data.copy(data, size);
+        row.data.resize(_symbol_size, 0);
+        if (block.pivot.empty()) {
+            block.pivot.assign(block.k, -1);
+        }
+        if (!insertRow(block, row)) {
+            return false;
+        }
+    }
+
+    // The block is decoded when the repair symbols cover all missing source symbols.
+    if (block.known + block.rows.size() == block.k) {
+        decodeBlock(block);
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Build the coefficients of a Reed-Solomon repair symbol.
+//----------------------------------------------------------------------------
+
+void ts::mcast::FECDecoder::repairCoefficients(std::vector<uint8_t>& coef, size_t k, size_t esi)
+{
+    // The inverse Vandermonde matrix is computed when the first repair symbol is received.
+    auto it = _inv_vandermonde.find(k);
+    if (it == _inv_vandermonde.end()) {
+        it = _inv_vandermonde.emplace(k, std::vector<uint8_t>()).first;
+        InverseVandermonde(k, it->second);
+    }
+    GeneratorColumn(it->second, k, esi, coef);
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a row in the linear system of a block.
+//----------------------------------------------------------------------------
+
+bool ts::mcast::FECDecoder::insertRow(Block& block, Row& row)
+{
+    const GF256& gf(GF());
+
+    // Eliminate all known source symbols and all known pivots from the new row. Since the system
+    // is in reduced row echelon form, each pivot row has zeroes in all other pivot columns and in
+    // all known source symbols columns.
+    for (size_t col = 0; col < block.k; ++col) {
+        const uint8_t c = row.coef[col];
+        if (c != 0 && block.isKnown(col)) {
+            gf.mulAdd(row.data.data(), block.symbols[col].data(), c, _symbol_size);
+            row.coef[col] = 0;
+        }
+        else if (c != 0 && block.pivot[col] >= 0) {
+            const Row& p(block.rows[block.pivot[col]]);
+            gf.mulAdd(row.coef.data(), p.coef.data(), c, block.k);
+            gf.mulAdd(row.data.data(), p.data.data(), c, _symbol_size);
+        }
+    }
+
+    // Find the pivot column of the new row.
+    size_t piv = 0;
+    while (piv < block.k && row.coef[piv] == 0) {
+        ++piv;
+    }
+    if (piv >= block.k) {
+        // Linearly dependent row, no new information.
+        return false;
+    }
+
+    // Normalize the new row.
+    const uint8_t f = gf.inv(row.coef[piv]);
+    gf.mul(row.coef.data(), f, block.k);
+    gf.mul(row.data.data(), f, _symbol_size);
+
+    // Eliminate the new pivot column from all other rows.
+    for (auto& r : block.rows) {
+        const uint8_t c = r.coef[piv];
+        if (c != 0) {
+            gf.mulAdd(r.coef.data(), row.coef.data(), c, block.k);
+            gf.mulAdd(r.data.data(), row.data.data(), c, _symbol_size);
+        }
+    }
+
+    block.pivot[piv] = int(block.rows.size());
+    block.rows.push_back(std::move(row));
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Eliminate a newly received source symbol from the linear system of a block.
+//----------------------------------------------------------------------------
+
+void ts::mcast::FECDecoder::eliminateSource(Block& block, size_t esi)
+{
+    const GF256& gf(GF());
+    const ByteBlock& sym(block.symbols[esi]);
+
+    for (auto& r : block.rows) {
+        const uint8_t c = r.coef[esi];
+        if (c != 0) {
+            gf.mulAdd(r.data.data(), sym.data(), c, _symbol_size);
+            r.coef[esi] = 0;
+        }
+    }
+
+    // The row which had its pivot on this column is now an equation on the other missing
+    // source symbols only. Remove it from the system and insert it again.
+    const int index = block.pivot[esi];
+    if (index >= 0) {
+        block.pivot[esi] = -1;
+        Row row(std::move(block.rows[index]));
+        const int last = int(block.rows.size()) - 1;
+        if (index != last) {
+            block.rows[index] = std::move(block.rows[last]);
+            *std::find(block.pivot.begin(), block.pivot.end(), last) = index;
+        }
+        block.rows.pop_back();
+        insertRow(block, row);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Move the recovered source symbols from the linear system into the block.
+//----------------------------------------------------------------------------
+
+void ts::mcast::FECDecoder::decodeBlock(Block& block)
+{
+    // With all missing source symbols as pivots, the reduced row echelon form is the identity.
+    if (!block.rows.empty()) {
+        block.symbols.resize(block.k);
+        for (size_t col = 0; col < block.k; ++col) {
+            if (block.pivot[col] >= 0) {
+                block.symbols[col] = std::move(block.rows[block.pivot[col]].data);
+            }
+        }
+        _recovered_symbols += block.rows.size();
+    }
+    block.known = block.k;
+    block.rows.clear();
+    block.rows.shrink_to_fit();
+    block.pivot.clear();
+    block.pivot.shrink_to_fit();
+    ++_solved_blocks;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the number of source bytes which are currently available.
+//----------------------------------------------------------------------------
+
+uint64_t ts::mcast::FECDecoder::availableBytes() const
+{
+    uint64_t count = 0;
+    for (const auto& b : _blocks) {
+        count += b.known;
+    }
+    return std::min(_transfer_length, count * _symbol_size);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the size in bytes of sub-symbol in a RaptorQ sub-block.
+//----------------------------------------------------------------------------
+
+size_t ts::mcast::FECDecoder::subSymbolSize(size_t sub_block) const
+{
+    size_t tl = 0, ts = 0, nl = 0, ns = 0;
+    Partition(_symbol_size / _symbol_alignment, _sub_blocks, tl, ts, nl, ns);
+    return (sub_block < nl ? tl : ts) * _symbol_alignment;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the decoded transport object.
+//----------------------------------------------------------------------------
+
+bool ts::mcast::FECDecoder::getObject(ByteBlock& data) const
+{
+    if (!isComplete()) {
+        data.clear();
+        return false;
+    }
+
+    data.resize(0);
+    data.reserve(size_t(_transfer_length));
+    for (const auto& b : _blocks) {
+        const size_t start = data.size();
+        data.resize(start + b.k * _symbol_size);
+        uint8_t* const base = data.data() + start;
+        if (_sub_blocks <= 1) {
+            // Source symbols are contiguous.
+            for (size_t i = 0; i < b.k; ++i) {
+                MemCopy(base + i * _symbol_size, b.symbols[i].data(), _symbol_size);
+            }
+        }
+        else {
+            // RaptorQ sub-blocking: each encoding symbol is the concatenation of the sub-symbols
+            // with the same index in each sub-block. Sub-blocks are contiguous in the source block.
+            size_t sub_start = 0;  // start of sub-block in source block
+            size_t sym_offset = 0; // offset of sub-symbol in encoding symbol
+            for (size_t j = 0; j < _sub_blocks; ++j) {
+                const size_t sub_size = subSymbolSize(j);
+                for (size_t i = 0; i < b.k; ++i) {
+                    MemCopy(base + sub_start + i * sub_size, b.symbols[i].data() + sym_offset, sub_size);
+                }
+                sub_start += b.k * sub_size;
+                sym_offset += sub_size;
+            }
+        }
+    }
+    data.resize(size_t(_transfer_length));
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Compute a Reed-Solomon encoding symbol over GF(2^8).
+//----------------------------------------------------------------------------
+
+bool ts::mcast::FECDecoder::EncodeReedSolomon(const std::vector<ByteBlock>& source, size_t esi, ByteBlock& symbol)
+{
+    const size_t k = source.size();
+    if (k == 0 || esi >= 255) {
+        symbol.clear();
+        return false;
+    }
+    if (esi < k) {
+        symbol = source[esi];
+        return true;
+    }
+    const size_t size = source[0].size();
+    std::vector<uint8_t> inv;
+    std::vector<uint8_t> coef;
+    InverseVandermonde(k, inv);
+    GeneratorColumn(inv, k, esi, coef);
+    symbol.assign(size, 0);
+    for (size_t i = 0; i < k; ++i) {
+        if (source[i].size() != size) {
+            symbol.clear();
+            return false;
+        }
+        GF().mulAdd(symbol.data(), source[i].data(), coef[i], size);
+    }
+    return true;
+}
@@ -0,0 +1,207 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Incremental FEC decoder for one transport object in FLUTE streams.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsmcastFECTransmissionInformation.h"
+#include "tsmcastFECPayloadId.h"
+#include "tsByteBlock.h"
+#include "tsReport.h"
+#include "tsNullReport.h"
+
+namespace ts::mcast {
+    //!
+    //! Incremental FEC decoder for one transport object (a file) in FLUTE streams.
+    //! @ingroup libtsduck mpeg
+    //!
+    //! Encoding symbols are passed to the decoder as soon as they are received.
+    //! Source symbols are directly stored in their source block. The repair symbols of
+    //! a source block are maintained as a linear system on the missing source symbols,
+    //! in reduced row echelon form over GF(2^8). A received symbol is immediately
+    //! eliminated against the already known ones. A source block is decoded as soon as
+    //! the number of received source symbols and independent repair symbols reaches the
+    //! number of source symbols in the block. There is no final batch decoding.
+    //!
+    //! Supported FEC schemes:
+    //! - FEC Encoding ID 2: Reed-Solomon Codes over GF(2^m), with m = 8 (RFC 5510, section 5).
+    //! - FEC Encoding ID 129, FEC Instance ID 0: Reed-Solomon over GF(2^8), Small Block Systematic (RFC 5510, section 8).
+    //! - FEC Encoding ID 6: RaptorQ (RFC 6330), source symbol reassembly only. RaptorQ FEC decoding
+    //!   is not implemented: repair symbols are counted but ignored and a warning is reported once per
+    //!   transport object. The object is rebuilt only when all its source symbols are received.
+    //!   Sub-blocking is correctly handled.
+    //!
+    //! With Reed-Solomon, the generator matrix is the systematic matrix GM = (V_k,k)^-1 x V_k,n,
+    //! where V is the Vandermonde matrix built on the primitive element of GF(2^8) and the
+    //! primitive polynomial x^8 + x^4 + x^3 + x^2 + 1, as defined in RFC 5510.
+    //!
+    class TSDUCKDLL FECDecoder
+    {
+        TS_NOCOPY(FECDecoder);
+    public:
+        //!
+        //! Constructor.
+        //!
+        FECDecoder() = default;
+
+        //!
+        //! Destructor.
+        //!
+        ~FECDecoder();
+
+        //!
+        //! Check if a FEC scheme is supported by this class.
+        //! @param [in] fec_encoding_id FEC Encoding ID.
+        //! @param [in] fec_instance_id FEC Instance ID (FEC Encoding ID 128-255 only).
+        //! @return True if the FEC scheme is supported.
+        //!
+        static bool IsSupported(uint8_t fec_encoding_id, uint16_t fec_instance_id = 0);
+
+        //!
+        //! Reset the decoder for a new transport object.
+        //! @param [in] fti FEC Transmission Information of the transport object.
+        //! @param [in,out] report Where to report errors. The reference is kept in the decoder
+        //! to report warnings during the decoding of the transport object.
+        //! @return True on success, false if the FEC scheme or parameters are not supported.
+        //!
+        bool reset(const FECTransmissionInformation& fti, Report& report);
+
+        //!
+        //! Check if the decoder was successfully initialized.
+        //! @return True if the decoder was successfully initialized.
+        //!
+        bool isValid() const { return _valid; }
+
+        //!
+        //! Add an encoding symbol (or a group of encoding symbols) from a FLUTE packet.
+        //! @param [in] fpi FEC Payload ID of the packet.
+        //! @param [in] data Address of the packet payload.
+        //! @param [in] size Size in bytes of the packet payload.
+        //! @return True if at least one symbol brought new information, false if all symbols were redundant or invalid.
+        //!
+        bool addSymbol(const FECPayloadId& fpi, const uint8_t* data, size_t size);
+
+        //!
+        //! Check if the transport object is completely decoded.
+        //! @return True if all source blocks are decoded.
+        //!
+        bool isComplete() const { return _valid && _solved_blocks == _blocks.size(); }
+
+        //!
+        //! Get the size of the transport object.
+        //! @return The transfer length of the object in bytes.
+        //!
+        uint64_t transferLength() const { return _transfer_length; }
+
+        //!
+        //! Get the number of source bytes which are currently available, received or recovered.
+        //! @return The number of source bytes which are currently available.
+        //!
+        uint64_t availableBytes() const;
+
+        //!
+        //! Get the decoded transport object.
+        //! @param [out] data The content of the transport object.
+        //! @return True on success, false if the object is not complete.
+        //!
+        bool getObject(ByteBlock& data) const;
+
+        //!
+        //! Get the number of received source symbols.
+        //! @return The number of received source symbols.
+        //!
+        size_t sourceSymbols() const { return _source_symbols; }
+
+        //!
+        //! Get the number of received repair symbols.
+        //! @return The number of received repair symbols.
+        //!
+        size_t repairSymbols() const { return _repair_symbols; }
+
+        //!
+        //! Get the number of source symbols which were recovered using repair symbols.
+        //! @return The number of recovered source symbols.
+        //!
+        size_t recoveredSymbols() const { return _recovered_symbols; }
+
+        //!
+        //! Compute a Reed-Solomon encoding symbol over GF(2^8), as defined in RFC 5510.
+        //! This is the encoder counterpart of the decoder. It is typically used to generate
+        //! repair symbols on the sending side and to test the decoder.
+        //! @param [in] source The source symbols of a source block, all with the same size.
+        //! @param [in] esi Encoding symbol id to generate, from 0 to 254.
+        //! @param [out] symbol The encoding symbol. When @a esi is lower than the number of
+        //! source symbols, this is a copy of the corresponding source symbol.
+        //! @return True on success, false on invalid parameters.
+        //!
+        static bool EncodeReedSolomon(const std::vector<ByteBlock>& source, size_t esi, ByteBlock& symbol);
+
+    private:
+        // One row of the linear system: coefficients of the source symbols and symbol value.
+        class Row
+        {
+        public:
+            std::vector<uint8_t> coef {};
+            ByteBlock            data {};
+        };
+
+        // Decoding state of one source block.
+        class Block
+        {
+        public:
+            size_t                 k = 0;       // Number of source symbols in the block.
+            size_t                 known = 0;   // Number of source symbols, received or recovered.
+            std::vector<ByteBlock> symbols {};  // Source symbols, indexed by ESI, empty when unknown. Allocated on first symbol.
+            std::vector<int>       pivot {};    // Index in rows of the pivot for each column, -1 if none. Allocated on first repair symbol.
+            std::vector<Row>       rows {};     // Repair symbols, linear system on the missing source symbols.
+            bool solved() const { return k > 0 && known == k; }
+            bool isKnown(size_t esi) const { return !symbols.empty() && !symbols[esi].empty(); }
+        };
+
+        Report*            _report = &NULLREP;
+        bool               _valid = false;
+        bool               _repair_ignored = false;  // Ignored repair symbols were already reported.
+        uint8_t            _fec_encoding_id = 0;
+        uint64_t           _transfer_length = 0;
+        size_t             _symbol_size = 0;
+        size_t             _symbols_per_packet = 1;
+        size_t             _max_esi = 0;          // Max encoding symbol id, exclusive.
+        size_t             _sub_blocks = 1;       // RaptorQ only.
+        size_t             _symbol_alignment = 1; // RaptorQ only.
+        size_t             _solved_blocks = 0;
+        size_t             _source_symbols = 0;
+        size_t             _repair_symbols = 0;
+        size_t             _recovered_symbols = 0;
+        std::vector<Block> _blocks {};
+        std::map<size_t, std::vector<uint8_t>> _inv_vandermonde {};  // Inverse of V_k,k, indexed by k.
+
+        // Add one encoding symbol in a source block.
+        bool addOneSymbol(Block& block, size_t esi, const uint8_t* data, size_t size);
+
+        // Insert a row in the linear system of a block. The row is modified.
+        bool insertRow(Block& block, Row& row);
+
+        // Eliminate a newly received source symbol from the linear system of a block.
+        void eliminateSource(Block& block, size_t esi);
+
+        // Move the recovered source symbols from the linear system into the block.
+        void decodeBlock(Block& block);
+
+        // Build the coefficients of a Reed-Solomon repair symbol.
+        void repairCoefficients(std::vector<uint8_t>& coef, size_t k, size_t esi);
+
+        // Get the size in bytes of sub-symbol in a RaptorQ sub-block.
+        size_t subSymbolSize(size_t sub_block) const;
+
+        // Partition function from RFC 6330, section 4.4.1.2.
+        static void Partition(size_t i, size_t j, size_t& il, size_t& is, size_t& jl, size_t& js);
+    };
+}
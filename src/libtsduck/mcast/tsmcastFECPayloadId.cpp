@@ -18,7 +18,7 @@ void ts::mcast::FECPayloadId::clear()
 {
     valid = false;
     fec_encoding_id = 0;
-    source_block_number = encoding_symbol_id = 0;
+    source_block_number = encoding_symbol_id = source_block_length = 0;
 }
 
 
@@ -46,6 +46,23 @@ bool ts::mcast::FECPayloadId::deserialize(uint8_t fei, const uint8_t*& addr, siz
             addr += 4;
             size -= 4;
         }
+        else if (fei == FEI_REED_SOLOMON) {
+            // RFC 5510, section 5.1.2, assuming the default m = 8.
+            valid = true;
+            source_block_number = GetUInt24(addr);
+            encoding_symbol_id = GetUInt8(addr + 3);
+            addr += 4;
+            size -= 4;
+        }
+        else if (fei == FEI_SMALL_BLOCK && size >= 6) {
+            // RFC 5445, section 5.1.
+            valid = true;
+            source_block_number = GetUInt16(addr);
+            source_block_length = GetUInt16(addr + 2);
+            encoding_symbol_id = GetUInt16(addr + 4);
+            addr += 6;
+            size -= 6;
+        }
     }
     return valid;
 }
@@ -58,7 +75,10 @@ bool ts::mcast::FECPayloadId::deserialize(uint8_t fei, const uint8_t*& addr, siz
 ts::UString ts::mcast::FECPayloadId::toString() const
 {
     UString str;
-    if (valid && (fec_encoding_id == FEI_COMPACT_NOCODE || fec_encoding_id == FEI_COMPACT)) {
+    if (valid && fec_encoding_id == FEI_SMALL_BLOCK) {
+        str.format(u"sbn: %d, block len: %d, symbol id: %d", source_block_number, source_block_length, encoding_symbol_id);
+    }
+    else if (valid) {
         str.format(u"sbn: %d, symbol id: %d", source_block_number, encoding_symbol_id);
     }
     return str;
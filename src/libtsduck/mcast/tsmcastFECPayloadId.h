@@ -30,6 +30,7 @@ namespace ts::mcast {
         uint8_t fec_encoding_id = 0;      //!< FEC Encoding ID which was used to parse the structure (not part of the structore).
         size_t  source_block_number = 0;  //!< SBN, Source Block Number (FEC Encoding ID 0 and 130, RFC 3695, section 2.1).
         size_t  encoding_symbol_id = 0;   //!< Encoding Symbol ID (FEC Encoding ID 0 and 130, RFC 3695, section 2.1).
+        size_t  source_block_length = 0;  //!< Number of source symbols in the source block (FEC Encoding ID 129 only, RFC 5445, section 5.1).
 
         //!
         //! Default constructor.
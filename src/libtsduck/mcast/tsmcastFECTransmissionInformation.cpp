@@ -20,6 +20,9 @@ void ts::mcast::FECTransmissionInformation::clear()
     transfer_length = 0;
     max_source_block_length = 0;
     fec_instance_id = encoding_symbol_length = max_encoding_symbols = 0;
+    field_size = symbols_per_packet = 0;
+    source_blocks = symbol_alignment = 0;
+    sub_blocks = 0;
 }
 
 
@@ -34,7 +37,31 @@ bool ts::mcast::FECTransmissionInformation::deserialize(uint8_t fei, const uint8
     if (addr == nullptr || size < 10) {
         return false;
     }
+    if (fei == FEI_RAPTORQ) {
+        // RFC 6330, section 3.3: 40-bit transfer length, 8-bit reserved, 16-bit symbol size, then Z, N, Al.
+        if (size < 12) {
+            return false;
+        }
+        transfer_length = GetUInt40(addr);
+        encoding_symbol_length = GetUInt16(addr + 6);
+        source_blocks = GetUInt8(addr + 8);
+        sub_blocks = GetUInt16(addr + 9);
+        symbol_alignment = GetUInt8(addr + 11);
+        return true;
+    }
     transfer_length = GetUInt48(addr);
+    if (fei == FEI_REED_SOLOMON) {
+        // RFC 5510, section 5.2.3: no FEC Instance ID, m, G, E, B, max_n.
+        if (size < 14) {
+            return false;
+        }
+        field_size = GetUInt8(addr + 6);
+        symbols_per_packet = GetUInt8(addr + 7);
+        encoding_symbol_length = GetUInt16(addr + 8);
+        max_source_block_length = GetUInt16(addr + 10);
+        max_encoding_symbols = GetUInt16(addr + 12);
+        return true;
+    }
     fec_instance_id = GetUInt16(addr + 6);
     if (fei == FEI_COMPACT_NOCODE || fei == FEI_EXPANDABLE || fei == FEI_SMALL_BLOCK || fei == FEI_COMPACT) {
         if (size < 14) {
@@ -60,6 +87,15 @@ bool ts::mcast::FECTransmissionInformation::deserialize(uint8_t fei, const uint8
 ts::UString ts::mcast::FECTransmissionInformation::toString() const
 {
     UString str;
+    if (fec_encoding_id == FEI_RAPTORQ) {
+        str.format(u"transfer len: %d, symbol size: %d, Z: %d, N: %d, Al: %d", transfer_length, encoding_symbol_length, source_blocks, sub_blocks, symbol_alignment);
+        return str;
+    }
+    if (fec_encoding_id == FEI_REED_SOLOMON) {
+        str.format(u"transfer len: %d, m: %d, G: %d, symbol size: %d, max src blk len: %d, max num enc sym: %d",
+                   transfer_length, field_size, symbols_per_packet, encoding_symbol_length, max_source_block_length, max_encoding_symbols);
+        return str;
+    }
     str.format(u"transfer len: %d, fec inst id: %d", transfer_length, fec_instance_id);
     if (fec_encoding_id == FEI_COMPACT_NOCODE || fec_encoding_id == FEI_EXPANDABLE || fec_encoding_id == FEI_COMPACT) {
         str.format(u", max src blk len: %d", max_source_block_length);
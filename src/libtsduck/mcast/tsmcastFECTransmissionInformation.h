@@ -29,9 +29,14 @@ namespace ts::mcast {
         uint8_t  fec_encoding_id = 0;          //!< FEC Encoding ID which was used to parse the structure (not part of the structore).
         uint64_t transfer_length = 0;          //!< The length of the transport object that carries the file in bytes.
         uint16_t fec_instance_id = 0;          //!< FEC Instance ID (FEC Encoding ID 128-255).
-        uint16_t encoding_symbol_length = 0;   //!< Length of Encoding Symbol in bytes (FEC Encoding ID 0, 128, 129, 130).
-        uint32_t max_source_block_length = 0;  //!< Max number of source symbols per source block (FEC Encoding ID 0, 128, 129, 130).
-        uint16_t max_encoding_symbols = 0;     //!< Max number of encoding symbols (FEC Encoding ID 129).
+        uint16_t encoding_symbol_length = 0;   //!< Length of Encoding Symbol in bytes (FEC Encoding ID 0, 2, 6, 128, 129, 130).
+        uint32_t max_source_block_length = 0;  //!< Max number of source symbols per source block (FEC Encoding ID 0, 2, 128, 129, 130).
+        uint16_t max_encoding_symbols = 0;     //!< Max number of encoding symbols (FEC Encoding ID 2, 129).
+        uint8_t  field_size = 0;               //!< Parameter m, size in bits of the finite field elements (FEC Encoding ID 2).
+        uint8_t  symbols_per_packet = 0;       //!< Parameter G, number of encoding symbols per packet (FEC Encoding ID 2).
+        uint8_t  source_blocks = 0;            //!< Parameter Z, number of source blocks (FEC Encoding ID 6).
+        uint16_t sub_blocks = 0;               //!< Parameter N, number of sub-blocks (FEC Encoding ID 6).
+        uint8_t  symbol_alignment = 0;         //!< Parameter Al, symbol alignment (FEC Encoding ID 6).
 
         //!
         //! Default constructor.
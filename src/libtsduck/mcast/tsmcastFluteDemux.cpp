@@ -72,6 +72,7 @@ void ts::mcast::FluteDemux::FileContext::clear()
     instance = 0xFFFFFFFF;
     transfer_length = current_length = 0;
     chunks.clear();
+    fec.reset();
 };
 
 
@@ -102,8 +103,9 @@ void ts::mcast::FluteDemux::feedPacketImpl(const cn::microseconds& timestamp, co
         return;
     }
 
-    // We currently only support the default FEC Encoding ID, value 0.
-    if (lct.fec_encoding_id != FEI_COMPACT_NOCODE) {
+    // Supported FEC Encoding ID are Compact No-Code (no FEC) and those which are supported by FECDecoder.
+    // With Small Block Systematic FEC, the FEC Instance ID is checked when the FTI is known.
+    if (lct.fec_encoding_id != FEI_COMPACT_NOCODE && !FECDecoder::IsSupported(lct.fec_encoding_id, lct.fti.has_value() ? lct.fti->fec_instance_id : 0)) {
         _report.error(u"unsupported FEC Encoding ID %d from %s", lct.fec_encoding_id, source);
         return;
     }
@@ -182,28 +184,40 @@ void ts::mcast::FluteDemux::feedPacketImpl(const cn::microseconds& timestamp, co
         return;
     }
 
-    // Store the file chunk if not already there.
-    if (lct.fpi.source_block_number >= file.chunks.size()) {
-        file.chunks.resize(lct.fpi.source_block_number + 1);
-    }
-    auto& syms(file.chunks[lct.fpi.source_block_number]);
-    const size_t sym_index = lct.fpi.encoding_symbol_id;
-    if (sym_index >= syms.size()) {
-        syms.resize(sym_index + 1);
+    // With FEC schemes, create the decoder as soon as the FEC Transmission Information is known.
+    if (lct.fec_encoding_id != FEI_COMPACT_NOCODE && file.fec == nullptr && lct.fti.has_value() && !createFECDecoder(sid, lct.toi, file, lct.fti.value())) {
+        return;
     }
-    if (syms[sym_index] == nullptr) {
-        // New chunk.
-        syms[sym_index] = std::make_shared<ByteBlock>(udp, udp_size);
-        file.current_length += udp_size;
+    if (file.fec != nullptr) {
+        // Incremental FEC decoding.
+        addFECSymbol(file, lct.fpi, udp, udp_size);
     }
-    else if (udp_size != syms[sym_index]->size()) {
-        // Chunk already there with a different size.
-        // Tolerate new size = 0 in non-strict mode.
-        if (udp_size > 0 || _args.strict) {
-            _report.error(u"size of file chunk #%n changed in the middle of transmission, was %'d, now %'d, TOI %d, %s",
-                          sym_index, syms[sym_index]->size(), udp_size, lct.toi, sid);
+    else {
+        // Store the file chunk if not already there.
+        if (lct.fpi.source_block_number >= file.chunks.size()) {
+            file.chunks.resize(lct.fpi.source_block_number + 1);
+        }
+        auto& syms(file.chunks[lct.fpi.source_block_number]);
+        const size_t sym_index = lct.fpi.encoding_symbol_id;
+        if (sym_index >= syms.size()) {
+            syms.resize(sym_index + 1);
+        }
+        if (syms[sym_index] == nullptr) {
+            // New chunk. With FEC, the length of the file is unknown until the FEC decoder is created.
+            syms[sym_index] = std::make_shared<ByteBlock>(udp, udp_size);
+            if (lct.fec_encoding_id == FEI_COMPACT_NOCODE) {
+                file.current_length += udp_size;
+            }
+        }
+        else if (udp_size != syms[sym_index]->size()) {
+            // Chunk already there with a different size.
+            // Tolerate new size = 0 in non-strict mode.
+            if (udp_size > 0 || _args.strict) {
+                _report.error(u"size of file chunk #%n changed in the middle of transmission, was %'d, now %'d, TOI %d, %s",
+                              sym_index, syms[sym_index]->size(), udp_size, lct.toi, sid);
+            }
+            return;
         }
-        return;
     }
 
     // If file is complete (and its size is known), process the file.
@@ -243,6 +257,62 @@ bool ts::mcast::FluteDemux::updateFileSize(const FluteSessionId& sid, SessionCon
 }
 
 
+//----------------------------------------------------------------------------
+// Create the FEC decoder of a file.
+//----------------------------------------------------------------------------
+
+bool ts::mcast::FluteDemux::createFECDecoder(const FluteSessionId& sid, uint64_t toi, FileContext& file, const FECTransmissionInformation& fti)
+{
+    file.fec = std::make_shared<FECDecoder>();
+    if (!file.fec->reset(fti, _report)) {
+        _report.verbose(u"ignoring file from %s, TOI: %d, unsupported FEC parameters", sid, toi);
+        // Mark the file as processed (ignored in the future). Deallocate everything.
+        file.processed = true;
+        file.chunks.clear();
+        file.fec.reset();
+        return false;
+    }
+    _report.debug(u"FEC decoder created for TOI %d, %s, %s", toi, sid, fti);
+
+    // Feed the decoder with the symbols which were received before the FTI.
+    FECPayloadId fpi;
+    fpi.valid = true;
+    fpi.fec_encoding_id = fti.fec_encoding_id;
+    for (size_t sbn = 0; sbn < file.chunks.size(); ++sbn) {
+        for (size_t esi = 0; esi < file.chunks[sbn].size(); ++esi) {
+            const ByteBlockPtr& sym(file.chunks[sbn][esi]);
+            if (sym != nullptr) {
+                fpi.source_block_number = sbn;
+                fpi.encoding_symbol_id = esi;
+                addFECSymbol(file, fpi, sym->data(), sym->size());
+            }
+        }
+    }
+    file.chunks.clear();
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Pass a FEC encoding symbol to the FEC decoder of a file.
+//----------------------------------------------------------------------------
+
+void ts::mcast::FluteDemux::addFECSymbol(FileContext& file, const FECPayloadId& fpi, const uint8_t* data, size_t size)
+{
+    file.fec->addSymbol(fpi, data, size);
+    if (file.transfer_length == 0) {
+        file.transfer_length = file.fec->transferLength();
+    }
+    if (file.fec->isComplete()) {
+        // Make sure that the file is considered as complete, even if transfer_length is inconsistent.
+        file.current_length = std::max(file.transfer_length, file.fec->transferLength());
+    }
+    else {
+        file.current_length = file.fec->availableBytes();
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Process a complete file.
 //----------------------------------------------------------------------------
@@ -252,6 +322,14 @@ void ts::mcast::FluteDemux::processCompleteFile(const FluteSessionId& sid, Sessi
     // Rebuild the content of the file.
     ByteBlockPtr data(std::make_shared<ByteBlock>(file.transfer_length));
     size_t next_index = 0;
+    if (file.fec != nullptr) {
+        // Decoded FEC transport object.
+        file.fec->getObject(*data);
+        next_index = data->size();
+        _report.debug(u"FEC decoding of TOI %d, %s: %d source symbols, %d repair symbols, %d recovered symbols",
+                      toi, sid, file.fec->sourceSymbols(), file.fec->repairSymbols(), file.fec->recoveredSymbols());
+        file.fec.reset();
+    }
     for (auto& src : file.chunks) {
         for (auto& sym : src) {
             if (sym != nullptr) {
@@ -272,8 +350,8 @@ void ts::mcast::FluteDemux::processCompleteFile(const FluteSessionId& sid, Sessi
     // Shrink rebuilt file data if necessary.
     data->resize(next_index);
 
-    // Important: we currently support FEC Encoding ID zero, meaning no encoding,
-    // therefore the raw transport data are identical to the file content.
+    // With FEC Encoding ID zero, there is no encoding, therefore the raw transport data are
+    // identical to the file content. With other FEC schemes, the data come from the decoder.
 
     if (toi == FLUTE_FDT_TOI) {
         // Process a new FDT.
@@ -388,7 +466,26 @@ void ts::mcast::FluteDemux::processFDT(SessionContext& session, const FluteFDT&
         FileContext& sf(session.files_by_toi[f.toi]);
         sf.name = f.content_location;
         sf.type = f.content_type;
-        updateFileSize(fdt.sessionId(), session, f.toi, sf, f.transfer_length);
+        if (updateFileSize(fdt.sessionId(), session, f.toi, sf, f.transfer_length) &&
+            !sf.processed &&
+            sf.fec == nullptr &&
+            f.fec_encoding_id != FEI_COMPACT_NOCODE &&
+            f.fec_encoding_id != FEI_RAPTORQ && // Scheme-specific RaptorQ parameters are not in the FDT.
+            f.transfer_length > 0 &&
+            f.encoding_symbol_length > 0 &&
+            f.max_source_block_length > 0 &&
+            FECDecoder::IsSupported(uint8_t(f.fec_encoding_id), uint16_t(f.fec_instance_id)))
+        {
+            // The FEC Transmission Information are in the FDT, no need to wait for EXT_FTI.
+            FECTransmissionInformation fti;
+            fti.fec_encoding_id = uint8_t(f.fec_encoding_id);
+            fti.fec_instance_id = uint16_t(f.fec_instance_id);
+            fti.transfer_length = f.transfer_length;
+            fti.encoding_symbol_length = uint16_t(f.encoding_symbol_length);
+            fti.max_source_block_length = f.max_source_block_length;
+            fti.max_encoding_symbols = uint16_t(f.max_encoding_symbols);
+            createFECDecoder(fdt.sessionId(), f.toi, sf, fti);
+        }
     }
 
     // Notify the application.
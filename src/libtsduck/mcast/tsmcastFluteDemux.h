@@ -16,6 +16,7 @@
 #include "tsmcastFluteHandlerInterface.h"
 #include "tsmcastFluteSessionId.h"
 #include "tsmcastFluteFDT.h"
+#include "tsmcastFECDecoder.h"
 #include "tsIPPacket.h"
 #include "tsDuckContext.h"
 
@@ -134,8 +135,14 @@ namespace ts::mcast {
             // First level of index: Source Block Number (SBN).
             // Second level of index: Encoding Symbol ID in source block.
             // Erased when the file is processed to save storage.
+            // With FEC schemes other than Compact No-Code, the chunks are encoding symbols which
+            // are stored here only until the FEC Transmission Information is known.
             std::vector<std::vector<ByteBlockPtr>> chunks {};
 
+            // FEC decoder, when the FEC scheme is not Compact No-Code.
+            // Encoding symbols are decoded incrementally as soon as they are received.
+            std::shared_ptr<FECDecoder> fec {};
+
             // Reset the content.
             void clear();
         };
@@ -181,6 +188,13 @@ namespace ts::mcast {
         // Update the announced length of a file. Return true on success, false if the file should be ignored.
         bool updateFileSize(const FluteSessionId& sid, SessionContext& session, uint64_t toi, FileContext& file, uint64_t file_size);
 
+        // Create the FEC decoder of a file and feed it with previously received symbols.
+        // Return true on success, false if the file should be ignored.
+        bool createFECDecoder(const FluteSessionId& sid, uint64_t toi, FileContext& file, const FECTransmissionInformation& fti);
+
+        // Pass a FEC encoding symbol to the FEC decoder of a file.
+        void addFECSymbol(FileContext& file, const FECPayloadId& fpi, const uint8_t* data, size_t size);
+
         // Process a complete file.
         void processCompleteFile(const FluteSessionId& sid, SessionContext& session, uint64_t toi, FileContext& file);
 
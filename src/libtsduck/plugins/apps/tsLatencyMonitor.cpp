@@ -8,6 +8,7 @@
 
 #include "tsLatencyMonitor.h"
 #include "tstslatencymonitorInputExecutor.h"
+#include "tsInfluxRequest.h"
 #include "tsFileUtils.h"
 
 
@@ -35,7 +36,7 @@ ts::LatencyMonitor::LatencyMonitor(const LatencyMonitorArgs& args, Report& repor
 
     // Get all input plugin options.
     for (size_t i = 0; i < _args.inputs.size(); ++i) {
-        _inputs.push_back(InputData{std::make_shared<tslatencymonitor::InputExecutor>(_args, i, *this, _report), {}});
+        _inputs.push_back(InputData{std::make_shared<tslatencymonitor::InputExecutor>(_args, i, *this, _report), {}, {}, {}, {}});
     }
 
     // Init last output time
@@ -71,6 +72,11 @@ bool ts::LatencyMonitor::start()
     // Output header
     csvHeader();
 
+    // Start the asynchronous InfluxDB sender.
+    if (_args.use_influx && !_influx_sender.start(_args.influx_args)) {
+        return false;
+    }
+
     // Start all input threads
     for (size_t i = 0; i < _inputs.size(); ++i) {
         // Here, start() means start the thread, and start input plugin.
@@ -84,6 +90,9 @@ bool ts::LatencyMonitor::start()
         _inputs[i].inputExecutor->waitForTermination();
     }
 
+    if (_args.use_influx) {
+        _influx_sender.stop();
+    }
     return true;
 }
 
@@ -94,28 +103,62 @@ bool ts::LatencyMonitor::start()
 
 void ts::LatencyMonitor::processPacket(const TSPacketVector& pkt, const TSPacketMetadataVector& metadata, size_t count, size_t pluginIndex)
 {
-    std::lock_guard<std::recursive_mutex> lock(_mutex);
-    TimingDataList& timingDataList = _inputs[pluginIndex].timingDataList;
+    InputData& input(_inputs[pluginIndex]);
+    TimingDataList& timingDataList = input.timingDataList;
+    TimingDataIndex& timingDataIndex = input.timingDataIndex;
+    input.pcrs.clear();
+    input.latencies.clear();
 
+    // Collect the PCR's of the batch outside the global mutex.
     for (size_t i = 0; i < count; i++) {
-        uint64_t pcr = pkt[i].getPCR();
-        const bool has_pcr = pcr != INVALID_PCR;
-        if (has_pcr) {
-            const PCR timestamp = metadata[i].getInputTimeStamp();
-            // Checking to see if the buffer time has been reached, and pop back element (oldest element) if the buffer time has been reached
-            while (!timingDataList.empty() && (timestamp - timingDataList.back().timestamp) >= _args.buffer_time) {
+        const uint64_t pcr = pkt[i].getPCR();
+        if (pcr != INVALID_PCR) {
+            input.pcrs.push_back(TimingData{pcr, metadata[i].getInputTimeStamp()});
+        }
+    }
+
+    if (!input.pcrs.empty()) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const auto& data : input.pcrs) {
+            // Look for the same PCR in the other inputs to get the latency.
+            for (size_t other = 0; other < _inputs.size(); ++other) {
+                if (other != pluginIndex) {
+                    const auto it = _inputs[other].timingDataIndex.find(data.pcr);
+                    if (it != _inputs[other].timingDataIndex.end()) {
+                        input.latencies.push_back(PCR(std::abs((data.timestamp - it->second).count())));
+                    }
+                }
+            }
+            // Checking to see if the buffer time has been reached, and pop back element (oldest element) if the buffer time has been reached.
+            // Remove it from the index, unless the same PCR value was received again later.
+            while (!timingDataList.empty() && (data.timestamp - timingDataList.back().timestamp) >= _args.buffer_time) {
+                const auto it = timingDataIndex.find(timingDataList.back().pcr);
+                if (it != timingDataIndex.end() && it->second == timingDataList.back().timestamp) {
+                    timingDataIndex.erase(it);
+                }
                 timingDataList.pop_back();
             }
-            timingDataList.push_front(TimingData{pcr, timestamp});
+            timingDataList.push_front(data);
+            timingDataIndex[data.pcr] = data.timestamp;
         }
     }
 
+    // Record latencies outside the global mutex, the histogram is lock-free.
+    for (const auto& latency : input.latencies) {
+        _histogram.recordDuration<cn::microseconds>(latency);
+    }
+
     // Check whether the elapsed time since the last output exceeds the output interval.
+    std::lock_guard<std::mutex> lock(_mutex);
     const cn::milliseconds timeDiff = cn::milliseconds(Time::CurrentUTC() - _last_output_time);
     if (timeDiff >= _args.output_interval) {
         // Set output timer to current time
         _last_output_time = Time::CurrentUTC();
+        _histogram.moveTo(_interval_histogram);
         calculatePCRDelta(_inputs);
+        if (_args.use_influx) {
+            sendInflux();
+        }
     }
 }
 
@@ -129,7 +172,13 @@ void ts::LatencyMonitor::csvHeader()
     *_output_file << "PCR1" << DEFAULT_CSV_SEPARATOR
                   << "PCR2" << DEFAULT_CSV_SEPARATOR
                   << "Latency (ms)" << DEFAULT_CSV_SEPARATOR
-                  << "Max Latency (ms)"
+                  << "Max Latency (ms)" << DEFAULT_CSV_SEPARATOR
+                  << "Samples" << DEFAULT_CSV_SEPARATOR
+                  << "Min (ms)" << DEFAULT_CSV_SEPARATOR
+                  << "P50 (ms)" << DEFAULT_CSV_SEPARATOR
+                  << "P99 (ms)" << DEFAULT_CSV_SEPARATOR
+                  << "P99.9 (ms)" << DEFAULT_CSV_SEPARATOR
+                  << "Interval Max (ms)"
                   << std::endl;
 }
 
@@ -181,7 +230,8 @@ void ts::LatencyMonitor::calculatePCRDelta(InputDataVector& inputs)
                 *_output_file << (refTimingDataList == &timingDataList1 ? refTimingData.pcr : shiftTimingData.pcr) << DEFAULT_CSV_SEPARATOR
                               << (refTimingDataList == &timingDataList2 ? refTimingData.pcr : shiftTimingData.pcr) << DEFAULT_CSV_SEPARATOR
                               << latency << DEFAULT_CSV_SEPARATOR
-                              << _max_latency << std::endl;
+                              << _max_latency;
+                outputPercentiles();
 
                 return;
             }
@@ -202,5 +252,38 @@ void ts::LatencyMonitor::calculatePCRDelta(InputDataVector& inputs)
     *_output_file << ((timingDataList1.empty()) ? "LOST" : std::to_string(timingDataList1.front().pcr)) << DEFAULT_CSV_SEPARATOR
                   << ((timingDataList2.empty()) ? "LOST" : std::to_string(timingDataList2.front().pcr)) << DEFAULT_CSV_SEPARATOR
                   << "N/A" << DEFAULT_CSV_SEPARATOR
-                  << "N/A" << std::endl;
+                  << "N/A";
+    outputPercentiles();
+}
+
+
+//----------------------------------------------------------------------------
+// Output the latency percentiles of the last interval.
+//----------------------------------------------------------------------------
+
+void ts::LatencyMonitor::outputPercentiles()
+{
+    // Histogram values are in microseconds, output values are in milliseconds.
+    const LatencyHistogram& h(_interval_histogram);
+    *_output_file << DEFAULT_CSV_SEPARATOR << h.count()
+                  << DEFAULT_CSV_SEPARATOR << double(h.minimum()) / 1000.0
+                  << DEFAULT_CSV_SEPARATOR << double(h.percentile(50.0)) / 1000.0
+                  << DEFAULT_CSV_SEPARATOR << double(h.percentile(99.0)) / 1000.0
+                  << DEFAULT_CSV_SEPARATOR << double(h.percentile(99.9)) / 1000.0
+                  << DEFAULT_CSV_SEPARATOR << double(h.maximum()) / 1000.0
+                  << std::endl;
+}
+
+void ts::LatencyMonitor::sendInflux()
+{
+    // Nothing to report when no latency was measured in the interval.
+    const LatencyHistogram& h(_interval_histogram);
+    if (h.count() > 0) {
+        auto req = std::make_shared<InfluxRequest>(&_report, _args.influx_args);
+        req->start(_last_output_time);
+        req->add(u"latency", UString(),
+                 UString::Format(u"count=%d,min=%d,p50=%d,p99=%d,p999=%d,max=%d",
+                                 h.count(), h.minimum(), h.percentile(50.0), h.percentile(99.0), h.percentile(99.9), h.maximum()));
+        _influx_sender.send(req);
+    }
 }
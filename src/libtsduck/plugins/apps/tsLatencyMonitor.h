@@ -13,6 +13,8 @@
 
 #pragma once
 #include "tsLatencyMonitorArgs.h"
+#include "tsLatencyHistogram.h"
+#include "tsInfluxSender.h"
 #include "tsTime.h"
 
 namespace ts {
@@ -51,6 +53,9 @@ namespace ts {
 
         //!
         //! Called by an input plugin when it received input packets.
+        //! Each time a PCR value is received on one input after being received on the other one,
+        //! the latency between the two inputs is recorded in a lock-free histogram which is shared
+        //! by all inputs. The percentiles of each output interval are reported in the CSV output.
         //! @param [in] pkt Income TS packet.
         //! @param [in] metadata Metadata of income TS packet.
         //! @param [in] count TS packet count.
@@ -64,19 +69,26 @@ namespace ts {
             uint64_t pcr;
             PCR      timestamp;
         };
-        using TimingDataList = std::list<TimingData>;
+        using TimingDataList = std::deque<TimingData>;  // Most recent PCR first.
+        using TimingDataIndex = std::map<uint64_t, PCR>;  // Timestamp of the most recent occurrence of each PCR value.
 
         struct InputData
         {
             std::shared_ptr<tslatencymonitor::InputExecutor> inputExecutor;
             TimingDataList timingDataList;
+            TimingDataIndex timingDataIndex;
+            std::vector<TimingData> pcrs;  // PCR's in the last packet batch, used by the input thread only.
+            std::vector<PCR> latencies;    // Latencies found in the last packet batch, used by the input thread only.
         };
         using InputDataVector = std::vector<InputData>;
 
         Report&              _report;
         LatencyMonitorArgs   _args {};
         InputDataVector      _inputs {};
-        std::recursive_mutex _mutex {};              // Global mutex, protect access to all subsequent fields.
+        LatencyHistogram     _histogram {};          // Latencies in microseconds, lock-free recording by all inputs.
+        InfluxSender         _influx_sender {&_report};  // Send metrics to InfluxDB server.
+        std::mutex           _mutex {};              // Global mutex, protect access to all subsequent fields.
+        LatencyHistogram     _interval_histogram {}; // Latencies in the last output interval.
         double               _max_latency = 0;       // Maximum latency between two inputs
         Time                 _last_output_time {};   // Timestamp to record last output time
         std::ofstream        _output_stream {};      // Output stream file
@@ -87,5 +99,9 @@ namespace ts {
 
         // Calculate delta of two PCRs
         void calculatePCRDelta(InputDataVector& inputs);
+
+        // Output the latency percentiles of the last interval, as CSV fields and to InfluxDB.
+        void outputPercentiles();
+        void sendInflux();
     };
 }
@@ -29,6 +29,13 @@ void ts::LatencyMonitorArgs::defineArgs(Args& args)
     args.help(u"output-interval",
               u"Specify the time interval between each output in seconds. "
               u"The default is 1 second.");
+
+    args.option(u"influx");
+    args.help(u"influx",
+              u"Send the latency percentiles of each output interval to an InfluxDB server. "
+              u"See all other --influx-* options for more details.");
+
+    influx_args.defineArgs(args);
 }
 
 
@@ -42,6 +49,8 @@ bool ts::LatencyMonitorArgs::loadArgs(Args& args)
     args.getPathValue(output_name, u"output-file");
     args.getChronoValue(buffer_time, u"buffer-time", cn::seconds(1));
     args.getChronoValue(output_interval, u"output-interval", cn::seconds(1));
+    use_influx = args.present(u"influx");
+    influx_args.loadArgs(args, use_influx);
 
     // Load all plugin descriptions. Default output is the standard output file.
     ArgsWithPlugins* pargs = dynamic_cast<ArgsWithPlugins*>(&args);
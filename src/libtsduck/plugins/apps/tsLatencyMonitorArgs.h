@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsPluginOptions.h"
+#include "tsInfluxArgs.h"
 
 namespace ts {
 
@@ -30,6 +31,8 @@ namespace ts {
         fs::path            output_name {};       //!< Output file name (empty means stderr).
         cn::seconds         buffer_time {1};      //!< Buffer time of timing data list.
         cn::seconds         output_interval {0};  //!< Waiting time between every output.
+        bool                use_influx = false;   //!< Send latency metrics to an InfluxDB server.
+        InfluxArgs          influx_args {true, false};  //!< InfluxDB connection parameters.
 
         //!
         //! Constructor.
@@ -65,3 +65,14 @@ bool ts::PluginEventData::updateSize(size_t size)
         return true;
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Attach the metadata of the TS packets in the plugin event data.
+//----------------------------------------------------------------------------
+
+void ts::PluginEventData::setMetadata(TSPacketMetadata* mdata, size_t count)
+{
+    _mdata = count == 0 ? nullptr : mdata;
+    _mdata_count = mdata == nullptr ? 0 : count;
+}
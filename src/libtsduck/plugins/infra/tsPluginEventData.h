@@ -15,6 +15,9 @@
 #include "tsObject.h"
 
 namespace ts {
+
+    class TSPacketMetadata;
+
     //!
     //! General-purpose plugin event data referencing binary data to exchange with applications.
     //! @ingroup libtsduck plugin
@@ -113,6 +116,41 @@ namespace ts {
         //!
         bool updateSize(size_t size);
 
+        //!
+        //! Attach the metadata of the TS packets in the plugin event data.
+        //! This is optional, plugins which pass TS packets in the event data may also
+        //! pass the corresponding packet metadata. They are modifiable if the event data are.
+        //! @param [in] mdata Address of an array of packet metadata, one per TS packet in the event data buffer.
+        //! @param [in] count Number of elements in @a mdata. When the event data are modifiable, this is
+        //! the maximum number of packets in the event data buffer, not the current number of packets.
+        //!
+        void setMetadata(TSPacketMetadata* mdata, size_t count);
+
+        //!
+        //! Attach the read-only metadata of the TS packets in the plugin event data.
+        //! @param [in] mdata Address of an array of packet metadata, one per TS packet in the event data buffer.
+        //! @param [in] count Number of elements in @a mdata.
+        //!
+        void setMetadata(const TSPacketMetadata* mdata, size_t count) { setMetadata(const_cast<TSPacketMetadata*>(mdata), count); }
+
+        //!
+        //! Get the address of the read-only packet metadata, if any.
+        //! @return The address of the packet metadata or the null pointer if there is none.
+        //!
+        const TSPacketMetadata* metadata() const { return _mdata; }
+
+        //!
+        //! Get the address of the modifiable packet metadata, if any.
+        //! @return The address of the packet metadata or the null pointer if there is none or the event data area is read-only.
+        //!
+        TSPacketMetadata* outputMetadata() const { return _read_only ? nullptr : _mdata; }
+
+        //!
+        //! Get the number of packet metadata.
+        //! @return The number of packet metadata in metadata().
+        //!
+        size_t metadataCount() const { return _mdata_count; }
+
         //!
         //! Set the error indicator in the event data.
         //! @param [in] error Error indicator (default is true).
@@ -131,5 +169,7 @@ namespace ts {
         uint8_t* _data = nullptr;
         size_t   _max_size = 0;
         size_t   _cur_size = 0;
+        TSPacketMetadata* _mdata = nullptr;
+        size_t   _mdata_count = 0;
     };
 }
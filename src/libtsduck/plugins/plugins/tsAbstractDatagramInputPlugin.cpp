@@ -51,6 +51,27 @@ ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_,
              u"Use this option only when necessary.");
     }
 
+    if (bool(_options & TSDatagramInputOptions::ALLOW_REORDER)) {
+        option(u"reorder-window", 0, INTEGER, 0, 1, 1, 16000);
+        help(u"reorder-window", u"count",
+             u"Reorder the received RTP datagrams according to their sequence numbers, "
+             u"using a reorder buffer of the specified number of datagrams. "
+             u"When a datagram is missing, the subsequent datagrams are held until the missing one is received "
+             u"or the reorder buffer is full. Then, the missing datagram is declared lost. "
+             u"Missing, late and duplicate datagrams are reported in verbose mode. "
+             u"Datagrams which are not RTP packets are not reordered. "
+             u"By default, the datagrams are returned in their order of arrival, without reordering. "
+             u"With --reorder-delay only, the default size of the reorder buffer is " +
+             UString::Decimal(RTPReorderBuffer::DEFAULT_WINDOW) + u" datagrams.");
+
+        option<cn::milliseconds>(u"reorder-delay");
+        help(u"reorder-delay",
+             u"Reorder the received RTP datagrams (see --reorder-window) and specify the maximum time "
+             u"the received datagrams are held while waiting for a missing one. "
+             u"After that delay, the missing datagram is declared lost, even if the reorder buffer is not full. "
+             u"By default, there is no time limit, only the size of the reorder buffer applies.");
+    }
+
     // Order of priority for input timestamps.
     _time_priority_enum.add(u"rtp-tsp", TimePriority::RTP_TSP);
     _time_priority_enum.add(u"tsp", TimePriority::TSP_ONLY);
@@ -98,6 +119,8 @@ bool ts::AbstractDatagramInputPlugin::getOptions()
     }
     _rs204_format = bool(_options & TSDatagramInputOptions::ALLOW_RS204) && present(u"rs204");
     getIntValue(_time_priority, u"timestamp-priority", _default_time_priority);
+    getChronoValue(_reorder_delay, u"reorder-delay");
+    getIntValue(_reorder_window, u"reorder-window", _reorder_delay > cn::milliseconds::zero() ? RTPReorderBuffer::DEFAULT_WINDOW : 0);
     return true;
 }
 
@@ -123,10 +146,33 @@ bool ts::AbstractDatagramInputPlugin::start()
     else {
         _packet_size = 0;
     }
+
+    // The reception buffer of the RTP reorder buffer must be able to receive the largest
+    // datagram, as the input buffer, otherwise large bursts would be truncated.
+    if (_reorder_window > 0) {
+        _reorder.setMessageSeverity(Severity::Verbose);
+        _reorder.reset(_reorder_window, _reorder_delay, _inbuf.size());
+    }
     return true;
 }
 
 
+//----------------------------------------------------------------------------
+// Input stop method
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramInputPlugin::stop()
+{
+    if (_reorder_window > 0) {
+        const RTPReorderBuffer::Statistics& stats(_reorder.statistics());
+        verbose(u"RTP reorder: received %'d RTP datagrams, %'d non-RTP, reordered %'d", stats.rtp_datagrams, stats.non_rtp_datagrams, stats.reordered_datagrams);
+        verbose(u"RTP reorder: missing %'d datagrams, late %'d, duplicate %'d, oversized %'d, resync %'d",
+                stats.missing_datagrams, stats.late_datagrams, stats.duplicate_datagrams, stats.oversized_datagrams, stats.resync_count);
+    }
+    return InputPlugin::stop();
+}
+
+
 //----------------------------------------------------------------------------
 // Input bitrate evaluation method
 //----------------------------------------------------------------------------
@@ -169,7 +215,7 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
 
         // Wait for a datagram message
         size_t insize = 0;
-        if (!receiveDatagram(_inbuf.data(), _inbuf.size(), insize, timestamp, timesource)) {
+        if (!receiveNextDatagram(insize, timestamp, timesource)) {
             return 0;
         }
 
@@ -286,3 +332,48 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
 
     return pkt_cnt;
 }
+
+
+//----------------------------------------------------------------------------
+// Wait for the next datagram message, default implementation.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramInputPlugin::waitDatagram(cn::microseconds, bool& ready)
+{
+    ready = true;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Receive the next datagram, after reordering when necessary.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramInputPlugin::receiveNextDatagram(size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource)
+{
+    if (_reorder_window == 0) {
+        return receiveDatagram(_inbuf.data(), _inbuf.size(), ret_size, timestamp, timesource);
+    }
+
+    // Datagrams are directly received in the reorder buffer.
+    while (!_reorder.getDatagram(_inbuf.data(), _inbuf.size(), ret_size, timestamp, timesource)) {
+        // With --reorder-delay, don't wait for the next datagram beyond the expiration of the held datagrams.
+        monotonic_time expiration;
+        if (_reorder.expiration(expiration)) {
+            bool ready = false;
+            if (!waitDatagram(cn::duration_cast<cn::microseconds>(expiration - monotonic_time::clock::now()), ready)) {
+                return false;
+            }
+            if (!ready) {
+                // Timeout, the held datagrams have expired.
+                continue;
+            }
+        }
+        size_t size = 0;
+        if (!receiveDatagram(_reorder.receiveBuffer(), _reorder.receiveBufferSize(), size, timestamp, timesource)) {
+            return false;
+        }
+        _reorder.commit(size, timestamp, timesource);
+    }
+    return true;
+}
@@ -15,6 +15,7 @@
 #include "tsInputPlugin.h"
 #include "tsTSPacketMetadata.h"
 #include "tsByteBlock.h"
+#include "tsRTPReorderBuffer.h"
 #include "tsNames.h"
 #include "tsTime.h"
 
@@ -24,9 +25,10 @@ namespace ts {
     //! Can be used as bitmasks.
     //!
     enum class TSDatagramInputOptions {
-        NONE        = 0x0000,  //!< No option.
-        REAL_TIME   = 0x0001,  //!< Reception occurs in real-time, typically from the network..
-        ALLOW_RS204 = 0x0002,  //!< Allow RS204 204-byte packets, autodetected, enforced with --rs204.
+        NONE          = 0x0000,  //!< No option.
+        REAL_TIME     = 0x0001,  //!< Reception occurs in real-time, typically from the network..
+        ALLOW_RS204   = 0x0002,  //!< Allow RS204 204-byte packets, autodetected, enforced with --rs204.
+        ALLOW_REORDER = 0x0004,  //!< Allow reordering of RTP datagrams with --reorder-window and --reorder-delay.
     };
 }
 TS_ENABLE_BITMASK_OPERATORS(ts::TSDatagramInputOptions);
@@ -45,6 +47,7 @@ namespace ts {
         // Implementation of plugin API.
         virtual bool getOptions() override;
         virtual bool start() override;
+        virtual bool stop() override;
         virtual bool isRealTime() override;
         virtual BitRate getBitrate() override;
         virtual BitRateConfidence getBitrateConfidence() override;
@@ -83,6 +86,17 @@ namespace ts {
         //!
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource) = 0;
 
+        //!
+        //! Wait for the next datagram message, with a timeout.
+        //! With --reorder-delay, this is called before receiveDatagram() when RTP datagrams are held in
+        //! the reorder buffer, to avoid waiting for the next datagram beyond their expiration.
+        //! The default implementation does not wait and always reports a datagram as ready.
+        //! @param [in] timeout Maximum time to wait for the next datagram.
+        //! @param [out] ready Set to true if a datagram can be received, false on timeout.
+        //! @return True on success, false on error.
+        //!
+        virtual bool waitDatagram(cn::microseconds timeout, bool& ready);
+
         //!
         //! Specify if the input is made of datagrams of several TS packets (true by default).
         //! @param [in] on When true, the input is made of datagrams of several TS packets.
@@ -101,6 +115,8 @@ namespace ts {
         TimePriority     _time_priority = RTP_TSP;         // Priority of time stamps sources.
         TimePriority     _default_time_priority = RTP_TSP; // Priority of time stamps sources.
         bool             _rs204_format = false;            // Input packets are always 204-byte format.
+        size_t           _reorder_window = 0;              // Size of RTP reorder window, zero means no reordering.
+        cn::milliseconds _reorder_delay {};                // Maximum delay in RTP reorder buffer.
 
         // Working data.
         bool          _datagram = true;     // The input is made of UDP datagrams.
@@ -117,5 +133,9 @@ namespace ts {
         size_t        _packet_size = 0;     // Packet size (188 or 204).
         ByteBlock     _inbuf {};            // Input buffer
         TSPacketMetadataVector _mdata {};   // Metadata for packets in _inbuf
+        RTPReorderBuffer _reorder {this};   // Reorder buffer for RTP datagrams.
+
+        // Receive the next datagram in _inbuf, after reordering when necessary.
+        bool receiveNextDatagram(size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource);
     };
 }
@@ -12,6 +12,9 @@
 // Stack usage required by this module in the ECM deciphering thread.
 #define ECM_THREAD_STACK_OVERHEAD (16  * 1024)
 
+// Number of packets which are descrambled together in packet window mode.
+#define PACKET_WINDOW_SIZE 128
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -121,6 +124,9 @@ bool ts::AbstractDescrambler::start()
     _abort = false;
     _ecm_streams.clear();
     _scrambled_streams.clear();
+    _window_mode = false;
+    _batch.clear();
+    _batch_streams.clear();
     _demux.reset();
 
     // Initialize the scrambling engine.
@@ -458,7 +464,7 @@ ts::PacketProcessStatus ts::AbstractDescrambler::processPacket(TSPacket& pkt, TS
     // If there is a user-specified list of PID's, we don't manage a service
     // and there is nothing else to do.
     if (_pids.any()) {
-        return !_pids.test(pid) || _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return !_pids.test(pid) || descramble(_scrambling, _batch, pkt) ? TSP_OK : TSP_END;
     }
 
     // Filter sections to locate the service and grab ECM's.
@@ -480,7 +486,7 @@ ts::PacketProcessStatus ts::AbstractDescrambler::processPacket(TSPacket& pkt, TS
 
     // Without ECM's, we descramble using fixed control words.
     if (!_need_ecm) {
-        return _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return descramble(_scrambling, _batch, pkt) ? TSP_OK : TSP_END;
     }
 
     // Get PID context. If the PID is not known as a scrambled PID,
@@ -509,7 +515,11 @@ ts::PacketProcessStatus ts::AbstractDescrambler::processPacket(TSPacket& pkt, TS
     // Flags new_cw_even/odd are "write-protected, read-volatile", no mutex needed.
     if ((scv == SC_EVEN_KEY && pecm->new_cw_even) || (scv == SC_ODD_KEY && pecm->new_cw_odd)) {
 
-        // A new CW was deciphered.
+        // A new CW was deciphered. Previous packets in the packet window use the previous CW.
+        if (!descrambleBatch(pecm->scrambling, pecm->batch)) {
+            return TSP_END;
+        }
+
         // In asynchronous mode, the CW are accessed under mutex protection.
         if (!_synchronous) {
             _mutex.lock();
@@ -533,7 +543,72 @@ ts::PacketProcessStatus ts::AbstractDescrambler::processPacket(TSPacket& pkt, TS
     }
 
     // Descramble the packet payload.
-    return pecm->scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+    if (_window_mode) {
+        _batch_streams.insert(pecm);
+    }
+    return descramble(pecm->scrambling, pecm->batch, pkt) ? TSP_OK : TSP_END;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing.
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractDescrambler::getPacketWindowSize()
+{
+    // The scrambling type from ECM's is not known in advance. With fixed control words,
+    // use packet windows only when the CBC chains of many packets can be interleaved.
+    _window_mode = _need_ecm || _scrambling.hasBatchEngine();
+    return _window_mode ? PACKET_WINDOW_SIZE : 0;
+}
+
+size_t ts::AbstractDescrambler::processPacketWindow(TSPacketWindow& win)
+{
+    TSPacket* pkt = nullptr;
+    TSPacketMetadata* pkt_data = nullptr;
+    size_t count = 0;
+
+    // Process all packets, the descrambling of the payloads is deferred.
+    for (; count < win.size(); ++count) {
+        if (win.get(count, pkt, pkt_data)) {
+            const PacketProcessStatus status = processPacket(*pkt, *pkt_data);
+            if (status == TSP_END) {
+                break;
+            }
+            else if (status == TSP_NULL) {
+                win.nullify(count);
+            }
+            else if (status == TSP_DROP) {
+                win.drop(count);
+            }
+        }
+    }
+
+    // Descramble all packets at once, by descrambling engine.
+    bool ok = descrambleBatch(_scrambling, _batch);
+    for (const auto& pecm : _batch_streams) {
+        ok = descrambleBatch(pecm->scrambling, pecm->batch) && ok;
+    }
+    _batch_streams.clear();
+    return ok ? count : 0;
+}
+
+bool ts::AbstractDescrambler::descramble(TSScrambling& scrambling, std::vector<TSPacket*>& batch, TSPacket& pkt)
+{
+    if (_window_mode) {
+        batch.push_back(&pkt);
+        return true;
+    }
+    else {
+        return scrambling.decrypt(pkt);
+    }
+}
+
+bool ts::AbstractDescrambler::descrambleBatch(TSScrambling& scrambling, std::vector<TSPacket*>& batch)
+{
+    const bool ok = batch.empty() || scrambling.decrypt(batch.data(), batch.size());
+    batch.clear();
+    return ok;
 }
 
 TS_POP_WARNING()
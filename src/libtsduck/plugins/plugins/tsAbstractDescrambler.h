@@ -36,6 +36,8 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
         virtual PacketProcessStatus processPacket(TSPacket&, TSPacketMetadata&) override;
 
     protected:
@@ -202,6 +204,7 @@ namespace ts {
             CWData        cw_even {};           // Last valid CW (even)
             CWData        cw_odd {};            // Last valid CW (odd)
             // -- end of protected area --
+            std::vector<TSPacket*> batch {};    // Packets to descramble at end of current packet window.
         };
 
         using ECMStreamPtr = std::shared_ptr<ECMStream>;
@@ -234,6 +237,12 @@ namespace ts {
         // Analyze a list of descriptors from the PMT, looking for ECM PID's
         void analyzeDescriptors(const DescriptorList& dlist, std::set<PID>& ecm_pids, uint8_t& scrambling);
 
+        // Descramble a packet. In packet window mode, the packet is added in a batch, descrambled at end of window.
+        bool descramble(TSScrambling& scrambling, std::vector<TSPacket*>& batch, TSPacket& pkt);
+
+        // Descramble all packets in a batch.
+        bool descrambleBatch(TSScrambling& scrambling, std::vector<TSPacket*>& batch);
+
         // Abstract descrambler private data.
         bool                    _use_service = false;         // Descramble a service (ie. not a specific list of PID's).
         bool                    _need_ecm = false;            // We need to get control words from ECM's.
@@ -241,6 +250,9 @@ namespace ts {
         bool                    _synchronous = false;         // Synchronous ECM deciphering.
         bool                    _swap_cw = false;             // Swap even/odd CW from ECM.
         TSScrambling            _scrambling {*this};          // Default descrambling (used with fixed control words).
+        bool                    _window_mode = false;         // Packets are processed by packet windows.
+        std::vector<TSPacket*>  _batch {};                    // Packets to descramble with _scrambling at end of packet window.
+        std::set<ECMStreamPtr>  _batch_streams {};            // ECM streams with packets to descramble at end of packet window.
         PIDSet                  _pids {};                     // Explicit PID's to descramble.
         ServiceDiscovery        _service {duck, this};        // Service to descramble (by name, id or none).
         size_t                  _stack_usage;                 // Stack usage for ECM deciphering.
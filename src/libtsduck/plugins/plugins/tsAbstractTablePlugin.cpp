@@ -28,6 +28,8 @@ ts::AbstractTablePlugin::AbstractTablePlugin(TSP* tsp_,
     _pzer(duck, pid),
     _patch_xml(duck)
 {
+    // The modified or created table is static between two updates, its cycle is precompiled.
+    _pzer.setPrecompiled(true);
     _patch_xml.defineArgs(*this);
 
     option<BitRate>(u"bitrate", 'b');
@@ -24,8 +24,15 @@ ts::ForkOutputPlugin::ForkOutputPlugin(TSP* tsp_) :
     option(u"", 0, STRING, 1, 1);
     help(u"", u"Specifies the command line to execute in the created process.");
 
+    option(u"async-packets", 0, POSITIVE);
+    help(u"async-packets",
+         u"Write the packets to the pipe from a separate thread, using a queue of the specified number of TS packets. "
+         u"A slow process does not block the processing chain, unless the queue is full. "
+         u"On Linux, the packets are transferred into the pipe using vmsplice(), without copy into the kernel. "
+         u"By default, the packets are synchronously written to the pipe.");
+
     option(u"buffered-packets", 'b', POSITIVE);
-    help(u"buffered-packets", u"Windows only: Specifies the pipe buffer size in number of TS packets.");
+    help(u"buffered-packets", u"Windows and Linux only: Specifies the pipe buffer size in number of TS packets.");
 
     option(u"nowait", 'n');
     help(u"nowait", u"Do not wait for child process termination at end of input.");
@@ -41,6 +48,7 @@ bool ts::ForkOutputPlugin::getOptions()
     // Get command line arguments.
     getValue(_command, u"");
     getIntValue(_buffer_size, u"buffered-packets", 0);
+    getIntValue(_async_packets, u"async-packets", 0);
     _nowait = present(u"nowait");
     _format = LoadTSPacketFormatOutputOption(*this);
     return true;
@@ -50,9 +58,10 @@ bool ts::ForkOutputPlugin::getOptions()
 bool ts::ForkOutputPlugin::start()
 {
     // Create pipe & process.
+    _pipe.setAsyncWriteSize(PKT_SIZE * _async_packets);
     return _pipe.open(_command,
                       _nowait ? ForkPipe::ASYNCHRONOUS : ForkPipe::SYNCHRONOUS,
-                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows only), same as internal buffer size.
+                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows and Linux), same as internal buffer size.
                       *this,                    // Error reporting.
                       ForkPipe::KEEP_BOTH,      // Output: same stdout and stderr as tsp process.
                       ForkPipe::STDIN_PIPE,     // Input: use the pipe.
@@ -37,6 +37,7 @@ namespace ts {
         bool           _nowait = false;   // Don't wait for children termination.
         TSPacketFormat _format = TSPacketFormat::TS;  // Packet format on the pipe
         size_t         _buffer_size = 0;  // Pipe buffer size in packets.
+        size_t         _async_packets = 0; // Asynchronous write queue size in packets.
         TSForkPipe     _pipe {};          // The pipe device.
     };
 }
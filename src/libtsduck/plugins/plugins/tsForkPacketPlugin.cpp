@@ -22,6 +22,7 @@ ts::ForkPacketPlugin::ForkPacketPlugin(TSP* tsp_) :
     _nowait(false),
     _format(TSPacketFormat::TS),
     _buffer_size(0),
+    _async_packets(0),
     _buffer_count(0),
     _buffer(),
     _mdata(),
@@ -32,6 +33,13 @@ ts::ForkPacketPlugin::ForkPacketPlugin(TSP* tsp_) :
     option(u"", 0, STRING, 1, 1);
     help(u"", u"Specifies the command line to execute in the created process.");
 
+    option(u"async-packets", 0, POSITIVE);
+    help(u"async-packets",
+         u"Write the packets to the pipe from a separate thread, using a queue of the specified number of TS packets. "
+         u"A slow process does not block the processing chain, unless the queue is full. "
+         u"On Linux, the packets are transferred into the pipe using vmsplice(), without copy into the kernel. "
+         u"By default, the packets are synchronously written to the pipe.");
+
     option(u"buffered-packets", 'b', UNSIGNED); // zero allowed
     help(u"buffered-packets",
          u"Specifies the number of TS packets to buffer before sending them through "
@@ -59,6 +67,7 @@ bool ts::ForkPacketPlugin::getOptions()
     // Get command line arguments
     getValue(_command, u"");
     getIntValue(_buffer_size, u"buffered-packets", tsp->realtime() ? 500 : 1000);
+    getIntValue(_async_packets, u"async-packets", 0);
     _nowait = present(u"nowait");
     _format = LoadTSPacketFormatOutputOption(*this);
     _pipe.setIgnoreAbort(present(u"ignore-abort"));
@@ -77,9 +86,10 @@ bool ts::ForkPacketPlugin::start()
     _buffer_count = 0;
 
     // Create pipe & process.
+    _pipe.setAsyncWriteSize(PKT_SIZE * _async_packets);
     return _pipe.open(_command,
                       _nowait ? ForkPipe::ASYNCHRONOUS : ForkPipe::SYNCHRONOUS,
-                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows only), same as internal buffer size.
+                      PKT_SIZE * _buffer_size,  // Pipe buffer size (Windows and Linux), same as internal buffer size.
                       *this,                    // Error reporting.
                       ForkPipe::KEEP_BOTH,      // Output: same stdout and stderr as tsp process.
                       ForkPipe::STDIN_PIPE,     // Input: use the pipe.
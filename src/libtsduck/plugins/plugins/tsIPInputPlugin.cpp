@@ -20,10 +20,25 @@ TS_REGISTER_INPUT_PLUGIN(u"ip", ts::IPInputPlugin);
 ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
     AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port",
                                 u"kernel", u"A kernel-provided timestamp for the packet, when available (Linux only)",
-                                TSDatagramInputOptions::REAL_TIME | TSDatagramInputOptions::ALLOW_RS204)
+                                TSDatagramInputOptions::REAL_TIME | TSDatagramInputOptions::ALLOW_RS204 | TSDatagramInputOptions::ALLOW_REORDER)
 {
     // Add UDP receiver common options.
     _sock_args.defineArgs(*this, true, true);
+
+    option(u"fec");
+    help(u"fec",
+         u"Receive the SMPTE 2022-1 Forward Error Correction (FEC) streams which are associated with the RTP input stream. "
+         u"Column FEC packets are received on the input UDP port plus " + UString::Decimal(FEC2022_COLUMN_PORT_OFFSET) +
+         u" and row FEC packets are received on the input UDP port plus " + UString::Decimal(FEC2022_ROW_PORT_OFFSET) + u". "
+         u"Lost RTP packets are recovered when possible and all RTP packets are reordered according to their sequence numbers. "
+         u"Recovery statistics are displayed at the end of the reception with --verbose.");
+
+    option(u"fec-window", 0, POSITIVE);
+    help(u"fec-window", u"count",
+         u"With --fec, specify the size of the reorder window in RTP packets. "
+         u"When an RTP packet is missing, subsequent packets are held until the missing packet is received or recovered, "
+         u"up to this number of packets. After that, the missing packet is declared lost. "
+         u"The default is " + UString::Decimal(SMPTE2022FECDecoder::DEFAULT_WINDOW) + u" packets.");
 }
 
 
@@ -36,6 +51,8 @@ bool ts::IPInputPlugin::getOptions()
     // Get command line arguments for superclass and socket.
     const bool ok = AbstractDatagramInputPlugin::getOptions() && _sock_args.loadArgs(*this, _sock.parameters().receive_timeout);
     _sock.setParameters(_sock_args);
+    _use_fec = present(u"fec");
+    getIntValue(_fec_window, u"fec-window", SMPTE2022FECDecoder::DEFAULT_WINDOW);
     return ok;
 }
 
@@ -47,7 +64,27 @@ bool ts::IPInputPlugin::getOptions()
 bool ts::IPInputPlugin::start()
 {
     // Initialize superclass and UDP socket.
-    return AbstractDatagramInputPlugin::start() && _sock.open();
+    if (!AbstractDatagramInputPlugin::start() || !_sock.open()) {
+        return false;
+    }
+
+    // Open SMPTE 2022-1 FEC sockets and start their receiver threads.
+    if (_use_fec) {
+        _fec.reset(_fec_window);
+        _fec_terminate = false;
+        if (!_fec_columns.open(_sock_args, FEC2022_COLUMN_PORT_OFFSET)) {
+            _sock.close();
+            return false;
+        }
+        if (!_fec_rows.open(_sock_args, FEC2022_ROW_PORT_OFFSET)) {
+            _fec_columns.close();
+            _sock.close();
+            return false;
+        }
+        _fec_columns.start();
+        _fec_rows.start();
+    }
+    return true;
 }
 
 
@@ -58,6 +95,20 @@ bool ts::IPInputPlugin::start()
 bool ts::IPInputPlugin::stop()
 {
     _sock.close();
+
+    // Terminate FEC receiver threads and report recovery statistics.
+    if (_use_fec) {
+        _fec_terminate = true;
+        _fec_columns.close();
+        _fec_rows.close();
+        _fec_columns.waitForTermination();
+        _fec_rows.waitForTermination();
+
+        const SMPTE2022FECDecoder::Statistics& stats(_fec.statistics());
+        verbose(u"FEC: received %'d RTP packets, %'d column FEC, %'d row FEC packets", stats.media_packets, stats.column_packets, stats.row_packets);
+        verbose(u"FEC: recovered %'d RTP packets, lost %'d, duplicate %'d, late %'d, invalid %'d, resync %'d",
+                stats.recovered_packets, stats.lost_packets, stats.duplicate_packets, stats.late_packets, stats.invalid_packets, stats.resync_count);
+    }
     return AbstractDatagramInputPlugin::stop();
 }
 
@@ -72,6 +123,11 @@ bool ts::IPInputPlugin::abortInput()
     if (_sock.isOpen()) {
         _sock.close();
     }
+    if (_use_fec) {
+        _fec_terminate = true;
+        _fec_columns.close();
+        _fec_rows.close();
+    }
     return true;
 }
 
@@ -94,6 +150,37 @@ bool ts::IPInputPlugin::setReceiveTimeout(cn::milliseconds timeout)
 //----------------------------------------------------------------------------
 
 bool ts::IPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource)
+{
+    if (!_use_fec) {
+        return receiveMedia(buffer, buffer_size, ret_size, timestamp, timesource);
+    }
+
+    // With FEC, RTP packets are returned by the decoder in sequence order, after recovery.
+    // A returned packet gets the timestamp of the last received datagram.
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(_fec_mutex);
+            if (_fec.getPacket(buffer, buffer_size, ret_size)) {
+                return true;
+            }
+        }
+        if (!receiveMedia(buffer, buffer_size, ret_size, timestamp, timesource)) {
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(_fec_mutex);
+        if (!_fec.addMediaPacket(buffer, ret_size)) {
+            // Not an RTP packet, return it as is.
+            return true;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Receive a datagram on the media socket.
+//----------------------------------------------------------------------------
+
+bool ts::IPInputPlugin::receiveMedia(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource)
 {
     IPSocketAddress sender;
     IPSocketAddress destination;
@@ -113,3 +200,54 @@ bool ts::IPInputPlugin::receiveDatagram(uint8_t* buffer, size_t buffer_size, siz
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Wait for the next media datagram, with a timeout.
+//----------------------------------------------------------------------------
+
+bool ts::IPInputPlugin::waitDatagram(cn::microseconds timeout, bool& ready)
+{
+    return _sock.waitReadable(timeout, ready);
+}
+
+
+//----------------------------------------------------------------------------
+// SMPTE 2022-1 FEC receiver threads.
+//----------------------------------------------------------------------------
+
+bool ts::IPInputPlugin::FECReceiver::open(const UDPReceiverArgs& args, uint16_t port_offset)
+{
+    // Same options as the media stream, on another UDP port, without timeout.
+    UDPReceiverArgs fec_args(args);
+    fec_args.destination.setPort(args.destination.port() + port_offset);
+    fec_args.receive_timeout = cn::milliseconds(-1);
+    _sock.setParameters(fec_args);
+    _plugin->debug(u"receiving %s FEC on %s", _name, fec_args.destination);
+    return _sock.open();
+}
+
+void ts::IPInputPlugin::FECReceiver::close()
+{
+    if (_sock.isOpen()) {
+        _sock.close();
+    }
+}
+
+void ts::IPInputPlugin::FECReceiver::main()
+{
+    _plugin->debug(u"%s FEC reception thread started", _name);
+
+    ByteBlock buffer(IP_MAX_PACKET_SIZE);
+    size_t insize = 0;
+    IPSocketAddress sender;
+    IPSocketAddress destination;
+
+    // Loop on message reception until a receive error (probably an end of execution).
+    while (!_plugin->_fec_terminate && _sock.receive(buffer.data(), buffer.size(), insize, sender, destination, _plugin->tsp)) {
+        std::lock_guard<std::mutex> lock(_plugin->_fec_mutex);
+        _plugin->_fec.addFECPacket(buffer.data(), insize);
+    }
+
+    _plugin->debug(u"%s FEC reception thread completed", _name);
+}
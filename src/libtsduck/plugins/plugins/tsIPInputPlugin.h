@@ -14,6 +14,8 @@
 #pragma once
 #include "tsAbstractDatagramInputPlugin.h"
 #include "tsUDPReceiver.h"
+#include "tsSMPTE2022FECDecoder.h"
+#include "tsThread.h"
 
 namespace ts {
     //!
@@ -34,9 +36,45 @@ namespace ts {
     protected:
         // Implementation of AbstractDatagramInputPlugin.
         virtual bool receiveDatagram(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource) override;
+        virtual bool waitDatagram(cn::microseconds timeout, bool& ready) override;
 
     private:
+        // Each SMPTE 2022-1 FEC stream (column or row) is received in a thread of this class.
+        class FECReceiver: public Thread
+        {
+            TS_NOBUILD_NOCOPY(FECReceiver);
+        public:
+            // Constructor.
+            FECReceiver(IPInputPlugin* plugin, const UString& name) : _plugin(plugin), _name(name) {}
+
+            // Open/close UDP socket.
+            bool open(const UDPReceiverArgs& args, uint16_t port_offset);
+            void close();
+
+        protected:
+            // Invoked in the context of the receiver thread.
+            virtual void main() override;
+
+        private:
+            IPInputPlugin* const _plugin;
+            const UString        _name;
+            UDPReceiver          _sock {_plugin};
+        };
+
+        // Command line options.
         UDPReceiverArgs _sock_args {};
+        bool            _use_fec = false;     // Receive and use SMPTE 2022-1 FEC streams.
+        size_t          _fec_window = 0;      // Size of the FEC reorder window in datagrams.
+
+        // Working data.
         UDPReceiver     _sock {this};
+        std::atomic_bool _fec_terminate = false;
+        std::mutex      _fec_mutex {};        // Protect the FEC decoder against the receiver threads.
+        SMPTE2022FECDecoder _fec {};
+        FECReceiver     _fec_columns {this, u"column"};
+        FECReceiver     _fec_rows {this, u"row"};
+
+        // Receive a datagram on the media socket.
+        bool receiveMedia(uint8_t* buffer, size_t buffer_size, size_t& ret_size, cn::microseconds& timestamp, TimeSource& timesource);
     };
 }
@@ -52,6 +52,7 @@ size_t ts::MemoryInputPlugin::receive(TSPacket* buffer, TSPacketMetadata* metada
 {
     // Prepare an event data block pointing to the input buffer.
     PluginEventData data(buffer->b, 0, PKT_SIZE * max_packets);
+    data.setMetadata(metadata, max_packets);
     tsp->signalPluginEvent(_event_code, &data);
     return data.size() / PKT_SIZE;
 }
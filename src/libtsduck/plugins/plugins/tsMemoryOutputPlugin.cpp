@@ -51,6 +51,7 @@ bool ts::MemoryOutputPlugin::send(const TSPacket* packets, const TSPacketMetadat
 {
     // Prepare an event data block pointing to the output packets.
     PluginEventData data(packets->b, PKT_SIZE * packet_count);
+    data.setMetadata(metadata, packet_count);
     tsp->signalPluginEvent(_event_code, &data);
     return !data.hasError();
 }
@@ -174,12 +174,17 @@ void ts::tsmux::Core::main()
     _output_sdt.onetw_id = _opt.outputNetwId;
     _eits.clear();
 
-    // Reset packetizers for output PSI/SI.
+    // Reset packetizers for output PSI/SI. The PAT, CAT, NIT and SDT/BAT cycles are static between
+    // two updates, they are precompiled. EIT's are provided on demand, they cannot be precompiled.
     _pat_pzer.reset();
     _cat_pzer.reset();
     _nit_pzer.reset();
     _sdt_bat_pzer.reset();
     _eit_pzer.reset();
+    _pat_pzer.setPrecompiled(true);
+    _cat_pzer.setPrecompiled(true);
+    _nit_pzer.setPrecompiled(true);
+    _sdt_bat_pzer.setPrecompiled(true);
 
     // Insertion interval for signalization.
     const PacketCounter pat_interval = (_opt.outputBitRate / _opt.patBitRate).toInt();
@@ -8,6 +8,7 @@
 
 #include "tspyPluginEventHandler.h"
 #include "tsPluginEventData.h"
+#include "tsTSPacketMetadata.h"
 #include "tspy.h"
 #include "tsMemory.h"
 
@@ -16,9 +17,9 @@
 // Python interface.
 //----------------------------------------------------------------------------
 
-TSDUCKPY void* tspyNewPyPluginEventHandler(ts::py::PluginEventHandler::PyCallback callback)
+TSDUCKPY void* tspyNewPyPluginEventHandler(ts::py::PluginEventHandler::PyCallback callback, bool metadata)
 {
-    return new ts::py::PluginEventHandler(callback);
+    return new ts::py::PluginEventHandler(callback, metadata);
 }
 
 TSDUCKPY void tspyDeletePyPluginEventHandler(void* obj)
@@ -43,12 +44,23 @@ TSDUCKPY void tspyPyPluginEventHandlerUpdateData(void* obj, void* data, size_t s
     }
 }
 
+// Update the size of a PluginEventData after direct write in its buffer.
+// Called from the Python callback in zero-copy mode.
+TSDUCKPY void tspyPyPluginEventHandlerUpdateSize(void* obj, size_t size)
+{
+    ts::PluginEventData* event_data = reinterpret_cast<ts::PluginEventData*>(obj);
+    if (event_data != nullptr && !event_data->updateSize(size)) {
+        event_data->setError(true);
+    }
+}
+
 //----------------------------------------------------------------------------
 // Constructors and destructors.
 //----------------------------------------------------------------------------
 
-ts::py::PluginEventHandler::PluginEventHandler(PyCallback callback) :
-    _callback(callback)
+ts::py::PluginEventHandler::PluginEventHandler(PyCallback callback, bool metadata) :
+    _callback(callback),
+    _metadata(metadata)
 {
 }
 
@@ -67,7 +79,17 @@ void ts::py::PluginEventHandler::handlePluginEvent(const PluginEventContext& con
         static const uint8_t dummy = 0;
         PluginEventData* event_data = dynamic_cast<PluginEventData*>(context.pluginData());
         const bool valid_data = event_data != nullptr && event_data->data() != nullptr;
+        const bool read_only_data = !valid_data || event_data->readOnly();
         const UString name(context.pluginName());
+
+        // Serialize the packet metadata in a reused buffer.
+        const TSPacketMetadata* mdata = _metadata && valid_data ? event_data->metadata() : nullptr;
+        const size_t mdata_count = mdata == nullptr ? 0 : std::min(event_data->metadataCount(), (read_only_data ? event_data->size() : event_data->maxSize()) / PKT_SIZE);
+        _mdata.resize(mdata_count * TSPacketMetadata::SERIALIZATION_SIZE);
+        for (size_t i = 0; i < mdata_count; ++i) {
+            mdata[i].serialize(_mdata.data() + i * TSPacketMetadata::SERIALIZATION_SIZE, TSPacketMetadata::SERIALIZATION_SIZE);
+        }
+
         const bool success = _callback(context.eventCode(),
                                        name.data(),
                                        name.size() * sizeof(UChar),
@@ -79,10 +101,22 @@ void ts::py::PluginEventHandler::handlePluginEvent(const PluginEventContext& con
                                        valid_data ? event_data->data() : &dummy,
                                        valid_data ? event_data->size() : 0,
                                        valid_data ? event_data->maxSize() : 0,
-                                       !valid_data || event_data->readOnly(),
+                                       read_only_data,
+                                       _mdata.data(),
+                                       _mdata.size(),
                                        event_data);
         if (!success && event_data != nullptr ) {
             event_data->setError(true);
         }
+
+        // Get back the metadata of the returned packets, the data size was updated by the callback.
+        if (success && !read_only_data && mdata_count > 0) {
+            TSPacketMetadata* outmdata = event_data->outputMetadata();
+            if (outmdata != nullptr) {
+                for (size_t i = 0; i < std::min(mdata_count, event_data->size() / PKT_SIZE); ++i) {
+                    outmdata[i].deserialize(_mdata.data() + i * TSPacketMetadata::SERIALIZATION_SIZE, TSPacketMetadata::SERIALIZATION_SIZE);
+                }
+            }
+        }
     }
 }
@@ -13,6 +13,7 @@
 
 #pragma once
 #include "tsPluginEventHandlerInterface.h"
+#include "tsByteBlock.h"
 
 namespace ts {
     namespace py {
@@ -39,13 +40,16 @@ namespace ts {
                                         size_t         data_size,
                                         size_t         data_max_size,
                                         bool           data_read_only,
+                                        uint8_t*       mdata_addr,
+                                        size_t         mdata_size,
                                         void*          event_data);
 
             //!
             //! Constructor.
             //! @param [in] callback Python callback to receive events.
+            //! @param [in] metadata If true, the packet metadata are serialized and passed to the callback.
             //!
-            PluginEventHandler(PyCallback callback);
+            PluginEventHandler(PyCallback callback, bool metadata);
 
             //!
             //! Destructor.
@@ -54,6 +58,8 @@ namespace ts {
 
         private:
             PyCallback _callback;
+            bool       _metadata;
+            ByteBlock  _mdata {};  // Serialized packet metadata, reused from one event to another.
 
             // Inherited from ts::PluginEventHandlerInterface:
             virtual void handlePluginEvent(const PluginEventContext& context) override;
@@ -758,6 +758,18 @@ class DuckContext(NativeObject):
 #
 class PluginEventContext:
 
+    ##
+    # Size in bytes of the serialized metadata of one TS packet in packet_metadata.
+    # The layout of the serialized metadata is:
+    # - byte 0: 0xB8 (constant).
+    # - bytes 1-8: input time stamp in PCR units (27 MHz), -1 if there is none.
+    # - bytes 9-12: bit mask of packet labels, bit N is label N.
+    # - byte 13: flags (0x80: input stuffing, 0x40: nullified, 0x20: datagram), type of input time stamp in the 4 LSB.
+    #
+    # Multi-byte values are big-endian.
+    #
+    METADATA_SIZE = 14
+
     ##
     # Constructor.
     #
@@ -778,8 +790,14 @@ class PluginEventContext:
         self.total_packets = 0
         ## Indicate if the event data are read-only or if they can be updated.
         self.read_only_data = True
+        ## Size in bytes of the input event data.
+        self.data_size = 0
         ## Maximum returned data size in bytes (if they can be modified).
         self.max_data_size = 0
+        ## In zero-copy mode, a memoryview over the serialized metadata of the TS packets in the
+        ## event data, METADATA_SIZE bytes per packet, or None if the plugin does not pass packet metadata.
+        ## If the event data can be updated, the metadata of the returned packets can be updated in the view.
+        self.packet_metadata = None
 
 
 #-----------------------------------------------------------------------------
@@ -794,9 +812,12 @@ class AbstractPluginEventHandler(NativeObject):
 
     ##
     # Constructor.
+    # @param zero_copy If True, the event data are passed to handlePluginEvent() as a memoryview
+    # which directly maps the plugin buffer, without copy. See handlePluginEvent() for details.
     #
-    def __init__(self):
+    def __init__(self, zero_copy = False):
         super().__init__()
+        self.__zero_copy = zero_copy
 
         # Profile of the Python callback!
         callback = ctypes.CFUNCTYPE(ctypes.c_bool, # return type
@@ -804,14 +825,14 @@ class AbstractPluginEventHandler(NativeObject):
                                     ctypes.c_size_t, ctypes.c_size_t, ctypes.c_size_t,
                                     ctypes.c_size_t, ctypes.c_size_t,
                                     ctypes.POINTER(ctypes.c_ubyte), ctypes.c_size_t, ctypes.c_size_t,
-                                    ctypes.c_bool, ctypes.c_void_p)
+                                    ctypes.c_bool, ctypes.c_void_p, ctypes.c_size_t, ctypes.c_void_p)
 
         #-- The internal callback with profile above, called from the C++ class.
         def event_callback(event_code, name_addr, name_size,
                            plugin_index, plugin_count, bitrate,
                            plugin_packets, total_packets,
                            data_addr, data_size, data_max_size,
-                           data_read_only, event_data_obj):
+                           data_read_only, mdata_addr, mdata_size, event_data_obj):
 
             # Build a PluginEventContext from individual fields.
             context = PluginEventContext()
@@ -823,42 +844,62 @@ class AbstractPluginEventHandler(NativeObject):
             context.plugin_packets = plugin_packets
             context.total_packets = total_packets
             context.read_only_data = bool(data_read_only)
+            context.data_size = data_size
             context.max_data_size = 0 if data_read_only else data_max_size
 
             # Build the input binary data of the event.
-            event_data = bytes(ctypes.string_at(data_addr, data_size))
+            if self.__zero_copy:
+                # Direct view over the plugin buffer, the complete buffer if it can be updated.
+                view_size = data_size if data_read_only else data_max_size
+                if view_size > 0:
+                    carray_type = ctypes.c_uint8 * view_size
+                    event_data = memoryview(carray_type.from_address(ctypes.cast(data_addr, ctypes.c_void_p).value)).cast('B')
+                else:
+                    event_data = memoryview(bytearray())
+                if data_read_only:
+                    event_data = event_data.toreadonly()
+                # Direct view over the serialized packet metadata, updated metadata are returned to the plugin.
+                if mdata_size > 0:
+                    carray_type = ctypes.c_uint8 * mdata_size
+                    context.packet_metadata = memoryview(carray_type.from_address(mdata_addr)).cast('B')
+                    if data_read_only:
+                        context.packet_metadata = context.packet_metadata.toreadonly()
+            else:
+                event_data = ctypes.string_at(data_addr, data_size)
 
             # Call the public Python callback.
             ret = self.handlePluginEvent(context, event_data)
 
-            # Analyze the result: bool, bytearray or tuple of both.
+            # Analyze the result: bool, int, bytearray or tuple of them.
             success = True
             outdata = None
-            if type(ret) is bool:
-                success = ret
-            elif type(ret) is bytearray or type(ret) is bytes:
-                outdata = ret
-            elif type(ret) is tuple:
-                for elem in ret:
-                    if type(elem) is bool:
-                        success = elem
-                    elif type(elem) is bytearray or type(elem) is bytes:
-                        outdata = elem
-
-            # If output data is a non-mutable bytes field, do not know how to get its address in ctypes.
-            # So, convert it to a mutable bytearray first. This is very inefficient and deserves improvement.
-            if type(outdata) is bytes:
-                outdata = bytearray(outdata)
-
-            # Copy back output data if there are any.
-            if type(outdata) is bytearray:
+            outsize = None
+            for elem in (ret if type(ret) is tuple else (ret,)):
+                if type(elem) is bool:
+                    success = elem
+                elif type(elem) is int:
+                    outsize = elem
+                elif type(elem) is bytearray or type(elem) is bytes:
+                    outdata = elem
+
+            if outdata is not None:
+                # Copy back output data. A bytes object is passed by address, without intermediate copy.
                 # void tspyPyPluginEventHandlerUpdateData(void* obj, void* data, size_t size)
                 cfunc = _lib.tspyPyPluginEventHandlerUpdateData
                 cfunc.restype = None
                 cfunc.argtypes = [ctypes.c_void_p, ctypes.c_void_p, ctypes.c_size_t]
-                carray_type = ctypes.c_uint8 * len(outdata)
-                carray = ctypes.cast(carray_type.from_buffer(outdata), _c_uint8_p)
-                cfunc(event_data_obj, carray, ctypes.c_size_t(len(outdata)))
+                if type(outdata) is bytearray:
+                    carray_type = ctypes.c_uint8 * len(outdata)
+                    cfunc(event_data_obj, ctypes.addressof(carray_type.from_buffer(outdata)), ctypes.c_size_t(len(outdata)))
+                else:
+                    cfunc(event_data_obj, outdata, ctypes.c_size_t(len(outdata)))
+            elif outsize is not None and self.__zero_copy:
+                # Output data were directly written in the plugin buffer.
+                # void tspyPyPluginEventHandlerUpdateSize(void* obj, size_t size)
+                cfunc = _lib.tspyPyPluginEventHandlerUpdateSize
+                cfunc.restype = None
+                cfunc.argtypes = [ctypes.c_void_p, ctypes.c_size_t]
+                cfunc(event_data_obj, ctypes.c_size_t(outsize))
 
             return success
 
@@ -866,14 +907,14 @@ class AbstractPluginEventHandler(NativeObject):
         # Keep a reference on the callback in the object instance.
         self.__cb = callback(event_callback)
 
-        # Finally create the native object.
-        # void* tspyNewPyPluginEventHandler(ts::py::PluginEventHandler::PyCallback callback)
+        # Finally create the native object. The packet metadata are passed in zero-copy mode only.
+        # void* tspyNewPyPluginEventHandler(ts::py::PluginEventHandler::PyCallback callback, bool metadata)
         cfunc = _lib.tspyNewPyPluginEventHandler
         cfunc.restype = ctypes.c_void_p
-        cfunc.argtypes = [ctypes.c_void_p]
+        cfunc.argtypes = [ctypes.c_void_p, ctypes.c_bool]
         # Don't know which type to use for ctypes.CFUNCTYPE() as first parameter.
         # cfunc.argtypes = [???]
-        self._setNative(cfunc(self.__cb))
+        self._setNative(cfunc(self.__cb, zero_copy))
 
     # Explicitly free the underlying C++ object (inherited).
     def delete(self):
@@ -902,6 +943,27 @@ class AbstractPluginEventHandler(NativeObject):
     # is the updated output event data (if the even data is not read-only). The default is no error,
     # no data if the function returns nothing.
     #
+    # When the handler was created with @a zero_copy set to True, @a data is a memoryview which
+    # directly maps the plugin buffer, typically the packet buffer of tsp in the @e memory plugins.
+    # This memoryview is valid during the execution of handlePluginEvent() only and must not be
+    # kept or used after returning. If the event data are read-only, @a data is a read-only view of
+    # the @a context.data_size input bytes. Otherwise, @a data is a writable view of
+    # @a context.max_data_size bytes, starting with the @a context.data_size input bytes. The handler
+    # can directly write the output data in @a data and return their size as an int, instead of a
+    # bytearray. The memoryview supports the buffer protocol and can be used, for instance, as
+    # a NumPy array without copy: <code>numpy.frombuffer(data, dtype=numpy.uint8).reshape(-1, tsduck.PKT_SIZE)</code>.
+    # The number of packets per event is the number of packets per input or output operation in tsp,
+    # see the properties @a max_input_packets and @a max_output_packets in TSProcessor.
+    # When the plugin passes packet metadata, @a context.packet_metadata is a second memoryview
+    # with one serialized metadata structure per TS packet, see PluginEventContext. It follows the
+    # same rules as @a data: read-only or writable, valid during the execution of handlePluginEvent() only.
+    #
+    # Example: zero copy, output data directly written in the buffer:
+    # @code
+    #   data[0:tsduck.PKT_SIZE] = packet
+    #   return tsduck.PKT_SIZE
+    # @endcode
+    #
     # Example: error, no data:
     # @code
     #   return False
@@ -923,8 +985,8 @@ class AbstractPluginEventHandler(NativeObject):
     #
     # @param context An instance of PluginEventContext containing the details of the event.
     # @param data A bytes object containing the data of the event. This is a read-only
-    # sequence of bytes. There is no way to return data from Python to the plugin.
-    # @return A bool, a bytearray or a tuple of both.
+    # sequence of bytes. In zero-copy mode, this is a memoryview over the plugin buffer.
+    # @return A bool, a bytearray, an int (in zero-copy mode) or a tuple of them.
     #
     def handlePluginEvent(self, context, data):
         pass
@@ -12,6 +12,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsPluginRepository.h"
+#include "tsDeferredLogger.h"
 #include "tsBinaryTable.h"
 #include "tsSectionDemux.h"
 #include "tsPESPacket.h"
@@ -69,10 +70,12 @@ namespace ts {
         bool          _use_milliseconds = false;  // Report playback time instead of packet number
         PacketCounter _suspend_threshold = 0;     // Number of missing packets after which a PID is considered as suspended
         fs::path      _outfile_name {};           // Output file name
+        uint64_t      _max_size = 0;              // Max size of output files
+        size_t        _max_files = 0;             // Max number of output files
         UString       _tag {};                    // Message tag.
 
         // Working data
-        std::ofstream _outfile {};                // User-specified output file
+        DeferredLogger _log {*this};              // History lines, formatted and written in a background thread
         PacketCounter _suspend_after = 0;         // Number of missing packets after which a PID is considered as suspended
         TDT           _last_tdt {};               // Last received TDT
         PacketCounter _last_tdt_pkt = 0;          // Packet# of last TDT
@@ -92,19 +95,22 @@ namespace ts {
         // Analyze a list of descriptors, looking for ECM PID's
         void analyzeCADescriptors(const DescriptorList& dlist, uint16_t service_id);
 
-        // Report a history line
-        void report(PacketCounter pkt, const UString& line);
+        // Report the last TDT if required, return the time of a history line.
+        PacketCounter lineTime(PacketCounter pkt);
 
+        // Report a history line
         template <class... Args>
         void report(const UChar* fmt, Args&&... args)
         {
-            report(tsp->pluginPackets(), UString::Format(fmt, std::forward<ArgMixIn>(args)...));
+            report(tsp->pluginPackets(), fmt, std::forward<Args>(args)...);
         }
 
         template <class... Args>
         void report(PacketCounter pkt, const UChar* fmt, Args&&... args)
         {
-            report(pkt, UString::Format(fmt, std::forward<ArgMixIn>(args)...));
+            DeferredLogger::Line line;
+            line.format(u"%s%d: ", _tag, lineTime(pkt)).format(fmt, std::forward<Args>(args)...);
+            _log.log(std::move(line));
         }
     };
 }
@@ -155,6 +161,19 @@ ts::HistoryPlugin::HistoryPlugin(TSP* tsp_) :
          u"When an output file is specified using --output-file, the sort command becomes:\n"
          u"  sort -n output-file-name");
 
+    option(u"max-files", 0, POSITIVE);
+    help(u"max-files",
+         u"With --max-size, specify a maximum number of output files. "
+         u"When the number of created files exceeds the specified number, the oldest files are deleted. "
+         u"By default, all created files are kept.");
+
+    option(u"max-size", 0, POSITIVE);
+    help(u"max-size",
+         u"With --output-file, specify a maximum size in bytes for the output files. "
+         u"When an output file grows beyond the specified limit, it is closed and another one is created. "
+         u"A number is automatically added to the name part so that successive output files receive distinct names. "
+         u"Example: if the specified file name is foo.txt, the various files are named foo-000000.txt, foo-000001.txt, etc.");
+
     option(u"suspend-packet-threshold", 's', POSITIVE);
     help(u"suspend-packet-threshold",
          u"Number of packets in TS after which a PID is considered as suspended. "
@@ -185,8 +204,15 @@ bool ts::HistoryPlugin::getOptions()
     _use_milliseconds = present(u"milli-seconds");
     getIntValue(_suspend_threshold, u"suspend-packet-threshold");
     getPathValue(_outfile_name, u"output-file");
+    getIntValue(_max_size, u"max-size", 0);
+    getIntValue(_max_files, u"max-files", 0);
     getValue(_tag, u"tag");
 
+    if (_max_size > 0 && _outfile_name.empty()) {
+        error(u"--max-size requires --output-file");
+        return false;
+    }
+
     // Message header.
     if (!_tag.empty()) {
         _tag.append(u": ");
@@ -201,14 +227,9 @@ bool ts::HistoryPlugin::getOptions()
 
 bool ts::HistoryPlugin::start()
 {
-    // Create output file
-    if (!_outfile_name.empty()) {
-        verbose(u"creating %s", _outfile_name);
-        _outfile.open(_outfile_name, std::ios::out);
-        if (!_outfile) {
-            error(u"cannot create %s", _outfile_name);
-            return false;
-        }
+    // Create output file or log on tsp.
+    if (!_log.open(_outfile_name, _max_size, _max_files)) {
+        return false;
     }
 
     // Reinitialize state
@@ -253,20 +274,18 @@ bool ts::HistoryPlugin::stop()
         }
     }
 
-    // Close output file
-    if (_outfile.is_open()) {
-        _outfile.close();
-    }
+    // Write all pending lines, close output file
+    _log.close();
 
     return true;
 }
 
 
 //----------------------------------------------------------------------------
-// Report a history line
+// Report the last TDT if required, return the time of a history line.
 //----------------------------------------------------------------------------
 
-void ts::HistoryPlugin::report(PacketCounter pkt, const UString& line)
+ts::PacketCounter ts::HistoryPlugin::lineTime(PacketCounter pkt)
 {
     // Reports the last TDT if required
     if (!_time_all && _last_tdt.isValid() && !_last_tdt_reported) {
@@ -278,14 +297,7 @@ void ts::HistoryPlugin::report(PacketCounter pkt, const UString& line)
     if (_use_milliseconds) {
         pkt = PacketInterval(tsp->bitrate(), pkt).count();
     }
-
-    // Then report the message.
-    if (_outfile.is_open()) {
-        _outfile << _tag << UString::Format(u"%d: ", pkt) << line << std::endl;
-    }
-    else {
-        info(u"%s%d: %s", _tag, pkt, line);
-    }
+    return pkt;
 }
 
 
@@ -298,10 +298,12 @@ bool ts::InjectPlugin::start()
 
 bool ts::InjectPlugin::reloadFiles()
 {
-    // Reinitialize packetizer
+    // Reinitialize packetizer. The cycle is precompiled when it is static, i.e. when no section-specific
+    // repetition rate applies and there is some stuffing (--stuffing, --repeat or --poll-files).
     _pzer.reset();
     _pzer.setPID(_inject_pid);
     _pzer.setStuffingPolicy(_stuffing_policy);
+    _pzer.setPrecompiled(true);
 
     // Load sections from input files
     bool success = true;
@@ -26,6 +26,7 @@
 #define DEFAULT_ECM_BITRATE 30000
 #define DEFAULT_ECM_INTER_PACKET  7000  // When bitrate is unknown, use 10 ECM/s for TS @10Mb/s
 #define ASYNC_HANDLER_EXTRA_STACK_SIZE (1024 * 1024)
+#define PACKET_WINDOW_SIZE 128  // Packets which are scrambled together with AES in CBC modes
 
 
 //----------------------------------------------------------------------------
@@ -69,11 +70,21 @@
 // is negative, we immediately perform an ECM transition and we recompute the
 // time for the next CW transition. If delay_start is positive, we immediately
 // perform a CW transition and we recompute the time for the next ECM transition.
+//
+// Notes on multiple services:
+//
+// Several services can be scrambled in the same pass. Each service has its own
+// ServiceContext object, with its own control words, crypto-periods, ECM PID and
+// degraded mode. All services share the same ECMG channel, each service using a
+// distinct ECM stream in this channel (ECM_stream_id and ECM_id are incremented
+// from the values of --stream-id and --ecm-id).
+//
+// The transition points and ECM insertion points of all services are kept in two
+// schedules, sorted by packet index. On each packet, only the head of the schedules
+// is checked, regardless of the number of services.
 
 namespace ts {
-    class ScramblerPlugin:
-        public ProcessorPlugin,
-        private SignalizationHandlerInterface
+    class ScramblerPlugin: public ProcessorPlugin
     {
         TS_PLUGIN_CONSTRUCTORS(ScramblerPlugin);
     public:
@@ -81,11 +92,15 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual bool stop() override;
+        virtual size_t getPacketWindowSize() override;
+        virtual size_t processPacketWindow(TSPacketWindow&) override;
         virtual PacketProcessStatus processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
+        class ServiceContext;
+
         // Description of a crypto-period.
-        // Each CryptoPeriod object points to its ScramblerPlugin parent object.
+        // Each CryptoPeriod object points to its ServiceContext parent object.
         // In case of error in a CryptoPeriod object, the _abort volatile flag
         // is set in ScramblerPlugin.
         class CryptoPeriod: private ECMGClientHandlerInterface
@@ -98,7 +113,7 @@ namespace ts {
             // Initialize first crypto period.
             // Generate two randow CW and corresponding ECM.
             // ECM generation may complete asynchronously.
-            void initCycle(ScramblerPlugin*, uint16_t cp_number);
+            void initCycle(ServiceContext*, uint16_t cp_number);
 
             // Initialize crypto period following specified one.
             // ECM generation may complete asynchronously.
@@ -114,7 +129,7 @@ namespace ts {
             bool initScramblerKey() const;
 
         private:
-            ScramblerPlugin* _plugin = nullptr;  // Reference to scrambler plugin
+            ServiceContext*  _ctx = nullptr;     // Reference to service context
             uint16_t         _cp_number = 0;     // Crypto-period number
             volatile bool    _ecm_ok = false;    // _ecm field is valid
             TSPacketVector   _ecm {};            // Packetized ECM
@@ -134,76 +149,154 @@ namespace ts {
             virtual void handleECM(const ecmgscs::ECMResponse&) override;
         };
 
+        // Scrambling context of one service (or of the explicit list of PID's).
+        class ServiceContext: private SignalizationHandlerInterface
+        {
+            TS_NOBUILD_NOCOPY(ServiceContext);
+        public:
+            // Constructor. The first service uses the scrambler of the plugin, the others use a copy of it.
+            ServiceContext(ScramblerPlugin* plugin, size_t index, const UString& service);
+
+            // Reset the state of the service, start the scrambler.
+            bool start();
+
+            // Create the first and second crypto-periods, when the ECM stream is established.
+            bool initCryptoPeriods();
+
+            // Terminate the scrambler.
+            void stop() { _scrambling->stop(); }
+
+            // Scramble a fixed list of PID's instead of the components of a service.
+            void setPIDs(const PIDSet& pids);
+
+            // Accessors.
+            size_t index() const { return _index; }
+            ecmgscs::StreamStatus& streamStatus() { return _stream_status; }
+            bool ready() const { return _scrambled_pids.any(); }
+            bool nonExistentService() const { return _service.nonExistentService(); }
+            size_t scrambledPIDCount() const { return _scrambled_pids.count(); }
+            bool waitingBitrate() const { return _wait_bitrate; }
+            PacketCounter nextChange() const { return std::min(_pkt_change_cw, _pkt_change_ecm); }
+            PacketCounter nextECMInsertion() const { return _pkt_insert_ecm; }
+
+            // Filter interesting sections to discover the service.
+            void feedPacket(const TSPacket& pkt) { _service.feedPacket(pkt); }
+
+            // Initialize ECM and CP scheduling.
+            void initializeScheduling();
+
+            // Perform CW and ECM transitions when their time is reached. Return false on fatal error.
+            bool processTransitions();
+
+            // Replace a null packet with the next ECM packet. Return false on fatal error.
+            bool insertECM(TSPacket& pkt);
+
+            // Scramble a packet from one of the scrambled PID's of the service.
+            PacketProcessStatus scramblePacket(TSPacket& pkt);
+
+            // Scramble all packets which are waiting in the current packet window.
+            bool scrambleBatch();
+
+        private:
+            friend class CryptoPeriod;
+
+            ScramblerPlugin* const _plugin;              // Parent plugin.
+            const size_t           _index;               // Index of service in command line.
+            const uint16_t         _stream_id;           // ECM_stream_id in ECMG channel.
+            const uint16_t         _ecm_id;              // ECM_id in ECMG channel.
+            const UString          _prefix;              // Prefix for messages.
+            ServiceDiscovery       _service;             // Service description
+            std::unique_ptr<TSScrambling> _own_scrambling {}; // Scrambler of additional services.
+            TSScrambling*          _scrambling;          // Scrambler of this service.
+            ecmgscs::StreamStatus  _stream_status;       // Initial response to ECMG stream_setup
+            PID                    _ecm_pid = PID_NULL;  // PID for ECM
+            bool                   _wait_bitrate = false;  // Waiting for bitrate to start scheduling ECM and CP.
+            bool                   _degraded_mode = false; // In degraded mode (see comments above)
+            PacketCounter          _partial_clear = 0;     // How many clear packets to keep clear
+            PacketCounter          _pkt_clear_period = 0;  // How many packets in initial clear period
+            PacketCounter          _pkt_insert_ecm = 0;    // Insertion point for next ECM packet.
+            PacketCounter          _pkt_change_cw = 0;     // Transition point for next CW change
+            PacketCounter          _pkt_change_ecm = 0;    // Transition point for next ECM change
+            uint8_t                _ecm_cc = 0;            // Continuity counter in ECM PID.
+            PIDSet                 _scrambled_pids {};     // List of pids to scramble
+            PIDSet                 _conflict_pids {};      // List of pids to scramble with scrambled input packets
+            CryptoPeriod           _cp[2] {};              // Previous/current or current/next crypto-periods
+            size_t                 _current_cw = 0;        // Index to current CW (current crypto period)
+            size_t                 _current_ecm = 0;       // Index to current ECM (ECM being broadcast)
+            std::vector<TSPacket*> _batch {};              // Packets to scramble at end of current packet window.
+
+            // Return current/next CryptoPeriod for CW or ECM
+            CryptoPeriod& currentCW()  { return _cp[_current_cw]; }
+            CryptoPeriod& nextCW()     { return _cp[(_current_cw + 1) & 0x01]; }
+            CryptoPeriod& currentECM() { return _cp[_current_ecm]; }
+            CryptoPeriod& nextECM()    { return _cp[(_current_ecm + 1) & 0x01]; }
+
+            // Perform CW and ECM transition
+            bool changeCW();
+            void changeECM();
+
+            // Check if we are in degraded mode or if we enter degraded mode
+            bool inDegradedMode();
+
+            // Try to exit from degraded mode
+            bool tryExitDegradedMode();
+
+            // Invoked when the PMT of the service is available.
+            virtual void handlePMT(const PMT&, PID) override;
+        };
+
+        // Schedule of services, indexed by packet index of their next event.
+        using Schedule = std::multimap<PacketCounter, ServiceContext*>;
+
         // ScramblerPlugin parameters, remain constant after start()
-        ServiceDiscovery  _service {duck, this};        // Service description
-        bool              _use_service = false;         // Scramble a service (ie. not a specific list of PID's).
+        UStringVector     _service_names {};            // Services to scramble
+        bool              _use_service = false;         // Scramble services (ie. not a specific list of PID's).
         bool              _component_level = false;     // Insert CA_descriptors at component level
         bool              _scramble_audio = false;      // Scramble all audio components
         bool              _scramble_video = false;      // Scramble all video components
         bool              _scramble_subtitles = false;  // Scramble all subtitles components
-        PID               _only_pid = PID_NULL;         // Only PID to scramble (part of _service streams)
+        PID               _only_pid = PID_NULL;         // Only PID to scramble (part of service streams)
         bool              _synchronous_ecmg = false;    // Synchronous ECM generation
         bool              _ignore_scrambled = false;    // Ignore packets which are already scrambled
-        bool              _update_pmt = false;          // Update PMT.
         bool              _need_cp = false;             // Need to manage crypto-periods (ie. not one single fixed CW).
         bool              _need_ecm = false;            // Need to manage ECM insertion (ie. not fixed CW's).
         bool              _pre_reduce_cw = false;       // Reduce the control word before sending to the ECMG.
         cn::milliseconds  _delay_start {0};             // Delay between CP start and ECM start (can be negative)
         ByteBlock         _ca_desc_private {};          // Private data to insert in CA_descriptor
         BitRate           _ecm_bitrate = 0;             // ECM PID's bitrate
-        PID               _ecm_pid = PID_NULL;          // PID for ECM
+        std::vector<PID>  _ecm_pid_opts {};             // PID's for ECM, one per service
+        PIDSet            _fixed_pids {};               // Explicit list of pids to scramble
         PacketCounter     _partial_scrambling = 0;      // Do not scramble all packets if > 1
         cn::seconds       _clear_period {0};            // Clear period before scrambling commences
         ECMGClientArgs    _ecmg_args {};                // Parameters for ECMG client
         tlv::Logger       _logger {*this, Severity::Debug}; // Message logger for ECMG <=> SCS protocol
         ecmgscs::Protocol      _ecmgscs {};                 // ECMG <=> SCS protocol instance.
         ecmgscs::ChannelStatus _channel_status {_ecmgscs};  // Initial response to ECMG channel_setup
-        ecmgscs::StreamStatus  _stream_status {_ecmgscs};   // Initial response to ECMG stream_setup
 
         // ScramblerPlugin state
         volatile bool     _abort = false;               // Error (service not found, etc)
-        bool              _wait_bitrate = false;        // Waiting for bitrate to start scheduling ECM and CP.
-        bool              _degraded_mode = false;       // In degraded mode (see comments above)
+        bool              _wait_bitrate = false;        // Some services are waiting for bitrate.
         PacketCounter     _packet_count = 0;            // Complete TS packet counter
         PacketCounter     _scrambled_count = 0;         // Summary of scrambled packets
-        PacketCounter     _partial_clear = 0;           // How many clear packets to keep clear
-        PacketCounter     _pkt_clear_period = 0;        // How many packets in initial clear period
-        PacketCounter     _pkt_insert_ecm = 0;          // Insertion point for next ECM packet.
-        PacketCounter     _pkt_change_cw = 0;           // Transition point for next CW change
-        PacketCounter     _pkt_change_ecm = 0;          // Transition point for next ECM change
         BitRate           _ts_bitrate = 0;              // Saved TS bitrate
+        size_t            _ready_count = 0;             // Number of services with known PID's to scramble
         ECMGClient        _ecmg {_logger, _ecmgscs, ASYNC_HANDLER_EXTRA_STACK_SIZE}; // Connection with the ECMG
-        uint8_t           _ecm_cc = 0;                  // Continuity counter in ECM PID.
-        PIDSet            _scrambled_pids {};           // List of pids to scramble
-        PIDSet            _conflict_pids {};            // List of pids to scramble with scrambled input packets
         PIDSet            _input_pids {};               // List of input pids
-        CryptoPeriod      _cp[2] {};                    // Previous/current or current/next crypto-periods
-        size_t            _current_cw = 0;              // Index to current CW (current crypto period)
-        size_t            _current_ecm = 0;             // Index to current ECM (ECM being broadcast)
-        TSScrambling      _scrambling {*this};          // Scrambler
-        CyclingPacketizer _pzer_pmt {duck};             // Packetizer for modified PMT
-
-        // Initialize ECM and CP scheduling.
-        void initializeScheduling();
-
-        // Return current/next CryptoPeriod for CW or ECM
-        CryptoPeriod& currentCW()  { return _cp[_current_cw]; }
-        CryptoPeriod& nextCW()     { return _cp[(_current_cw + 1) & 0x01]; }
-        CryptoPeriod& currentECM() { return _cp[_current_ecm]; }
-        CryptoPeriod& nextECM()    { return _cp[(_current_ecm + 1) & 0x01]; }
-
-        // Perform CW and ECM transition
-        bool changeCW();
-        void changeECM();
-
-        // Check if we are in degraded mode or if we enter degraded mode
-        bool inDegradedMode();
-
-        // Try to exit from degraded mode
-        bool tryExitDegradedMode();
-
-        // Invoked when the PMT of the service is available.
-        virtual void handlePMT(const PMT&, PID) override;
+        PIDSet            _ecm_pids {};                 // List of ECM pids of all services
+        PIDSet            _pmt_pids {};                 // List of PMT pids to replace
+        TSScrambling      _scrambling {*this};          // Scrambler of first service
+        bool              _window_mode = false;         // Packets are processed by packet windows.
+        std::vector<std::unique_ptr<ServiceContext>> _contexts {};  // One context per service
+        std::vector<ServiceContext*> _pid_contexts {};  // Scrambling service by PID
+        std::vector<ServiceContext*> _due {};           // Services with a transition to perform
+        std::map<PID, std::shared_ptr<CyclingPacketizer>> _pzer_pmt {}; // Packetizers for modified PMT's, by PID
+        Schedule          _transitions {};              // Next CW or ECM transition of each service
+        Schedule          _insertions {};               // Next ECM insertion of each service
+        std::vector<Schedule::iterator> _transition_slots {}; // Position of each service in _transitions
+        std::vector<Schedule::iterator> _insertion_slots {};  // Position of each service in _insertions
+
+        // Update the position of a service in the schedules after a change of its transition points.
+        void reschedule(ServiceContext&);
     };
 }
 
@@ -215,14 +308,14 @@ TS_REGISTER_PROCESSOR_PLUGIN(u"scrambler", ts::ScramblerPlugin);
 //----------------------------------------------------------------------------
 
 ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
-    ProcessorPlugin(tsp_, u"DVB scrambler", u"[options] [service]")
+    ProcessorPlugin(tsp_, u"DVB scrambler", u"[options] [service ...]")
 {
     // We need to define character sets to specify service names.
     duck.defineArgsForCharset(*this);
 
-    option(u"", 0, STRING, 0, 1);
+    option(u"", 0, STRING, 0, UNLIMITED_COUNT);
     help(u"",
-         u"Specifies the optional service to scramble. "
+         u"Specifies the optional services to scramble. "
          u"If no service is specified, a list of PID's to scramble must be provided using --pid options. "
          u"When PID's are provided, fixed control words must be specified as well.\n\n"
          u"If no fixed CW is specified, a random CW is generated for each crypto-period and "
@@ -232,7 +325,11 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
          u"If it is an empty string or \"-\", the first service in the PAT is scrambled. "
          u"Otherwise, it is interpreted as a service name, as specified in the SDT. "
          u"The name is not case sensitive and blanks are ignored. "
-         u"If the input TS does not contain any SDT or VCT, use service ids only.");
+         u"If the input TS does not contain any SDT or VCT, use service ids only.\n\n"
+         u"Several services can be specified. Each service is scrambled with its own control words "
+         u"and crypto-periods. All services share the same ECMG channel, using one ECM stream per service. "
+         u"The ECM_stream_id and ECM_id of the first service are specified by --stream-id and --ecm-id "
+         u"and are incremented for each subsequent service.");
 
     option<BitRate>(u"bitrate-ecm", 'b');
     help(u"bitrate-ecm",
@@ -283,12 +380,14 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
          u"Several -p or --pid options may be specified. "
          u"By default, scramble the service which is provided as parameter.");
 
-    option(u"pid-ecm", 0, PIDVAL);
+    option(u"pid-ecm", 0, PIDVAL, 0, UNLIMITED_COUNT);
     help(u"pid-ecm",
          u"Specifies the new ECM PID for the service. By default, use the first "
          u"unused PID immediately following the PMT PID. Using the default, there "
          u"is a risk to later discover that this PID is already used. In that case, "
-         u"specify --pid-ecm with a notoriously unused PID value.");
+         u"specify --pid-ecm with a notoriously unused PID value.\n\n"
+         u"When several services are scrambled, this option can be specified several times. "
+         u"The ECM PID's apply to the services in the same order.");
 
     option(u"pre-reduce-cw");
     help(u"pre-reduce-cw",
@@ -329,9 +428,9 @@ bool ts::ScramblerPlugin::getOptions()
 {
     // Plugin parameters.
     duck.loadArgs(*this);
-    _use_service = present(u"");
-    _service.set(value(u""));
-    getIntValues(_scrambled_pids, u"pid");
+    getValues(_service_names, u"");
+    _use_service = !_service_names.empty();
+    getIntValues(_fixed_pids, u"pid");
     _synchronous_ecmg = present(u"synchronous") || !tsp->realtime();
     _component_level = present(u"component-level");
     _scramble_audio = !present(u"no-audio");
@@ -342,7 +441,7 @@ bool ts::ScramblerPlugin::getOptions()
     _pre_reduce_cw = present(u"pre-reduce-cw");
     getChronoValue(_clear_period, u"clear-period", cn::seconds(0));
     getIntValue(_partial_scrambling, u"partial-scrambling", 1);
-    getIntValue(_ecm_pid, u"pid-ecm", PID_NULL);
+    getIntValues(_ecm_pid_opts, u"pid-ecm");
     getValue(_ecm_bitrate, u"bitrate-ecm", DEFAULT_ECM_BITRATE);
     getHexaValue(_ca_desc_private, u"private-data");
 
@@ -357,17 +456,23 @@ bool ts::ScramblerPlugin::getOptions()
     _logger.setSeverity(ecmgscs::Tags::ECM_response, _ecmg_args.log_data);
 
     // Scramble either a service or a list of PID's, not a mixture of them.
-    if ((_use_service + _scrambled_pids.any()) != 1) {
+    if ((_use_service + _fixed_pids.any()) != 1) {
         error(u"specify either a service or a list of PID's");
         return false;
     }
 
     // To scramble a fixed list of PID's, we need fixed control words, otherwise the random CW's are lost.
-    if (_scrambled_pids.any() && !_scrambling.hasFixedCW()) {
+    if (_fixed_pids.any() && !_scrambling.hasFixedCW()) {
         error(u"specify control words to scramble an explicit list of PID's");
         return false;
     }
 
+    // One ECM PID per service at most.
+    if (_ecm_pid_opts.size() > std::max<size_t>(1, _service_names.size())) {
+        error(u"too many --pid-ecm options, only one per service");
+        return false;
+    }
+
     // Do we need to manage crypto-periods and ECM insertion?
     _need_cp = _scrambling.fixedCWCount() != 1;
     _need_ecm = _use_service && !_scrambling.hasFixedCW();
@@ -375,11 +480,41 @@ bool ts::ScramblerPlugin::getOptions()
     // Specify which ECMG <=> SCS version to use.
     _ecmgscs.setVersion(_ecmg_args.dvbsim_version);
     _channel_status.forceProtocolVersion(_ecmg_args.dvbsim_version);
-    _stream_status.forceProtocolVersion(_ecmg_args.dvbsim_version);
+
+    // Create one context per service, or one single context for the list of PID's.
+    _contexts.clear();
+    for (size_t index = 0; index < std::max<size_t>(1, _service_names.size()); ++index) {
+        _contexts.push_back(std::make_unique<ServiceContext>(this, index, _use_service ? _service_names[index] : UString()));
+    }
     return true;
 }
 
 
+//----------------------------------------------------------------------------
+// Service context constructor.
+//----------------------------------------------------------------------------
+
+ts::ScramblerPlugin::ServiceContext::ServiceContext(ScramblerPlugin* plugin, size_t index, const UString& service) :
+    _plugin(plugin),
+    _index(index),
+    _stream_id(uint16_t(plugin->_ecmg_args.ecm_stream_id + index)),
+    _ecm_id(uint16_t(plugin->_ecmg_args.ecm_id + index)),
+    _prefix(plugin->_service_names.size() > 1 ? UString::Format(u"service %s: ", service) : UString()),
+    _service(plugin->duck, this),
+    _scrambling(&plugin->_scrambling),
+    _stream_status(plugin->_ecmgscs)
+{
+    if (!service.empty()) {
+        _service.set(service);
+    }
+    if (index > 0) {
+        _own_scrambling = std::make_unique<TSScrambling>(plugin->_scrambling);
+        _scrambling = _own_scrambling.get();
+    }
+    _stream_status.forceProtocolVersion(plugin->_ecmg_args.dvbsim_version);
+}
+
+
 //----------------------------------------------------------------------------
 // Start method
 //----------------------------------------------------------------------------
@@ -387,27 +522,35 @@ bool ts::ScramblerPlugin::getOptions()
 bool ts::ScramblerPlugin::start()
 {
     // Reset states
-    _conflict_pids.reset();
     _packet_count = 0;
     _scrambled_count = 0;
-    _ecm_cc = 0;
     _abort = false;
     _wait_bitrate = false;
-    _degraded_mode = false;
     _ts_bitrate = 0;
-    _partial_clear = 0;
-    _pkt_clear_period = 0;
-    _update_pmt = false;
+    _ready_count = 0;
     _delay_start = cn::milliseconds(0);
-    _current_cw = 0;
-    _current_ecm = 0;
-
-    // As long as the bitrate is unknown, delay changes to infinite.
-    _pkt_insert_ecm = _pkt_change_cw = _pkt_change_ecm = std::numeric_limits<PacketCounter>::max();
+    _window_mode = false;
+    _ecm_pids.reset();
+    _pmt_pids.reset();
+    _pzer_pmt.clear();
+    _pid_contexts.assign(PID_MAX, nullptr);
+    _transitions.clear();
+    _insertions.clear();
+    _transition_slots.clear();
+    _insertion_slots.clear();
+
+    // Initialize the scrambling engines and schedules.
+    for (const auto& ctx : _contexts) {
+        if (!ctx->start()) {
+            return false;
+        }
+        _transition_slots.push_back(_transitions.insert(std::make_pair(ctx->nextChange(), ctx.get())));
+        _insertion_slots.push_back(_insertions.insert(std::make_pair(ctx->nextECMInsertion(), ctx.get())));
+    }
 
-    // Initialize the scrambling engine.
-    if (!_scrambling.start()) {
-        return false;
+    // With an explicit list of PID's, we already know what to scramble.
+    if (!_use_service) {
+        _contexts.front()->setPIDs(_fixed_pids);
     }
 
     // Initialize ECMG.
@@ -421,34 +564,34 @@ bool ts::ScramblerPlugin::start()
             error(u"--super-cas-id is required with --ecmg");
             return false;
         }
-        else if (!_ecmg.connect(_ecmg_args, _channel_status, _stream_status, tsp)) {
+        else if (!_ecmg.connect(_ecmg_args, _channel_status, _contexts.front()->streamStatus(), tsp)) {
             // Error connecting to ECMG, error message already reported
             return false;
         }
-        else {
-            // Now correctly connected to ECMG.
-            // Validate delay start (limit to half the crypto-period).
-            _delay_start = cn::milliseconds(_channel_status.delay_start);
-            if (_delay_start > _ecmg_args.cp_duration / 2 || _delay_start < -_ecmg_args.cp_duration / 2) {
-                error(u"crypto-period too short for this CAS, must be at least %'!s", 2 * cn::abs(_delay_start));
+
+        // Now correctly connected to ECMG. Create one additional ECM stream per additional service.
+        for (size_t i = 1; i < _contexts.size(); ++i) {
+            if (!_ecmg.addStream(uint16_t(_ecmg_args.ecm_stream_id + i), uint16_t(_ecmg_args.ecm_id + i), _ecmg_args.cp_duration, _contexts[i]->streamStatus())) {
                 return false;
             }
-            debug(u"crypto-period duration: %'!s, delay start: %'!s", cn::duration_cast<cn::milliseconds>(_ecmg_args.cp_duration), _delay_start);
+        }
 
-            // Create first and second crypto-periods
-            _cp[0].initCycle(this, 0);
-            if (!_cp[0].initScramblerKey()) {
+        // Validate delay start (limit to half the crypto-period).
+        _delay_start = cn::milliseconds(_channel_status.delay_start);
+        if (_delay_start > _ecmg_args.cp_duration / 2 || _delay_start < -_ecmg_args.cp_duration / 2) {
+            error(u"crypto-period too short for this CAS, must be at least %'!s", 2 * cn::abs(_delay_start));
+            return false;
+        }
+        debug(u"crypto-period duration: %'!s, delay start: %'!s", cn::duration_cast<cn::milliseconds>(_ecmg_args.cp_duration), _delay_start);
+
+        // Create first and second crypto-periods of all services.
+        for (const auto& ctx : _contexts) {
+            if (!ctx->initCryptoPeriods()) {
                 return false;
             }
-            _cp[1].initNext(_cp[0]);
         }
     }
 
-    // The PMT will be modified, initialize the PMT packetizer.
-    // Note that even without ECMG we may need to add a scrambling_descriptor in the PMT.
-    _pzer_pmt.reset();
-    _pzer_pmt.setStuffingPolicy(CyclingPacketizer::StuffingPolicy::ALWAYS);
-
     // Initialize the list of used pids. Preset reserved PIDs.
     _input_pids.reset();
     _input_pids.set(PID_NULL);
@@ -460,6 +603,68 @@ bool ts::ScramblerPlugin::start()
 }
 
 
+//----------------------------------------------------------------------------
+// Reset the state of a service, start the scrambler.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::ServiceContext::start()
+{
+    _scrambled_pids.reset();
+    _conflict_pids.reset();
+    _ecm_cc = 0;
+    _wait_bitrate = false;
+    _degraded_mode = false;
+    _partial_clear = 0;
+    _pkt_clear_period = 0;
+    _current_cw = 0;
+    _current_ecm = 0;
+    _batch.clear();
+
+    // Explicit ECM PID for this service, if any.
+    _ecm_pid = _index < _plugin->_ecm_pid_opts.size() ? _plugin->_ecm_pid_opts[_index] : PID(PID_NULL);
+    if (_ecm_pid != PID_NULL) {
+        _plugin->_ecm_pids.set(_ecm_pid);
+    }
+
+    // As long as the bitrate is unknown, delay changes to infinite.
+    _pkt_insert_ecm = _pkt_change_cw = _pkt_change_ecm = std::numeric_limits<PacketCounter>::max();
+
+    // Initialize the scrambling engine.
+    return _scrambling->start();
+}
+
+
+//----------------------------------------------------------------------------
+// Create the first and second crypto-periods of a service.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::ServiceContext::initCryptoPeriods()
+{
+    _cp[0].initCycle(this, 0);
+    if (!_cp[0].initScramblerKey()) {
+        return false;
+    }
+    _cp[1].initNext(_cp[0]);
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Scramble a fixed list of PID's.
+//----------------------------------------------------------------------------
+
+void ts::ScramblerPlugin::ServiceContext::setPIDs(const PIDSet& pids)
+{
+    _scrambled_pids = pids;
+    for (PID pid = 0; pid < PID_MAX; ++pid) {
+        if (pids.test(pid)) {
+            _plugin->_pid_contexts[pid] = this;
+        }
+    }
+    _plugin->_ready_count++;
+}
+
+
 //----------------------------------------------------------------------------
 // Stop method
 //----------------------------------------------------------------------------
@@ -471,10 +676,14 @@ bool ts::ScramblerPlugin::stop()
         _ecmg.disconnect();
     }
 
-    // Terminate the scrambling engine.
-    _scrambling.stop();
+    // Terminate the scrambling engines.
+    size_t pid_count = 0;
+    for (const auto& ctx : _contexts) {
+        ctx->stop();
+        pid_count += ctx->scrambledPIDCount();
+    }
 
-    debug(u"scrambled %'d packets in %'d PID's", _scrambled_count, _scrambled_pids.count());
+    debug(u"scrambled %'d packets in %'d PID's", _scrambled_count, pid_count);
     return true;
 }
 
@@ -483,61 +692,83 @@ bool ts::ScramblerPlugin::stop()
 // This method processes the PMT of the service.
 //----------------------------------------------------------------------------
 
-void ts::ScramblerPlugin::handlePMT(const PMT& table, PID)
+void ts::ScramblerPlugin::ServiceContext::handlePMT(const PMT& table, PID)
 {
-    assert(_use_service);
+    assert(_plugin->_use_service);
+    DuckContext& duck(_plugin->duck);
+    const bool was_ready = ready();
 
     // Need a modifiable version of the PMT.
     PMT pmt(table);
 
+    // Forget previous components of the service.
+    for (PID pid = 0; pid < PID_MAX; ++pid) {
+        if (_plugin->_pid_contexts[pid] == this) {
+            _plugin->_pid_contexts[pid] = nullptr;
+        }
+    }
+
     // Collect all PIDS to scramble.
     _scrambled_pids.reset();
     for (const auto& it : pmt.streams) {
         const PID pid = it.first;
         const PMT::Stream& stream(it.second);
-        _input_pids.set(pid);
-        if (((_scramble_audio && stream.isAudio(duck)) || (_scramble_video && stream.isVideo(duck)) || (_scramble_subtitles && stream.isSubtitles(duck))) && (_only_pid == PID_NULL || _only_pid == pid)) {
+        _plugin->_input_pids.set(pid);
+        if (((_plugin->_scramble_audio && stream.isAudio(duck)) || (_plugin->_scramble_video && stream.isVideo(duck)) || (_plugin->_scramble_subtitles && stream.isSubtitles(duck))) &&
+            (_plugin->_only_pid == PID_NULL || _plugin->_only_pid == pid))
+        {
+            if (_plugin->_pid_contexts[pid] != nullptr) {
+                _plugin->error(u"%sPID %n is already scrambled in another service", _prefix, pid);
+                _plugin->_abort = true;
+                return;
+            }
             _scrambled_pids.set(pid);
-            verbose(u"starting scrambling PID %n", pid);
+            _plugin->_pid_contexts[pid] = this;
+            _plugin->verbose(u"%sstarting scrambling PID %n", _prefix, pid);
         }
     }
 
     // Check that we have something to scramble.
     if (_scrambled_pids.none()) {
-        error(u"no PID to scramble in service");
-        _abort = true;
+        _plugin->error(u"%sno PID to scramble in service", _prefix);
+        _plugin->_abort = true;
         return;
     }
+    if (!was_ready) {
+        _plugin->_ready_count++;
+    }
 
     // Allocate a PID value for ECM if necessary
-    if (_need_ecm && _ecm_pid == PID_NULL) {
+    if (_plugin->_need_ecm && _ecm_pid == PID_NULL) {
         // Start at service PMT PID, then look for an unused one.
-        for (_ecm_pid = _service.getPMTPID() + 1; _ecm_pid < PID_NULL && _input_pids.test(_ecm_pid); _ecm_pid++) {}
+        for (_ecm_pid = _service.getPMTPID() + 1; _ecm_pid < PID_NULL && (_plugin->_input_pids.test(_ecm_pid) || _plugin->_ecm_pids.test(_ecm_pid)); _ecm_pid++) {}
         if (_ecm_pid >= PID_NULL) {
-            error(u"cannot find an unused PID for ECM, try --pid-ecm");
-            _abort = true;
+            _plugin->error(u"%scannot find an unused PID for ECM, try --pid-ecm", _prefix);
+            _plugin->_abort = true;
         }
         else {
-            verbose(u"using PID %n for ECM", _ecm_pid);
+            _plugin->_ecm_pids.set(_ecm_pid);
+            _plugin->verbose(u"%susing PID %n for ECM", _prefix, _ecm_pid);
         }
     }
 
     // Add a scrambling_descriptor in the PMT for scrambling other than DVB-CSA2.
-    if (_scrambling.scramblingType() != SCRAMBLING_DVB_CSA2) {
-        _update_pmt = true;
-        pmt.descs.add(duck, ScramblingDescriptor(_scrambling.scramblingType()));
+    bool update_pmt = false;
+    if (_scrambling->scramblingType() != SCRAMBLING_DVB_CSA2) {
+        update_pmt = true;
+        pmt.descs.add(duck, ScramblingDescriptor(_scrambling->scramblingType()));
     }
 
     // With ECM generation, modify the PMT
-    if (_need_ecm) {
-        _update_pmt = true;
+    if (_plugin->_need_ecm) {
+        update_pmt = true;
 
         // Create a CA_descriptor
-        CADescriptor ca_desc((_ecmg_args.super_cas_id >> 16) & 0xFFFF, _ecm_pid);
-        ca_desc.private_data = _ca_desc_private;
+        CADescriptor ca_desc((_plugin->_ecmg_args.super_cas_id >> 16) & 0xFFFF, _ecm_pid);
+        ca_desc.private_data = _plugin->_ca_desc_private;
 
         // Add the CA_descriptor at program level or component level
-        if (_component_level) {
+        if (_plugin->_component_level) {
             // Add a CA_descriptor in each scrambled component
             for (auto& it : pmt.streams) {
                 if (_scrambled_pids.test(it.first)) {
@@ -551,21 +782,28 @@ void ts::ScramblerPlugin::handlePMT(const PMT& table, PID)
         }
     }
 
-    // Packetize the modified PMT
-    if (_update_pmt) {
-        _pzer_pmt.removeSections(TID_PMT, pmt.service_id);
-        _pzer_pmt.setPID(_service.getPMTPID());
-        _pzer_pmt.addTable(duck, pmt);
+    // Packetize the modified PMT. The packetizer is shared by all services in the same PMT PID.
+    if (update_pmt) {
+        const PID pmt_pid = _service.getPMTPID();
+        auto& pzer(_plugin->_pzer_pmt[pmt_pid]);
+        if (pzer == nullptr) {
+            // Note that even without ECMG we may need to add a scrambling_descriptor in the PMT.
+            pzer = std::make_shared<CyclingPacketizer>(duck, pmt_pid, CyclingPacketizer::StuffingPolicy::ALWAYS);
+        }
+        pzer->removeSections(TID_PMT, pmt.service_id);
+        pzer->addTable(duck, pmt);
+        _plugin->_pmt_pids.set(pmt_pid);
     }
 
     // We need to know the bitrate in order to schedule crypto-periods or ECM insertion.
-    if (_need_cp || _need_ecm) {
-        if (_ts_bitrate == 0) {
-            _wait_bitrate = true;
-            warning(u"unknown bitrate, scheduling of crypto-periods is delayed");
+    if (_plugin->_need_cp || _plugin->_need_ecm) {
+        if (_plugin->_ts_bitrate == 0) {
+            _wait_bitrate = _plugin->_wait_bitrate = true;
+            _plugin->warning(u"%sunknown bitrate, scheduling of crypto-periods is delayed", _prefix);
         }
         else {
             initializeScheduling();
+            _plugin->reschedule(*this);
         }
     }
 }
@@ -575,33 +813,53 @@ void ts::ScramblerPlugin::handlePMT(const PMT& table, PID)
 // Initialize ECM and CP scheduling.
 //----------------------------------------------------------------------------
 
-void ts::ScramblerPlugin::initializeScheduling()
+void ts::ScramblerPlugin::ServiceContext::initializeScheduling()
 {
-    assert(_ts_bitrate != 0);
+    const BitRate& ts_bitrate(_plugin->_ts_bitrate);
+    assert(ts_bitrate != 0);
 
     // Initial clear period
-    _pkt_clear_period = PacketDistance(_ts_bitrate, _clear_period);
+    _pkt_clear_period = PacketDistance(ts_bitrate, _plugin->_clear_period);
 
     // Next crypto-period.
-    if (_need_cp) {
-        _pkt_change_cw = _packet_count + PacketDistance(_ts_bitrate, _ecmg_args.cp_duration);
+    if (_plugin->_need_cp) {
+        _pkt_change_cw = _plugin->_packet_count + PacketDistance(ts_bitrate, _plugin->_ecmg_args.cp_duration);
     }
 
     // Initialize ECM insertion.
-    if (_need_ecm) {
+    if (_plugin->_need_ecm) {
         // Insert current ECM packets as soon as possible.
-        _pkt_insert_ecm = _packet_count;
+        _pkt_insert_ecm = _plugin->_packet_count;
 
         // Next ECM may start before or after next crypto-period
-        _pkt_change_ecm = _delay_start > cn::milliseconds::zero() ?
-                    _pkt_change_cw + PacketDistance(_ts_bitrate, _delay_start) :
-                    _pkt_change_cw - PacketDistance(_ts_bitrate, _delay_start);
+        _pkt_change_ecm = _plugin->_delay_start > cn::milliseconds::zero() ?
+                    _pkt_change_cw + PacketDistance(ts_bitrate, _plugin->_delay_start) :
+                    _pkt_change_cw - PacketDistance(ts_bitrate, _plugin->_delay_start);
     }
 
     // No longer wait for bitrate.
     if (_wait_bitrate) {
         _wait_bitrate = false;
-        info(u"bitrate now known, %'d b/s, starting scheduling crypto-periods", _ts_bitrate);
+        _plugin->info(u"%sbitrate now known, %'d b/s, starting scheduling crypto-periods", _prefix, ts_bitrate);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Update the position of a service in the schedules.
+//----------------------------------------------------------------------------
+
+void ts::ScramblerPlugin::reschedule(ServiceContext& ctx)
+{
+    Schedule::iterator& tr(_transition_slots[ctx.index()]);
+    if (tr->first != ctx.nextChange()) {
+        _transitions.erase(tr);
+        tr = _transitions.insert(std::make_pair(ctx.nextChange(), &ctx));
+    }
+    Schedule::iterator& ins(_insertion_slots[ctx.index()]);
+    if (ins->first != ctx.nextECMInsertion()) {
+        _insertions.erase(ins);
+        ins = _insertions.insert(std::make_pair(ctx.nextECMInsertion(), &ctx));
     }
 }
 
@@ -610,9 +868,9 @@ void ts::ScramblerPlugin::initializeScheduling()
 // Check if we are in degraded mode or if we enter degraded mode
 //----------------------------------------------------------------------------
 
-bool ts::ScramblerPlugin::inDegradedMode()
+bool ts::ScramblerPlugin::ServiceContext::inDegradedMode()
 {
-    if (!_need_ecm) {
+    if (!_plugin->_need_ecm) {
         // No ECM, no degraded mode.
         return false;
     }
@@ -626,7 +884,7 @@ bool ts::ScramblerPlugin::inDegradedMode()
     }
     else {
         // Entering degraded mode
-        warning(u"Next ECM not ready, entering degraded mode");
+        _plugin->warning(u"%sNext ECM not ready, entering degraded mode", _prefix);
         return _degraded_mode = true;
     }
 }
@@ -636,14 +894,14 @@ bool ts::ScramblerPlugin::inDegradedMode()
 // Try to exit from degraded mode
 //----------------------------------------------------------------------------
 
-bool ts::ScramblerPlugin::tryExitDegradedMode()
+bool ts::ScramblerPlugin::ServiceContext::tryExitDegradedMode()
 {
     // If not in degraded mode, nothing to do
     if (!_degraded_mode) {
         return true;
     }
-    assert(_need_ecm);
-    assert(_ts_bitrate != 0);
+    assert(_plugin->_need_ecm);
+    assert(_plugin->_ts_bitrate != 0);
 
     // We are in degraded mode. If next ECM not yet ready, stay degraded
     if (!nextECM().ecmReady()) {
@@ -651,15 +909,15 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
     }
 
     // Next ECM is ready, at last. Exit degraded mode.
-    info(u"Next ECM ready, exiting from degraded mode");
+    _plugin->info(u"%sNext ECM ready, exiting from degraded mode", _prefix);
     _degraded_mode = false;
 
     // Compute next CW and ECM change.
-    if (_delay_start < cn::milliseconds::zero()) {
+    if (_plugin->_delay_start < cn::milliseconds::zero()) {
         // Start broadcasting ECM before beginning of crypto-period, ie. now
         changeECM();
         // Postpone CW change
-        _pkt_change_cw = _packet_count + PacketDistance(_ts_bitrate, _delay_start);
+        _pkt_change_cw = _plugin->_packet_count + PacketDistance(_plugin->_ts_bitrate, _plugin->_delay_start);
     }
     else {
         // Change CW now.
@@ -667,7 +925,7 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
             return false;
         }
         // Start broadcasting ECM after beginning of crypto-period
-        _pkt_change_ecm = _packet_count + PacketDistance(_ts_bitrate, _delay_start);
+        _pkt_change_ecm = _plugin->_packet_count + PacketDistance(_plugin->_ts_bitrate, _plugin->_delay_start);
     }
 
     return true;
@@ -678,21 +936,40 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 // Perform crypto-period transition, for CW or ECM
 //----------------------------------------------------------------------------
 
-bool ts::ScramblerPlugin::changeCW()
+bool ts::ScramblerPlugin::ServiceContext::processTransitions()
+{
+    // Is it time to apply the next control word ?
+    if (_plugin->_need_cp && _plugin->_packet_count >= _pkt_change_cw && !changeCW()) {
+        return false;
+    }
+
+    // Is it time to start broadcasting the next ECM ?
+    if (_plugin->_need_ecm && _plugin->_packet_count >= _pkt_change_ecm) {
+        changeECM();
+    }
+    return true;
+}
+
+bool ts::ScramblerPlugin::ServiceContext::changeCW()
 {
-    if (_scrambling.hasFixedCW()) {
+    // Packets which were selected before the transition are scrambled with the previous CW.
+    if (!scrambleBatch()) {
+        return false;
+    }
+
+    if (_scrambling->hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
         // Point to next crypto-period
         _current_cw = (_current_cw + 1) & 0x01;
 
         // Determine new transition point.
-        if (_need_cp && _ts_bitrate != 0) {
-            _pkt_change_cw = _packet_count + PacketDistance(_ts_bitrate, _ecmg_args.cp_duration);
+        if (_plugin->_need_cp && _plugin->_ts_bitrate != 0) {
+            _pkt_change_cw = _plugin->_packet_count + PacketDistance(_plugin->_ts_bitrate, _plugin->_ecmg_args.cp_duration);
         }
 
         // Set next crypto-period key.
-        return _scrambling.setEncryptParity(int(_current_cw));
+        return _scrambling->setEncryptParity(int(_current_cw));
     }
     else if (!inDegradedMode()) {
         // Random CW and ECM generation at each crypto-period.
@@ -707,28 +984,28 @@ bool ts::ScramblerPlugin::changeCW()
         }
 
         // Determine new transition point.
-        if (_need_cp && _ts_bitrate != 0) {
-            _pkt_change_cw = _packet_count + PacketDistance(_ts_bitrate, _ecmg_args.cp_duration);
+        if (_plugin->_need_cp && _plugin->_ts_bitrate != 0) {
+            _pkt_change_cw = _plugin->_packet_count + PacketDistance(_plugin->_ts_bitrate, _plugin->_ecmg_args.cp_duration);
         }
 
         // Generate (or start generating) next ECM when using ECM(N) in cp(N)
-        if (_need_ecm && _current_ecm == _current_cw) {
+        if (_plugin->_need_ecm && _current_ecm == _current_cw) {
             nextCW().initNext(currentCW());
         }
     }
     return true;
 }
 
-void ts::ScramblerPlugin::changeECM()
+void ts::ScramblerPlugin::ServiceContext::changeECM()
 {
     // Allowed to change CW only if not in degraded mode
-    if (_need_ecm && _ts_bitrate != 0 && !inDegradedMode()) {
+    if (_plugin->_need_ecm && _plugin->_ts_bitrate != 0 && !inDegradedMode()) {
 
         // Point to next crypto-period
         _current_ecm = (_current_ecm + 1) & 0x01;
 
         // Determine new transition point
-        _pkt_change_ecm = _packet_count + PacketDistance(_ts_bitrate, _ecmg_args.cp_duration);
+        _pkt_change_ecm = _plugin->_packet_count + PacketDistance(_plugin->_ts_bitrate, _plugin->_ecmg_args.cp_duration);
 
         // Generate (or start generating) next ECM when using ECM(N) in cp(N)
         if (_current_ecm == _current_cw) {
@@ -738,6 +1015,28 @@ void ts::ScramblerPlugin::changeECM()
 }
 
 
+//----------------------------------------------------------------------------
+// Replace a null packet with the next ECM packet of the service.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::ServiceContext::insertECM(TSPacket& pkt)
+{
+    // Compute next insertion point (approximate)
+    assert(_plugin->_ecm_bitrate != 0);
+    _pkt_insert_ecm += _plugin->_ts_bitrate == 0 ? DEFAULT_ECM_INTER_PACKET : BitRate(_plugin->_ts_bitrate / _plugin->_ecm_bitrate).toInt();
+
+    // Try to exit from degraded mode, if we were in.
+    // Note that return false means unrecoverable error here.
+    if (!tryExitDegradedMode()) {
+        return false;
+    }
+
+    // Replace current null packet with an ECM packet
+    currentECM().getNextECMPacket(pkt);
+    return true;
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processing method
 //----------------------------------------------------------------------------
@@ -756,83 +1055,104 @@ ts::PacketProcessStatus ts::ScramblerPlugin::processPacket(TSPacket& pkt, TSPack
     if (br != 0) {
         _ts_bitrate = br;
         if (_wait_bitrate) {
-            initializeScheduling();
+            _wait_bitrate = false;
+            for (const auto& ctx : _contexts) {
+                if (ctx->waitingBitrate()) {
+                    ctx->initializeScheduling();
+                    reschedule(*ctx);
+                }
+            }
         }
     }
 
-    // Filter interesting sections to discover the service.
+    // Filter interesting sections to discover the services.
+    // If a service is definitely unknown or a fatal error occured during PMT analysis, give up.
     if (_use_service) {
-        _service.feedPacket(pkt);
+        for (const auto& ctx : _contexts) {
+            ctx->feedPacket(pkt);
+            if (ctx->nonExistentService()) {
+                return TSP_END;
+            }
+        }
     }
-
-    // If the service is definitely unknown or a fatal error occured during PMT analysis, give up.
-    if (_abort || _service.nonExistentService()) {
+    if (_abort) {
         return TSP_END;
     }
 
     // Abort if allocated PID for ECM is already present in TS.
-    if (_ecm_pid != PID_NULL && pid == _ecm_pid) {
+    if (_ecm_pids.test(pid)) {
         error(u"ECM PID allocation conflict, used 0x%X, now found as input PID, try another --pid-ecm", pid);
         return TSP_END;
     }
 
-    // As long as we do not know which PID's to scramble, nullify all packets.
+    // As long as we do not know which PID's to scramble in all services, nullify all packets.
     // Let predefined PID pass however since we do not need to modify the PAT, SDT, etc.
-    // The only modified PSI/SI is the PMT of the service, not in this PID range.
-    if (_scrambled_pids.none()) {
+    // The only modified PSI/SI are the PMT's of the services, not in this PID range.
+    if (_ready_count < _contexts.size()) {
         return pid <= PID_DVB_LAST ? TSP_OK : TSP_NULL;
     }
 
     // Packetize modified PMT when needed.
-    if (_update_pmt && pid == _pzer_pmt.getPID()) {
-        _pzer_pmt.getNextPacket(pkt);
+    if (_pmt_pids.test(pid)) {
+        _pzer_pmt[pid]->getNextPacket(pkt);
         return TSP_OK;
     }
 
-    // Is it time to apply the next control word ?
-    if (_need_cp && _packet_count >= _pkt_change_cw && !changeCW()) {
-        return TSP_END;
+    // Perform the CW and ECM transitions of all services which reached their transition point.
+    // Services in degraded mode remain at the head of the schedule and are checked again on next packet.
+    if (!_transitions.empty() && _transitions.begin()->first <= _packet_count) {
+        _due.clear();
+        for (auto it = _transitions.begin(); it != _transitions.end() && it->first <= _packet_count; ++it) {
+            _due.push_back(it->second);
+        }
+        for (auto ctx : _due) {
+            if (!ctx->processTransitions()) {
+                return TSP_END;
+            }
+            reschedule(*ctx);
+        }
     }
 
-    // Is it time to start broadcasting the next ECM ?
-    if (_need_ecm && _packet_count >= _pkt_change_ecm) {
-        changeECM();
+    // Insert an ECM packet (replace a null packet) for the service which needs it first.
+    if (_need_ecm && pid == PID_NULL && !_insertions.empty() && _insertions.begin()->first <= _packet_count) {
+        ServiceContext& ctx(*_insertions.begin()->second);
+        const bool ok = ctx.insertECM(pkt);
+        reschedule(ctx);
+        return ok ? TSP_OK : TSP_END;
     }
 
-    // Insert an ECM packet (replace a null packet) when time to do so
-    if (_need_ecm && pid == PID_NULL && _packet_count >= _pkt_insert_ecm) {
-
-        // Compute next insertion point (approximate)
-        assert(_ecm_bitrate != 0);
-        _pkt_insert_ecm += _ts_bitrate == 0 ? DEFAULT_ECM_INTER_PACKET : BitRate(_ts_bitrate / _ecm_bitrate).toInt();
-
-        // Try to exit from degraded mode, if we were in.
-        // Note that return false means unrecoverable error here.
-        if (!tryExitDegradedMode()) {
-            return TSP_END;
-        }
-
-        // Replace current null packet with an ECM packet
-        currentECM().getNextECMPacket(pkt);
+    // If the packet has no payload, or its PID is not to be scrambled, there is nothing to do.
+    ServiceContext* ctx = _pid_contexts[pid];
+    if (!pkt.hasPayload() || ctx == nullptr) {
         return TSP_OK;
     }
+    return ctx->scramblePacket(pkt);
+}
+
 
-    // If the packet has no payload, or its PID is not to be scrambled, or in the clear period, there is nothing to do.
-    if (!pkt.hasPayload() || !_scrambled_pids.test(pid) || _packet_count < _pkt_clear_period) {
+//----------------------------------------------------------------------------
+// Scramble a packet from one of the scrambled PID's of a service.
+//----------------------------------------------------------------------------
+
+ts::PacketProcessStatus ts::ScramblerPlugin::ServiceContext::scramblePacket(TSPacket& pkt)
+{
+    // In the clear period, there is nothing to do.
+    if (_plugin->_packet_count < _pkt_clear_period) {
         return TSP_OK;
     }
 
     // If packet is already scrambled, error or ignore (do not modify packet)
+    const PID pid = pkt.getPID();
     if (pkt.isScrambled()) {
-        if (_ignore_scrambled) {
+        if (_plugin->_ignore_scrambled) {
             if (!_conflict_pids.test(pid)) {
-                verbose(u"found input scrambled packets in PID %n, ignored", pid);
+                _plugin->verbose(u"%sfound input scrambled packets in PID %n, ignored", _prefix, pid);
                 _conflict_pids.set(pid);
             }
             return TSP_OK;
         }
         else {
-            error(u"packet already scrambled in PID %n", pid);
+            _plugin->error(u"%spacket already scrambled in PID %n", _prefix, pid);
             return TSP_END;
         }
     }
@@ -845,16 +1165,63 @@ ts::PacketProcessStatus ts::ScramblerPlugin::processPacket(TSPacket& pkt, TSPack
     }
     else {
         // Scramble this packet and reinit subsequent number of packets to keep clear
-        _partial_clear = _partial_scrambling - 1;
+        _partial_clear = _plugin->_partial_scrambling - 1;
     }
 
-    // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
-        return TSP_END;
+    // Scramble the packet payload. In packet window mode, the packet is scrambled at the end of the window.
+    _plugin->_scrambled_count++;
+    if (_plugin->_window_mode) {
+        _batch.push_back(&pkt);
+        return TSP_OK;
+    }
+    return _scrambling->encrypt(pkt) ? TSP_OK : TSP_END;
+}
+
+
+//----------------------------------------------------------------------------
+// Packet window processing, when the scrambling algorithm benefits from it.
+//----------------------------------------------------------------------------
+
+size_t ts::ScramblerPlugin::getPacketWindowSize()
+{
+    // With AES in CBC modes, the CBC chains of many packets are interleaved.
+    _window_mode = _scrambling.hasBatchEngine();
+    return _window_mode ? PACKET_WINDOW_SIZE : 0;
+}
+
+size_t ts::ScramblerPlugin::processPacketWindow(TSPacketWindow& win)
+{
+    TSPacket* pkt = nullptr;
+    TSPacketMetadata* pkt_data = nullptr;
+    size_t count = 0;
+
+    // Process all packets, except the actual scrambling.
+    for (; count < win.size(); ++count) {
+        if (win.get(count, pkt, pkt_data)) {
+            const PacketProcessStatus status = processPacket(*pkt, *pkt_data);
+            if (status == TSP_END) {
+                break;
+            }
+            else if (status == TSP_NULL) {
+                win.nullify(count);
+            }
+        }
     }
-    _scrambled_count++;
 
-    return TSP_OK;
+    // Scramble all selected packets at once, one batch per service, ie. per control word.
+    // On error, do not let clear packets pass.
+    bool ok = true;
+    for (const auto& ctx : _contexts) {
+        ok = ctx->scrambleBatch() && ok;
+    }
+    return ok ? count : 0;
+}
+
+bool ts::ScramblerPlugin::ServiceContext::scrambleBatch()
+{
+    const bool ok = _batch.empty() || _scrambling->encrypt(_batch.data(), _batch.size());
+    _batch.clear();
+    return ok;
 }
 
 
@@ -862,12 +1229,12 @@ ts::PacketProcessStatus ts::ScramblerPlugin::processPacket(TSPacket& pkt, TSPack
 // Initialize first crypto period.
 //----------------------------------------------------------------------------
 
-void ts::ScramblerPlugin::CryptoPeriod::initCycle(ScramblerPlugin* scrambler, uint16_t cp_number)
+void ts::ScramblerPlugin::CryptoPeriod::initCycle(ServiceContext* ctx, uint16_t cp_number)
 {
-    _plugin = scrambler;
+    _ctx = ctx;
     _cp_number = cp_number;
 
-    if (_plugin->_need_ecm) {
+    if (_ctx->_plugin->_need_ecm) {
         generateCW(_cw_current);
         generateCW(_cw_next);
         generateECM();
@@ -881,10 +1248,10 @@ void ts::ScramblerPlugin::CryptoPeriod::initCycle(ScramblerPlugin* scrambler, ui
 
 void ts::ScramblerPlugin::CryptoPeriod::initNext(const CryptoPeriod& previous)
 {
-    _plugin = previous._plugin;
+    _ctx = previous._ctx;
     _cp_number = previous._cp_number + 1;
 
-    if (_plugin->_need_ecm) {
+    if (_ctx->_plugin->_need_ecm) {
         _cw_current = previous._cw_next;
         generateCW(_cw_next);
         generateECM();
@@ -898,8 +1265,8 @@ void ts::ScramblerPlugin::CryptoPeriod::initNext(const CryptoPeriod& previous)
 
 void ts::ScramblerPlugin::CryptoPeriod::generateCW(ByteBlock& cw)
 {
-    BetterSystemRandomGenerator::Instance().readByteBlock(cw, _plugin->_scrambling.cwSize());
-    if (_plugin->_pre_reduce_cw && _plugin->_scrambling.entropyMode() == DVBCSA2::REDUCE_ENTROPY) {
+    BetterSystemRandomGenerator::Instance().readByteBlock(cw, _ctx->_scrambling->cwSize());
+    if (_ctx->_plugin->_pre_reduce_cw && _ctx->_scrambling->entropyMode() == DVBCSA2::REDUCE_ENTROPY) {
         assert(cw.size() == DVBCSA2::KEY_SIZE);
         DVBCSA2::ReduceCW(cw.data());
     }
@@ -912,12 +1279,12 @@ void ts::ScramblerPlugin::CryptoPeriod::generateCW(ByteBlock& cw)
 
 bool ts::ScramblerPlugin::CryptoPeriod::initScramblerKey() const
 {
-    _plugin->debug(u"starting crypto-period %'d at packet %'d", _cp_number, _plugin->_packet_count);
+    _ctx->_plugin->debug(u"%sstarting crypto-period %'d at packet %'d", _ctx->_prefix, _cp_number, _ctx->_plugin->_packet_count);
 
     // Change the parity of the scrambled packets.
     // Set our random current control word if no fixed CW.
-    return _plugin->_scrambling.setEncryptParity(_cp_number) &&
-        (!_plugin->_need_ecm || _plugin->_scrambling.setCW(_cw_current, _cp_number));
+    return _ctx->_scrambling->setEncryptParity(_cp_number) &&
+        (!_ctx->_plugin->_need_ecm || _ctx->_scrambling->setCW(_cw_current, _cp_number));
 }
 
 
@@ -927,20 +1294,22 @@ bool ts::ScramblerPlugin::CryptoPeriod::initScramblerKey() const
 
 void ts::ScramblerPlugin::CryptoPeriod::generateECM()
 {
+    ScramblerPlugin* const plugin = _ctx->_plugin;
     _ecm_ok = false;
 
-    if (_plugin->_synchronous_ecmg) {
+    if (plugin->_synchronous_ecmg) {
         // Synchronous ECM generation
-        ecmgscs::ECMResponse response(_plugin->_ecmgscs);
-        if (!_plugin->_ecmg.generateECM(_cp_number,
-                                        _cw_current,
-                                        _cw_next,
-                                        _plugin->_ecmg_args.access_criteria,
-                                        _plugin->_ecmg_args.cp_duration,
-                                        response))
+        ecmgscs::ECMResponse response(plugin->_ecmgscs);
+        if (!plugin->_ecmg.generateECM(_ctx->_stream_id,
+                                       _cp_number,
+                                       _cw_current,
+                                       _cw_next,
+                                       plugin->_ecmg_args.access_criteria,
+                                       plugin->_ecmg_args.cp_duration,
+                                       response))
         {
             // Error, message already reported
-            _plugin->_abort = true;
+            plugin->_abort = true;
         }
         else {
             handleECM(response);
@@ -948,15 +1317,16 @@ void ts::ScramblerPlugin::CryptoPeriod::generateECM()
     }
     else {
         // Asynchronous ECM generation
-        if (!_plugin->_ecmg.submitECM(_cp_number,
-                                      _cw_current,
-                                      _cw_next,
-                                      _plugin->_ecmg_args.access_criteria,
-                                      _plugin->_ecmg_args.cp_duration,
-                                      this))
+        if (!plugin->_ecmg.submitECM(_ctx->_stream_id,
+                                     _cp_number,
+                                     _cw_current,
+                                     _cw_next,
+                                     plugin->_ecmg_args.access_criteria,
+                                     plugin->_ecmg_args.cp_duration,
+                                     this))
         {
             // Error, message already reported
-            _plugin->_abort = true;
+            plugin->_abort = true;
         }
     }
 }
@@ -968,24 +1338,26 @@ void ts::ScramblerPlugin::CryptoPeriod::generateECM()
 
 void ts::ScramblerPlugin::CryptoPeriod::handleECM(const ecmgscs::ECMResponse& response)
 {
-    if (_plugin->_channel_status.section_TSpkt_flag == 0) {
+    ScramblerPlugin* const plugin = _ctx->_plugin;
+
+    if (plugin->_channel_status.section_TSpkt_flag == 0) {
         // ECMG returns ECM in section format
         const auto sp = std::make_shared<Section>(response.ECM_datagram);
         if (!sp->isValid()) {
-            _plugin->error(u"ECMG returned an invalid ECM section (%d bytes)", response.ECM_datagram.size());
-            _plugin->_abort = true;
+            plugin->error(u"%sECMG returned an invalid ECM section (%d bytes)", _ctx->_prefix, response.ECM_datagram.size());
+            plugin->_abort = true;
             return;
         }
         // Packetize the section
-        OneShotPacketizer pzer(_plugin->duck, _plugin->_ecm_pid, true);
+        OneShotPacketizer pzer(plugin->duck, _ctx->_ecm_pid, true);
         pzer.addSection(sp);
         pzer.getPackets(_ecm);
 
     }
     else if (response.ECM_datagram.size() % PKT_SIZE != 0) {
         // ECMG returns ECM in packet format, but not an integral number of packets
-        _plugin->error(u"invalid ECM size (%d bytes), not a multiple of %d", response.ECM_datagram.size(), PKT_SIZE);
-        _plugin->_abort = true;
+        plugin->error(u"%sinvalid ECM size (%d bytes), not a multiple of %d", _ctx->_prefix, response.ECM_datagram.size(), PKT_SIZE);
+        plugin->_abort = true;
         return;
     }
     else {
@@ -994,7 +1366,7 @@ void ts::ScramblerPlugin::CryptoPeriod::handleECM(const ecmgscs::ECMResponse& re
         MemCopy(&_ecm[0].b, response.ECM_datagram.data(), response.ECM_datagram.size());
     }
 
-    _plugin->debug(u"got ECM for crypto-period %d, %d packets", _cp_number, _ecm.size());
+    plugin->debug(u"%sgot ECM for crypto-period %d, %d packets", _ctx->_prefix, _cp_number, _ecm.size());
 
     _ecm_pkt_index = 0;
 
@@ -1022,8 +1394,8 @@ void ts::ScramblerPlugin::CryptoPeriod::getNextECMPacket(TSPacket& pkt)
             _ecm_pkt_index = 0;
         }
         // Adjust PID and continuity counter in TS packet
-        pkt.setPID(_plugin->_ecm_pid);
-        pkt.setCC(_plugin->_ecm_cc);
-        _plugin->_ecm_cc = (_plugin->_ecm_cc + 1) & 0x0F;
+        pkt.setPID(_ctx->_ecm_pid);
+        pkt.setCC(_ctx->_ecm_cc);
+        _ctx->_ecm_cc = (_ctx->_ecm_cc + 1) & 0x0F;
     }
 }
@@ -15,7 +15,7 @@
 #include "tsCASSelectionArgs.h"
 #include "tsBinaryTable.h"
 #include "tsSectionDemux.h"
-#include "tsPAT.h"
+#include "tsPATView.h"
 
 
 //----------------------------------------------------------------------------
@@ -42,7 +42,7 @@ namespace ts {
         virtual void handleTable(SectionDemux&, const BinaryTable&) override;
 
         // Process specific tables
-        void processPAT(const PAT&);
+        void processPAT(const PATView&);
     };
 }
 
@@ -162,7 +162,8 @@ void ts::SIFilterPlugin::handleTable(SectionDemux& demux, const BinaryTable& tab
     switch (table.tableId()) {
 
         case TID_PAT: {
-            PAT pat(duck, table);
+            // The tables are only read, use views instead of deserialization.
+            const PATView pat(table);
             if (pat.isValid()) {
                 processPAT(pat);
             }
@@ -170,7 +171,7 @@ void ts::SIFilterPlugin::handleTable(SectionDemux& demux, const BinaryTable& tab
         }
 
         case TID_CAT: {
-            CAT cat(duck, table);
+            const CATView cat(table);
             if (cat.isValid()) {
                 _cas_args.addMatchingPIDs(_pass_pids, cat, *this);
             }
@@ -178,7 +179,7 @@ void ts::SIFilterPlugin::handleTable(SectionDemux& demux, const BinaryTable& tab
         }
 
         case TID_PMT: {
-            PMT pmt(duck, table);
+            const PMTView pmt(table);
             if (pmt.isValid()) {
                 _cas_args.addMatchingPIDs(_pass_pids, pmt, *this);
             }
@@ -196,17 +197,22 @@ void ts::SIFilterPlugin::handleTable(SectionDemux& demux, const BinaryTable& tab
 //  This method processes a Program Association Table (PAT).
 //----------------------------------------------------------------------------
 
-void ts::SIFilterPlugin::processPAT(const PAT& pat)
+void ts::SIFilterPlugin::processPAT(const PATView& pat)
 {
-    for (const auto& it : pat.pmts) {
+    for (const auto& srv : pat) {
+        // Skip the NIT PID.
+        if (srv.id() == 0) {
+            continue;
+        }
+        const PID pmt_pid = srv.pmtPID();
         // Add PMT PID to section filter if ECM are required
         if (_cas_args.pass_ecm) {
-            _demux.addPID(it.second);
+            _demux.addPID(pmt_pid);
         }
         // Pass this PMT PID if PMT are required
-        if (_pass_pmt && !_pass_pids[it.second]) {
-            verbose(u"Filtering PMT PID %n", it.second);
-            _pass_pids.set(it.second);
+        if (_pass_pmt && !_pass_pids[pmt_pid]) {
+            verbose(u"Filtering PMT PID %n", pmt_pid);
+            _pass_pids.set(pmt_pid);
         }
     }
 }
@@ -12,6 +12,7 @@
 //----------------------------------------------------------------------------
 
 #include "tsPluginRepository.h"
+#include "tsDeferredLogger.h"
 
 #define DEFAULT_FORMAT u"Packet: %i, PID: %P (%p)"
 
@@ -39,7 +40,7 @@ namespace ts {
         fs::path         _outfile_name {};  // Output file name
 
         // Working data
-        std::ofstream _outfile {};          // User-specified output file
+        DeferredLogger _log {*this};        // Trace lines, written in a background thread
     };
 }
 
@@ -110,16 +111,8 @@ bool ts::TracePlugin::getOptions()
 
 bool ts::TracePlugin::start()
 {
-    // Create output file
-    if (!_outfile_name.empty()) {
-        verbose(u"creating %s", _outfile_name);
-        _outfile.open(_outfile_name, std::ios::out);
-        if (!_outfile) {
-            error(u"cannot create %s", _outfile_name);
-            return false;
-        }
-    }
-    return true;
+    // Create output file or log on tsp.
+    return _log.open(_outfile_name);
 }
 
 
@@ -129,10 +122,8 @@ bool ts::TracePlugin::start()
 
 bool ts::TracePlugin::stop()
 {
-    // Close output file
-    if (_outfile.is_open()) {
-        _outfile.close();
-    }
+    // Write all pending lines, close output file
+    _log.close();
     return true;
 }
 
@@ -195,11 +186,6 @@ ts::PacketProcessStatus ts::TracePlugin::processPacket(TSPacket& pkt, TSPacketMe
     }
 
     // Then report the message.
-    if (_outfile.is_open()) {
-        _outfile << line << std::endl;
-    }
-    else {
-        info(line);
-    }
+    _log.log(Severity::Info, u"%s", line);
     return TSP_OK;
 }
@@ -13,6 +13,7 @@
 #include "tsMain.h"
 #include "tsTSAnalyzerReport.h"
 #include "tsTSAnalyzerArgs.h"
+#include "tsParallelTSFileAnalyzer.h"
 #include "tsTSFile.h"
 #include "tsPagerArgs.h"
 #include "tsDuckContext.h"
@@ -33,6 +34,7 @@ namespace {
         ts::DuckContext    duck {this};         // TSDuck execution context.
         ts::BitRate        bitrate = 0;         // Expected bitrate (188-byte packets)
         fs::path           infile {};           // Input file name
+        size_t             threads = 1;         // Number of analysis threads.
         ts::TSPacketFormat format = ts::TSPacketFormat::AUTODETECT; // Input file format.
         ts::TSAnalyzerArgs analysis {};         // Analysis options.
         ts::PagerArgs      pager {true, true};  // Output paging options.
@@ -60,6 +62,15 @@ Options::Options(int argc, char *argv[]) :
          u"(based on 188-byte packets). By default, the bitrate is "
          u"evaluated using the PCR in the transport stream.");
 
+    option(u"threads", 't', UNSIGNED);
+    help(u"threads",
+         u"Analyze the input file using the specified number of threads. "
+         u"The file is split into chunks of packets which are analyzed in parallel and then merged. "
+         u"The result is the same as the sequential analysis. "
+         u"Zero means the number of CPU cores in the system. "
+         u"The default is one thread, meaning sequential analysis. "
+         u"The parallel analysis is possible only when the input is a regular file.");
+
     analyze(argc, argv);
 
     // Define all standard analysis options.
@@ -69,6 +80,7 @@ Options::Options(int argc, char *argv[]) :
 
     getPathValue(infile, u"");
     getValue(bitrate, u"bitrate");
+    getIntValue(threads, u"threads", 1);
     format = ts::LoadTSPacketFormatInputOption(*this);
 
     exitOnError();
@@ -88,19 +100,28 @@ int MainCode(int argc, char *argv[])
     ts::TSAnalyzerReport analyzer(opt.duck, opt.bitrate, ts::BitRateConfidence::OVERRIDE);
     analyzer.setAnalysisOptions(opt.analysis);
 
-    // Open the TS file.
-    ts::TSFile file;
-    if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
-        return EXIT_FAILURE;
-    }
-
     // Analyze all packets in the file.
-    ts::TSPacket pkt;
-    ts::TSPacketMetadata mdata;
-    while (file.readPackets(&pkt, &mdata, 1, opt) > 0) {
-        analyzer.feedPacket(pkt, mdata);
+    if (opt.threads != 1) {
+        // Parallel analysis of chunks of the file.
+        ts::ParallelTSFileAnalyzer parallel(opt.duck, analyzer);
+        parallel.setThreadCount(opt.threads);
+        if (!parallel.analyze(opt.infile, opt.format)) {
+            return EXIT_FAILURE;
+        }
+    }
+    else {
+        // Open the TS file.
+        ts::TSFile file;
+        if (!file.openRead(opt.infile, 1, 0, opt, opt.format)) {
+            return EXIT_FAILURE;
+        }
+        ts::TSPacket pkt;
+        ts::TSPacketMetadata mdata;
+        while (file.readPackets(&pkt, &mdata, 1, opt) > 0) {
+            analyzer.feedPacket(pkt, mdata);
+        }
+        file.close(opt);
     }
-    file.close(opt);
 
     // Display analysis results.
     analyzer.report(opt.pager.output(opt), opt.analysis, opt);
@@ -16,6 +16,7 @@
 #include "tsTSFile.h"
 #include "tsFileUtils.h"
 #include "tsjsonObject.h"
+#include "tsTSPacketMatcher.h"
 TS_MAIN(MainCode);
 
 #define DEFAULT_BUFFERED_PACKETS 10000
@@ -43,6 +44,8 @@ namespace ts {
         size_t           threshold_diff = 0;
         size_t           min_reorder = 0;
         bool             search_reorder = false;
+        bool             fingerprint = false;
+        size_t           threads = 0;
         bool             dump = false;
         uint32_t         dump_flags = 0;
         bool             normalized = false;
@@ -85,6 +88,20 @@ ts::TSCompareOptions::TSCompareOptions(int argc, char *argv[]) :
     option(u"dump", 'd');
     help(u"dump", u"Dump the content of all differing packets.");
 
+    option(u"fingerprint");
+    help(u"fingerprint",
+         u"Search missing, duplicated and reordered packets using packet fingerprints. "
+         u"Each packet is identified by a hash of its content and PID. "
+         u"A packet is matched with the oldest unmatched identical packet from the other file "
+         u"within a window of --buffered-packets packets around its expected position. "
+         u"The expected position follows the current offset between the files, as found from the last packets in order. "
+         u"This is much faster than --search-reorder on long files and it realigns after each gap which is shorter "
+         u"than --buffered-packets packets, whatever the total number of missing or inserted packets. "
+         u"A packet which is not found in the window is reported as missing in the other file. "
+         u"A packet which is found out of order relatively to the current offset is reported as reordered. "
+         u"A packet which is not found and is identical to the previous packet in the same PID is reported as duplicated. "
+         u"The options --cc-ignore, --payload-only, --pcr-ignore and --pid-ignore are applied before computing the fingerprint.");
+
     option(u"min-reorder", 'm', POSITIVE);
     help(u"min-reorder", u"count",
          u"With --search-reorder, this is the minimum number of consecutive packets to consider in reordered sequences of packets. "
@@ -119,6 +136,12 @@ ts::TSCompareOptions::TSCompareOptions(int argc, char *argv[]) :
     option(u"subset");
     help(u"subset", u"Legacy option, same as --search-reorder");
 
+    option(u"threads", 0, POSITIVE);
+    help(u"threads",
+         u"With --fingerprint, compare the packets in parallel in the specified number of threads, by groups of PID's. "
+         u"Packets are then considered out of order only relatively to packets in the same group of PID's. "
+         u"The default is 1.");
+
     option(u"threshold-diff", 't', INTEGER, 0, 1, 0, PKT_SIZE);
     help(u"threshold-diff", u"count",
          u"When used with --search-reorder, this value specifies the maximum number of "
@@ -139,6 +162,8 @@ ts::TSCompareOptions::TSCompareOptions(int argc, char *argv[]) :
     getIntValue(threshold_diff, u"threshold-diff", 0);
     getIntValue(min_reorder, u"min-reorder", std::min<size_t>(DEFAULT_MIN_REORDER, buffered_packets));
     search_reorder = present(u"subset") || present(u"search-reorder");
+    fingerprint = present(u"fingerprint");
+    getIntValue(threads, u"threads", 1);
     payload_only = present(u"payload-only");
     pcr_ignore = present(u"pcr-ignore");
     pid_ignore = present(u"pid-ignore");
@@ -155,6 +180,12 @@ ts::TSCompareOptions::TSCompareOptions(int argc, char *argv[]) :
     if (json.useFile() && normalized) {
         error(u"options --json and --normalized are mutually exclusive");
     }
+    if (fingerprint && search_reorder) {
+        error(u"options --fingerprint and --search-reorder are mutually exclusive");
+    }
+    if (fingerprint && threshold_diff > 0) {
+        error(u"--threshold-diff cannot be used with --fingerprint, packets must be identical");
+    }
     if (quiet) {
         setMaxSeverity(Severity::Info);
     }
@@ -185,7 +216,7 @@ namespace ts {
     {
         TS_NOBUILD_NOCOPY(PacketComparator);
     private:
-        TSCompareOptions& _opt;
+        const TSCompareOptions& _opt;
     public:
         bool   equal = false;      // Compared packets are identical
         size_t compared_size = 0;  // Size of compared data
@@ -194,7 +225,10 @@ namespace ts {
         size_t diff_count = 0;     // Number of different bytes (can be lower than end_diff-first_diff)
 
         // Constructor, compare the packets.
-        PacketComparator(const TSPacket& pkt1, const TSPacket& pkt2, TSCompareOptions& opt);
+        PacketComparator(const TSPacket& pkt1, const TSPacket& pkt2, const TSCompareOptions& opt);
+
+        // Reset the fields which are ignored in the comparison.
+        static void Normalize(TSPacket& pkt, const TSCompareOptions& opt);
 
     private:
         // Compare two TS memory regions, fill all fields with comparison result.
@@ -204,7 +238,7 @@ namespace ts {
 
 
 // Packet comparator constructor.
-ts::PacketComparator::PacketComparator(const TSPacket& pkt1, const TSPacket& pkt2, TSCompareOptions& opt) :
+ts::PacketComparator::PacketComparator(const TSPacket& pkt1, const TSPacket& pkt2, const TSCompareOptions& opt) :
     _opt(opt)
 {
     if (pkt1.getPID() == PID_NULL || pkt2.getPID() == PID_NULL) {
@@ -225,29 +259,29 @@ ts::PacketComparator::PacketComparator(const TSPacket& pkt1, const TSPacket& pkt
         // Some fields should be ignored, reset them in local copies
         TSPacket p1(pkt1);
         TSPacket p2(pkt2);
-        if (opt.pcr_ignore) {
-            if (p1.hasPCR()) {
-                p1.setPCR(0);
-            }
-            if (p1.hasOPCR()) {
-                p1.setOPCR(0);
-            }
-            if (p2.hasPCR()) {
-                p2.setPCR(0);
-            }
-            if (p2.hasOPCR()) {
-                p2.setOPCR(0);
-            }
-        }
-        if (opt.pid_ignore) {
-            p1.setPID(PID_NULL);
-            p2.setPID(PID_NULL);
+        Normalize(p1, opt);
+        Normalize(p2, opt);
+        compare(p1.b, PKT_SIZE, p2.b, PKT_SIZE);
+    }
+}
+
+
+// Reset the fields which are ignored in the comparison.
+void ts::PacketComparator::Normalize(TSPacket& pkt, const TSCompareOptions& opt)
+{
+    if (opt.pcr_ignore) {
+        if (pkt.hasPCR()) {
+            pkt.setPCR(0);
         }
-        if (opt.cc_ignore) {
-            p1.setCC(0);
-            p2.setCC(0);
+        if (pkt.hasOPCR()) {
+            pkt.setOPCR(0);
         }
-        compare(p1.b, PKT_SIZE, p2.b, PKT_SIZE);
+    }
+    if (opt.pid_ignore) {
+        pkt.setPID(PID_NULL);
+    }
+    if (opt.cc_ignore) {
+        pkt.setCC(0);
     }
 }
 
@@ -322,6 +356,9 @@ namespace ts {
         // Check if we are in a missing area. Return either 0 or the number of missing packets. Reset the missing area.
         PacketCounter wasInMissingArea();
 
+        // Account for a chunk of missing packets which was found elsewhere.
+        void addMissing(PacketCounter count);
+
     private:
         // Metadata for one packet in the buffer.
         struct PacketData {
@@ -438,6 +475,13 @@ ts::PacketCounter ts::FileToCompare::wasInMissingArea()
     }
 }
 
+// Account for a chunk of missing packets which was found elsewhere.
+void ts::FileToCompare::addMissing(PacketCounter count)
+{
+    _missing_packets += count;
+    _missing_chunks++;
+}
+
 // Find a sequence of packets (beginning of this buffer's file) in another file.
 bool ts::FileToCompare::findPackets(FileToCompare& other, PacketCounter& other_index, PacketCounter& count) const
 {
@@ -512,6 +556,16 @@ namespace ts {
         FileToCompare     _file1;
         json::Object      _jroot {};
         PacketCounter     _diff_count = 0;
+        TSPacketMatcher::Event _runs[3][2] {};  // Current run of consecutive events, by event type and file.
+
+        // Compare using buffers or fingerprints.
+        void compareBuffers();
+        void compareFingerprints();
+
+        // Accumulate consecutive events from fingerprint comparison, report them.
+        void addEvent(const TSPacketMatcher::Event& event);
+        void flushEvents();
+        void displayEvent(const TSPacketMatcher::Event& event);
 
         void displayHeader();
         void displayFinal();
@@ -519,6 +573,10 @@ namespace ts {
         void displayTruncated(size_t file_index, const FileToCompare& file);
         void displayMissingChunk(size_t ref_file_index, FileToCompare& ref_file,
                                  size_t miss_file_index, FileToCompare& miss_file);
+        void displayMissingPackets(size_t ref_file_index, const FileToCompare& ref_file,
+                                   size_t miss_file_index, const FileToCompare& miss_file,
+                                   PacketCounter start, PacketCounter count);
+        void displayDuplicate(size_t file_index, const FileToCompare& file, PacketCounter start, PacketCounter count);
         void displayReorder(size_t file0_index, const FileToCompare& file0, PacketCounter packet_index0,
                             size_t file1_index, const FileToCompare& file1, PacketCounter packet_index1,
                             PacketCounter count);
@@ -538,7 +596,21 @@ ts::FileComparator::FileComparator(TSCompareOptions& opt) :
     }
 
     displayHeader();
+    if (_opt.fingerprint) {
+        compareFingerprints();
+    }
+    else {
+        compareBuffers();
+    }
+    displayFinal();
 
+    success = _diff_count == 0 && _opt.valid() && !_opt.gotErrors();
+}
+
+
+// Compare packets one by one, search missing or reordered packets in the buffers.
+void ts::FileComparator::compareBuffers()
+{
     // Read and compare all packets in the files.
     // Stop at first difference in quiet mode (only report if equal) or not --continue.
     while (!_file0.eof() && !_file1.eof() && (_diff_count == 0 || (!_opt.quiet && _opt.continue_all))) {
@@ -614,9 +686,100 @@ ts::FileComparator::FileComparator(TSCompareOptions& opt) :
     else if (!_file0.eof() && _file1.eof()) {
         displayTruncated(1, _file1);
     }
-    displayFinal();
+}
 
-    success = _diff_count == 0 && _opt.valid() && !_opt.gotErrors();
+
+// Compare packets using fingerprints, in groups of PID's.
+void ts::FileComparator::compareFingerprints()
+{
+    TSPacketMatcher::Options mopt;
+    mopt.window = _opt.buffered_packets;
+    mopt.threads = _opt.threads;
+    mopt.payload_only = _opt.payload_only;
+    mopt.pcr_ignore = _opt.pcr_ignore;
+    mopt.pid_ignore = _opt.pid_ignore;
+    mopt.cc_ignore = _opt.cc_ignore;
+    TSPacketMatcher matcher(mopt);
+
+    FileToCompare* files[2] {&_file0, &_file1};
+    TSPacketVector chunks[2];
+    bool eof[2] {false, false};
+    std::vector<TSPacketMatcher::Event> events;
+    bool found = false;
+
+    // Stop at first difference in quiet mode (only report if equal) or not --continue.
+    while (!(eof[0] && eof[1]) && (!found || (!_opt.quiet && _opt.continue_all))) {
+        // Read next chunk in each file, the files are kept aligned on their current offset.
+        for (size_t f = 0; f < 2; ++f) {
+            const size_t count = matcher.readCount(f);
+            chunks[f].clear();
+            while (chunks[f].size() < count && !files[f]->eof()) {
+                chunks[f].push_back(files[f]->packet());
+                files[f]->moveNext();
+            }
+            eof[f] = files[f]->eof();
+        }
+
+        // Match packets and report events in file order.
+        matcher.feedPackets(chunks, eof, events);
+        for (const auto& ev : events) {
+            addEvent(ev);
+        }
+        found = found || !events.empty();
+    }
+    flushEvents();
+}
+
+
+// Accumulate consecutive events from fingerprint comparison.
+void ts::FileComparator::addEvent(const TSPacketMatcher::Event& event)
+{
+    TSPacketMatcher::Event& run(_runs[event.type][event.stream]);
+    if (run.count > 0 && event.index == run.index + run.count && (event.type != TSPacketMatcher::Event::REORDER || event.other_index == run.other_index + run.count)) {
+        run.count += event.count;
+    }
+    else {
+        if (run.count > 0) {
+            displayEvent(run);
+        }
+        run = event;
+    }
+}
+
+
+// Report all pending runs of events.
+void ts::FileComparator::flushEvents()
+{
+    for (auto& by_type : _runs) {
+        for (auto& run : by_type) {
+            if (run.count > 0) {
+                displayEvent(run);
+                run.count = 0;
+            }
+        }
+    }
+}
+
+
+// Report a run of events from fingerprint comparison.
+void ts::FileComparator::displayEvent(const TSPacketMatcher::Event& event)
+{
+    FileToCompare& file(event.stream == 0 ? _file0 : _file1);
+    FileToCompare& other(event.stream == 0 ? _file1 : _file0);
+    switch (event.type) {
+        case TSPacketMatcher::Event::MISSING:
+            file.addMissing(event.count);
+            displayMissingPackets(event.stream, file, 1 - event.stream, other, event.index, event.count);
+            break;
+        case TSPacketMatcher::Event::DUPLICATE:
+            displayDuplicate(event.stream, file, event.index, event.count);
+            break;
+        case TSPacketMatcher::Event::REORDER:
+            displayReorder(0, _file0, event.index, 1, _file1, event.other_index, event.count);
+            break;
+        default:
+            break;
+    }
 }
 
 
@@ -779,25 +942,52 @@ void ts::FileComparator::displayMissingChunk(size_t ref_file_index, FileToCompar
 {
     const PacketCounter count = ref_file.wasInMissingArea();
     if (count > 0) {
-        const PacketCounter start = ref_file.packetIndex() - count;
-        if (_opt.json.useJSON()) {
-            json::Value& jv(_jroot.query(u"events[]", true));
-            jv.add(u"type", u"skipped");
-            jv.add(u"packet", start);
-            jv.add(u"skipped", count);
-            jv.add(u"miss-file-index", miss_file_index);
-            jv.add(u"ref-file-index", ref_file_index);
-        }
-        if (_opt.normalized) {
-            std::cout << "skip:file=" << miss_file_index << ":packet=" << start << ":skipped=" << count << ":" << std::endl;
-        }
-        else if (!_opt.quiet && !_opt.json.useFile()) {
-            std::cout << "* Packet " << UString::Decimal(start) << " in " << ref_file.fileName()
-                      << ", missing " << UString::Decimal(count) << " packets in " << miss_file.fileName()
-                      << std::endl;
-        }
-        _diff_count++;
+        displayMissingPackets(ref_file_index, ref_file, miss_file_index, miss_file, ref_file.packetIndex() - count, count);
+    }
+}
+
+// Report a chunk of packets which are missing in the other file.
+void ts::FileComparator::displayMissingPackets(size_t ref_file_index, const FileToCompare& ref_file,
+                                               size_t miss_file_index, const FileToCompare& miss_file,
+                                               PacketCounter start, PacketCounter count)
+{
+    if (_opt.json.useJSON()) {
+        json::Value& jv(_jroot.query(u"events[]", true));
+        jv.add(u"type", u"skipped");
+        jv.add(u"packet", start);
+        jv.add(u"skipped", count);
+        jv.add(u"miss-file-index", miss_file_index);
+        jv.add(u"ref-file-index", ref_file_index);
+    }
+    if (_opt.normalized) {
+        std::cout << "skip:file=" << miss_file_index << ":packet=" << start << ":skipped=" << count << ":" << std::endl;
+    }
+    else if (!_opt.quiet && !_opt.json.useFile()) {
+        std::cout << "* Packet " << UString::Decimal(start) << " in " << ref_file.fileName()
+                  << ", missing " << UString::Decimal(count) << " packets in " << miss_file.fileName()
+                  << std::endl;
+    }
+    _diff_count++;
+}
+
+// Report duplicated packets, not found in the other file.
+void ts::FileComparator::displayDuplicate(size_t file_index, const FileToCompare& file, PacketCounter start, PacketCounter count)
+{
+    if (_opt.json.useJSON()) {
+        json::Value& jv(_jroot.query(u"events[]", true));
+        jv.add(u"type", u"duplicate");
+        jv.add(u"packet", start);
+        jv.add(u"count", count);
+        jv.add(u"file-index", file_index);
+    }
+    if (_opt.normalized) {
+        std::cout << "duplicate:file=" << file_index << ":packet=" << start << ":count=" << count << ":" << std::endl;
     }
+    else if (!_opt.quiet && !_opt.json.useFile()) {
+        std::cout << "* Packet " << UString::Decimal(start) << " in " << file.fileName()
+                  << ", " << UString::Decimal(count) << " duplicate packets" << std::endl;
+    }
+    _diff_count++;
 }
 
 // Report packets in the wrong order.
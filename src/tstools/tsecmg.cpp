@@ -13,11 +13,16 @@
 #include "tsMain.h"
 #include "tsDuckContext.h"
 #include "tsAsyncReport.h"
-#include "tsThread.h"
+#include "tsTaskPool.h"
 #include "tsSysUtils.h"
+#include "tsSysInfo.h"
 #include "tsECMGSCS.h"
 #include "tsTCPServer.h"
-#include "tstlvConnection.h"
+#include "tsReactor.h"
+#include "tsReactiveTCPServer.h"
+#include "tsReactiveServer.h"
+#include "tstlvReactiveConnection.h"
+#include "tsLatencyHistogram.h"
 #include "tsDuckProtocol.h"
 #include "tsOneShotPacketizer.h"
 TS_MAIN(MainCode);
@@ -31,12 +36,16 @@ namespace {
     static const int16_t  DEFAULT_TRANS_DELAY_START = -500;
     static const int16_t  DEFAULT_TRANS_DELAY_STOP  = 0;
 
-    // Stack size for execution of the client connection thread
-    static constexpr size_t CLIENT_STACK_SIZE = 128 * 1024;
+    static const size_t   DEFAULT_MAX_PENDING       = 1000;
 
-    // Instantiation of a TCP connection in a multi-thread context for TLV messages.
-    using ECMGConnection = ts::tlv::Connection<ts::ThreadSafety::Full>;
-    using ECMGConnectionPtr = std::shared_ptr<ECMGConnection>;
+    // Stack size for execution of the ECM computation threads.
+    static constexpr size_t WORKER_STACK_SIZE = 128 * 1024;
+
+    // Backlog of incoming client connections.
+    static constexpr int LISTEN_BACKLOG = 128;
+
+    // Max number of consecutive invalid messages before disconnecting a client.
+    static constexpr size_t MAX_INVALID_MESSAGES = 3;
 }
 
 
@@ -57,6 +66,9 @@ namespace {
         int                        logProtocol = ts::Severity::Debug;  // Log level for ECMG <=> SCS protocol.
         int                        logData = ts::Severity::Debug;      // Log level for CW/ECM data messages.
         bool                       once = false;            // Accept only one client.
+        size_t                     threads = 0;             // Number of ECM computation threads.
+        size_t                     maxPending = 0;          // Max number of pending ECM computations.
+        cn::seconds                statsInterval {};        // Interval between response time reports.
         bool                       reusePort = false;       // Socket option.
         cn::milliseconds           ecmCompTime {};          // ECM computation time.
         ts::IPSocketAddress        serverAddress {};        // TCP server local address.
@@ -130,6 +142,13 @@ ECMGOptions::ECMGOptions(int argc, char *argv[]) :
     option(u"no-reuse-port", 0);
     help(u"no-reuse-port", u"Disable the reuse port socket option. Do not use unless completely necessary.");
 
+    option(u"max-pending", 0, POSITIVE);
+    help(u"max-pending",
+         u"Specify the maximum number of CW_provision requests which are waiting for "
+         u"an ECM computation thread. When this limit is reached, new requests are "
+         u"rejected with an 'out of compute' error. "
+         u"Default: " + ts::UString::Decimal(DEFAULT_MAX_PENDING) + u".");
+
     option(u"once", 'o');
     help(u"once", u"Accept only one client and exit at the end of the session.");
 
@@ -147,6 +166,19 @@ ECMGOptions::ECMGOptions(int argc, char *argv[]) :
          u"parameter 'section_TSpkt_flag' to zero. By default, ECM's are returned "
          u"in TS packet format.");
 
+    option<cn::seconds>(u"statistics-interval");
+    help(u"statistics-interval",
+         u"Periodically report the distribution of the ECM response times of each "
+         u"channel (from CW_provision reception to ECM_response transmission), "
+         u"including the 99th percentile. The response times of a channel are always "
+         u"reported at the end of its session, in verbose mode.");
+
+    option(u"threads", 0, POSITIVE);
+    help(u"threads",
+         u"Specify the number of threads which compute ECM's. All client sessions are "
+         u"handled by one single thread but the ECM computations are offloaded to a pool "
+         u"of worker threads. By default, use one thread per CPU core.");
+
     option(u"transition-delay-start", 0, INT16);
     help(u"transition-delay-start",
          u"This option sets the DVB SimulCrypt option 'transition_delay_start', in "
@@ -162,6 +194,9 @@ ECMGOptions::ECMGOptions(int argc, char *argv[]) :
     logArgs.loadArgs(*this);
     serverAddress.setPort(intValue<uint16_t>(u"port", DEFAULT_SERVER_PORT));
     once = present(u"once");
+    getIntValue(threads, u"threads", ts::SysInfo::Instance().cpuCoreCount());
+    getIntValue(maxPending, u"max-pending", DEFAULT_MAX_PENDING);
+    getChronoValue(statsInterval, u"statistics-interval");
     reusePort = !present(u"no-reuse-port");
     getChronoValue(ecmCompTime, u"comp-time");
     logProtocol = present(u"log-protocol") ? intValue<int>(u"log-protocol", ts::Severity::Info) : ts::Severity::Debug;
@@ -263,32 +298,297 @@ bool ECMGSharedData::closeChannel(uint16_t id)
 
 
 //----------------------------------------------------------------------------
-// A class implementing a thread which manages a client connection.
+// An ECM computation request, from a client session to the worker threads
+// and back to the client session with the computed ECM.
+//----------------------------------------------------------------------------
+
+class ECMGRequest
+{
+    TS_NOBUILD_NOCOPY(ECMGRequest);
+public:
+    // Constructor.
+    ECMGRequest(const ECMGOptions& opt, uint64_t session, const std::shared_ptr<ts::ecmgscs::CWProvision>& msg);
+
+    const uint64_t                                  session_id;  // Id of the requesting client session.
+    const std::shared_ptr<ts::ecmgscs::CWProvision> request;     // Original CW_provision message.
+    const ts::monotonic_time                        received;    // Reception time of the request.
+    ts::ecmgscs::ECMResponse                        response;    // Computed ECM_response message.
+};
+
+using ECMGRequestPtr = std::shared_ptr<ECMGRequest>;
+
+ECMGRequest::ECMGRequest(const ECMGOptions& opt, uint64_t session, const std::shared_ptr<ts::ecmgscs::CWProvision>& msg) :
+    session_id(session),
+    request(msg),
+    received(ts::monotonic_time::clock::now()),
+    response(opt.ecmgscs)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// A client session interface, as seen by the ECM computation pool.
+//----------------------------------------------------------------------------
+
+class ECMGSessionInterface
+{
+    TS_INTERFACE(ECMGSessionInterface);
+public:
+    // Invoked in the reactor thread when the ECM of a request is computed.
+    virtual void handleECMComputed(const ECMGRequestPtr& req) = 0;
+
+    // Invoked in the reactor thread to report response times.
+    virtual void reportStatistics(bool final) = 0;
+};
+
+ECMGSessionInterface::~ECMGSessionInterface() {}
+
+
+//----------------------------------------------------------------------------
+// A bounded pool of threads which compute ECM's.
 //----------------------------------------------------------------------------
 
-class ECMGClientHandler: public ts::Thread
+class ECMGWorkerPool: private ts::ReactorHandlerInterface
 {
-    TS_NOBUILD_NOCOPY(ECMGClientHandler);
+    TS_NOBUILD_NOCOPY(ECMGWorkerPool);
 public:
     // Constructor.
-    // When deleteWhenTerminated is true, this object is automatically deleted when the thread terminates.
-    ECMGClientHandler(const ECMGOptions& opt, const ECMGConnectionPtr& conn, ECMGSharedData* shared, bool deleteWhenTerminated);
+    ECMGWorkerPool(const ECMGOptions& opt, ECMGSharedData& shared, ts::Reactor& reactor);
 
     // Destructor.
-    virtual ~ECMGClientHandler() override;
+    virtual ~ECMGWorkerPool() override;
+
+    // Start and stop the worker threads.
+    bool start();
+    void stop();
+
+    // Register and unregister a client session. Must be called in the reactor thread.
+    uint64_t registerSession(ECMGSessionInterface* session);
+    void unregisterSession(uint64_t id);
 
-    // Main code of the thread.
-    // Make it a public methof to invoke it synchronously with --once.
-    virtual void main() override;
+    // Submit an ECM computation. Return false if too many computations are pending.
+    bool submit(const ECMGRequestPtr& req);
+
+private:
+    const ECMGOptions&        _opt;
+    ECMGSharedData&           _shared;
+    ts::Reactor&              _reactor;
+    ts::EventId               _done_event {};     // Signaled by worker threads when ECM's are computed.
+    ts::EventId               _stats_timer {};    // Periodic report of response times.
+    uint64_t                  _last_session = 0;  // Last allocated session id.
+    std::map<uint64_t, ECMGSessionInterface*> _sessions {};  // Active sessions, used in reactor thread only.
+    const ts::duck::Protocol  _protocol {};       // To encode ECM structure, read-only, shared by all threads.
+    ts::TaskPool              _tasks;             // Pending and executing ECM computations.
+
+    // Queue of computed requests, to be sent in the reactor thread, protected by the mutex.
+    std::mutex                 _mutex {};
+    std::deque<ECMGRequestPtr> _done {};
+
+    // Compute an ECM, in the context of a worker thread.
+    void computeECM(ECMGRequest& req);
+
+    // Reactor handlers.
+    virtual void handleUserEvent(ts::Reactor& reactor, ts::EventId id) override;
+    virtual void handleTimer(ts::Reactor& reactor, ts::EventId id) override;
+};
+
+
+//----------------------------------------------------------------------------
+// Implementation of ECMGWorkerPool.
+//----------------------------------------------------------------------------
+
+ECMGWorkerPool::ECMGWorkerPool(const ECMGOptions& opt, ECMGSharedData& shared, ts::Reactor& reactor) :
+    _opt(opt),
+    _shared(shared),
+    _reactor(reactor),
+    _tasks(opt.threads, opt.maxPending, ts::ThreadAttributes().setStackSize(WORKER_STACK_SIZE))
+{
+}
+
+ECMGWorkerPool::~ECMGWorkerPool()
+{
+    stop();
+}
+
+// Start the worker threads.
+bool ECMGWorkerPool::start()
+{
+    _done_event = _reactor.newEvent(this);
+    if (!_done_event.isValid()) {
+        return false;
+    }
+    if (_opt.statsInterval > cn::seconds::zero()) {
+        _stats_timer = _reactor.newTimer(this, _opt.statsInterval, true);
+        if (!_stats_timer.isValid()) {
+            return false;
+        }
+    }
+    return _tasks.start();
+}
+
+// Stop the worker threads. Pending requests are dropped.
+void ECMGWorkerPool::stop()
+{
+    _tasks.clear();
+    _tasks.terminate();
+}
+
+// Register a client session.
+uint64_t ECMGWorkerPool::registerSession(ECMGSessionInterface* session)
+{
+    _sessions[++_last_session] = session;
+    return _last_session;
+}
+
+// Unregister a client session. Computations in progress for this session will be dropped.
+void ECMGWorkerPool::unregisterSession(uint64_t id)
+{
+    _sessions.erase(id);
+}
+
+// Submit an ECM computation.
+bool ECMGWorkerPool::submit(const ECMGRequestPtr& req)
+{
+    return _tasks.tryPost([this, req]() {
+        computeECM(*req);
+        // Pass the response to the reactor thread.
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _done.push_back(req);
+        }
+        _reactor.signalEvent(_done_event);
+    });
+}
+
+// Reactor handler: called when some ECM's have been computed.
+void ECMGWorkerPool::handleUserEvent(ts::Reactor& reactor, ts::EventId id)
+{
+    std::deque<ECMGRequestPtr> done;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        done.swap(_done);
+    }
+    for (const auto& req : done) {
+        const auto it = _sessions.find(req->session_id);
+        if (it != _sessions.end()) {
+            it->second->handleECMComputed(req);
+        }
+    }
+}
+
+// Reactor handler: periodically report response times.
+void ECMGWorkerPool::handleTimer(ts::Reactor& reactor, ts::EventId id)
+{
+    for (const auto& it : _sessions) {
+        it.second->reportStatistics(false);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Compute an ECM, in the context of a worker thread.
+// The request has already been validated by the client session.
+//----------------------------------------------------------------------------
+
+void ECMGWorkerPool::computeECM(ECMGRequest& req)
+{
+    const ECMGOptions& opt(_opt);
+    const ts::ecmgscs::CWProvision& msg(*req.request);
+
+    // Start to build the response.
+    req.response.channel_id = msg.channel_id;
+    req.response.stream_id = msg.stream_id;
+    req.response.CP_number = msg.CP_number;
+
+    // Add all CW's in the ECM (in the clear, yeah, but that's a fake/test ECMG).
+    ts::duck::ClearECM ecm(_protocol);
+    for (const auto& cpcw : msg.CP_CW_combination) {
+        if ((cpcw.CP & 0x01) == 0) {
+            ecm.cw_even = cpcw.CW;
+        }
+        else {
+            ecm.cw_odd = cpcw.CW;
+        }
+        // In debug mode, display if CW has reduced entropy.
+        _shared.report().debug(u"incoming CW entropy: %s", cpcw.CW.size() == ts::DVBCSA2::KEY_SIZE && ts::DVBCSA2::IsReducedCW(cpcw.CW.data()) ? u"reduced" : u"not reduced");
+    }
+
+    // Add optional access criteria in ECM.
+    if (msg.has_access_criteria) {
+        ecm.access_criteria = msg.access_criteria;
+    }
+
+    // Serialize the ECM section payload.
+    const auto ecm_bin = std::make_shared<ts::ByteBlock>();
+    ts::tlv::Serializer serial(ecm_bin);
+    ecm.serialize(serial);
+
+    // Compute the table id for the ECM, 0x80 or 0x81. There are two incompatible possibilities.
+    // First method is to copy the parity of the crypto period number. Second method is to
+    // alternate between the two, request after request in the stream. There is no requirement
+    // that the table id has the same parity as the CP. However, it is safe to do it just in
+    // case some CAS relies on it. On the other hand, if the SCS sends non-consecutive CP
+    // numbers, it is possible that two adjacent CP have the same parity. Anyway, since there
+    // is no perfect solution, we use the first one since it is simpler.
+    const ts::TID tid = ts::TID(ts::TID_ECM_80 | (msg.CP_number & 0x01));
+
+    // Build the ECM section.
+    const auto ecm_section = std::make_shared<ts::Section>(tid, true, ecm_bin->data(), ecm_bin->size());
+
+    // Format ECM for the response message.
+    if (opt.channelStatus.section_TSpkt_flag) {
+        // Send ECM as TS packets, packetize the section.
+        ts::TSPacketVector ecm_packets;
+        ts::OneShotPacketizer zer(opt.duck);
+        zer.addSection(ecm_section);
+        zer.getPackets(ecm_packets);
+        if (!ecm_packets.empty()) {
+            req.response.ECM_datagram.copy(ecm_packets[0].b, ecm_packets.size() * ts::PKT_SIZE);
+        }
+    }
+    else {
+        // Send ECM as a section.
+        req.response.ECM_datagram.copy(ecm_section->content(), ecm_section->size());
+    }
+
+    // Emulate the computation time of a real ECMG.
+    if (opt.ecmCompTime > cn::milliseconds::zero()) {
+        std::this_thread::sleep_for(opt.ecmCompTime);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// A class implementing a client session in the reactor thread.
+//----------------------------------------------------------------------------
+
+class ECMGClientSession:
+    public ts::ReactiveServerSessionInterface,
+    private ECMGSessionInterface,
+    private ts::ReactiveTCPConnectionHandlerInterface,
+    private ts::tlv::ReactiveConnectionHandlerInterface
+{
+    TS_NOBUILD_NOCOPY(ECMGClientSession);
+public:
+    // Constructor.
+    ECMGClientSession(const ECMGOptions& opt, ECMGSharedData& shared, ECMGWorkerPool& pool, ts::Reactor& reactor);
+
+    // Destructor, invoked by the reactive server after the socket is closed.
+    virtual ~ECMGClientSession() override;
 
 private:
     const ECMGOptions&          _opt;
-    ts::duck::Protocol          _protocol {};   // To encode ECM structure.
-    ECMGSharedData*             _shared = nullptr;
-    ECMGConnectionPtr           _conn {};
+    ECMGSharedData&             _shared;
+    ECMGWorkerPool&             _pool;
+    uint64_t                    _session_id = 0;
+    ts::TCPConnection           _client {};
+    ts::ReactiveTCPConnection   _rclient;
+    ts::tlv::ReactiveConnection _conn;
     ts::UString                 _peer {};
     std::optional<uint16_t>     _channel {};    // Current channel id.
     std::map<uint16_t,uint16_t> _streams {};    // Map of current stream id => ECM id.
+    ts::LatencyHistogram        _latency {};    // ECM response times in microseconds since last report.
+    ts::LatencyHistogram        _total {};      // ECM response times in microseconds for the channel.
 
     // Handle the various ECMG client messages.
     bool handleChannelSetup(const std::shared_ptr<ts::ecmgscs::ChannelSetup>& msg);
@@ -300,54 +600,82 @@ private:
     bool handleCWProvision(const std::shared_ptr<ts::ecmgscs::CWProvision>& msg);
 
     // Send a response message.
-    bool send(const ts::tlv::Message& msg) { return _conn->sendMessage(msg); }
+    bool send(const ts::tlv::Message& msg) { return _conn.startSendMessage(msg); }
 
     // Send an error related to the msg.
     bool sendErrorResponse(const std::shared_ptr<ts::tlv::Message>& msg, uint16_t errorStatus);
+
+    // Release the current channel.
+    void releaseChannel();
+
+    // Inherited methods.
+    virtual ts::ReactiveTCPConnection& getConnection() override;
+    virtual void handleTCPAccepted(ts::ReactiveTCPServer& server, ts::ReactiveTCPConnection& sock, int error_code, const ts::ObjectPtr& user_data) override;
+    virtual void handleTLVMessage(ts::tlv::ReactiveConnection& conn, const ts::tlv::MessagePtr& msg, int error_code) override;
+    virtual void handleECMComputed(const ECMGRequestPtr& req) override;
+    virtual void reportStatistics(bool final) override;
 };
 
 
 //----------------------------------------------------------------------------
-// ECMG client constructor and destructor.
+// ECMG client session constructor and destructor.
 //----------------------------------------------------------------------------
 
-ECMGClientHandler::ECMGClientHandler(const ECMGOptions& opt, const ECMGConnectionPtr& conn, ECMGSharedData* shared, bool deleteWhenTerminated) :
+ECMGClientSession::ECMGClientSession(const ECMGOptions& opt, ECMGSharedData& shared, ECMGWorkerPool& pool, ts::Reactor& reactor) :
     _opt(opt),
     _shared(shared),
-    _conn(conn)
+    _pool(pool),
+    _rclient(reactor, _client),
+    _conn(_rclient, shared.logger(), opt.ecmgscs, true, MAX_INVALID_MESSAGES)
+{
+    _rclient.whenAccepted(this);
+}
+
+ECMGClientSession::~ECMGClientSession()
 {
-    // Set thread attributes. Beware of deleteWhenTerminated...
-    ts::ThreadAttributes attr;
-    attr.setStackSize(CLIENT_STACK_SIZE);
-    attr.setDeleteWhenTerminated(deleteWhenTerminated);
-    setAttributes(attr);
+    // Make sure to release the channel if not done by the clients.
+    releaseChannel();
+    if (_session_id != 0) {
+        _pool.unregisterSession(_session_id);
+        _shared.report().verbose(u"%s: session completed", _peer);
+    }
 }
 
-ECMGClientHandler::~ECMGClientHandler()
+ts::ReactiveTCPConnection& ECMGClientSession::getConnection()
 {
-    // Wait for completion of the thread.
-    waitForTermination();
+    return _rclient;
 }
 
 
 //----------------------------------------------------------------------------
-// Main code of the client connection thread.
+// Invoked when a client is connected.
 //----------------------------------------------------------------------------
 
-void ECMGClientHandler::main()
+void ECMGClientSession::handleTCPAccepted(ts::ReactiveTCPServer& server, ts::ReactiveTCPConnection& sock, int error_code, const ts::ObjectPtr& user_data)
 {
-    _peer = _conn->peerName();
-    _shared->report().verbose(u"%s: session started", _peer);
+    if (error_code == ts::SYS_SUCCESS) {
+        _peer = _client.peerName();
+        _session_id = _pool.registerSession(this);
+        _shared.report().verbose(u"%s: session started", _peer);
+
+        // We never send any request to the client. We simply wait for requests from the
+        // client and respond to them. Responses to CW_provision are sent when the ECM
+        // computation completes in the worker pool.
+        if (!_conn.startReceive(this)) {
+            _rclient.startClose(nullptr, true);
+        }
+    }
+}
 
-    // Normally, an ECMG should handle incoming and outgoing messages independently.
-    // However, here we have a minimal implementation. We never send any request to
-    // the client and the ECM generation is instantaneous. So, we simply wait for
-    // requests from the client and respond to them immediately.
 
-    // Loop on message reception
-    ts::tlv::MessagePtr msg;
-    bool ok = true;
-    while (ok && _conn->receiveMessage(msg)) {
+//----------------------------------------------------------------------------
+// Invoked when a TLV message is received from the client.
+//----------------------------------------------------------------------------
+
+void ECMGClientSession::handleTLVMessage(ts::tlv::ReactiveConnection& conn, const ts::tlv::MessagePtr& msg, int error_code)
+{
+    bool ok = error_code == ts::SYS_SUCCESS && msg != nullptr;
+    if (ok) {
         switch (msg->tag()) {
             case ts::ecmgscs::Tags::channel_setup:
                 ok = handleChannelSetup(std::dynamic_pointer_cast<ts::ecmgscs::ChannelSetup>(msg));
@@ -384,16 +712,51 @@ void ECMGClientHandler::main()
     }
 
     // Error while receiving or sending messages, most likely a client disconnection.
-    _conn->disconnect(true);
-    _conn->close();
+    // The session object is deleted by the reactive server after the socket is closed.
+    if (!ok && _rclient.isOpen()) {
+        releaseChannel();
+        _client.disconnect(true);
+        _rclient.startClose(nullptr, true);
+    }
+}
 
-    // Make sure to release the channel if not done by the clients.
+
+//----------------------------------------------------------------------------
+// Release the current channel.
+//----------------------------------------------------------------------------
+
+void ECMGClientSession::releaseChannel()
+{
     if (_channel.has_value()) {
-        _shared->closeChannel(_channel.value());
+        reportStatistics(true);
+        _shared.closeChannel(_channel.value());
         _channel.reset();
     }
+    _streams.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Report the ECM response times of the channel.
+//----------------------------------------------------------------------------
 
-    _shared->report().verbose(u"%s: session completed", _peer);
+void ECMGClientSession::reportStatistics(bool final)
+{
+    if (_channel.has_value()) {
+        ts::LatencyHistogram interval;
+        _latency.moveTo(interval);
+        _total.add(interval);
+        if (final && _total.count() > 0) {
+            _shared.report().verbose(u"%s: channel %d, ECM response times: %s", _peer, _channel.value(), _total.summary(u" us"));
+        }
+        else if (!final && interval.count() > 0) {
+            _shared.report().info(u"%s: channel %d, ECM response times: %s", _peer, _channel.value(), interval.summary(u" us"));
+        }
+    }
+    if (final) {
+        _latency.reset();
+        _total.reset();
+    }
 }
 
 
@@ -401,7 +764,7 @@ void ECMGClientHandler::main()
 // Send an error related to the msg.
 //----------------------------------------------------------------------------
 
-bool ECMGClientHandler::sendErrorResponse(const std::shared_ptr<ts::tlv::Message>& msg, uint16_t errorStatus)
+bool ECMGClientSession::sendErrorResponse(const std::shared_ptr<ts::tlv::Message>& msg, uint16_t errorStatus)
 {
     std::shared_ptr<ts::tlv::ChannelMessage> channel_msg;
     std::shared_ptr<ts::tlv::StreamMessage> stream_msg;
@@ -436,14 +799,14 @@ bool ECMGClientHandler::sendErrorResponse(const std::shared_ptr<ts::tlv::Message
 // Handle the various types of messages from the client.
 //----------------------------------------------------------------------------
 
-bool ECMGClientHandler::handleChannelSetup(const std::shared_ptr<ts::ecmgscs::ChannelSetup>& msg)
+bool ECMGClientSession::handleChannelSetup(const std::shared_ptr<ts::ecmgscs::ChannelSetup>& msg)
 {
     assert(msg != nullptr);
     if (_channel.has_value()) {
         // Channel already set in this session.
         return sendErrorResponse(msg, ts::ecmgscs::Errors::inv_channel_id);
     }
-    else if (!_shared->openChannel(msg->channel_id)) {
+    else if (!_shared.openChannel(msg->channel_id)) {
         // Channel id already in use.
         return sendErrorResponse(msg, ts::ecmgscs::Errors::channel_id_in_use);
     }
@@ -457,7 +820,7 @@ bool ECMGClientHandler::handleChannelSetup(const std::shared_ptr<ts::ecmgscs::Ch
 }
 
 
-bool ECMGClientHandler::handleChannelTest(const std::shared_ptr<ts::ecmgscs::ChannelTest>& msg)
+bool ECMGClientSession::handleChannelTest(const std::shared_ptr<ts::ecmgscs::ChannelTest>& msg)
 {
     assert(msg != nullptr);
     if (_channel != msg->channel_id) {
@@ -474,7 +837,7 @@ bool ECMGClientHandler::handleChannelTest(const std::shared_ptr<ts::ecmgscs::Cha
 }
 
 
-bool ECMGClientHandler::handleChannelClose(const std::shared_ptr<ts::ecmgscs::ChannelClose>& msg)
+bool ECMGClientSession::handleChannelClose(const std::shared_ptr<ts::ecmgscs::ChannelClose>& msg)
 {
     assert(msg != nullptr);
     if (_channel != msg->channel_id) {
@@ -483,15 +846,13 @@ bool ECMGClientHandler::handleChannelClose(const std::shared_ptr<ts::ecmgscs::Ch
     }
     else {
         // Channel ok, close everything, no response expected.
-        _shared->closeChannel(msg->channel_id);
-        _channel.reset();
-        _streams.clear();
+        releaseChannel();
         return true;
     }
 }
 
 
-bool ECMGClientHandler::handleStreamSetup(const std::shared_ptr<ts::ecmgscs::StreamSetup>& msg)
+bool ECMGClientSession::handleStreamSetup(const std::shared_ptr<ts::ecmgscs::StreamSetup>& msg)
 {
     assert(msg != nullptr);
     if (_channel != msg->channel_id) {
@@ -514,7 +875,7 @@ bool ECMGClientHandler::handleStreamSetup(const std::shared_ptr<ts::ecmgscs::Str
 }
 
 
-bool ECMGClientHandler::handleStreamTest(const std::shared_ptr<ts::ecmgscs::StreamTest>& msg)
+bool ECMGClientSession::handleStreamTest(const std::shared_ptr<ts::ecmgscs::StreamTest>& msg)
 {
     assert(msg != nullptr);
     if (_channel != msg->channel_id) {
@@ -536,7 +897,7 @@ bool ECMGClientHandler::handleStreamTest(const std::shared_ptr<ts::ecmgscs::Stre
 }
 
 
-bool ECMGClientHandler::handleStreamCloseRequest(const std::shared_ptr<ts::ecmgscs::StreamCloseRequest>& msg)
+bool ECMGClientSession::handleStreamCloseRequest(const std::shared_ptr<ts::ecmgscs::StreamCloseRequest>& msg)
 {
     assert(msg != nullptr);
     if (_channel != msg->channel_id) {
@@ -558,7 +919,7 @@ bool ECMGClientHandler::handleStreamCloseRequest(const std::shared_ptr<ts::ecmgs
 }
 
 
-bool ECMGClientHandler::handleCWProvision(const std::shared_ptr<ts::ecmgscs::CWProvision>& msg)
+bool ECMGClientSession::handleCWProvision(const std::shared_ptr<ts::ecmgscs::CWProvision>& msg)
 {
     assert(msg != nullptr);
     if (_channel != msg->channel_id) {
@@ -573,82 +934,66 @@ bool ECMGClientHandler::handleCWProvision(const std::shared_ptr<ts::ecmgscs::CWP
         // Not the right number of CW in the request.
         return sendErrorResponse(msg, ts::ecmgscs::Errors::not_enough_CW);
     }
-    else {
-        // Start to build the response.
-        ts::ecmgscs::ECMResponse resp(_opt.ecmgscs);
-        resp.channel_id = msg->channel_id;
-        resp.stream_id = msg->stream_id;
-        resp.CP_number = msg->CP_number;
-
-        // Check if 16-bit crypto-period numbers wrap over 0xFFFF.
-        const uint16_t cp_max = msg->CP_number + _opt.channelStatus.lead_CW;
-        const bool cp_wrap = cp_max < msg->CP_number;
-
-        // Add all CW's in the ECM (in the clear, yeah, but that's a fake/test ECMG).
-        ts::duck::ClearECM ecm(_protocol);
-        for (auto it = msg->CP_CW_combination.begin(); it != msg->CP_CW_combination.end(); ++it) {
-            if ((!cp_wrap && (it->CP < msg->CP_number || it->CP > cp_max)) || (cp_wrap && it->CP > cp_max && it->CP < msg->CP_number)) {
-                // Incorrect CP/CW combination.
-                return sendErrorResponse(msg, ts::ecmgscs::Errors::not_enough_CW);
-            }
-            if ((it->CP & 0x01) == 0) {
-                ecm.cw_even = it->CW;
-            }
-            else {
-                ecm.cw_odd = it->CW;
-            }
-            // In debug mode, display if CW has reduced entropy.
-            _shared->report().debug(u"incoming CW entropy: %s", it->CW.size() == ts::DVBCSA2::KEY_SIZE && ts::DVBCSA2::IsReducedCW(it->CW.data()) ? u"reduced" : u"not reduced");
-        }
 
-        // Add optional access criteria in ECM.
-        if (msg->has_access_criteria) {
-            ecm.access_criteria = msg->access_criteria;
+    // Check if 16-bit crypto-period numbers wrap over 0xFFFF.
+    const uint16_t cp_max = msg->CP_number + _opt.channelStatus.lead_CW;
+    const bool cp_wrap = cp_max < msg->CP_number;
+    for (const auto& cpcw : msg->CP_CW_combination) {
+        if ((!cp_wrap && (cpcw.CP < msg->CP_number || cpcw.CP > cp_max)) || (cp_wrap && cpcw.CP > cp_max && cpcw.CP < msg->CP_number)) {
+            // Incorrect CP/CW combination.
+            return sendErrorResponse(msg, ts::ecmgscs::Errors::not_enough_CW);
         }
+    }
 
-        // Serialize the ECM section payload.
-        const auto ecm_bin = std::make_shared<ts::ByteBlock>();
-        ts::tlv::Serializer serial(ecm_bin);
-        ecm.serialize(serial);
-
-        // Compute the table id for the ECM, 0x80 or 0x81. There are two incompatible possibilities.
-        // First method is to copy the parity of the crypto period number. Second method is to
-        // alternate between the two, request after request in the stream. There is no requirement
-        // that the table id has the same parity as the CP. However, it is safe to do it just in
-        // case some CAS relies on it. On the other hand, if the SCS sends non-consecutive CP
-        // numbers, it is possible that two adjacent CP have the same parity. Anyway, since there
-        // is no perfect solution, we use the first one since it is simpler.
-        const ts::TID tid = ts::TID(ts::TID_ECM_80 | (msg->CP_number & 0x01));
-
-        // Build the ECM section.
-        const auto ecm_section = std::make_shared<ts::Section>(tid, true, ecm_bin->data(), ecm_bin->size());
-
-        // Format ECM for the response message.
-        if (_opt.channelStatus.section_TSpkt_flag) {
-            // Send ECM as TS packets, packetize the section.
-            ts::TSPacketVector ecm_packets;
-            ts::OneShotPacketizer zer(_opt.duck);
-            zer.addSection(ecm_section);
-            zer.getPackets(ecm_packets);
-            if (!ecm_packets.empty()) {
-                resp.ECM_datagram.copy(ecm_packets[0].b, ecm_packets.size() * ts::PKT_SIZE);
-            }
-        }
-        else {
-            // Send ECM as a section.
-            resp.ECM_datagram.copy(ecm_section->content(), ecm_section->size());
-        }
+    // Offload the ECM computation to the worker pool. The response is sent in handleECMComputed().
+    if (!_pool.submit(std::make_shared<ECMGRequest>(_opt, _session_id, msg))) {
+        return sendErrorResponse(msg, ts::ecmgscs::Errors::out_of_compute);
+    }
+    return true;
+}
 
-        // Emulate the computation time of a real ECMG.
-        if (_opt.ecmCompTime > cn::milliseconds::zero()) {
-            std::this_thread::sleep_for(_opt.ecmCompTime);
-        }
 
-        return send(resp);
+//----------------------------------------------------------------------------
+// Invoked when the ECM of a CW_provision is computed.
+//----------------------------------------------------------------------------
+
+void ECMGClientSession::handleECMComputed(const ECMGRequestPtr& req)
+{
+    // Drop the response if the stream was closed in the meantime.
+    if (_rclient.isOpen() && _channel == req->response.channel_id && _streams.count(req->response.stream_id) != 0) {
+        _latency.recordDuration<cn::microseconds>(ts::monotonic_time::clock::now() - req->received);
+        if (!send(req->response)) {
+            releaseChannel();
+            _rclient.startClose(nullptr, true);
+        }
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Factory of client sessions.
+//----------------------------------------------------------------------------
+
+class ECMGSessionFactory: public ts::ReactiveServerFactoryInterface
+{
+    TS_NOBUILD_NOCOPY(ECMGSessionFactory);
+public:
+    ECMGSessionFactory(const ECMGOptions& opt, ECMGSharedData& shared, ECMGWorkerPool& pool, ts::Reactor& reactor) :
+        _opt(opt), _shared(shared), _pool(pool), _reactor(reactor) {}
+
+    virtual ts::ReactiveServerSessionInterface* newClientSession() override
+    {
+        return new ECMGClientSession(_opt, _shared, _pool, _reactor);
+    }
+
+private:
+    const ECMGOptions& _opt;
+    ECMGSharedData&    _shared;
+    ECMGWorkerPool&    _pool;
+    ts::Reactor&       _reactor;
+};
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -660,12 +1005,20 @@ int MainCode(int argc, char *argv[])
     // Create ECMG shared data (including the asynchronous report).
     ECMGSharedData shared(opt);
 
-    // Initialize a TCP server.
-    ts::TCPServer server(&opt);
-    if (!server.open(opt.serverAddress.generation()) ||
-        !server.reusePort(opt.reusePort) ||
-        !server.bind(opt.serverAddress) ||
-        !server.listen(5))
+    // All client sessions are handled in one reactor, the ECM computations are offloaded to a pool of threads.
+    ts::Reactor           reactor(&shared.report());
+    ECMGWorkerPool        pool(opt, shared, reactor);
+    ECMGSessionFactory    factory(opt, shared, pool, reactor);
+    ts::TCPServer         tcp_server(&opt);
+    ts::ReactiveTCPServer rtcp_server(reactor, tcp_server);
+    ts::ReactiveServer    server(rtcp_server);
+
+    // Initialize the reactor and the TCP server.
+    if (!reactor.open() ||
+        !tcp_server.open(opt.serverAddress.generation()) ||
+        !tcp_server.reusePort(opt.reusePort) ||
+        !tcp_server.bind(opt.serverAddress) ||
+        !tcp_server.listen(LISTEN_BACKLOG))
     {
         return EXIT_FAILURE;
     }
@@ -677,30 +1030,15 @@ int MainCode(int argc, char *argv[])
     // the client disconnects, creating a SIGPIPE signal.
     ts::IgnorePipeSignal();
 
-    // Manage incoming client connections.
-    for (;;) {
-
-        // Accept one incoming connection.
-        ts::IPSocketAddress client_address;
-        ECMGConnectionPtr conn = std::make_shared<ECMGConnection>(shared.logger(), opt.ecmgscs, true, 3);
-        if (!server.accept(*conn, client_address)) {
-            break;
-        }
-
-        // Process the connection.
-        if (opt.once) {
-            // If --once is specified, run once in the context of the main thread and exit.
-            ECMGClientHandler client(opt, conn, &shared, false);
-            client.main();
-            break;
-        }
-        else {
-            // Otherwise, create a thread and forget about it.
-            // The thread will deallocate itself automatically when it completes.
-            ECMGClientHandler* client = new ECMGClientHandler(opt, conn, &shared, true);
-            client->start();
-        }
+    // With --once, the server exits at the end of the first client session.
+    if (opt.once) {
+        server.setExitAfterClientCount(1);
     }
+    server.setExitEventLoop(true);
 
-    return EXIT_SUCCESS;
+    // Manage incoming client connections until the server exits.
+    const bool ok = pool.start() && server.start(&factory) && reactor.processEventLoop();
+    pool.stop();
+    reactor.close();
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
 }
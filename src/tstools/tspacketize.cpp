@@ -191,6 +191,9 @@ int MainCode(int argc, char *argv[])
         pzer.display(std::cerr);
     }
 
+    // In continuous mode, static cycles are packetized once and replayed.
+    pzer.setPrecompiled(opt.continuous);
+
     // Generate packets
     ts::TSPacket pkt;
     ts::PacketCounter count = 0;
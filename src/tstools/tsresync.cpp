@@ -14,6 +14,7 @@
 #include "tsInputRedirector.h"
 #include "tsOutputRedirector.h"
 #include "tsByteBlock.h"
+#include "tsMemory.h"
 #include "tsTS.h"
 TS_MAIN(MainCode);
 
@@ -129,11 +130,12 @@ public:
     }
 
     // Look for MPEG packets in a buffer, according to an assumed packet size.
-    // If the complete buffer matches the packet size, set input and output packet
-    // sizes and return true. Return false otherwise.
-    bool checkSync(const uint8_t* buf, size_t buf_size, size_t pkt_size, size_t header_size);
+    // Packets must be found all along search_size bytes, starting at one of the
+    // start_count first positions in the buffer. If found, set input and output
+    // packet sizes and return the address of the first packet. Return nullptr otherwise.
+    const uint8_t* findSync(const uint8_t* buf, size_t start_count, size_t search_size, size_t pkt_size, size_t header_size);
 
-    // Get packet sizes, as determined by checkSync(). Size is zero if no valid packet size found.
+    // Get packet sizes, as determined by findSync(). Size is zero if no valid packet size found.
     size_t inputPacketSize() const {return _in_pkt_size;}
     size_t inputHeaderSize() const {return _in_header_size;}
     size_t outputPacketSize() const {return _out_pkt_size;}
@@ -224,25 +226,33 @@ bool Resynchronizer::writePacket(const uint8_t* input_packet)
 //  Look for MPEG packets in a buffer, according to an assumed packet size.
 //----------------------------------------------------------------------------
 
-bool Resynchronizer::checkSync(const uint8_t* buf, size_t buf_size, size_t pkt_size, size_t header_size)
+const uint8_t* Resynchronizer::findSync(const uint8_t* buf, size_t start_count, size_t search_size, size_t pkt_size, size_t header_size)
 {
     assert(pkt_size >= header_size + ts::PKT_SIZE);
-    const uint8_t* end = buf + buf_size - pkt_size + 1;
+    if (start_count == 0) {
+        return nullptr;
+    }
+
+    // Number of consecutive packets in the search area.
+    const size_t count = search_size / pkt_size;
+    const uint8_t* start = buf;
 
-    // Check if the buffer contains packets with the appropriate size
-    while (buf < end) {
-        if (buf[header_size] != ts::SYNC_BYTE) {
-            return false; // not found
+    // Check if the buffer contains packets with the appropriate size.
+    // The sync bytes are searched with vector instructions, when available.
+    if (count > 0) {
+        const uint8_t* sync = ts::LocateStridedByte(buf + header_size, start_count + (count - 1) * pkt_size, ts::SYNC_BYTE, pkt_size, count);
+        if (sync == nullptr) {
+            return nullptr; // not found
         }
-        buf += pkt_size;
+        start = sync - header_size;
     }
 
-    // Packets found all along the buffer
+    // Packets found all along the search area
     _in_pkt_size = pkt_size;
     _in_header_size = header_size;
     _out_pkt_size = _keep_packet_size ? pkt_size : ts::PKT_SIZE;
     _out_header_size = _keep_packet_size ? header_size : 0;
-    return true;
+    return start;
 }
 
 
@@ -286,27 +296,28 @@ int MainCode(int argc, char *argv[])
         uint8_t* const end_search = sync_end - search_size + 1;
 
         // Search a range of valid packets. Try all expected packet sizes.
-        const uint8_t* start;
-        for (start = sync_buf; start < end_search; start++) {
-            if (opt.packet_size > 0) {
-                if (resync.checkSync(start, search_size, opt.packet_size, opt.header_size)) {
-                    // Found user-specified encapsulation of TS packets
-                    break;
-                }
+        // With several candidate sizes, keep the first synchronization point in the buffer.
+        // On the same position, the packet sizes are tried in that order.
+        const uint8_t* start = end_search;
+        const uint8_t* found = nullptr;
+        if (opt.packet_size > 0) {
+            // Look for user-specified encapsulation of TS packets
+            if ((found = resync.findSync(sync_buf, start - sync_buf, search_size, opt.packet_size, opt.header_size)) != nullptr) {
+                start = found;
             }
-            else {
-                if (resync.checkSync(start, search_size, ts::PKT_SIZE, 0)) {
-                    // Found standard TS packets
-                    break;
-                }
-                if (resync.checkSync(start, search_size, ts::PKT_RS_SIZE, 0)) {
-                    // Found TS packets with trailing Reed-Solomon outer FEC
-                    break;
-                }
-                if (resync.checkSync(start, search_size, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE)) {
-                    // Found TS packets with leading 4-byte timestamp (M2TS format, blu-ray discs)
-                    break;
-                }
+        }
+        else {
+            // Look for standard TS packets
+            if ((found = resync.findSync(sync_buf, start - sync_buf, search_size, ts::PKT_SIZE, 0)) != nullptr) {
+                start = found;
+            }
+            // Look for TS packets with trailing Reed-Solomon outer FEC
+            if ((found = resync.findSync(sync_buf, start - sync_buf, search_size, ts::PKT_RS_SIZE, 0)) != nullptr) {
+                start = found;
+            }
+            // Look for TS packets with leading 4-byte timestamp (M2TS format, blu-ray discs)
+            if ((found = resync.findSync(sync_buf, start - sync_buf, search_size, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE)) != nullptr) {
+                start = found;
             }
         }
         if (resync.inputPacketSize() == 0) {
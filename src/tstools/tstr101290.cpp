@@ -0,0 +1,291 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  Monitor many UDP transport streams according to ETSI TR 101 290.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsAsyncReport.h"
+#include "tsUDPReceiver.h"
+#include "tsUDPReceiverArgsList.h"
+#include "tsReactor.h"
+#include "tsReactiveUDPSocket.h"
+#include "tstr101290MultiStreamAnalyzer.h"
+#include "tsjsonObject.h"
+#include "tsFileUtils.h"
+TS_MAIN(MainCode);
+
+namespace {
+    // Default interval between two status reports.
+    constexpr cn::seconds DEFAULT_INTERVAL = cn::seconds(10);
+}
+
+
+//----------------------------------------------------------------------------
+// Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class MonitorOptions: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(MonitorOptions);
+    public:
+        MonitorOptions(int argc, char *argv[]);
+
+        ts::AsyncReportArgs     logArgs {};     // Options for asynchronous log.
+        ts::UDPReceiverArgsList inputs {};      // All UDP inputs.
+        size_t                  threads = 0;    // Number of analysis threads.
+        size_t                  maxPending = 0; // Max number of packets waiting for analysis per stream.
+        cn::seconds             interval {};    // Interval between status reports.
+        cn::seconds             duration {};    // Monitoring duration, zero means infinite.
+        fs::path                jsonFile {};    // Output JSON file.
+    };
+}
+
+MonitorOptions::MonitorOptions(int argc, char *argv[]) :
+    ts::Args(u"Monitor many UDP transport streams according to ETSI TR 101 290", u"[options] [address:]port ...")
+{
+    logArgs.defineArgs(*this);
+    inputs.defineArgs(*this, true, true, true);
+
+    option<cn::seconds>(u"duration");
+    help(u"duration",
+         u"Stop monitoring after the specified number of seconds. "
+         u"By default, monitor until the command is interrupted.");
+
+    option<cn::seconds>(u"interval", 'i');
+    help(u"interval",
+         u"Specify the interval between two status reports. "
+         u"Default: " + ts::UString::Chrono(DEFAULT_INTERVAL, true) + u".");
+
+    option(u"json-output", 'j', FILENAME);
+    help(u"json-output", u"filename",
+         u"At each status report, save the TR 101 290 error counters of all streams in the specified JSON file. "
+         u"The file is atomically replaced, a dashboard can read it at any time. "
+         u"By default, only the total number of errors is reported in verbose mode.");
+
+    option(u"max-pending", 0, POSITIVE);
+    help(u"max-pending",
+         u"Specify the maximum number of TS packets per stream which are waiting for analysis. "
+         u"Above this limit, the incoming packets are dropped and counted. "
+         u"This limits the memory which is used per stream. "
+         u"Default: " + ts::UString::Decimal(ts::tr101290::MultiStreamAnalyzer::DEFAULT_MAX_PENDING) + u".");
+
+    option(u"threads", 0, POSITIVE);
+    help(u"threads",
+         u"Specify the number of analysis threads. All UDP inputs are received by one single thread "
+         u"but the streams are analyzed in a pool of worker threads. All packets of a stream are "
+         u"analyzed in the same thread. By default, use one thread per CPU core.");
+
+    analyze(argc, argv);
+
+    logArgs.loadArgs(*this);
+    inputs.loadArgs(*this);
+    getIntValue(threads, u"threads", 0);
+    getIntValue(maxPending, u"max-pending", ts::tr101290::MultiStreamAnalyzer::DEFAULT_MAX_PENDING);
+    getChronoValue(interval, u"interval", DEFAULT_INTERVAL);
+    getChronoValue(duration, u"duration");
+    getPathValue(jsonFile, u"json-output");
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+// The monitor, in the reactor thread.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Monitor: private ts::ReactorHandlerInterface, private ts::ReactiveUDPHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Monitor);
+    public:
+        Monitor(const MonitorOptions& opt, ts::Report& report);
+        bool run();
+
+    private:
+        // One UDP input.
+        class Input
+        {
+            TS_NOBUILD_NOCOPY(Input);
+        public:
+            Input(ts::Reactor& reactor, ts::Report& report, size_t idx) : index(idx), socket(&report), rsocket(reactor, socket) {}
+            size_t                index;
+            ts::UDPReceiver       socket;
+            ts::ReactiveUDPSocket rsocket;
+            size_t                packet_size = ts::PKT_SIZE;
+        };
+
+        const MonitorOptions&                _opt;
+        ts::Report&                          _report;
+        ts::Reactor                          _reactor {&_report};
+        ts::tr101290::MultiStreamAnalyzer    _analyzer {_report};
+        std::map<ts::ReactiveUDPSocket*, std::shared_ptr<Input>> _inputs {};
+        ts::TSPacketVector                   _packets {};
+        ts::EventId                          _report_timer {};
+        ts::EventId                          _end_timer {};
+        size_t                               _open_count = 0;
+
+        // Save or report the status of all streams.
+        void reportStatus();
+
+        // Reactor handlers.
+        virtual void handleTimer(ts::Reactor& reactor, ts::EventId id) override;
+        virtual void handleUDPClosed(ts::ReactiveUDPSocket& sock, const ts::ObjectPtr& user_data) override;
+        virtual void handleUDPReceive(ts::ReactiveUDPSocket& sock,
+                                      const ts::ByteBlockPtr& data,
+                                      const ts::IPSocketAddress& sender,
+                                      const ts::IPSocketAddress& destination,
+                                      cn::microseconds timestamp,
+                                      ts::UDPSocket::TimeStampType timestamp_type,
+                                      int error_code,
+                                      const ts::ObjectPtr& user_data) override;
+    };
+}
+
+// Constructor.
+Monitor::Monitor(const MonitorOptions& opt, ts::Report& report) :
+    _opt(opt),
+    _report(report)
+{
+    _analyzer.setThreadCount(_opt.threads);
+    _analyzer.setMaxPendingPackets(_opt.maxPending);
+}
+
+// Run the monitoring session.
+bool Monitor::run()
+{
+    if (!_reactor.open()) {
+        return false;
+    }
+
+    // Open all UDP inputs. The reactive socket must be initialized before opening the socket.
+    bool ok = true;
+    for (size_t i = 0; ok && i < _opt.inputs.size(); ++i) {
+        auto input = std::make_shared<Input>(_reactor, _report, i);
+        input->socket.setParameters(_opt.inputs[i]);
+        _inputs[&input->rsocket] = input;
+        ok = _analyzer.addStream(_opt.inputs[i].destination.toString()) == i &&
+             input->socket.open() &&
+             input->rsocket.startReceive(this);
+        if (ok) {
+            _open_count++;
+        }
+    }
+
+    // Start the analysis and the timers.
+    ok = ok && _analyzer.start();
+    if (ok) {
+        _report.verbose(u"monitoring %d streams", _inputs.size());
+        _report_timer = _reactor.newTimer(this, _opt.interval, true);
+        if (_opt.duration > cn::seconds::zero()) {
+            _end_timer = _reactor.newTimer(this, _opt.duration, false);
+        }
+        ok = _reactor.processEventLoop();
+    }
+
+    // Final status report, after analyzing all pending packets.
+    _analyzer.stop();
+    if (ok) {
+        reportStatus();
+    }
+    for (const auto& it : _inputs) {
+        if (it.second->socket.isOpen()) {
+            it.second->socket.close(true);
+        }
+    }
+    _reactor.close();
+    return ok;
+}
+
+// Save or report the status of all streams.
+void Monitor::reportStatus()
+{
+    ts::json::Object root;
+    _analyzer.getStatus(root);
+    _report.verbose(u"total: %'d packets, %'d dropped, %'d errors",
+                    root.value(u"total").value(u"packets").toInteger(),
+                    root.value(u"total").value(u"dropped").toInteger(),
+                    root.value(u"total").value(u"errors").toInteger());
+
+    // Atomically replace the JSON file: write a temporary file, then rename it.
+    if (!_opt.jsonFile.empty()) {
+        fs::path tmp(_opt.jsonFile);
+        tmp += u".tmp";
+        if (root.save(tmp, 2, false, _report)) {
+            fs::rename(tmp, _opt.jsonFile, &ts::ErrCodeReport(_report, u"error renaming", tmp));
+        }
+    }
+}
+
+// Reactor handler: timers.
+void Monitor::handleTimer(ts::Reactor& reactor, ts::EventId id)
+{
+    if (id == _report_timer) {
+        reportStatus();
+    }
+    else if (id == _end_timer) {
+        // End of monitoring, close all sockets. The event loop exits when they are all closed.
+        _reactor.cancelTimer(_report_timer);
+        for (const auto& it : _inputs) {
+            it.second->rsocket.startClose(this, true);
+        }
+    }
+}
+
+// Reactor handler: socket closed.
+void Monitor::handleUDPClosed(ts::ReactiveUDPSocket& sock, const ts::ObjectPtr& user_data)
+{
+    if (_open_count > 0 && --_open_count == 0) {
+        _reactor.exitEventLoop();
+    }
+}
+
+// Reactor handler: datagram received.
+void Monitor::handleUDPReceive(ts::ReactiveUDPSocket& sock,
+                               const ts::ByteBlockPtr& data,
+                               const ts::IPSocketAddress& sender,
+                               const ts::IPSocketAddress& destination,
+                               cn::microseconds timestamp,
+                               ts::UDPSocket::TimeStampType timestamp_type,
+                               int error_code,
+                               const ts::ObjectPtr& user_data)
+{
+    const auto it = _inputs.find(&sock);
+    if (error_code != ts::SYS_SUCCESS || data == nullptr || it == _inputs.end()) {
+        return;
+    }
+    Input& input(*it->second);
+
+    // Locate the TS packets in the datagram (possibly after an RTP header).
+    size_t start = 0;
+    size_t count = 0;
+    if (ts::TSPacket::Locate(data->data(), data->size(), start, count, input.packet_size)) {
+        // The same monotonic timestamp is used for all packets in the datagram.
+        const ts::PCR now(cn::duration_cast<ts::PCR>(ts::monotonic_time::clock::now().time_since_epoch()));
+        _packets.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            _packets[i].copyFrom(data->data() + start + i * input.packet_size);
+        }
+        _analyzer.feedPackets(input.index, now, _packets.data(), count);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    MonitorOptions opt(argc, argv);
+    ts::AsyncReport report(opt.maxSeverity(), opt.logArgs);
+    Monitor monitor(opt, report);
+    return monitor.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
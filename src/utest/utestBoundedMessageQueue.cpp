@@ -0,0 +1,274 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::BoundedMessageQueue
+//
+//----------------------------------------------------------------------------
+
+#include "tsBoundedMessageQueue.h"
+#include "tsBoundedMessagePriorityQueue.h"
+#include "tsMessageQueue.h"
+#include "tsunit.h"
+#include "utestTSUnitBenchmark.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class BoundedMessageQueueTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Constructor);
+    TSUNIT_DECLARE_TEST(Queue);
+    TSUNIT_DECLARE_TEST(Timeout);
+    TSUNIT_DECLARE_TEST(Threads);
+    TSUNIT_DECLARE_TEST(PriorityQueue);
+    TSUNIT_DECLARE_TEST(Contention);
+};
+
+TSUNIT_REGISTER(BoundedMessageQueueTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+using TestQueue = ts::BoundedMessageQueue<int>;
+
+TSUNIT_DEFINE_TEST(Constructor)
+{
+    TestQueue queue1;
+    TestQueue queue2(10);
+    TestQueue queue3(0);
+
+    TSUNIT_EQUAL(TestQueue::DEFAULT_MAX_MESSAGES, queue1.getMaxMessages());
+    TSUNIT_EQUAL(10, queue2.getMaxMessages());
+    TSUNIT_EQUAL(TestQueue::DEFAULT_MAX_MESSAGES, queue3.getMaxMessages());
+
+    queue1.setMaxMessages(27);
+    TSUNIT_EQUAL(27, queue1.getMaxMessages());
+    TSUNIT_EQUAL(0, queue1.size());
+}
+
+TSUNIT_DEFINE_TEST(Queue)
+{
+    TestQueue queue(5);
+    int msg = 0;
+
+    for (int i = 0; i < 5; ++i) {
+        TSUNIT_ASSERT(queue.enqueue(i, cn::milliseconds::zero()));
+    }
+    TSUNIT_EQUAL(5, queue.size());
+    TSUNIT_ASSERT(!queue.enqueue(5, cn::milliseconds::zero()));
+
+    // Forced messages use the reserved slots.
+    for (size_t i = 0; i < TestQueue::RESERVED_MESSAGES; ++i) {
+        queue.forceEnqueue(int(100 + i));
+    }
+    TSUNIT_EQUAL(5 + TestQueue::RESERVED_MESSAGES, queue.size());
+
+    for (int i = 0; i < 5; ++i) {
+        TSUNIT_ASSERT(queue.dequeue(msg, cn::milliseconds::zero()));
+        TSUNIT_EQUAL(i, msg);
+    }
+    for (size_t i = 0; i < TestQueue::RESERVED_MESSAGES; ++i) {
+        queue.dequeue(msg);
+        TSUNIT_EQUAL(int(100 + i), msg);
+    }
+    TSUNIT_ASSERT(!queue.dequeue(msg, cn::milliseconds::zero()));
+
+    // Several rounds over the ring.
+    for (int i = 0; i < 100; ++i) {
+        queue.enqueue(i);
+        queue.enqueue(i + 1000);
+        queue.dequeue(msg);
+        TSUNIT_EQUAL(i, msg);
+        queue.dequeue(msg);
+        TSUNIT_EQUAL(i + 1000, msg);
+    }
+
+    queue.enqueue(1);
+    queue.enqueue(2);
+    queue.clear();
+    TSUNIT_EQUAL(0, queue.size());
+    TSUNIT_ASSERT(!queue.dequeue(msg, cn::milliseconds::zero()));
+}
+
+TSUNIT_DEFINE_TEST(Timeout)
+{
+    ts::BoundedMessageQueue<ts::UString> queue(1);
+    ts::UString msg;
+
+    TSUNIT_ASSERT(!queue.dequeue(msg, cn::milliseconds(20)));
+    TSUNIT_ASSERT(queue.enqueue(u"foo", cn::milliseconds(20)));
+    TSUNIT_ASSERT(!queue.enqueue(u"bar", cn::milliseconds(20)));
+
+    // Move semantics: the message is moved on success only.
+    ts::UString bar(u"bar");
+    TSUNIT_ASSERT(!queue.enqueue(std::move(bar), cn::milliseconds::zero()));
+    TSUNIT_EQUAL(u"bar", bar);
+
+    // A consumer thread unblocks the producer.
+    std::thread consumer([&queue]() {
+        ts::UString m;
+        std::this_thread::sleep_for(cn::milliseconds(50));
+        queue.dequeue(m);
+    });
+    TSUNIT_ASSERT(queue.enqueue(std::move(bar), cn::milliseconds(10000)));
+    consumer.join();
+
+    TSUNIT_ASSERT(queue.dequeue(msg, cn::milliseconds::zero()));
+    TSUNIT_EQUAL(u"bar", msg);
+}
+
+TSUNIT_DEFINE_TEST(Threads)
+{
+    // Several producers and consumers, check that all messages are received once.
+    constexpr int PRODUCERS = 4;
+    constexpr int CONSUMERS = 3;
+    constexpr int COUNT = 20000;
+
+    TestQueue queue(16);
+    std::atomic<int64_t> sum = 0;
+    std::atomic<int> received = 0;
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < CONSUMERS; ++c) {
+        threads.emplace_back([&]() {
+            int msg = 0;
+            for (;;) {
+                queue.dequeue(msg);
+                if (msg < 0) {
+                    break;
+                }
+                sum += msg;
+                received++;
+            }
+        });
+    }
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&queue, p]() {
+            for (int i = 1; i <= COUNT; ++i) {
+                if ((i % 2) == 0) {
+                    queue.enqueue(i);
+                }
+                else {
+                    while (!queue.enqueue(i, cn::milliseconds(p)));
+                }
+            }
+        });
+    }
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads[CONSUMERS + p].join();
+    }
+    for (int c = 0; c < CONSUMERS; ++c) {
+        queue.forceEnqueue(-1);
+    }
+    for (int c = 0; c < CONSUMERS; ++c) {
+        threads[c].join();
+    }
+
+    TSUNIT_EQUAL(PRODUCERS * COUNT, received.load());
+    TSUNIT_EQUAL(int64_t(PRODUCERS) * COUNT * (COUNT + 1) / 2, sum.load());
+}
+
+TSUNIT_DEFINE_TEST(PriorityQueue)
+{
+    struct Message
+    {
+        int a = 0;
+        int b = 0;
+        bool operator<(const Message& other) const { return a < other.a; }
+    };
+
+    using Queue = ts::BoundedMessagePriorityQueue<Message>;
+    Queue queue(8);
+    Message msg;
+
+    // Same order as ts::MessagePriorityQueue.
+    TSUNIT_ASSERT(queue.enqueue(Message{1, 1}, cn::milliseconds::zero()));
+    TSUNIT_ASSERT(queue.enqueue(Message{5, 2}, cn::milliseconds::zero()));
+    TSUNIT_ASSERT(queue.enqueue(Message{2, 3}, cn::milliseconds::zero()));
+    TSUNIT_ASSERT(queue.enqueue(Message{6, 4}, cn::milliseconds::zero()));
+    TSUNIT_ASSERT(queue.enqueue(Message{3, 5}, cn::milliseconds::zero()));
+    TSUNIT_ASSERT(queue.enqueue(Message{2, 6}, cn::milliseconds::zero()));
+    TSUNIT_ASSERT(queue.enqueue(Message{0, 7}, cn::milliseconds::zero()));
+    TSUNIT_ASSERT(queue.enqueue(Message{0, 8}, cn::milliseconds::zero()));
+    TSUNIT_ASSERT(!queue.enqueue(Message{0, 9}, cn::milliseconds::zero()));
+    TSUNIT_EQUAL(8, queue.size());
+
+    static const int expected[][2] = {{0, 7}, {0, 8}, {1, 1}, {2, 3}, {2, 6}, {3, 5}, {5, 2}, {6, 4}};
+    for (const auto& exp : expected) {
+        TSUNIT_ASSERT(queue.dequeue(msg, cn::milliseconds::zero()));
+        TSUNIT_EQUAL(exp[0], msg.a);
+        TSUNIT_EQUAL(exp[1], msg.b);
+    }
+    TSUNIT_ASSERT(!queue.dequeue(msg, cn::milliseconds::zero()));
+
+    queue.enqueue(Message{4, 10});
+    queue.forceEnqueue(Message{4, 11});
+    queue.dequeue(msg);
+    TSUNIT_EQUAL(10, msg.b);
+    queue.clear();
+    TSUNIT_EQUAL(0, queue.size());
+}
+
+
+//----------------------------------------------------------------------------
+// Contention benchmark, compared with ts::MessageQueue.
+// Set TSUNIT_MSGQUEUE_ITERATIONS to the number of messages per producer.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Run producers and one consumer, return the elapsed time.
+    template <class ENQUEUE, class DEQUEUE>
+    cn::microseconds RunContention(int producers, size_t count, ENQUEUE enqueue, DEQUEUE dequeue)
+    {
+        const ts::monotonic_time start = ts::monotonic_time::clock::now();
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([count, &enqueue]() {
+                for (size_t i = 0; i < count; ++i) {
+                    enqueue(int(i));
+                }
+            });
+        }
+        for (size_t i = 0; i < producers * count; ++i) {
+            dequeue();
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        return cn::duration_cast<cn::microseconds>(ts::monotonic_time::clock::now() - start);
+    }
+}
+
+TSUNIT_DEFINE_TEST(Contention)
+{
+    utest::TSUnitBenchmark bench(u"TSUNIT_MSGQUEUE_ITERATIONS");
+    const size_t count = std::max<size_t>(bench.iterations, 1000);
+
+    for (int producers = 1; producers <= 4; producers *= 2) {
+        ts::MessageQueue<int> list_queue(256);
+        ts::MessageQueue<int>::MessagePtr list_msg;
+        const cn::microseconds list_time = RunContention(producers, count,
+            [&list_queue](int i) { list_queue.enqueue(new int(i)); },
+            [&list_queue, &list_msg]() { list_queue.dequeue(list_msg); });
+
+        ts::BoundedMessageQueue<int> ring_queue(256);
+        int ring_msg = 0;
+        const cn::microseconds ring_time = RunContention(producers, count,
+            [&ring_queue](int i) { ring_queue.enqueue(i); },
+            [&ring_queue, &ring_msg]() { ring_queue.dequeue(ring_msg); });
+
+        TSUNIT_EQUAL(0, ring_queue.size());
+        debug() << ts::UString::Format(u"BoundedMessageQueueTest: %d producers, %'d messages each, MessageQueue: %'d us, BoundedMessageQueue: %'d us",
+                                       producers, count, list_time.count(), ring_time.count())
+                << std::endl;
+    }
+}
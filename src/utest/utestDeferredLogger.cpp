@@ -0,0 +1,225 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::DeferredLogger
+//
+//----------------------------------------------------------------------------
+
+#include "tsDeferredLogger.h"
+#include "tsReportBuffer.h"
+#include "tsCerrReport.h"
+#include "tsErrCodeReport.h"
+#include "tsFileUtils.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class DeferredLoggerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Format);
+    TSUNIT_DECLARE_TEST(Fallback);
+    TSUNIT_DECLARE_TEST(Report);
+    TSUNIT_DECLARE_TEST(File);
+    TSUNIT_DECLARE_TEST(Rotation);
+
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+private:
+    ts::UString _temp_prefix {};
+    void cleanup();
+};
+
+TSUNIT_REGISTER(DeferredLoggerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+void DeferredLoggerTest::beforeTest()
+{
+    if (_temp_prefix.empty()) {
+        _temp_prefix = ts::UString(ts::TempFile(u"")) + u"-log";
+    }
+    cleanup();
+}
+
+void DeferredLoggerTest::afterTest()
+{
+    cleanup();
+}
+
+void DeferredLoggerTest::cleanup()
+{
+    fs::remove(_temp_prefix + u".log", &ts::ErrCodeReport());
+    for (int i = 0; i < 10; ++i) {
+        fs::remove(ts::UString::Format(u"%s-%06d.log", _temp_prefix, i), &ts::ErrCodeReport());
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    enum class Color : uint8_t {RED = 1, GREEN = 2};
+
+    template <class... Args>
+    ts::UString Deferred(const ts::UChar* fmt, Args&&... args)
+    {
+        ts::DeferredLogger::Line line;
+        line.format(fmt, std::forward<Args>(args)...);
+        return line.toString();
+    }
+}
+
+#define CHECK_FORMAT(...) TSUNIT_EQUAL(ts::UString::Format(__VA_ARGS__), Deferred(__VA_ARGS__))
+
+TSUNIT_DEFINE_TEST(Format)
+{
+    const ts::UString us(u"abc");
+    const std::string s("def");
+
+    CHECK_FORMAT(u"no argument");
+    CHECK_FORMAT(u"%d %d %d %d", int8_t(-2), uint8_t(200), int16_t(-1000), uint16_t(50000));
+    CHECK_FORMAT(u"%d %d %'d %'d", int32_t(-7), uint32_t(4000000000), int64_t(-123456789012), uint64_t(0xFFFFFFFFFFFFFFFF));
+    CHECK_FORMAT(u"%X %X %X %X", uint8_t(5), int16_t(-5), uint32_t(0x1234), int64_t(-1));
+    CHECK_FORMAT(u"PID %n, service %n, %n", uint16_t(0x100), uint16_t(27), 1234);
+    CHECK_FORMAT(u"%d %s %s", Color::GREEN, true, false);
+    CHECK_FORMAT(u"%f %.3f %10.2f", 3.5, -0.125, 2.0f);
+    CHECK_FORMAT(u"[%s] [%-6s] [%6s] [%s] [%s]", us, s, u"ghi", "jkl", ts::UString());
+    CHECK_FORMAT(u"%s %d", 12, u"string");
+    CHECK_FORMAT(u"%d %d", 1, 2, 3, 4);
+    CHECK_FORMAT(u"%d %d", 1);
+    CHECK_FORMAT(u"%c%c", ts::UChar(u'x'), 'y');
+
+    // Several segments.
+    ts::DeferredLogger::Line line;
+    line.format(u"%s%d: ", u"tag: ", 12345).format(u"PID %n, %s", uint16_t(0x1FFF), us);
+    TSUNIT_EQUAL(u"tag: 12345: PID 0x1FFF (8191), abc", line.toString());
+}
+
+TSUNIT_DEFINE_TEST(Fallback)
+{
+    // Arguments which cannot be captured are formatted immediately.
+    const ts::UString long_string(ts::DeferredLogger::MAX_CHARS, u'x');
+    const std::string utf8("d\xC3\xA9j\xC3\xA0");
+    const ts::UString with_nul(u"a\0b", 3);
+
+    CHECK_FORMAT(u"%s/%d", long_string, 5);
+    CHECK_FORMAT(u"%s", utf8);
+    CHECK_FORMAT(u"%s", with_nul);
+    CHECK_FORMAT(u"%s, %s", cn::milliseconds(1500), 1);
+    CHECK_FORMAT(u"%d %d %d %d %d %d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14);
+
+    // More segments than the record can store.
+    ts::DeferredLogger::Line line;
+    ts::UString expected;
+    for (int i = 0; i < int(2 * ts::DeferredLogger::MAX_SEGMENTS + 1); ++i) {
+        line.format(u"<%d>", i);
+        if (i == 3) {
+            line.format(u"(%s)", long_string);
+        }
+        expected.format(u"<%d>", i);
+        if (i == 3) {
+            expected.format(u"(%s)", long_string);
+        }
+    }
+    TSUNIT_EQUAL(expected, line.toString());
+}
+
+TSUNIT_DEFINE_TEST(Report)
+{
+    ts::ReportBuffer<ts::ThreadSafety::Full> rep(ts::Severity::Debug);
+    {
+        ts::DeferredLogger logger(rep, 4);
+        logger.log(ts::Severity::Info, u"ignored, not open");
+        TSUNIT_ASSERT(logger.open());
+        TSUNIT_ASSERT(logger.isOpen());
+        for (int i = 0; i < 20; ++i) {
+            logger.log(ts::Severity::Info, u"line %d, PID %n", i, uint16_t(i + 0x100));
+        }
+        logger.log(ts::Severity::Warning, u"last %s", u"line");
+        logger.flush();
+        TSUNIT_ASSERT(rep.messages().contains(u"line 19, PID 0x0113 (275)"));
+    }
+
+    ts::UString expected;
+    for (int i = 0; i < 20; ++i) {
+        expected.format(u"line %d, PID %n\n", i, uint16_t(i + 0x100));
+    }
+    expected.append(u"Warning: last line");
+    TSUNIT_EQUAL(expected, rep.messages());
+}
+
+TSUNIT_DEFINE_TEST(File)
+{
+    constexpr int THREADS = 3;
+    constexpr int COUNT = 2000;
+    const fs::path file_name(_temp_prefix + u".log");
+
+    ts::DeferredLogger logger(CERR, 16);
+    TSUNIT_ASSERT(logger.open(file_name));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&logger, t]() {
+            for (int i = 0; i < COUNT; ++i) {
+                ts::DeferredLogger::Line line;
+                line.format(u"thread %d: ", t).format(u"line %'d, %s", i, i % 2 == 0 ? u"even" : u"odd");
+                logger.log(std::move(line));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    logger.close();
+    TSUNIT_ASSERT(!logger.isOpen());
+
+    // Check that the lines of each thread are all present, in order.
+    ts::UStringList lines;
+    TSUNIT_ASSERT(ts::UString::Load(lines, file_name));
+    TSUNIT_EQUAL(size_t(THREADS * COUNT), lines.size());
+    int next[THREADS] {};
+    for (const auto& l : lines) {
+        int t = 0;
+        TSUNIT_ASSERT(l.size() > 8 && l.substr(7, 1).toInteger(t) && t >= 0 && t < THREADS);
+        TSUNIT_EQUAL(ts::UString::Format(u"thread %d: line %'d, %s", t, next[t], next[t] % 2 == 0 ? u"even" : u"odd"), l);
+        next[t]++;
+    }
+}
+
+TSUNIT_DEFINE_TEST(Rotation)
+{
+    const fs::path file_name(_temp_prefix + u".log");
+    ts::DeferredLogger logger(CERR);
+
+    // Lines are 10 bytes long (9 characters + new line), files are closed after 10 lines.
+    TSUNIT_ASSERT(logger.open(file_name, 100, 3));
+    for (int i = 0; i < 45; ++i) {
+        logger.log(ts::Severity::Info, u"line %04d", i);
+    }
+    logger.close();
+
+    TSUNIT_ASSERT(!fs::exists(file_name));
+    TSUNIT_ASSERT(!fs::exists(ts::UString::Format(u"%s-%06d.log", _temp_prefix, 0)));
+    TSUNIT_ASSERT(!fs::exists(ts::UString::Format(u"%s-%06d.log", _temp_prefix, 1)));
+    for (int file = 2; file <= 4; ++file) {
+        ts::UStringList lines;
+        TSUNIT_ASSERT(ts::UString::Load(lines, ts::UString::Format(u"%s-%06d.log", _temp_prefix, file)));
+        TSUNIT_EQUAL(file < 4 ? 10 : 5, lines.size());
+        TSUNIT_EQUAL(ts::UString::Format(u"line %04d", 10 * file), lines.front());
+    }
+}
@@ -179,12 +179,24 @@ void DemuxTest::testTable(const char* name, const uint8_t* ref_packets, size_t r
 
     const ts::TSPacket* ref_pkt = reinterpret_cast<const ts::TSPacket*>(ref_packets);
     ts::StandaloneTableDemux demux(duck, ts::AllPIDs());
+    const bool counters_enabled = ts::AbstractDemux::CountersEnabled();
+    ts::AbstractDemux::EnableCounters();
+    const ts::AbstractDemux::Counters counters0(ts::AbstractDemux::CurrentThreadCounters());
 
     for (size_t pi = 0; pi < ref_packets_size / ts::PKT_SIZE; ++pi) {
         demux.feedPacket(ref_pkt[pi]);
     }
+    ts::AbstractDemux::EnableCounters(counters_enabled);
     TSUNIT_EQUAL(1, demux.tableCount());
 
+    // Check the reassembly counters of the thread.
+    const ts::AbstractDemux::Counters counters(ts::AbstractDemux::CurrentThreadCounters() - counters0);
+    TSUNIT_EQUAL(ref_packets_size / ts::PKT_SIZE, counters.packets);
+    TSUNIT_EQUAL(1, counters.tables);
+    TSUNIT_ASSERT(counters.sections >= demux.tableAt(0)->sectionCount());
+    TSUNIT_EQUAL(0, counters.pes_packets);
+    TSUNIT_EQUAL(0, counters.invalid);
+
     // Compare contents of reference sections and demuxed sections.
 
     const ts::BinaryTable& table1(*demux.tableAt(0));
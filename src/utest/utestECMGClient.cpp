@@ -0,0 +1,218 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::ECMGClient.
+//
+//----------------------------------------------------------------------------
+
+#include "tsECMGClient.h"
+#include "tsECMGClientArgs.h"
+#include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "utestFakeECMG.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class ECMGClientTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(MultiStream);
+    TSUNIT_DECLARE_TEST(AsyncMultiStream);
+    TSUNIT_DECLARE_TEST(DisconnectFailedStream);
+};
+
+TSUNIT_REGISTER(ECMGClientTest);
+
+
+//----------------------------------------------------------------------------
+// Common definitions.
+//----------------------------------------------------------------------------
+
+namespace {
+    constexpr uint16_t ECMG_PORT = 12347;
+
+    // Expected errors are displayed in debug mode only.
+    ts::Report& ClientReport()
+    {
+        return tsunit::Test::debugMode() ? static_cast<ts::Report&>(CERR) : static_cast<ts::Report&>(NULLREP);
+    }
+
+    ts::ECMGClientArgs ClientArgs()
+    {
+        ts::ECMGClientArgs args;
+        args.ecmg_address = ts::IPSocketAddress(ts::IPAddress::LocalHost4, ECMG_PORT);
+        args.super_cas_id = 0x12340000;
+        args.cp_duration = ts::deciseconds(100);
+        args.ecm_channel_id = 1;
+        args.ecm_stream_id = 1;
+        args.ecm_id = 1;
+        return args;
+    }
+
+    // Synchronously generate one ECM and check which stream it belongs to.
+    void CheckECM(ts::ECMGClient& client, uint16_t stream_id, uint16_t cp_number)
+    {
+        const ts::ByteBlock cw1(8, 0x11);
+        const ts::ByteBlock cw2(8, 0x22);
+        ts::ecmgscs::Protocol protocol;
+        ts::ecmgscs::ECMResponse response(protocol);
+        TSUNIT_ASSERT(client.generateECM(stream_id, cp_number, cw1, cw2, ts::ByteBlock(), ts::deciseconds(100), response));
+        TSUNIT_EQUAL(stream_id, response.stream_id);
+        TSUNIT_EQUAL(cp_number, response.CP_number);
+        const ts::Section ecm(response.ECM_datagram);
+        TSUNIT_ASSERT(ecm.isValid());
+        TSUNIT_EQUAL(utest::FakeECMG::ECM_TID, ecm.tableId());
+        TSUNIT_EQUAL(stream_id, utest::FakeECMG::StreamIdOf(ecm));
+    }
+
+    // Asynchronous ECM handler.
+    class ECMHandler: public ts::ECMGClientHandlerInterface
+    {
+        TS_NOCOPY(ECMHandler);
+    public:
+        ECMHandler() = default;
+        bool wait(size_t count);
+        std::map<uint16_t, uint16_t> received {};  // Last CP_number, indexed by ECM_stream_id.
+    private:
+        std::mutex _mutex {};
+        std::condition_variable _cond {};
+        size_t _count = 0;
+        virtual void handleECM(const ts::ecmgscs::ECMResponse& response) override;
+    };
+
+    void ECMHandler::handleECM(const ts::ecmgscs::ECMResponse& response)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        const ts::Section ecm(response.ECM_datagram);
+        if (ecm.isValid() && utest::FakeECMG::StreamIdOf(ecm) == response.stream_id) {
+            received[response.stream_id] = response.CP_number;
+        }
+        _count++;
+        _cond.notify_all();
+    }
+
+    bool ECMHandler::wait(size_t count)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _cond.wait_for(lock, cn::seconds(5), [this, count]() { return _count >= count; });
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(MultiStream)
+{
+    utest::FakeECMG ecmg(ECMG_PORT);
+    TSUNIT_ASSERT(ecmg.listen());
+    ecmg.start();
+
+    const ts::ecmgscs::Protocol protocol;
+    ts::tlv::Logger logger(ClientReport(), ts::Severity::Debug);
+    ts::ECMGClient client(logger, protocol);
+    ts::ecmgscs::ChannelStatus channel_status(protocol);
+    ts::ecmgscs::StreamStatus stream_status(protocol);
+
+    TSUNIT_ASSERT(client.connect(ClientArgs(), channel_status, stream_status));
+    TSUNIT_ASSERT(client.isConnected());
+    TSUNIT_EQUAL(1, stream_status.stream_id);
+
+    // Two additional streams in the same channel. A stream id cannot be reused.
+    TSUNIT_ASSERT(client.addStream(2, 2, ts::deciseconds(100), stream_status));
+    TSUNIT_EQUAL(2, stream_status.stream_id);
+    TSUNIT_EQUAL(2, stream_status.ECM_id);
+    TSUNIT_ASSERT(client.addStream(3, 7, ts::deciseconds(100), stream_status));
+    TSUNIT_EQUAL(3, stream_status.stream_id);
+    TSUNIT_EQUAL(7, stream_status.ECM_id);
+    TSUNIT_ASSERT(!client.addStream(2, 9, ts::deciseconds(100), stream_status));
+
+    // ECM's are generated in their own streams.
+    CheckECM(client, 1, 10);
+    CheckECM(client, 3, 20);
+    CheckECM(client, 2, 30);
+    CheckECM(client, 3, 21);
+
+    // All streams and the channel are politely closed.
+    TSUNIT_ASSERT(client.disconnect());
+    TSUNIT_ASSERT(!client.isConnected());
+    ecmg.waitForTermination();
+
+    TSUNIT_EQUAL(3, ecmg.streams.size());
+    TSUNIT_EQUAL(1, ecmg.streams[1]);
+    TSUNIT_EQUAL(2, ecmg.streams[2]);
+    TSUNIT_EQUAL(7, ecmg.streams[3]);
+    TSUNIT_EQUAL(1, ecmg.ecm_count[1]);
+    TSUNIT_EQUAL(1, ecmg.ecm_count[2]);
+    TSUNIT_EQUAL(2, ecmg.ecm_count[3]);
+    TSUNIT_ASSERT(ecmg.closed == std::vector<uint16_t>({1, 2, 3}));
+    TSUNIT_ASSERT(ecmg.channel_closed);
+}
+
+TSUNIT_DEFINE_TEST(AsyncMultiStream)
+{
+    utest::FakeECMG ecmg(ECMG_PORT);
+    TSUNIT_ASSERT(ecmg.listen());
+    ecmg.start();
+
+    const ts::ecmgscs::Protocol protocol;
+    ts::tlv::Logger logger(ClientReport(), ts::Severity::Debug);
+    ts::ECMGClient client(logger, protocol);
+    ts::ecmgscs::ChannelStatus channel_status(protocol);
+    ts::ecmgscs::StreamStatus stream_status(protocol);
+
+    TSUNIT_ASSERT(client.connect(ClientArgs(), channel_status, stream_status));
+    TSUNIT_ASSERT(client.addStream(2, 2, ts::deciseconds(100), stream_status));
+
+    // Same CP_number in two streams: the pending requests must not collide.
+    const ts::ByteBlock cw1(8, 0x11);
+    const ts::ByteBlock cw2(8, 0x22);
+    ECMHandler handler;
+    TSUNIT_ASSERT(client.submitECM(1, 5, cw1, cw2, ts::ByteBlock(), ts::deciseconds(100), &handler));
+    TSUNIT_ASSERT(client.submitECM(2, 5, cw1, cw2, ts::ByteBlock(), ts::deciseconds(100), &handler));
+    TSUNIT_ASSERT(handler.wait(2));
+    TSUNIT_EQUAL(2, handler.received.size());
+    TSUNIT_EQUAL(5, handler.received[1]);
+    TSUNIT_EQUAL(5, handler.received[2]);
+
+    TSUNIT_ASSERT(client.disconnect());
+    ecmg.waitForTermination();
+    TSUNIT_ASSERT(ecmg.closed == std::vector<uint16_t>({1, 2}));
+    TSUNIT_ASSERT(ecmg.channel_closed);
+}
+
+TSUNIT_DEFINE_TEST(DisconnectFailedStream)
+{
+    utest::FakeECMG ecmg(ECMG_PORT);
+    TSUNIT_ASSERT(ecmg.listen());
+    ecmg.failStreamClose(1);
+    ecmg.start();
+
+    const ts::ecmgscs::Protocol protocol;
+    ts::tlv::Logger logger(ClientReport(), ts::Severity::Debug);
+    ts::ECMGClient client(logger, protocol);
+    ts::ecmgscs::ChannelStatus channel_status(protocol);
+    ts::ecmgscs::StreamStatus stream_status(protocol);
+
+    TSUNIT_ASSERT(client.connect(ClientArgs(), channel_status, stream_status));
+    TSUNIT_ASSERT(client.addStream(2, 2, ts::deciseconds(100), stream_status));
+    TSUNIT_ASSERT(client.addStream(3, 3, ts::deciseconds(100), stream_status));
+
+    // The closure of the first stream fails: the other streams are still
+    // closed, the result is an error and the channel is not politely closed.
+    TSUNIT_ASSERT(!client.disconnect());
+    TSUNIT_ASSERT(!client.isConnected());
+    ecmg.waitForTermination();
+
+    TSUNIT_ASSERT(ecmg.closed == std::vector<uint16_t>({1, 2, 3}));
+    TSUNIT_ASSERT(!ecmg.channel_closed);
+}
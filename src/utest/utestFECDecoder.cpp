@@ -0,0 +1,315 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::mcast::FECDecoder
+//
+//----------------------------------------------------------------------------
+
+#include "tsmcastFECDecoder.h"
+#include "tsmcast.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class FECDecoderTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(ReedSolomonNoLoss);
+    TSUNIT_DECLARE_TEST(ReedSolomonRecovery);
+    TSUNIT_DECLARE_TEST(ReedSolomonRepairFirst);
+    TSUNIT_DECLARE_TEST(ReedSolomonLateSource);
+    TSUNIT_DECLARE_TEST(ReedSolomonTooManyLosses);
+    TSUNIT_DECLARE_TEST(RaptorQSourceSymbols);
+
+public:
+    virtual void beforeTest() override;
+
+private:
+    ts::ByteBlock _object {};
+
+    // Split the test object in source blocks of k symbols, as done by the decoder for FEI 2.
+    void buildBlocks(size_t symbol_size, size_t k, std::vector<std::vector<ts::ByteBlock>>& blocks);
+};
+
+TSUNIT_REGISTER(FECDecoderTest);
+
+void FECDecoderTest::beforeTest()
+{
+    // 10,000 bytes of pseudo-random data.
+    _object.resize(10000);
+    uint32_t x = 0x12345678;
+    for (auto& b : _object) {
+        x = x * 1103515245 + 12345;
+        b = uint8_t(x >> 16);
+    }
+}
+
+void FECDecoderTest::buildBlocks(size_t symbol_size, size_t k, std::vector<std::vector<ts::ByteBlock>>& blocks)
+{
+    // With 10,000 bytes, 100-byte symbols, max 30 symbols per block: 4 blocks of 25 symbols.
+    const size_t total = (_object.size() + symbol_size - 1) / symbol_size;
+    const size_t count = (total + k - 1) / k;
+    blocks.resize(count);
+    for (size_t sym = 0; sym < total; ++sym) {
+        ts::ByteBlock data(_object.data() + sym * symbol_size, std::min(symbol_size, _object.size() - sym * symbol_size));
+        data.resize(symbol_size, 0);
+        blocks[sym / (total / count)].push_back(data);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    ts::mcast::FECTransmissionInformation ReedSolomonFTI(uint64_t length)
+    {
+        ts::mcast::FECTransmissionInformation fti;
+        fti.fec_encoding_id = ts::mcast::FEI_REED_SOLOMON;
+        fti.transfer_length = length;
+        fti.field_size = 8;
+        fti.symbols_per_packet = 1;
+        fti.encoding_symbol_length = 100;
+        fti.max_source_block_length = 30;
+        fti.max_encoding_symbols = 40;
+        return fti;
+    }
+}
+
+TSUNIT_DEFINE_TEST(ReedSolomonNoLoss)
+{
+    std::vector<std::vector<ts::ByteBlock>> blocks;
+    buildBlocks(100, 30, blocks);
+    TSUNIT_EQUAL(4, blocks.size());
+    TSUNIT_EQUAL(25, blocks[0].size());
+
+    ts::mcast::FECDecoder dec;
+    TSUNIT_ASSERT(dec.reset(ReedSolomonFTI(_object.size()), NULLREP));
+
+    ts::mcast::FECPayloadId fpi;
+    fpi.valid = true;
+    fpi.fec_encoding_id = ts::mcast::FEI_REED_SOLOMON;
+    for (size_t sbn = 0; sbn < blocks.size(); ++sbn) {
+        for (size_t esi = 0; esi < blocks[sbn].size(); ++esi) {
+            TSUNIT_ASSERT(!dec.isComplete());
+            fpi.source_block_number = sbn;
+            fpi.encoding_symbol_id = esi;
+            TSUNIT_ASSERT(dec.addSymbol(fpi, blocks[sbn][esi].data(), blocks[sbn][esi].size()));
+        }
+    }
+    TSUNIT_ASSERT(dec.isComplete());
+    TSUNIT_EQUAL(100, dec.sourceSymbols());
+    TSUNIT_EQUAL(0, dec.repairSymbols());
+    TSUNIT_EQUAL(0, dec.recoveredSymbols());
+
+    ts::ByteBlock result;
+    TSUNIT_ASSERT(dec.getObject(result));
+    TSUNIT_ASSERT(result == _object);
+}
+
+TSUNIT_DEFINE_TEST(ReedSolomonRecovery)
+{
+    std::vector<std::vector<ts::ByteBlock>> blocks;
+    buildBlocks(100, 30, blocks);
+
+    ts::mcast::FECDecoder dec;
+    TSUNIT_ASSERT(dec.reset(ReedSolomonFTI(_object.size()), NULLREP));
+
+    ts::mcast::FECPayloadId fpi;
+    fpi.valid = true;
+    fpi.fec_encoding_id = ts::mcast::FEI_REED_SOLOMON;
+    ts::ByteBlock sym;
+
+    // In each block, drop 1 source symbol out of 3, then send repair symbols.
+    size_t dropped = 0;
+    for (size_t sbn = 0; sbn < blocks.size(); ++sbn) {
+        const size_t k = blocks[sbn].size();
+        fpi.source_block_number = sbn;
+        for (size_t esi = 0; esi < k; ++esi) {
+            if (esi % 3 == 1) {
+                dropped++;
+            }
+            else {
+                fpi.encoding_symbol_id = esi;
+                TSUNIT_ASSERT(dec.addSymbol(fpi, blocks[sbn][esi].data(), blocks[sbn][esi].size()));
+            }
+        }
+        for (size_t esi = k; esi < 40; ++esi) {
+            TSUNIT_ASSERT(ts::mcast::FECDecoder::EncodeReedSolomon(blocks[sbn], esi, sym));
+            fpi.encoding_symbol_id = esi;
+            dec.addSymbol(fpi, sym.data(), sym.size());
+        }
+    }
+    TSUNIT_ASSERT(dec.isComplete());
+    TSUNIT_EQUAL(dropped, dec.recoveredSymbols());
+    TSUNIT_EQUAL(_object.size(), dec.availableBytes());
+
+    ts::ByteBlock result;
+    TSUNIT_ASSERT(dec.getObject(result));
+    TSUNIT_ASSERT(result == _object);
+}
+
+TSUNIT_DEFINE_TEST(ReedSolomonRepairFirst)
+{
+    std::vector<std::vector<ts::ByteBlock>> blocks;
+    buildBlocks(100, 30, blocks);
+
+    ts::mcast::FECDecoder dec;
+    TSUNIT_ASSERT(dec.reset(ReedSolomonFTI(_object.size()), NULLREP));
+
+    ts::mcast::FECPayloadId fpi;
+    fpi.valid = true;
+    fpi.fec_encoding_id = ts::mcast::FEI_REED_SOLOMON;
+    ts::ByteBlock sym;
+
+    // In each block, send all repair symbols first, then source symbols in reverse order.
+    for (size_t sbn = 0; sbn < blocks.size(); ++sbn) {
+        const size_t k = blocks[sbn].size();
+        fpi.source_block_number = sbn;
+        for (size_t esi = k; esi < 40; ++esi) {
+            TSUNIT_ASSERT(ts::mcast::FECDecoder::EncodeReedSolomon(blocks[sbn], esi, sym));
+            fpi.encoding_symbol_id = esi;
+            TSUNIT_ASSERT(dec.addSymbol(fpi, sym.data(), sym.size()));
+        }
+        for (size_t esi = k; esi > 0; --esi) {
+            fpi.encoding_symbol_id = esi - 1;
+            dec.addSymbol(fpi, blocks[sbn][esi - 1].data(), blocks[sbn][esi - 1].size());
+        }
+    }
+    TSUNIT_ASSERT(dec.isComplete());
+    TSUNIT_EQUAL(4 * 15, dec.repairSymbols());
+    TSUNIT_EQUAL(4 * 15, dec.recoveredSymbols());
+
+    ts::ByteBlock result;
+    TSUNIT_ASSERT(dec.getObject(result));
+    TSUNIT_ASSERT(result == _object);
+}
+
+TSUNIT_DEFINE_TEST(ReedSolomonLateSource)
+{
+    std::vector<std::vector<ts::ByteBlock>> blocks;
+    buildBlocks(100, 30, blocks);
+
+    ts::mcast::FECDecoder dec;
+    TSUNIT_ASSERT(dec.reset(ReedSolomonFTI(_object.size()), NULLREP));
+
+    ts::mcast::FECPayloadId fpi;
+    fpi.valid = true;
+    fpi.fec_encoding_id = ts::mcast::FEI_REED_SOLOMON;
+    ts::ByteBlock sym;
+
+    // Block 0: 10 source symbols, 5 repair symbols, then the source symbols which were
+    // used as pivots by the repair symbols, then other source symbols until decoded.
+    fpi.source_block_number = 0;
+    for (size_t esi = 0; esi < 10; ++esi) {
+        fpi.encoding_symbol_id = esi;
+        TSUNIT_ASSERT(dec.addSymbol(fpi, blocks[0][esi].data(), blocks[0][esi].size()));
+    }
+    for (size_t esi = 25; esi < 30; ++esi) {
+        TSUNIT_ASSERT(ts::mcast::FECDecoder::EncodeReedSolomon(blocks[0], esi, sym));
+        fpi.encoding_symbol_id = esi;
+        TSUNIT_ASSERT(dec.addSymbol(fpi, sym.data(), sym.size()));
+    }
+    for (size_t esi = 10; esi < 20; ++esi) {
+        TSUNIT_EQUAL(0, dec.recoveredSymbols());
+        fpi.encoding_symbol_id = esi;
+        TSUNIT_ASSERT(dec.addSymbol(fpi, blocks[0][esi].data(), blocks[0][esi].size()));
+    }
+    TSUNIT_EQUAL(5, dec.recoveredSymbols());
+
+    // Other blocks without loss.
+    for (size_t sbn = 1; sbn < blocks.size(); ++sbn) {
+        fpi.source_block_number = sbn;
+        for (size_t esi = 0; esi < blocks[sbn].size(); ++esi) {
+            fpi.encoding_symbol_id = esi;
+            TSUNIT_ASSERT(dec.addSymbol(fpi, blocks[sbn][esi].data(), blocks[sbn][esi].size()));
+        }
+    }
+    TSUNIT_ASSERT(dec.isComplete());
+
+    ts::ByteBlock result;
+    TSUNIT_ASSERT(dec.getObject(result));
+    TSUNIT_ASSERT(result == _object);
+}
+
+TSUNIT_DEFINE_TEST(ReedSolomonTooManyLosses)
+{
+    std::vector<std::vector<ts::ByteBlock>> blocks;
+    buildBlocks(100, 30, blocks);
+
+    ts::mcast::FECDecoder dec;
+    TSUNIT_ASSERT(dec.reset(ReedSolomonFTI(_object.size()), NULLREP));
+
+    ts::mcast::FECPayloadId fpi;
+    fpi.valid = true;
+    fpi.fec_encoding_id = ts::mcast::FEI_REED_SOLOMON;
+    ts::ByteBlock sym;
+
+    // Only 24 distinct symbols out of 25 in block 0 (23 source, 1 repair), with duplicates.
+    fpi.source_block_number = 0;
+    for (size_t esi = 2; esi <= 25; ++esi) {
+        TSUNIT_ASSERT(ts::mcast::FECDecoder::EncodeReedSolomon(blocks[0], esi, sym));
+        fpi.encoding_symbol_id = esi;
+        TSUNIT_ASSERT(dec.addSymbol(fpi, sym.data(), sym.size()));
+        TSUNIT_ASSERT(!dec.addSymbol(fpi, sym.data(), sym.size()));
+    }
+    TSUNIT_ASSERT(!dec.isComplete());
+    TSUNIT_EQUAL(23 * 100, dec.availableBytes());
+
+    ts::ByteBlock result;
+    TSUNIT_ASSERT(!dec.getObject(result));
+}
+
+TSUNIT_DEFINE_TEST(RaptorQSourceSymbols)
+{
+    // RaptorQ with 2 source blocks, 2 sub-blocks and 4-byte alignment.
+    // Only the reassembly of source symbols is supported, RaptorQ FEC decoding is not implemented.
+    ts::mcast::FECTransmissionInformation fti;
+    fti.fec_encoding_id = ts::mcast::FEI_RAPTORQ;
+    fti.transfer_length = _object.size();
+    fti.encoding_symbol_length = 100;
+    fti.source_blocks = 2;
+    fti.sub_blocks = 2;
+    fti.symbol_alignment = 4;
+
+    ts::mcast::FECDecoder dec;
+    TSUNIT_ASSERT(dec.reset(fti, NULLREP));
+
+    // Sub-symbol sizes: Partition[100/4, 2] = (13, 12, 1, 1), meaning 52 and 48 bytes.
+    // Each source block has 50 symbols (5,000 bytes), sub-block 0 is 2,600 bytes, sub-block 1 is 2,400 bytes.
+    ts::mcast::FECPayloadId fpi;
+    fpi.valid = true;
+    fpi.fec_encoding_id = ts::mcast::FEI_RAPTORQ;
+    for (size_t sbn = 0; sbn < 2; ++sbn) {
+        const uint8_t* block = _object.data() + sbn * 5000;
+        for (size_t esi = 0; esi < 50; ++esi) {
+            ts::ByteBlock sym(block + esi * 52, 52);
+            sym.append(block + 2600 + esi * 48, 48);
+            fpi.source_block_number = sbn;
+            fpi.encoding_symbol_id = esi;
+            TSUNIT_ASSERT(dec.addSymbol(fpi, sym.data(), sym.size()));
+        }
+    }
+    TSUNIT_ASSERT(dec.isComplete());
+    TSUNIT_EQUAL(100, dec.sourceSymbols());
+
+    // Repair symbols are counted but ignored.
+    ts::ByteBlock repair(100, 0x5A);
+    fpi.source_block_number = 0;
+    fpi.encoding_symbol_id = 50;
+    TSUNIT_ASSERT(!dec.addSymbol(fpi, repair.data(), repair.size()));
+    TSUNIT_EQUAL(1, dec.repairSymbols());
+
+    ts::ByteBlock result;
+    TSUNIT_ASSERT(dec.getObject(result));
+    TSUNIT_ASSERT(result == _object);
+}
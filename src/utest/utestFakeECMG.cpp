@@ -0,0 +1,144 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+
+#include "utestFakeECMG.h"
+#include "tstlvConnection.h"
+#include "tsCerrReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors
+//----------------------------------------------------------------------------
+
+utest::FakeECMG::FakeECMG(uint16_t port) :
+    TSUnitThread(),
+    _port(port),
+    _logger(CERR, ts::Severity::Debug),
+    _server(&CERR)
+{
+}
+
+utest::FakeECMG::~FakeECMG()
+{
+    waitForTermination();
+    _server.close(true);
+}
+
+
+//----------------------------------------------------------------------------
+// Open the server socket and start listening.
+//----------------------------------------------------------------------------
+
+bool utest::FakeECMG::listen()
+{
+    return ts::IPInitialize() &&
+           _server.open(ts::IP::v4) &&
+           _server.reusePort(true) &&
+           _server.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, _port)) &&
+           _server.listen(5);
+}
+
+
+//----------------------------------------------------------------------------
+// Get the ECM_stream_id of a generated ECM section.
+//----------------------------------------------------------------------------
+
+uint16_t utest::FakeECMG::StreamIdOf(const ts::Section& section)
+{
+    return section.isValid() && section.payloadSize() >= 2 ? ts::GetUInt16(section.payload()) : 0xFFFF;
+}
+
+
+//----------------------------------------------------------------------------
+// Server thread: serve one client session.
+//----------------------------------------------------------------------------
+
+void utest::FakeECMG::test()
+{
+    ts::tlv::Connection<ts::ThreadSafety::None> conn(_logger, _protocol, true, 3);
+    ts::IPSocketAddress client;
+    TSUNIT_ASSERT(_server.accept(conn, client));
+
+    ts::tlv::MessagePtr msg;
+    while (!channel_closed && conn.receiveMessage(msg)) {
+        switch (msg->tag()) {
+            case ts::ecmgscs::Tags::channel_setup: {
+                const auto setup = std::dynamic_pointer_cast<ts::ecmgscs::ChannelSetup>(msg);
+                TSUNIT_ASSERT(setup != nullptr);
+                ts::ecmgscs::ChannelStatus resp(_protocol);
+                resp.channel_id = setup->channel_id;
+                resp.section_TSpkt_flag = false;
+                resp.ECM_rep_period = 100;
+                resp.max_streams = 100;
+                resp.min_CP_duration = 10;
+                resp.lead_CW = 1;
+                resp.CW_per_msg = 2;
+                resp.max_comp_time = 100;
+                TSUNIT_ASSERT(conn.sendMessage(resp));
+                break;
+            }
+            case ts::ecmgscs::Tags::stream_setup: {
+                const auto setup = std::dynamic_pointer_cast<ts::ecmgscs::StreamSetup>(msg);
+                TSUNIT_ASSERT(setup != nullptr);
+                streams.insert_or_assign(setup->stream_id, setup->ECM_id);
+                ts::ecmgscs::StreamStatus resp(_protocol);
+                resp.channel_id = setup->channel_id;
+                resp.stream_id = setup->stream_id;
+                resp.ECM_id = setup->ECM_id;
+                TSUNIT_ASSERT(conn.sendMessage(resp));
+                break;
+            }
+            case ts::ecmgscs::Tags::CW_provision: {
+                const auto cwp = std::dynamic_pointer_cast<ts::ecmgscs::CWProvision>(msg);
+                TSUNIT_ASSERT(cwp != nullptr);
+                ecm_count[cwp->stream_id]++;
+                uint8_t payload[4];
+                ts::PutUInt16(payload, cwp->stream_id);
+                ts::PutUInt16(payload + 2, cwp->CP_number);
+                const ts::Section ecm(ECM_TID, true, payload, sizeof(payload));
+                ts::ecmgscs::ECMResponse resp(_protocol);
+                resp.channel_id = cwp->channel_id;
+                resp.stream_id = cwp->stream_id;
+                resp.CP_number = cwp->CP_number;
+                resp.ECM_datagram.copy(ecm.content(), ecm.size());
+                TSUNIT_ASSERT(conn.sendMessage(resp));
+                break;
+            }
+            case ts::ecmgscs::Tags::stream_close_request: {
+                const auto req = std::dynamic_pointer_cast<ts::ecmgscs::StreamCloseRequest>(msg);
+                TSUNIT_ASSERT(req != nullptr);
+                closed.push_back(req->stream_id);
+                if (req->stream_id == _fail_close) {
+                    ts::ecmgscs::StreamError resp(_protocol);
+                    resp.channel_id = req->channel_id;
+                    resp.stream_id = req->stream_id;
+                    resp.error_status.push_back(ts::ecmgscs::Errors::unknown_error);
+                    TSUNIT_ASSERT(conn.sendMessage(resp));
+                }
+                else {
+                    ts::ecmgscs::StreamCloseResponse resp(_protocol);
+                    resp.channel_id = req->channel_id;
+                    resp.stream_id = req->stream_id;
+                    TSUNIT_ASSERT(conn.sendMessage(resp));
+                }
+                break;
+            }
+            case ts::ecmgscs::Tags::channel_close: {
+                channel_closed = true;
+                break;
+            }
+            default: {
+                break;
+            }
+        }
+    }
+
+    conn.disconnect(true);
+    conn.close(true);
+}
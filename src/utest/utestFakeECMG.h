@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Minimal ECMG server for unitary tests of ECMG clients.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "utestTSUnitThread.h"
+#include "tsECMGSCS.h"
+#include "tsSection.h"
+#include "tsTCPServer.h"
+#include "tstlvLogger.h"
+
+namespace utest {
+    //!
+    //! Minimal ECMG server for unitary tests of ECMG clients.
+    //!
+    //! The server accepts one single client connection, with one channel and any
+    //! number of ECM streams. Each CW_provision is answered with an ECM which is
+    //! a short private section containing the ECM_stream_id and the CP_number.
+    //! All received messages are recorded for later checks by the test, once the
+    //! server thread is terminated.
+    //!
+    class FakeECMG : public TSUnitThread
+    {
+        TS_NOBUILD_NOCOPY(FakeECMG);
+    public:
+        //!
+        //! Table id of the generated ECM's.
+        //!
+        static constexpr ts::TID ECM_TID = 0x80;
+
+        //!
+        //! Constructor.
+        //! @param [in] port TCP port on localhost.
+        //!
+        FakeECMG(uint16_t port);
+
+        //!
+        //! Destructor.
+        //!
+        virtual ~FakeECMG() override;
+
+        //!
+        //! Open the server socket and start listening.
+        //! Must be called in the main thread, before starting the thread and connecting the client.
+        //! @return True on success, false on error.
+        //!
+        bool listen();
+
+        //!
+        //! Reply a stream_error instead of a stream_close_response for a given stream.
+        //! @param [in] stream_id ECM_stream_id to fail.
+        //!
+        void failStreamClose(uint16_t stream_id) { _fail_close = stream_id; }
+
+        //!
+        //! Get the ECM_stream_id of a generated ECM section.
+        //! @param [in] section ECM section.
+        //! @return The ECM_stream_id in the ECM.
+        //!
+        static uint16_t StreamIdOf(const ts::Section& section);
+
+        // Recorded activity, to check after termination of the thread.
+        std::map<uint16_t, uint16_t> streams {};      //!< ECM_id of all opened streams, indexed by ECM_stream_id.
+        std::map<uint16_t, size_t>   ecm_count {};    //!< Number of generated ECM's, indexed by ECM_stream_id.
+        std::vector<uint16_t>        closed {};       //!< ECM_stream_id of all stream_close_request, in order.
+        bool                         channel_closed = false; //!< A channel_close was received.
+
+    protected:
+        // Implementation of TSUnitThread.
+        virtual void test() override;
+
+    private:
+        const uint16_t         _port;
+        uint16_t               _fail_close = 0xFFFF;
+        ts::ecmgscs::Protocol  _protocol {};
+        ts::tlv::Logger        _logger;
+        ts::TCPServer          _server;
+    };
+}
@@ -11,6 +11,9 @@
 //----------------------------------------------------------------------------
 
 #include "tsForkPipe.h"
+#include "tsByteBlock.h"
+#include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
 #include "tsCerrReport.h"
 #include "tsunit.h"
 
@@ -22,6 +25,7 @@
 class ForkPipeTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(ListFiles);
+    TSUNIT_DECLARE_TEST(AsyncWrite);
 };
 
 TSUNIT_REGISTER(ForkPipeTest);
@@ -46,3 +50,38 @@ TSUNIT_DEFINE_TEST(ListFiles)
 
     debug() << "ForkPipeTest: output of ls: \"" << output << "\"" << std::endl;
 }
+
+TSUNIT_DEFINE_TEST(AsyncWrite)
+{
+#if defined(TS_UNIX)
+    const fs::path file(ts::TempFile(u".bin"));
+    fs::remove(file, &ts::ErrCodeReport());
+
+    // Small queue and pipe size to force many wrap-arounds and full queues.
+    ts::ForkPipe pipe;
+    pipe.setAsyncWriteSize(10'000);
+    TSUNIT_ASSERT(pipe.open(u"cat > '" + ts::UString(file) + u"'", ts::ForkPipe::SYNCHRONOUS, 8192, CERR, ts::ForkPipe::KEEP_BOTH, ts::ForkPipe::STDIN_PIPE));
+
+    // The source buffer is overwritten after each write: the pipe shall not reference it.
+    ts::ByteBlock expected;
+    ts::ByteBlock buffer(3000);
+    for (size_t count = 0; count < 200; ++count) {
+        const size_t size = 1 + (count * 997) % buffer.size();
+        for (size_t i = 0; i < size; ++i) {
+            buffer[i] = uint8_t(count + i);
+        }
+        expected.append(buffer.data(), size);
+        size_t written = 0;
+        TSUNIT_ASSERT(pipe.writeStream(buffer.data(), size, written, CERR));
+        TSUNIT_EQUAL(size, written);
+        std::fill(buffer.begin(), buffer.end(), 0xFF);
+    }
+    TSUNIT_ASSERT(pipe.close(CERR));
+
+    ts::ByteBlock received;
+    TSUNIT_ASSERT(received.loadFromFile(ts::UString(file), std::numeric_limits<size_t>::max(), &CERR));
+    TSUNIT_EQUAL(expected.size(), received.size());
+    TSUNIT_ASSERT(expected == received);
+    fs::remove(file, &ts::ErrCodeReport());
+#endif
+}
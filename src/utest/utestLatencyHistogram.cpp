@@ -0,0 +1,164 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::LatencyHistogram
+//
+//----------------------------------------------------------------------------
+
+#include "tsLatencyHistogram.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class LatencyHistogramTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Empty);
+    TSUNIT_DECLARE_TEST(Exact);
+    TSUNIT_DECLARE_TEST(Precision);
+    TSUNIT_DECLARE_TEST(Percentiles);
+    TSUNIT_DECLARE_TEST(MoveAndAdd);
+    TSUNIT_DECLARE_TEST(Concurrent);
+};
+
+TSUNIT_REGISTER(LatencyHistogramTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Empty)
+{
+    ts::LatencyHistogram h;
+    TSUNIT_EQUAL(8, h.precision());
+    TSUNIT_EQUAL(0, h.count());
+    TSUNIT_EQUAL(0, h.minimum());
+    TSUNIT_EQUAL(0, h.maximum());
+    TSUNIT_EQUAL(0, h.percentile(50.0));
+    TSUNIT_EQUAL(0.0, h.mean());
+}
+
+TSUNIT_DEFINE_TEST(Exact)
+{
+    // Values below 2^precision are exact.
+    ts::LatencyHistogram h(4);
+    for (uint64_t v = 1; v <= 10; ++v) {
+        h.record(v);
+    }
+    TSUNIT_EQUAL(10, h.count());
+    TSUNIT_EQUAL(1, h.minimum());
+    TSUNIT_EQUAL(10, h.maximum());
+    TSUNIT_EQUAL(5, h.percentile(50.0));
+    TSUNIT_EQUAL(9, h.percentile(90.0));
+    TSUNIT_EQUAL(10, h.percentile(99.0));
+    TSUNIT_EQUAL(1, h.percentile(0.0));
+    TSUNIT_EQUAL(5.5, h.mean());
+    TSUNIT_EQUAL(u"count: 10, min: 1 us, p50: 5 us, p99: 10 us, p99.9: 10 us, max: 10 us", h.summary(u" us"));
+}
+
+TSUNIT_DEFINE_TEST(Precision)
+{
+    // Large values are never under-estimated and are within the relative precision.
+    ts::LatencyHistogram h;
+    for (uint64_t v : {257ull, 1000ull, 123456ull, 98765432ull, 0xFFFFFFFFFFFFFFFFull}) {
+        h.reset();
+        h.record(v);
+        h.record(0xFFFFFFFFFFFFFFFFull);
+        const uint64_t p = h.percentile(50.0);
+        debug() << "LatencyHistogramTest::Precision: value: " << v << ", p50: " << p << std::endl;
+        TSUNIT_ASSERT(p >= v);
+        TSUNIT_ASSERT(p - v <= v / 128);
+    }
+}
+
+TSUNIT_DEFINE_TEST(Percentiles)
+{
+    // 10,000 values: 1 to 10,000 microseconds.
+    ts::LatencyHistogram h;
+    for (uint64_t v = 1; v <= 10000; ++v) {
+        h.record(v);
+    }
+    TSUNIT_EQUAL(10000, h.count());
+    const uint64_t p50 = h.percentile(50.0);
+    const uint64_t p99 = h.percentile(99.0);
+    const uint64_t p999 = h.percentile(99.9);
+    TSUNIT_ASSERT(p50 >= 5000 && p50 <= 5000 + 5000 / 128);
+    TSUNIT_ASSERT(p99 >= 9900 && p99 <= 9900 + 9900 / 128);
+    TSUNIT_ASSERT(p999 >= 9990 && p999 <= 10000);
+    TSUNIT_EQUAL(10000, h.percentile(100.0));
+
+    // Durations.
+    ts::LatencyHistogram d;
+    d.recordDuration<cn::microseconds>(cn::milliseconds(3));
+    d.recordDuration<cn::microseconds>(cn::milliseconds(-3));
+    TSUNIT_EQUAL(2, d.count());
+    TSUNIT_EQUAL(0, d.minimum());
+    TSUNIT_EQUAL(3000, d.maximum());
+}
+
+TSUNIT_DEFINE_TEST(MoveAndAdd)
+{
+    ts::LatencyHistogram h1;
+    ts::LatencyHistogram h2;
+    ts::LatencyHistogram h3(10);
+
+    h1.record(10, 3);
+    h1.record(20);
+    TSUNIT_ASSERT(!h1.moveTo(h3));
+    TSUNIT_ASSERT(h1.moveTo(h2));
+    TSUNIT_EQUAL(0, h1.count());
+    TSUNIT_EQUAL(0, h1.maximum());
+    TSUNIT_EQUAL(4, h2.count());
+    TSUNIT_EQUAL(10, h2.minimum());
+    TSUNIT_EQUAL(20, h2.maximum());
+    TSUNIT_EQUAL(10, h2.percentile(75.0));
+    TSUNIT_EQUAL(20, h2.percentile(76.0));
+
+    h1.record(5);
+    TSUNIT_ASSERT(h1.add(h2));
+    TSUNIT_EQUAL(5, h1.count());
+    TSUNIT_EQUAL(5, h1.minimum());
+    TSUNIT_EQUAL(20, h1.maximum());
+    TSUNIT_EQUAL(11.0, h1.mean());
+}
+
+TSUNIT_DEFINE_TEST(Concurrent)
+{
+    // Several threads record values while the main thread moves them into a snapshot.
+    constexpr size_t thread_count = 4;
+    constexpr uint64_t per_thread = 100000;
+    ts::LatencyHistogram h;
+    ts::LatencyHistogram snapshot;
+    ts::LatencyHistogram total;
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&h, t]() {
+            for (uint64_t i = 0; i < per_thread; ++i) {
+                h.record(t * 1000 + i % 1000);
+            }
+        });
+    }
+    for (size_t i = 0; i < 1000; ++i) {
+        h.moveTo(snapshot);
+        total.add(snapshot);
+        // The remaining count must never wrap below zero during concurrent recordings.
+        TSUNIT_ASSERT(h.count() <= thread_count * per_thread);
+    }
+    for (auto& th : threads) {
+        th.join();
+    }
+    h.moveTo(snapshot);
+    total.add(snapshot);
+
+    TSUNIT_EQUAL(thread_count * per_thread, total.count());
+    TSUNIT_EQUAL(0, h.count());
+}
@@ -87,6 +87,7 @@ class MemoryTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(PutIntFixBE);
     TSUNIT_DECLARE_TEST(PutIntFixLE);
     TSUNIT_DECLARE_TEST(LocatePattern);
+    TSUNIT_DECLARE_TEST(LocateStridedByte);
     TSUNIT_DECLARE_TEST(LocateZeroZero);
     TSUNIT_DECLARE_TEST(Xor);
 };
@@ -629,6 +630,41 @@ TSUNIT_DEFINE_TEST(LocatePattern)
 {
     TSUNIT_ASSERT(ts::LocatePattern(data1, sizeof(data1), data2 + 7, 6) == nullptr);
     TSUNIT_ASSERT(ts::LocatePattern(data1, sizeof(data1), data1 + 7, 6) == data1 + 7);
+
+    // Patterns in all positions of a large area, including the last bytes which are not a full vector.
+    for (size_t pos = 0; pos < sizeof(_bytes) - 5; pos += 17) {
+        TSUNIT_ASSERT(ts::LocatePattern(_bytes, sizeof(_bytes), _bytes + pos, 5) == _bytes + pos);
+    }
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, sizeof(_bytes), _bytes + sizeof(_bytes) - 2, 2) == _bytes + sizeof(_bytes) - 2);
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, sizeof(_bytes) - 1, _bytes + sizeof(_bytes) - 2, 2) == nullptr);
+    TSUNIT_ASSERT(ts::LocatePattern(_bytes, sizeof(_bytes), data1 + 21, 3) == nullptr);
+}
+
+TSUNIT_DEFINE_TEST(LocateStridedByte)
+{
+    // Packets of 188 bytes, sync bytes 0x47, starting at offset 100.
+    uint8_t buf[100 + 10 * 188];
+    for (size_t i = 0; i < sizeof(buf); ++i) {
+        buf[i] = uint8_t(i % 0x47);
+    }
+    for (size_t i = 100; i < sizeof(buf); i += 188) {
+        buf[i] = 0x47;
+    }
+    // Isolated sync bytes before the first packet.
+    buf[3] = buf[40] = 0x47;
+
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 188, 1) == buf + 3);
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 188, 2) == buf + 100);
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 188, 10) == buf + 100);
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 188, 11) == nullptr);
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 204, 2) == nullptr);
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 188, 0) == nullptr);
+
+    // Only the last packets are synchronized: the result is beyond the first vectors.
+    buf[100 + 2 * 188] = 0x00;
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 188, 3) == buf + 100 + 3 * 188);
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 188, 7) == buf + 100 + 3 * 188);
+    TSUNIT_ASSERT(ts::LocateStridedByte(buf, sizeof(buf), 0x47, 188, 8) == nullptr);
 }
 
 TSUNIT_DEFINE_TEST(LocateZeroZero)
@@ -87,6 +87,11 @@ namespace {
     {
         ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
         if (data != nullptr && _packets_count > 0) {
+            // Label the input packet with its index in the reference packets.
+            ts::TSPacketMetadata* mdata = data->outputMetadata();
+            if (mdata != nullptr && data->metadataCount() > data->size() / ts::PKT_SIZE) {
+                mdata[data->size() / ts::PKT_SIZE].setLabel(_packets_count);
+            }
             data->append(_packets, ts::PKT_SIZE);
             _packets++;
             _packets_count--;
@@ -104,14 +109,16 @@ namespace {
     {
         TS_NOBUILD_NOCOPY(Output);
     public:
-        Output(ts::TSPacketVector& output);
+        Output(ts::TSPacketVector& output, ts::TSPacketMetadataVector& metadata);
         virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
     private:
         ts::TSPacketVector& _output;
+        ts::TSPacketMetadataVector& _metadata;
     };
 
-    Output::Output(ts::TSPacketVector& output) :
-        _output(output)
+    Output::Output(ts::TSPacketVector& output, ts::TSPacketMetadataVector& metadata) :
+        _output(output),
+        _metadata(metadata)
     {
     }
 
@@ -123,6 +130,10 @@ namespace {
             const size_t index = _output.size();
             _output.resize(index + packets_count);
             ts::TSPacket::Copy(&_output[index], data->data(), packets_count);
+            if (data->metadataCount() == packets_count) {
+                _metadata.resize(index + packets_count);
+                ts::TSPacketMetadata::Copy(&_metadata[index], data->metadata(), packets_count);
+            }
         }
     }
 }
@@ -192,8 +203,9 @@ TSUNIT_DEFINE_TEST(All)
     TestReport log(log_buffer);
 
     ts::TSPacketVector output_packets;
+    ts::TSPacketMetadataVector output_metadata;
     Input input(REF_PACKETS, REF_PACKETS_COUNT);
-    Output output(output_packets);
+    Output output(output_packets, output_metadata);
 
     ts::TSProcessorArgs opt;
     opt.input = {u"memory", {}};
@@ -208,5 +220,9 @@ TSUNIT_DEFINE_TEST(All)
 
     TSUNIT_EQUAL(REF_PACKETS_COUNT, output_packets.size());
     TSUNIT_EQUAL(0, ts::MemCompare(&output_packets[0], REF_PACKETS, ts::PKT_SIZE * REF_PACKETS_COUNT));
+    TSUNIT_EQUAL(REF_PACKETS_COUNT, output_metadata.size());
+    for (size_t i = 0; i < output_metadata.size(); ++i) {
+        TSUNIT_ASSERT(output_metadata[i].hasLabel(REF_PACKETS_COUNT - i));
+    }
     TSUNIT_EQUAL(u"", log_buffer);
 }
@@ -0,0 +1,205 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::PSIMerger.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPSIMerger.h"
+#include "tsOneShotPacketizer.h"
+#include "tsSectionDemux.h"
+#include "tsBinaryTable.h"
+#include "tsPAT.h"
+#include "tsCAT.h"
+#include "tsCADescriptor.h"
+#include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PSIMergerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(PATVersions);
+    TSUNIT_DECLARE_TEST(CATOrigins);
+};
+
+TSUNIT_REGISTER(PSIMergerTest);
+
+
+//----------------------------------------------------------------------------
+// A test bench: feed input tables in the two streams, collect output tables.
+//----------------------------------------------------------------------------
+
+namespace {
+    class MergerBench : private ts::TableHandlerInterface
+    {
+        TS_NOCOPY(MergerBench);
+    public:
+        MergerBench(ts::PSIMerger::Options options);
+
+        // Expected conflicts are reported as errors, display them in debug mode only.
+        ts::DuckContext  duck {tsunit::Test::debugMode() ? static_cast<ts::Report*>(&CERR) : static_cast<ts::Report*>(&NULLREP)};
+        ts::PSIMerger    merger {duck, ts::PSIMerger::NONE};
+        std::vector<std::shared_ptr<ts::BinaryTable>> output {};  // All new output tables (new versions only).
+
+        // Pass one input table in each stream, a few times, and collect the output.
+        void feed(const ts::AbstractTable& main, const ts::AbstractTable& merge);
+
+    private:
+        ts::SectionDemux _demux {duck, this};
+        uint8_t          _main_cc = 0;   // Continuity counters, kept across calls to feed().
+        uint8_t          _merge_cc = 0;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable& table) override;
+    };
+
+    MergerBench::MergerBench(ts::PSIMerger::Options options)
+    {
+        merger.reset(options);
+        _demux.addPID(ts::PID_PAT);
+        _demux.addPID(ts::PID_CAT);
+    }
+
+    void MergerBench::handleTable(ts::SectionDemux&, const ts::BinaryTable& table)
+    {
+        output.push_back(std::make_shared<ts::BinaryTable>(table, ts::ShareMode::COPY));
+    }
+
+    void MergerBench::feed(const ts::AbstractTable& main, const ts::AbstractTable& merge)
+    {
+        const ts::PID pid = main.tableId() == ts::TID_CAT ? ts::PID_CAT : ts::PID_PAT;
+        ts::TSPacketVector main_packets;
+        ts::TSPacketVector merge_packets;
+        ts::OneShotPacketizer main_pzer(duck, pid, true);
+        ts::OneShotPacketizer merge_pzer(duck, pid, true);
+        main_pzer.addTable(duck, main);
+        merge_pzer.addTable(duck, merge);
+        main_pzer.getPackets(main_packets);
+        merge_pzer.getPackets(merge_packets);
+
+        for (size_t count = 0; count < 4; ++count) {
+            for (auto pkt : merge_packets) {
+                pkt.setCC(_merge_cc++ & ts::CC_MASK);
+                TSUNIT_ASSERT(merger.feedMergedPacket(pkt));
+            }
+            for (auto pkt : main_packets) {
+                pkt.setCC(_main_cc++ & ts::CC_MASK);
+                TSUNIT_ASSERT(merger.feedMainPacket(pkt));
+                _demux.feedPacket(pkt);
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(PATVersions)
+{
+    MergerBench bench(ts::PSIMerger::MERGE_PAT | ts::PSIMerger::NULL_MERGED);
+
+    ts::PAT main_pat(4, true, 0x0001);
+    main_pat.pmts[1] = 0x0100;
+    main_pat.pmts[2] = 0x0200;
+    ts::PAT merge_pat(0, true, 0x0002);
+    merge_pat.pmts[10] = 0x1000;
+
+    // Initial merge: the output version is the next one after the main PAT.
+    bench.feed(main_pat, merge_pat);
+    TSUNIT_EQUAL(1, bench.output.size());
+    ts::PAT pat(bench.duck, *bench.output.back());
+    TSUNIT_ASSERT(pat.isValid());
+    TSUNIT_EQUAL(5, pat.version());
+    TSUNIT_EQUAL(0x0001, pat.ts_id);
+    TSUNIT_EQUAL(3, pat.pmts.size());
+    TSUNIT_EQUAL(0x1000, pat.pmts[10]);
+
+    TSUNIT_ASSERT(bench.merger.serviceOrigin(1) == ts::PSIMerger::Origin::MAIN);
+    TSUNIT_ASSERT(bench.merger.serviceOrigin(2) == ts::PSIMerger::Origin::MAIN);
+    TSUNIT_ASSERT(bench.merger.serviceOrigin(10) == ts::PSIMerger::Origin::MERGED);
+    TSUNIT_ASSERT(!bench.merger.serviceOrigin(11).has_value());
+
+    // New versions of the input tables with unchanged content: no new output version.
+    merge_pat.setVersion(1);
+    bench.feed(main_pat, merge_pat);
+    main_pat.setVersion(5);
+    bench.feed(main_pat, merge_pat);
+    TSUNIT_EQUAL(1, bench.output.size());
+
+    // A service is added in the merged stream: new output version.
+    merge_pat.setVersion(2);
+    merge_pat.pmts[11] = 0x1100;
+    bench.feed(main_pat, merge_pat);
+    TSUNIT_EQUAL(2, bench.output.size());
+    pat.deserialize(bench.duck, *bench.output.back());
+    TSUNIT_ASSERT(pat.isValid());
+    TSUNIT_EQUAL(6, pat.version());
+    TSUNIT_EQUAL(4, pat.pmts.size());
+    TSUNIT_ASSERT(bench.merger.serviceOrigin(11) == ts::PSIMerger::Origin::MERGED);
+
+    // A service is removed from the merged stream: new output version, origin forgotten.
+    merge_pat.setVersion(3);
+    merge_pat.pmts.erase(10);
+    bench.feed(main_pat, merge_pat);
+    TSUNIT_EQUAL(3, bench.output.size());
+    pat.deserialize(bench.duck, *bench.output.back());
+    TSUNIT_EQUAL(7, pat.version());
+    TSUNIT_EQUAL(3, pat.pmts.size());
+    TSUNIT_ASSERT(!pat.pmts.contains(10));
+    TSUNIT_ASSERT(!bench.merger.serviceOrigin(10).has_value());
+    TSUNIT_ASSERT(bench.merger.serviceOrigin(11) == ts::PSIMerger::Origin::MERGED);
+
+    // A service which exists in both streams is kept from the main stream.
+    merge_pat.setVersion(4);
+    merge_pat.pmts[2] = 0x1200;
+    bench.feed(main_pat, merge_pat);
+    TSUNIT_EQUAL(3, bench.output.size());
+    TSUNIT_ASSERT(bench.merger.serviceOrigin(2) == ts::PSIMerger::Origin::MAIN);
+}
+
+TSUNIT_DEFINE_TEST(CATOrigins)
+{
+    MergerBench bench(ts::PSIMerger::MERGE_CAT | ts::PSIMerger::NULL_MERGED);
+
+    ts::CAT main_cat(0);
+    main_cat.descs.add(bench.duck, ts::CADescriptor(0x0100, 0x0500));
+    ts::CAT merge_cat(0);
+    merge_cat.descs.add(bench.duck, ts::CADescriptor(0x0200, 0x0600));
+
+    bench.feed(main_cat, merge_cat);
+    TSUNIT_EQUAL(1, bench.output.size());
+    ts::CAT cat(bench.duck, *bench.output.back());
+    TSUNIT_ASSERT(cat.isValid());
+    TSUNIT_EQUAL(1, cat.version());
+    TSUNIT_EQUAL(2, cat.descs.count());
+
+    TSUNIT_ASSERT(bench.merger.emmOrigin(0x0500) == ts::PSIMerger::Origin::MAIN);
+    TSUNIT_ASSERT(bench.merger.emmOrigin(0x0600) == ts::PSIMerger::Origin::MERGED);
+    TSUNIT_ASSERT(!bench.merger.emmOrigin(0x0700).has_value());
+
+    // Same content, new input version: no new output version.
+    merge_cat.setVersion(1);
+    bench.feed(main_cat, merge_cat);
+    TSUNIT_EQUAL(1, bench.output.size());
+
+    // EMM PID changed in the merged stream.
+    merge_cat.setVersion(2);
+    merge_cat.descs.clear();
+    merge_cat.descs.add(bench.duck, ts::CADescriptor(0x0200, 0x0700));
+    bench.feed(main_cat, merge_cat);
+    TSUNIT_EQUAL(2, bench.output.size());
+    cat.deserialize(bench.duck, *bench.output.back());
+    TSUNIT_EQUAL(2, cat.version());
+    TSUNIT_ASSERT(!bench.merger.emmOrigin(0x0600).has_value());
+    TSUNIT_ASSERT(bench.merger.emmOrigin(0x0700) == ts::PSIMerger::Origin::MERGED);
+}
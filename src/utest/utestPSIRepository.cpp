@@ -25,6 +25,7 @@ class PSIRepositoryTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(DataTypes);
     TSUNIT_DECLARE_TEST(Registrations);
     TSUNIT_DECLARE_TEST(SharedTID);
+    TSUNIT_DECLARE_TEST(LateRegistration);
 };
 
 TSUNIT_REGISTER(PSIRepositoryTest);
@@ -107,3 +108,18 @@ TSUNIT_DEFINE_TEST(SharedTID)
     TSUNIT_ASSERT(ts::MGT::DisplaySection == ts::PSIRepository::Instance().getTable(ts::TID_LDT, ts::SectionContext(ts::PID_PSIP, ts::Standards::NONE)).display);
     TSUNIT_ASSERT(ts::LDT::DisplaySection == ts::PSIRepository::Instance().getTable(ts::TID_LDT, ts::SectionContext(ts::PID_LDT, ts::Standards::NONE)).display);
 }
+
+namespace {
+    void LateCADisplay(ts::TablesDisplay&, ts::PSIBuffer&, const ts::UString&, ts::TID) {}
+}
+
+TSUNIT_DEFINE_TEST(LateRegistration)
+{
+    // Registrations after the construction of the repository are immediately applied.
+    constexpr ts::CASID cas = 0xFFF0;
+    ts::PSIRepository& repo(ts::PSIRepository::Instance());
+    TSUNIT_ASSERT(repo.getCADescriptorDisplay(cas) == nullptr);
+    ts::PSIRepository::RegisterDescriptor reg(LateCADisplay, cas);
+    TSUNIT_ASSERT(repo.getCADescriptorDisplay(cas) == LateCADisplay);
+    TSUNIT_ASSERT(repo.getCADescriptorDisplay(cas + 1) == nullptr);
+}
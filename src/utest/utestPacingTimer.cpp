@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::PacingTimer
+//
+//----------------------------------------------------------------------------
+
+#include "tsPacingTimer.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class PacingTimerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(SpinMargin);
+    TSUNIT_DECLARE_TEST(Wait);
+    TSUNIT_DECLARE_TEST(Calibrate);
+};
+
+TSUNIT_REGISTER(PacingTimerTest);
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(SpinMargin)
+{
+    ts::PacingTimer timer;
+    TSUNIT_EQUAL(0, timer.spinMargin().count());
+
+    timer.setSpinMargin(cn::microseconds(20));
+    TSUNIT_EQUAL(20'000, timer.spinMargin().count());
+
+    timer.setSpinMargin(cn::milliseconds(5), false, cn::microseconds(300));
+    TSUNIT_EQUAL(300'000, timer.spinMargin().count());
+
+    timer.setSpinMargin(cn::microseconds(-5));
+    TSUNIT_EQUAL(0, timer.spinMargin().count());
+}
+
+TSUNIT_DEFINE_TEST(Wait)
+{
+    // Never wake up before the deadline, with or without spin.
+    ts::PacingTimer timer;
+    for (int spin = 0; spin <= 200; spin += 100) {
+        timer.setSpinMargin(cn::microseconds(spin));
+        for (int i = 0; i < 10; ++i) {
+            const ts::monotonic_time deadline = ts::monotonic_time::clock::now() + cn::microseconds(300);
+            const ts::monotonic_time wakeup = timer.waitUntil(deadline);
+            TSUNIT_ASSERT(wakeup >= deadline);
+            TSUNIT_ASSERT(ts::monotonic_time::clock::now() >= deadline);
+        }
+    }
+    TSUNIT_EQUAL(30, timer.jitter().count());
+
+    // A deadline in the past returns immediately.
+    const ts::monotonic_time past = ts::monotonic_time::clock::now() - cn::seconds(1);
+    TSUNIT_ASSERT(timer.waitUntil(past) - past >= cn::seconds(1));
+    TSUNIT_EQUAL(31, timer.jitter().count());
+    TSUNIT_ASSERT(timer.jitter().maximum() >= 1'000'000'000);
+
+    debug() << "PacingTimerTest::Wait: jitter (ns): " << timer.jitter().summary() << std::endl;
+}
+
+TSUNIT_DEFINE_TEST(Calibrate)
+{
+    ts::PacingTimer timer;
+    const cn::nanoseconds margin = timer.calibrate(cn::microseconds(400));
+    TSUNIT_ASSERT(margin >= cn::nanoseconds::zero());
+    TSUNIT_ASSERT(margin <= cn::microseconds(400));
+    TSUNIT_EQUAL(margin.count(), timer.spinMargin().count());
+    TSUNIT_EQUAL(0, timer.jitter().count());
+
+    for (int i = 0; i < 20; ++i) {
+        const ts::monotonic_time deadline = ts::monotonic_time::clock::now() + cn::microseconds(500);
+        TSUNIT_ASSERT(timer.waitUntil(deadline) >= deadline);
+        TSUNIT_ASSERT(timer.spinMargin() <= cn::microseconds(400));
+    }
+    TSUNIT_EQUAL(20, timer.jitter().count());
+
+    debug() << "PacingTimerTest::Calibrate: margin: " << margin.count() << " ns, jitter (ns): " << timer.jitter().summary() << std::endl;
+}
@@ -32,10 +32,14 @@
 class PacketizerTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Packetizer);
+    TSUNIT_DECLARE_TEST(Precompiled);
 
 private:
     // Demux one table from a list of packets
     static void DemuxTable(ts::BinaryTablePtr& binTable, const char* name, const uint8_t* packets, size_t packets_size);
+
+    // Compare the output of a normal and a precompiled packetizer.
+    void comparePacketizers(ts::CyclingPacketizer& ref, ts::CyclingPacketizer& pre, size_t count, bool bulk);
 };
 
 TSUNIT_REGISTER(PacketizerTest);
@@ -132,3 +136,87 @@ TSUNIT_DEFINE_TEST(Packetizer)
     TSUNIT_ASSERT(pmt_count == 4);
     TSUNIT_ASSERT(sdt_count >= 12 && sdt_count <= 18);
 }
+
+void PacketizerTest::comparePacketizers(ts::CyclingPacketizer& ref, ts::CyclingPacketizer& pre, size_t count, bool bulk)
+{
+    ts::TSPacketVector ref_packets(count);
+    ts::TSPacketVector pre_packets(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        ref.getNextPacket(ref_packets[i]);
+        if (!bulk) {
+            pre.getNextPacket(pre_packets[i]);
+            TSUNIT_EQUAL(ref.atCycleBoundary(), pre.atCycleBoundary());
+            TSUNIT_EQUAL(ref.atSectionBoundary(), pre.atSectionBoundary());
+            TSUNIT_EQUAL(ref.sectionCount(), pre.sectionCount());
+        }
+    }
+    if (bulk) {
+        TSUNIT_EQUAL(count, pre.getNextPackets(pre_packets.data(), count));
+        TSUNIT_EQUAL(ref.atCycleBoundary(), pre.atCycleBoundary());
+        TSUNIT_EQUAL(ref.sectionCount(), pre.sectionCount());
+    }
+    for (size_t i = 0; i < count; ++i) {
+        TSUNIT_ASSERT(ref_packets[i] == pre_packets[i]);
+    }
+    TSUNIT_EQUAL(ref.packetCount(), pre.packetCount());
+    TSUNIT_EQUAL(ref.nextContinuityCounter(), pre.nextContinuityCounter());
+}
+
+TSUNIT_DEFINE_TEST(Precompiled)
+{
+    ts::DuckContext duck;
+    ts::BinaryTablePtr binpat;
+    ts::BinaryTablePtr binpmt;
+    ts::BinaryTablePtr binsdt;
+
+    DemuxTable(binpat, "PAT", psi_pat_r4_packets, sizeof(psi_pat_r4_packets));
+    DemuxTable(binpmt, "PMT", psi_pmt_planete_packets, sizeof(psi_pmt_planete_packets));
+    DemuxTable(binsdt, "SDT", psi_sdt_r3_packets, sizeof(psi_sdt_r3_packets));
+
+    for (auto policy : {ts::CyclingPacketizer::StuffingPolicy::AT_END, ts::CyclingPacketizer::StuffingPolicy::ALWAYS}) {
+
+        ts::CyclingPacketizer ref(duck, 0x0100, policy);
+        ts::CyclingPacketizer pre(duck, 0x0100, policy);
+        pre.setPrecompiled(true);
+        TSUNIT_ASSERT(pre.precompiled());
+
+        for (auto* pzer : {&ref, &pre}) {
+            pzer->addTable(*binpat);
+            pzer->addTable(*binpmt);
+            pzer->addTable(*binsdt);
+        }
+
+        // First cycle is recorded, the next ones are replayed.
+        TSUNIT_EQUAL(0, pre.precompiledPacketCount());
+        comparePacketizers(ref, pre, 50, false);
+        TSUNIT_ASSERT(pre.precompiledPacketCount() > 0);
+        comparePacketizers(ref, pre, 123, true);
+
+        // Complete the current cycle, then change the content of the cycle.
+        while (!ref.atCycleBoundary()) {
+            comparePacketizers(ref, pre, 1, false);
+        }
+        ref.removeSections(ts::TID_PMT);
+        pre.removeSections(ts::TID_PMT);
+        comparePacketizers(ref, pre, 40, false);
+        comparePacketizers(ref, pre, 77, true);
+
+        // Changing the PID does not invalidate the precompiled cycle.
+        ref.setPID(0x0200);
+        pre.setPID(0x0200);
+        comparePacketizers(ref, pre, 31, true);
+        TSUNIT_ASSERT(pre.precompiledPacketCount() > 0);
+    }
+
+    // A cycle with repetition rates is never precompiled.
+    ts::CyclingPacketizer sched(duck, 0x0100, ts::CyclingPacketizer::StuffingPolicy::ALWAYS, ts::PKT_SIZE_BITS * 10);
+    sched.setPrecompiled(true);
+    sched.addTable(*binpat);
+    sched.addTable(*binsdt, cn::milliseconds(250));
+    ts::TSPacket pkt;
+    for (size_t i = 0; i < 20; ++i) {
+        sched.getNextPacket(pkt);
+    }
+    TSUNIT_EQUAL(0, sched.precompiledPacketCount());
+}
@@ -0,0 +1,249 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::RTPReorderBuffer.
+//
+//----------------------------------------------------------------------------
+
+#include "tsRTPReorderBuffer.h"
+#include "tsIPProtocols.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class RTPReorderBufferTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(InOrder);
+    TSUNIT_DECLARE_TEST(Reorder);
+    TSUNIT_DECLARE_TEST(DuplicateLate);
+    TSUNIT_DECLARE_TEST(WindowFull);
+    TSUNIT_DECLARE_TEST(Delay);
+    TSUNIT_DECLARE_TEST(NonRTP);
+    TSUNIT_DECLARE_TEST(Resync);
+    TSUNIT_DECLARE_TEST(LargeDatagrams);
+
+private:
+    ts::monotonic_time _now {};
+
+    // Receive one RTP datagram with a given sequence number and return all available datagrams.
+    // Return sequence numbers of returned datagrams, -1 for non-RTP datagrams.
+    void receive(ts::RTPReorderBuffer& buf, std::vector<int>& out, uint16_t seq, uint32_t ssrc = 0x1234, bool rtp = true);
+    void receive(ts::RTPReorderBuffer& buf, std::vector<int>& out, std::initializer_list<uint16_t> seqs);
+};
+
+TSUNIT_REGISTER(RTPReorderBufferTest);
+
+void RTPReorderBufferTest::receive(ts::RTPReorderBuffer& buf, std::vector<int>& out, uint16_t seq, uint32_t ssrc, bool rtp)
+{
+    uint8_t* data = buf.receiveBuffer();
+    TSUNIT_ASSERT(data != nullptr);
+    TSUNIT_ASSERT(buf.receiveBufferSize() >= 100);
+    data[0] = rtp ? 0x80 : 0x47;
+    data[1] = ts::RTP_PT_MP2T;
+    ts::PutUInt16(data + 2, seq);
+    ts::PutUInt32(data + 4, seq * 100);
+    ts::PutUInt32(data + 8, ssrc);
+    buf.commit(100, cn::microseconds(seq), ts::TimeSource::KERNEL, _now);
+
+    uint8_t buffer[200];
+    size_t size = 0;
+    cn::microseconds timestamp {};
+    ts::TimeSource source = ts::TimeSource::UNDEFINED;
+    while (buf.getDatagram(buffer, sizeof(buffer), size, timestamp, source, _now)) {
+        TSUNIT_EQUAL(100, size);
+        TSUNIT_EQUAL(ts::TimeSource::KERNEL, source);
+        if (buffer[0] == 0x80) {
+            TSUNIT_EQUAL(ts::GetUInt16(buffer + 2), timestamp.count());
+            out.push_back(ts::GetUInt16(buffer + 2));
+        }
+        else {
+            out.push_back(-1);
+        }
+    }
+}
+
+void RTPReorderBufferTest::receive(ts::RTPReorderBuffer& buf, std::vector<int>& out, std::initializer_list<uint16_t> seqs)
+{
+    for (auto seq : seqs) {
+        receive(buf, out, seq);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(InOrder)
+{
+    ts::RTPReorderBuffer buf;
+    buf.reset(8);
+    TSUNIT_EQUAL(8, buf.window());
+
+    std::vector<int> out;
+    receive(buf, out, {0xFFFE, 0xFFFF, 0, 1, 2});
+    TSUNIT_ASSERT(out == std::vector<int>({0xFFFE, 0xFFFF, 0, 1, 2}));
+    TSUNIT_EQUAL(5, buf.statistics().rtp_datagrams);
+    TSUNIT_EQUAL(0, buf.statistics().reordered_datagrams);
+    TSUNIT_EQUAL(0, buf.statistics().missing_datagrams);
+}
+
+TSUNIT_DEFINE_TEST(Reorder)
+{
+    ts::RTPReorderBuffer buf;
+    buf.reset(8);
+
+    std::vector<int> out;
+    receive(buf, out, {10, 12, 13, 11, 14, 16, 15});
+    TSUNIT_ASSERT(out == std::vector<int>({10, 11, 12, 13, 14, 15, 16}));
+    TSUNIT_EQUAL(2, buf.statistics().reordered_datagrams);
+    TSUNIT_EQUAL(0, buf.statistics().missing_datagrams);
+}
+
+TSUNIT_DEFINE_TEST(DuplicateLate)
+{
+    ts::RTPReorderBuffer buf;
+    buf.reset(8);
+
+    std::vector<int> out;
+    receive(buf, out, {10, 12, 12, 11, 10});
+    TSUNIT_ASSERT(out == std::vector<int>({10, 11, 12}));
+    TSUNIT_EQUAL(1, buf.statistics().duplicate_datagrams);
+    TSUNIT_EQUAL(1, buf.statistics().late_datagrams);
+}
+
+TSUNIT_DEFINE_TEST(WindowFull)
+{
+    // Window of 4 datagrams, 11 and 12 are lost, 12 is received too late.
+    ts::RTPReorderBuffer buf;
+    buf.reset(4);
+
+    std::vector<int> out;
+    receive(buf, out, {10, 13, 14, 15});
+    TSUNIT_ASSERT(out == std::vector<int>({10}));
+    TSUNIT_EQUAL(1, buf.statistics().missing_datagrams);
+    receive(buf, out, 16);
+    TSUNIT_ASSERT(out == std::vector<int>({10, 13, 14, 15, 16}));
+    receive(buf, out, {12, 17});
+    TSUNIT_ASSERT(out == std::vector<int>({10, 13, 14, 15, 16, 17}));
+    TSUNIT_EQUAL(2, buf.statistics().missing_datagrams);
+    TSUNIT_EQUAL(1, buf.statistics().late_datagrams);
+}
+
+TSUNIT_DEFINE_TEST(Delay)
+{
+    ts::RTPReorderBuffer buf;
+    buf.reset(100, cn::milliseconds(20));
+
+    std::vector<int> out;
+    ts::monotonic_time expiration {};
+    receive(buf, out, 10);
+    TSUNIT_ASSERT(!buf.expiration(expiration));
+    receive(buf, out, 12);
+    TSUNIT_ASSERT(out == std::vector<int>({10}));
+    TSUNIT_ASSERT(buf.expiration(expiration));
+    TSUNIT_ASSERT(expiration == _now + cn::milliseconds(20));
+    _now += cn::milliseconds(10);
+    receive(buf, out, 13);
+    TSUNIT_ASSERT(out == std::vector<int>({10}));
+    TSUNIT_ASSERT(buf.expiration(expiration));
+    TSUNIT_ASSERT(expiration == _now + cn::milliseconds(10));
+    _now += cn::milliseconds(15);
+    receive(buf, out, 14);
+    TSUNIT_ASSERT(out == std::vector<int>({10, 12, 13, 14}));
+    TSUNIT_EQUAL(1, buf.statistics().missing_datagrams);
+    TSUNIT_ASSERT(!buf.expiration(expiration));
+}
+
+TSUNIT_DEFINE_TEST(NonRTP)
+{
+    ts::RTPReorderBuffer buf;
+    buf.reset(8);
+
+    std::vector<int> out;
+    receive(buf, out, {10, 12});
+    receive(buf, out, 0, 0, false);
+    receive(buf, out, 11);
+    TSUNIT_ASSERT(out == std::vector<int>({10, -1, 11, 12}));
+    TSUNIT_EQUAL(1, buf.statistics().non_rtp_datagrams);
+    TSUNIT_EQUAL(3, buf.statistics().rtp_datagrams);
+}
+
+TSUNIT_DEFINE_TEST(Resync)
+{
+    ts::RTPReorderBuffer buf;
+    buf.reset(8);
+
+    std::vector<int> out;
+    receive(buf, out, {10, 11, 13});
+    receive(buf, out, 5000);
+    receive(buf, out, 5001);
+    TSUNIT_ASSERT(out == std::vector<int>({10, 11, 13, 5000, 5001}));
+    receive(buf, out, 7, 0x5678);
+    TSUNIT_ASSERT(out == std::vector<int>({10, 11, 13, 5000, 5001, 7}));
+    TSUNIT_EQUAL(2, buf.statistics().resync_count);
+    TSUNIT_EQUAL(0, buf.statistics().missing_datagrams);
+}
+
+TSUNIT_DEFINE_TEST(LargeDatagrams)
+{
+    // Bursts of 128 TS packets in one datagram, larger than a jumbo frame.
+    constexpr size_t dg_size = 128 * ts::PKT_SIZE;
+    static_assert(dg_size > ts::RTPReorderBuffer::DEFAULT_DATAGRAM_SIZE);
+
+    ts::RTPReorderBuffer buf;
+    buf.reset(8, cn::milliseconds::zero(), dg_size);
+    TSUNIT_EQUAL(dg_size, buf.receiveBufferSize());
+
+    // Each byte of the payload is a function of the sequence number.
+    // Return sequence numbers of returned datagrams.
+    ts::ByteBlock buffer(dg_size);
+    std::vector<int> out;
+    const auto receive = [&](uint16_t seq, size_t size) {
+        uint8_t* data = buf.receiveBuffer();
+        data[0] = 0x80;
+        data[1] = ts::RTP_PT_MP2T;
+        ts::PutUInt16(data + 2, seq);
+        ts::PutUInt32(data + 4, 0);
+        ts::PutUInt32(data + 8, 0x1234);
+        for (size_t i = ts::RTP_HEADER_SIZE; i < dg_size; ++i) {
+            data[i] = uint8_t(i + seq);
+        }
+        buf.commit(size, cn::microseconds(seq), ts::TimeSource::KERNEL, _now);
+
+        size_t ret_size = 0;
+        cn::microseconds timestamp {};
+        ts::TimeSource source = ts::TimeSource::UNDEFINED;
+        while (buf.getDatagram(buffer.data(), buffer.size(), ret_size, timestamp, source, _now)) {
+            TSUNIT_EQUAL(dg_size, ret_size);
+            const uint16_t ret_seq = ts::GetUInt16(buffer.data() + 2);
+            bool same = true;
+            for (size_t i = ts::RTP_HEADER_SIZE; same && i < dg_size; ++i) {
+                same = buffer[i] == uint8_t(i + ret_seq);
+            }
+            TSUNIT_ASSERT(same);
+            out.push_back(ret_seq);
+        }
+    };
+
+    receive(0, dg_size);
+    receive(2, dg_size);
+    receive(1, dg_size);
+    TSUNIT_ASSERT(out == std::vector<int>({0, 1, 2}));
+    TSUNIT_EQUAL(1, buf.statistics().reordered_datagrams);
+
+    // A datagram which was truncated on reception is dropped, not returned truncated.
+    receive(3, dg_size + 1);
+    receive(4, dg_size);
+    TSUNIT_ASSERT(out == std::vector<int>({0, 1, 2}));
+    TSUNIT_EQUAL(1, buf.statistics().oversized_datagrams);
+    TSUNIT_EQUAL(4, buf.statistics().rtp_datagrams);
+}
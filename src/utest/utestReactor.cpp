@@ -16,6 +16,9 @@
 #include "tsReactiveTCPServer.h"
 #include "tsReactiveServer.h"
 #include "tsReactiveTelnetConnection.h"
+#include "tstlvReactiveConnection.h"
+#include "tstlvConnection.h"
+#include "tsECMGSCS.h"
 #include "tsTime.h"
 #include "tsCerrReport.h"
 #include "tsSysUtils.h"
@@ -33,6 +36,7 @@ class ReactorTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(UDP);
     TSUNIT_DECLARE_TEST(Server);
     TSUNIT_DECLARE_TEST(Client);
+    TSUNIT_DECLARE_TEST(TLV);
 
 public:
     virtual void beforeTestSuite() override;
@@ -806,3 +810,175 @@ TSUNIT_DEFINE_TEST(Server)
     TSUNIT_ASSERT(reactor.processEventLoop());
     TSUNIT_ASSERT(reactor.close());
 }
+
+
+//----------------------------------------------------------------------------
+// Test TLV messages on a reactive server.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    //------------------------------------------------------------------------
+    // A client connection on the server side.
+    // Each channel_test is responded with a channel_status.
+    //------------------------------------------------------------------------
+
+    class TLVServerConnection:
+        public ts::ReactiveServerSessionInterface,
+        private ts::ReactiveTCPConnectionHandlerInterface,
+        private ts::tlv::ReactiveConnectionHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(TLVServerConnection);
+    public:
+        TLVServerConnection(ts::Reactor& reactor, ts::tlv::Logger& logger, const ts::ecmgscs::Protocol& protocol, std::ostream& debug);
+        virtual ~TLVServerConnection() override;
+
+    private:
+        std::ostream&                _debug;
+        const ts::ecmgscs::Protocol& _protocol;
+        ts::TCPConnection            _client {};
+        ts::ReactiveTCPConnection    _rclient;
+        ts::tlv::ReactiveConnection  _conn;
+
+        virtual ts::ReactiveTCPConnection& getConnection() override;
+        virtual void handleTCPAccepted(ts::ReactiveTCPServer& server, ts::ReactiveTCPConnection& sock, int error_code, const ts::ObjectPtr& user_data) override;
+        virtual void handleTLVMessage(ts::tlv::ReactiveConnection& conn, const ts::tlv::MessagePtr& msg, int error_code) override;
+    };
+
+    TLVServerConnection::TLVServerConnection(ts::Reactor& reactor, ts::tlv::Logger& logger, const ts::ecmgscs::Protocol& protocol, std::ostream& debug) :
+        _debug(debug),
+        _protocol(protocol),
+        _rclient(reactor, _client),
+        _conn(_rclient, logger, protocol, true, 3)
+    {
+        _rclient.whenAccepted(this);
+    }
+
+    TLVServerConnection::~TLVServerConnection()
+    {
+        _debug << "TLVServerConnection: destruction" << std::endl;
+    }
+
+    ts::ReactiveTCPConnection& TLVServerConnection::getConnection()
+    {
+        return _rclient;
+    }
+
+    void TLVServerConnection::handleTCPAccepted(ts::ReactiveTCPServer& server, ts::ReactiveTCPConnection& sock, int error_code, const ts::ObjectPtr& user_data)
+    {
+        _debug << "TLVServerConnection::handleTCPAccepted, error code: " << error_code << std::endl;
+        if (error_code == ts::SYS_SUCCESS) {
+            // Use a small buffer to make sure that messages are split over several receive operations.
+            TSUNIT_ASSERT(_conn.startReceive(this, 7));
+        }
+    }
+
+    void TLVServerConnection::handleTLVMessage(ts::tlv::ReactiveConnection& conn, const ts::tlv::MessagePtr& msg, int error_code)
+    {
+        TSUNIT_ASSERT(&conn == &_conn);
+        if (error_code != ts::SYS_SUCCESS) {
+            _debug << "TLVServerConnection::handleTLVMessage, error code: " << error_code << std::endl;
+            TSUNIT_EQUAL(ts::SYS_EOF, error_code);
+            TSUNIT_ASSERT(msg == nullptr);
+            TSUNIT_ASSERT(_rclient.startClose(nullptr));
+        }
+        else {
+            TSUNIT_ASSERT(msg != nullptr);
+            TSUNIT_EQUAL(ts::ecmgscs::Tags::channel_test, msg->tag());
+            const auto test = std::dynamic_pointer_cast<ts::ecmgscs::ChannelTest>(msg);
+            TSUNIT_ASSERT(test != nullptr);
+            ts::ecmgscs::ChannelStatus resp(_protocol);
+            resp.channel_id = test->channel_id;
+            TSUNIT_ASSERT(_conn.startSendMessage(resp));
+        }
+    }
+
+    //------------------------------------------------------------------------
+    // Factory for server sessions.
+    //------------------------------------------------------------------------
+
+    class TLVFactory: public ts::ReactiveServerFactoryInterface
+    {
+        TS_NOBUILD_NOCOPY(TLVFactory);
+    public:
+        TLVFactory(ts::Reactor& reactor, ts::tlv::Logger& logger, const ts::ecmgscs::Protocol& protocol, std::ostream& debug) :
+            _reactor(reactor), _logger(logger), _protocol(protocol), _debug(debug) {}
+
+    private:
+        ts::Reactor&                 _reactor;
+        ts::tlv::Logger&             _logger;
+        const ts::ecmgscs::Protocol& _protocol;
+        std::ostream&                _debug;
+
+        virtual ts::ReactiveServerSessionInterface* newClientSession() override
+        {
+            return new TLVServerConnection(_reactor, _logger, _protocol, _debug);
+        }
+    };
+}
+
+TSUNIT_DEFINE_TEST(TLV)
+{
+    static constexpr uint16_t PORT = 12346;
+    static constexpr uint16_t COUNT = 20;
+
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const ts::ecmgscs::Protocol protocol;
+    ts::tlv::Logger       logger(CERR, ts::Severity::Debug);
+    ts::Reactor           reactor(&CERR);
+    TLVFactory            factory(reactor, logger, protocol, debug());
+    ts::TCPServer         tcp_server(&CERR);
+    ts::ReactiveTCPServer rtcp_server(reactor, tcp_server);
+    ts::ReactiveServer    server(rtcp_server);
+
+    TSUNIT_ASSERT(reactor.open());
+
+    TSUNIT_ASSERT(tcp_server.open(ts::IP::v4));
+    TSUNIT_ASSERT(tcp_server.reusePort(true));
+    TSUNIT_ASSERT(tcp_server.bind(ts::IPSocketAddress(ts::IPAddress::LocalHost4, PORT)));
+    TSUNIT_ASSERT(tcp_server.listen(5));
+
+    server.setExitAfterClientCount(1);
+    server.setExitEventLoop(true);
+    server.start(&factory);
+
+    // Blocking client in a separate thread.
+    size_t status_count = 0;
+    size_t error_count = 0;
+    std::thread client([&]() {
+        ts::tlv::Connection<ts::ThreadSafety::None> conn(logger, protocol, false);
+        if (!conn.open(ts::IP::v4) || !conn.connect(ts::IPSocketAddress(ts::IPAddress::LocalHost4, PORT))) {
+            return;
+        }
+        for (uint16_t i = 0; i < COUNT; ++i) {
+            ts::ecmgscs::ChannelTest msg(protocol);
+            msg.channel_id = i;
+            conn.sendMessage(msg);
+            if (i == COUNT / 2) {
+                // Invalid message: unknown tag.
+                const uint8_t invalid[] = {protocol.version(), 0x7F, 0xFF, 0x00, 0x00};
+                conn.send(invalid, sizeof(invalid));
+            }
+        }
+        ts::tlv::MessagePtr msg;
+        for (size_t i = 0; i < COUNT + 1 && conn.receiveMessage(msg); ++i) {
+            const auto status = std::dynamic_pointer_cast<ts::ecmgscs::ChannelStatus>(msg);
+            if (status != nullptr && status->channel_id == status_count) {
+                status_count++;
+            }
+            else if (std::dynamic_pointer_cast<ts::ecmgscs::ChannelError>(msg) != nullptr) {
+                error_count++;
+            }
+        }
+        conn.disconnect();
+        conn.close();
+    });
+
+    const bool ok = reactor.processEventLoop();
+    client.join();
+    TSUNIT_ASSERT(ok);
+    TSUNIT_ASSERT(reactor.close());
+    TSUNIT_EQUAL(COUNT, status_count);
+    TSUNIT_EQUAL(1, error_count);
+}
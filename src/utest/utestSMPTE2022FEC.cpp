@@ -0,0 +1,291 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for SMPTE 2022-1 FEC encoder and decoder.
+//
+//----------------------------------------------------------------------------
+
+#include "tsSMPTE2022FECEncoder.h"
+#include "tsSMPTE2022FECDecoder.h"
+#include "tsTS.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class SMPTE2022FECTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Encoder);
+    TSUNIT_DECLARE_TEST(NoLoss);
+    TSUNIT_DECLARE_TEST(ColumnRecovery);
+    TSUNIT_DECLARE_TEST(IterativeRecovery);
+    TSUNIT_DECLARE_TEST(Reorder);
+    TSUNIT_DECLARE_TEST(Unrecoverable);
+    TSUNIT_DECLARE_TEST(HeaderExtension);
+
+public:
+    virtual void beforeTest() override;
+
+private:
+    std::vector<ts::ByteBlock> _media {};
+
+    // Run the encoder and the decoder, dropping some media packets.
+    // Media packets are sent in the order of the "order" vector, when not empty.
+    // Return the list of output packets from the decoder.
+    void run(ts::SMPTE2022FECDecoder& dec,
+             size_t columns,
+             size_t rows,
+             bool row_fec,
+             const std::set<size_t>& dropped,
+             std::vector<ts::ByteBlock>& output,
+             const std::vector<size_t>& order = std::vector<size_t>());
+};
+
+TSUNIT_REGISTER(SMPTE2022FECTest);
+
+void SMPTE2022FECTest::beforeTest()
+{
+    // 200 RTP packets, sequence numbers wrap after the first few ones.
+    // Most payloads have 7 TS packets, some are shorter.
+    _media.clear();
+    uint32_t x = 0x87654321;
+    for (size_t i = 0; i < 200; ++i) {
+        ts::ByteBlock& pkt(_media.emplace_back(ts::RTP_HEADER_SIZE + (i % 11 == 5 ? 3 : 7) * ts::PKT_SIZE));
+        pkt[0] = 0x80;
+        pkt[1] = ts::RTP_PT_MP2T;
+        ts::PutUInt16(&pkt[2], uint16_t(0xFFF8 + i));
+        ts::PutUInt32(&pkt[4], uint32_t(1000 * i));
+        ts::PutUInt32(&pkt[8], 0x11223344);
+        for (size_t j = ts::RTP_HEADER_SIZE; j < pkt.size(); ++j) {
+            x = x * 1103515245 + 12345;
+            pkt[j] = uint8_t(x >> 16);
+        }
+    }
+}
+
+void SMPTE2022FECTest::run(ts::SMPTE2022FECDecoder& dec,
+                           size_t columns,
+                           size_t rows,
+                           bool row_fec,
+                           const std::set<size_t>& dropped,
+                           std::vector<ts::ByteBlock>& output,
+                           const std::vector<size_t>& order)
+{
+    ts::SMPTE2022FECEncoder enc;
+    TSUNIT_ASSERT(enc.reset(columns, rows, row_fec, NULLREP));
+
+    // Generate all FEC packets first.
+    std::vector<ts::ByteBlock> columns_fec(_media.size());
+    std::vector<ts::ByteBlock> rows_fec(_media.size());
+    for (size_t i = 0; i < _media.size(); ++i) {
+        TSUNIT_ASSERT(enc.addPacket(_media[i].data(), _media[i].size()));
+        if (enc.columnPacketReady()) {
+            columns_fec[i] = enc.columnPacket();
+        }
+        if (enc.rowPacketReady()) {
+            rows_fec[i] = enc.rowPacket();
+        }
+    }
+
+    // Feed the decoder, FEC packets after the last protected packet.
+    output.clear();
+    ts::ByteBlock buffer(2000);
+    size_t size = 0;
+    for (size_t n = 0; n < _media.size(); ++n) {
+        const size_t i = order.empty() ? n : order[n];
+        if (dropped.find(i) == dropped.end()) {
+            TSUNIT_ASSERT(dec.addMediaPacket(_media[i].data(), _media[i].size()));
+        }
+        if (!columns_fec[i].empty()) {
+            TSUNIT_ASSERT(dec.addFECPacket(columns_fec[i].data(), columns_fec[i].size()));
+        }
+        if (!rows_fec[i].empty()) {
+            TSUNIT_ASSERT(dec.addFECPacket(rows_fec[i].data(), rows_fec[i].size()));
+        }
+        while (dec.getPacket(buffer.data(), buffer.size(), size)) {
+            output.emplace_back(buffer.data(), size);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Encoder)
+{
+    ts::SMPTE2022FECEncoder enc;
+    TSUNIT_ASSERT(!enc.reset(21, 4, true, NULLREP));
+    TSUNIT_ASSERT(!enc.reset(5, 3, true, NULLREP));
+    TSUNIT_ASSERT(!enc.reset(10, 11, true, NULLREP));
+    TSUNIT_ASSERT(enc.reset(5, 4, true, NULLREP));
+    TSUNIT_EQUAL(5, enc.columns());
+    TSUNIT_EQUAL(4, enc.rows());
+
+    size_t column_count = 0;
+    size_t row_count = 0;
+    for (size_t i = 0; i < 20; ++i) {
+        TSUNIT_ASSERT(enc.addPacket(_media[i].data(), _media[i].size()));
+        if (enc.columnPacketReady()) {
+            // Column FEC packets on the last row of the matrix.
+            TSUNIT_ASSERT(i >= 15);
+            const ts::ByteBlock& fec(enc.columnPacket());
+            TSUNIT_EQUAL(ts::RTP_HEADER_SIZE + ts::FEC2022_HEADER_SIZE + 7 * ts::PKT_SIZE, fec.size());
+            TSUNIT_EQUAL(ts::FEC2022_RTP_PT, fec[1]);
+            TSUNIT_EQUAL(column_count, ts::GetUInt16(&fec[2]));
+            TSUNIT_EQUAL(uint16_t(0xFFF8 + i - 15), ts::GetUInt16(&fec[12]));
+            TSUNIT_EQUAL(0x00, fec[24] & 0x40);
+            TSUNIT_EQUAL(5, fec[25]);
+            TSUNIT_EQUAL(4, fec[26]);
+            column_count++;
+        }
+        if (enc.rowPacketReady()) {
+            // Row FEC packets on the last column of the matrix.
+            TSUNIT_EQUAL(4, i % 5);
+            const ts::ByteBlock& fec(enc.rowPacket());
+            TSUNIT_EQUAL(uint16_t(0xFFF8 + i - 4), ts::GetUInt16(&fec[12]));
+            TSUNIT_EQUAL(0x40, fec[24] & 0x40);
+            TSUNIT_EQUAL(1, fec[25]);
+            TSUNIT_EQUAL(5, fec[26]);
+            row_count++;
+        }
+    }
+    TSUNIT_EQUAL(5, column_count);
+    TSUNIT_EQUAL(4, row_count);
+}
+
+TSUNIT_DEFINE_TEST(NoLoss)
+{
+    ts::SMPTE2022FECDecoder dec;
+    std::vector<ts::ByteBlock> output;
+    run(dec, 10, 10, true, {}, output);
+
+    TSUNIT_EQUAL(_media.size(), output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        TSUNIT_ASSERT(output[i] == _media[i]);
+    }
+    TSUNIT_EQUAL(200, dec.statistics().media_packets);
+    TSUNIT_EQUAL(20, dec.statistics().column_packets);
+    TSUNIT_EQUAL(20, dec.statistics().row_packets);
+    TSUNIT_EQUAL(0, dec.statistics().recovered_packets);
+    TSUNIT_EQUAL(0, dec.statistics().lost_packets);
+}
+
+TSUNIT_DEFINE_TEST(ColumnRecovery)
+{
+    // A burst of L packets is lost, one in each column, including a short one.
+    ts::SMPTE2022FECDecoder dec;
+    std::vector<ts::ByteBlock> output;
+    run(dec, 8, 5, false, {20, 21, 22, 23, 24, 25, 26, 27}, output);
+
+    TSUNIT_EQUAL(_media.size(), output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        TSUNIT_ASSERT(output[i] == _media[i]);
+    }
+    TSUNIT_EQUAL(192, dec.statistics().media_packets);
+    TSUNIT_EQUAL(0, dec.statistics().row_packets);
+    TSUNIT_EQUAL(8, dec.statistics().recovered_packets);
+    TSUNIT_EQUAL(0, dec.statistics().lost_packets);
+}
+
+TSUNIT_DEFINE_TEST(IterativeRecovery)
+{
+    // Matrix 4x4, packets 0-15. Lost packets: 1, 2, 5 (row 0: 1,2; row 1: 5; column 1: 1,5; column 2: 2).
+    // Packet 2 is recovered by column 2, then packet 1 by row 0, then packet 5 by column 1 or row 1.
+    ts::SMPTE2022FECDecoder dec;
+    std::vector<ts::ByteBlock> output;
+    run(dec, 4, 4, true, {1, 2, 5}, output);
+
+    TSUNIT_EQUAL(_media.size(), output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        TSUNIT_ASSERT(output[i] == _media[i]);
+    }
+    TSUNIT_EQUAL(3, dec.statistics().recovered_packets);
+    TSUNIT_EQUAL(0, dec.statistics().lost_packets);
+}
+
+TSUNIT_DEFINE_TEST(Reorder)
+{
+    // Swap a few packets, no loss, no FEC recovery needed.
+    std::vector<size_t> order(_media.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::swap(order[10], order[12]);
+    std::swap(order[50], order[51]);
+    std::swap(order[100], order[130]);
+
+    ts::SMPTE2022FECDecoder dec;
+    std::vector<ts::ByteBlock> output;
+    run(dec, 10, 10, true, {}, output, order);
+
+    TSUNIT_EQUAL(_media.size(), output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        TSUNIT_ASSERT(output[i] == _media[i]);
+    }
+    TSUNIT_EQUAL(0, dec.statistics().lost_packets);
+    TSUNIT_EQUAL(0, dec.statistics().late_packets);
+}
+
+TSUNIT_DEFINE_TEST(Unrecoverable)
+{
+    // Two packets lost in the same column without row FEC. Small reorder window.
+    ts::SMPTE2022FECDecoder dec(20);
+    std::vector<ts::ByteBlock> output;
+    run(dec, 5, 5, false, {31, 36}, output);
+
+    TSUNIT_EQUAL(_media.size() - 2, output.size());
+    TSUNIT_EQUAL(0, dec.statistics().recovered_packets);
+    TSUNIT_EQUAL(2, dec.statistics().lost_packets);
+    for (size_t i = 0; i < output.size(); ++i) {
+        TSUNIT_ASSERT(output[i] == _media[i < 31 ? i : (i < 35 ? i + 1 : i + 2)]);
+    }
+}
+
+TSUNIT_DEFINE_TEST(HeaderExtension)
+{
+    // Add a CSRC list and a header extension in all odd media packets.
+    // The protected payload starts after the complete RTP header.
+    for (size_t i = 1; i < _media.size(); i += 2) {
+        ts::ByteBlock& pkt(_media[i]);
+        const uint8_t ext[16] = {
+            0x11, 0x11, 0x11, 0x11, 0x22, 0x22, 0x22, 0x22,  // 2 CSRC
+            0xBE, 0xDE, 0x00, 0x01, 0x33, 0x33, 0x33, 0x33,  // extension header, one 32-bit word
+        };
+        pkt.insert(pkt.begin() + ts::RTP_HEADER_SIZE, ext, ext + sizeof(ext));
+        pkt[0] |= 0x12;  // X=1, CC=2
+        TSUNIT_EQUAL(ts::RTP_HEADER_SIZE + sizeof(ext), ts::RTPHeaderSize(pkt.data(), pkt.size()));
+    }
+
+    // Lose 8 consecutive packets, one in each column, with and without header extension.
+    ts::SMPTE2022FECDecoder dec;
+    std::vector<ts::ByteBlock> output;
+    run(dec, 8, 5, false, {20, 21, 22, 23, 24, 25, 26, 27}, output);
+
+    TSUNIT_EQUAL(_media.size(), output.size());
+    for (size_t i = 0; i < output.size(); ++i) {
+        if (i < 20 || i > 27) {
+            TSUNIT_ASSERT(output[i] == _media[i]);
+        }
+        else {
+            // Recovered packets have a fixed RTP header, without CSRC and extension.
+            const size_t hsize = ts::RTPHeaderSize(_media[i].data(), _media[i].size());
+            TSUNIT_EQUAL(ts::RTP_HEADER_SIZE, ts::RTPHeaderSize(output[i].data(), output[i].size()));
+            TSUNIT_EQUAL(_media[i].size() - hsize, output[i].size() - ts::RTP_HEADER_SIZE);
+            TSUNIT_EQUAL(ts::GetUInt16(&_media[i][2]), ts::GetUInt16(&output[i][2]));
+            TSUNIT_EQUAL(ts::GetUInt32(&_media[i][4]), ts::GetUInt32(&output[i][4]));
+            TSUNIT_ASSERT(ts::MemEqual(_media[i].data() + hsize, output[i].data() + ts::RTP_HEADER_SIZE, _media[i].size() - hsize));
+        }
+    }
+    TSUNIT_EQUAL(8, dec.statistics().recovered_packets);
+    TSUNIT_EQUAL(0, dec.statistics().lost_packets);
+}
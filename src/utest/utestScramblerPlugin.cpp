@@ -0,0 +1,276 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for the scrambler plugin, with several services.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsTSProcessor.h"
+#include "tsCyclingPacketizer.h"
+#include "tsSectionDemux.h"
+#include "tsBinaryTable.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsCADescriptor.h"
+#include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "utestFakeECMG.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class ScramblerPluginTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(MultiService);
+};
+
+TSUNIT_REGISTER(ScramblerPluginTest);
+
+
+//----------------------------------------------------------------------------
+// Test stream: two services with one video PID each, and null packets.
+//----------------------------------------------------------------------------
+
+namespace {
+    constexpr uint16_t ECMG_PORT = 12348;
+    constexpr ts::PID PID_PMT1 = 0x100;
+    constexpr ts::PID PID_VIDEO1 = 0x101;
+    constexpr ts::PID PID_PMT2 = 0x200;
+    constexpr ts::PID PID_VIDEO2 = 0x201;
+
+    void BuildStream(ts::TSPacketVector& packets)
+    {
+        ts::DuckContext duck;
+
+        ts::PAT pat(1, true, 0x1234);
+        pat.pmts[1] = PID_PMT1;
+        pat.pmts[2] = PID_PMT2;
+        ts::PMT pmt1(1, true, 1, PID_VIDEO1);
+        pmt1.streams[PID_VIDEO1].stream_type = ts::ST_MPEG2_VIDEO;
+        ts::PMT pmt2(1, true, 2, PID_VIDEO2);
+        pmt2.streams[PID_VIDEO2].stream_type = ts::ST_MPEG2_VIDEO;
+
+        ts::CyclingPacketizer pat_pzer(duck, ts::PID_PAT);
+        ts::CyclingPacketizer pmt1_pzer(duck, PID_PMT1);
+        ts::CyclingPacketizer pmt2_pzer(duck, PID_PMT2);
+        pat_pzer.addTable(duck, pat);
+        pmt1_pzer.addTable(duck, pmt1);
+        pmt2_pzer.addTable(duck, pmt2);
+
+        uint8_t cc1 = 0;
+        uint8_t cc2 = 0;
+        packets.clear();
+        for (size_t i = 0; i < 8'000; ++i) {
+            ts::TSPacket pkt;
+            if (i % 500 == 0) {
+                pat_pzer.getNextPacket(pkt);
+            }
+            else if (i % 500 == 1) {
+                pmt1_pzer.getNextPacket(pkt);
+            }
+            else if (i % 500 == 2) {
+                pmt2_pzer.getNextPacket(pkt);
+            }
+            else if (i % 3 == 0) {
+                pkt.init(PID_VIDEO1, cc1++ & ts::CC_MASK, uint8_t(i));
+            }
+            else if (i % 3 == 1) {
+                pkt.init(PID_VIDEO2, cc2++ & ts::CC_MASK, uint8_t(i));
+            }
+            else {
+                pkt = ts::NullPacket;
+            }
+            packets.push_back(pkt);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Event handlers for memory input and output plugins.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Input : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Input);
+    public:
+        Input(const ts::TSPacketVector& packets) : _packets(packets) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        const ts::TSPacketVector& _packets;
+        size_t _next = 0;
+    };
+
+    void Input::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr && _next < _packets.size()) {
+            const size_t count = std::min(_packets.size() - _next, data->remainingSize() / ts::PKT_SIZE);
+            data->append(&_packets[_next], count * ts::PKT_SIZE);
+            _next += count;
+        }
+    }
+
+    class Output : public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(Output);
+    public:
+        Output(ts::TSPacketVector& packets) : _packets(packets) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        ts::TSPacketVector& _packets;
+    };
+
+    void Output::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            const size_t count = data->size() / ts::PKT_SIZE;
+            const size_t index = _packets.size();
+            _packets.resize(index + count);
+            ts::TSPacket::Copy(&_packets[index], data->data(), count);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Analysis of the scrambled stream: ECM PID's from the PMT's, then ECM's.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Analyzer : private ts::TableHandlerInterface, private ts::SectionHandlerInterface
+    {
+        TS_NOCOPY(Analyzer);
+    public:
+        Analyzer();
+        void feedPacket(const ts::TSPacket& pkt) { _demux.feedPacket(pkt); }
+
+        std::map<uint16_t, ts::PID> ecm_pids {};        // ECM PID, indexed by service id.
+        std::map<ts::PID, std::set<uint16_t>> ecms {};  // ECM_stream_id of ECM's, indexed by ECM PID.
+
+    private:
+        ts::DuckContext  _duck {};
+        ts::SectionDemux _demux {_duck, this, this};
+
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable&) override;
+        virtual void handleSection(ts::SectionDemux&, const ts::Section&) override;
+    };
+
+    Analyzer::Analyzer()
+    {
+        _demux.addPID(PID_PMT1);
+        _demux.addPID(PID_PMT2);
+    }
+
+    void Analyzer::handleTable(ts::SectionDemux& demux, const ts::BinaryTable& table)
+    {
+        if (table.tableId() == ts::TID_PMT) {
+            const ts::PMT pmt(_duck, table);
+            ts::CADescriptor ca;
+            if (pmt.isValid() && pmt.descs.search(_duck, ts::DID_MPEG_CA, ca) < pmt.descs.count()) {
+                TSUNIT_EQUAL(0x1234, ca.cas_id);
+                ecm_pids[pmt.service_id] = ca.ca_pid;
+                demux.addPID(ca.ca_pid);
+            }
+        }
+    }
+
+    void Analyzer::handleSection(ts::SectionDemux&, const ts::Section& section)
+    {
+        if (section.tableId() == utest::FakeECMG::ECM_TID) {
+            ecms[section.sourcePID()].insert(utest::FakeECMG::StreamIdOf(section));
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(MultiService)
+{
+    utest::FakeECMG ecmg(ECMG_PORT);
+    TSUNIT_ASSERT(ecmg.listen());
+    ecmg.start();
+
+    ts::TSPacketVector input_packets;
+    ts::TSPacketVector output_packets;
+    BuildStream(input_packets);
+    Input input(input_packets);
+    Output output(output_packets);
+
+    // 8000 packets at 1 Mb/s last about 12 seconds, several 2-second crypto-periods.
+    ts::TSProcessorArgs opt;
+    opt.fixed_bitrate = 1'000'000;
+    opt.input = {u"memory", {}};
+    opt.plugins = {
+        {u"scrambler", {u"1", u"2",
+                        u"--ecmg", ts::UString::Format(u"127.0.0.1:%d", ECMG_PORT),
+                        u"--ecmg-scs-version", u"3",
+                        u"--super-cas-id", u"0x12340000",
+                        u"--cp-duration", u"2",
+                        u"--synchronous"}},
+    };
+    opt.output = {u"memory", {}};
+
+    ts::TSProcessor tsp(debugMode() ? *static_cast<ts::Report*>(&CERR) : *static_cast<ts::Report*>(&NULLREP));
+    tsp.registerEventHandler(&input, ts::PluginType::INPUT);
+    tsp.registerEventHandler(&output, ts::PluginType::OUTPUT);
+    TSUNIT_ASSERT(tsp.start(opt));
+    tsp.waitForTermination();
+    ecmg.waitForTermination();
+
+    // One ECM stream per service in the same channel, all closed at the end.
+    TSUNIT_EQUAL(2, ecmg.streams.size());
+    TSUNIT_EQUAL(1, ecmg.streams[1]);
+    TSUNIT_EQUAL(2, ecmg.streams[2]);
+    TSUNIT_ASSERT(ecmg.ecm_count[1] >= 4);
+    TSUNIT_ASSERT(ecmg.ecm_count[2] >= 4);
+    TSUNIT_ASSERT(ecmg.closed == std::vector<uint16_t>({1, 2}));
+    TSUNIT_ASSERT(ecmg.channel_closed);
+
+    // Check the scrambling of each service, including crypto-period changes.
+    TSUNIT_EQUAL(input_packets.size(), output_packets.size());
+    Analyzer analyzer;
+    std::map<ts::PID, std::set<uint8_t>> parities;
+    std::map<ts::PID, bool> scrambling_started;
+    for (const auto& pkt : output_packets) {
+        analyzer.feedPacket(pkt);
+        const ts::PID pid = pkt.getPID();
+        if (pid == PID_VIDEO1 || pid == PID_VIDEO2) {
+            if (pkt.isScrambled()) {
+                scrambling_started[pid] = true;
+                parities[pid].insert(pkt.getScrambling());
+            }
+            else {
+                // Once started, scrambling never stops.
+                TSUNIT_ASSERT(!scrambling_started[pid]);
+            }
+        }
+    }
+    TSUNIT_ASSERT(scrambling_started[PID_VIDEO1]);
+    TSUNIT_ASSERT(scrambling_started[PID_VIDEO2]);
+    TSUNIT_EQUAL(2, parities[PID_VIDEO1].size());
+    TSUNIT_EQUAL(2, parities[PID_VIDEO2].size());
+
+    // Each service has its own ECM PID in its PMT, carrying the ECM's of its own ECM stream.
+    TSUNIT_EQUAL(2, analyzer.ecm_pids.size());
+    const ts::PID ecm_pid1 = analyzer.ecm_pids[1];
+    const ts::PID ecm_pid2 = analyzer.ecm_pids[2];
+    TSUNIT_ASSERT(ecm_pid1 != ecm_pid2);
+    TSUNIT_ASSERT(analyzer.ecms[ecm_pid1] == std::set<uint16_t>({1}));
+    TSUNIT_ASSERT(analyzer.ecms[ecm_pid2] == std::set<uint16_t>({2}));
+}
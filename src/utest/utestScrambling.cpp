@@ -6,11 +6,13 @@
 //
 //----------------------------------------------------------------------------
 //
-//  TSUnit test suite for class ts::DVBCSA2
+//  TSUnit test suite for class ts::DVBCSA2 and ts::TSScrambling
 //
 //----------------------------------------------------------------------------
 
 #include "tsDVBCSA2.h"
+#include "tsTSScrambling.h"
+#include "tsNullReport.h"
 #include "tsTSPacket.h"
 #include "tsNames.h"
 #include "tsunit.h"
@@ -23,6 +25,7 @@
 class ScramblingTest: public tsunit::Test
 {
     TSUNIT_DECLARE_TEST(Scrambling);
+    TSUNIT_DECLARE_TEST(Batch);
 };
 
 TSUNIT_REGISTER(ScramblingTest);
@@ -166,3 +169,71 @@ TSUNIT_DEFINE_TEST(Scrambling)
         TSUNIT_EQUAL(0, ts::MemCompare(pkt.b + header_size, vec->cipher.b + header_size, payload_size));
     }
 }
+
+// Batch encryption and decryption must be identical to packet by packet.
+TSUNIT_DEFINE_TEST(Batch)
+{
+    static const uint8_t types[] = {ts::SCRAMBLING_DVB_CISSA1, ts::SCRAMBLING_ATIS_IIF_IDSA, ts::SCRAMBLING_DVB_CSA2};
+    constexpr size_t count = 40;
+
+    // Clear packets with all sorts of payload sizes, including empty and short payloads.
+    ts::TSPacketVector plain(count);
+    for (size_t i = 0; i < count; ++i) {
+        plain[i].init(100, uint8_t(i), uint8_t(i));
+        for (size_t j = 0; j < ts::PKT_MAX_PAYLOAD_SIZE; ++j) {
+            plain[i].b[ts::PKT_HEADER_SIZE + j] = uint8_t(i * 7 + j * 13);
+        }
+        TSUNIT_ASSERT(plain[i].setPayloadSize(ts::PKT_MAX_PAYLOAD_SIZE - (i * 37) % (ts::PKT_MAX_PAYLOAD_SIZE + 1)));
+    }
+    TSUNIT_ASSERT(plain[5].setPayloadSize(0));
+    TSUNIT_ASSERT(plain[6].setPayloadSize(7));
+    TSUNIT_ASSERT(plain[7].setPayloadSize(16));
+    TSUNIT_ASSERT(plain[8].setPayloadSize(17));
+
+    for (uint8_t type : types) {
+        debug() << "ScramblingTest::Batch: type " << ts::NameFromSection(u"dtv", u"ScramblingMode", type) << std::endl;
+
+        ts::TSScrambling single(NULLREP, type);
+        ts::TSScrambling batch(NULLREP, type);
+        TSUNIT_EQUAL(type != ts::SCRAMBLING_DVB_CSA2, batch.hasBatchEngine());
+
+        ts::ByteBlock cw0(single.cwSize()), cw1(single.cwSize());
+        for (size_t i = 0; i < cw0.size(); ++i) {
+            cw0[i] = uint8_t(0x10 + i);
+            cw1[i] = uint8_t(0xA0 - i);
+        }
+        TSUNIT_ASSERT(single.setCW(cw0, 0) && single.setCW(cw1, 1));
+        TSUNIT_ASSERT(batch.setCW(cw0, 0) && batch.setCW(cw1, 1));
+
+        // Encrypt the first half with the even key, the second half with the odd key.
+        ts::TSPacketVector ref(plain);
+        ts::TSPacketVector pkts(plain);
+        std::vector<ts::TSPacket*> addr(count);
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(single.setEncryptParity(i < count / 2 ? 0 : 1));
+            TSUNIT_ASSERT(single.encrypt(ref[i]));
+            addr[i] = &pkts[i];
+        }
+        TSUNIT_ASSERT(batch.setEncryptParity(0));
+        TSUNIT_ASSERT(batch.encrypt(addr.data(), count / 2));
+        TSUNIT_ASSERT(batch.setEncryptParity(1));
+        TSUNIT_ASSERT(batch.encrypt(addr.data() + count / 2, count - count / 2));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(0, ts::MemCompare(ref[i].b, pkts[i].b, ts::PKT_SIZE));
+        }
+        TSUNIT_ASSERT(ref[0].isScrambled());
+
+        // Already encrypted packets are rejected.
+        TSUNIT_ASSERT(!batch.encrypt(addr.data(), count));
+
+        // Decrypt all packets in one batch, with both parities.
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_ASSERT(single.decrypt(ref[i]));
+        }
+        TSUNIT_ASSERT(batch.decrypt(addr.data(), count));
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(0, ts::MemCompare(plain[i].b, ref[i].b, ts::PKT_SIZE));
+            TSUNIT_EQUAL(0, ts::MemCompare(plain[i].b, pkts[i].b, ts::PKT_SIZE));
+        }
+    }
+}
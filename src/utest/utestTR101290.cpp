@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for ETSI TR 101 290 analysis.
+//
+//----------------------------------------------------------------------------
+
+#include "tstr101290MultiStreamAnalyzer.h"
+#include "tsjsonObject.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TR101290Test: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(MultiStreamCounters);
+    TSUNIT_DECLARE_TEST(MultiStreamDropped);
+
+private:
+    // Build packets on one PID with continuous CC, with transport error or bad sync byte on some packets.
+    static ts::TSPacketVector MakePackets(size_t count, size_t tei_count, size_t bad_sync_count);
+};
+
+TSUNIT_REGISTER(TR101290Test);
+
+ts::TSPacketVector TR101290Test::MakePackets(size_t count, size_t tei_count, size_t bad_sync_count)
+{
+    ts::TSPacketVector packets(count);
+    for (size_t i = 0; i < count; ++i) {
+        packets[i].init(100, uint8_t(i));
+        packets[i].setTEI(i < tei_count);
+        if (i >= count - bad_sync_count) {
+            packets[i].b[0] = 0x46;
+        }
+    }
+    return packets;
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(MultiStreamCounters)
+{
+    ts::tr101290::MultiStreamAnalyzer msa(NULLREP);
+    msa.setThreadCount(2);
+    TSUNIT_EQUAL(0, msa.addStream(u"A"));
+    TSUNIT_EQUAL(1, msa.addStream(u"B"));
+    TSUNIT_EQUAL(2, msa.addStream(u"C"));
+    TSUNIT_EQUAL(3, msa.streamCount());
+    TSUNIT_ASSERT(msa.start());
+
+    // All packets with the same timestamp, no time-based error.
+    const ts::TSPacketVector a(MakePackets(20, 4, 0));
+    const ts::TSPacketVector b(MakePackets(10, 0, 3));
+    const ts::TSPacketVector c(MakePackets(7, 2, 1));
+    const ts::PCR timestamp(1000);
+    for (size_t i = 0; i < a.size(); i += 5) {
+        msa.feedPackets(0, timestamp, &a[i], 5);
+    }
+    msa.feedPackets(1, timestamp, b.data(), b.size());
+    msa.feedPackets(2, timestamp, c.data(), c.size());
+
+    // Pending packets are analyzed before stopping.
+    msa.stop();
+
+    ts::tr101290::MultiStreamAnalyzer::Status sa, sb, sc;
+    TSUNIT_ASSERT(msa.getStatus(0, sa));
+    TSUNIT_ASSERT(msa.getStatus(1, sb));
+    TSUNIT_ASSERT(msa.getStatus(2, sc));
+    TSUNIT_ASSERT(!msa.getStatus(3, sc));
+    TSUNIT_EQUAL(u"A", sa.name);
+    TSUNIT_EQUAL(20, sa.packets);
+    TSUNIT_EQUAL(10, sb.packets);
+    TSUNIT_EQUAL(7, sc.packets);
+    TSUNIT_EQUAL(4, sa.counters[ts::tr101290::Transport_error]);
+    TSUNIT_EQUAL(0, sb.counters[ts::tr101290::Transport_error]);
+    TSUNIT_EQUAL(2, sc.counters[ts::tr101290::Transport_error]);
+    TSUNIT_EQUAL(0, sa.counters[ts::tr101290::Sync_byte_error]);
+    TSUNIT_EQUAL(3, sb.counters[ts::tr101290::Sync_byte_error]);
+    TSUNIT_EQUAL(1, sc.counters[ts::tr101290::Sync_byte_error]);
+    TSUNIT_EQUAL(20, sa.counters[ts::tr101290::packet_count]);
+
+    // The total in the JSON status is the sum of all streams, for all counters.
+    ts::json::Object root;
+    msa.getStatus(root);
+    const ts::json::Value& total(root.value(u"total"));
+    TSUNIT_EQUAL(37, total.value(u"packets").toInteger());
+    TSUNIT_EQUAL(0, total.value(u"dropped").toInteger());
+    TSUNIT_EQUAL(3, root.value(u"streams").size());
+    TSUNIT_EQUAL(u"C", root.value(u"streams").at(2).value(u"name").toString());
+    const auto& desc(ts::tr101290::GetCounterDescriptions());
+    for (size_t i = 0; i < desc.size(); ++i) {
+        TSUNIT_EQUAL(sa.counters[i] + sb.counters[i] + sc.counters[i], size_t(total.value(u"counters").value(desc[i].name).toInteger()));
+    }
+    TSUNIT_EQUAL(6, total.value(u"counters").value(u"Transport_error").toInteger());
+    TSUNIT_EQUAL(4, total.value(u"counters").value(u"Sync_byte_error").toInteger());
+}
+
+TSUNIT_DEFINE_TEST(MultiStreamDropped)
+{
+    ts::tr101290::MultiStreamAnalyzer msa(NULLREP);
+    msa.setThreadCount(1);
+    msa.setMaxPendingPackets(10);
+    TSUNIT_EQUAL(0, msa.addStream(u"A"));
+    TSUNIT_EQUAL(1, msa.addStream(u"B"));
+    TSUNIT_ASSERT(msa.start());
+
+    // One batch larger than the maximum number of pending packets: the excess is dropped.
+    const ts::TSPacketVector packets(MakePackets(25, 0, 0));
+    msa.feedPackets(0, ts::PCR(1000), packets.data(), packets.size());
+    msa.feedPackets(1, ts::PCR(1000), packets.data(), 8);
+    msa.stop();
+
+    // Packets are no longer accepted after stop().
+    msa.feedPackets(1, ts::PCR(2000), packets.data(), 8);
+
+    ts::tr101290::MultiStreamAnalyzer::Status status;
+    TSUNIT_ASSERT(msa.getStatus(0, status));
+    TSUNIT_EQUAL(10, status.packets);
+    TSUNIT_EQUAL(15, status.dropped);
+    TSUNIT_ASSERT(msa.getStatus(1, status));
+    TSUNIT_EQUAL(8, status.packets);
+    TSUNIT_EQUAL(0, status.dropped);
+
+    ts::json::Object root;
+    msa.getStatus(root);
+    TSUNIT_EQUAL(18, root.value(u"total").value(u"packets").toInteger());
+    TSUNIT_EQUAL(15, root.value(u"total").value(u"dropped").toInteger());
+}
@@ -0,0 +1,378 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for chunked and parallel TS analysis.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSAnalyzerReport.h"
+#include "tsParallelTSFileAnalyzer.h"
+#include "tsCyclingPacketizer.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsCADescriptor.h"
+#include "tsDuckContext.h"
+#include "tsTSFile.h"
+#include "tsCerrReport.h"
+#include "tsFileUtils.h"
+#include "tsErrCodeReport.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSAnalyzerTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(MergeChunks);
+    TSUNIT_DECLARE_TEST(ParallelFile);
+    TSUNIT_DECLARE_TEST(InexactMerge);
+
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+private:
+    fs::path _tempFileName {};
+
+    // Build a test stream with PSI, PES, PCR, scrambling and continuity errors.
+    // Optionally add the cases which make the analysis of chunks differ from the sequential analysis:
+    // - suspects: a transport error before a packet of a PID which was seen long ago.
+    // - pes_sections: a packet which looks like the start of a PES packet in the ECM PID.
+    static void BuildStream(ts::TSPacketVector& packets, bool suspects = false, bool pes_sections = false);
+
+    // Analyze a stream by chunks and merge them. Chunks which cannot be merged are sequentially analyzed.
+    // When use_reader is false, the merge cannot read packets again. Return the number of sequential chunks.
+    static size_t AnalyzeChunks(const ts::TSPacketVector& packets, ts::TSAnalyzer& merged, bool use_reader = true);
+
+    // Write a stream in the temporary file.
+    void WriteFile(const ts::TSPacketVector& packets);
+
+    // Get the normalized report of an analysis.
+    static ts::UString Report(ts::TSAnalyzerReport& analyzer);
+};
+
+TSUNIT_REGISTER(TSAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TSAnalyzerTest::beforeTest()
+{
+    if (_tempFileName.empty()) {
+        _tempFileName = ts::TempFile(u".ts");
+    }
+    fs::remove(_tempFileName, &ts::ErrCodeReport());
+}
+
+// Test suite cleanup method.
+void TSAnalyzerTest::afterTest()
+{
+    fs::remove(_tempFileName, &ts::ErrCodeReport());
+}
+
+
+//----------------------------------------------------------------------------
+// Build a test stream.
+//----------------------------------------------------------------------------
+
+void TSAnalyzerTest::BuildStream(ts::TSPacketVector& packets, bool suspects, bool pes_sections)
+{
+    constexpr ts::PID PID_PMT = 0x100;
+    constexpr ts::PID PID_VIDEO = 0x200;
+    constexpr ts::PID PID_AUDIO = 0x201;
+    constexpr ts::PID PID_ECM = 0x300;
+    constexpr ts::PID PID_RARE = 0x400;
+
+    ts::DuckContext duck;
+
+    ts::PAT pat(1, true, 0x1234);
+    pat.pmts[1] = PID_PMT;
+    ts::PMT pmt(1, true, 1, PID_VIDEO);
+    pmt.descs.add(duck, ts::CADescriptor(0x0500, PID_ECM));
+    pmt.streams[PID_VIDEO].stream_type = ts::ST_MPEG2_VIDEO;
+    pmt.streams[PID_AUDIO].stream_type = ts::ST_MPEG1_AUDIO;
+
+    ts::CyclingPacketizer pat_pzer(duck, ts::PID_PAT);
+    ts::CyclingPacketizer pmt_pzer(duck, PID_PMT);
+    ts::CyclingPacketizer ecm_pzer(duck, PID_ECM);
+    pat_pzer.addTable(duck, pat);
+    pmt_pzer.addTable(duck, pmt);
+    const uint8_t ecm[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09};
+    ecm_pzer.addSection(std::make_shared<ts::Section>(ts::TID(0x80), true, ecm, sizeof(ecm)));
+    ecm_pzer.addSection(std::make_shared<ts::Section>(ts::TID(0x81), true, ecm, sizeof(ecm)));
+
+    uint8_t cc_video = 0;
+    uint8_t cc_audio = 0;
+    uint8_t cc_rare = 0;
+    size_t video_count = 0;
+    size_t audio_count = 0;
+
+    packets.clear();
+    for (size_t i = 0; i < 20'000; ++i) {
+        ts::TSPacket pkt;
+        if (i % 400 == 0) {
+            pat_pzer.getNextPacket(pkt);
+        }
+        else if (i % 400 == 1) {
+            pmt_pzer.getNextPacket(pkt);
+        }
+        else if (i % 300 == 2) {
+            ecm_pzer.getNextPacket(pkt);
+            if (pes_sections && i == 12'002) {
+                // Looks like a PES packet but the PID is filtered by the section demux.
+                const uint8_t header[] = {0x00, 0x00, 0x01, 0xBD, 0x00, 0x00};
+                pkt.setPUSI();
+                ts::MemSet(pkt.getPayload(), 0xFF, pkt.getPayloadSize());
+                ts::MemCopy(pkt.getPayload(), header, sizeof(header));
+            }
+        }
+        else if (suspects && (i == 100 || i == 9'001)) {
+            // A PID with rare packets, the second one after a transport error.
+            pkt.init(PID_RARE, cc_rare++ & ts::CC_MASK, 0x00);
+        }
+        else if (suspects && i == 9'000) {
+            pkt = ts::NullPacket;
+            pkt.setTEI();
+        }
+        else if (i % 11 == 0) {
+            pkt = ts::NullPacket;
+        }
+        else if (i % 5 == 0) {
+            // Audio: bounded PES packets of two TS packets, crypto-periods in the second half.
+            pkt.init(PID_AUDIO, cc_audio++ & ts::CC_MASK, 0x00);
+            if (audio_count++ % 2 == 0) {
+                // Some PES packets have an invalid length.
+                const uint16_t length = audio_count % 50 == 7 ? 1000 : 2 * 184 - 6;
+                const uint8_t header[] = {0x00, 0x00, 0x01, 0xC0, uint8_t(length >> 8), uint8_t(length), 0x80, 0x80, 0x05, 0x21, 0x00, 0x01, 0x00, 0x01, 0xFF, 0xFB, 0x90, 0x64};
+                pkt.setPUSI();
+                ts::MemCopy(pkt.getPayload(), header, sizeof(header));
+                pkt.setPTS(90 * i);
+            }
+            if (i > 10'000) {
+                pkt.setScrambling((i / 1000) % 2 == 0 ? ts::SC_EVEN_KEY : ts::SC_ODD_KEY);
+            }
+        }
+        else {
+            // Video: unbounded PES packets with PCR and PTS, with a continuity error and a PCR leap.
+            if (i == 7'003) {
+                cc_video++;
+            }
+            pkt.init(PID_VIDEO, cc_video++ & ts::CC_MASK);
+            if (video_count++ % 20 == 0) {
+                const uint8_t header[] = {0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x80, 0x80, 0x05, 0x21, 0x00, 0x01, 0x00, 0x01};
+                pkt.setPUSI();
+                pkt.setPCR(4061 * i + (i > 15'000 ? 5 * ts::SYSTEM_CLOCK_FREQ : 0), true);
+                if (i > 15'000 && i < 15'100) {
+                    pkt.setDiscontinuityIndicator();
+                }
+                ts::MemCopy(pkt.getPayload(), header, sizeof(header));
+                pkt.setPTS(90 * i);
+            }
+        }
+        packets.push_back(pkt);
+        if (i == 12'007) {
+            // Duplicate packet.
+            packets.push_back(pkt);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Analyze a stream by chunks and merge them.
+//----------------------------------------------------------------------------
+
+size_t TSAnalyzerTest::AnalyzeChunks(const ts::TSPacketVector& packets, ts::TSAnalyzer& merged, bool use_reader)
+{
+    constexpr size_t CHUNK = 1500;
+    constexpr size_t WARMUP = 500;
+    const ts::TSPacketMetadata mdata;
+    size_t sequential = 0;
+
+    const ts::TSAnalyzer::PacketReader reader = [&packets](ts::PacketCounter position, ts::TSPacket* buffer, size_t count) -> size_t {
+        count = size_t(std::min<ts::PacketCounter>(count, packets.size() - std::min<ts::PacketCounter>(position, packets.size())));
+        std::copy(packets.begin() + position, packets.begin() + position + count, buffer);
+        return count;
+    };
+
+    for (size_t first = 0; first < packets.size(); first += CHUNK) {
+        const auto feed = [&](ts::TSAnalyzer& analyzer) {
+            for (size_t i = first - std::min(first, WARMUP); i < first; ++i) {
+                analyzer.feedWarmupPacket(packets[i]);
+            }
+            for (size_t i = first; i < std::min(first + CHUNK, packets.size()); ++i) {
+                analyzer.feedPacket(packets[i], mdata);
+            }
+            for (size_t i = first + CHUNK; i < packets.size() && analyzer.feedLookaheadPacket(packets[i]); ++i) {
+            }
+        };
+        ts::DuckContext duck;
+        ts::TSAnalyzer chunk(duck);
+        chunk.startChunk(first);
+        feed(chunk);
+        if (merged.canMergeChunk(chunk)) {
+            TSUNIT_ASSERT(merged.mergeChunk(chunk, use_reader ? reader : nullptr));
+        }
+        else {
+            sequential++;
+            merged.startSequentialChunk();
+            feed(merged);
+        }
+    }
+    return sequential;
+}
+
+
+//----------------------------------------------------------------------------
+// Write a stream in the temporary file.
+//----------------------------------------------------------------------------
+
+void TSAnalyzerTest::WriteFile(const ts::TSPacketVector& packets)
+{
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, CERR));
+    TSUNIT_ASSERT(file.writePackets(packets.data(), nullptr, packets.size(), CERR));
+    TSUNIT_ASSERT(file.close(CERR));
+}
+
+
+//----------------------------------------------------------------------------
+// Get the normalized report of an analysis.
+//----------------------------------------------------------------------------
+
+ts::UString TSAnalyzerTest::Report(ts::TSAnalyzerReport& analyzer)
+{
+    ts::TSAnalyzerArgs opt;
+    opt.deterministic = true;
+    std::ostringstream strm;
+    analyzer.reportNormalized(opt, strm);
+    return ts::UString::FromUTF8(strm.str());
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(MergeChunks)
+{
+    ts::TSPacketVector packets;
+    BuildStream(packets);
+    const ts::TSPacketMetadata mdata;
+
+    // Sequential analysis.
+    ts::DuckContext duck1;
+    ts::TSAnalyzerReport seq(duck1);
+    for (const auto& pkt : packets) {
+        seq.feedPacket(pkt, mdata);
+    }
+    const ts::UString ref(Report(seq));
+    debug() << "TSAnalyzerTest::MergeChunks: sequential:" << std::endl << ref << std::endl;
+    TSUNIT_ASSERT(ref.contains(u"pid:pid=512:"));
+
+    // Analysis per chunk.
+    ts::DuckContext duck2;
+    ts::TSAnalyzerReport merged(duck2);
+    TSUNIT_EQUAL(0, AnalyzeChunks(packets, merged));
+    TSUNIT_ASSERT(merged.isMergeExact());
+    TSUNIT_EQUAL(ref, Report(merged));
+
+    // Chunks must be merged in order.
+    ts::DuckContext duck4;
+    ts::TSAnalyzer other(duck4);
+    other.startChunk(1500);
+    ts::TSAnalyzerReport target(duck1);
+    TSUNIT_ASSERT(!target.mergeChunk(other));
+}
+
+TSUNIT_DEFINE_TEST(ParallelFile)
+{
+    ts::TSPacketVector packets;
+    BuildStream(packets);
+    WriteFile(packets);
+
+    ts::DuckContext duck1(&CERR);
+    ts::TSAnalyzerReport seq(duck1);
+    ts::ParallelTSFileAnalyzer seq_file(duck1, seq);
+    seq_file.setThreadCount(1);
+    TSUNIT_ASSERT(seq_file.analyze(_tempFileName));
+    const ts::UString ref(Report(seq));
+
+    ts::DuckContext duck2(&CERR);
+    ts::TSAnalyzerReport par(duck2);
+    ts::ParallelTSFileAnalyzer par_file(duck2, par);
+    par_file.setThreadCount(4);
+    par_file.setChunkSize(2'000);
+    par_file.setWarmupSize(1'000);
+    TSUNIT_ASSERT(par_file.analyze(_tempFileName));
+    TSUNIT_EQUAL(ref, Report(par));
+}
+
+TSUNIT_DEFINE_TEST(InexactMerge)
+{
+    const ts::TSPacketMetadata mdata;
+
+    // Each case alone makes the analysis of one chunk boundary depend on the previous chunks.
+    for (int index = 0; index < 3; ++index) {
+        const bool suspects = index != 1;
+        const bool pes_sections = index != 0;
+        ts::TSPacketVector packets;
+        BuildStream(packets, suspects, pes_sections);
+        debug() << "TSAnalyzerTest::InexactMerge: suspects: " << suspects << ", PES in sections: " << pes_sections << std::endl;
+
+        ts::DuckContext duck1;
+        ts::TSAnalyzerReport seq(duck1);
+        for (const auto& pkt : packets) {
+            seq.feedPacket(pkt, mdata);
+        }
+        const ts::UString ref(Report(seq));
+
+        // Only the chunk with the suspect packet is sequentially analyzed.
+        // The chunk with PES-like sections is read again during the merge.
+        ts::DuckContext duck2;
+        ts::TSAnalyzerReport merged(duck2);
+        TSUNIT_EQUAL(suspects ? 1 : 0, AnalyzeChunks(packets, merged));
+        TSUNIT_ASSERT(merged.isMergeExact());
+        TSUNIT_EQUAL(ref, Report(merged));
+
+        // Without reading packets again, the merge is inexact.
+        ts::DuckContext duck3;
+        ts::TSAnalyzerReport noread(duck3);
+        TSUNIT_EQUAL(suspects ? 1 : 0, AnalyzeChunks(packets, noread, false));
+        TSUNIT_EQUAL(!pes_sections, noread.isMergeExact());
+        TSUNIT_EQUAL(!pes_sections, ref == Report(noread));
+    }
+
+    // The parallel analysis of a file handles the same cases.
+    ts::TSPacketVector packets;
+    BuildStream(packets, true, true);
+    WriteFile(packets);
+
+    ts::DuckContext duck1(&CERR);
+    ts::TSAnalyzerReport seq(duck1);
+    ts::ParallelTSFileAnalyzer seq_file(duck1, seq);
+    seq_file.setThreadCount(1);
+    TSUNIT_ASSERT(seq_file.analyze(_tempFileName));
+    const ts::UString ref(Report(seq));
+    TSUNIT_ASSERT(ref.contains(u"pid:pid=1024:"));
+
+    ts::DuckContext duck2(&CERR);
+    ts::TSAnalyzerReport par(duck2);
+    ts::ParallelTSFileAnalyzer par_file(duck2, par);
+    par_file.setThreadCount(4);
+    par_file.setChunkSize(2'000);
+    par_file.setWarmupSize(1'000);
+    TSUNIT_ASSERT(par_file.analyze(_tempFileName));
+    TSUNIT_ASSERT(par.isMergeExact());
+    TSUNIT_EQUAL(ref, Report(par));
+}
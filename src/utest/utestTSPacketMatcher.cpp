@@ -0,0 +1,235 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TSPacketMatcher.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketMatcher.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSPacketMatcherTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Identical);
+    TSUNIT_DECLARE_TEST(Drop);
+    TSUNIT_DECLARE_TEST(Insert);
+    TSUNIT_DECLARE_TEST(Duplicate);
+    TSUNIT_DECLARE_TEST(Reorder);
+    TSUNIT_DECLARE_TEST(LargeGap);
+    TSUNIT_DECLARE_TEST(Drift);
+
+private:
+    // Build a stream of distinct packets in several PID's.
+    static void BuildStream(ts::TSPacketVector& packets, size_t count, ts::PID base_pid = 100, uint32_t base_value = 0);
+
+    // Match two streams, return the runs of consecutive events, in stream order.
+    // Each run is formatted as "type:stream:index:count" or "reorder:index:other:count".
+    static ts::UStringVector Match(const ts::TSPacketVector& s0, const ts::TSPacketVector& s1, size_t window, size_t threads, int64_t* offset = nullptr);
+
+    // Check the events of two streams, with one or several threads.
+    void CheckMatch(const ts::TSPacketVector& s0, const ts::TSPacketVector& s1, size_t window, const ts::UStringVector& expected);
+};
+
+TSUNIT_REGISTER(TSPacketMatcherTest);
+
+
+//----------------------------------------------------------------------------
+// Helpers.
+//----------------------------------------------------------------------------
+
+void TSPacketMatcherTest::BuildStream(ts::TSPacketVector& packets, size_t count, ts::PID base_pid, uint32_t base_value)
+{
+    packets.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        packets[i].init(ts::PID(base_pid + i % 7), uint8_t(i & ts::CC_MASK), 0xFF);
+        ts::PutUInt32(packets[i].getPayload(), base_value + uint32_t(i));
+    }
+}
+
+ts::UStringVector TSPacketMatcherTest::Match(const ts::TSPacketVector& s0, const ts::TSPacketVector& s1, size_t window, size_t threads, int64_t* offset)
+{
+    ts::TSPacketMatcher::Options opt;
+    opt.window = window;
+    opt.threads = threads;
+    ts::TSPacketMatcher matcher(opt);
+
+    // Read the streams as directed by the matcher.
+    const ts::TSPacketVector* streams[2] {&s0, &s1};
+    size_t pos[2] {0, 0};
+    bool eof[2] {false, false};
+    ts::TSPacketVector chunks[2];
+    std::vector<ts::TSPacketMatcher::Event> events;
+    std::vector<ts::TSPacketMatcher::Event> all;
+    while (!eof[0] || !eof[1]) {
+        for (size_t s = 0; s < 2; ++s) {
+            const size_t count = std::min(matcher.readCount(s), streams[s]->size() - pos[s]);
+            chunks[s].assign(streams[s]->begin() + pos[s], streams[s]->begin() + pos[s] + count);
+            pos[s] += count;
+            eof[s] = pos[s] >= streams[s]->size();
+        }
+        matcher.feedPackets(chunks, eof, events);
+        all.insert(all.end(), events.begin(), events.end());
+    }
+    if (offset != nullptr) {
+        *offset = matcher.offset();
+    }
+
+    // With several threads, the events of distinct groups of PID's may come in distinct chunks.
+    std::sort(all.begin(), all.end());
+    std::vector<ts::TSPacketMatcher::Event> runs;
+    for (const auto& ev : all) {
+        bool merged = false;
+        for (auto& run : runs) {
+            if (run.type == ev.type && run.stream == ev.stream && ev.index == run.index + run.count && (ev.type != ts::TSPacketMatcher::Event::REORDER || ev.other_index == run.other_index + run.count)) {
+                run.count += ev.count;
+                merged = true;
+                break;
+            }
+        }
+        if (!merged) {
+            runs.push_back(ev);
+        }
+    }
+
+    ts::UStringVector result;
+    for (const auto& run : runs) {
+        switch (run.type) {
+            case ts::TSPacketMatcher::Event::MISSING:
+                result.push_back(ts::UString::Format(u"missing:%d:%d:%d", run.stream, run.index, run.count));
+                break;
+            case ts::TSPacketMatcher::Event::DUPLICATE:
+                result.push_back(ts::UString::Format(u"duplicate:%d:%d:%d", run.stream, run.index, run.count));
+                break;
+            case ts::TSPacketMatcher::Event::REORDER:
+                result.push_back(ts::UString::Format(u"reorder:%d:%d:%d", run.index, run.other_index, run.count));
+                break;
+            default:
+                break;
+        }
+    }
+    return result;
+}
+
+void TSPacketMatcherTest::CheckMatch(const ts::TSPacketVector& s0, const ts::TSPacketVector& s1, size_t window, const ts::UStringVector& expected)
+{
+    for (size_t threads = 1; threads <= 4; threads += 3) {
+        const ts::UStringVector result(Match(s0, s1, window, threads));
+        debug() << "TSPacketMatcherTest: threads: " << threads << ", events: " << ts::UString::Join(result) << std::endl;
+        TSUNIT_EQUAL(ts::UString::Join(expected), ts::UString::Join(result));
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Identical)
+{
+    ts::TSPacketVector s0;
+    BuildStream(s0, 10'000);
+    CheckMatch(s0, s0, 1000, {});
+}
+
+TSUNIT_DEFINE_TEST(Drop)
+{
+    ts::TSPacketVector s0;
+    BuildStream(s0, 10'000);
+    ts::TSPacketVector s1(s0);
+    s1.erase(s1.begin() + 5000, s1.begin() + 5100);
+    CheckMatch(s0, s1, 1000, {u"missing:0:5000:100"});
+}
+
+TSUNIT_DEFINE_TEST(Insert)
+{
+    ts::TSPacketVector s0;
+    BuildStream(s0, 10'000);
+    ts::TSPacketVector extra;
+    BuildStream(extra, 100, 200, 100'000);
+    ts::TSPacketVector s1(s0);
+    s1.insert(s1.begin() + 5000, extra.begin(), extra.end());
+    CheckMatch(s0, s1, 1000, {u"missing:1:5000:100"});
+}
+
+TSUNIT_DEFINE_TEST(Duplicate)
+{
+    ts::TSPacketVector s0;
+    BuildStream(s0, 10'000);
+    ts::TSPacketVector s1(s0);
+    s1.insert(s1.begin() + 3001, s0[3000]);
+    CheckMatch(s0, s1, 1000, {u"duplicate:1:3001:1"});
+}
+
+TSUNIT_DEFINE_TEST(Reorder)
+{
+    ts::TSPacketVector s0;
+    BuildStream(s0, 10'000);
+
+    // One packet moved ahead: only this packet is reordered, not all packets which it jumped over.
+    ts::TSPacketVector s1(s0);
+    s1.erase(s1.begin() + 3000);
+    s1.insert(s1.begin() + 3200, s0[3000]);
+    CheckMatch(s0, s1, 1000, {u"reorder:3000:3200:1"});
+
+    // Same thing after an offset between the streams.
+    s1.erase(s1.begin() + 1000, s1.begin() + 1050);
+    CheckMatch(s0, s1, 1000, {u"missing:0:1000:50", u"reorder:3000:3150:1"});
+
+    // A sequence of packets moved backward.
+    s1 = s0;
+    s1.insert(s1.begin() + 4000, s0.begin() + 6000, s0.begin() + 6010);
+    s1.erase(s1.begin() + 6010, s1.begin() + 6020);
+    CheckMatch(s0, s1, 5000, {u"reorder:6000:4000:10"});
+}
+
+TSUNIT_DEFINE_TEST(LargeGap)
+{
+    // Gaps which are much larger than the chunks of packets, close to the search window.
+    ts::TSPacketVector s0;
+    BuildStream(s0, 20'000);
+    ts::TSPacketVector extra;
+    BuildStream(extra, 900, 200, 100'000);
+    ts::TSPacketVector s1(s0);
+    s1.erase(s1.begin() + 12'000, s1.begin() + 12'900);
+    s1.insert(s1.begin() + 4000, extra.begin(), extra.end());
+    CheckMatch(s0, s1, 1000, {u"missing:1:4000:900", u"missing:0:12000:900"});
+}
+
+TSUNIT_DEFINE_TEST(Drift)
+{
+    // Many drops, each one smaller than the search window, much more packets in total.
+    ts::TSPacketVector s0;
+    BuildStream(s0, 30'000);
+    ts::TSPacketVector s1;
+    ts::UStringVector expected;
+    for (size_t i = 0; i < s0.size(); ++i) {
+        if (i % 2000 == 1000 && i < 21'000) {
+            expected.push_back(ts::UString::Format(u"missing:0:%d:300", i));
+            i += 299;
+        }
+        else {
+            s1.push_back(s0[i]);
+        }
+    }
+    CheckMatch(s0, s1, 1000, expected);
+
+    int64_t offset = 0;
+    Match(s0, s1, 1000, 1, &offset);
+    TSUNIT_EQUAL(-3000, offset);
+
+    // Same thing with inserted packets.
+    for (auto& s : expected) {
+        s.substitute(u"missing:0:", u"missing:1:");
+    }
+    CheckMatch(s1, s0, 1000, expected);
+}
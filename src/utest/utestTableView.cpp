@@ -0,0 +1,410 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for read-only table views.
+//
+//----------------------------------------------------------------------------
+
+#include "tsPATView.h"
+#include "tsCATView.h"
+#include "tsPMTView.h"
+#include "tsSDTView.h"
+#include "tsEITView.h"
+#include "tsNITView.h"
+#include "tsBATView.h"
+#include "tsTOTView.h"
+#include "tsPAT.h"
+#include "tsCAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsEIT.h"
+#include "tsNIT.h"
+#include "tsBAT.h"
+#include "tsTOT.h"
+#include "tsCADescriptor.h"
+#include "tsShortEventDescriptor.h"
+#include "tsDuckContext.h"
+#include "tsunit.h"
+
+#include "tables/psi_bat_cplus_sections.h"
+#include "tables/psi_cat_r6_sections.h"
+#include "tables/psi_nit_tntv23_sections.h"
+#include "tables/psi_pat_r4_sections.h"
+#include "tables/psi_pmt_planete_sections.h"
+#include "tables/psi_sdt_r3_sections.h"
+#include "tables/psi_tot_tnt_sections.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TableViewTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Descriptors);
+    TSUNIT_DECLARE_TEST(PAT);
+    TSUNIT_DECLARE_TEST(CAT);
+    TSUNIT_DECLARE_TEST(PMT);
+    TSUNIT_DECLARE_TEST(SDT);
+    TSUNIT_DECLARE_TEST(EIT);
+    TSUNIT_DECLARE_TEST(NIT);
+    TSUNIT_DECLARE_TEST(BAT);
+    TSUNIT_DECLARE_TEST(TOT);
+    TSUNIT_DECLARE_TEST(Invalid);
+    TSUNIT_DECLARE_TEST(Truncated);
+
+private:
+    // Build a binary table from a sequence of sections.
+    static void LoadTable(ts::BinaryTable& table, const uint8_t* data, size_t size);
+};
+
+TSUNIT_REGISTER(TableViewTest);
+
+
+//----------------------------------------------------------------------------
+// Build a binary table from a sequence of sections.
+//----------------------------------------------------------------------------
+
+void TableViewTest::LoadTable(ts::BinaryTable& table, const uint8_t* data, size_t size)
+{
+    table.clear();
+    while (size >= 3) {
+        const size_t sec_size = std::min<size_t>(size, 3 + (ts::GetUInt16(data + 1) & 0x0FFF));
+        table.addNewSection(data, sec_size, ts::PID_NULL, ts::CRC32::CHECK);
+        data += sec_size;
+        size -= sec_size;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Descriptors)
+{
+    static const uint8_t data[] = {
+        0x09, 0x04, 0x01, 0x00, 0xE1, 0x00,  // CA descriptor
+        0x52, 0x01, 0x07,                    // stream identifier descriptor
+        0x09, 0x04, 0x05, 0x00, 0xE2, 0x00,  // CA descriptor
+        0x0A, 0x08, 0x00,                    // truncated descriptor
+    };
+
+    const ts::DescriptorListView dlist(data, sizeof(data));
+    TSUNIT_ASSERT(!dlist.empty());
+    TSUNIT_EQUAL(3, dlist.count());
+    TSUNIT_ASSERT(dlist.contains(ts::DID_MPEG_CA));
+    TSUNIT_ASSERT(!dlist.contains(ts::DID_MPEG_LANGUAGE));
+
+    const ts::DescriptorView sid(dlist.search(ts::DID_DVB_STREAM_ID));
+    TSUNIT_ASSERT(sid.isValid());
+    TSUNIT_EQUAL(ts::DID_DVB_STREAM_ID, sid.tag());
+    TSUNIT_EQUAL(3, sid.size());
+    TSUNIT_EQUAL(1, sid.payloadSize());
+    TSUNIT_EQUAL(7, sid.payload()[0]);
+
+    std::vector<uint16_t> cas;
+    for (auto it = dlist.search(ts::DID_MPEG_CA, dlist.begin()); it != dlist.end(); it = dlist.search(ts::DID_MPEG_CA, ++it)) {
+        cas.push_back(ts::GetUInt16(it->payload()));
+    }
+    TSUNIT_EQUAL(2, cas.size());
+    TSUNIT_EQUAL(0x0100, cas[0]);
+    TSUNIT_EQUAL(0x0500, cas[1]);
+
+    ts::DescriptorList full(nullptr);
+    TSUNIT_EQUAL(3, dlist.addTo(full));
+    TSUNIT_EQUAL(3, full.count());
+    TSUNIT_EQUAL(ts::DID_DVB_STREAM_ID, full[1].tag());
+
+    TSUNIT_ASSERT(ts::DescriptorListView().empty());
+    TSUNIT_ASSERT(!ts::DescriptorListView().search(ts::DID_MPEG_CA).isValid());
+}
+
+TSUNIT_DEFINE_TEST(PAT)
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    LoadTable(bin, psi_pat_r4_sections, sizeof(psi_pat_r4_sections));
+    TSUNIT_ASSERT(bin.isValid());
+
+    const ts::PAT pat(duck, bin);
+    const ts::PATView view(bin);
+    TSUNIT_ASSERT(pat.isValid());
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(ts::TID_PAT, view.tableId());
+    TSUNIT_EQUAL(pat.version(), view.version());
+    TSUNIT_EQUAL(pat.ts_id, view.tsId());
+    TSUNIT_EQUAL(pat.nit_pid, view.nitPID());
+
+    size_t count = 0;
+    for (const auto& srv : view) {
+        if (srv.id() != 0) {
+            count++;
+            TSUNIT_ASSERT(pat.pmts.contains(srv.id()));
+            TSUNIT_EQUAL(pat.pmts.at(srv.id()), srv.pmtPID());
+        }
+    }
+    TSUNIT_EQUAL(pat.pmts.size(), count);
+}
+
+TSUNIT_DEFINE_TEST(CAT)
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    LoadTable(bin, psi_cat_r6_sections, sizeof(psi_cat_r6_sections));
+
+    const ts::CAT cat(duck, bin);
+    const ts::CATView view(bin);
+    TSUNIT_ASSERT(cat.isValid());
+    TSUNIT_ASSERT(view.isValid());
+
+    size_t index = 0;
+    for (const auto& desc : view) {
+        TSUNIT_ASSERT(index < cat.descs.count());
+        TSUNIT_EQUAL(cat.descs[index].tag(), desc.tag());
+        TSUNIT_EQUAL(cat.descs[index].size(), desc.size());
+        index++;
+    }
+    TSUNIT_EQUAL(cat.descs.count(), index);
+}
+
+TSUNIT_DEFINE_TEST(PMT)
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    LoadTable(bin, psi_pmt_planete_sections, sizeof(psi_pmt_planete_sections));
+
+    const ts::PMT pmt(duck, bin);
+    const ts::PMTView view(bin);
+    TSUNIT_ASSERT(pmt.isValid());
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(pmt.service_id, view.serviceId());
+    TSUNIT_EQUAL(pmt.pcr_pid, view.pcrPID());
+    TSUNIT_EQUAL(pmt.descs.count(), view.descriptors().count());
+
+    size_t count = 0;
+    for (const auto& stream : view) {
+        count++;
+        TSUNIT_ASSERT(pmt.streams.contains(stream.pid()));
+        const ts::PMT::Stream& ref(pmt.streams.at(stream.pid()));
+        TSUNIT_EQUAL(ref.stream_type, stream.streamType());
+        TSUNIT_EQUAL(ref.descs.count(), stream.descriptors().count());
+    }
+    TSUNIT_EQUAL(pmt.streams.size(), count);
+}
+
+TSUNIT_DEFINE_TEST(SDT)
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    LoadTable(bin, psi_sdt_r3_sections, sizeof(psi_sdt_r3_sections));
+
+    const ts::SDT sdt(duck, bin);
+    const ts::SDTView view(bin);
+    TSUNIT_ASSERT(sdt.isValid());
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_ASSERT(view.isActual());
+    TSUNIT_EQUAL(sdt.ts_id, view.tsId());
+    TSUNIT_EQUAL(sdt.onetw_id, view.originalNetworkId());
+
+    size_t count = 0;
+    for (const auto& srv : view) {
+        count++;
+        TSUNIT_ASSERT(sdt.services.contains(srv.id()));
+        const ts::SDT::ServiceEntry& ref(sdt.services.at(srv.id()));
+        TSUNIT_EQUAL(ref.EITs_present, srv.eitSchedule());
+        TSUNIT_EQUAL(ref.EITpf_present, srv.eitPresentFollowing());
+        TSUNIT_EQUAL(ref.running_status, srv.runningStatus());
+        TSUNIT_EQUAL(ref.CA_controlled, srv.CAControlled());
+        TSUNIT_EQUAL(ref.descs.count(), srv.descriptors().count());
+        TSUNIT_ASSERT(srv.descriptors().contains(ts::DID_DVB_SERVICE));
+    }
+    TSUNIT_EQUAL(sdt.services.size(), count);
+}
+
+TSUNIT_DEFINE_TEST(EIT)
+{
+    ts::DuckContext duck;
+    ts::EIT eit(true, false, 1, 3, true, 0x1234, 0x5678, 0x9ABC);
+    ts::EIT::Event& ev1(eit.events.newEntry());
+    ev1.event_id = 0x0101;
+    ev1.start_time = ts::Time(2025, 10, 3, 20, 45, 0);
+    ev1.duration = cn::seconds(5400);
+    ev1.running_status = 4;
+    ev1.CA_controlled = true;
+    ev1.descs.add(duck, ts::ShortEventDescriptor(u"fre", u"Title", u"Text"));
+    ts::EIT::Event& ev2(eit.events.newEntry());
+    ev2.event_id = 0x0102;
+    ev2.start_time = ts::Time(2025, 10, 3, 22, 15, 30);
+    ev2.duration = cn::seconds(59);
+
+    ts::BinaryTable bin;
+    TSUNIT_ASSERT(eit.serialize(duck, bin));
+    TSUNIT_EQUAL(1, bin.sectionCount());
+
+    const ts::EITView view(*bin.sectionAt(0));
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(ts::TID_EIT_S_ACT_MIN + 1, view.tableId());
+    TSUNIT_EQUAL(0x1234, view.serviceId());
+    TSUNIT_EQUAL(0x5678, view.tsId());
+    TSUNIT_EQUAL(0x9ABC, view.originalNetworkId());
+
+    auto it = view.begin();
+    TSUNIT_ASSERT(it != view.end());
+    ts::Time start;
+    TSUNIT_EQUAL(0x0101, it->id());
+    TSUNIT_ASSERT(it->startTime(start));
+    TSUNIT_ASSERT(start == ts::Time(2025, 10, 3, 20, 45, 0));
+    TSUNIT_EQUAL(5400, it->duration().count());
+    TSUNIT_EQUAL(4, it->runningStatus());
+    TSUNIT_ASSERT(it->CAControlled());
+    TSUNIT_EQUAL(1, it->descriptors().count());
+    TSUNIT_ASSERT(it->descriptors().contains(ts::DID_DVB_SHORT_EVENT));
+
+    ++it;
+    TSUNIT_ASSERT(it != view.end());
+    TSUNIT_EQUAL(0x0102, it->id());
+    TSUNIT_ASSERT(it->startTime(start));
+    TSUNIT_ASSERT(start == ts::Time(2025, 10, 3, 22, 15, 30));
+    TSUNIT_EQUAL(59, it->duration().count());
+    TSUNIT_EQUAL(0, it->runningStatus());
+    TSUNIT_ASSERT(!it->CAControlled());
+    TSUNIT_ASSERT(it->descriptors().empty());
+
+    ++it;
+    TSUNIT_ASSERT(it == view.end());
+}
+
+TSUNIT_DEFINE_TEST(NIT)
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    LoadTable(bin, psi_nit_tntv23_sections, sizeof(psi_nit_tntv23_sections));
+
+    const ts::NIT nit(duck, bin);
+    const ts::NITView view(bin);
+    TSUNIT_ASSERT(nit.isValid());
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_ASSERT(view.isActual());
+    TSUNIT_EQUAL(nit.network_id, view.networkId());
+
+    size_t count = 0;
+    for (auto it = view.descriptorsBegin(); it != view.descriptorsEnd(); ++it) {
+        count++;
+    }
+    TSUNIT_EQUAL(nit.descs.count(), count);
+
+    count = 0;
+    for (const auto& ts : view) {
+        count++;
+        const ts::TransportStreamId id(ts.tsId(), ts.originalNetworkId());
+        TSUNIT_ASSERT(nit.transports.contains(id));
+        TSUNIT_EQUAL(nit.transports.at(id).descs.count(), ts.descriptors().count());
+    }
+    TSUNIT_EQUAL(nit.transports.size(), count);
+}
+
+TSUNIT_DEFINE_TEST(BAT)
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    LoadTable(bin, psi_bat_cplus_sections, sizeof(psi_bat_cplus_sections));
+
+    const ts::BAT bat(duck, bin);
+    const ts::BATView view(bin);
+    TSUNIT_ASSERT(bat.isValid());
+    TSUNIT_ASSERT(view.isValid());
+    TSUNIT_EQUAL(bat.bouquet_id, view.bouquetId());
+    TSUNIT_ASSERT(!ts::NITView(bin).isValid());
+
+    size_t count = 0;
+    for (auto it = view.descriptorsBegin(); it != view.descriptorsEnd(); ++it) {
+        count++;
+    }
+    TSUNIT_EQUAL(bat.descs.count(), count);
+
+    count = 0;
+    for (const auto& ts : view) {
+        count++;
+        TSUNIT_ASSERT(bat.transports.contains(ts::TransportStreamId(ts.tsId(), ts.originalNetworkId())));
+    }
+    TSUNIT_EQUAL(bat.transports.size(), count);
+}
+
+TSUNIT_DEFINE_TEST(TOT)
+{
+    ts::DuckContext duck;
+    ts::BinaryTable bin;
+    LoadTable(bin, psi_tot_tnt_sections, sizeof(psi_tot_tnt_sections));
+
+    const ts::TOT tot(duck, bin);
+    const ts::TOTView view(bin);
+    TSUNIT_ASSERT(tot.isValid());
+    TSUNIT_ASSERT(view.isValid());
+
+    ts::Time utc;
+    TSUNIT_ASSERT(view.utcTime(utc));
+    TSUNIT_ASSERT(utc == tot.utc_time);
+
+    // Local time offset descriptors are split into regions in the TOT object.
+    const ts::DescriptorListView descs(view.descriptors());
+    TSUNIT_ASSERT(descs.contains(ts::DID_DVB_LOCAL_TIME_OFFSET));
+    TSUNIT_ASSERT(descs.count() >= tot.descs.count());
+}
+
+TSUNIT_DEFINE_TEST(Invalid)
+{
+    ts::BinaryTable bin;
+    LoadTable(bin, psi_pat_r4_sections, sizeof(psi_pat_r4_sections));
+
+    // A PAT is not a PMT.
+    const ts::PMTView pmt(bin);
+    TSUNIT_ASSERT(!pmt.isValid());
+    TSUNIT_EQUAL(0, pmt.sectionCount());
+    TSUNIT_EQUAL(ts::PID_NULL, pmt.pcrPID());
+    TSUNIT_ASSERT(pmt.descriptors().empty());
+    TSUNIT_ASSERT(pmt.begin() == pmt.end());
+
+    // Empty table.
+    const ts::BinaryTable empty;
+    const ts::PATView pat(empty);
+    TSUNIT_ASSERT(!pat.isValid());
+    TSUNIT_EQUAL(0, pat.tsId());
+    TSUNIT_ASSERT(pat.begin() == pat.end());
+}
+
+TSUNIT_DEFINE_TEST(Truncated)
+{
+    // PMT with two streams, the ES_info_length of the second one exceeds the section.
+    ts::ByteBlock data(psi_pmt_planete_sections, sizeof(psi_pmt_planete_sections));
+    const ts::Section ref(data, ts::PID_NULL, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(ref.isValid());
+
+    // Locate the last stream and enlarge its ES_info_length.
+    const uint8_t* last = nullptr;
+    size_t full_count = 0;
+    const ts::PMTView ref_view(ref);
+    for (const auto& stream : ref_view) {
+        last = stream.descriptors().data() - 5;
+        full_count++;
+    }
+    TSUNIT_ASSERT(full_count >= 2);
+    TSUNIT_ASSERT(last != nullptr);
+    const size_t offset = last - ref.content();
+    data[offset + 3] |= 0x0F;
+
+    const ts::Section sec(data, ts::PID_NULL, ts::CRC32::IGNORE);
+    TSUNIT_ASSERT(sec.isValid());
+    const ts::PMTView view(sec);
+    TSUNIT_ASSERT(view.isValid());
+    size_t count = 0;
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        count++;
+    }
+    TSUNIT_EQUAL(full_count - 1, count);
+}
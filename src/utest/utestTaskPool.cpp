@@ -0,0 +1,207 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TaskPool
+//
+//----------------------------------------------------------------------------
+
+#include "tsTaskPool.h"
+#include "tsunit.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TaskPoolTest: public tsunit::Test
+{
+    TSUNIT_DECLARE_TEST(Submit);
+    TSUNIT_DECLARE_TEST(Exception);
+    TSUNIT_DECLARE_TEST(Continuation);
+    TSUNIT_DECLARE_TEST(SubTasks);
+    TSUNIT_DECLARE_TEST(Bounded);
+    TSUNIT_DECLARE_TEST(Clear);
+    TSUNIT_DECLARE_TEST(Terminate);
+    TSUNIT_DECLARE_TEST(TerminateContinuations);
+};
+
+TSUNIT_REGISTER(TaskPoolTest);
+
+namespace {
+    // Check that the result of a future is an exception of a given type.
+    template <class EXCEP, typename T>
+    bool Throws(std::future<T>& future)
+    {
+        try {
+            future.get();
+        }
+        catch (const EXCEP&) {
+            return true;
+        }
+        catch (...) {
+        }
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+TSUNIT_DEFINE_TEST(Submit)
+{
+    ts::TaskPool pool(4);
+    TSUNIT_EQUAL(4, pool.threadCount());
+    TSUNIT_ASSERT(!pool.isWorkerThread());
+    TSUNIT_ASSERT(pool.start());
+    TSUNIT_ASSERT(!pool.start());
+
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; ++i) {
+        results.push_back(pool.submit([i]() { return i * i; }));
+    }
+    for (int i = 0; i < 100; ++i) {
+        TSUNIT_EQUAL(i * i, results[i].get());
+    }
+
+    std::atomic<int> count = 0;
+    for (int i = 0; i < 50; ++i) {
+        TSUNIT_ASSERT(pool.post([&count]() { count++; }));
+    }
+    auto in_pool = pool.submit([&pool]() { return pool.isWorkerThread(); });
+    TSUNIT_ASSERT(in_pool.get());
+    pool.waitIdle();
+    TSUNIT_EQUAL(50, count.load());
+
+    const ts::TaskPool::Statistics stats(pool.getStatistics());
+    TSUNIT_EQUAL(151, stats.submitted);
+    TSUNIT_EQUAL(151, stats.executed);
+    TSUNIT_EQUAL(0, stats.failed);
+    TSUNIT_EQUAL(0, stats.dropped);
+    TSUNIT_ASSERT(stats.max_queued >= 1);
+}
+
+TSUNIT_DEFINE_TEST(Exception)
+{
+    ts::TaskPool pool(2);
+    TSUNIT_ASSERT(pool.start());
+
+    auto result = pool.submit([]() -> int { throw std::runtime_error("task error"); });
+    TSUNIT_ASSERT(Throws<std::runtime_error>(result));
+
+    TSUNIT_ASSERT(pool.post([]() { throw std::runtime_error("ignored error"); }));
+    pool.waitIdle();
+    TSUNIT_EQUAL(1, pool.getStatistics().failed);
+}
+
+TSUNIT_DEFINE_TEST(Continuation)
+{
+    ts::TaskPool pool(2);
+    TSUNIT_ASSERT(pool.start());
+
+    auto f1 = pool.submit([]() { return 6 * 7; }, [](int i) { return ts::UString::Decimal(i); });
+    TSUNIT_EQUAL(u"42", f1.get());
+
+    std::atomic<int> count = 0;
+    auto f2 = pool.submit([&count]() { count++; }, [&count]() { return count.load() * 10; });
+    TSUNIT_EQUAL(10, f2.get());
+
+    auto f3 = pool.submit([]() -> int { throw std::runtime_error("task error"); }, [](int i) { return i; });
+    TSUNIT_ASSERT(Throws<std::runtime_error>(f3));
+
+    auto f4 = pool.submit([]() { return 1; }, [](int) -> int { throw std::runtime_error("continuation error"); });
+    TSUNIT_ASSERT(Throws<std::runtime_error>(f4));
+}
+
+TSUNIT_DEFINE_TEST(SubTasks)
+{
+    // Tasks which submit sub-tasks, these are stolen by other workers.
+    ts::TaskPool pool(4);
+    TSUNIT_ASSERT(pool.start());
+
+    std::atomic<int> count = 0;
+    for (int i = 0; i < 10; ++i) {
+        pool.post([&pool, &count]() {
+            for (int j = 0; j < 100; ++j) {
+                pool.post([&count]() { count++; });
+            }
+        });
+    }
+    pool.waitIdle();
+    TSUNIT_EQUAL(1000, count.load());
+
+    const ts::TaskPool::Statistics stats(pool.getStatistics());
+    TSUNIT_EQUAL(1010, stats.executed);
+    debug() << "TaskPoolTest::SubTasks: stolen: " << stats.stolen << ", max queued: " << stats.max_queued << std::endl;
+}
+
+TSUNIT_DEFINE_TEST(Bounded)
+{
+    ts::TaskPool pool(1, 2);
+    TSUNIT_ASSERT(pool.tryPost([]() {}));
+    TSUNIT_ASSERT(pool.tryPost([]() {}));
+    TSUNIT_ASSERT(!pool.tryPost([]() {}));
+
+    TSUNIT_ASSERT(pool.start());
+    pool.waitIdle();
+    TSUNIT_ASSERT(pool.tryPost([]() {}));
+    pool.waitIdle();
+    TSUNIT_EQUAL(3, pool.getStatistics().executed);
+}
+
+TSUNIT_DEFINE_TEST(Clear)
+{
+    ts::TaskPool pool(1);
+    auto f1 = pool.submit([]() { return 1; });
+    TSUNIT_ASSERT(pool.post([]() {}));
+    TSUNIT_EQUAL(2, pool.clear());
+    TSUNIT_ASSERT(Throws<std::future_error>(f1));
+    TSUNIT_EQUAL(2, pool.getStatistics().dropped);
+}
+
+TSUNIT_DEFINE_TEST(Terminate)
+{
+    std::atomic<int> count = 0;
+    {
+        ts::TaskPool pool(2);
+        TSUNIT_ASSERT(pool.start());
+        for (int i = 0; i < 20; ++i) {
+            pool.post([&count]() { std::this_thread::sleep_for(cn::milliseconds(1)); count++; });
+        }
+        // All queued tasks are executed on termination.
+        pool.terminate();
+        TSUNIT_EQUAL(20, count.load());
+        TSUNIT_ASSERT(!pool.post([&count]() { count++; }));
+        auto f = pool.submit([]() { return 1; });
+        TSUNIT_ASSERT(Throws<std::future_error>(f));
+    }
+    TSUNIT_EQUAL(20, count.load());
+}
+
+TSUNIT_DEFINE_TEST(TerminateContinuations)
+{
+    // Terminate while the workers are still posting continuations in their own queues,
+    // which are concurrently stolen by the other workers.
+    for (int iteration = 0; iteration < 20; ++iteration) {
+        std::atomic<int> count = 0;
+        std::vector<std::future<int>> results;
+        ts::TaskPool pool(4);
+        TSUNIT_ASSERT(pool.start());
+        for (int i = 0; i < 100; ++i) {
+            results.push_back(pool.submit([i]() { std::this_thread::sleep_for(cn::microseconds(50)); return i; },
+                                          [&count](int i) { count++; return 2 * i; }));
+        }
+        pool.terminate();
+        TSUNIT_EQUAL(100, count.load());
+        for (int i = 0; i < 100; ++i) {
+            TSUNIT_EQUAL(2 * i, results[i].get());
+        }
+        TSUNIT_EQUAL(200, pool.getStatistics().executed);
+    }
+}
@@ -13,6 +13,7 @@
 #include "tsxmlModelDocument.h"
 #include "tsxmlElement.h"
 #include "tsxmlDeclaration.h"
+#include "tsxmlStreamParser.h"
 #include "tsSectionFile.h"
 #include "tsTextFormatter.h"
 #include "tsCerrReport.h"
@@ -44,6 +45,8 @@ class XMLTest: public tsunit::Test
     TSUNIT_DECLARE_TEST(PreserveSpace);
     TSUNIT_DECLARE_TEST(IntValue);
     TSUNIT_DECLARE_TEST(Iterators);
+    TSUNIT_DECLARE_TEST(StreamParser);
+    TSUNIT_DECLARE_TEST(StreamParserInvalid);
 
 public:
     virtual void beforeTest() override;
@@ -890,3 +893,106 @@ TSUNIT_DEFINE_TEST(Iterators)
     TSUNIT_ASSERT(!valid);
     TSUNIT_EQUAL(u"Error: <doc>, line 2, contains 4 <a>, allowed 1 to 3", rep.messages());
 }
+
+namespace {
+    // Collect the names and line numbers of top-level elements from a stream parser.
+    class StreamCollector: public ts::xml::StreamHandlerInterface
+    {
+    public:
+        ts::UString root {};
+        ts::UStringList elements {};
+        size_t max_count = ts::NPOS;
+
+        virtual bool handleXMLRoot(ts::xml::StreamParser&, const ts::xml::Element& elem) override
+        {
+            root = elem.name();
+            return true;
+        }
+
+        virtual bool handleXMLElement(ts::xml::StreamParser&, const ts::xml::Element& elem) override
+        {
+            ts::UString text(ts::UString::Format(u"%s:%d", elem.name(), elem.lineNumber()));
+            if (elem.parent() != nullptr) {
+                text.format(u":%s", elem.parent()->value());
+            }
+            const ts::xml::Element* child = elem.firstChildElement();
+            if (child != nullptr) {
+                text.format(u":%s:%d", child->name(), child->lineNumber());
+            }
+            elements.push_back(text);
+            return elements.size() < max_count;
+        }
+    };
+}
+
+TSUNIT_DEFINE_TEST(StreamParser)
+{
+    static const ts::UChar* document =
+        u"﻿<?xml version='1.0' encoding='UTF-8'?>\n"
+        u"<!-- comment before root -->\n"
+        u"<tsduck attr='<>'>\n"
+        u"  <a x='1'/>\n"
+        u"  <!-- <b/> -->\n"
+        u"  <b y=\"2>3\">\n"
+        u"    <c><![CDATA[</b> <d>]]></c>\n"
+        u"  </b>\n"
+        u"  <?foo bar?>\n"
+        u"  <a>\n"
+        u"    <b><b/></b>\n"
+        u"  </a>\n"
+        u"</tsduck>\n"
+        u"<!-- comment after root -->\n";
+
+    // Use all chunk sizes, including very small ones, which split the elements everywhere.
+    for (size_t chunk : {16, 17, 23, 64, 1000}) {
+        ts::ReportBuffer<ts::ThreadSafety::None> rep;
+        StreamCollector coll;
+        ts::xml::StreamParser parser(rep, &coll);
+        parser.setChunkSize(chunk);
+        TSUNIT_ASSERT(parser.parse(document));
+        TSUNIT_EQUAL(u"", rep.messages());
+        TSUNIT_EQUAL(u"tsduck", coll.root);
+        TSUNIT_EQUAL(u"a:4:tsduck, b:6:tsduck:c:7, a:10:tsduck:b:11", ts::UString::Join(coll.elements));
+        TSUNIT_EQUAL(15, parser.lineNumber());
+    }
+
+    // Abort by the handler.
+    ts::ReportBuffer<ts::ThreadSafety::None> rep;
+    StreamCollector coll;
+    coll.max_count = 2;
+    ts::xml::StreamParser parser(rep, &coll);
+    TSUNIT_ASSERT(!parser.parse(document));
+    TSUNIT_EQUAL(u"a:4:tsduck, b:6:tsduck:c:7", ts::UString::Join(coll.elements));
+}
+
+TSUNIT_DEFINE_TEST(StreamParserInvalid)
+{
+    ts::ReportBuffer<ts::ThreadSafety::None> rep;
+    StreamCollector coll;
+    ts::xml::StreamParser parser(rep, &coll);
+
+    // An invalid top-level element does not prevent the other ones.
+    TSUNIT_ASSERT(!parser.parse(u"<root>\n<a/>\n<b>\n</c>\n</b>\n<d/>\n</root>"));
+    TSUNIT_EQUAL(u"a:2:root, d:6:root", ts::UString::Join(coll.elements));
+    TSUNIT_EQUAL(u"Error: line 4: parsing error, expected </b> to match <b> at line 3", rep.messages());
+
+    rep.clear();
+    coll.elements.clear();
+    TSUNIT_ASSERT(!parser.parse(u"<root>\n<a/>\n</foo>"));
+    TSUNIT_EQUAL(u"a:2:root", ts::UString::Join(coll.elements));
+    TSUNIT_EQUAL(u"Error: line 3: parsing error, expected </root> to match <root> at line 1", rep.messages());
+
+    rep.clear();
+    coll.elements.clear();
+    TSUNIT_ASSERT(!parser.parse(u"<root>\n<a/>\n<b>\n"));
+    TSUNIT_EQUAL(u"a:2:root", ts::UString::Join(coll.elements));
+    TSUNIT_EQUAL(u"Error: line 4: unexpected end of document, missing </root> to match <root> at line 1", rep.messages());
+
+    rep.clear();
+    TSUNIT_ASSERT(!parser.parse(u"<?xml version='1.0'?>\n<!-- nothing -->\n"));
+    TSUNIT_EQUAL(u"Error: invalid XML document, no root element found", rep.messages());
+
+    rep.clear();
+    TSUNIT_ASSERT(!parser.parse(u"<root/>\n<other/>"));
+    TSUNIT_EQUAL(u"Error: line 2: trailing character sequence, invalid XML document", rep.messages());
+}
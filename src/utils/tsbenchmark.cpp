@@ -0,0 +1,817 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2026, Thierry Lelegard
+// BSD-2-Clause license, see LICENSE.txt file or https://tsduck.io/license
+//
+// Micro and macro benchmarks on the packet and PSI/SI hot paths.
+//
+// Each benchmark prepares its data, then measures the time, CPU cycles and
+// heap allocations in its processing loop only. The results are reported
+// per processed item (packet, section, table, etc.) in a text table or in
+// JSON format, to track performance regressions between versions.
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsAllocationTracker.h"
+#include "tsCPUCycles.h"
+#include "tsDuckContext.h"
+#include "tsjsonOutputArgs.h"
+#include "tsjsonObject.h"
+#include "tsVersionInfo.h"
+#include "tsTSPacket.h"
+#include "tsCRC32.h"
+#include "tsSectionDemux.h"
+#include "tsPESDemux.h"
+#include "tsPacketizer.h"
+#include "tsCyclingPacketizer.h"
+#include "tsSectionFile.h"
+#include "tsBinaryTable.h"
+#include "tsPAT.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+#include "tsPSIBuffer.h"
+#include "tsECB.h"
+#include "tsCBC.h"
+#include "tsAES128.h"
+#include "tsAES256.h"
+#include "tsDES.h"
+#include "tsTDES.h"
+#include "tsDVBCSA2.h"
+#include "tsDVBCISSA.h"
+#include "tsIDSA.h"
+#include "tsSCTE52.h"
+#include "tsTSProcessor.h"
+#include "tsPluginEventHandlerInterface.h"
+#include "tsPluginEventData.h"
+#include "tsPSIRepository.h"
+#include "tsForkPipe.h"
+#include "tsSysUtils.h"
+#include "tsFileUtils.h"
+TS_MAIN(MainCode);
+TS_TRACK_ALLOCATIONS();
+
+
+//----------------------------------------------------------------------------
+// Command line options
+//----------------------------------------------------------------------------
+
+namespace {
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+
+        ts::UStringVector    names {};      // Benchmark names or prefixes.
+        bool                 list = false;  // List benchmarks only.
+        size_t               packets = 0;   // Number of packets in packet-oriented benchmarks.
+        size_t               repeat = 0;    // Number of runs per benchmark, keep the fastest.
+        ts::json::OutputArgs json {};       // JSON output.
+    };
+}
+
+Options::Options(int argc, char *argv[]) :
+    ts::Args(u"Micro and macro benchmarks on TSDuck hot paths", u"[options] [name-prefix ...]")
+{
+    option(u"", 0, STRING);
+    help(u"", u"name-prefix",
+         u"Run all benchmarks the name of which starts with one of the specified prefixes. "
+         u"By default, all benchmarks are run. Use --list to get the list of benchmarks.");
+
+    option(u"list", 'l');
+    help(u"list", u"List the available benchmarks and exit.");
+
+    option(u"packets", 'p', POSITIVE);
+    help(u"packets", u"count",
+         u"Number of TS packets in packet-oriented benchmarks. "
+         u"All other benchmarks are scaled accordingly. The default is 100,000.");
+
+    option(u"repeat", 'r', POSITIVE);
+    help(u"repeat", u"count",
+         u"Run each benchmark the specified number of times and report the fastest run. "
+         u"The default is 3.");
+
+    json.defineArgs(*this, true, u"Report the results in JSON format.");
+
+    analyze(argc, argv);
+
+    getValues(names, u"");
+    list = present(u"list");
+    getIntValue(packets, u"packets", 100'000);
+    getIntValue(repeat, u"repeat", 3);
+    json.loadArgs(*this);
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+// Measurement of one benchmark run.
+//----------------------------------------------------------------------------
+
+namespace {
+    class Result
+    {
+    public:
+        uint64_t                        items = 0;   // Number of processed items.
+        cn::nanoseconds                 duration {}; // Total processing time.
+        uint64_t                        cycles = 0;  // Total CPU cycles.
+        ts::AllocationTracker::Counters allocs {};   // Heap allocations during processing.
+
+        // Values per item.
+        double nsPerItem() const { return PerItem(duration.count()); }
+        double cyclesPerItem() const { return PerItem(cycles); }
+        double allocsPerItem() const { return PerItem(allocs.allocations); }
+        double bytesPerItem() const { return PerItem(allocs.bytes); }
+        double itemsPerSecond() const { return duration.count() <= 0 ? 0.0 : 1.0e9 * double(items) / double(duration.count()); }
+
+    private:
+        template <typename INT>
+        double PerItem(INT value) const { return items == 0 ? 0.0 : double(value) / double(items); }
+    };
+
+    // Each benchmark calls start() after its initialization and stop() after its processing loop.
+    class Meter
+    {
+        TS_NOCOPY(Meter);
+    public:
+        Meter() = default;
+        void start();
+        void stop(uint64_t items);
+        const Result& result() const { return _result; }
+
+    private:
+        Result                          _result {};
+        ts::AllocationTracker::Counters _start_allocs {};
+        ts::monotonic_time                  _start_time {};
+        uint64_t                        _start_cycles = 0;
+    };
+}
+
+void Meter::start()
+{
+    // The process counters are used because the tsp benchmarks run in several threads.
+    _start_allocs = ts::AllocationTracker::Process();
+    _start_time = ts::monotonic_time::clock::now();
+    _start_cycles = ts::ReadCPUCycles();
+}
+
+void Meter::stop(uint64_t items)
+{
+    const uint64_t cycles = ts::ReadCPUCycles();
+    const ts::monotonic_time time = ts::monotonic_time::clock::now();
+    _result.allocs = ts::AllocationTracker::Process() - _start_allocs;
+    _result.cycles = cycles - _start_cycles;
+    _result.duration = cn::duration_cast<cn::nanoseconds>(time - _start_time);
+    _result.items = items;
+}
+
+
+//----------------------------------------------------------------------------
+// Common test data.
+//----------------------------------------------------------------------------
+
+namespace {
+    // PID's of the test streams.
+    constexpr ts::PID PSI_PID = 0x0100;
+    constexpr ts::PID PES_PID = 0x0200;
+
+    // A result of the benchmarks which must be used to prevent the compiler from optimizing away the loops.
+    volatile uint64_t sink = 0;
+
+    // Build a set of PSI/SI tables: PAT, PMT's, SDT.
+    ts::BinaryTablePtrVector BuildTables(ts::DuckContext& duck)
+    {
+        constexpr uint16_t SERVICE_COUNT = 32;
+
+        ts::PAT pat(0, true, 0x1234);
+        ts::SDT sdt(true, 0, true, 0x1234, 0x20FA);
+        ts::BinaryTablePtrVector tables;
+
+        for (uint16_t i = 0; i < SERVICE_COUNT; ++i) {
+            const uint16_t sid = 0x0100 + i;
+            const ts::PID pmt_pid = 0x1000 + 16 * i;
+            pat.pmts[sid] = pmt_pid;
+            sdt.services[sid].setName(duck, ts::UString::Format(u"Service %d", i));
+            sdt.services[sid].setProvider(duck, u"TSDuck benchmark");
+            sdt.services[sid].running_status = 4;
+
+            ts::PMT pmt(0, true, sid, pmt_pid + 1);
+            pmt.streams[pmt_pid + 1].stream_type = ts::ST_AVC_VIDEO;
+            pmt.streams[pmt_pid + 2].stream_type = ts::ST_MPEG2_AUDIO;
+            pmt.streams[pmt_pid + 3].stream_type = ts::ST_PES_PRIV;
+            tables.push_back(std::make_shared<ts::BinaryTable>());
+            pmt.serialize(duck, *tables.back());
+        }
+        tables.push_back(std::make_shared<ts::BinaryTable>());
+        pat.serialize(duck, *tables.back());
+        tables.push_back(std::make_shared<ts::BinaryTable>());
+        sdt.serialize(duck, *tables.back());
+        return tables;
+    }
+
+    // Build a packetized stream of sections, cycling on the same tables.
+    void BuildSectionPackets(ts::DuckContext& duck, ts::TSPacketVector& packets, size_t count)
+    {
+        ts::CyclingPacketizer pzer(duck, PSI_PID, ts::CyclingPacketizer::StuffingPolicy::NEVER);
+        for (const auto& table : BuildTables(duck)) {
+            pzer.addTable(*table);
+        }
+        packets.resize(count);
+        for (auto& pkt : packets) {
+            pzer.getNextPacket(pkt);
+        }
+    }
+
+    // Build a stream of PES packets, 20 TS packets per PES packet.
+    void BuildPESPackets(ts::TSPacketVector& packets, size_t count)
+    {
+        constexpr size_t PES_TS_PACKETS = 20;
+        static const uint8_t pes_header[] = {0x00, 0x00, 0x01, 0xE0, 0x00, 0x00, 0x80, 0x00, 0x00};
+
+        packets.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            auto& pkt(packets[i]);
+            pkt.init(PES_PID, uint8_t(i & ts::CC_MASK), uint8_t(i));
+            if (i % PES_TS_PACKETS == 0) {
+                pkt.setPUSI();
+                ts::MemCopy(pkt.b + ts::PKT_HEADER_SIZE, pes_header, sizeof(pes_header));
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Startup benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Lazy construction of the PSI repository, on first use. It can be measured only once per
+    // process, this is why it is the first benchmark. One "item" is the complete repository.
+    void BenchPSIRepository(Meter& meter, Options&)
+    {
+        meter.start();
+        ts::PSIRepository::Instance();
+        meter.stop(1);
+    }
+
+    // Start a minimal tsp relay in a new process, which never decodes tables or descriptors.
+    // This includes the loading of the shared libraries and all static initializations.
+    // One "item" is one tsp process.
+    void BenchStartupTSP(Meter& meter, Options& opt)
+    {
+        const fs::path tsp(ts::ExecutableFile().parent_path() / (u"tsp" + ts::UString(ts::EXECUTABLE_FILE_SUFFIX)));
+        const ts::UString command(ts::UString::Format(u"\"%s\" -I null 1 -O drop", tsp));
+        const size_t count = std::max<size_t>(1, opt.packets / 10'000);
+
+        bool success = true;
+        meter.start();
+        for (size_t i = 0; success && i < count; ++i) {
+            success = ts::ForkPipe::Launch(command, opt, ts::ForkPipe::KEEP_BOTH, ts::ForkPipe::STDIN_NONE, ts::ForkPipe::SYNCHRONOUS);
+        }
+        meter.stop(count);
+        if (!success) {
+            opt.error(u"error running %s", command);
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Micro-benchmarks on packets.
+//----------------------------------------------------------------------------
+
+namespace {
+    void BenchPacketAccess(Meter& meter, Options& opt)
+    {
+        ts::DuckContext duck;
+        ts::TSPacketVector packets;
+        BuildSectionPackets(duck, packets, opt.packets);
+
+        uint64_t total = 0;
+        meter.start();
+        for (auto& pkt : packets) {
+            total += pkt.getPID() + pkt.getCC() + pkt.getPayloadSize();
+            if (pkt.getPUSI() && pkt.hasValidSync()) {
+                total++;
+            }
+            if (pkt.hasPCR()) {
+                total += pkt.getPCR();
+            }
+            pkt.setCC(uint8_t(pkt.getCC() + 1) & ts::CC_MASK);
+        }
+        meter.stop(packets.size());
+        sink = total;
+    }
+
+    void BenchCRC32(Meter& meter, Options& opt)
+    {
+        ts::DuckContext duck;
+        ts::TSPacketVector packets;
+        BuildSectionPackets(duck, packets, opt.packets);
+
+        uint64_t total = 0;
+        meter.start();
+        for (const auto& pkt : packets) {
+            total += ts::CRC32(pkt.b, ts::PKT_SIZE).value();
+        }
+        meter.stop(packets.size());
+        sink = total;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Demux benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    class SectionCounter: public ts::SectionHandlerInterface, public ts::TableHandlerInterface
+    {
+    public:
+        uint64_t sections = 0;
+        uint64_t tables = 0;
+        virtual void handleSection(ts::SectionDemux&, const ts::Section&) override { sections++; }
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable&) override { tables++; }
+    };
+
+    class PESCounter: public ts::PESHandlerInterface
+    {
+    public:
+        uint64_t packets = 0;
+        virtual void handlePESPacket(ts::PESDemux&, const ts::PESPacket&) override { packets++; }
+    };
+
+    void BenchSectionDemux(Meter& meter, Options& opt)
+    {
+        ts::DuckContext duck;
+        ts::TSPacketVector packets;
+        BuildSectionPackets(duck, packets, opt.packets);
+
+        SectionCounter counter;
+        ts::SectionDemux demux(duck, &counter, &counter, {PSI_PID});
+        meter.start();
+        for (const auto& pkt : packets) {
+            demux.feedPacket(pkt);
+        }
+        meter.stop(packets.size());
+        sink = counter.sections + counter.tables;
+    }
+
+    void BenchPESDemux(Meter& meter, Options& opt)
+    {
+        ts::DuckContext duck;
+        ts::TSPacketVector packets;
+        BuildPESPackets(packets, opt.packets);
+
+        PESCounter counter;
+        ts::PESDemux demux(duck, &counter, {PES_PID});
+        meter.start();
+        for (const auto& pkt : packets) {
+            demux.feedPacket(pkt);
+        }
+        meter.stop(packets.size());
+        sink = counter.packets;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Packetizer benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    class SectionRepeater: public ts::SectionProviderInterface
+    {
+    public:
+        ts::SectionPtrVector sections {};
+        virtual void provideSection(ts::SectionCounter counter, ts::SectionPtr& section) override { section = sections[counter % sections.size()]; }
+        virtual bool doStuffing() override { return false; }
+    };
+
+    void BenchPacketizer(Meter& meter, Options& opt)
+    {
+        ts::DuckContext duck;
+        SectionRepeater repeater;
+        for (const auto& table : BuildTables(duck)) {
+            for (size_t i = 0; i < table->sectionCount(); ++i) {
+                repeater.sections.push_back(table->sectionAt(i));
+            }
+        }
+
+        ts::Packetizer pzer(duck, PSI_PID, &repeater);
+        ts::TSPacket pkt;
+        uint64_t total = 0;
+        meter.start();
+        for (size_t i = 0; i < opt.packets; ++i) {
+            pzer.getNextPacket(pkt);
+            total += pkt.b[4];
+        }
+        meter.stop(opt.packets);
+        sink = total;
+    }
+
+    void BenchCyclingPacketizer(Meter& meter, Options& opt)
+    {
+        ts::DuckContext duck;
+        ts::CyclingPacketizer pzer(duck, PSI_PID, ts::CyclingPacketizer::StuffingPolicy::AT_END);
+        for (const auto& table : BuildTables(duck)) {
+            pzer.addTable(*table);
+        }
+
+        ts::TSPacket pkt;
+        uint64_t total = 0;
+        meter.start();
+        for (size_t i = 0; i < opt.packets; ++i) {
+            pzer.getNextPacket(pkt);
+            total += pkt.b[4];
+        }
+        meter.stop(opt.packets);
+        sink = total;
+    }
+
+    void BenchPrecompiledPacketizer(Meter& meter, Options& opt)
+    {
+        ts::DuckContext duck;
+        ts::CyclingPacketizer pzer(duck, PSI_PID, ts::CyclingPacketizer::StuffingPolicy::AT_END);
+        pzer.setPrecompiled(true);
+        for (const auto& table : BuildTables(duck)) {
+            pzer.addTable(*table);
+        }
+
+        // Bulk emission, by chunks of packets.
+        ts::TSPacketVector pkts(64);
+        uint64_t total = 0;
+        meter.start();
+        for (size_t i = 0; i < opt.packets; i += pkts.size()) {
+            const size_t count = std::min(pkts.size(), opt.packets - i);
+            pzer.getNextPackets(pkts.data(), count);
+            for (size_t n = 0; n < count; ++n) {
+                total += pkts[n].b[4];
+            }
+        }
+        meter.stop(opt.packets);
+        sink = total;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Cipher benchmarks: encrypt the payload of TS packets.
+//----------------------------------------------------------------------------
+
+namespace {
+    template <class CIPHER>
+    void BenchCipher(Meter& meter, Options& opt)
+    {
+        CIPHER cipher;
+        const ts::ByteBlock key(cipher.minKeySize(), 0xA5);
+        const ts::ByteBlock iv(cipher.minIVSize(), 0x5A);
+        if (!cipher.setKey(key, iv)) {
+            opt.error(u"error setting %s key", cipher.name());
+            return;
+        }
+
+        // Largest payload size which is acceptable by the cipher.
+        size_t size = ts::PKT_SIZE - ts::PKT_HEADER_SIZE;
+        if (!cipher.residueAllowed()) {
+            size -= size % cipher.blockSize();
+        }
+        const ts::ByteBlock plain(size, 0x3C);
+        ts::ByteBlock encrypted(size);
+
+        bool success = true;
+        meter.start();
+        for (size_t i = 0; success && i < opt.packets; ++i) {
+            success = cipher.encrypt(plain.data(), plain.size(), encrypted.data(), encrypted.size());
+        }
+        meter.stop(opt.packets);
+        if (!success) {
+            opt.error(u"%s encryption error", cipher.name());
+        }
+        sink = encrypted[0];
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Serialization benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    void BenchBufferBits(Meter& meter, Options& opt)
+    {
+        // One "item" is a sequence of bit fields which fills 12 bytes.
+        ts::Buffer buf(opt.packets * 12);
+        uint64_t total = 0;
+        meter.start();
+        for (size_t i = 0; i < opt.packets; ++i) {
+            buf.putBits(i, 3);
+            buf.putBits(i >> 3, 13);
+            buf.putUInt16(uint16_t(i));
+            buf.putBits(i, 1);
+            buf.putBits(i, 7);
+            buf.putUInt32(uint32_t(i));
+            buf.putBits(i, 24);
+        }
+        while (buf.canRead()) {
+            total += buf.getBits<uint16_t>(3);
+            total += buf.getBits<uint16_t>(13);
+            total += buf.getUInt16();
+            total += buf.getBits<uint8_t>(1);
+            total += buf.getBits<uint8_t>(7);
+            total += buf.getUInt32();
+            total += buf.getBits<uint32_t>(24);
+        }
+        meter.stop(opt.packets);
+        if (buf.error()) {
+            opt.error(u"buffer bits serialization error");
+        }
+        sink = total;
+    }
+
+    void BenchPSIBuffer(Meter& meter, Options& opt)
+    {
+        // One "item" is a service-descriptor-like structure of 29 bytes.
+        ts::DuckContext duck;
+        const ts::UString provider(u"TSDuck");
+        const ts::UString name(u"Benchmark service");
+        ts::PSIBuffer buf(duck, opt.packets * 29);
+        uint64_t total = 0;
+        meter.start();
+        for (size_t i = 0; i < opt.packets; ++i) {
+            buf.putUInt8(uint8_t(i));
+            buf.putStringWithByteLength(provider);
+            buf.putStringWithByteLength(name);
+            buf.putLanguageCode(u"eng");
+        }
+        while (buf.canRead()) {
+            total += buf.getUInt8();
+            total += buf.getStringWithByteLength().size();
+            total += buf.getStringWithByteLength().size();
+            total += buf.getLanguageCode().size();
+        }
+        meter.stop(opt.packets);
+        if (buf.error()) {
+            opt.error(u"PSI buffer serialization error");
+        }
+        sink = total;
+    }
+
+    // Table round-trips: binary to XML or JSON to binary. One "item" is one table.
+    void BenchTableRoundTrip(Meter& meter, Options& opt, bool use_json)
+    {
+        ts::DuckContext duck;
+        const ts::BinaryTablePtrVector tables(BuildTables(duck));
+        const size_t count = std::max<size_t>(1, opt.packets / 1000);
+
+        bool success = true;
+        meter.start();
+        for (size_t i = 0; success && i < count; ++i) {
+            ts::SectionFile input(duck);
+            input.add(tables);
+            ts::SectionFile output(duck);
+            success = use_json ? output.parseJSON(input.toJSON()) : output.parseXML(input.toXML());
+            success = success && output.tables().size() == tables.size();
+        }
+        meter.stop(count * tables.size());
+        if (!success) {
+            opt.error(u"%s round-trip error", use_json ? u"JSON" : u"XML");
+        }
+    }
+
+    void BenchXMLTables(Meter& meter, Options& opt)
+    {
+        BenchTableRoundTrip(meter, opt, false);
+    }
+
+    void BenchJSONTables(Meter& meter, Options& opt)
+    {
+        BenchTableRoundTrip(meter, opt, true);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Full tsp chains.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Memory input: generate null packets, as many as possible in each event.
+    class MemoryInput: public ts::PluginEventHandlerInterface
+    {
+        TS_NOBUILD_NOCOPY(MemoryInput);
+    public:
+        explicit MemoryInput(size_t count) : _remaining(count) {}
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    private:
+        size_t _remaining;
+    };
+
+    void MemoryInput::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        ts::PluginEventData* data = dynamic_cast<ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr && data->outputData() != nullptr) {
+            const size_t count = std::min(_remaining, data->maxSize() / ts::PKT_SIZE);
+            ts::TSPacket* pkt = reinterpret_cast<ts::TSPacket*>(data->outputData());
+            for (size_t i = 0; i < count; ++i) {
+                pkt[i] = ts::NullPacket;
+            }
+            data->updateSize(count * ts::PKT_SIZE);
+            _remaining -= count;
+        }
+    }
+
+    // Memory output: count packets.
+    class MemoryOutput: public ts::PluginEventHandlerInterface
+    {
+        TS_NOCOPY(MemoryOutput);
+    public:
+        MemoryOutput() = default;
+        uint64_t packets = 0;
+        virtual void handlePluginEvent(const ts::PluginEventContext& context) override;
+    };
+
+    void MemoryOutput::handlePluginEvent(const ts::PluginEventContext& context)
+    {
+        const ts::PluginEventData* data = dynamic_cast<const ts::PluginEventData*>(context.pluginData());
+        if (data != nullptr) {
+            packets += data->size() / ts::PKT_SIZE;
+        }
+    }
+
+    // Run a tsp chain, the input is either null or memory, the output is either drop or memory.
+    void BenchTSP(Meter& meter, Options& opt, bool memory)
+    {
+        MemoryInput input(opt.packets);
+        MemoryOutput output;
+
+        ts::TSProcessorArgs args;
+        args.app_name = opt.appName();
+        if (memory) {
+            args.input = {u"memory", {}};
+            args.output = {u"memory", {}};
+        }
+        else {
+            args.input = {u"null", {ts::UString::Decimal(opt.packets, 0, true, u"")}};
+            args.output = {u"drop", {}};
+        }
+
+        ts::TSProcessor tsp(opt);
+        tsp.registerEventHandler(&input, ts::PluginType::INPUT);
+        tsp.registerEventHandler(&output, ts::PluginType::OUTPUT);
+
+        meter.start();
+        if (tsp.start(args)) {
+            tsp.waitForTermination();
+        }
+        meter.stop(opt.packets);
+        if (memory && output.packets != opt.packets) {
+            opt.error(u"tsp output %'d packets, expected %'d", output.packets, opt.packets);
+        }
+    }
+
+    void BenchTSPNull(Meter& meter, Options& opt)
+    {
+        BenchTSP(meter, opt, false);
+    }
+
+    void BenchTSPMemory(Meter& meter, Options& opt)
+    {
+        BenchTSP(meter, opt, true);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// List of benchmarks.
+//----------------------------------------------------------------------------
+
+namespace {
+    using BenchmarkFunction = void (*)(Meter&, Options&);
+
+    struct Benchmark
+    {
+        const ts::UChar*  name;          // Benchmark name.
+        const ts::UChar*  unit;          // Name of processed items.
+        BenchmarkFunction function;      // Benchmark code.
+        bool              once = false;  // Can run only once per process.
+    };
+
+    const Benchmark benchmarks[] = {
+        {u"psi-repository",      u"build",   BenchPSIRepository, true},
+        {u"startup-tsp",         u"process", BenchStartupTSP},
+        {u"packet-access",       u"packet",  BenchPacketAccess},
+        {u"crc32",               u"packet",  BenchCRC32},
+        {u"section-demux",       u"packet",  BenchSectionDemux},
+        {u"pes-demux",           u"packet",  BenchPESDemux},
+        {u"packetizer",          u"packet",  BenchPacketizer},
+        {u"cycling-packetizer",  u"packet",  BenchCyclingPacketizer},
+        {u"cycling-precompiled", u"packet",  BenchPrecompiledPacketizer},
+        {u"cipher-aes128-ecb",   u"packet",  BenchCipher<ts::ECB<ts::AES128>>},
+        {u"cipher-aes128-cbc",   u"packet",  BenchCipher<ts::CBC<ts::AES128>>},
+        {u"cipher-aes256-ecb",   u"packet",  BenchCipher<ts::ECB<ts::AES256>>},
+        {u"cipher-aes256-cbc",   u"packet",  BenchCipher<ts::CBC<ts::AES256>>},
+        {u"cipher-des-ecb",      u"packet",  BenchCipher<ts::ECB<ts::DES>>},
+        {u"cipher-tdes-ecb",     u"packet",  BenchCipher<ts::ECB<ts::TDES>>},
+        {u"cipher-dvbcsa2",      u"packet",  BenchCipher<ts::DVBCSA2>},
+        {u"cipher-dvbcissa",     u"packet",  BenchCipher<ts::DVBCISSA>},
+        {u"cipher-idsa",         u"packet",  BenchCipher<ts::IDSA>},
+        {u"cipher-scte52",       u"packet",  BenchCipher<ts::SCTE52_2003>},
+        {u"buffer-bits",         u"record",  BenchBufferBits},
+        {u"psibuffer",           u"record",  BenchPSIBuffer},
+        {u"xml-tables",          u"table",   BenchXMLTables},
+        {u"json-tables",         u"table",   BenchJSONTables},
+        {u"tsp-null-drop",       u"packet",  BenchTSPNull},
+        {u"tsp-memory",          u"packet",  BenchTSPMemory},
+    };
+
+    // Check if a benchmark is selected on the command line.
+    bool Selected(const Options& opt, const ts::UString& name)
+    {
+        if (opt.names.empty()) {
+            return true;
+        }
+        for (const auto& prefix : opt.names) {
+            if (name.starts_with(prefix)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Program main code.
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    CERR.setMaxSeverity(opt.maxSeverity());
+
+    if (opt.list) {
+        for (const auto& bench : benchmarks) {
+            std::cout << ts::UString(bench.name) << std::endl;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Text output header.
+    if (!opt.json.useFile()) {
+        std::cout << ts::UString::Format(u"%-20s %12s %10s %12s %12s %10s %10s", u"Benchmark", u"Items", u"Unit", u"ns/item", u"cycles/item", u"allocs", u"bytes")
+                  << std::endl
+                  << ts::UString::Format(u"%s %s %s %s %s %s %s", ts::UString(20, u'-'), ts::UString(12, u'-'), ts::UString(10, u'-'), ts::UString(12, u'-'), ts::UString(12, u'-'), ts::UString(10, u'-'), ts::UString(10, u'-'))
+                  << std::endl;
+    }
+
+    ts::json::Object jroot;
+    jroot.add(u"version", ts::VersionInfo::GetVersion());
+    jroot.add(u"cycles-counter", ts::json::Bool(ts::CPU_CYCLES_COUNTER));
+    jroot.add(u"allocations-tracked", ts::json::Bool(ts::AllocationTracker::Enabled()));
+    jroot.add(u"repeat", opt.repeat);
+
+    for (const auto& bench : benchmarks) {
+        if (!Selected(opt, bench.name)) {
+            continue;
+        }
+
+        // Run the benchmark several times, keep the fastest run.
+        Result best;
+        const size_t repeat = bench.once ? 1 : opt.repeat;
+        for (size_t i = 0; i < repeat && !opt.gotErrors(); ++i) {
+            Meter meter;
+            bench.function(meter, opt);
+            if (i == 0 || meter.result().duration < best.duration) {
+                best = meter.result();
+            }
+        }
+        if (opt.gotErrors()) {
+            break;
+        }
+
+        if (!opt.json.useFile()) {
+            std::cout << ts::UString::Format(u"%-20s %12'd %10s %12.1f %12.1f %10.3f %10.1f", bench.name, best.items, bench.unit,
+                                             best.nsPerItem(), best.cyclesPerItem(), best.allocsPerItem(), best.bytesPerItem())
+                      << std::endl;
+        }
+        if (opt.json.useJSON()) {
+            ts::json::Value& jv(jroot.query(u"benchmarks[]", true));
+            jv.add(u"name", ts::UString(bench.name));
+            jv.add(u"unit", ts::UString(bench.unit));
+            jv.add(u"items", best.items);
+            jv.add(u"items-per-second", best.itemsPerSecond());
+            jv.add(u"ns-per-item", best.nsPerItem());
+            jv.add(u"cycles-per-item", best.cyclesPerItem());
+            jv.add(u"allocations-per-item", best.allocsPerItem());
+            jv.add(u"bytes-per-item", best.bytesPerItem());
+        }
+    }
+
+    opt.json.report(jroot, std::cout, opt);
+    return opt.gotErrors() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
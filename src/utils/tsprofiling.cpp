@@ -14,6 +14,10 @@
 // is completely inappropriate for production and should be reserved to
 // plugin profiling or debugging.
 //
+// With --profile, the time, CPU cycles, heap allocations, demux activity
+// and cache misses are measured in each plugin and reported at the end
+// in a table, ranked by cost.
+//
 // Limitations:
 // - Awful performances.
 // - No support for joint termination.
@@ -26,7 +30,14 @@
 #include "tsDuckContext.h"
 #include "tsPCRAnalyzer.h"
 #include "tsPluginRepository.h"
+#include "tsAbstractDemux.h"
+#include "tsAllocationTracker.h"
+#include "tsCPUCycles.h"
+#include "tsPerfCounter.h"
+#include "tsjsonOutputArgs.h"
+#include "tsjsonObject.h"
 TS_MAIN(MainCode);
+TS_TRACK_ALLOCATIONS();
 
 
 //----------------------------------------------------------------------------
@@ -43,6 +54,9 @@ namespace {
         ts::DuckContext         duck {this};
         size_t                  buffer_size = 0;
         ts::BitRate             fixed_bitrate = 0;
+        bool                    profile = false;     // Measure and report the cost of each plugin.
+        ts::json::OutputArgs    json {};             // JSON profiling report.
+        ts::PerfCounter         cache_misses {};     // Cache misses counter in main thread (when profiling).
         ts::PluginOptions       input {};
         ts::PluginOptionsVector plugins {};
         ts::PluginOptions       output {};
@@ -66,6 +80,15 @@ Options::Options(int argc, char *argv[]) :
     option(u"packet-buffer", 'p', POSITIVE);
     help(u"packet-buffer", u"Specify the maximum number of TS packets in the buffer. The default is 1000.");
 
+    option(u"profile", 0);
+    help(u"profile",
+         u"Measure the cost of each plugin and report it at the end, ranked by CPU cycles. "
+         u"The report includes CPU cycles, time, heap allocations, section and PES demux activity "
+         u"and, when available on the system, last level cache misses, per packet. "
+         u"The report is displayed on standard error.");
+
+    json.defineArgs(*this, true, u"Report the profiling results in JSON format. Implies --profile.");
+
     // Analyze the command.
     analyze(argc, argv);
 
@@ -73,6 +96,8 @@ Options::Options(int argc, char *argv[]) :
     duck.loadArgs(*this);
     getIntValue(buffer_size, u"packet-buffer", 1000);
     getValue(fixed_bitrate, u"bitrate");
+    json.loadArgs(*this);
+    profile = present(u"profile") || json.useJSON();
     getPlugin(input, ts::PluginType::INPUT, u"file");
     getPlugin(output, ts::PluginType::OUTPUT, u"drop");
     getPlugins(plugins, ts::PluginType::PROCESSOR);
@@ -106,6 +131,21 @@ namespace {
         virtual bool useJointTermination() const override { return false; }
         virtual bool thisJointTerminated() const override { return false; }
 
+        // Accumulated profiling data of the plugin.
+        class Profile
+        {
+        public:
+            uint64_t                    calls = 0;            // Number of calls to the plugin.
+            uint64_t                    packets = 0;          // Number of packets passed to the plugin.
+            uint64_t                    cycles = 0;           // CPU cycles in the plugin.
+            cn::nanoseconds             duration {};          // Time in the plugin.
+            uint64_t                    allocations = 0;      // Number of heap allocations.
+            uint64_t                    allocated_bytes = 0;  // Total size of heap allocations.
+            uint64_t                    cache_misses = 0;     // Number of last level cache misses.
+            ts::AbstractDemux::Counters demux {};             // Section and PES demux activity.
+        };
+        const Profile& profile() const { return _profile; }
+
     protected:
         Options& _opt;              // Application options.
         bool _own_bitrate = false;  // This plugin manages its own bitrate (ie. does not get it from previous plugin).
@@ -114,11 +154,23 @@ namespace {
         void updateBitrateFromPrevious();
         void updateBitrateFromCurrent();
 
+        // Start and stop the measurement of one call to the plugin (only with --profile).
+        void startProfiling();
+        void stopProfiling(size_t packets);
+
     private:
         size_t          _index = 0;           // Plugin index in the chain.
         ts::UString     _name {};             // Plugin name.
         ts::Plugin*     _shlib = nullptr;     // Plugin instance.
         PluginExecutor* _previous = nullptr;  // Previous plugin executor.
+
+        // Profiling data.
+        Profile                         _profile {};
+        uint64_t                        _start_cycles = 0;
+        ts::monotonic_time              _start_time {};
+        uint64_t                        _start_misses = 0;
+        ts::AllocationTracker::Counters _start_allocs {};
+        ts::AbstractDemux::Counters     _start_demux {};
     };
 }
 
@@ -216,6 +268,43 @@ void PluginExecutor::updateBitrateFromCurrent()
     }
 }
 
+// Start the measurement of one call to the plugin.
+void PluginExecutor::startProfiling()
+{
+    if (_opt.profile) {
+        _start_allocs = ts::AllocationTracker::CurrentThread();
+        _start_demux = ts::AbstractDemux::CurrentThreadCounters();
+        _start_misses = _opt.cache_misses.value();
+        _start_time = ts::monotonic_time::clock::now();
+        _start_cycles = ts::ReadCPUCycles();
+    }
+}
+
+// Stop the measurement of one call to the plugin and accumulate the results.
+void PluginExecutor::stopProfiling(size_t packets)
+{
+    if (_opt.profile) {
+        const uint64_t cycles = ts::ReadCPUCycles();
+        const ts::monotonic_time time = ts::monotonic_time::clock::now();
+        const uint64_t misses = _opt.cache_misses.value();
+        const ts::AllocationTracker::Counters allocs(ts::AllocationTracker::CurrentThread() - _start_allocs);
+        const ts::AbstractDemux::Counters demux(ts::AbstractDemux::CurrentThreadCounters() - _start_demux);
+
+        _profile.calls++;
+        _profile.packets += packets;
+        _profile.cycles += cycles - _start_cycles;
+        _profile.duration += cn::duration_cast<cn::nanoseconds>(time - _start_time);
+        _profile.cache_misses += misses - _start_misses;
+        _profile.allocations += allocs.allocations;
+        _profile.allocated_bytes += allocs.bytes;
+        _profile.demux.packets += demux.packets;
+        _profile.demux.sections += demux.sections;
+        _profile.demux.tables += demux.tables;
+        _profile.demux.pes_packets += demux.pes_packets;
+        _profile.demux.invalid += demux.invalid;
+    }
+}
+
 
 //----------------------------------------------------------------------------
 // Input plugin executor class.
@@ -256,7 +345,12 @@ InputPluginExecutor::InputPluginExecutor(Options& opt) :
 size_t InputPluginExecutor::receive(ts::TSPacket* packets, ts::TSPacketMetadata* metadata, size_t max_packets)
 {
     // Receive packets from the plugin. End of stream after loss of synchronization.
-    size_t count = _sync_lost ? 0 : plugin()->receive(packets, metadata, max_packets);
+    size_t count = 0;
+    if (!_sync_lost) {
+        startProfiling();
+        count = plugin()->receive(packets, metadata, max_packets);
+        stopProfiling(count);
+    }
     if (count == 0) {
         return 0;
     }
@@ -327,7 +421,9 @@ bool ProcessorPluginExecutor::process(ts::TSPacket* packets, ts::TSPacketMetadat
     updateBitrateFromPrevious();
 
     // Loop on packets.
-    for (size_t i = 0; i < count; ++i) {
+    bool success = true;
+    startProfiling();
+    for (size_t i = 0; success && i < count; ++i) {
         if (packets[i].b[0] == 0) {
             // The packet has already been dropped by a previous packet processor.
             addNonPluginPackets(1);
@@ -336,7 +432,8 @@ bool ProcessorPluginExecutor::process(ts::TSPacket* packets, ts::TSPacketMetadat
             metadata[i].setBitrateChanged(false);
             switch (plugin()->processPacket(packets[i], metadata[i])) {
                 case ts::TSP_END:
-                    return false;
+                    success = false;
+                    break;
                 case ts::TSP_DROP:
                     packets[i].b[0] = 0;
                     addNonPluginPackets(1);
@@ -351,12 +448,13 @@ bool ProcessorPluginExecutor::process(ts::TSPacket* packets, ts::TSPacketMetadat
                 default:
                     break;
             }
-            if (metadata[i].getBitrateChanged()) {
+            if (success && metadata[i].getBitrateChanged()) {
                 updateBitrateFromCurrent();
             }
         }
     }
-    return true;
+    stopProfiling(count);
+    return success;
 }
 
 
@@ -393,8 +491,10 @@ bool OutputPluginExecutor::send(ts::TSPacket* packets, ts::TSPacketMetadata* met
     updateBitrateFromPrevious();
 
     // Loop on chunks of non-dropped packets.
+    bool success = true;
     size_t chunk_start = 0;
-    while (chunk_start < count) {
+    startProfiling();
+    while (success && chunk_start < count) {
         // Locate next chunk of non-dropped packets.
         while (chunk_start < count && packets[chunk_start].b[0] != ts::SYNC_BYTE) {
             chunk_start++;
@@ -404,13 +504,94 @@ bool OutputPluginExecutor::send(ts::TSPacket* packets, ts::TSPacketMetadata* met
             chunk_end++;
         }
         // Output chunk of packets.
-        if (chunk_end > chunk_start && !plugin()->send(packets + chunk_start, metadata + chunk_start, chunk_end - chunk_start)) {
-            return false;
-        }
+        success = chunk_end == chunk_start || plugin()->send(packets + chunk_start, metadata + chunk_start, chunk_end - chunk_start);
         chunk_start = chunk_end;
     }
+    stopProfiling(count);
+    return success;
+}
+
 
-    return true;
+//----------------------------------------------------------------------------
+// Display the profiling report, plugins ranked by CPU cycles.
+//----------------------------------------------------------------------------
+
+namespace {
+    void ReportProfile(Options& opt, std::vector<PluginExecutor*> plugins)
+    {
+        // Values per packet.
+        const auto per_packet = [](uint64_t value, uint64_t packets) { return packets == 0 ? 0.0 : double(value) / double(packets); };
+
+        // Total cost in all plugins.
+        uint64_t total_cycles = 0;
+        for (const auto& pl : plugins) {
+            total_cycles += pl->profile().cycles;
+        }
+
+        // Rank plugins by decreasing CPU cycles.
+        std::stable_sort(plugins.begin(), plugins.end(), [](const PluginExecutor* a, const PluginExecutor* b) { return a->profile().cycles > b->profile().cycles; });
+
+        const bool misses = opt.cache_misses.isOpen();
+        ts::json::Object jroot;
+        jroot.add(u"cycles-counter", ts::json::Bool(ts::CPU_CYCLES_COUNTER));
+        jroot.add(u"allocations-tracked", ts::json::Bool(ts::AllocationTracker::Enabled()));
+        jroot.add(u"cache-misses", ts::json::Bool(misses));
+        jroot.add(u"total-cycles", total_cycles);
+
+        if (!opt.json.useFile()) {
+            ts::UString header(ts::UString::Format(u"%-22s %12s %6s %10s %10s %10s %10s %8s %8s %8s",
+                                                   u"Plugin", u"Packets", u"%", u"cycles/pkt", u"ns/pkt", u"allocs/pkt", u"bytes/pkt",
+                                                   u"sections", u"tables", u"PES"));
+            if (misses) {
+                header.append(u" misses/pkt");
+            }
+            std::cerr << std::endl << header << std::endl;
+        }
+
+        for (const auto& pl : plugins) {
+            const PluginExecutor::Profile& prof(pl->profile());
+            const ts::UString name(ts::UString::Format(u"%d:%s", pl->pluginIndex(), pl->pluginName()));
+            const double percent = total_cycles == 0 ? 0.0 : 100.0 * double(prof.cycles) / double(total_cycles);
+
+            if (!opt.json.useFile()) {
+                ts::UString line(ts::UString::Format(u"%-22s %12'd %6.2f %10.1f %10.1f %10.3f %10.1f %8'd %8'd %8'd",
+                                                     name, prof.packets, percent,
+                                                     per_packet(prof.cycles, prof.packets), per_packet(prof.duration.count(), prof.packets),
+                                                     per_packet(prof.allocations, prof.packets), per_packet(prof.allocated_bytes, prof.packets),
+                                                     prof.demux.sections, prof.demux.tables, prof.demux.pes_packets));
+                if (misses) {
+                    line.format(u" %10.3f", per_packet(prof.cache_misses, prof.packets));
+                }
+                std::cerr << line << std::endl;
+            }
+            if (opt.json.useJSON()) {
+                ts::json::Value& jv(jroot.query(u"plugins[]", true));
+                jv.add(u"index", pl->pluginIndex());
+                jv.add(u"name", pl->pluginName());
+                jv.add(u"calls", prof.calls);
+                jv.add(u"packets", prof.packets);
+                jv.add(u"cycles", prof.cycles);
+                jv.add(u"percent", percent);
+                jv.add(u"duration-ns", prof.duration.count());
+                jv.add(u"cycles-per-packet", per_packet(prof.cycles, prof.packets));
+                jv.add(u"ns-per-packet", per_packet(prof.duration.count(), prof.packets));
+                jv.add(u"allocations", prof.allocations);
+                jv.add(u"allocated-bytes", prof.allocated_bytes);
+                jv.add(u"allocations-per-packet", per_packet(prof.allocations, prof.packets));
+                jv.add(u"demux-packets", prof.demux.packets);
+                jv.add(u"sections", prof.demux.sections);
+                jv.add(u"tables", prof.demux.tables);
+                jv.add(u"pes-packets", prof.demux.pes_packets);
+                jv.add(u"invalid-sections-pes", prof.demux.invalid);
+                if (misses) {
+                    jv.add(u"cache-misses", prof.cache_misses);
+                    jv.add(u"cache-misses-per-packet", per_packet(prof.cache_misses, prof.packets));
+                }
+            }
+        }
+
+        opt.json.report(jroot, std::cerr, opt);
+    }
 }
 
 
@@ -427,6 +608,14 @@ int MainCode(int argc, char *argv[])
     // Prevent from being killed when writing on broken pipes.
     ts::IgnorePipeSignal();
 
+    // Count cache misses in the main thread, where all plugins are executed, when possible.
+    if (opt.profile && !opt.cache_misses.open(ts::PerfCounter::Event::CACHE_MISSES)) {
+        opt.verbose(u"cache misses are not available on this system");
+    }
+
+    // Count the demux reassembly work in all plugins, before starting them.
+    ts::AbstractDemux::EnableCounters(opt.profile);
+
     // Allocate and start all plugins.
     InputPluginExecutor* input = new InputPluginExecutor(opt);
     PluginExecutor* previous = input;
@@ -460,6 +649,14 @@ int MainCode(int argc, char *argv[])
         ts::TSPacketMetadata::Reset(metadata.data(), received);
     }
 
+    // Report the cost of each plugin.
+    if (opt.profile) {
+        std::vector<PluginExecutor*> all {input};
+        all.insert(all.end(), procs.begin(), procs.end());
+        all.push_back(output);
+        ReportProfile(opt, all);
+    }
+
     // Close and deallocate all plugins.
     input->plugin()->stop();
     delete input;